@@ -0,0 +1,221 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// 与平台无关的通用类型定义（不依赖 windows.h，可在Linux上编译和测试）
+namespace WindowsAPI {
+    // 错误代码定义
+    enum class ErrorCode {
+        SUCCESS = 0,
+        WINDOW_NOT_FOUND,
+        INVALID_HANDLE,
+        OPERATION_FAILED,
+        PERMISSION_DENIED,
+        INVALID_PARAMETER,
+        MEMORY_ALLOCATION_FAILED,
+        CAPTURE_FAILED,
+        INPUT_SIMULATION_FAILED,
+        WINDOW_NOT_RESPONDING,
+        COUNT               // 错误码个数（不是错误码），新的错误码加在它之前
+    };
+
+    // 点坐标结构
+    struct Point {
+        int x;
+        int y;
+        
+        Point() : x(0), y(0) {}
+        Point(int x, int y) : x(x), y(y) {}
+    };
+
+    // 矩形区域结构
+    struct Rectangle {
+        int left;
+        int top;
+        int right;
+        int bottom;
+        
+        Rectangle() : left(0), top(0), right(0), bottom(0) {}
+        Rectangle(int l, int t, int r, int b) : left(l), top(t), right(r), bottom(b) {}
+        
+        int width() const { return right - left; }
+        int height() const { return bottom - top; }
+    };
+
+    // 像素格式
+    enum class PixelFormat {
+        UNKNOWN = 0,
+        BGRA32,     // 32位 B,G,R,A（GDI捕获的原生格式）
+        GRAY8,      // 8位灰度
+        RGB24,      // 24位 R,G,B（编码器常用格式）
+        RGBA32,     // 32位 R,G,B,A
+        RGB565,     // 16位 R5 G6 B5（小端 WORD，R 在高位）
+        MONO1       // 1位掩码，每字节8个像素，最左像素在最高位
+    };
+
+    // 获取像素格式每像素的位数
+    inline int GetBitsPerPixel(PixelFormat format) {
+        switch (format) {
+            case PixelFormat::BGRA32: return 32;
+            case PixelFormat::GRAY8: return 8;
+            case PixelFormat::RGB24: return 24;
+            case PixelFormat::RGBA32: return 32;
+            case PixelFormat::RGB565: return 16;
+            case PixelFormat::MONO1: return 1;
+            default: return 0;
+        }
+    }
+
+    // 根据每像素位数推断像素格式（32位按捕获的原生格式 BGRA32 处理）
+    inline PixelFormat GetPixelFormat(int bitsPerPixel) {
+        switch (bitsPerPixel) {
+            case 32: return PixelFormat::BGRA32;
+            case 24: return PixelFormat::RGB24;
+            case 16: return PixelFormat::RGB565;
+            case 8: return PixelFormat::GRAY8;
+            case 1: return PixelFormat::MONO1;
+            default: return PixelFormat::UNKNOWN;
+        }
+    }
+
+    // 一行像素实际占用的字节数
+    inline int GetRowBytes(int width, PixelFormat format) {
+        return (width * GetBitsPerPixel(format) + 7) / 8;
+    }
+
+    // 按4字节对齐的行跨度（与 DIB 的行对齐规则一致）
+    inline int GetAlignedStride(int width, PixelFormat format) {
+        return (width * GetBitsPerPixel(format) + 31) / 32 * 4;
+    }
+
+    // 图像数据结构
+    struct ImageData {
+        std::vector<std::uint8_t> data;
+        int width;
+        int height;
+        int bitsPerPixel;
+        int stride;
+        PixelFormat format;  // UNKNOWN 时按 bitsPerPixel 推断
+        
+        ImageData() : width(0), height(0), bitsPerPixel(0), stride(0), format(PixelFormat::UNKNOWN) {}
+        
+        // 按格式分配清零的像素内存，行跨度按4字节对齐
+        ImageData(int w, int h, PixelFormat f)
+            : data(static_cast<size_t>(GetAlignedStride(w, f)) * h), width(w), height(h),
+              bitsPerPixel(GetBitsPerPixel(f)), stride(GetAlignedStride(w, f)), format(f) {}
+        
+        // 获取像素格式（兼容只设置了 bitsPerPixel 的旧数据）
+        PixelFormat GetFormat() const {
+            return format != PixelFormat::UNKNOWN ? format : GetPixelFormat(bitsPerPixel);
+        }
+    };
+
+    // 鼠标按键枚举
+    enum class MouseButton {
+        LEFT,
+        RIGHT,
+        MIDDLE,
+        X1,
+        X2
+    };
+
+    // 鼠标事件类型
+    enum class MouseEventType {
+        MOVE,
+        LEFT_DOWN,
+        LEFT_UP,
+        RIGHT_DOWN,
+        RIGHT_UP,
+        MIDDLE_DOWN,
+        MIDDLE_UP,
+        WHEEL,
+    };
+
+    // 键盘修饰键
+    enum class ModifierKey {
+        NONE = 0,
+        CTRL = 1,
+        ALT = 2,
+        SHIFT = 4,
+        WIN = 8
+    };
+
+    /**
+     * @brief 获取错误代码的默认描述（静态表，不分配内存）
+     * @param code 错误代码
+     * @return 描述文本
+     */
+    const std::wstring& GetErrorCodeText(ErrorCode code);
+
+    /**
+     * @brief 操作结果结构
+     * 
+     * 成功路径上只保存数据本身：数据可以移动进出，不复制大块载荷，也不构造任何字符串。
+     * 错误信息仅在错误路径上分配，未提供时从静态表中取默认描述。
+     */
+    template<typename T>
+    class Result {
+    private:
+        ErrorCode errorCode;
+        T data;
+        std::shared_ptr<const std::wstring> errorMessage;
+        
+    public:
+        Result() : errorCode(ErrorCode::SUCCESS) {}
+        Result(ErrorCode code) : errorCode(code) {}
+        Result(ErrorCode code, std::wstring message) : errorCode(code) {
+            if (!message.empty()) {
+                errorMessage = std::make_shared<const std::wstring>(std::move(message));
+            }
+        }
+        Result(const T& value) : errorCode(ErrorCode::SUCCESS), data(value) {}
+        Result(T&& value) : errorCode(ErrorCode::SUCCESS), data(std::move(value)) {}
+        
+        bool IsSuccess() const { return errorCode == ErrorCode::SUCCESS; }
+        bool IsError() const { return errorCode != ErrorCode::SUCCESS; }
+        
+        const T& GetData() const & { return data; }
+        T& GetData() & { return data; }
+        // 临时对象上调用时移出数据，避免悬空引用
+        T GetData() && { return std::move(data); }
+        
+        // 移出数据（调用后结果对象中的数据处于已移动状态）
+        T TakeData() && { return std::move(data); }
+        
+        ErrorCode GetErrorCode() const { return errorCode; }
+        const std::wstring& GetErrorMessage() const {
+            return errorMessage ? *errorMessage : GetErrorCodeText(errorCode);
+        }
+        
+        // 静态创建方法
+        static Result<T> Success(const T& value) {
+            return Result<T>(value);
+        }
+        
+        static Result<T> Success(T&& value) {
+            return Result<T>(std::move(value));
+        }
+        
+        static Result<T> Error(ErrorCode code) {
+            return Result<T>(code);
+        }
+        
+        static Result<T> Error(ErrorCode code, std::wstring message) {
+            return Result<T>(code, std::move(message));
+        }
+    };
+    
+    // 日志级别
+    enum class LogLevel {
+        DEBUG,
+        INFO,
+        WARNING,
+        ERROR_LEVEL
+    };
+
+}  // namespace WindowsAPI
@@ -0,0 +1,56 @@
+#pragma once
+
+// x86 平台检测（SIMD 内核只在 x86/x64 上编译）
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define WINDOWSAPI_X86 1
+#endif
+
+// 函数级指令集属性：GCC/Clang 需要显式开启，MSVC 直接允许使用内建函数
+#if defined(__GNUC__) || defined(__clang__)
+#define WINDOWSAPI_TARGET(isa) __attribute__((target(isa)))
+#else
+#define WINDOWSAPI_TARGET(isa)
+#endif
+
+/**
+ * @namespace CpuFeatures
+ * @brief 运行时CPU指令集检测
+ * 
+ * 各图像处理模块据此在运行时选择 SIMD 内核：
+ * - 首次调用时通过 CPUID 检测一次并缓存
+ * - 可以限制可用的最高级别，便于测试与基准对比各内核
+ */
+namespace CpuFeatures {
+
+/**
+ * @brief SIMD 级别（由低到高）
+ */
+enum class SimdLevel {
+    SCALAR = 0,
+    SSE2,
+    SSSE3,
+    AVX2
+};
+
+/**
+ * @brief 获取CPU支持的最高SIMD级别（不受限制影响）
+ */
+SimdLevel GetDetectedSimdLevel();
+
+/**
+ * @brief 获取当前可用的SIMD级别（检测结果与限制中的较小者）
+ */
+SimdLevel GetSimdLevel();
+
+/**
+ * @brief 限制可用的最高SIMD级别
+ * @param level 最高级别，传入 AVX2 即取消限制
+ */
+void SetMaxSimdLevel(SimdLevel level);
+
+/**
+ * @brief 获取SIMD级别名称
+ */
+const char* GetSimdLevelName(SimdLevel level);
+
+}  // namespace CpuFeatures
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "BasicTypes.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace WindowsAPI {
+    /**
+     * @brief 只读图像视图
+     * 
+     * 不拥有像素内存，仅记录像素指针、尺寸、行跨度与像素格式。
+     * 视图的有效期由像素内存的持有者决定；子视图共享同一块内存，创建开销为O(1)。
+     */
+    struct ImageView {
+        const std::uint8_t* data;
+        int width;
+        int height;
+        int stride;
+        PixelFormat format;
+        
+        ImageView() : data(nullptr), width(0), height(0), stride(0), format(PixelFormat::UNKNOWN) {}
+        ImageView(const std::uint8_t* d, int w, int h, int s, PixelFormat f)
+            : data(d), width(w), height(h), stride(s), format(f) {}
+        
+        // 引用 ImageData 的像素（不复制）
+        explicit ImageView(const ImageData& image)
+            : data(image.data.empty() ? nullptr : image.data.data()), width(image.width), height(image.height),
+              stride(image.stride), format(image.GetFormat()) {}
+        
+        bool IsEmpty() const { return data == nullptr || width <= 0 || height <= 0; }
+        
+        int BitsPerPixel() const { return GetBitsPerPixel(format); }
+        int BytesPerPixel() const { return GetBitsPerPixel(format) / 8; }
+        
+        // 获取指定行的起始地址
+        const std::uint8_t* Row(int y) const {
+            return data + static_cast<std::ptrdiff_t>(y) * stride;
+        }
+        
+        // 获取指定像素的起始地址（MONO1 为该像素所在的字节）
+        const std::uint8_t* PixelAt(int x, int y) const {
+            return Row(y) + static_cast<std::ptrdiff_t>(x) * BitsPerPixel() / 8;
+        }
+        
+        // 读取 MONO1 掩码中的一位
+        bool MaskBit(int x, int y) const {
+            return (Row(y)[x >> 3] >> (7 - (x & 7))) & 1;
+        }
+        
+        /**
+         * @brief 创建子视图（不复制像素）
+         * @param rect 子区域（本视图坐标），超出部分会被裁掉
+         * @return 子视图，与本视图无交集时返回空视图；MONO1 的左边界必须是8的倍数，否则返回空视图
+         */
+        ImageView Subview(const Rectangle& rect) const {
+            int left = std::max(rect.left, 0);
+            int top = std::max(rect.top, 0);
+            int right = std::min(rect.right, width);
+            int bottom = std::min(rect.bottom, height);
+            if (IsEmpty() || right <= left || bottom <= top) {
+                return ImageView();
+            }
+            if (BitsPerPixel() % 8 != 0 && left * BitsPerPixel() % 8 != 0) {
+                return ImageView();
+            }
+            return ImageView(PixelAt(left, top), right - left, bottom - top, stride, format);
+        }
+    };
+
+    /**
+     * @brief 将视图内容复制为紧凑排列的 ImageData
+     * @param view 源视图
+     * @return 拥有像素内存的图像数据（行跨度按4字节对齐）
+     */
+    ImageData CopyToImageData(const ImageView& view);
+
+}  // namespace WindowsAPI
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace WindowsAPI {
+    /**
+     * @brief 固定大小的线程池
+     * 
+     * 图像处理模块用它把行带/候选位置分给多个线程：
+     * - ParallelFor 把区间切成块，调用线程也参与执行，嵌套调用不会死锁
+     * - GetDefault() 提供进程内共享的默认线程池（线程数 = 硬件并发数）
+     */
+    class ThreadPool {
+    public:
+        explicit ThreadPool(size_t threadCount);
+        ~ThreadPool();
+        
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+        
+        /**
+         * @brief 提交一个异步任务
+         */
+        void Submit(std::function<void()> task);
+        
+        /**
+         * @brief 并行执行区间 [begin, end)
+         * @param begin 起始下标
+         * @param end 结束下标（不含）
+         * @param body 处理子区间 [chunkBegin, chunkEnd) 的函数
+         * @param minChunk 每块的最小长度
+         */
+        void ParallelFor(int begin, int end, const std::function<void(int, int)>& body, int minChunk = 1);
+        
+        // 工作线程数（不含调用线程）
+        size_t GetThreadCount() const { return m_workers.size(); }
+        
+        // 进程内共享的默认线程池
+        static ThreadPool& GetDefault();
+        
+    private:
+        void WorkerLoop();
+        
+    private:
+        std::vector<std::thread> m_workers;
+        std::deque<std::function<void()>> m_tasks;
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        bool m_stopping = false;
+    };
+
+}  // namespace WindowsAPI
@@ -0,0 +1,30 @@
+#include "../include/BasicTypes.h"
+
+namespace WindowsAPI {
+
+const std::wstring& GetErrorCodeText(ErrorCode code) {
+    // 静态表：首次使用时构造一次，之后只返回引用
+    static const std::wstring texts[] = {
+        L"Success",
+        L"Window not found",
+        L"Invalid handle",
+        L"Operation failed",
+        L"Permission denied",
+        L"Invalid parameter",
+        L"Memory allocation failed",
+        L"Capture failed",
+        L"Input simulation failed",
+        L"Window not responding",
+    };
+    static_assert(sizeof(texts) / sizeof(texts[0]) == static_cast<size_t>(ErrorCode::COUNT),
+                  "Every ErrorCode needs a text");
+    static const std::wstring unknown = L"Unknown error";
+    
+    size_t index = static_cast<size_t>(code);
+    if (index < sizeof(texts) / sizeof(texts[0])) {
+        return texts[index];
+    }
+    return unknown;
+}
+
+}  // namespace WindowsAPI
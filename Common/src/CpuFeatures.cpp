@@ -0,0 +1,76 @@
+#include "../include/CpuFeatures.h"
+
+#include <atomic>
+
+#if defined(WINDOWSAPI_X86) && defined(_MSC_VER)
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+namespace CpuFeatures {
+
+namespace {
+    SimdLevel DetectSimdLevel() {
+#if defined(WINDOWSAPI_X86) && defined(_MSC_VER)
+        int info[4] = {};
+        __cpuid(info, 0);
+        int maxLeaf = info[0];
+        
+        __cpuid(info, 1);
+        bool sse2 = (info[3] & (1 << 26)) != 0;
+        bool ssse3 = (info[2] & (1 << 9)) != 0;
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        bool avx = (info[2] & (1 << 28)) != 0;
+        
+        bool avx2 = false;
+        if (maxLeaf >= 7 && osxsave && avx) {
+            // 操作系统必须保存 YMM 寄存器状态
+            bool ymmEnabled = (_xgetbv(0) & 0x6) == 0x6;
+            __cpuidex(info, 7, 0);
+            avx2 = ymmEnabled && (info[1] & (1 << 5)) != 0;
+        }
+        
+        if (avx2) return SimdLevel::AVX2;
+        if (ssse3) return SimdLevel::SSSE3;
+        if (sse2) return SimdLevel::SSE2;
+        return SimdLevel::SCALAR;
+#elif defined(WINDOWSAPI_X86) && (defined(__GNUC__) || defined(__clang__))
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+        if (__builtin_cpu_supports("ssse3")) return SimdLevel::SSSE3;
+        if (__builtin_cpu_supports("sse2")) return SimdLevel::SSE2;
+        return SimdLevel::SCALAR;
+#else
+        return SimdLevel::SCALAR;
+#endif
+    }
+    
+    std::atomic<int> g_maxLevel{static_cast<int>(SimdLevel::AVX2)};
+}
+
+SimdLevel GetDetectedSimdLevel() {
+    static const SimdLevel detected = DetectSimdLevel();
+    return detected;
+}
+
+SimdLevel GetSimdLevel() {
+    int detected = static_cast<int>(GetDetectedSimdLevel());
+    int limit = g_maxLevel.load(std::memory_order_relaxed);
+    return static_cast<SimdLevel>(detected < limit ? detected : limit);
+}
+
+void SetMaxSimdLevel(SimdLevel level) {
+    g_maxLevel.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+const char* GetSimdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::SCALAR: return "scalar";
+        case SimdLevel::SSE2: return "SSE2";
+        case SimdLevel::SSSE3: return "SSSE3";
+        case SimdLevel::AVX2: return "AVX2";
+        default: return "unknown";
+    }
+}
+
+}  // namespace CpuFeatures
@@ -0,0 +1,21 @@
+#include "../include/ImageView.h"
+
+#include <cstring>
+
+namespace WindowsAPI {
+
+ImageData CopyToImageData(const ImageView& view) {
+    if (view.IsEmpty()) {
+        return ImageData();
+    }
+    
+    ImageData image(view.width, view.height, view.format);
+    int rowBytes = GetRowBytes(view.width, view.format);
+    for (int y = 0; y < view.height; y++) {
+        std::memcpy(&image.data[static_cast<size_t>(y) * image.stride], view.Row(y), rowBytes);
+    }
+    
+    return image;
+}
+
+}  // namespace WindowsAPI
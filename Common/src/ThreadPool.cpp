@@ -0,0 +1,106 @@
+#include "../include/ThreadPool.h"
+
+#include <algorithm>
+#include <memory>
+
+namespace WindowsAPI {
+
+ThreadPool::ThreadPool(size_t threadCount) {
+    m_workers.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; i++) {
+        m_workers.emplace_back([this]() { WorkerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_condition.notify_all();
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::Submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push_back(std::move(task));
+    }
+    m_condition.notify_one();
+}
+
+void ThreadPool::ParallelFor(int begin, int end, const std::function<void(int, int)>& body, int minChunk) {
+    if (end <= begin) {
+        return;
+    }
+    
+    int total = end - begin;
+    int participants = static_cast<int>(m_workers.size()) + 1;
+    // 每个参与者分到若干块，兼顾负载均衡与调度开销
+    int chunk = std::max(std::max(minChunk, 1), total / (participants * 4));
+    int chunkCount = (total + chunk - 1) / chunk;
+    
+    if (chunkCount == 1 || m_workers.empty()) {
+        body(begin, end);
+        return;
+    }
+    
+    // 共享状态：块计数器与完成计数
+    struct State {
+        std::atomic<int> nextChunk{0};
+        std::atomic<int> finishedChunks{0};
+        std::mutex mutex;
+        std::condition_variable done;
+    };
+    auto state = std::make_shared<State>();
+    
+    auto runChunks = [state, begin, end, chunk, chunkCount, &body]() {
+        for (;;) {
+            int index = state->nextChunk.fetch_add(1);
+            if (index >= chunkCount) {
+                return;
+            }
+            int chunkBegin = begin + index * chunk;
+            body(chunkBegin, std::min(chunkBegin + chunk, end));
+            if (state->finishedChunks.fetch_add(1) + 1 == chunkCount) {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->done.notify_all();
+            }
+        }
+    };
+    
+    int helpers = std::min(static_cast<int>(m_workers.size()), chunkCount - 1);
+    for (int i = 0; i < helpers; i++) {
+        Submit(runChunks);
+    }
+    
+    // 调用线程也参与执行，然后等待其他线程已领取的块完成
+    runChunks();
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->done.wait(lock, [&]() { return state->finishedChunks.load() == chunkCount; });
+}
+
+ThreadPool& ThreadPool::GetDefault() {
+    static ThreadPool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+    return pool;
+}
+
+void ThreadPool::WorkerLoop() {
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]() { return m_stopping || !m_tasks.empty(); });
+            if (m_stopping && m_tasks.empty()) {
+                return;
+            }
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+        task();
+    }
+}
+
+}  // namespace WindowsAPI
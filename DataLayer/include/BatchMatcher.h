@@ -0,0 +1,174 @@
+#pragma once
+
+#include "BasicTypes.h"
+#include "ImageView.h"
+#include "TemplateMatcher.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+using namespace WindowsAPI;
+
+/**
+ * @namespace BatchMatcher
+ * @brief 多模板批量匹配
+ *
+ * 回答"这一帧里这几百个图标各自在哪"，而不是把单模板搜索重复几百次：
+ * - 模板预先编译为 TemplateSet：转灰度、按尺寸分组、计算签名
+ * - 足够大的尺寸组在 4x（或 2x）盒式缩小的大图上筛选，查询的位置数减为 1/16（或 1/4）。
+ *   模板在原图中的位置相对缩小块有 f x f 种相位，每种相位取模板内完整覆盖的块缩小为一个变体，
+ *   同组所有变体尺寸相同，原图每个位置恰好对应缩小图上的一个位置与一个变体
+ * - 签名为变体四个角块（各占一半宽高）的平均亮度与整体标准差，量化后
+ *   建立五维格子索引；缩小图每个位置的签名由积分图 O(1) 得到（整行向量化计算），
+ *   只查一个格子即可得到所有可能匹配的变体（通常为空）
+ * - 查格子之前先按 8x8 位置块做方差预筛选：块内窗口的方差不超过块覆盖区域的方差，
+ *   达不到组内最小标准差的块整块跳过（不影响结果）
+ * - 格子内同一模板的各相位变体签名相近，合为一段先按并集范围核对角块均值；
+ *   通过的段再逐个变体核对角块均值与标准差，然后在缩小图上计算变体的 NCC 得分，
+ *   达到 minScore 的位置回到原图核对 16 个采样点，最后一次遍历窗口得到标准差与完整的 NCC 得分
+ * - 按行分给线程池，每行依次处理所有尺寸组
+ *
+ * 预筛选假设图标以原始亮度与对比度出现（游戏/界面截图中通常如此），
+ * 亮度或对比度变化超过容差的匹配会被跳过；盒式缩小只去掉细节，缩小后得分达不到
+ * minScore 而原图得分达到的位置（相关性只在细节中的匹配）也会被跳过。
+ */
+namespace BatchMatcher {
+
+/**
+ * @brief 批量匹配选项
+ */
+struct BatchOptions {
+    double minScore = 0.8;      // 最低 NCC 得分
+    bool multithreaded = true;  // 是否使用默认线程池
+};
+
+/**
+ * @brief 单个模板的最佳匹配
+ */
+struct TemplateHit {
+    bool found = false;                // 最佳得分是否达到 minScore
+    TemplateMatcher::Match best;       // 通过预筛选的位置中得分最高的一个（score 为 -1 表示没有候选）
+};
+
+/**
+ * @brief 编译后的模板集合
+ *
+ * 所有模板的灰度像素保存在一块连续内存中；同尺寸的模板组成一组，
+ * 组内每个模板按缩小倍数的每种相位生成一个变体（不缩小的组每个模板一个变体）。
+ * 每组把四个角块的均值各量化为不超过 kMaxBins 个区间、标准差量化为不超过
+ * 4 个区间，变体登记到与其签名相差不超过容差的所有格子中，查询时只需看窗口自身所在的格子。
+ * 格子键由各区间下标拼成，非空格子用位图标记，按位图中的序号压缩存储。
+ */
+class TemplateSet {
+public:
+    static constexpr int kBinBits = 4;                // 每个角块的区间下标位数
+    static constexpr int kMaxBins = 11;               // 每个角块均值的最多区间数（不超过 1 << kBinBits）
+    static constexpr int kStdBits = 2;                // 标准差区间下标位数
+    static constexpr int kCellCount = 1 << (4 * kBinBits + kStdBits);  // 格子键数
+    static constexpr int kMaxStdArea = 66051;         // 平方和不超过32位的最大模板面积，更大的组不按标准差分格
+    static constexpr int kSampleCount = 16;           // 每个模板的采样点数（4x4 网格中心）
+    static constexpr int kMaxSampleMisses = 4;        // 允许超出采样容差的采样点数
+    static constexpr int kMinCoarseSize = 4;          // 缩小后变体的最小边长，达不到时改用更小的倍数
+
+    TemplateSet() = default;
+
+    /**
+     * @brief 编译模板
+     * @param templates 模板列表（BGRA32 或 GRAY8，宽高至少为 2）
+     * @param meanTolerance 预筛选容差：角块平均亮度与整体标准差允许的差（0-64 灰度级），
+     *                      采样点允许的差为 4 * meanTolerance + 8
+     * @return 模板集合
+     */
+    static Result<TemplateSet> Compile(const std::vector<ImageView>& templates, int meanTolerance = 12);
+
+    // 获取模板数量
+    int GetTemplateCount() const { return static_cast<int>(m_templates.size()); }
+
+    // 获取尺寸组数量
+    int GetGroupCount() const { return static_cast<int>(m_groups.size()); }
+
+    // 获取第 index 个模板的宽高
+    int GetTemplateWidth(int index) const { return m_templates[index].width; }
+    int GetTemplateHeight(int index) const { return m_templates[index].height; }
+
+private:
+    friend Result<std::vector<TemplateHit>> FindAll(const ImageView&, const TemplateSet&, const BatchOptions&);
+
+    // 单个模板
+    struct Entry {
+        int width = 0;
+        int height = 0;
+        size_t offset = 0;              // 在 m_pixels 中的起始位置（行跨度为 width）
+        double sum = 0.0;               // 像素和
+        double variance = 0.0;          // sumSq - sum^2 / n
+        double stdDev = 0.0;            // 标准差（灰度级）
+        std::array<std::uint16_t, kSampleCount> sampleX = {};  // 采样点相对模板左上角的位置
+        std::array<std::uint16_t, kSampleCount> sampleY = {};
+        std::array<std::uint8_t, kSampleCount> sampleValues = {};  // 采样点灰度
+    };
+
+    // 模板在一种相位下缩小后的签名
+    struct Variant {
+        int templateIndex = 0;
+        int phaseX = 0;                 // 模板内第一个完整缩小块的位置：原图位置 x = factor * X - phaseX
+        int phaseY = 0;
+        size_t offset = 0;              // 缩小后的像素在 m_coarsePixels 中的起始位置（行跨度为组的 coarseWidth）
+        double sum = 0.0;               // 缩小后的像素和
+        double variance = 0.0;          // 缩小后的 sumSq - sum^2 / n
+        double stdDev = 0.0;            // 缩小后的标准差
+    };
+
+    // 格子中的一个变体：角块和与下标放在一起，查格子时顺序读取
+    struct CellMember {
+        std::array<std::int32_t, 4> quadSums = {0, 0, 0, 0};  // 缩小后的四个角块和（左上、右上、左下、右下）
+        int variant = 0;                // 变体下标（m_variants）
+    };
+
+    // 格子中同一模板的一段变体：角块和允许的范围取段内各变体容差范围的并集
+    struct CellRun {
+        std::array<std::int32_t, 4> quadLow = {0, 0, 0, 0};   // 角块和下限（已计入容差）
+        std::array<std::int32_t, 4> quadHigh = {0, 0, 0, 0};  // 角块和上限（已计入容差）
+        int memberBegin = 0;            // 段内变体位于 cellMembers[memberBegin, memberEnd)
+        int memberEnd = 0;
+    };
+
+    // 同尺寸的一组模板
+    struct Group {
+        int width = 0;
+        int height = 0;
+        int factor = 1;                 // 筛选所用的缩小倍数（1、2 或 4）
+        int coarseWidth = 0;            // 变体的宽高（缩小后）
+        int coarseHeight = 0;
+        int quadWidth = 0;              // 变体角块宽度（coarseWidth / 2）
+        int quadHeight = 0;             // 变体角块高度（coarseHeight / 2）
+        double minStdDev = 0.0;         // 组内变体标准差的最小值（方差预筛选用）
+        std::vector<std::uint64_t> occupied;  // 非空格子的位图（kCellCount 位）
+        std::vector<int> wordRank;      // occupied 中每个字之前的非空格子数
+        std::vector<int> cellStart;     // 第 k 个非空格子的变体段位于 cellRuns[cellStart[k], cellStart[k + 1])
+        std::vector<CellRun> cellRuns;
+        std::vector<CellMember> cellMembers;
+    };
+
+    int m_tolerance = 0;
+    int m_sampleTolerance = 0;          // 采样点允许的灰度差
+    int m_binWidth = 0;                 // 均值量化区间宽度（灰度级）
+    int m_stdBinWidth = 0;              // 标准差量化区间宽度（灰度级）
+    std::vector<Entry> m_templates;
+    std::vector<Variant> m_variants;
+    std::vector<Group> m_groups;
+    std::vector<std::uint8_t> m_pixels;
+    std::vector<std::uint8_t> m_coarsePixels;  // 所有变体缩小后的灰度像素
+};
+
+/**
+ * @brief 在大图中查找集合内每个模板的最佳位置
+ * @param haystack 大图（BGRA32 或 GRAY8）
+ * @param templates 模板集合
+ * @param options 批量匹配选项
+ * @return 与模板顺序一致的结果列表；比大图还大的模板 found 为 false
+ */
+Result<std::vector<TemplateHit>> FindAll(const ImageView& haystack, const TemplateSet& templates,
+                                         const BatchOptions& options = BatchOptions());
+
+}  // namespace BatchMatcher
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "BasicTypes.h"
+#include "ImageView.h"
+
+#include <vector>
+
+using namespace WindowsAPI;
+
+/**
+ * @namespace Blobs
+ * @brief 掩码连通域分析
+ *
+ * 在颜色阈值化之后回答"所有面积超过 20 像素的红色块及其外接矩形与质心"：
+ * - 输入为 MONO1 掩码（如 ColorSearch::CreateMask 的结果）或 GRAY8 掩码（非 0 为前景）
+ * - 每行先压缩为游程 [x0, x1)，并查集的节点是游程而不是像素，两遍扫描都只访问游程数组
+ * - 大掩码按行带分给线程池：各行带独立提取游程并在带内合并，最后串行合并行带边界
+ * - 并查集总是把下标较大的根挂到较小的根下，标号按第一个像素的光栅顺序分配，结果与线程数无关
+ */
+namespace Blobs {
+
+/**
+ * @brief 连通方式
+ */
+enum class Connectivity {
+    FOUR,       // 上下左右相邻
+    EIGHT       // 含对角相邻
+};
+
+/**
+ * @brief 连通域分析选项
+ */
+struct LabelOptions {
+    Connectivity connectivity = Connectivity::EIGHT;
+    int minArea = 1;            // 面积小于该值的连通域不输出
+    bool multithreaded = true;  // 大掩码是否按行带并行
+};
+
+/**
+ * @brief 连通域
+ */
+struct Blob {
+    int area = 0;                   // 像素数
+    WindowsAPI::Rectangle bounds;   // 外接矩形（right、bottom 不含）
+    double centroidX = 0.0;         // 质心（像素中心坐标）
+    double centroidY = 0.0;
+};
+
+/**
+ * @brief 查找掩码中的连通域
+ * @param mask 掩码（MONO1 或 GRAY8）
+ * @param options 分析选项
+ * @return 按第一个像素的光栅顺序排列的连通域
+ */
+Result<std::vector<Blob>> FindBlobs(const ImageView& mask, const LabelOptions& options = LabelOptions());
+
+}  // namespace Blobs
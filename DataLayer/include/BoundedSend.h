@@ -0,0 +1,38 @@
+#pragma once
+
+#include "CommonTypes.h"
+
+using namespace WindowsAPI;
+
+/**
+ * @namespace BoundedSend
+ * @brief 限时同步消息
+ *
+ * SendMessage 在目标窗口挂起时会无限期阻塞调用线程。这里改用
+ * SendMessageTimeout(SMTO_ABORTIFHUNG)：超时或系统判定目标挂起时立即返回，
+ * 并报告本次调用的耗时，供 ServiceLayer 的窗口健康记录使用。
+ */
+namespace BoundedSend {
+
+/**
+ * @brief 一次限时发送的结果
+ */
+struct SendOutcome {
+    LRESULT result = 0;         // 目标窗口过程的返回值（未完成时为 0）
+    double latencyMs = 0.0;     // 调用耗时（毫秒）
+    bool completed = false;     // 目标是否在时限内处理完
+    bool hung = false;          // 未完成且系统判定目标挂起（SMTO_ABORTIFHUNG 立即返回）
+};
+
+/**
+ * @brief 限时发送消息
+ * @param windowHandle 目标窗口句柄
+ * @param message 消息
+ * @param wParam 参数
+ * @param lParam 参数（字符串参数由系统跨进程封送）
+ * @param timeoutMs 时限（毫秒）
+ * @return 发送结果；超时与挂起不是错误，由 completed/hung 表示；句柄无效时为 INVALID_HANDLE
+ */
+Result<SendOutcome> Send(HWND windowHandle, UINT message, WPARAM wParam, LPARAM lParam, UINT timeoutMs);
+
+}  // namespace BoundedSend
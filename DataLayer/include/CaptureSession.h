@@ -0,0 +1,112 @@
+#pragma once
+
+#include "BasicTypes.h"
+#include "ImageView.h"
+
+#include <cstdint>
+#include <memory>
+
+using namespace WindowsAPI;
+
+namespace ScreenCapture {
+
+/**
+ * @brief 捕获表面（由后端分配的32位BGRA像素缓冲）
+ */
+struct CaptureSurface {
+    std::uint8_t* pixels;
+    int width;
+    int height;
+    int stride;
+    
+    CaptureSurface() : pixels(nullptr), width(0), height(0), stride(0) {}
+};
+
+/**
+ * @brief 捕获后端接口
+ * 
+ * 将平台相关的表面分配与抓取操作从会话的复用逻辑中分离出来：
+ * Windows 下由 GDI 后端实现，测试和基准中可替换为假后端。
+ */
+class CaptureBackend {
+public:
+    virtual ~CaptureBackend() = default;
+
+    /**
+     * @brief 查询捕获源当前的尺寸
+     * @return 以(0,0)为原点的源矩形
+     */
+    virtual Result<WindowsAPI::Rectangle> QuerySourceBounds() = 0;
+
+    /**
+     * @brief 分配指定尺寸的捕获表面（会先释放已有表面）
+     * @param width 宽度
+     * @param height 高度
+     * @return 新分配的表面
+     */
+    virtual Result<CaptureSurface> AllocateSurface(int width, int height) = 0;
+
+    /**
+     * @brief 释放当前捕获表面
+     */
+    virtual void ReleaseSurface() = 0;
+
+    /**
+     * @brief 将源内容直接写入表面
+     * @param surface 由 AllocateSurface 返回的表面
+     * @return 操作结果
+     */
+    virtual Result<bool> Grab(const CaptureSurface& surface) = 0;
+};
+
+/**
+ * @brief 持久捕获会话
+ * 
+ * 绑定一个捕获源，跨帧复用后端表面：
+ * - 仅在源尺寸变化时重新分配表面
+ * - 像素直接写入表面，不再复制到 ImageData
+ * - 返回只读视图，视图在下一次 Capture() 或 Reset() 之前有效
+ */
+class CaptureSession {
+public:
+    /**
+     * @brief 会话统计信息
+     */
+    struct Statistics {
+        std::uint64_t frameCount = 0;       // 成功捕获的帧数
+        std::uint64_t allocationCount = 0;  // 表面分配次数
+    };
+
+public:
+    explicit CaptureSession(std::unique_ptr<CaptureBackend> backend);
+    ~CaptureSession();
+
+    CaptureSession(const CaptureSession&) = delete;
+    CaptureSession& operator=(const CaptureSession&) = delete;
+
+    /**
+     * @brief 捕获一帧
+     * @return 指向会话内部表面的只读视图
+     */
+    Result<ImageView> Capture();
+
+    /**
+     * @brief 释放当前表面，下一次捕获时重新分配
+     */
+    void Reset();
+
+    const Statistics& GetStatistics() const { return m_statistics; }
+    int GetSurfaceWidth() const { return m_surface.width; }
+    int GetSurfaceHeight() const { return m_surface.height; }
+
+private:
+    Result<bool> EnsureSurface(int width, int height);
+
+private:
+    std::unique_ptr<CaptureBackend> m_backend;
+    CaptureSurface m_surface;
+    bool m_hasSurface = false;
+    Statistics m_statistics;
+};
+
+}  // namespace ScreenCapture
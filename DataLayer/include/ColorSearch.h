@@ -0,0 +1,141 @@
+#pragma once
+
+#include "BasicTypes.h"
+#include "ImageView.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+using namespace WindowsAPI;
+
+/**
+ * @namespace ColorSearch
+ * @brief 颜色范围搜索
+ *
+ * 在 BGRA 图像中查找颜色落在指定范围内的像素：
+ * - BGR 容差范围或 HSV 范围两种判定方式
+ * - 行优先或由起点向外螺旋的搜索顺序，命中数达到上限即提前结束
+ * - 运行时选择 AVX2/SSE2 内核，大图按行带分给线程池并行扫描
+ * - 也可以输出整幅图的命中掩码（MONO1），交给 Blobs 做连通域分析
+ */
+namespace ColorSearch {
+
+/**
+ * @brief 每通道颜色范围（闭区间）
+ */
+struct ColorRange {
+    std::array<std::uint8_t, 4> low = {0, 0, 0, 0};          // 下界（B,G,R,A）
+    std::array<std::uint8_t, 4> high = {255, 255, 255, 255};  // 上界（B,G,R,A）
+
+    /**
+     * @brief 以某个颜色为中心、各颜色通道相同容差构造范围（忽略Alpha）
+     * @param r 红
+     * @param g 绿
+     * @param b 蓝
+     * @param tolerance 容差
+     */
+    static ColorRange FromRgb(std::uint8_t r, std::uint8_t g, std::uint8_t b, std::uint8_t tolerance = 0) {
+        auto lower = [tolerance](std::uint8_t v) { return static_cast<std::uint8_t>(v > tolerance ? v - tolerance : 0); };
+        auto upper = [tolerance](std::uint8_t v) {
+            return static_cast<std::uint8_t>(255 - v > tolerance ? v + tolerance : 255);
+        };
+        ColorRange range;
+        range.low = {lower(b), lower(g), lower(r), 0};
+        range.high = {upper(b), upper(g), upper(r), 255};
+        return range;
+    }
+};
+
+/**
+ * @brief HSV 范围（闭区间）
+ *
+ * 色相单位为度（0-359），hueMin 大于 hueMax 时表示跨越 0 度的区间（如红色 340-20）；
+ * 饱和度与明度按 0-255 表示。
+ */
+struct HsvRange {
+    int hueMin = 0;
+    int hueMax = 359;
+    std::uint8_t saturationMin = 0;
+    std::uint8_t saturationMax = 255;
+    std::uint8_t valueMin = 0;
+    std::uint8_t valueMax = 255;
+};
+
+/**
+ * @brief 搜索顺序
+ */
+enum class SearchOrder {
+    RASTER,     // 从起点开始行优先扫描，到末尾后回绕到图像开头
+    SPIRAL      // 按与起点的切比雪夫距离由近到远，同一圈内按行优先
+};
+
+/**
+ * @brief 搜索选项
+ */
+struct SearchOptions {
+    SearchOrder order = SearchOrder::RASTER;
+    Point start;                 // 搜索起点（图像坐标）
+    int maxResults = 0;          // 命中数上限，0 表示不限
+    bool multithreaded = true;   // 大图是否按行带并行扫描
+};
+
+/**
+ * @brief 查找第一个颜色在范围内的像素
+ * @param image 图像（BGRA32）
+ * @param range 颜色范围
+ * @param options 搜索选项（maxResults 被忽略）
+ * @return 命中点列表，未找到时为空
+ */
+Result<std::vector<Point>> FindColor(const ImageView& image, const ColorRange& range,
+                                     const SearchOptions& options = SearchOptions());
+
+/**
+ * @brief 查找所有颜色在范围内的像素
+ * @param image 图像（BGRA32）
+ * @param range 颜色范围
+ * @param options 搜索选项
+ * @return 按搜索顺序排列的命中点列表
+ */
+Result<std::vector<Point>> FindAllColors(const ImageView& image, const ColorRange& range,
+                                         const SearchOptions& options = SearchOptions());
+
+/**
+ * @brief 查找第一个 HSV 在范围内的像素
+ * @param image 图像（BGRA32）
+ * @param range HSV 范围
+ * @param options 搜索选项（maxResults 被忽略）
+ * @return 命中点列表，未找到时为空
+ */
+Result<std::vector<Point>> FindColor(const ImageView& image, const HsvRange& range,
+                                     const SearchOptions& options = SearchOptions());
+
+/**
+ * @brief 查找所有 HSV 在范围内的像素
+ * @param image 图像（BGRA32）
+ * @param range HSV 范围
+ * @param options 搜索选项
+ * @return 按搜索顺序排列的命中点列表
+ */
+Result<std::vector<Point>> FindAllColors(const ImageView& image, const HsvRange& range,
+                                         const SearchOptions& options = SearchOptions());
+
+/**
+ * @brief 生成颜色在范围内的像素掩码
+ * @param image 图像（BGRA32）
+ * @param range 颜色范围
+ * @param multithreaded 大图是否按行带并行扫描
+ * @return MONO1 掩码，命中像素为 1
+ */
+Result<ImageData> CreateMask(const ImageView& image, const ColorRange& range, bool multithreaded = true);
+
+/**
+ * @brief 生成 HSV 在范围内的像素掩码
+ * @param image 图像（BGRA32）
+ * @param range HSV 范围
+ * @param multithreaded 大图是否按行带并行扫描
+ * @return MONO1 掩码，命中像素为 1
+ */
+Result<ImageData> CreateMask(const ImageView& image, const HsvRange& range, bool multithreaded = true);
+
+}  // namespace ColorSearch
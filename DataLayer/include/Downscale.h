@@ -0,0 +1,91 @@
+#pragma once
+
+#include "BasicTypes.h"
+#include "ImageView.h"
+
+#include <cstdint>
+
+using namespace WindowsAPI;
+
+/**
+ * @namespace Downscale
+ * @brief 图像缩小
+ *
+ * 实时预览缩略图与匹配金字塔都需要缩小后的帧：
+ * - 2x/4x 盒式滤波：每个输出像素是 factor x factor 个源像素的四舍五入平均
+ * - 任意比例的面积平均：按输出像素覆盖的源面积加权（8 位定点权重，误差不超过 2 级）
+ *
+ * 先纵向累加到 16 位行缓冲，再横向归约，两遍都使用 SSE2/AVX2 内核；
+ * 大图按输出行带分给线程池。输出写入调用方提供的缓冲，反复缩放同尺寸的帧不再分配内存。
+ * 支持 BGRA32、RGBA32 与 GRAY8。
+ */
+namespace Downscale {
+
+/**
+ * @brief 缩小选项
+ */
+struct DownscaleOptions {
+    bool multithreaded = true;  // 大图是否按行带并行
+};
+
+/**
+ * @brief 是否支持该像素格式
+ */
+bool IsSupported(PixelFormat format);
+
+/**
+ * @brief 盒式滤波缩小到调用方提供的缓冲区
+ *
+ * 输出尺寸为 source.width / factor x source.height / factor，不足一个块的右侧与底部余量被丢弃。
+ *
+ * @param source 源视图
+ * @param factor 缩小倍数（2 或 4）
+ * @param destination 目标首行地址，不能与源重叠
+ * @param destinationStride 目标行跨度（字节）
+ * @param options 缩小选项
+ * @return 是否成功
+ */
+Result<bool> BoxRows(const ImageView& source, int factor, std::uint8_t* destination, int destinationStride,
+                     const DownscaleOptions& options = DownscaleOptions());
+
+/**
+ * @brief 盒式滤波缩小到 ImageData
+ *
+ * output 已有的内存足够时直接复用；输出行跨度按4字节对齐。
+ *
+ * @param source 源视图
+ * @param factor 缩小倍数（2 或 4）
+ * @param output 输出图像（不能是 source 引用的图像）
+ * @param options 缩小选项
+ * @return 是否成功
+ */
+Result<bool> Box(const ImageView& source, int factor, ImageData& output,
+                 const DownscaleOptions& options = DownscaleOptions());
+
+/**
+ * @brief 面积平均缩小到调用方提供的缓冲区
+ * @param source 源视图
+ * @param width 输出宽度（1 到 source.width）
+ * @param height 输出高度（1 到 source.height）
+ * @param destination 目标首行地址，不能与源重叠
+ * @param destinationStride 目标行跨度（字节）
+ * @param options 缩小选项
+ * @return 是否成功
+ */
+Result<bool> AreaRows(const ImageView& source, int width, int height,
+                      std::uint8_t* destination, int destinationStride,
+                      const DownscaleOptions& options = DownscaleOptions());
+
+/**
+ * @brief 面积平均缩小到 ImageData
+ * @param source 源视图
+ * @param width 输出宽度（1 到 source.width）
+ * @param height 输出高度（1 到 source.height）
+ * @param output 输出图像，已有内存足够时直接复用
+ * @param options 缩小选项
+ * @return 是否成功
+ */
+Result<bool> Area(const ImageView& source, int width, int height, ImageData& output,
+                  const DownscaleOptions& options = DownscaleOptions());
+
+}  // namespace Downscale
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "BasicTypes.h"
+#include "ImageView.h"
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+
+using namespace WindowsAPI;
+
+/**
+ * @namespace EdgeMap
+ * @brief 梯度幅值与方向图（抗光照/主题变化的匹配特征）
+ *
+ * 主题切换、悬停高亮、日夜配色会改变颜色与亮度，但很少改变轮廓：
+ * - 3x3 Sobel 或 Scharr 算子，SSE2/AVX2 行内核按 16 位整数计算水平与竖直梯度
+ * - 幅值为 |gx| + |gy| 按算子归一化后饱和到 0-255（亮度阶跃 255 的理想边缘幅值为 255）
+ * - 方向按 1/256 圈量化（0 指向右，64 指向下，即亮度增加的方向）
+ * - 图像边界按复制边缘像素处理，大图按行带并行
+ *
+ * 在幅值图上做 NCC 模板匹配，同一个模板可以应对颜色与明暗反转；
+ * 也可以直接使用 TemplateMatcher 的 MatchFeatures::EDGES。
+ */
+namespace EdgeMap {
+
+/**
+ * @brief 梯度算子
+ */
+enum class Operator {
+    SOBEL,      // 权重 1-2-1
+    SCHARR      // 权重 3-10-3，方向更准确
+};
+
+/**
+ * @brief 梯度计算选项
+ */
+struct EdgeOptions {
+    Operator op = Operator::SOBEL;
+    bool multithreaded = true;      // 大图是否按行带并行
+};
+
+/**
+ * @brief 梯度幅值与方向
+ */
+struct GradientMaps {
+    ImageData magnitude;            // GRAY8 幅值
+    ImageData orientation;          // GRAY8 方向（1/256 圈，幅值为 0 处为 0）
+};
+
+/**
+ * @brief 计算梯度幅值图
+ * @param image 图像（GRAY8 或 BGRA32，BGRA32 先转灰度）
+ * @param options 计算选项
+ * @return 与输入同尺寸的 GRAY8 幅值图
+ */
+Result<ImageData> ComputeMagnitude(const ImageView& image, const EdgeOptions& options = EdgeOptions());
+
+/**
+ * @brief 计算梯度幅值图与方向图
+ * @param image 图像（GRAY8 或 BGRA32，BGRA32 先转灰度）
+ * @param options 计算选项
+ * @return 幅值图与方向图
+ */
+Result<GradientMaps> ComputeGradients(const ImageView& image, const EdgeOptions& options = EdgeOptions());
+
+/**
+ * @brief 静态模板的幅值图缓存
+ *
+ * 按调用方分配的模板编号缓存幅值图，同一模板只计算一次。
+ * 编号由调用方保证唯一（如模板在资源表中的下标），不依赖像素地址：
+ * 模板释放后地址被新模板复用也不会取到旧的幅值图。
+ * 编号对应的模板内容改变时应调用 Remove 或换用新编号。
+ * 多线程可以同时查询；返回的视图在该编号被移除、Clear 或缓存销毁之前一直有效。
+ */
+class TemplateCache {
+public:
+    explicit TemplateCache(Operator op = Operator::SOBEL) : m_operator(op) {}
+
+    TemplateCache(const TemplateCache&) = delete;
+    TemplateCache& operator=(const TemplateCache&) = delete;
+
+    /**
+     * @brief 获取模板的幅值图，首次查询时计算
+     * @param templateId 模板编号（非负，由调用方分配）
+     * @param templ 模板（GRAY8 或 BGRA32）
+     * @return 幅值图视图；编号已缓存但尺寸与 templ 不同时返回 INVALID_PARAMETER
+     */
+    Result<ImageView> Get(int templateId, const ImageView& templ);
+
+    // 获取缓存使用的算子
+    Operator GetOperator() const { return m_operator; }
+
+    // 获取已缓存的模板数
+    size_t GetSize() const;
+
+    // 移除一个模板的幅值图，返回是否存在
+    bool Remove(int templateId);
+
+    // 清空缓存
+    void Clear();
+
+private:
+    Operator m_operator;
+    mutable std::mutex m_mutex;
+    std::map<int, ImageData> m_maps;    // 节点容器：插入新模板不会使已返回的视图失效
+};
+
+}  // namespace EdgeMap
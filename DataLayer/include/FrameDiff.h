@@ -0,0 +1,73 @@
+#pragma once
+
+#include "BasicTypes.h"
+#include "ImageView.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+using namespace WindowsAPI;
+
+/**
+ * @namespace FrameDiff
+ * @brief 帧差异检测
+ * 
+ * 比较两帧 BGRA 图像，回答"窗口有没有变化、哪里变了"：
+ * - 按瓦片统计变化像素，合并为脏矩形列表
+ * - 每通道容差，忽略压缩与抗锯齿噪声
+ * - 运行时选择 AVX2/SSE2 内核，无 SIMD 时使用标量实现
+ */
+namespace FrameDiff {
+
+/**
+ * @brief 差异检测选项
+ */
+struct DiffOptions {
+    int tileSize = 32;  // 瓦片边长（像素）
+    
+    // 每通道容差（B,G,R,A），差值不超过容差视为相同；默认忽略Alpha通道
+    std::array<std::uint8_t, 4> channelTolerance = {0, 0, 0, 255};
+    
+    // 统一设置颜色通道容差（Alpha通道保持不变）
+    void SetColorTolerance(std::uint8_t tolerance) {
+        channelTolerance[0] = tolerance;
+        channelTolerance[1] = tolerance;
+        channelTolerance[2] = tolerance;
+    }
+};
+
+/**
+ * @brief 差异检测结果
+ */
+struct DiffResult {
+    std::vector<WindowsAPI::Rectangle> dirtyRects;  // 合并后的脏矩形（像素坐标）
+    std::uint64_t changedPixels = 0;                 // 变化像素数
+    std::uint64_t totalPixels = 0;                   // 总像素数
+    double changedRatio = 0.0;                       // 变化像素占比
+    int dirtyTileCount = 0;                          // 脏瓦片数
+    
+    bool HasChanges() const { return changedPixels != 0; }
+};
+
+/**
+ * @brief 比较两帧并输出脏矩形
+ * @param previous 上一帧（BGRA32）
+ * @param current 当前帧（BGRA32，尺寸必须与上一帧相同）
+ * @param options 检测选项
+ * @return 差异结果
+ */
+Result<DiffResult> Compare(const ImageView& previous, const ImageView& current,
+                           const DiffOptions& options = DiffOptions());
+
+/**
+ * @brief 快速判断两帧是否有差异（发现第一处变化即返回）
+ * @param previous 上一帧（BGRA32）
+ * @param current 当前帧（BGRA32，尺寸必须与上一帧相同）
+ * @param options 检测选项（仅使用容差）
+ * @return 是否有变化
+ */
+Result<bool> HasChanged(const ImageView& previous, const ImageView& current,
+                        const DiffOptions& options = DiffOptions());
+
+}  // namespace FrameDiff
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "BasicTypes.h"
+#include "ImageView.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace WindowsAPI;
+
+/**
+ * @namespace GlyphReader
+ * @brief 固定界面字体的字形识别（读取计数器、计时器与短标签）
+ *
+ * 不依赖外部 OCR 引擎，适用于像素级固定的界面字体：
+ * - 从样本截图与对应文本学习字形模板（同一字符可以有多个模板）
+ * - 识别时先二值化文本区域，按列投影切分字形，笔画相连的宽字形再贪心拆分
+ * - 模板与待识别字形都放在固定行宽的 0/0xFF 缓冲区中居中对齐，
+ *   每个候选偏移的比较是一次连续的 SIMD SAD（不同像素数 = SAD / 255）
+ *
+ * 10 位数字计数器的识别耗时为数十微秒量级。只支持单行文本，字形不缩放。
+ */
+namespace GlyphReader {
+
+constexpr int kMaxGlyphWidth = 48;      // 单个字形的最大宽度（像素）
+constexpr int kMaxLineHeight = 64;      // 文本行的最大高度（像素）
+constexpr wchar_t kUnknownGlyph = L'?'; // 得分低于 minScore 的字形
+
+/**
+ * @brief 文字极性
+ */
+enum class Polarity {
+    AUTO,           // 像素数较少的一侧为文字
+    DARK_ON_LIGHT,  // 浅色背景上的深色文字
+    LIGHT_ON_DARK   // 深色背景上的浅色文字
+};
+
+/**
+ * @brief 二值化选项
+ */
+struct BinarizeOptions {
+    Polarity polarity = Polarity::AUTO;
+    int threshold = -1;         // 灰度阈值，-1 表示取区域最亮与最暗灰度的中点
+    int minContrast = 40;       // 区域灰度极差低于该值时视为没有文字
+};
+
+/**
+ * @brief 识别选项
+ */
+struct ReadOptions {
+    BinarizeOptions binarize;
+    double minScore = 0.75;     // 字形得分低于该值时输出 kUnknownGlyph
+    int spaceGap = 0;           // 字形间隔不小于该值时插入空格，0 表示使用学习到的间隔（未学到空格时不插入）
+};
+
+/**
+ * @brief 识别出的字形
+ */
+struct Glyph {
+    wchar_t character = kUnknownGlyph;
+    WindowsAPI::Rectangle bounds;   // 字形墨迹的外接矩形（区域坐标）
+    double confidence = 0.0;        // 最佳模板的得分（0-1，1 表示逐像素一致）
+};
+
+/**
+ * @brief 识别结果
+ */
+struct ReadResult {
+    std::wstring text;
+    std::vector<Glyph> glyphs;      // 不含空格
+    double confidence = 0.0;        // 所有字形得分的最小值（没有字形时为 0）
+};
+
+/**
+ * @brief 字形模板集合
+ *
+ * 所有模板都是行高 x 64 字节的 0/0xFF 块，连续存放在同一个数组中。
+ * 第一个样本决定行高，之后的样本行高必须相同。
+ */
+class Font {
+public:
+    Font() = default;
+
+    /**
+     * @brief 从样本截图学习字形
+     *
+     * 样本中切分出的字形数必须等于文本中非空格字符数；文本中的空格用来学习空格间隔。
+     *
+     * @param sample 单行文本截图（BGRA32 或 GRAY8）
+     * @param text 截图中的文本
+     * @param options 二值化选项
+     * @return 新增的模板数
+     */
+    Result<int> Learn(const ImageView& sample, const std::wstring& text,
+                      const BinarizeOptions& options = BinarizeOptions());
+
+    /**
+     * @brief 识别文本区域
+     * @param region 单行文本区域（BGRA32 或 GRAY8）
+     * @param options 识别选项
+     * @return 识别结果；区域对比度不足时返回空文本
+     */
+    Result<ReadResult> Read(const ImageView& region, const ReadOptions& options = ReadOptions()) const;
+
+    // 获取模板数
+    int GetGlyphCount() const { return static_cast<int>(m_characters.size()); }
+
+    // 获取行高（尚未学习时为 0）
+    int GetLineHeight() const { return m_lineHeight; }
+
+    // 获取学习到的空格间隔（未学到空格时为 0）
+    int GetSpaceGap() const { return m_spaceGap; }
+
+    // 清空所有模板
+    void Clear();
+
+private:
+    int m_lineHeight = 0;
+    int m_maxWidth = 0;                     // 最宽模板的宽度
+    int m_maxGlyphGap = 0;                  // 样本中相邻字形的最大间隔
+    int m_minSpaceGap = 0;                  // 样本中空格两侧字形的最小间隔
+    int m_spaceGap = 0;
+    std::vector<wchar_t> m_characters;
+    std::vector<int> m_widths;
+    std::vector<int> m_inks;                // 每个模板的墨迹像素数
+    std::vector<std::uint8_t> m_cells;      // 模板 t 位于 [t * 块大小, (t + 1) * 块大小)
+};
+
+}  // namespace GlyphReader
@@ -0,0 +1,235 @@
+#pragma once
+
+#include "BasicTypes.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace WindowsAPI;
+
+/**
+ * @namespace InputDispatcher
+ * @brief 异步批量输入派发
+ *
+ * KeyboardSimulator/MouseSimulator 的每个函数都同步 SendMessage 并重新调用 IsWindow，
+ * 调用线程要等目标窗口的消息循环处理完每一个事件：
+ * - 调用方按窗口提交一批按键、字符与鼠标事件，立即得到这一批的完成 future
+ * - 批次进入无锁多生产者单消费者队列，专用的派发线程按提交顺序取出
+ * - 每批只校验一次窗口句柄，再按事件的投递方式逐个交给输入接收端
+ * - 接收端可替换：Windows 下为 PostMessage/SendMessage（见 CreateWin32Sink），
+ *   测试和基准中为记录事件的假接收端
+ */
+namespace InputDispatcher {
+
+// 窗口句柄（Windows 下即 HWND）
+using WindowHandle = void*;
+
+/**
+ * @brief 输入事件类型
+ */
+enum class EventType {
+    KEY_DOWN,       // code 为虚拟键码
+    KEY_UP,
+    CHAR,           // code 为 UTF-16 码元
+    MOUSE_MOVE,     // x、y 为客户区坐标，held 为按住的按键
+    BUTTON_DOWN,
+    BUTTON_UP,
+    WHEEL           // delta 为滚动格数（正值向上）
+};
+
+/**
+ * @brief 投递方式
+ *
+ * 同一窗口的投递事件之间保持顺序；同步事件在前一个事件交出后才发送，返回后才处理下一个事件。
+ * 投递的事件排在目标线程的消息队列里，会晚于之后同步发送的事件被处理（如移动晚于按键释放），
+ * 因此 AUTO 按整批解析以保持批内顺序：整批都可投递（只含鼠标移动、滚轮或显式 POST 的事件）时
+ * 全部投递，批内只要有一个同步发送的事件，所有 AUTO 事件都同步发送。
+ * 显式指定 POST 与 SEND 的事件按指定方式派发，混用时由调用方承担乱序。
+ */
+enum class Delivery {
+    AUTO,           // 整批都可投递时投递，否则同步发送
+    POST,           // 投递（PostMessage），不等待目标处理
+    SEND            // 同步发送（SendMessage），等待目标处理完
+};
+
+/**
+ * @brief 按键在 InputEvent::held 中的位
+ */
+constexpr std::uint8_t HeldMask(MouseButton button) {
+    return static_cast<std::uint8_t>(1u << static_cast<int>(button));
+}
+
+/**
+ * @brief 单个输入事件
+ */
+struct InputEvent {
+    EventType type = EventType::KEY_DOWN;
+    Delivery delivery = Delivery::AUTO;
+    std::uint32_t code = 0;
+    int x = 0;
+    int y = 0;
+    int delta = 0;
+    MouseButton button = MouseButton::LEFT;     // BUTTON_DOWN/BUTTON_UP 的按键
+    std::uint8_t held = 0;                      // MOUSE_MOVE 时按住的按键（HeldMask 的按位或），默认不按任何键
+
+    static InputEvent KeyDown(std::uint32_t virtualKey);
+    static InputEvent KeyUp(std::uint32_t virtualKey);
+    static InputEvent Char(wchar_t character);
+    static InputEvent MouseMove(int x, int y, std::uint8_t held = 0);
+    static InputEvent MouseMove(int x, int y, MouseButton held);
+    static InputEvent ButtonDown(int x, int y, MouseButton button = MouseButton::LEFT);
+    static InputEvent ButtonUp(int x, int y, MouseButton button = MouseButton::LEFT);
+    static InputEvent Wheel(int x, int y, int delta);
+
+    // 指定投递方式
+    InputEvent& Via(Delivery mode) {
+        delivery = mode;
+        return *this;
+    }
+};
+
+/**
+ * @brief 事件单独成批时是否可投递：显式 POST，或 AUTO 的鼠标移动与滚轮
+ */
+bool IsPostable(const InputEvent& event);
+
+/**
+ * @brief 整批事件是否都可投递
+ */
+bool IsPostableBatch(const std::vector<InputEvent>& events);
+
+/**
+ * @brief 解析 AUTO 投递方式
+ * @param event 事件
+ * @param postableBatch 事件所在的整批是否都可投递（见 IsPostableBatch），否则 AUTO 同步发送
+ * @return POST 或 SEND
+ */
+Delivery ResolveDelivery(const InputEvent& event, bool postableBatch);
+
+/**
+ * @brief 输入接收端接口
+ *
+ * 只在派发线程上调用，实现不需要加锁。
+ */
+class InputSink {
+public:
+    virtual ~InputSink() = default;
+
+    /**
+     * @brief 开始一批事件：校验窗口句柄，可在此读取整批共用的状态（如修饰键）
+     * @param window 目标窗口
+     * @return 失败时整批不派发
+     */
+    virtual Result<bool> BeginBatch(WindowHandle window) = 0;
+
+    /**
+     * @brief 派发单个事件
+     * @param window 目标窗口
+     * @param event 事件
+     * @param delivery 解析后的投递方式（POST 或 SEND）
+     * @return 失败时这一批剩余的事件不再派发
+     */
+    virtual Result<bool> Deliver(WindowHandle window, const InputEvent& event, Delivery delivery) = 0;
+};
+
+/**
+ * @brief 在调用线程上同步派发一批事件（不经过派发线程）
+ *
+ * 规则与 Dispatcher 相同：先调用一次 BeginBatch，按整批解析投递方式，某个事件失败后剩余的事件不再派发。
+ * KeyboardSimulator/MouseSimulator 的单个操作也经由它派发，传入录制接收端即可录制。
+ *
+ * @param sink 接收端
+ * @param window 目标窗口
+ * @param events 事件
+ * @return 已派发的事件数
+ */
+Result<int> DeliverBatch(InputSink& sink, WindowHandle window, const std::vector<InputEvent>& events);
+
+/**
+ * @brief 带专用派发线程的输入派发器
+ *
+ * 提交不加锁、不等待目标窗口；批次按提交顺序派发（多个线程同时提交时按进入队列的顺序）。
+ * 析构时先派发完已提交的批次再退出派发线程。
+ */
+class Dispatcher {
+public:
+    /**
+     * @brief 派发统计
+     */
+    struct Statistics {
+        std::uint64_t batchCount = 0;       // 已完成的批次（含失败）
+        std::uint64_t postedCount = 0;      // 投递的事件数
+        std::uint64_t sentCount = 0;        // 同步发送的事件数
+        std::uint64_t failedBatchCount = 0; // 句柄无效或派发失败的批次
+    };
+
+public:
+    explicit Dispatcher(std::unique_ptr<InputSink> sink);
+    ~Dispatcher();
+
+    Dispatcher(const Dispatcher&) = delete;
+    Dispatcher& operator=(const Dispatcher&) = delete;
+
+    /**
+     * @brief 提交一批事件
+     * @param window 目标窗口
+     * @param events 按顺序派发的事件
+     * @return 完成时得到已派发的事件数；句柄无效为 INVALID_HANDLE，派发失败为接收端的错误
+     */
+    std::future<Result<int>> Submit(WindowHandle window, std::vector<InputEvent> events);
+
+    /**
+     * @brief 等待此前提交的所有批次派发完成
+     */
+    void WaitIdle();
+
+    Statistics GetStatistics() const;
+
+private:
+    // 队列节点：一批事件
+    struct Batch {
+        std::atomic<Batch*> next{nullptr};
+        WindowHandle window = nullptr;
+        std::vector<InputEvent> events;
+        std::promise<Result<int>> completion;
+    };
+
+    // 入队（任意线程，无锁：一次原子交换加一次存储）
+    void Push(Batch* batch);
+    // 出队（只在派发线程调用）；生产者尚未链接完成时返回 nullptr
+    Batch* Pop();
+    void PumpLoop();
+    Result<int> Dispatch(const Batch& batch);
+
+private:
+    std::unique_ptr<InputSink> m_sink;
+
+    // Vyukov 侵入式 MPSC 队列：m_head 为最后入队的节点，m_tail 为下一个出队的节点
+    std::atomic<Batch*> m_head;
+    Batch* m_tail;
+    Batch m_stub;
+
+    std::atomic<std::uint64_t> m_submitted{0};  // 已入队的批次数
+    std::atomic<std::uint64_t> m_completed{0};  // 已完成的批次数
+    std::atomic<bool> m_sleeping{false};
+    std::atomic<bool> m_stopping{false};
+    std::atomic<int> m_idleWaiters{0};          // 正在 WaitIdle 的线程数
+    std::mutex m_mutex;                         // 只在派发线程休眠/唤醒与 WaitIdle 时使用
+    std::condition_variable m_wake;
+    std::condition_variable m_idle;
+
+    std::atomic<std::uint64_t> m_batchCount{0};
+    std::atomic<std::uint64_t> m_postedCount{0};
+    std::atomic<std::uint64_t> m_sentCount{0};
+    std::atomic<std::uint64_t> m_failedBatchCount{0};
+
+    std::thread m_pump;
+};
+
+}  // namespace InputDispatcher
@@ -0,0 +1,237 @@
+#pragma once
+
+#include "BasicTypes.h"
+#include "InputDispatcher.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace WindowsAPI;
+
+/**
+ * @namespace InputMacro
+ * @brief 输入宏的二进制录制与定时回放
+ *
+ * 录制与窗口无关的输入事件序列，回放到任意多个窗口：
+ * - Recorder 记录事件与时间（可用 CreateRecordingSink 挂在 InputDispatcher 的接收端前面，
+ *   记录经过派发器的所有事件；传给 KeyboardSimulator/MouseSimulator 带 sink 的重载时记录单个操作）
+ * - 二进制格式：16 字节头 + 逐事件编码（标签字节、与上一事件的微秒间隔 varint、
+ *   键码 varint 或与上一鼠标坐标的 zigzag varint 差值，按住按键的移动另加一个字节），
+ *   悬停的鼠标移动通常只占 4~5 字节
+ * - MacroView 直接在内存（如 MappedMacro 的文件映射）上解码，打开时只检查文件头，
+ *   加载数千个宏不需要解析
+ * - Replay 用先休眠、最后一段自旋的混合等待按时间表派发，并报告每个事件的延迟分位数
+ */
+namespace InputMacro {
+
+using InputDispatcher::InputEvent;
+using InputDispatcher::InputSink;
+using InputDispatcher::WindowHandle;
+using Clock = std::chrono::steady_clock;
+
+constexpr std::uint32_t kMagic = 0x434D4157;    // "WAMC"（小端）
+constexpr std::uint16_t kVersion = 2;           // 2：鼠标移动记录按住的按键，不再借用 button
+constexpr size_t kHeaderSize = 16;              // magic u32、version u16、保留 u16、事件数 u32、负载字节数 u32
+
+/**
+ * @brief 带时间的事件
+ */
+struct TimedEvent {
+    std::uint64_t timeUs = 0;   // 距录制开始的微秒数
+    InputEvent event;
+};
+
+/**
+ * @brief 宏录制器（线程安全）
+ */
+class Recorder {
+public:
+    Recorder() { Start(); }
+
+    Recorder(const Recorder&) = delete;
+    Recorder& operator=(const Recorder&) = delete;
+
+    /**
+     * @brief 清空并重新开始录制
+     * @param origin 时间零点
+     */
+    void Start(Clock::time_point origin = Clock::now());
+
+    /**
+     * @brief 记录一个事件
+     *
+     * 早于上一事件的时间按上一事件计（多个线程同时记录时保持时间单调）。
+     *
+     * @param event 事件
+     * @param when 事件发生的时间
+     */
+    void Record(const InputEvent& event, Clock::time_point when = Clock::now());
+
+    // 获取已记录的事件数
+    size_t GetEventCount() const;
+
+    /**
+     * @brief 生成完整的宏数据（文件头 + 负载）
+     */
+    std::vector<std::uint8_t> Serialize() const;
+
+    /**
+     * @brief 保存到文件
+     * @param path 文件路径（本地窄字符编码）
+     */
+    Result<bool> SaveToFile(const std::string& path) const;
+
+private:
+    mutable std::mutex m_mutex;
+    Clock::time_point m_origin;
+    std::vector<std::uint8_t> m_payload;
+    std::uint32_t m_count = 0;
+    std::uint64_t m_lastTimeUs = 0;
+    int m_lastX = 0;
+    int m_lastY = 0;
+};
+
+/**
+ * @brief 创建录制接收端
+ *
+ * 包装另一个接收端：事件派发成功后记入 recorder。recorder 必须比接收端活得久。
+ */
+std::unique_ptr<InputSink> CreateRecordingSink(std::unique_ptr<InputSink> inner, Recorder& recorder);
+
+/**
+ * @brief 宏数据视图（不持有内存）
+ */
+class MacroView {
+public:
+    /**
+     * @brief 逐事件解码的游标
+     */
+    class Cursor {
+    public:
+        explicit Cursor(const MacroView& view);
+
+        /**
+         * @brief 解码下一个事件
+         * @return 到达末尾或数据损坏时返回 false（损坏时 IsCorrupt 为 true）
+         */
+        bool Next(TimedEvent& out);
+
+        bool IsCorrupt() const { return m_corrupt; }
+
+    private:
+        const std::uint8_t* m_position;
+        const std::uint8_t* m_end;
+        std::uint32_t m_remaining;
+        std::uint64_t m_timeUs = 0;
+        int m_x = 0;
+        int m_y = 0;
+        bool m_corrupt = false;
+    };
+
+public:
+    MacroView() = default;
+
+    /**
+     * @brief 在内存上打开宏（只检查文件头，O(1)）
+     * @param data 宏数据
+     * @param size 字节数
+     * @return 视图；文件头无效或长度不足时为 INVALID_PARAMETER
+     */
+    static Result<MacroView> Open(const std::uint8_t* data, size_t size);
+
+    /**
+     * @brief 完整解码一遍，检查所有事件
+     */
+    Result<bool> Validate() const;
+
+    /**
+     * @brief 解码全部事件
+     */
+    Result<std::vector<TimedEvent>> Decode() const;
+
+    size_t GetEventCount() const { return m_eventCount; }
+    size_t GetPayloadSize() const { return m_payloadSize; }
+
+private:
+    const std::uint8_t* m_payload = nullptr;
+    size_t m_payloadSize = 0;
+    std::uint32_t m_eventCount = 0;
+};
+
+/**
+ * @brief 只读映射的宏文件
+ */
+class MappedMacro {
+public:
+    /**
+     * @brief 映射宏文件（只读，按需分页，不复制）
+     * @param path 文件路径（本地窄字符编码）
+     */
+    static Result<std::shared_ptr<const MappedMacro>> Open(const std::string& path);
+
+    ~MappedMacro();
+
+    MappedMacro(const MappedMacro&) = delete;
+    MappedMacro& operator=(const MappedMacro&) = delete;
+
+    const MacroView& GetView() const { return m_view; }
+
+private:
+    MappedMacro() = default;
+
+    MacroView m_view;
+    const void* m_address = nullptr;
+    size_t m_size = 0;
+    void* m_mapping = nullptr;  // Windows 下的文件映射对象
+};
+
+/**
+ * @brief 回放选项
+ */
+struct ReplayOptions {
+    double speed = 1.0;         // 回放速度倍数
+    int spinUs = 2000;          // 到期前最后这段时间自旋等待（微秒），之前休眠
+};
+
+/**
+ * @brief 回放报告
+ */
+struct ReplayReport {
+    size_t eventCount = 0;          // 宏中的事件数
+    size_t deliveredCount = 0;      // 成功派发的事件数（事件数 × 窗口数）
+    size_t failedWindowCount = 0;   // 开始时句柄无效或中途派发失败（之后不再派发）的窗口数
+    double durationUs = 0.0;        // 回放总耗时
+    // 每次派发（事件 × 窗口）开始时晚于计划时刻的微秒数：窗口依次派发，
+    // 第 N 个窗口的延迟包含前 N - 1 个窗口的派发耗时
+    double jitterP50Us = 0.0;
+    double jitterP90Us = 0.0;
+    double jitterP99Us = 0.0;
+    double jitterMaxUs = 0.0;
+};
+
+/**
+ * @brief 混合等待：休眠到截止时间前 spin，再自旋到截止时间
+ */
+void SleepUntil(Clock::time_point deadline, std::chrono::microseconds spin);
+
+/**
+ * @brief 按录制的时间表回放宏
+ *
+ * 每个事件在计划时刻依次派发给所有窗口（同一线程串行，不并行）；窗口在开始时各调用一次 BeginBatch。
+ * 在调用线程上执行，直到最后一个事件派发完才返回。
+ *
+ * @param macro 宏
+ * @param sink 接收端
+ * @param windows 目标窗口
+ * @param options 回放选项
+ * @return 回放报告；宏损坏或参数无效时为 INVALID_PARAMETER
+ */
+Result<ReplayReport> Replay(const MacroView& macro, InputSink& sink, const std::vector<WindowHandle>& windows,
+                            const ReplayOptions& options = ReplayOptions());
+
+}  // namespace InputMacro
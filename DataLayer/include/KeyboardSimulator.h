@@ -1,6 +1,9 @@
 #pragma once
 
 #include "CommonTypes.h"
+#include "TextInput.h"
+
+#include <string>
 
 using namespace WindowsAPI;
 
@@ -13,6 +16,10 @@ using namespace WindowsAPI;
  * - 单个按键操作
  * - 基础文本输入
  * - 键盘状态检查
+ *
+ * 单个按键与字符经由 InputDispatcher::InputSink 同步发送：不带 sink 的版本使用
+ * Windows 消息接收端（CreateWin32Sink），带 sink 的版本可传入录制接收端
+ * （InputMacro::CreateRecordingSink）或限时接收端（GuardedInputService::CreateSink）。
  */
 namespace KeyboardSimulator {
 
@@ -26,6 +33,9 @@ namespace KeyboardSimulator {
  */
 Result<bool> KeyDown(HWND windowHandle, UINT virtualKey);
 
+// 同 KeyDown，经由 sink 发送
+Result<bool> KeyDown(InputDispatcher::InputSink& sink, HWND windowHandle, UINT virtualKey);
+
 /**
  * @brief 模拟按键释放
  * @param windowHandle 目标窗口句柄
@@ -34,6 +44,9 @@ Result<bool> KeyDown(HWND windowHandle, UINT virtualKey);
  */
 Result<bool> KeyUp(HWND windowHandle, UINT virtualKey);
 
+// 同 KeyUp，经由 sink 发送
+Result<bool> KeyUp(InputDispatcher::InputSink& sink, HWND windowHandle, UINT virtualKey);
+
 // ============ 文本输入 ============
 
 /**
@@ -44,6 +57,26 @@ Result<bool> KeyUp(HWND windowHandle, UINT virtualKey);
  */
 Result<bool> SendChar(HWND windowHandle, wchar_t character);
 
+// 同 SendChar，经由 sink 发送
+Result<bool> SendChar(InputDispatcher::InputSink& sink, HWND windowHandle, wchar_t character);
+
+/**
+ * @brief 批量输入文本
+ *
+ * 先由 TextInput::BuildPlan 构建整段消息序列，再按块发送：
+ * - CHAR_STREAM/KEY_STROKES：块内每个消息用 SendMessageCallback 连续发出、不逐个等待，
+ *   块末等待全部回调后再发下一块（跨线程的发送消息按顺序处理，块之间不会乱序）
+ * - REPLACE_SELECTION：每块一次 EM_REPLACESEL；SET_TEXT：一次 WM_SETTEXT
+ * 块之间按 chunkDelayMs 间隔。
+ *
+ * @param windowHandle 目标窗口句柄（编辑控件模式下应为编辑控件本身）
+ * @param text 要输入的文本
+ * @param options 发送方式、分块与节奏
+ * @return 输入的字符数；目标在 timeoutMs 内未处理完一块时为 WINDOW_NOT_RESPONDING
+ */
+Result<int> SendText(HWND windowHandle, const std::wstring& text,
+                     const TextInput::TextOptions& options = TextInput::TextOptions());
+
 // ============ 键盘状态 ============
 
 /**
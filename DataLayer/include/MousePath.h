@@ -0,0 +1,147 @@
+#pragma once
+
+#include "BasicTypes.h"
+#include "InputDispatcher.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace WindowsAPI;
+
+/**
+ * @namespace MousePath
+ * @brief 拟人鼠标轨迹生成
+ *
+ * MouseSimulator::MoveInWindow 只发送终点的一个 WM_MOUSEMOVE，部分程序会忽略这种"瞬移"。
+ * 这里预先生成整条轨迹，再作为一批事件按轨迹时间派发（PlayMove/PlayDrag）：
+ * - BEZIER：三次贝塞尔弧线，先加速后减速（smoothstep）
+ * - MINIMUM_JERK：直线，最小加加速度速度曲线（10τ³ − 15τ⁴ + 6τ⁵），接近人手的点到点移动
+ * - 可选的垂直方向抖动（低通随机量，起点与终点处为 0），相同 seed 生成相同轨迹
+ * - 点缓冲区在 Path 对象中复用，容量足够时生成不分配内存
+ */
+namespace MousePath {
+
+using InputDispatcher::InputEvent;
+using InputDispatcher::InputSink;
+using InputDispatcher::WindowHandle;
+
+/**
+ * @brief 轨迹形状
+ */
+enum class Curve {
+    BEZIER,         // 弧线
+    MINIMUM_JERK    // 直线，最小加加速度
+};
+
+/**
+ * @brief 轨迹选项
+ */
+struct PathOptions {
+    Curve curve = Curve::MINIMUM_JERK;
+    double speed = 1200.0;          // 平均速度（像素/秒），决定时长
+    double minDurationMs = 60.0;    // 时长下限（毫秒）
+    double maxDurationMs = 1500.0;  // 时长上限（毫秒）
+    double sampleIntervalMs = 8.0;  // 采样间隔（毫秒）
+    int pointCount = 0;             // 指定采样点数（>= 2），0 表示由时长与采样间隔决定
+    double curvature = 0.15;        // BEZIER 控制点偏离直线的最大距离（相对起终点距离）
+    double jitter = 0.0;            // 垂直方向抖动幅度上限（像素），0 表示不抖动
+    std::uint32_t seed = 1;         // 弧线方向与抖动的随机种子
+};
+
+/**
+ * @brief 轨迹点
+ */
+struct PathPoint {
+    int x = 0;
+    int y = 0;
+    double timeMs = 0.0;    // 距起点的时间（毫秒）
+};
+
+/**
+ * @brief 可复用的轨迹缓冲区
+ */
+class Path {
+public:
+    /**
+     * @brief 构造
+     * @param capacity 预留的点数（生成的点数不超过它时不分配内存）
+     */
+    explicit Path(size_t capacity = 256);
+
+    /**
+     * @brief 生成从 start 到 end 的轨迹（覆盖之前的内容）
+     *
+     * 第一个点为 start，最后一个点为 end；坐标取整后与上一个点相同的采样点被跳过。
+     *
+     * @param start 起点（客户区坐标）
+     * @param end 终点（客户区坐标）
+     * @param options 轨迹选项
+     * @return 点数；选项无效时为 INVALID_PARAMETER（缓冲区保持不变）
+     */
+    Result<size_t> Generate(const Point& start, const Point& end, const PathOptions& options = PathOptions());
+
+    const std::vector<PathPoint>& GetPoints() const { return m_points; }
+    size_t GetPointCount() const { return m_points.size(); }
+
+    // 获取轨迹时长（毫秒）
+    double GetDurationMs() const { return m_points.empty() ? 0.0 : m_points.back().timeMs; }
+
+private:
+    std::vector<PathPoint> m_points;
+};
+
+/**
+ * @brief 追加移动事件：每个点一个 MOUSE_MOVE
+ *
+ * 事件的投递方式为 AUTO（单独成批时投递，与点击同批时同步发送），与 MouseSimulator::MoveInWindow 一样
+ * 只在 wParam 中带上实际按住的按键的 MK_* 标志。
+ *
+ * @param path 轨迹
+ * @param events 输出事件（追加），不按任何键（悬停）
+ */
+void AppendMove(const Path& path, std::vector<InputEvent>& events);
+
+// 同 AppendMove，移动时按住 held
+void AppendMove(const Path& path, MouseButton held, std::vector<InputEvent>& events);
+
+/**
+ * @brief 追加拖拽事件：起点按下、逐点移动（按住 button）、终点释放
+ *
+ * 全部显式同步发送（即使移动事件与按下、释放分批提交）：投递的移动可能晚于之后同步发送的释放被处理，
+ * 拖拽会在中途松开。
+ *
+ * @param path 轨迹
+ * @param button 拖拽使用的按键
+ * @param events 输出事件（追加）
+ */
+void AppendDrag(const Path& path, MouseButton button, std::vector<InputEvent>& events);
+
+/**
+ * @brief 按轨迹时间派发移动：第 i 个点在开始后 timeMs 毫秒派发
+ *
+ * 整段作为一批（开始时调用一次 BeginBatch，投递方式按整批解析）。
+ * 在调用线程上按 InputMacro::SleepUntil 等待每个点的时刻，最后一个点派发完才返回，
+ * 耗时约为 GetDurationMs()。
+ *
+ * @param sink 接收端（对挂起窗口应限时失败，如 GuardedInputService::CreateSink）
+ * @param window 目标窗口
+ * @param path 轨迹
+ * @param spinUs 每个点到期前自旋等待的微秒数，之前休眠
+ * @return 已派发的事件数；某个事件失败后剩余的不再派发
+ */
+Result<int> PlayMove(InputSink& sink, WindowHandle window, const Path& path, int spinUs = 2000);
+
+// 同 PlayMove，移动时按住 held
+Result<int> PlayMove(InputSink& sink, WindowHandle window, const Path& path, MouseButton held, int spinUs = 2000);
+
+/**
+ * @brief 按轨迹时间派发拖拽：起点时刻按下，逐点移动，终点时刻释放
+ *
+ * 事件与 AppendDrag 相同，节奏与 PlayMove 相同。
+ *
+ * @return 已派发的事件数；某个事件失败后剩余的不再派发（按键可能保持按下）
+ */
+Result<int> PlayDrag(InputSink& sink, WindowHandle window, const Path& path, MouseButton button, int spinUs = 2000);
+
+}  // namespace MousePath
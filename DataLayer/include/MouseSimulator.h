@@ -1,6 +1,7 @@
 #pragma once
 
 #include "CommonTypes.h"
+#include "MousePath.h"
 
 using namespace WindowsAPI;
 
@@ -13,6 +14,10 @@ using namespace WindowsAPI;
  * - 窗口内移动和点击
  * - 窗口内拖拽操作
  * - 窗口内滚轮操作
+ *
+ * 点击、移动与滚轮经由 InputDispatcher::InputSink 同步发送：不带 sink 的版本使用
+ * Windows 消息接收端（CreateWin32Sink），带 sink 的版本可传入录制接收端
+ * （InputMacro::CreateRecordingSink）或限时接收端（GuardedInputService::CreateSink）。
  */
 namespace MouseSimulator {
 
@@ -37,6 +42,10 @@ Result<Point> GetPositionInWindow(HWND windowHandle);
  */
 Result<bool> MouseButtonDownInWindow(HWND windowHandle, int x, int y, MouseButton button);
 
+// 同 MouseButtonDownInWindow，经由 sink 发送
+Result<bool> MouseButtonDownInWindow(InputDispatcher::InputSink& sink, HWND windowHandle, int x, int y,
+                                     MouseButton button);
+
 /**
  * @brief 在窗口客户区内释放鼠标按键
  * @param windowHandle 目标窗口句柄
@@ -47,18 +56,66 @@ Result<bool> MouseButtonDownInWindow(HWND windowHandle, int x, int y, MouseButto
  */
 Result<bool> MouseButtonUpInWindow(HWND windowHandle, int x, int y, MouseButton button);
 
+// 同 MouseButtonUpInWindow，经由 sink 发送
+Result<bool> MouseButtonUpInWindow(InputDispatcher::InputSink& sink, HWND windowHandle, int x, int y,
+                                   MouseButton button);
+
 // ============ 窗口内移动操作 ============
 
 /**
- * @brief 在窗口客户区内移动
+ * @brief 在窗口客户区内移动（悬停，wParam 不带按键的 MK_* 标志）
  * @param windowHandle 目标窗口句柄
  * @param endX 结束X坐标（客户区坐标）
  * @param endY 结束Y坐标（客户区坐标）
- * @param button 使用的鼠标按键
  * @return 操作结果
  */
+Result<bool> MoveInWindow(HWND windowHandle, int endX, int endY);
+
+// 同 MoveInWindow，经由 sink 发送
+Result<bool> MoveInWindow(InputDispatcher::InputSink& sink, HWND windowHandle, int endX, int endY);
+
+// 同 MoveInWindow，移动时按住 button
 Result<bool> MoveInWindow(HWND windowHandle, int endX, int endY, MouseButton button);
 
+// 同 MoveInWindow，移动时按住 button，经由 sink 发送
+Result<bool> MoveInWindow(InputDispatcher::InputSink& sink, HWND windowHandle, int endX, int endY,
+                          MouseButton button);
+
+// ============ 窗口内轨迹移动与拖拽 ============
+
+/**
+ * @brief 沿轨迹在窗口客户区内移动（每个点一个 WM_MOUSEMOVE）
+ *
+ * 整段作为一批交给 sink（只含移动，AUTO 解析为投递），每个点在轨迹时间 timeMs 派发
+ * （见 MousePath::PlayMove），调用线程阻塞约 path.GetDurationMs() 毫秒。
+ * 应传入不会被挂起窗口卡住的接收端，如 GuardedInputService::CreateSink。
+ *
+ * @param sink 接收端
+ * @param windowHandle 目标窗口句柄
+ * @param path 轨迹（见 MousePath::Path::Generate）
+ * @return 派发的消息数
+ */
+Result<int> MoveAlongPathInWindow(InputDispatcher::InputSink& sink, HWND windowHandle, const MousePath::Path& path);
+
+// 同 MoveAlongPathInWindow，移动时按住 button
+Result<int> MoveAlongPathInWindow(InputDispatcher::InputSink& sink, HWND windowHandle, const MousePath::Path& path,
+                                  MouseButton button);
+
+/**
+ * @brief 沿轨迹在窗口客户区内拖拽
+ *
+ * 起点按下、逐点移动、终点释放，整个过程的 MK_* 与 Ctrl/Shift 状态一致；全部同步发送，
+ * 按轨迹时间派发（见 MousePath::PlayDrag）。同步发送经由 sink：GuardedInputService::CreateSink 对无响应的窗口限时失败，不会一直阻塞。
+ *
+ * @param sink 接收端
+ * @param windowHandle 目标窗口句柄
+ * @param path 轨迹（见 MousePath::Path::Generate）
+ * @param button 拖拽使用的按键
+ * @return 派发的消息数
+ */
+Result<int> DragAlongPathInWindow(InputDispatcher::InputSink& sink, HWND windowHandle, const MousePath::Path& path,
+                                  MouseButton button);
+
 // ============ 窗口内滚轮操作 ============
 
 /**
@@ -71,4 +128,7 @@ Result<bool> MoveInWindow(HWND windowHandle, int endX, int endY, MouseButton but
  */
 Result<bool> ScrollInWindow(HWND windowHandle, int x, int y, int delta);
 
+// 同 ScrollInWindow，经由 sink 发送
+Result<bool> ScrollInWindow(InputDispatcher::InputSink& sink, HWND windowHandle, int x, int y, int delta);
+
 }  // namespace MouseSimulator
\ No newline at end of file
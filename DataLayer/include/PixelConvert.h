@@ -0,0 +1,104 @@
+#pragma once
+
+#include "BasicTypes.h"
+#include "ImageView.h"
+
+#include <cstdint>
+
+using namespace WindowsAPI;
+
+/**
+ * @namespace PixelConvert
+ * @brief 像素格式转换
+ *
+ * 捕获结果固定为 BGRA32，各使用方需要的格式不同：
+ * - BGRA32 -> RGB24（编码器）、RGBA32、GRAY8（匹配）
+ * - BGRA32 <-> RGB565、BGRA32/GRAY8 -> MONO1（紧凑的模板与掩码缓存）
+ * - GRAY8 / MONO1 -> BGRA32（显示结果）
+ * - Alpha 预乘（Qt 的 Premultiplied 格式）
+ *
+ * 按行调用 SSSE3/AVX2 内核，运行时根据 CPU 特性选择，无 SIMD 时使用标量实现。
+ * 输出像素不大于输入像素的转换支持原地进行。
+ */
+namespace PixelConvert {
+
+/**
+ * @brief 生成掩码时使用的通道
+ */
+enum class MaskChannel {
+    LUMA,       // 亮度（BGRA32 按灰度权重计算，GRAY8 取原值）
+    ALPHA       // Alpha 通道（BGRA32、RGBA32）
+};
+
+/**
+ * @brief 是否支持从 source 到 target 的转换
+ *
+ * 支持：BGRA32 -> RGB24 / RGBA32 / GRAY8 / RGB565 / MONO1，RGBA32 -> BGRA32，
+ * GRAY8 -> BGRA32 / MONO1，RGB565 -> BGRA32，MONO1 -> GRAY8 / BGRA32，以及相同格式间的复制。
+ * 转为 MONO1 时亮度不小于 128 的像素为 1。
+ */
+bool IsSupported(PixelFormat source, PixelFormat target);
+
+/**
+ * @brief 转换为新分配的紧凑图像
+ * @param source 源视图
+ * @param target 目标格式
+ * @return 转换结果（行跨度按4字节对齐）
+ */
+Result<ImageData> Convert(const ImageView& source, PixelFormat target);
+
+/**
+ * @brief 转换到调用方提供的缓冲区
+ *
+ * 目标每像素字节数不大于源且 destinationStride 不大于源 stride 时，
+ * destination 可以等于 source.data（原地转换）。
+ *
+ * @param source 源视图
+ * @param target 目标格式
+ * @param destination 目标首行地址
+ * @param destinationStride 目标行跨度（字节）
+ * @return 是否成功
+ */
+Result<bool> ConvertRows(const ImageView& source, PixelFormat target,
+                         std::uint8_t* destination, int destinationStride);
+
+/**
+ * @brief 原地转换 ImageData
+ *
+ * 只支持每像素位数不增加的转换，转换后数据收紧为按4字节对齐的行。
+ *
+ * @param image 图像数据（未设置格式的32位数据按 BGRA32 解释）
+ * @param target 目标格式
+ * @return 是否成功
+ */
+Result<bool> ConvertInPlace(ImageData& image, PixelFormat target);
+
+/**
+ * @brief 按通道阈值生成 1 位掩码
+ * @param source 源视图（BGRA32、RGBA32 或 GRAY8）
+ * @param channel 判定使用的通道
+ * @param threshold 阈值，通道值不小于阈值的像素为 1
+ * @return MONO1 掩码
+ */
+Result<ImageData> CreateMask(const ImageView& source, MaskChannel channel, std::uint8_t threshold);
+
+/**
+ * @brief Alpha 预乘：颜色通道乘以 alpha/255（四舍五入）
+ *
+ * 适用于 Alpha 在第4字节的 32 位格式（BGRA32、RGBA32），通道顺序不变。
+ *
+ * @param source 源视图
+ * @param destination 目标首行地址，可以等于 source.data
+ * @param destinationStride 目标行跨度（字节）
+ * @return 是否成功
+ */
+Result<bool> PremultiplyRows(const ImageView& source, std::uint8_t* destination, int destinationStride);
+
+/**
+ * @brief 原地 Alpha 预乘
+ * @param image 32 位图像数据
+ * @return 是否成功
+ */
+Result<bool> PremultiplyInPlace(ImageData& image);
+
+}  // namespace PixelConvert
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "BasicTypes.h"
+#include "ImageView.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+using namespace WindowsAPI;
+
+/**
+ * @namespace PixelProbe
+ * @brief 批量像素颜色探测
+ *
+ * 回答"这些点的颜色是否都在容差之内"：
+ * - 探测点预先编译为定长数组，一次收集/比较即可得到全部结果
+ * - 结果为位掩码，第 i 位表示第 i 个探测点是否匹配
+ * - 只依赖探测点的外接矩形，可配合区域捕获只抓取很小的一块
+ */
+namespace PixelProbe {
+
+/**
+ * @brief 单个探测点
+ */
+struct Probe {
+    Point position;                                   // 探测位置（源坐标）
+    std::array<std::uint8_t, 4> color = {0, 0, 0, 255};  // 期望颜色（B,G,R,A）
+
+    // 每通道容差（B,G,R,A），差值不超过容差视为匹配；默认忽略Alpha通道
+    std::array<std::uint8_t, 4> tolerance = {0, 0, 0, 255};
+
+    /**
+     * @brief 按RGB构造探测点
+     * @param x X坐标
+     * @param y Y坐标
+     * @param r 红
+     * @param g 绿
+     * @param b 蓝
+     * @param colorTolerance 颜色通道容差（忽略Alpha）
+     */
+    static Probe Rgb(int x, int y, std::uint8_t r, std::uint8_t g, std::uint8_t b,
+                     std::uint8_t colorTolerance = 0) {
+        Probe probe;
+        probe.position = Point(x, y);
+        probe.color = {b, g, r, 255};
+        probe.tolerance = {colorTolerance, colorTolerance, colorTolerance, 255};
+        return probe;
+    }
+};
+
+/**
+ * @brief 编译后的探测点集合
+ *
+ * 探测点按结构数组（SoA）保存相对外接矩形的偏移、期望颜色与容差，
+ * 长度补齐到8的倍数，AVX2 下每次收集并比较8个像素。
+ */
+class PixelProbeSet {
+public:
+    static constexpr int MAX_PROBES = 64;  // 位掩码宽度
+
+    PixelProbeSet() = default;
+
+    /**
+     * @brief 编译探测点
+     * @param probes 探测点列表（1 到 MAX_PROBES 个，坐标非负）
+     * @return 探测点集合
+     */
+    static Result<PixelProbeSet> Compile(const std::vector<Probe>& probes);
+
+    /**
+     * @brief 对源坐标系下的整帧求值
+     * @param frame 整帧图像（BGRA32），必须覆盖外接矩形
+     * @return 匹配位掩码
+     */
+    Result<std::uint64_t> Evaluate(const ImageView& frame) const;
+
+    /**
+     * @brief 对源图像的一部分求值（例如只抓取了外接矩形的区域捕获）
+     * @param view 图像（BGRA32）
+     * @param viewOrigin view 左上角在源坐标系中的位置
+     * @return 匹配位掩码
+     */
+    Result<std::uint64_t> Evaluate(const ImageView& view, Point viewOrigin) const;
+
+    // 获取探测点数量
+    int GetProbeCount() const { return m_count; }
+
+    // 获取所有探测点的外接矩形（源坐标，右下角不包含）
+    const WindowsAPI::Rectangle& GetBounds() const { return m_bounds; }
+
+    // 全部探测点都匹配时的掩码
+    std::uint64_t GetAllMask() const {
+        return m_count >= 64 ? ~0ull : ((1ull << m_count) - 1);
+    }
+
+    // 掩码是否表示全部匹配
+    bool AllMatched(std::uint64_t mask) const { return mask == GetAllMask(); }
+
+private:
+    int m_count = 0;
+    WindowsAPI::Rectangle m_bounds;
+    std::vector<std::int32_t> m_offsetX;      // 相对外接矩形左边的字节偏移
+    std::vector<std::int32_t> m_offsetY;      // 相对外接矩形顶边的行数
+    std::vector<std::uint32_t> m_colors;      // 打包的期望颜色（内存顺序 B,G,R,A）
+    std::vector<std::uint32_t> m_tolerances;  // 打包的容差
+};
+
+}  // namespace PixelProbe
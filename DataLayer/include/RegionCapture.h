@@ -0,0 +1,83 @@
+#pragma once
+
+#include "BasicTypes.h"
+#include "ImageView.h"
+
+#include <vector>
+
+using namespace WindowsAPI;
+
+namespace ScreenCapture {
+
+constexpr int kDefaultGroupMergeSlack = 64 * 64;   // 合并两组时允许多抓取的像素数（约一次抓取的固定开销）
+
+/**
+ * @brief 一次抓取覆盖的区域组
+ */
+struct RegionGroup {
+    WindowsAPI::Rectangle bounds;   // 组内区域的外接矩形（源坐标）
+    std::vector<size_t> regions;    // 组内区域在 RegionCapturePlan::regions 中的下标（升序）
+};
+
+/**
+ * @brief 区域捕获计划
+ * 
+ * 位置相近的区域合为一组，每组只抓取组内区域的外接矩形，再切出各区域；
+ * 相距较远的区域分到不同的组，避免一个外接矩形退化为整个窗口。
+ */
+struct RegionCapturePlan {
+    WindowsAPI::Rectangle bounds;                // 所有区域的外接矩形（源坐标）
+    std::vector<WindowsAPI::Rectangle> regions;  // 各区域（源坐标）
+    std::vector<RegionGroup> groups;             // 抓取分组
+};
+
+/**
+ * @brief 根据区域列表生成捕获计划
+ *
+ * 贪心合并：每次合并外接矩形多出面积最小的两组，直到多出的面积超过 mergeSlack。
+ *
+ * @param regions 区域列表（源坐标）
+ * @param sourceWidth 源宽度
+ * @param sourceHeight 源高度
+ * @param mergeSlack 合并两组时允许多抓取的像素数，0 表示只合并不多抓像素的组
+ * @return 捕获计划，区域为空或超出源范围时返回错误
+ */
+Result<RegionCapturePlan> PlanRegionCapture(const std::vector<WindowsAPI::Rectangle>& regions,
+                                            int sourceWidth, int sourceHeight,
+                                            int mergeSlack = kDefaultGroupMergeSlack);
+
+/**
+ * @brief 从外接矩形的抓取结果中取出各区域的子视图（不复制像素）
+ * @param plan 捕获计划
+ * @param grabbed 抓取结果，尺寸必须等于 plan.bounds
+ * @return 与区域一一对应的子视图，有效期与 grabbed 相同
+ */
+Result<std::vector<ImageView>> GetRegionViews(const RegionCapturePlan& plan, const ImageView& grabbed);
+
+/**
+ * @brief 从外接矩形的抓取结果中切出各区域（复制为独立的图像数据）
+ * @param plan 捕获计划
+ * @param grabbed 抓取结果，尺寸必须等于 plan.bounds
+ * @return 与区域一一对应、尺寸恰好合适的图像数据
+ */
+Result<std::vector<ImageData>> ExtractRegions(const RegionCapturePlan& plan, const ImageView& grabbed);
+
+/**
+ * @brief 从各组的抓取结果中取出各区域的子视图（不复制像素）
+ * @param plan 捕获计划
+ * @param groupGrabs 与 plan.groups 一一对应的抓取结果，尺寸必须等于各组的 bounds
+ * @return 与区域一一对应的子视图，有效期与 groupGrabs 相同
+ */
+Result<std::vector<ImageView>> GetGroupedRegionViews(const RegionCapturePlan& plan,
+                                                     const std::vector<ImageView>& groupGrabs);
+
+/**
+ * @brief 从各组的抓取结果中切出各区域（复制为独立的图像数据）
+ * @param plan 捕获计划
+ * @param groupGrabs 与 plan.groups 一一对应的抓取结果，尺寸必须等于各组的 bounds
+ * @return 与区域一一对应、尺寸恰好合适的图像数据
+ */
+Result<std::vector<ImageData>> ExtractGroupedRegions(const RegionCapturePlan& plan,
+                                                     const std::vector<ImageView>& groupGrabs);
+
+}  // namespace ScreenCapture
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "BasicTypes.h"
+#include "ImageView.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+using namespace WindowsAPI;
+
+/**
+ * @namespace RegionStats
+ * @brief 基于积分图的区域统计
+ *
+ * 回答"区域 R 的平均亮度/方差是多少""这块是不是空白面板"：
+ * - 一次向量化遍历建立和与平方和的积分图（灰度或按通道）
+ * - 任意矩形的和、均值、方差都是 O(1) 查询
+ * - 新帧到来时只从最上面的脏行开始重算
+ */
+namespace RegionStats {
+
+/**
+ * @brief 积分图的通道模式
+ */
+enum class ChannelMode {
+    GRAY,           // 单通道：GRAY8 直接使用，BGRA32 按灰度权重转换
+    PER_CHANNEL     // 四通道独立统计（BGRA32/RGBA32，按内存顺序）
+};
+
+/**
+ * @brief 矩形区域的统计结果
+ *
+ * GRAY 模式只使用下标 0，PER_CHANNEL 模式按内存顺序（BGRA32 为 B,G,R,A）。
+ */
+struct RegionStatistics {
+    std::uint64_t pixelCount = 0;
+    std::array<std::uint64_t, 4> sum = {0, 0, 0, 0};
+    std::array<double, 4> mean = {0, 0, 0, 0};
+    std::array<double, 4> variance = {0, 0, 0, 0};
+};
+
+/**
+ * @brief 和与平方和的积分图（summed-area table）
+ *
+ * 第 (x, y) 项保存左上角 [0, x) x [0, y) 内的累加值，首行首列为0。
+ * 和按32位取模保存，只要矩形本身的和不超过32位即可精确相减，
+ * 因此图像面积上限为 2^32 / 255 个像素（约 1680 万，足够 4K）；平方和按64位保存。
+ */
+class IntegralImage {
+public:
+    IntegralImage() = default;
+
+    /**
+     * @brief 从一帧建立积分图
+     * @param frame 图像（GRAY 模式：BGRA32 或 GRAY8；PER_CHANNEL 模式：BGRA32 或 RGBA32）
+     * @param mode 通道模式
+     * @return 积分图
+     */
+    static Result<IntegralImage> Build(const ImageView& frame, ChannelMode mode = ChannelMode::GRAY);
+
+    /**
+     * @brief 用新帧增量更新
+     *
+     * 积分图沿纵向累加，第 firstDirtyRow 行变化会影响其下所有行，
+     * 因此从该行重算到底部，之上的行保持不变。
+     *
+     * @param frame 新帧（尺寸与格式必须与建立时相同）
+     * @param firstDirtyRow 最上面的变化行，不小于高度时不做任何事
+     * @return 是否成功
+     */
+    Result<bool> Update(const ImageView& frame, int firstDirtyRow);
+
+    /**
+     * @brief 按脏矩形增量更新（例如 FrameDiff::Compare 的结果）
+     * @param frame 新帧
+     * @param dirtyRects 脏矩形列表，为空时不做任何事
+     * @return 是否成功
+     */
+    Result<bool> Update(const ImageView& frame, const std::vector<WindowsAPI::Rectangle>& dirtyRects);
+
+    /**
+     * @brief 查询矩形区域的和、均值与方差
+     * @param rect 区域（必须非空且位于图像内）
+     * @return 统计结果
+     */
+    Result<RegionStatistics> Query(const WindowsAPI::Rectangle& rect) const;
+
+    /**
+     * @brief 判断区域是否近似纯色（空白面板检测）
+     * @param rect 区域
+     * @param maxStdDev 每个通道允许的最大标准差
+     * @return 所有通道的标准差都不超过阈值时为 true
+     */
+    Result<bool> IsUniform(const WindowsAPI::Rectangle& rect, double maxStdDev) const;
+
+    // 窗口 [x, x + w) x [y, y + h) 的和，不做边界检查（调用方保证窗口在图像内）
+    std::uint64_t Sum(int x, int y, int w, int h, int channel = 0) const {
+        std::uint32_t value = m_sum[Index(x + w, y + h, channel)] - m_sum[Index(x + w, y, channel)] -
+                              m_sum[Index(x, y + h, channel)] + m_sum[Index(x, y, channel)];
+        return value;
+    }
+
+    // 窗口内的平方和，不做边界检查
+    std::uint64_t SumOfSquares(int x, int y, int w, int h, int channel = 0) const {
+        return m_sumSq[Index(x + w, y + h, channel)] - m_sumSq[Index(x + w, y, channel)] -
+               m_sumSq[Index(x, y + h, channel)] + m_sumSq[Index(x, y, channel)];
+    }
+
+    // 第 y 行（0 到高度）积分值的起始地址，按 x、通道交错排列，共 (宽度 + 1) * 通道数 项
+    const std::uint32_t* SumRow(int y) const { return &m_sum[Index(0, y, 0)]; }
+    const std::uint64_t* SumOfSquaresRow(int y) const { return &m_sumSq[Index(0, y, 0)]; }
+
+    int GetWidth() const { return m_width; }
+    int GetHeight() const { return m_height; }
+    int GetChannelCount() const { return m_channels; }
+    ChannelMode GetMode() const { return m_mode; }
+
+private:
+    size_t Index(int x, int y, int channel) const {
+        return (static_cast<size_t>(y) * (m_width + 1) + x) * m_channels + channel;
+    }
+
+    Result<bool> ValidateFrame(const ImageView& frame) const;
+    void BuildRows(const ImageView& frame, int firstRow);
+
+private:
+    int m_width = 0;
+    int m_height = 0;
+    int m_channels = 0;
+    ChannelMode m_mode = ChannelMode::GRAY;
+    PixelFormat m_format = PixelFormat::UNKNOWN;
+    std::vector<std::uint32_t> m_sum;     // 和（按32位取模）
+    std::vector<std::uint64_t> m_sumSq;   // 平方和
+    std::vector<std::uint8_t> m_grayRow;  // BGRA 转灰度的行缓冲
+};
+
+}  // namespace RegionStats
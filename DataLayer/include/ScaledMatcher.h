@@ -0,0 +1,154 @@
+#pragma once
+
+#include "BasicTypes.h"
+#include "ImageView.h"
+#include "TemplateMatcher.h"
+
+#include <map>
+#include <mutex>
+#include <vector>
+
+using namespace WindowsAPI;
+
+/**
+ * @namespace ScaledMatcher
+ * @brief 适应 DPI 缩放与窗口尺寸的模板匹配
+ *
+ * 模板在 100% DPI、固定客户区尺寸下截取；窗口在 125%/150% DPI 或被拉伸后，
+ * ScreenCapture::CaptureWindow 得到的界面元素随之缩放，原尺寸模板不再匹配：
+ * - 由 WindowManager::GetClientRect 的客户区尺寸与模板截取时的参考尺寸推断缩放比例
+ * - 模板集合在每个缩放比例下只重采样一次（缩小用面积平均，放大用双线性），结果缓存复用
+ * - 已知比例时直接用缓存的模板调用 TemplateMatcher，开销与原尺寸匹配相同
+ * - 推断的比例匹配失败时才按几何级数粗扫比例范围，再在最佳比例附近细化
+ */
+namespace ScaledMatcher {
+
+/**
+ * @brief 缩放搜索选项
+ */
+struct ScaleOptions {
+    TemplateMatcher::MatchOptions match;    // 每个比例下的匹配选项（maxResults 固定为 1）
+    bool sweepOnMiss = true;                // 推断的比例匹配失败时是否扫描比例范围
+    double minScale = 0.5;                  // 扫描范围
+    double maxScale = 2.0;
+    double sweepRatio = 1.1;                // 粗扫相邻比例之比（大于 1）
+};
+
+/**
+ * @brief 缩放匹配结果
+ */
+struct ScaledMatch {
+    bool found = false;                     // 得分是否达到 minScore
+    TemplateMatcher::Match match;           // 最佳位置与得分（大图坐标）
+    double scale = 1.0;                     // 匹配使用的比例
+    WindowsAPI::Rectangle bounds;           // 缩放后模板在大图中的区域
+    bool swept = false;                     // 是否经过比例扫描
+};
+
+/**
+ * @brief 由客户区尺寸推断缩放比例
+ *
+ * 宽高比例不一致时（窗口被单向拉伸）取较小者：界面元素按 DPI 等比缩放，
+ * 多出的客户区通常是留白而不是放大的元素。
+ *
+ * @param clientRect 当前客户区（如 WindowManager::GetClientRect 的结果）
+ * @param referenceWidth 模板截取时的客户区宽度
+ * @param referenceHeight 模板截取时的客户区高度
+ * @return 缩放比例；尺寸无效时返回 1.0
+ */
+double InferScale(const WindowsAPI::Rectangle& clientRect, int referenceWidth, int referenceHeight);
+
+/**
+ * @brief 多比例模板集合
+ *
+ * 添加时模板转为灰度并复制，之后与调用方的内存无关。
+ * 每个比例的模板按比例的千分之一量化后缓存；多线程可以同时查询，
+ * 返回的视图在 ClearCache 或集合销毁之前一直有效。
+ */
+class ScaledTemplateSet {
+public:
+    static constexpr int kScaleUnits = 1000;    // 缓存键：比例 * kScaleUnits 四舍五入
+
+    /**
+     * @param referenceWidth 模板截取时的客户区宽度
+     * @param referenceHeight 模板截取时的客户区高度
+     */
+    ScaledTemplateSet(int referenceWidth, int referenceHeight)
+        : m_referenceWidth(referenceWidth), m_referenceHeight(referenceHeight) {}
+
+    ScaledTemplateSet(const ScaledTemplateSet&) = delete;
+    ScaledTemplateSet& operator=(const ScaledTemplateSet&) = delete;
+
+    /**
+     * @brief 添加参考尺寸下的模板
+     * @param templ 模板（BGRA32 或 GRAY8）
+     * @return 模板下标
+     */
+    Result<int> Add(const ImageView& templ);
+
+    // 获取模板数量
+    int GetTemplateCount() const;
+
+    // 由当前客户区推断缩放比例
+    double InferScale(const WindowsAPI::Rectangle& clientRect) const {
+        return ScaledMatcher::InferScale(clientRect, m_referenceWidth, m_referenceHeight);
+    }
+
+    /**
+     * @brief 预先重采样整个模板集合
+     * @param scale 缩放比例
+     * @return 是否成功（有模板缩放后宽或高小于 1 时失败，其余模板仍会缓存）
+     */
+    Result<bool> Prepare(double scale);
+
+    /**
+     * @brief 获取某个比例下的模板，首次查询时重采样整个集合
+     * @param index 模板下标
+     * @param scale 缩放比例
+     * @return GRAY8 模板视图
+     */
+    Result<ImageView> GetTemplate(int index, double scale);
+
+    /**
+     * @brief 在已知比例下查找模板
+     * @param haystack 大图（BGRA32 或 GRAY8）
+     * @param index 模板下标
+     * @param scale 缩放比例
+     * @param options 匹配选项
+     * @return 与 TemplateMatcher::FindTemplate 相同
+     */
+    Result<std::vector<TemplateMatcher::Match>> Find(const ImageView& haystack, int index, double scale,
+                                                     const TemplateMatcher::MatchOptions& options = TemplateMatcher::MatchOptions());
+
+    /**
+     * @brief 先按推断的比例查找，失败时扫描比例范围
+     * @param haystack 大图（BGRA32 或 GRAY8）
+     * @param index 模板下标
+     * @param scale 推断的缩放比例
+     * @param options 缩放搜索选项
+     * @return 最佳匹配；没有达到 minScore 时 found 为 false
+     */
+    Result<ScaledMatch> Locate(const ImageView& haystack, int index, double scale,
+                               const ScaleOptions& options = ScaleOptions());
+
+    // 获取已缓存的比例数（不含参考比例 1.0）
+    size_t GetCachedScaleCount() const;
+
+    // 清空重采样缓存（保留原始模板）
+    void ClearCache();
+
+private:
+    // 在量化后的比例下匹配，取最佳的一个
+    Result<ScaledMatch> MatchAt(const ImageView& haystack, int index, int scaleKey,
+                                const TemplateMatcher::MatchOptions& options);
+    // 确保该比例下的整个集合已重采样，返回该比例的模板列表（调用方持有锁）
+    Result<const std::vector<ImageData>*> EnsureScale(int scaleKey);
+
+    int m_referenceWidth;
+    int m_referenceHeight;
+    mutable std::mutex m_mutex;
+    std::vector<ImageData> m_templates;                 // 参考尺寸的灰度模板
+    std::map<int, std::vector<ImageData>> m_scaled;     // 比例键 -> 与 m_templates 对应的重采样模板
+};
+
+}  // namespace ScaledMatcher
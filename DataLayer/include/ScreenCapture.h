@@ -1,6 +1,11 @@
 #pragma once
 
 #include "CommonTypes.h"
+#include "CaptureSession.h"
+#include "RegionCapture.h"
+#include "PixelProbe.h"
+
+#include <memory>
 
 using namespace WindowsAPI;
 
@@ -12,6 +17,7 @@ using namespace WindowsAPI;
  * - 基础屏幕截图
  * - 基础窗口截图
  * - 基础文件操作
+ * - 复用资源的持久捕获会话
  */
 namespace ScreenCapture {
 
@@ -37,26 +43,74 @@ Result<ImageData> CaptureScreen();
 /**
  * @brief 捕获指定窗口
  * @param windowHandle 窗口句柄
+ * @param format 输出像素格式（非 BGRA32 时在捕获缓冲上原地转换，如 GRAY8、RGB565、MONO1）
  * @return 图像数据结果
  */
-Result<ImageData> CaptureWindow(HWND windowHandle);
+Result<ImageData> CaptureWindow(HWND windowHandle, PixelFormat format = PixelFormat::BGRA32);
 
 /**
  * @brief 捕获窗口客户区
  * @param windowHandle 窗口句柄
+ * @param format 输出像素格式
  * @return 图像数据结果
  */
-Result<ImageData> CaptureWindowClient(HWND windowHandle);
+Result<ImageData> CaptureWindowClient(HWND windowHandle, PixelFormat format = PixelFormat::BGRA32);
 
 /**
  * @brief 捕获窗口指定区域
+ * 
+ * 只把区域从窗口 DC BitBlt 到区域大小的缓冲；复制的是屏幕上的像素，被遮挡的部分得到遮挡物。
+ * 窗口最小化或 BitBlt 失败时回退为整幅 PrintWindow 后裁剪。
+ * 
  * @param windowHandle 窗口句柄
  * @param x 起始X坐标
  * @param y 起始Y坐标
  * @param width 宽度
  * @param height 高度
+ * @param format 输出像素格式
  * @return 图像数据结果
  */
-Result<ImageData> CaptureRegion(HWND windowHandle, int x, int y, int width, int height);
+Result<ImageData> CaptureRegion(HWND windowHandle, int x, int y, int width, int height,
+                                PixelFormat format = PixelFormat::BGRA32);
+
+/**
+ * @brief 一次抓取捕获窗口内的多个区域
+ * 
+ * 按 PlanRegionCapture 的分组，每组只把外接矩形 BitBlt 到组大小的缓冲再切出各区域，
+ * 适合同时轮询多个小区域。与 CaptureRegion 相同，被遮挡的部分得到遮挡物，
+ * 窗口最小化或 BitBlt 失败时回退为整幅 PrintWindow 后按组裁剪。
+ * 
+ * @param windowHandle 窗口句柄
+ * @param regions 区域列表（窗口坐标）
+ * @return 与区域一一对应的图像数据
+ */
+Result<std::vector<ImageData>> CaptureRegions(HWND windowHandle, const std::vector<WindowsAPI::Rectangle>& regions);
+
+// ============ 像素探测 ============
+
+/**
+ * @brief 对窗口执行一组像素探测
+ * 
+ * 只抓取探测点的外接矩形，再一次性比较所有探测点。
+ * 
+ * @param windowHandle 窗口句柄
+ * @param probes 编译好的探测点集合（窗口坐标）
+ * @return 匹配位掩码，第 i 位对应第 i 个探测点
+ */
+Result<std::uint64_t> ProbeWindow(HWND windowHandle, const PixelProbe::PixelProbeSet& probes);
+
+// ============ 持久捕获会话 ============
+
+/**
+ * @brief 创建绑定到指定窗口的持久捕获会话
+ * 
+ * 会话保持内存DC与DIB节跨帧存活，PrintWindow直接写入DIB内存，
+ * 仅在窗口尺寸变化时重新分配。适合高频轮询同一窗口。
+ * 
+ * @param windowHandle 窗口句柄
+ * @param clientOnly 是否只捕获客户区
+ * @return 捕获会话
+ */
+Result<std::shared_ptr<CaptureSession>> CreateCaptureSession(HWND windowHandle, bool clientOnly = false);
 
 }  // namespace ScreenCapture
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "BasicTypes.h"
+#include "ImageView.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace WindowsAPI;
+
+/**
+ * @namespace ScreenState
+ * @brief 界面状态识别（"当前在哪个界面"）
+ *
+ * 用瓦片哈希代替一串模板匹配来判断登录页、大厅、某个对话框等已知界面：
+ * - 截图按行抽样后面积平均缩小为 (tilesX * 8) x (tilesY * 8) 的灰度采样格，
+ *   每个瓦片的 8x8 采样格生成 64 位平均哈希，并记录瓦片平均亮度
+ * - 索引保存每个已知界面的一个或多个样本签名，可以忽略会变化的区域（计时器、头像等）
+ * - 识别时逐个样本统计匹配的瓦片（哈希汉明距离与亮度差都在容差内），
+ *   匹配比例最高的界面即为结果，与次佳界面的比例差作为置信度
+ * - 索引可序列化为字节流，离线建好后随程序发布
+ *
+ * 签名只读取少量抽样行，1080p 截图的识别耗时在 1ms 以内。
+ */
+namespace ScreenState {
+
+constexpr int kCellsPerTile = 8;    // 每个瓦片每个方向的采样格数（8x8 = 64 位哈希）
+constexpr int kMaxTiles = 16;       // 每个方向的最大瓦片数
+
+/**
+ * @brief 截图的瓦片签名
+ */
+struct TileSignature {
+    int tilesX = 0;
+    int tilesY = 0;
+    std::vector<std::uint64_t> hashes;  // 每个瓦片的平均哈希（行优先）
+    std::vector<std::uint8_t> means;    // 每个瓦片的平均亮度
+};
+
+/**
+ * @brief 计算截图的瓦片签名
+ *
+ * 采样格亮度高于瓦片平均亮度 2 级以上的位为 1；采样格亮度极差小于 16 的瓦片
+ * （纯色或平缓渐变）哈希为 0，只靠平均亮度区分，避免噪声在均值附近翻转哈希位。
+ *
+ * @param capture 截图（BGRA32 或 GRAY8，宽高不小于采样格数）
+ * @param tilesX 横向瓦片数（1 到 kMaxTiles）
+ * @param tilesY 纵向瓦片数（1 到 kMaxTiles）
+ * @return 瓦片签名
+ */
+Result<TileSignature> ComputeSignature(const ImageView& capture, int tilesX = 8, int tilesY = 8);
+
+/**
+ * @brief 识别选项
+ */
+struct ClassifyOptions {
+    int hashTolerance = 10;         // 瓦片哈希允许的汉明距离（0-64）
+    int meanTolerance = 12;         // 瓦片平均亮度允许的差（灰度级）
+    double minMatchRatio = 0.85;    // 匹配瓦片比例不低于该值才认定为该界面
+};
+
+/**
+ * @brief 识别结果
+ */
+struct Classification {
+    int state = -1;             // 识别出的界面下标，没有界面达到 minMatchRatio 时为 -1
+    int nearestState = -1;      // 匹配比例最高的界面下标（索引为空时为 -1）
+    double matchRatio = 0.0;    // 最近界面的匹配瓦片比例（只计未忽略的瓦片）
+    double confidence = 0.0;    // 最近界面与次佳界面的匹配比例之差（0-1，只有一个界面时等于 matchRatio）
+};
+
+/**
+ * @brief 已知界面的签名索引
+ *
+ * 所有样本的哈希、亮度与忽略位图分别保存在连续数组中，识别时顺序扫描，
+ * 每个瓦片只需一次异或与位计数；数百个样本的查询耗时为微秒级。
+ */
+class StateIndex {
+public:
+    // 8x8 瓦片的空索引
+    StateIndex();
+
+    /**
+     * @brief 创建空索引
+     * @param tilesX 横向瓦片数（1 到 kMaxTiles）
+     * @param tilesY 纵向瓦片数（1 到 kMaxTiles）
+     * @return 空索引
+     */
+    static Result<StateIndex> Create(int tilesX, int tilesY);
+
+    /**
+     * @brief 添加界面样本
+     *
+     * 同名界面可以添加多个样本（如不同主题或分辨率），识别时取匹配最好的样本。
+     *
+     * @param name 界面名称
+     * @param capture 该界面的截图（BGRA32 或 GRAY8）
+     * @param ignoreRegions 截图坐标下需要忽略的区域，与之相交的瓦片不参与比较
+     * @return 界面下标
+     */
+    Result<int> AddSample(const std::wstring& name, const ImageView& capture,
+                          const std::vector<WindowsAPI::Rectangle>& ignoreRegions = {});
+
+    /**
+     * @brief 识别截图所属的界面
+     * @param capture 截图（BGRA32 或 GRAY8，尺寸可以与样本不同）
+     * @param options 识别选项
+     * @return 识别结果
+     */
+    Result<Classification> Classify(const ImageView& capture, const ClassifyOptions& options = ClassifyOptions()) const;
+
+    /**
+     * @brief 按已计算的签名识别
+     * @param signature 瓦片签名（瓦片数必须与索引相同）
+     * @param options 识别选项
+     * @return 识别结果
+     */
+    Result<Classification> Classify(const TileSignature& signature,
+                                    const ClassifyOptions& options = ClassifyOptions()) const;
+
+    /**
+     * @brief 序列化为字节流（小端）
+     */
+    std::vector<std::uint8_t> Serialize() const;
+
+    /**
+     * @brief 从 Serialize 生成的字节流恢复索引
+     * @param data 字节流
+     * @param size 字节数
+     * @return 索引
+     */
+    static Result<StateIndex> Deserialize(const std::uint8_t* data, std::size_t size);
+
+    // 获取瓦片数
+    int GetTilesX() const { return m_tilesX; }
+    int GetTilesY() const { return m_tilesY; }
+
+    // 获取界面数与样本数
+    int GetStateCount() const { return static_cast<int>(m_names.size()); }
+    int GetSampleCount() const { return static_cast<int>(m_sampleStates.size()); }
+
+    // 获取界面名称
+    const std::wstring& GetStateName(int state) const { return m_names[state]; }
+
+    // 按名称查找界面下标，不存在时返回 -1
+    int FindState(const std::wstring& name) const;
+
+private:
+    StateIndex(int tilesX, int tilesY);
+
+    int TileCount() const { return m_tilesX * m_tilesY; }
+    int MaskWords() const { return (TileCount() + 63) / 64; }
+
+    int m_tilesX;
+    int m_tilesY;
+    std::vector<std::wstring> m_names;
+    std::vector<int> m_sampleStates;        // 每个样本所属的界面
+    std::vector<int> m_activeTiles;         // 每个样本参与比较的瓦片数
+    std::vector<std::uint64_t> m_hashes;    // 样本 s 的瓦片哈希位于 [s * TileCount(), (s + 1) * TileCount())
+    std::vector<std::uint8_t> m_means;      // 与 m_hashes 对应的瓦片平均亮度
+    std::vector<std::uint64_t> m_ignored;   // 样本 s 的忽略位图位于 [s * MaskWords(), (s + 1) * MaskWords())
+};
+
+}  // namespace ScreenState
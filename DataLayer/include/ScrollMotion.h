@@ -0,0 +1,116 @@
+#pragma once
+
+#include "BasicTypes.h"
+#include "ImageView.h"
+
+#include <cstdint>
+#include <vector>
+
+using namespace WindowsAPI;
+
+/**
+ * @namespace ScrollMotion
+ * @brief 滚动位移估计与长截图拼接
+ *
+ * 滚动列表后回答"内容移动了多少"，并把连续截图拼成一张长图：
+ * - 每帧先转灰度，再面积平均为行签名（每行 64 个采样）与列签名（每列 64 个采样）
+ * - 逐个候选位移计算重叠部分签名的 SAD（重叠行在内存中连续，每个候选一次 SIMD 调用）
+ * - 代价曲线的几个局部最小值再用全分辨率 SAD 核对，取误差最小者
+ * - 双向位移无法由行/列签名分别求出，改为在上一帧中匹配当前帧的几个半尺寸块得到候选
+ * - 拼接器只保留上一帧的灰度副本与拼好的长图，新露出的行直接追加
+ */
+namespace ScrollMotion {
+
+/**
+ * @brief 搜索方向
+ */
+enum class Axis {
+    VERTICAL,       // 只估计纵向位移
+    HORIZONTAL,     // 只估计横向位移
+    BOTH            // 两个方向同时估计（分块匹配，比单方向慢）
+};
+
+/**
+ * @brief 位移估计选项
+ */
+struct MotionOptions {
+    Axis axis = Axis::VERTICAL;
+    int maxShift = 0;                   // 最大位移（像素），0 表示只受 minOverlap 限制
+    int minOverlap = 32;                // 两帧至少重叠的行数（横向为列数）
+    WindowsAPI::Rectangle region;       // 参与比较的滚动区域（帧坐标），空矩形表示整帧
+};
+
+/**
+ * @brief 位移估计结果
+ *
+ * 位移指内容的移动：上一帧 (x, y) 处的内容在当前帧位于 (x + dx, y + dy)。
+ * 向下滚动时内容上移，dy 为负。
+ */
+struct Motion {
+    int dx = 0;
+    int dy = 0;
+    double error = 0.0;         // 重叠部分的平均绝对差（灰度级，0 表示完全一致）
+    double confidence = 0.0;    // 0-1：最佳位移的代价相对其他位移的优势，内容单调或周期重复时接近 0
+};
+
+/**
+ * @brief 估计两帧之间的内容位移
+ * @param previous 上一帧（BGRA32 或 GRAY8）
+ * @param current 当前帧（与上一帧尺寸、格式相同）
+ * @param options 估计选项
+ * @return 位移
+ */
+Result<Motion> Estimate(const ImageView& previous, const ImageView& current,
+                        const MotionOptions& options = MotionOptions());
+
+/**
+ * @brief 拼接选项
+ */
+struct StitchOptions {
+    MotionOptions motion;       // 位移估计选项（axis 固定按纵向处理；region 同时决定拼接的区域）
+    double maxError = 6.0;      // 重叠部分平均绝对差超过该值时拒绝该帧
+};
+
+/**
+ * @brief 纵向滚动长截图拼接器
+ *
+ * 依次传入滚动过程中的截图，每帧与上一帧估计纵向位移，
+ * 视野超出已拼接部分底端时把新露出的行追加到长图。向上回滚不会追加内容，
+ * 回滚到第一帧之上的帧被拒绝。
+ */
+class Stitcher {
+public:
+    explicit Stitcher(const StitchOptions& options = StitchOptions());
+
+    /**
+     * @brief 追加一帧
+     * @param frame 截图（BGRA32 或 GRAY8，尺寸与格式必须与第一帧相同）
+     * @return 与上一帧之间的位移（第一帧为 0）；被拒绝的帧不改变拼接状态
+     */
+    Result<Motion> Append(const ImageView& frame);
+
+    // 获取拼好的长图（格式与输入帧相同）
+    const ImageData& GetImage() const { return m_image; }
+
+    // 取出长图并重置
+    ImageData TakeImage();
+
+    // 获取已接受的帧数
+    int GetFrameCount() const { return m_frameCount; }
+
+    // 获取最近一帧的顶端在长图中的位置
+    int GetViewTop() const { return m_viewTop; }
+
+    // 清空已拼接的内容
+    void Reset();
+
+private:
+    StitchOptions m_options;
+    ImageData m_image;
+    std::vector<std::uint8_t> m_previous;  // 上一帧拼接区域的灰度副本（stride = width）
+    std::vector<std::uint8_t> m_current;   // 当前帧的灰度缓冲区（与 m_previous 交替复用）
+    int m_frameCount = 0;
+    int m_viewTop = 0;
+};
+
+}  // namespace ScrollMotion
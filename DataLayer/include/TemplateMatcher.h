@@ -0,0 +1,98 @@
+#pragma once
+
+#include "BasicTypes.h"
+#include "ImageView.h"
+#include "EdgeMap.h"
+
+#include <cstdint>
+#include <vector>
+
+using namespace WindowsAPI;
+
+/**
+ * @namespace TemplateMatcher
+ * @brief 模板匹配（在截图中查找图像）
+ * 
+ * 在进程内完成"在截图中找按钮/图标"：
+ * - 支持 SAD、SSD 与零均值归一化互相关（NCC）
+ * - 由粗到细的图像金字塔：最粗层全图搜索，逐层在候选点附近细化
+ * - 内层循环使用 SIMD 行内核，全图搜索按行分给线程池
+ * - 可选的模板掩码：只比较掩码内的像素，用于圆形按钮、带透明边缘的图标等非矩形元素
+ * 
+ * 匹配在8位灰度上进行，BGRA输入会先转换为灰度。
+ * 主题或配色会变化的界面可以改为在梯度幅值图上匹配（MatchFeatures::EDGES）。
+ */
+namespace TemplateMatcher {
+
+/**
+ * @brief 匹配度量
+ */
+enum class MatchMethod {
+    SAD,    // 绝对差之和
+    SSD,    // 差的平方和
+    NCC     // 零均值归一化互相关
+};
+
+/**
+ * @brief 匹配特征
+ */
+enum class MatchFeatures {
+    INTENSITY,  // 灰度
+    EDGES       // 梯度幅值（见 EdgeMap），对亮度、配色与明暗反转不敏感
+};
+
+/**
+ * @brief 匹配选项
+ */
+struct MatchOptions {
+    MatchMethod method = MatchMethod::NCC;
+    int maxResults = 1;                 // 最多返回的匹配数
+    double minScore = 0.8;              // 最低得分
+    int pyramidLevels = 0;              // 金字塔层数，0 表示自动，1 表示不使用金字塔
+    int minPyramidTemplateSize = 8;     // 自动分层时模板在最粗层的最小边长
+    bool multithreaded = true;          // 是否使用默认线程池
+    bool useAlphaMask = false;          // BGRA32 模板按 Alpha 通道生成掩码（如从带透明通道的 PNG 加载的模板）
+    std::uint8_t alphaThreshold = 128;  // Alpha 不小于该值的模板像素参与匹配
+    MatchFeatures features = MatchFeatures::INTENSITY;
+    EdgeMap::Operator edgeOperator = EdgeMap::Operator::SOBEL;  // EDGES 使用的梯度算子
+    EdgeMap::TemplateCache* edgeCache = nullptr;                // 可选：静态模板的幅值图缓存（算子须与 edgeOperator 一致）
+    int edgeTemplateId = -1;                                    // 使用 edgeCache 时模板在缓存中的编号
+};
+
+/**
+ * @brief 单个匹配结果
+ * 
+ * 得分统一为"越大越相似"：SAD/SSD 归一化到 [0,1]，NCC 为相关系数 [-1,1]。
+ */
+struct Match {
+    WindowsAPI::Point location;     // 模板左上角在大图中的位置
+    double score = 0.0;
+};
+
+/**
+ * @brief 在大图中查找模板
+ * @param haystack 大图（BGRA32 或 GRAY8）
+ * @param templ 模板（BGRA32 或 GRAY8）
+ * @param options 匹配选项
+ * @return 按得分从高到低排列、互不重叠的匹配列表（可能为空）
+ */
+Result<std::vector<Match>> FindTemplate(const ImageView& haystack, const ImageView& templ,
+                                        const MatchOptions& options = MatchOptions());
+
+/**
+ * @brief 按掩码在大图中查找模板
+ * 
+ * 只有掩码内的模板像素参与 SAD/SSD/NCC 计算，得分按掩码内像素数归一化。
+ * 使用金字塔时，粗层只保留对应 2x2 块全部在掩码内的像素；
+ * 掩码内像素过少的粗层不再使用。
+ * 
+ * @param haystack 大图（BGRA32 或 GRAY8）
+ * @param templ 模板（BGRA32 或 GRAY8）
+ * @param mask 掩码（MONO1 或 GRAY8，与模板同尺寸；非零像素参与匹配）
+ * @param options 匹配选项（忽略 useAlphaMask）
+ * @return 按得分从高到低排列、互不重叠的匹配列表（可能为空）
+ */
+Result<std::vector<Match>> FindTemplate(const ImageView& haystack, const ImageView& templ, const ImageView& mask,
+                                        const MatchOptions& options = MatchOptions());
+
+}  // namespace TemplateMatcher
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "BasicTypes.h"
+#include "InputDispatcher.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace WindowsAPI;
+
+/**
+ * @namespace TextInput
+ * @brief 批量文本输入的消息序列构建
+ *
+ * KeyboardSimulator::SendChar 每个字符一次同步 SendMessage(WM_CHAR)，10 KB 文本就是上万次往返。
+ * 这里先一次性构建整段文本的消息序列，KeyboardSimulator::SendText 再按块流水发送：
+ * - UTF-16 代理对与组合字符序列（组合附加符号、变体选择符、ZWJ 连接的表情等）不会被拆到两个块里
+ * - 换行统一映射：字符流与按键模式下 \r\n、\r、\n 都是一次回车（\r），编辑控件模式下为 \r\n
+ * - 可选的发送方式：WM_CHAR 字符流、编辑控件的 EM_REPLACESEL/WM_SETTEXT 快速路径、按键按下/释放模拟
+ */
+namespace TextInput {
+
+using InputDispatcher::InputEvent;
+
+constexpr std::uint32_t kVirtualKeyPacket = 0xE7;   // VK_PACKET：没有对应按键的字符
+
+/**
+ * @brief 发送方式
+ */
+enum class TextMode {
+    CHAR_STREAM,        // 每个 UTF-16 码元一个 WM_CHAR
+    REPLACE_SELECTION,  // 编辑控件：每块一次 EM_REPLACESEL（插入到光标处，可撤销）
+    SET_TEXT,           // 编辑控件：一次 WM_SETTEXT 替换全部内容（忽略分块与节奏）
+    KEY_STROKES         // 每个字符 WM_KEYDOWN、WM_CHAR、WM_KEYUP（大小写由 WM_CHAR 决定，不模拟 Shift）
+};
+
+/**
+ * @brief 文本输入选项
+ */
+struct TextOptions {
+    TextMode mode = TextMode::CHAR_STREAM;
+    int chunkSize = 256;        // 每块的 UTF-16 码元数上限（单个字符序列超过上限时独占一块）
+    int chunkDelayMs = 0;       // 块之间的间隔（毫秒），0 表示不等待
+    int timeoutMs = 5000;       // 每块等待目标处理完的超时（毫秒）
+};
+
+/**
+ * @brief 构建好的消息序列
+ *
+ * CHAR_STREAM/KEY_STROKES 使用 events，REPLACE_SELECTION/SET_TEXT 使用 text；
+ * chunkEnds[i] 为第 i 块在 events 或 text 中的结束下标（不含），最后一项等于总长度。
+ */
+struct TextPlan {
+    TextMode mode = TextMode::CHAR_STREAM;
+    std::vector<InputEvent> events;
+    std::wstring text;
+    std::vector<size_t> chunkEnds;
+    size_t characterCount = 0;  // 输入的字符数（码位，\r\n 计为一个）
+};
+
+/**
+ * @brief 构建文本的消息序列
+ * @param text 要输入的文本（UTF-16）
+ * @param options 发送方式与分块
+ * @return 消息序列；有未配对的代理项或选项无效时为 INVALID_PARAMETER
+ */
+Result<TextPlan> BuildPlan(const std::wstring& text, const TextOptions& options = TextOptions());
+
+/**
+ * @brief 字符对应的虚拟键码（按键模式使用）
+ *
+ * 字母、数字、空格、回车、Tab、退格映射到各自的按键，其余字符为 kVirtualKeyPacket。
+ */
+std::uint32_t VirtualKeyFor(std::uint32_t codePoint);
+
+}  // namespace TextInput
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "CommonTypes.h"
+#include "InputDispatcher.h"
+
+#include <memory>
+
+using namespace WindowsAPI;
+
+namespace InputDispatcher {
+
+/**
+ * @brief 输入事件对应的窗口消息
+ */
+struct WindowMessage {
+    UINT message = 0;
+    WPARAM wParam = 0;
+    LPARAM lParam = 0;
+};
+
+/**
+ * @brief 构建输入事件的窗口消息
+ * @param event 事件
+ * @param modifiers 鼠标消息 wParam 中的 MK_CONTROL/MK_SHIFT
+ * @return 窗口消息
+ */
+WindowMessage ToWindowMessage(const InputEvent& event, WPARAM modifiers);
+
+/**
+ * @brief 创建 Windows 消息接收端
+ *
+ * 消息与 KeyboardSimulator/MouseSimulator 发送的相同（WM_KEYDOWN/WM_CHAR/WM_MOUSEMOVE 等），
+ * 按解析后的投递方式使用 PostMessage 或 SendMessage。
+ * 每批开始时调用一次 IsWindow，并读取一次 Ctrl/Shift 状态用于鼠标消息的 wParam。
+ *
+ * @return 接收端
+ */
+std::unique_ptr<InputSink> CreateWin32Sink();
+
+/**
+ * @brief 创建使用 Windows 消息接收端的派发器
+ * @return 派发器（派发线程已启动）
+ */
+std::unique_ptr<Dispatcher> CreateWin32Dispatcher();
+
+}  // namespace InputDispatcher
@@ -0,0 +1,678 @@
+#include "../include/BatchMatcher.h"
+#include "../include/Downscale.h"
+#include "../include/PixelConvert.h"
+#include "../include/RegionStats.h"
+#include "MatchKernels.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <mutex>
+#include <utility>
+
+namespace BatchMatcher {
+
+// 内部辅助函数
+namespace {
+    // 没有任何候选时的内部得分（NCC 不会低于 -1）
+    const double kNoCandidate = -2.0;
+    // 并行时每块的最少行数
+    const int kMinRowsPerChunk = 8;
+    // 方差预筛选的位置块边长
+    const int kPrescreenBlock = 8;
+
+    // 模板在 [x, x + w) x [y, y + h) 内的像素和
+    std::int32_t BlockSum(const std::uint8_t* pixels, int stride, int x, int y, int w, int h) {
+        std::int32_t sum = 0;
+        for (int row = y; row < y + h; row++) {
+            for (int col = x; col < x + w; col++) {
+                sum += pixels[static_cast<size_t>(row) * stride + col];
+            }
+        }
+        return sum;
+    }
+
+    inline int PopCount64(std::uint64_t value) {
+        value = value - ((value >> 1) & 0x5555555555555555ull);
+        value = (value & 0x3333333333333333ull) + ((value >> 2) & 0x3333333333333333ull);
+        value = (value + (value >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+        return static_cast<int>((value * 0x0101010101010101ull) >> 56);
+    }
+
+    // 格子键：四个角块区间下标各占 kBinBits 位，最低 kStdBits 位为标准差区间
+    inline int CellKey(int b0, int b1, int b2, int b3, int stdBin) {
+        const int bits = TemplateSet::kBinBits;
+        const int stdBits = TemplateSet::kStdBits;
+        return (b0 << (3 * bits + stdBits)) | (b1 << (2 * bits + stdBits)) | (b2 << (bits + stdBits)) |
+               (b3 << stdBits) | stdBin;
+    }
+
+    // 大图一行 [begin, end) 内各位置的角块和：out[x] 为 [x, x + qw) x [y, y + qh) 的和
+    // 角块面积不超过图像的四分之一，和小于 2^31，按有符号整数处理以便向量化
+    void QuadRowSums(const RegionStats::IntegralImage& integral, int y, int quadWidth, int quadHeight, int begin,
+                     int end, std::int32_t* out) {
+        const std::uint32_t* top = integral.SumRow(y);
+        const std::uint32_t* bottom = integral.SumRow(y + quadHeight);
+        for (int x = begin; x < end; x++) {
+            out[x] = static_cast<std::int32_t>(bottom[x + quadWidth] - top[x + quadWidth] - bottom[x] + top[x]);
+        }
+    }
+
+    // 角块和量化为区间下标（scale = 1 / (角块面积 * 区间宽度)）
+    void QuantizeRow(const std::int32_t* sums, int begin, int end, float scale, std::int32_t* bins) {
+        for (int x = begin; x < end; x++) {
+            bins[x] = static_cast<std::int32_t>(static_cast<float>(sums[x]) * scale);
+        }
+    }
+
+    // 大图一行 [begin, end) 内 w x h 窗口的和与平方和的低32位（窗口面积不超过 kMaxStdArea 时即精确值）
+    void WindowRowSums(const RegionStats::IntegralImage& integral, int y, int w, int h, int begin, int end,
+                       std::uint32_t* sums, std::uint32_t* squares) {
+        const std::uint32_t* top = integral.SumRow(y);
+        const std::uint32_t* bottom = integral.SumRow(y + h);
+        for (int x = begin; x < end; x++) {
+            sums[x] = bottom[x + w] - top[x + w] - bottom[x] + top[x];
+        }
+        const std::uint64_t* topSq = integral.SumOfSquaresRow(y);
+        const std::uint64_t* bottomSq = integral.SumOfSquaresRow(y + h);
+        for (int x = begin; x < end; x++) {
+            squares[x] = static_cast<std::uint32_t>(bottomSq[x + w] - topSq[x + w] - bottomSq[x] + topSq[x]);
+        }
+    }
+
+    // 窗口标准差量化为区间下标：方差与各区间下界的平方比较，不必逐个开方
+    // 32位无符号数先右移一位再转浮点，以便使用有符号转换指令
+    void StdBinRow(const std::uint32_t* sums, const std::uint32_t* squares, int begin, int end, float invArea,
+                   const float* edges, std::int32_t* bins) {
+        static_assert(TemplateSet::kStdBits == 2, "StdBinRow compares against three bin edges");
+        const float e1 = edges[0];
+        const float e2 = edges[1];
+        const float e3 = edges[2];
+        for (int x = begin; x < end; x++) {
+            float mean = static_cast<float>(static_cast<std::int32_t>(sums[x] >> 1)) * 2.0f * invArea;
+            float meanSq = static_cast<float>(static_cast<std::int32_t>(squares[x] >> 1)) * 2.0f * invArea;
+            float variance = meanSq - mean * mean;
+            bins[x] = (variance >= e1 ? 1 : 0) + (variance >= e2 ? 1 : 0) + (variance >= e3 ? 1 : 0);
+        }
+    }
+
+    // 每个位置的格子键
+    void CellRow(const std::int32_t* topBins, const std::int32_t* bottomBins, const std::int32_t* stdBins,
+                 int rightX, int begin, int end, std::int32_t* cells) {
+        const int bits = TemplateSet::kBinBits;
+        const int stdBits = TemplateSet::kStdBits;
+        for (int x = begin; x < end; x++) {
+            cells[x] = (topBins[x] << (3 * bits + stdBits)) | (topBins[x + rightX] << (2 * bits + stdBits)) |
+                       (bottomBins[x] << (bits + stdBits)) | (bottomBins[x + rightX] << stdBits) | stdBins[x];
+        }
+    }
+
+    inline bool WithinTolerance(std::int32_t a, std::int32_t b, std::int32_t limit) {
+        return std::abs(a - b) <= limit;
+    }
+
+    inline bool WithinRange(std::int32_t value, std::int32_t low, std::int32_t high) {
+        return static_cast<std::uint32_t>(value - low) <= static_cast<std::uint32_t>(high - low);
+    }
+
+    // 变体边长：相位为 factor - 1 时模板内完整覆盖的块数最少，取这个最小值使同组变体尺寸一致
+    int CoarseLength(int length, int factor) {
+        return (length - (factor - 1)) / factor;
+    }
+
+    // 尺寸组的缩小倍数：变体边长不小于 kMinCoarseSize 的最大倍数
+    int CoarseFactor(int width, int height) {
+        for (int factor : {4, 2}) {
+            if (CoarseLength(std::min(width, height), factor) >= TemplateSet::kMinCoarseSize) {
+                return factor;
+            }
+        }
+        return 1;
+    }
+
+    // 缩小倍数在层数组中的下标
+    int LevelIndex(int factor) {
+        return factor == 4 ? 2 : factor - 1;
+    }
+
+    // 从模板 (phaseX, phaseY) 起按 factor x factor 块取整平均（与 Downscale::BoxRows 相同的舍入），输出 width x height
+    void ReduceTemplate(const std::uint8_t* pixels, int stride, int phaseX, int phaseY, int factor, int width, int height,
+                        std::uint8_t* out) {
+        const int shift = factor == 4 ? 4 : (factor == 2 ? 2 : 0);
+        const int round = shift > 0 ? 1 << (shift - 1) : 0;
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                const int sum = BlockSum(pixels, stride, phaseX + x * factor, phaseY + y * factor, factor, factor);
+                out[static_cast<size_t>(y) * width + x] = static_cast<std::uint8_t>((sum + round) >> shift);
+            }
+        }
+    }
+
+    // 与 (score, y, x) 字典序比较：得分高者优先，同分取更靠上、更靠左的位置
+    bool IsBetter(const TemplateMatcher::Match& a, const TemplateMatcher::Match& b) {
+        if (a.score != b.score) {
+            return a.score > b.score;
+        }
+        if (a.location.y != b.location.y) {
+            return a.location.y < b.location.y;
+        }
+        return a.location.x < b.location.x;
+    }
+}
+
+Result<TemplateSet> TemplateSet::Compile(const std::vector<ImageView>& templates, int meanTolerance) {
+    if (templates.empty()) {
+        return Result<TemplateSet>::Error(ErrorCode::INVALID_PARAMETER, L"Empty template list");
+    }
+    if (meanTolerance < 0 || meanTolerance > 64) {
+        return Result<TemplateSet>::Error(ErrorCode::INVALID_PARAMETER, L"Invalid mean tolerance");
+    }
+
+    TemplateSet set;
+    size_t totalPixels = 0;
+    for (const auto& templ : templates) {
+        if (templ.IsEmpty() || templ.width < 2 || templ.height < 2) {
+            return Result<TemplateSet>::Error(ErrorCode::INVALID_PARAMETER, L"Template must be at least 2x2");
+        }
+        if (templ.format != PixelFormat::BGRA32 && templ.format != PixelFormat::GRAY8) {
+            return Result<TemplateSet>::Error(ErrorCode::INVALID_PARAMETER, L"Unsupported pixel format");
+        }
+        totalPixels += static_cast<size_t>(templ.width) * templ.height;
+    }
+
+    // 区间宽度至少覆盖容差两侧加取整误差，保证每一维最多登记到两个区间
+    set.m_tolerance = meanTolerance;
+    set.m_binWidth = std::max(2 * meanTolerance + 3, (256 + kMaxBins - 1) / kMaxBins);
+    set.m_stdBinWidth = std::max(2 * meanTolerance + 3, 128 >> kStdBits);
+    set.m_sampleTolerance = 4 * meanTolerance + 8;
+
+    // 灰度像素连续存放
+    set.m_pixels.resize(totalPixels);
+    const auto& kernels = MatchKernels::GetKernels();
+    size_t offset = 0;
+    for (const auto& templ : templates) {
+        Entry entry;
+        entry.width = templ.width;
+        entry.height = templ.height;
+        entry.offset = offset;
+        std::uint8_t* gray = &set.m_pixels[offset];
+        PixelConvert::ConvertRows(templ, PixelFormat::GRAY8, gray, templ.width);
+
+        std::uint64_t sumSq = 0;
+        for (int y = 0; y < templ.height; y++) {
+            const std::uint8_t* row = gray + static_cast<size_t>(y) * templ.width;
+            sumSq += kernels.dotRow(row, row, templ.width);
+        }
+        double pixelCount = static_cast<double>(templ.width) * templ.height;
+        entry.sum = BlockSum(gray, templ.width, 0, 0, templ.width, templ.height);
+        entry.variance = static_cast<double>(sumSq) - entry.sum * entry.sum / pixelCount;
+        entry.stdDev = std::sqrt(std::max(0.0, entry.variance / pixelCount));
+
+        for (int i = 0; i < kSampleCount; i++) {
+            int sampleX = ((i % 4) * 2 + 1) * templ.width / 8;
+            int sampleY = ((i / 4) * 2 + 1) * templ.height / 8;
+            entry.sampleX[i] = static_cast<std::uint16_t>(sampleX);
+            entry.sampleY[i] = static_cast<std::uint16_t>(sampleY);
+            entry.sampleValues[i] = gray[static_cast<size_t>(sampleY) * templ.width + sampleX];
+        }
+        set.m_templates.push_back(entry);
+        offset += static_cast<size_t>(templ.width) * templ.height;
+    }
+
+    // 按尺寸分组
+    std::vector<int> order(templates.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        order[i] = static_cast<int>(i);
+    }
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        const Entry& ea = set.m_templates[a];
+        const Entry& eb = set.m_templates[b];
+        return ea.height != eb.height ? ea.height < eb.height : ea.width < eb.width;
+    });
+
+    for (size_t begin = 0; begin < order.size();) {
+        const Entry& first = set.m_templates[order[begin]];
+        size_t end = begin;
+        while (end < order.size() && set.m_templates[order[end]].width == first.width &&
+               set.m_templates[order[end]].height == first.height) {
+            end++;
+        }
+
+        Group group;
+        group.width = first.width;
+        group.height = first.height;
+        group.factor = CoarseFactor(first.width, first.height);
+        group.coarseWidth = CoarseLength(first.width, group.factor);
+        group.coarseHeight = CoarseLength(first.height, group.factor);
+        group.quadWidth = group.coarseWidth / 2;
+        group.quadHeight = group.coarseHeight / 2;
+        const int rightX = group.coarseWidth - group.quadWidth;
+        const int bottomY = group.coarseHeight - group.quadHeight;
+        const double quadArea = static_cast<double>(group.quadWidth) * group.quadHeight;
+        const double coarseArea = static_cast<double>(group.coarseWidth) * group.coarseHeight;
+
+        // 每个模板在每种相位下缩小为一个变体
+        const size_t firstVariant = set.m_variants.size();
+        const size_t coarseSize = static_cast<size_t>(group.coarseWidth) * group.coarseHeight;
+        std::vector<std::array<std::int32_t, 4>> quadSums;
+        for (size_t i = begin; i < end; i++) {
+            const Entry& entry = set.m_templates[order[i]];
+            const std::uint8_t* gray = &set.m_pixels[entry.offset];
+            for (int phaseY = 0; phaseY < group.factor; phaseY++) {
+                for (int phaseX = 0; phaseX < group.factor; phaseX++) {
+                    Variant variant;
+                    variant.templateIndex = order[i];
+                    variant.phaseX = phaseX;
+                    variant.phaseY = phaseY;
+                    variant.offset = set.m_coarsePixels.size();
+                    set.m_coarsePixels.resize(variant.offset + coarseSize);
+                    std::uint8_t* coarse = &set.m_coarsePixels[variant.offset];
+                    ReduceTemplate(gray, entry.width, phaseX, phaseY, group.factor, group.coarseWidth,
+                                   group.coarseHeight, coarse);
+                    quadSums.push_back({BlockSum(coarse, group.coarseWidth, 0, 0, group.quadWidth, group.quadHeight),
+                                        BlockSum(coarse, group.coarseWidth, rightX, 0, group.quadWidth, group.quadHeight),
+                                        BlockSum(coarse, group.coarseWidth, 0, bottomY, group.quadWidth, group.quadHeight),
+                                        BlockSum(coarse, group.coarseWidth, rightX, bottomY, group.quadWidth,
+                                                 group.quadHeight)});
+                    double sum = 0.0;
+                    double sumSq = 0.0;
+                    for (size_t p = 0; p < coarseSize; p++) {
+                        sum += coarse[p];
+                        sumSq += static_cast<double>(coarse[p]) * coarse[p];
+                    }
+                    variant.sum = sum;
+                    variant.variance = sumSq - sum * sum / coarseArea;
+                    variant.stdDev = std::sqrt(std::max(0.0, variant.variance / coarseArea));
+                    set.m_variants.push_back(variant);
+                }
+            }
+        }
+        group.minStdDev = set.m_variants[firstVariant].stdDev;
+        for (size_t v = firstVariant; v < set.m_variants.size(); v++) {
+            group.minStdDev = std::min(group.minStdDev, set.m_variants[v].stdDev);
+        }
+
+        // 每个角块均值与标准差可能对应的窗口区间（容差两侧各多放宽1级，覆盖单精度取整）
+        auto binRange = [&](std::int32_t quadSum, int& low, int& high) {
+            double mean = quadSum / quadArea;
+            low = static_cast<int>(std::max(0.0, mean - meanTolerance - 1)) / set.m_binWidth;
+            high = static_cast<int>(std::min(255.0, mean + meanTolerance + 1)) / set.m_binWidth;
+        };
+        const bool useStd = group.coarseWidth * group.coarseHeight <= kMaxStdArea;
+        const int maxStdBin = (1 << kStdBits) - 1;
+        std::vector<std::pair<int, int>> keyed;  // (格子键, 变体下标)
+        for (size_t v = firstVariant; v < set.m_variants.size(); v++) {
+            const Variant& variant = set.m_variants[v];
+            int low[4];
+            int high[4];
+            for (int q = 0; q < 4; q++) {
+                binRange(quadSums[v - firstVariant][q], low[q], high[q]);
+            }
+            int stdLow = 0;
+            int stdHigh = 0;
+            if (useStd) {
+                stdLow = std::min(maxStdBin, static_cast<int>(std::max(0.0, variant.stdDev - meanTolerance - 1)) /
+                                                 set.m_stdBinWidth);
+                stdHigh = std::min(maxStdBin, static_cast<int>(variant.stdDev + meanTolerance + 1) / set.m_stdBinWidth);
+            }
+            for (int b0 = low[0]; b0 <= high[0]; b0++) {
+                for (int b1 = low[1]; b1 <= high[1]; b1++) {
+                    for (int b2 = low[2]; b2 <= high[2]; b2++) {
+                        for (int b3 = low[3]; b3 <= high[3]; b3++) {
+                            for (int sb = stdLow; sb <= stdHigh; sb++) {
+                                keyed.emplace_back(CellKey(b0, b1, b2, b3, sb), static_cast<int>(v));
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        std::stable_sort(keyed.begin(), keyed.end(),
+                         [](const std::pair<int, int>& a, const std::pair<int, int>& b) { return a.first < b.first; });
+
+        // 按键顺序压缩：第 k 个非空格子即位图中第 k 个置位；
+        // 变体按模板顺序生成，格子内同一模板的变体相邻，合为一段
+        const std::int32_t quadLimit = meanTolerance * group.quadWidth * group.quadHeight;
+        group.occupied.assign(kCellCount / 64, 0);
+        for (size_t i = 0; i < keyed.size(); i++) {
+            const bool newCell = i == 0 || keyed[i].first != keyed[i - 1].first;
+            if (newCell) {
+                group.occupied[keyed[i].first / 64] |= 1ull << (keyed[i].first % 64);
+                group.cellStart.push_back(static_cast<int>(group.cellRuns.size()));
+            }
+            const int index = keyed[i].second;
+            if (newCell ||
+                set.m_variants[index].templateIndex != set.m_variants[keyed[i - 1].second].templateIndex) {
+                CellRun run;
+                run.quadLow.fill(std::numeric_limits<std::int32_t>::max());
+                run.quadHigh.fill(std::numeric_limits<std::int32_t>::min());
+                run.memberBegin = static_cast<int>(group.cellMembers.size());
+                group.cellRuns.push_back(run);
+            }
+            CellMember member;
+            member.quadSums = quadSums[index - firstVariant];
+            member.variant = index;
+            group.cellMembers.push_back(member);
+
+            CellRun& run = group.cellRuns.back();
+            for (int q = 0; q < 4; q++) {
+                run.quadLow[q] = std::min(run.quadLow[q], member.quadSums[q] - quadLimit);
+                run.quadHigh[q] = std::max(run.quadHigh[q], member.quadSums[q] + quadLimit);
+            }
+            run.memberEnd = static_cast<int>(group.cellMembers.size());
+        }
+        group.cellStart.push_back(static_cast<int>(group.cellRuns.size()));
+        group.wordRank.resize(group.occupied.size());
+        int rank = 0;
+        for (size_t w = 0; w < group.occupied.size(); w++) {
+            group.wordRank[w] = rank;
+            rank += PopCount64(group.occupied[w]);
+        }
+
+        set.m_groups.push_back(std::move(group));
+        begin = end;
+    }
+
+    return Result<TemplateSet>::Success(std::move(set));
+}
+
+Result<std::vector<TemplateHit>> FindAll(const ImageView& haystack, const TemplateSet& templates,
+                                         const BatchOptions& options) {
+    if (haystack.IsEmpty()) {
+        return Result<std::vector<TemplateHit>>::Error(ErrorCode::INVALID_PARAMETER, L"Empty image");
+    }
+    if (haystack.format != PixelFormat::BGRA32 && haystack.format != PixelFormat::GRAY8) {
+        return Result<std::vector<TemplateHit>>::Error(ErrorCode::INVALID_PARAMETER, L"Unsupported pixel format");
+    }
+
+    // 灰度大图建立一次，所有尺寸组共用
+    std::vector<std::uint8_t> grayPixels;
+    ImageView gray = haystack;
+    if (haystack.format == PixelFormat::BGRA32) {
+        grayPixels.resize(static_cast<size_t>(haystack.width) * haystack.height);
+        PixelConvert::ConvertRows(haystack, PixelFormat::GRAY8, grayPixels.data(), haystack.width);
+        gray = ImageView(grayPixels.data(), haystack.width, haystack.height, haystack.width, PixelFormat::GRAY8);
+    }
+
+    // 筛选层：按需为用到的缩小倍数（1、2、4）各建立一次缩小图与积分图，同倍数的尺寸组共用
+    struct Level {
+        std::vector<std::uint8_t> pixels;
+        ImageView view;
+        RegionStats::IntegralImage integral;
+        bool ready = false;
+    };
+    Level levels[3];
+    Downscale::DownscaleOptions downscaleOptions;
+    downscaleOptions.multithreaded = options.multithreaded;
+    for (const auto& group : templates.m_groups) {
+        Level& level = levels[LevelIndex(group.factor)];
+        if (level.ready || group.width > haystack.width || group.height > haystack.height) {
+            continue;
+        }
+        level.view = gray;
+        if (group.factor > 1) {
+            const int width = haystack.width / group.factor;
+            const int height = haystack.height / group.factor;
+            level.pixels.resize(static_cast<size_t>(width) * height);
+            auto reduced = Downscale::BoxRows(gray, group.factor, level.pixels.data(), width, downscaleOptions);
+            if (reduced.IsError()) {
+                return Result<std::vector<TemplateHit>>::Error(reduced.GetErrorCode(), reduced.GetErrorMessage());
+            }
+            level.view = ImageView(level.pixels.data(), width, height, width, PixelFormat::GRAY8);
+        }
+        auto built = RegionStats::IntegralImage::Build(level.view);
+        if (built.IsError()) {
+            return Result<std::vector<TemplateHit>>::Error(built.GetErrorCode(), built.GetErrorMessage());
+        }
+        level.integral = std::move(built).TakeData();
+        level.ready = true;
+    }
+
+    const auto& kernels = MatchKernels::GetKernels();
+    const int templateCount = templates.GetTemplateCount();
+    const double tolerance = templates.m_tolerance;
+    // 全掩码：一次遍历窗口行得到乘积和、和与平方和
+    const std::vector<std::uint8_t> fullMask(haystack.width, 0xFF);
+    std::vector<TemplateMatcher::Match> best(templateCount);
+    for (auto& match : best) {
+        match.score = kNoCandidate;
+    }
+    std::mutex mergeMutex;
+
+    auto searchRows = [&](int rowBegin, int rowEnd) {
+        std::vector<TemplateMatcher::Match> local(templateCount);
+        for (auto& match : local) {
+            match.score = kNoCandidate;
+        }
+        std::vector<std::int32_t> topQuads(haystack.width);
+        std::vector<std::int32_t> bottomQuads(haystack.width);
+        std::vector<std::int32_t> topBins(haystack.width);
+        std::vector<std::int32_t> bottomBins(haystack.width);
+        std::vector<std::int32_t> cells(haystack.width);
+        std::vector<std::uint32_t> windowSums(haystack.width);
+        std::vector<std::uint32_t> windowSquares(haystack.width);
+        std::vector<std::int32_t> stdBins(haystack.width, 0);
+        std::vector<std::uint8_t> activeBlocks(haystack.width / kPrescreenBlock + 1);
+
+        // 原图 (x, y) 处核对采样点，再一次遍历窗口得到标准差与 NCC 得分
+        auto verify = [&](int index, int x, int y) {
+            const auto& entry = templates.m_templates[index];
+            int misses = 0;
+            for (int k = 0; k < TemplateSet::kSampleCount && misses <= TemplateSet::kMaxSampleMisses; k++) {
+                int value = gray.Row(y + entry.sampleY[k])[x + entry.sampleX[k]];
+                if (std::abs(value - entry.sampleValues[k]) > templates.m_sampleTolerance) {
+                    misses++;
+                }
+            }
+            if (misses > TemplateSet::kMaxSampleMisses) {
+                return;
+            }
+
+            std::uint64_t dot = 0;
+            std::uint64_t sum = 0;
+            std::uint64_t sumSq = 0;
+            const std::uint8_t* templPixels = &templates.m_pixels[entry.offset];
+            for (int r = 0; r < entry.height; r++) {
+                const MatchKernels::MaskedStats stats = kernels.maskedStatsRow(
+                    gray.Row(y + r) + x, templPixels + static_cast<size_t>(r) * entry.width, fullMask.data(), entry.width);
+                dot += stats.dot;
+                sum += stats.sum;
+                sumSq += stats.sumSq;
+            }
+            const double pixelCount = static_cast<double>(entry.width) * entry.height;
+            const double windowSum = static_cast<double>(sum);
+            const double windowSumSq = static_cast<double>(sumSq);
+            const double variance = (windowSumSq - windowSum * windowSum / pixelCount) / pixelCount;
+            if (std::fabs(std::sqrt(std::max(0.0, variance)) - entry.stdDev) > tolerance) {
+                return;
+            }
+
+            TemplateMatcher::Match match;
+            match.score = MatchKernels::NccScore(static_cast<double>(dot), windowSum, windowSumSq, entry.sum,
+                                                 entry.variance, pixelCount);
+            match.location = WindowsAPI::Point(x, y);
+            if (IsBetter(match, local[index])) {
+                local[index] = match;
+            }
+        };
+
+        for (const auto& group : templates.m_groups) {
+            if (group.width > haystack.width || group.height > haystack.height) {
+                continue;
+            }
+            const Level& level = levels[LevelIndex(group.factor)];
+            const RegionStats::IntegralImage& integral = level.integral;
+            const int factor = group.factor;
+            const int rangeX = level.view.width - group.coarseWidth + 1;
+            // 原图的行块 [rowBegin, rowEnd) 对应缩小图的行 [ceil(rowBegin / f), ceil(rowEnd / f))，相邻块不重叠
+            const int coarseBegin = (rowBegin + factor - 1) / factor;
+            const int rowLimit = std::min((rowEnd + factor - 1) / factor, level.view.height - group.coarseHeight + 1);
+            if (rangeX <= 0 || coarseBegin >= rowLimit) {
+                continue;
+            }
+            const int quadArea = group.quadWidth * group.quadHeight;
+            const int rightX = group.coarseWidth - group.quadWidth;
+            const int bottomY = group.coarseHeight - group.quadHeight;
+            const std::int32_t limit = templates.m_tolerance * quadArea;
+            const float binScale = 1.0f / (static_cast<float>(quadArea) * templates.m_binWidth);
+            const double pixelCount = static_cast<double>(group.coarseWidth) * group.coarseHeight;
+            const bool useStd = group.coarseWidth * group.coarseHeight <= TemplateSet::kMaxStdArea;
+            const float invArea = 1.0f / static_cast<float>(pixelCount);
+            const int maxX = haystack.width - group.width;
+            const int maxY = haystack.height - group.height;
+            float stdEdges[3];
+            for (int k = 0; k < 3; k++) {
+                float edge = static_cast<float>((k + 1) * templates.m_stdBinWidth);
+                stdEdges[k] = edge * edge;
+            }
+            if (!useStd) {
+                std::fill(stdBins.begin(), stdBins.end(), 0);
+            }
+
+            // 方差预筛选：8x8 位置块内所有窗口都落在块的并集矩形 U 内，
+            // 窗口离差平方和不超过 U 的离差平方和，U 都达不到组内最小标准差 - 容差的块可整块跳过
+            const double minDeviation = std::max(0.0, group.minStdDev - tolerance);
+            const double minScatter = pixelCount * minDeviation * minDeviation * (1.0 - 1e-9);
+            const int blockCount = (rangeX + kPrescreenBlock - 1) / kPrescreenBlock;
+
+            // 缩小图 (x, y) 落入第 cell 个格子：先按段、再按变体核对签名，缩小后的 NCC 达到 minScore 再回原图核对
+            auto screenCell = [&](int cell, int x, int y) {
+                double windowSum = 0.0;
+                double windowSumSq = 0.0;
+                double windowStdDev = -1.0;
+                for (int r = group.cellStart[cell]; r < group.cellStart[cell + 1]; r++) {
+                    const auto& run = group.cellRuns[r];
+                    if (!WithinRange(topQuads[x], run.quadLow[0], run.quadHigh[0]) ||
+                        !WithinRange(topQuads[x + rightX], run.quadLow[1], run.quadHigh[1]) ||
+                        !WithinRange(bottomQuads[x], run.quadLow[2], run.quadHigh[2]) ||
+                        !WithinRange(bottomQuads[x + rightX], run.quadLow[3], run.quadHigh[3])) {
+                        continue;
+                    }
+                    for (int i = run.memberBegin; i < run.memberEnd; i++) {
+                        const auto& member = group.cellMembers[i];
+                        if (!WithinTolerance(topQuads[x], member.quadSums[0], limit) ||
+                            !WithinTolerance(topQuads[x + rightX], member.quadSums[1], limit) ||
+                            !WithinTolerance(bottomQuads[x], member.quadSums[2], limit) ||
+                            !WithinTolerance(bottomQuads[x + rightX], member.quadSums[3], limit)) {
+                            continue;
+                        }
+                        const auto& variant = templates.m_variants[member.variant];
+                        if (windowStdDev < 0.0) {
+                            windowSum = static_cast<double>(integral.Sum(x, y, group.coarseWidth, group.coarseHeight));
+                            windowSumSq =
+                                static_cast<double>(integral.SumOfSquares(x, y, group.coarseWidth, group.coarseHeight));
+                            windowStdDev =
+                                std::sqrt(std::max(0.0, (windowSumSq - windowSum * windowSum / pixelCount) / pixelCount));
+                        }
+                        if (std::fabs(windowStdDev - variant.stdDev) > tolerance) {
+                            continue;
+                        }
+                        std::uint64_t dot = 0;
+                        const std::uint8_t* coarse = &templates.m_coarsePixels[variant.offset];
+                        for (int row = 0; row < group.coarseHeight; row++) {
+                            dot += kernels.dotRow(level.view.Row(y + row) + x,
+                                                  coarse + static_cast<size_t>(row) * group.coarseWidth, group.coarseWidth);
+                        }
+                        if (MatchKernels::NccScore(static_cast<double>(dot), windowSum, windowSumSq, variant.sum,
+                                                   variant.variance, pixelCount) < options.minScore) {
+                            continue;
+                        }
+                        const int fullX = factor * x - variant.phaseX;
+                        const int fullY = factor * y - variant.phaseY;
+                        if (fullX >= 0 && fullY >= 0 && fullX <= maxX && fullY <= maxY) {
+                            verify(variant.templateIndex, fullX, fullY);
+                        }
+                    }
+                }
+            };
+
+            for (int blockY = coarseBegin; blockY < rowLimit; blockY += kPrescreenBlock) {
+                const int blockRows = std::min(kPrescreenBlock, rowLimit - blockY);
+                for (int b = 0; b < blockCount; b++) {
+                    const int blockX = b * kPrescreenBlock;
+                    const int blockColumns = std::min(kPrescreenBlock, rangeX - blockX);
+                    bool active = true;
+                    if (minScatter > 0.0) {
+                        const int unionWidth = blockColumns - 1 + group.coarseWidth;
+                        const int unionHeight = blockRows - 1 + group.coarseHeight;
+                        const double sum = static_cast<double>(integral.Sum(blockX, blockY, unionWidth, unionHeight));
+                        const double sumSq =
+                            static_cast<double>(integral.SumOfSquares(blockX, blockY, unionWidth, unionHeight));
+                        active = sumSq - sum * sum / (static_cast<double>(unionWidth) * unionHeight) >= minScatter;
+                    }
+                    activeBlocks[b] = active;
+                }
+
+                for (int y = blockY; y < blockY + blockRows; y++) {
+                    // 逐段处理连续的活跃块：整段的角块和、区间与格子键（可向量化），再逐个位置查位图
+                    for (int b = 0; b < blockCount;) {
+                        if (!activeBlocks[b]) {
+                            b++;
+                            continue;
+                        }
+                        const int runBegin = b * kPrescreenBlock;
+                        while (b < blockCount && activeBlocks[b]) {
+                            b++;
+                        }
+                        const int runEnd = std::min(b * kPrescreenBlock, rangeX);
+
+                        QuadRowSums(integral, y, group.quadWidth, group.quadHeight, runBegin, runEnd + rightX,
+                                    topQuads.data());
+                        QuadRowSums(integral, y + bottomY, group.quadWidth, group.quadHeight, runBegin, runEnd + rightX,
+                                    bottomQuads.data());
+                        QuantizeRow(topQuads.data(), runBegin, runEnd + rightX, binScale, topBins.data());
+                        QuantizeRow(bottomQuads.data(), runBegin, runEnd + rightX, binScale, bottomBins.data());
+                        if (useStd) {
+                            WindowRowSums(integral, y, group.coarseWidth, group.coarseHeight, runBegin, runEnd,
+                                          windowSums.data(), windowSquares.data());
+                            StdBinRow(windowSums.data(), windowSquares.data(), runBegin, runEnd, invArea, stdEdges,
+                                      stdBins.data());
+                        }
+                        CellRow(topBins.data(), bottomBins.data(), stdBins.data(), rightX, runBegin, runEnd,
+                                cells.data());
+
+                        for (int x = runBegin; x < runEnd; x++) {
+                            const int key = cells[x];
+                            const std::uint64_t word = group.occupied[key >> 6];
+                            const std::uint64_t bit = 1ull << (key & 63);
+                            if (!(word & bit)) {
+                                continue;
+                            }
+                            const int cell = group.wordRank[key >> 6] + PopCount64(word & (bit - 1));
+
+                            screenCell(cell, x, y);
+                        }
+                    }
+                }
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mergeMutex);
+        for (int i = 0; i < templateCount; i++) {
+            if (local[i].score > kNoCandidate && IsBetter(local[i], best[i])) {
+                best[i] = local[i];
+            }
+        }
+    };
+
+    if (options.multithreaded) {
+        ThreadPool::GetDefault().ParallelFor(0, haystack.height, searchRows, kMinRowsPerChunk);
+    } else {
+        searchRows(0, haystack.height);
+    }
+
+    std::vector<TemplateHit> hits(templateCount);
+    for (int i = 0; i < templateCount; i++) {
+        if (best[i].score > kNoCandidate) {
+            hits[i].best = best[i];
+            hits[i].found = best[i].score >= options.minScore;
+        } else {
+            hits[i].best.score = -1.0;
+        }
+    }
+    return Result<std::vector<TemplateHit>>::Success(std::move(hits));
+}
+
+}  // namespace BatchMatcher
@@ -0,0 +1,299 @@
+#include "../include/Blobs.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+
+namespace Blobs {
+
+// 内部辅助函数
+namespace {
+    // 像素数超过该值时才按行带并行
+    const long long kParallelPixelThreshold = 256 * 256;
+    // 每个行带的最少行数
+    const int kMinStripeRows = 32;
+
+    // 一行中连续的前景像素 [x0, x1)
+    struct Run {
+        int x0;
+        int x1;
+    };
+
+    // 行带 [y0, y1)：rowStart[r] 为第 y0 + r 行第一个游程在 runs 中的下标（末尾多一项），
+    // offset 为本带第一个游程在全局并查集中的下标
+    struct Stripe {
+        int y0 = 0;
+        int y1 = 0;
+        std::vector<Run> runs;
+        std::vector<int> rowStart;
+        int offset = 0;
+    };
+
+    // 连通域累加量（质心按 2 倍坐标累加，避免游程中心的半像素）
+    struct Accumulator {
+        long long area = 0;
+        long long sumX2 = 0;
+        long long sumY = 0;
+        int left = 0;
+        int top = 0;
+        int right = 0;
+        int bottom = 0;
+    };
+
+    inline std::uint64_t Load64(const std::uint8_t* p) {
+        std::uint64_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    inline bool HasZeroByte(std::uint64_t v) {
+        return ((v - 0x0101010101010101ULL) & ~v & 0x8080808080808080ULL) != 0;
+    }
+
+    // MONO1 行（高位在前）：游程外整 8 字节为 0、游程内整 8 字节为 0xFF 时直接跳过
+    void Mono1Runs(const std::uint8_t* row, int width, std::vector<Run>& runs) {
+        const size_t first = runs.size();
+        const int bytes = (width + 7) / 8;
+        bool inside = false;
+        int start = 0;
+        int i = 0;
+        while (i < bytes) {
+            const std::uint64_t skip = inside ? ~0ULL : 0ULL;
+            if (i + 8 <= bytes && Load64(row + i) == skip) {
+                i += 8;
+                continue;
+            }
+            const std::uint8_t b = row[i];
+            if (b != static_cast<std::uint8_t>(skip)) {
+                for (int bit = 0; bit < 8; bit++) {
+                    const bool on = (b >> (7 - bit)) & 1;
+                    if (on != inside) {
+                        if (on) {
+                            start = i * 8 + bit;
+                        } else {
+                            runs.push_back({start, i * 8 + bit});
+                        }
+                        inside = on;
+                    }
+                }
+            }
+            i++;
+        }
+        if (inside) {
+            runs.push_back({start, bytes * 8});
+        }
+
+        // 最后一个字节中宽度之外的位不属于图像
+        while (runs.size() > first && runs.back().x0 >= width) {
+            runs.pop_back();
+        }
+        if (runs.size() > first) {
+            runs.back().x1 = std::min(runs.back().x1, width);
+        }
+    }
+
+    // GRAY8 行（非 0 为前景）：游程外整 8 字节为 0、游程内整 8 字节都非 0 时直接跳过
+    void Gray8Runs(const std::uint8_t* row, int width, std::vector<Run>& runs) {
+        bool inside = false;
+        int start = 0;
+        int x = 0;
+        while (x < width) {
+            if (x + 8 <= width) {
+                const std::uint64_t word = Load64(row + x);
+                if (inside ? !HasZeroByte(word) : word == 0) {
+                    x += 8;
+                    continue;
+                }
+            }
+            const bool on = row[x] != 0;
+            if (on != inside) {
+                if (on) {
+                    start = x;
+                } else {
+                    runs.push_back({start, x});
+                }
+                inside = on;
+            }
+            x++;
+        }
+        if (inside) {
+            runs.push_back({start, width});
+        }
+    }
+
+    int Find(std::vector<int>& parent, int x) {
+        while (parent[x] != x) {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    }
+
+    // 较大的根挂到较小的根下，保持 parent[i] <= i
+    void Union(std::vector<int>& parent, int a, int b) {
+        a = Find(parent, a);
+        b = Find(parent, b);
+        if (a < b) {
+            parent[b] = a;
+        } else if (b < a) {
+            parent[a] = b;
+        }
+    }
+
+    // 合并相邻两行中相互接触的游程；slack 为 1 时对角相邻也算接触（8 连通）
+    void UnionRows(std::vector<int>& parent, const Run* upper, int upperBase, int upperCount,
+                   const Run* lower, int lowerBase, int lowerCount, int slack) {
+        int i = 0;
+        int j = 0;
+        while (i < upperCount && j < lowerCount) {
+            const Run& u = upper[i];
+            const Run& l = lower[j];
+            if (u.x1 + slack <= l.x0) {
+                i++;
+            } else if (l.x1 + slack <= u.x0) {
+                j++;
+            } else {
+                Union(parent, upperBase + i, lowerBase + j);
+                // 先结束的游程不会再接触另一行后面的游程
+                if (u.x1 < l.x1) {
+                    i++;
+                } else {
+                    j++;
+                }
+            }
+        }
+    }
+
+    void ExtractStripe(const ImageView& mask, Stripe& stripe) {
+        stripe.rowStart.reserve(static_cast<size_t>(stripe.y1 - stripe.y0) + 1);
+        for (int y = stripe.y0; y < stripe.y1; y++) {
+            stripe.rowStart.push_back(static_cast<int>(stripe.runs.size()));
+            if (mask.format == PixelFormat::MONO1) {
+                Mono1Runs(mask.Row(y), mask.width, stripe.runs);
+            } else {
+                Gray8Runs(mask.Row(y), mask.width, stripe.runs);
+            }
+        }
+        stripe.rowStart.push_back(static_cast<int>(stripe.runs.size()));
+    }
+
+    // 行带内的合并只修改本带下标范围内的 parent，可以与其他行带并行
+    void UnionStripe(std::vector<int>& parent, const Stripe& stripe, int slack) {
+        for (size_t i = 0; i < stripe.runs.size(); i++) {
+            parent[stripe.offset + i] = stripe.offset + static_cast<int>(i);
+        }
+        for (int r = 1; r < stripe.y1 - stripe.y0; r++) {
+            const int upper = stripe.rowStart[r - 1];
+            const int lower = stripe.rowStart[r];
+            UnionRows(parent, stripe.runs.data() + upper, stripe.offset + upper, lower - upper,
+                      stripe.runs.data() + lower, stripe.offset + lower, stripe.rowStart[r + 1] - lower, slack);
+        }
+    }
+}
+
+Result<std::vector<Blob>> FindBlobs(const ImageView& mask, const LabelOptions& options) {
+    if (mask.IsEmpty()) {
+        return Result<std::vector<Blob>>::Error(ErrorCode::INVALID_PARAMETER, L"Empty mask");
+    }
+    if (mask.format != PixelFormat::MONO1 && mask.format != PixelFormat::GRAY8) {
+        return Result<std::vector<Blob>>::Error(ErrorCode::INVALID_PARAMETER, L"Mask must be MONO1 or GRAY8");
+    }
+    if (options.minArea < 0) {
+        return Result<std::vector<Blob>>::Error(ErrorCode::INVALID_PARAMETER, L"minArea must not be negative");
+    }
+    const int slack = options.connectivity == Connectivity::EIGHT ? 1 : 0;
+
+    ThreadPool& pool = ThreadPool::GetDefault();
+    const long long pixelCount = static_cast<long long>(mask.width) * mask.height;
+    int stripeCount = 1;
+    if (options.multithreaded && pool.GetThreadCount() > 0 && pixelCount >= kParallelPixelThreshold) {
+        stripeCount = std::max(1, std::min(mask.height / kMinStripeRows, static_cast<int>(pool.GetThreadCount() + 1) * 4));
+    }
+    std::vector<Stripe> stripes(stripeCount);
+    for (int s = 0; s < stripeCount; s++) {
+        stripes[s].y0 = static_cast<int>(static_cast<long long>(mask.height) * s / stripeCount);
+        stripes[s].y1 = static_cast<int>(static_cast<long long>(mask.height) * (s + 1) / stripeCount);
+    }
+    auto forEachStripe = [&](const std::function<void(Stripe&)>& body) {
+        if (stripeCount == 1) {
+            body(stripes[0]);
+            return;
+        }
+        pool.ParallelFor(0, stripeCount, [&](int begin, int end) {
+            for (int s = begin; s < end; s++) {
+                body(stripes[s]);
+            }
+        });
+    };
+
+    // 第一遍：各行带提取游程并在带内合并，再串行合并行带边界
+    forEachStripe([&](Stripe& stripe) { ExtractStripe(mask, stripe); });
+    int runCount = 0;
+    for (auto& stripe : stripes) {
+        stripe.offset = runCount;
+        runCount += static_cast<int>(stripe.runs.size());
+    }
+    std::vector<int> parent(runCount);
+    forEachStripe([&](Stripe& stripe) { UnionStripe(parent, stripe, slack); });
+    for (int s = 1; s < stripeCount; s++) {
+        const Stripe& upper = stripes[s - 1];
+        const Stripe& lower = stripes[s];
+        const int rows = upper.y1 - upper.y0;
+        if (rows == 0 || lower.y1 == lower.y0) {
+            continue;
+        }
+        const int upperFirst = upper.rowStart[rows - 1];
+        UnionRows(parent, upper.runs.data() + upperFirst, upper.offset + upperFirst, upper.rowStart[rows] - upperFirst,
+                  lower.runs.data(), lower.offset, lower.rowStart[1], slack);
+    }
+
+    // 第二遍：parent[i] <= i，按下标顺序即可把每个游程解析为连通域编号（编号即光栅顺序），同时累加统计量
+    std::vector<int> label(runCount);
+    std::vector<Accumulator> accumulators;
+    int index = 0;
+    for (const auto& stripe : stripes) {
+        for (int r = 0; r < stripe.y1 - stripe.y0; r++) {
+            const int y = stripe.y0 + r;
+            for (int k = stripe.rowStart[r]; k < stripe.rowStart[r + 1]; k++, index++) {
+                const Run& run = stripe.runs[k];
+                if (parent[index] == index) {
+                    label[index] = static_cast<int>(accumulators.size());
+                    Accumulator fresh;
+                    fresh.left = run.x0;
+                    fresh.top = y;
+                    fresh.right = run.x1;
+                    fresh.bottom = y + 1;
+                    accumulators.push_back(fresh);
+                } else {
+                    label[index] = label[parent[index]];
+                }
+                Accumulator& acc = accumulators[label[index]];
+                const long long length = run.x1 - run.x0;
+                acc.area += length;
+                acc.sumX2 += static_cast<long long>(run.x0 + run.x1 - 1) * length;
+                acc.sumY += static_cast<long long>(y) * length;
+                acc.left = std::min(acc.left, run.x0);
+                acc.right = std::max(acc.right, run.x1);
+                acc.bottom = y + 1;
+            }
+        }
+    }
+
+    std::vector<Blob> blobs;
+    for (const auto& acc : accumulators) {
+        if (acc.area < options.minArea) {
+            continue;
+        }
+        Blob blob;
+        blob.area = static_cast<int>(acc.area);
+        blob.bounds = WindowsAPI::Rectangle(acc.left, acc.top, acc.right, acc.bottom);
+        blob.centroidX = static_cast<double>(acc.sumX2) / (2.0 * acc.area);
+        blob.centroidY = static_cast<double>(acc.sumY) / acc.area;
+        blobs.push_back(blob);
+    }
+    return Result<std::vector<Blob>>::Success(std::move(blobs));
+}
+
+}  // namespace Blobs
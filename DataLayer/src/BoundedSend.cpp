@@ -0,0 +1,35 @@
+#include "../include/BoundedSend.h"
+#include <windows.h>
+
+#include <chrono>
+
+namespace BoundedSend {
+
+Result<SendOutcome> Send(HWND windowHandle, UINT message, WPARAM wParam, LPARAM lParam, UINT timeoutMs) {
+    if (!IsWindow(windowHandle)) {
+        return Result<SendOutcome>::Error(ErrorCode::INVALID_HANDLE, L"Invalid window handle");
+    }
+
+    SendOutcome outcome;
+    DWORD_PTR result = 0;
+    const auto start = std::chrono::steady_clock::now();
+    const LRESULT sent = SendMessageTimeout(windowHandle, message, wParam, lParam,
+                                            SMTO_NORMAL | SMTO_ABORTIFHUNG, timeoutMs, &result);
+    const DWORD error = sent ? ERROR_SUCCESS : GetLastError();
+    outcome.latencyMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    if (sent) {
+        outcome.result = static_cast<LRESULT>(result);
+        outcome.completed = true;
+        return Result<SendOutcome>::Success(outcome);
+    }
+    if (error == ERROR_INVALID_WINDOW_HANDLE) {
+        // 等待期间窗口被销毁
+        return Result<SendOutcome>::Error(ErrorCode::INVALID_HANDLE, L"Window destroyed during send");
+    }
+    // SMTO_ABORTIFHUNG 与 IsHungAppWindow 使用同一判定（约 5 秒未取消息）
+    outcome.hung = IsHungAppWindow(windowHandle) != FALSE;
+    return Result<SendOutcome>::Success(outcome);
+}
+
+}  // namespace BoundedSend
@@ -0,0 +1,81 @@
+#include "../include/CaptureSession.h"
+
+#include <utility>
+
+namespace ScreenCapture {
+
+CaptureSession::CaptureSession(std::unique_ptr<CaptureBackend> backend)
+    : m_backend(std::move(backend)) {}
+
+CaptureSession::~CaptureSession() {
+    Reset();
+}
+
+Result<ImageView> CaptureSession::Capture() {
+    if (!m_backend) {
+        return Result<ImageView>::Error(ErrorCode::INVALID_PARAMETER, L"Capture backend is null");
+    }
+    
+    auto boundsResult = m_backend->QuerySourceBounds();
+    if (boundsResult.IsError()) {
+        return Result<ImageView>::Error(boundsResult.GetErrorCode(), boundsResult.GetErrorMessage());
+    }
+    
+    int width = boundsResult.GetData().width();
+    int height = boundsResult.GetData().height();
+    if (width <= 0 || height <= 0) {
+        return Result<ImageView>::Error(ErrorCode::INVALID_PARAMETER, L"Invalid source dimensions");
+    }
+    
+    // 仅在尺寸变化时重新分配表面
+    auto surfaceResult = EnsureSurface(width, height);
+    if (surfaceResult.IsError()) {
+        return Result<ImageView>::Error(surfaceResult.GetErrorCode(), surfaceResult.GetErrorMessage());
+    }
+    
+    auto grabResult = m_backend->Grab(m_surface);
+    if (grabResult.IsError()) {
+        return Result<ImageView>::Error(grabResult.GetErrorCode(), grabResult.GetErrorMessage());
+    }
+    
+    m_statistics.frameCount++;
+    
+    ImageView view(m_surface.pixels, m_surface.width, m_surface.height, m_surface.stride, PixelFormat::BGRA32);
+    return Result<ImageView>::Success(view);
+}
+
+void CaptureSession::Reset() {
+    if (m_hasSurface && m_backend) {
+        m_backend->ReleaseSurface();
+    }
+    m_surface = CaptureSurface();
+    m_hasSurface = false;
+}
+
+Result<bool> CaptureSession::EnsureSurface(int width, int height) {
+    if (m_hasSurface && m_surface.width == width && m_surface.height == height) {
+        return Result<bool>::Success(true);
+    }
+    
+    Reset();
+    
+    auto allocResult = m_backend->AllocateSurface(width, height);
+    if (allocResult.IsError()) {
+        return Result<bool>::Error(allocResult.GetErrorCode(), allocResult.GetErrorMessage());
+    }
+    
+    const CaptureSurface& surface = allocResult.GetData();
+    if (surface.pixels == nullptr || surface.width != width || surface.height != height ||
+        surface.stride < width * 4) {
+        m_backend->ReleaseSurface();
+        return Result<bool>::Error(ErrorCode::MEMORY_ALLOCATION_FAILED, L"Backend returned an invalid surface");
+    }
+    
+    m_surface = surface;
+    m_hasSurface = true;
+    m_statistics.allocationCount++;
+    
+    return Result<bool>::Success(true);
+}
+
+}  // namespace ScreenCapture
@@ -0,0 +1,504 @@
+#include "../include/ColorSearch.h"
+#include "CpuFeatures.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdlib>
+
+#ifdef WINDOWSAPI_X86
+#include <immintrin.h>
+#endif
+
+namespace ColorSearch {
+
+// 内部辅助函数
+namespace {
+    // 像素数超过该值时才按行带并行扫描
+    const long long kParallelPixelThreshold = 256 * 256;
+    // 螺旋搜索第一圈的半径，之后每次翻倍
+    const int kFirstSpiralRadius = 15;
+
+    // 编译后的判定条件
+    struct Criteria {
+        bool hsv = false;
+        std::uint32_t low = 0;       // ColorRange 下界（打包 B,G,R,A）
+        std::uint32_t high = 0;      // ColorRange 上界
+        HsvRange hsvRange;
+        bool checkHue = false;       // 色相区间不是全范围时才逐点计算色相
+    };
+
+    // 一段连续像素 [x0, x1)
+    struct Segment {
+        int y;
+        int x0;
+        int x1;
+    };
+
+    // 扫描一段像素，把命中像素的下标写入 hits，最多写 maxHits 个，返回写入个数
+    using RowKernel = int (*)(const std::uint8_t* pixels, int count, const Criteria& criteria,
+                              std::int32_t* hits, int maxHits);
+
+    std::uint32_t PackChannels(const std::array<std::uint8_t, 4>& channels) {
+        return static_cast<std::uint32_t>(channels[0]) |
+               (static_cast<std::uint32_t>(channels[1]) << 8) |
+               (static_cast<std::uint32_t>(channels[2]) << 16) |
+               (static_cast<std::uint32_t>(channels[3]) << 24);
+    }
+
+    // 色相（度，0-359），与 SIMD 路径使用相同的整数规则
+    int ComputeHue(int b, int g, int r) {
+        int value = std::max(b, std::max(g, r));
+        int delta = value - std::min(b, std::min(g, r));
+        if (delta == 0) {
+            return 0;
+        }
+        int hue;
+        if (value == r) {
+            hue = 60 * (g - b) / delta;
+        } else if (value == g) {
+            hue = 120 + 60 * (b - r) / delta;
+        } else {
+            hue = 240 + 60 * (r - g) / delta;
+        }
+        return hue < 0 ? hue + 360 : hue;
+    }
+
+    bool HueInRange(const std::uint8_t* p, const HsvRange& range) {
+        int hue = ComputeHue(p[0], p[1], p[2]);
+        if (range.hueMin <= range.hueMax) {
+            return hue >= range.hueMin && hue <= range.hueMax;
+        }
+        return hue >= range.hueMin || hue <= range.hueMax;
+    }
+
+    // 明度与饱和度判定：S = delta * 255 / V（向下取整），改写为乘法比较避免除法
+    bool ValueSaturationInRange(const std::uint8_t* p, const HsvRange& range) {
+        int value = std::max(p[0], std::max(p[1], p[2]));
+        int delta = value - std::min(p[0], std::min(p[1], p[2]));
+        if (value < range.valueMin || value > range.valueMax) {
+            return false;
+        }
+        // V 为 0 时 S 定义为 0，把除数按 1 处理即可得到同样的结论
+        int divisor = std::max(value, 1);
+        int scaled = delta * 255;
+        return scaled >= range.saturationMin * divisor && scaled < (range.saturationMax + 1) * divisor;
+    }
+
+    bool PixelMatches(const std::uint8_t* p, const Criteria& criteria) {
+        if (criteria.hsv) {
+            return ValueSaturationInRange(p, criteria.hsvRange) &&
+                   (!criteria.checkHue || HueInRange(p, criteria.hsvRange));
+        }
+        for (int c = 0; c < 4; c++) {
+            int low = static_cast<int>((criteria.low >> (c * 8)) & 0xFF);
+            int high = static_cast<int>((criteria.high >> (c * 8)) & 0xFF);
+            if (p[c] < low || p[c] > high) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    int ScanScalar(const std::uint8_t* pixels, int count, const Criteria& criteria,
+                   std::int32_t* hits, int maxHits) {
+        int found = 0;
+        for (int i = 0; i < count && found < maxHits; i++) {
+            if (PixelMatches(pixels + i * 4, criteria)) {
+                hits[found++] = i;
+            }
+        }
+        return found;
+    }
+
+    // 把 SIMD 比较得到的候选位展开为下标（HSV 需要再逐点校验色相）
+    inline int EmitHits(unsigned mask, int lanes, int base, const std::uint8_t* pixels, const Criteria& criteria,
+                        std::int32_t* hits, int found, int maxHits) {
+        for (int lane = 0; lane < lanes && found < maxHits; lane++) {
+            if (!(mask & (1u << lane))) {
+                continue;
+            }
+            int index = base + lane;
+            if (criteria.checkHue && !HueInRange(pixels + index * 4, criteria.hsvRange)) {
+                continue;
+            }
+            hits[found++] = index;
+        }
+        return found;
+    }
+
+#ifdef WINDOWSAPI_X86
+    WINDOWSAPI_TARGET("sse2")
+    int ScanSSE2(const std::uint8_t* pixels, int count, const Criteria& criteria,
+                 std::int32_t* hits, int maxHits) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i byteMask = _mm_set1_epi32(0xFF);
+        const __m128i low = _mm_set1_epi32(static_cast<int>(criteria.low));
+        const __m128i high = _mm_set1_epi32(static_cast<int>(criteria.high));
+        const HsvRange& hsv = criteria.hsvRange;
+        const __m128i valueMin = _mm_set1_epi32(hsv.valueMin);
+        const __m128i valueMax = _mm_set1_epi32(hsv.valueMax);
+        const __m128i satMin = _mm_set1_epi32(hsv.saturationMin);
+        const __m128i satMaxPlusOne = _mm_set1_epi32(hsv.saturationMax + 1);
+        const __m128i scale = _mm_set1_epi32(255);
+        const __m128i one = _mm_set1_epi32(1);
+
+        int found = 0;
+        int i = 0;
+        for (; i + 4 <= count && found < maxHits; i += 4) {
+            __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i * 4));
+            __m128i match;
+            if (criteria.hsv) {
+                // 字节0 依次与 G、R 取最大/最小得到 V 与 min(B,G,R)
+                __m128i g = _mm_srli_epi32(px, 8);
+                __m128i r = _mm_srli_epi32(px, 16);
+                __m128i value = _mm_and_si128(_mm_max_epu8(px, _mm_max_epu8(g, r)), byteMask);
+                __m128i minimum = _mm_and_si128(_mm_min_epu8(px, _mm_min_epu8(g, r)), byteMask);
+                // 乘积不超过 65280，16 位乘法的低半部分即为准确结果；V 为 0 时除数按 1 处理
+                __m128i scaled = _mm_mullo_epi16(_mm_sub_epi32(value, minimum), scale);
+                __m128i divisor = _mm_max_epi16(value, one);
+                __m128i bad = _mm_or_si128(_mm_cmpgt_epi32(valueMin, value), _mm_cmpgt_epi32(value, valueMax));
+                bad = _mm_or_si128(bad, _mm_cmpgt_epi32(_mm_mullo_epi16(divisor, satMin), scaled));
+                __m128i belowMax = _mm_cmpgt_epi32(_mm_mullo_epi16(divisor, satMaxPlusOne), scaled);
+                match = _mm_andnot_si128(bad, belowMax);
+            } else {
+                __m128i outside = _mm_or_si128(_mm_subs_epu8(px, high), _mm_subs_epu8(low, px));
+                match = _mm_cmpeq_epi32(outside, zero);
+            }
+            unsigned mask = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(match)));
+            if (mask) {
+                found = EmitHits(mask, 4, i, pixels, criteria, hits, found, maxHits);
+            }
+        }
+        if (i < count && found < maxHits) {
+            int tail = ScanScalar(pixels + i * 4, count - i, criteria, hits + found, maxHits - found);
+            for (int k = 0; k < tail; k++) {
+                hits[found + k] += i;
+            }
+            found += tail;
+        }
+        return found;
+    }
+
+    WINDOWSAPI_TARGET("avx2")
+    int ScanAVX2(const std::uint8_t* pixels, int count, const Criteria& criteria,
+                 std::int32_t* hits, int maxHits) {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i byteMask = _mm256_set1_epi32(0xFF);
+        const __m256i low = _mm256_set1_epi32(static_cast<int>(criteria.low));
+        const __m256i high = _mm256_set1_epi32(static_cast<int>(criteria.high));
+        const HsvRange& hsv = criteria.hsvRange;
+        const __m256i valueMin = _mm256_set1_epi32(hsv.valueMin);
+        const __m256i valueMax = _mm256_set1_epi32(hsv.valueMax);
+        const __m256i satMin = _mm256_set1_epi32(hsv.saturationMin);
+        const __m256i satMaxPlusOne = _mm256_set1_epi32(hsv.saturationMax + 1);
+        const __m256i scale = _mm256_set1_epi32(255);
+        const __m256i one = _mm256_set1_epi32(1);
+
+        int found = 0;
+        int i = 0;
+        for (; i + 8 <= count && found < maxHits; i += 8) {
+            __m256i px = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pixels + i * 4));
+            __m256i match;
+            if (criteria.hsv) {
+                __m256i g = _mm256_srli_epi32(px, 8);
+                __m256i r = _mm256_srli_epi32(px, 16);
+                __m256i value = _mm256_and_si256(_mm256_max_epu8(px, _mm256_max_epu8(g, r)), byteMask);
+                __m256i minimum = _mm256_and_si256(_mm256_min_epu8(px, _mm256_min_epu8(g, r)), byteMask);
+                __m256i scaled = _mm256_mullo_epi16(_mm256_sub_epi32(value, minimum), scale);
+                __m256i divisor = _mm256_max_epi16(value, one);
+                __m256i bad = _mm256_or_si256(_mm256_cmpgt_epi32(valueMin, value),
+                                              _mm256_cmpgt_epi32(value, valueMax));
+                bad = _mm256_or_si256(bad, _mm256_cmpgt_epi32(_mm256_mullo_epi16(divisor, satMin), scaled));
+                __m256i belowMax = _mm256_cmpgt_epi32(_mm256_mullo_epi16(divisor, satMaxPlusOne), scaled);
+                match = _mm256_andnot_si256(bad, belowMax);
+            } else {
+                __m256i outside = _mm256_or_si256(_mm256_subs_epu8(px, high), _mm256_subs_epu8(low, px));
+                match = _mm256_cmpeq_epi32(outside, zero);
+            }
+            unsigned mask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(match)));
+            if (mask) {
+                found = EmitHits(mask, 8, i, pixels, criteria, hits, found, maxHits);
+            }
+        }
+        if (i < count && found < maxHits) {
+            int tail = ScanSSE2(pixels + i * 4, count - i, criteria, hits + found, maxHits - found);
+            for (int k = 0; k < tail; k++) {
+                hits[found + k] += i;
+            }
+            found += tail;
+        }
+        return found;
+    }
+#endif
+
+    RowKernel SelectKernel() {
+#ifdef WINDOWSAPI_X86
+        switch (CpuFeatures::GetSimdLevel()) {
+            case CpuFeatures::SimdLevel::AVX2: return ScanAVX2;
+            case CpuFeatures::SimdLevel::SSSE3:
+            case CpuFeatures::SimdLevel::SSE2: return ScanSSE2;
+            default: break;
+        }
+#endif
+        return ScanScalar;
+    }
+
+    // 按顺序扫描一组行段，最多返回 limit 个命中（0 表示不限）
+    std::vector<Point> ScanSegments(const ImageView& image, const std::vector<Segment>& segments,
+                                    const Criteria& criteria, int limit, bool multithreaded) {
+        RowKernel kernel = SelectKernel();
+        int cap = limit > 0 ? limit : INT_MAX;
+
+        // 扫描 [first, last) 段，命中写入 out
+        auto scanRange = [&](size_t first, size_t last, std::vector<Point>& out, const std::atomic<int>* stopBefore,
+                             int band) {
+            std::vector<std::int32_t> buffer(static_cast<size_t>(image.width));
+            for (size_t s = first; s < last && static_cast<int>(out.size()) < cap; s++) {
+                // 更靠前的行带已凑满命中数，本行带的结果不会被用到
+                if (stopBefore && stopBefore->load(std::memory_order_relaxed) < band) {
+                    return;
+                }
+                const Segment& segment = segments[s];
+                int count = segment.x1 - segment.x0;
+                int remaining = cap - static_cast<int>(out.size());
+                int found = kernel(image.PixelAt(segment.x0, segment.y), count, criteria, buffer.data(),
+                                   std::min(remaining, count));
+                for (int k = 0; k < found; k++) {
+                    out.emplace_back(segment.x0 + buffer[k], segment.y);
+                }
+            }
+        };
+
+        long long pixelCount = 0;
+        for (const auto& segment : segments) {
+            pixelCount += segment.x1 - segment.x0;
+        }
+
+        ThreadPool& pool = ThreadPool::GetDefault();
+        if (!multithreaded || pool.GetThreadCount() == 0 || pixelCount < kParallelPixelThreshold ||
+            segments.size() < 2) {
+            std::vector<Point> hits;
+            scanRange(0, segments.size(), hits, nullptr, 0);
+            return hits;
+        }
+
+        // 按行带分给线程池，行带内保持顺序，合并时按行带顺序拼接
+        int bandCount = std::min(static_cast<int>(segments.size()), static_cast<int>(pool.GetThreadCount() + 1) * 4);
+        std::vector<std::vector<Point>> bandHits(bandCount);
+        std::atomic<int> firstFullBand{INT_MAX};
+        pool.ParallelFor(0, bandCount, [&](int begin, int end) {
+            for (int band = begin; band < end; band++) {
+                size_t first = segments.size() * band / bandCount;
+                size_t last = segments.size() * (band + 1) / bandCount;
+                scanRange(first, last, bandHits[band], &firstFullBand, band);
+                if (static_cast<int>(bandHits[band].size()) >= cap) {
+                    int current = firstFullBand.load();
+                    while (band < current && !firstFullBand.compare_exchange_weak(current, band)) {
+                    }
+                }
+            }
+        });
+
+        std::vector<Point> hits;
+        for (int band = 0; band < bandCount && static_cast<int>(hits.size()) < cap; band++) {
+            for (const auto& point : bandHits[band]) {
+                if (static_cast<int>(hits.size()) >= cap) {
+                    break;
+                }
+                hits.push_back(point);
+            }
+        }
+        return hits;
+    }
+
+    // 行优先顺序：起点所在行的剩余部分、其后各行、回绕到开头各行、起点左侧
+    std::vector<Point> SearchRaster(const ImageView& image, const Criteria& criteria, const SearchOptions& options) {
+        std::vector<Segment> segments;
+        segments.reserve(static_cast<size_t>(image.height) + 1);
+        segments.push_back({options.start.y, options.start.x, image.width});
+        for (int y = options.start.y + 1; y < image.height; y++) {
+            segments.push_back({y, 0, image.width});
+        }
+        for (int y = 0; y < options.start.y; y++) {
+            segments.push_back({y, 0, image.width});
+        }
+        if (options.start.x > 0) {
+            segments.push_back({options.start.y, 0, options.start.x});
+        }
+        return ScanSegments(image, segments, criteria, options.maxResults, options.multithreaded);
+    }
+
+    // 螺旋顺序：以起点为中心的正方形逐次扩大半径，只扫描新增的环形区域，
+    // 环内命中按（圈号、行、列）排序后追加，凑满命中数即停止
+    std::vector<Point> SearchSpiral(const ImageView& image, const Criteria& criteria, const SearchOptions& options) {
+        const int sx = options.start.x;
+        const int sy = options.start.y;
+        const int farthest = std::max(std::max(sx, image.width - 1 - sx), std::max(sy, image.height - 1 - sy));
+
+        std::vector<Point> results;
+        std::vector<Segment> segments;
+        int inner = -1;  // 已扫描正方形的半径
+        int outer = std::min(kFirstSpiralRadius, farthest);
+        for (;;) {
+            segments.clear();
+            int left = std::max(0, sx - outer);
+            int right = std::min(image.width, sx + outer + 1);
+            for (int y = std::max(0, sy - outer); y < std::min(image.height, sy + outer + 1); y++) {
+                if (std::abs(y - sy) > inner) {
+                    segments.push_back({y, left, right});
+                    continue;
+                }
+                int innerLeft = std::max(0, sx - inner);
+                int innerRight = std::min(image.width, sx + inner + 1);
+                if (left < innerLeft) {
+                    segments.push_back({y, left, innerLeft});
+                }
+                if (innerRight < right) {
+                    segments.push_back({y, innerRight, right});
+                }
+            }
+
+            std::vector<Point> ring = ScanSegments(image, segments, criteria, 0, options.multithreaded);
+            std::sort(ring.begin(), ring.end(), [sx, sy](const Point& a, const Point& b) {
+                int da = std::max(std::abs(a.x - sx), std::abs(a.y - sy));
+                int db = std::max(std::abs(b.x - sx), std::abs(b.y - sy));
+                if (da != db) {
+                    return da < db;
+                }
+                return a.y != b.y ? a.y < b.y : a.x < b.x;
+            });
+            for (const auto& point : ring) {
+                if (options.maxResults > 0 && static_cast<int>(results.size()) >= options.maxResults) {
+                    break;
+                }
+                results.push_back(point);
+            }
+
+            bool full = options.maxResults > 0 && static_cast<int>(results.size()) >= options.maxResults;
+            if (full || outer >= farthest) {
+                return results;
+            }
+            inner = outer;
+            outer = std::min(outer * 2 + 1, farthest);
+        }
+    }
+
+    Result<std::vector<Point>> Search(const ImageView& image, const Criteria& criteria, const SearchOptions& options) {
+        if (image.IsEmpty() || image.format != PixelFormat::BGRA32) {
+            return Result<std::vector<Point>>::Error(ErrorCode::INVALID_PARAMETER, L"Image must be non-empty BGRA32");
+        }
+        if (options.start.x < 0 || options.start.y < 0 ||
+            options.start.x >= image.width || options.start.y >= image.height) {
+            return Result<std::vector<Point>>::Error(ErrorCode::INVALID_PARAMETER, L"Start point is outside the image");
+        }
+        if (options.maxResults < 0) {
+            return Result<std::vector<Point>>::Error(ErrorCode::INVALID_PARAMETER, L"maxResults must not be negative");
+        }
+
+        std::vector<Point> hits = options.order == SearchOrder::SPIRAL
+            ? SearchSpiral(image, criteria, options)
+            : SearchRaster(image, criteria, options);
+        return Result<std::vector<Point>>::Success(std::move(hits));
+    }
+
+    Criteria MakeCriteria(const ColorRange& range) {
+        Criteria criteria;
+        criteria.low = PackChannels(range.low);
+        criteria.high = PackChannels(range.high);
+        return criteria;
+    }
+
+    Criteria MakeCriteria(const HsvRange& range) {
+        Criteria criteria;
+        criteria.hsv = true;
+        criteria.hsvRange = range;
+        criteria.checkHue = !(range.hueMin <= 0 && range.hueMax >= 359);
+        return criteria;
+    }
+
+    // 逐行扫描整幅图，命中下标写成 MONO1 位（高位在前）
+    Result<ImageData> BuildMask(const ImageView& image, const Criteria& criteria, bool multithreaded) {
+        if (image.IsEmpty() || image.format != PixelFormat::BGRA32) {
+            return Result<ImageData>::Error(ErrorCode::INVALID_PARAMETER, L"Image must be non-empty BGRA32");
+        }
+        ImageData mask(image.width, image.height, PixelFormat::MONO1);
+        RowKernel kernel = SelectKernel();
+        auto scanRows = [&](int begin, int end) {
+            std::vector<std::int32_t> buffer(static_cast<size_t>(image.width));
+            for (int y = begin; y < end; y++) {
+                std::uint8_t* row = &mask.data[static_cast<size_t>(y) * mask.stride];
+                int found = kernel(image.Row(y), image.width, criteria, buffer.data(), image.width);
+                for (int k = 0; k < found; k++) {
+                    row[buffer[k] >> 3] |= static_cast<std::uint8_t>(0x80 >> (buffer[k] & 7));
+                }
+            }
+        };
+
+        ThreadPool& pool = ThreadPool::GetDefault();
+        long long pixelCount = static_cast<long long>(image.width) * image.height;
+        if (!multithreaded || pool.GetThreadCount() == 0 || pixelCount < kParallelPixelThreshold) {
+            scanRows(0, image.height);
+        } else {
+            pool.ParallelFor(0, image.height, scanRows, 16);
+        }
+        return Result<ImageData>::Success(std::move(mask));
+    }
+
+    SearchOptions FirstHitOnly(SearchOptions options) {
+        options.maxResults = 1;
+        return options;
+    }
+
+    Result<std::vector<Point>> ValidateHsv(const HsvRange& range) {
+        if (range.hueMin < 0 || range.hueMin > 359 || range.hueMax < 0 || range.hueMax > 359) {
+            return Result<std::vector<Point>>::Error(ErrorCode::INVALID_PARAMETER, L"Hue must be in 0-359");
+        }
+        return Result<std::vector<Point>>::Success(std::vector<Point>());
+    }
+}
+
+// ============ BGR 范围 ============
+
+Result<std::vector<Point>> FindColor(const ImageView& image, const ColorRange& range, const SearchOptions& options) {
+    return Search(image, MakeCriteria(range), FirstHitOnly(options));
+}
+
+Result<std::vector<Point>> FindAllColors(const ImageView& image, const ColorRange& range, const SearchOptions& options) {
+    return Search(image, MakeCriteria(range), options);
+}
+
+// ============ HSV 范围 ============
+
+Result<std::vector<Point>> FindColor(const ImageView& image, const HsvRange& range, const SearchOptions& options) {
+    auto valid = ValidateHsv(range);
+    if (valid.IsError()) {
+        return valid;
+    }
+    return Search(image, MakeCriteria(range), FirstHitOnly(options));
+}
+
+Result<std::vector<Point>> FindAllColors(const ImageView& image, const HsvRange& range, const SearchOptions& options) {
+    auto valid = ValidateHsv(range);
+    if (valid.IsError()) {
+        return valid;
+    }
+    return Search(image, MakeCriteria(range), options);
+}
+
+// ============ 掩码 ============
+
+Result<ImageData> CreateMask(const ImageView& image, const ColorRange& range, bool multithreaded) {
+    return BuildMask(image, MakeCriteria(range), multithreaded);
+}
+
+Result<ImageData> CreateMask(const ImageView& image, const HsvRange& range, bool multithreaded) {
+    auto valid = ValidateHsv(range);
+    if (valid.IsError()) {
+        return Result<ImageData>::Error(valid.GetErrorCode(), valid.GetErrorMessage());
+    }
+    return BuildMask(image, MakeCriteria(range), multithreaded);
+}
+
+}  // namespace ColorSearch
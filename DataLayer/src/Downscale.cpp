@@ -0,0 +1,508 @@
+#include "../include/Downscale.h"
+#include "CpuFeatures.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#ifdef WINDOWSAPI_X86
+#include <immintrin.h>
+#endif
+
+namespace Downscale {
+
+// 内部辅助函数
+namespace {
+    // 源像素数超过该值时才按行带并行
+    const long long kParallelPixelThreshold = 256 * 256;
+    // 每个行带的最少输出行数
+    const int kMinBandRows = 4;
+    // 面积平均的定点权重：每个方向的权重之和为 kWeightOne
+    // 纵向结果最大为 255 * 256，恰好放进16位；横向乘加前右移一位，使其能按有符号16位参与 madd
+    const int kWeightBits = 8;
+    const int kWeightOne = 1 << kWeightBits;
+    // 两个方向权重相乘（减去横向前的一位右移）后的舍入移位
+    const int kAreaShift = kWeightBits * 2 - 1;
+    // 单通道横向内核一次读取8个抽头，行缓冲与权重表末尾各多留出的元素数
+    const int kTapPadding = 8;
+
+    // 面积平均的一维抽头：输出坐标 i 覆盖源区间 [i * ratio, (i + 1) * ratio)
+    struct AxisTaps {
+        int count = 0;                       // 每个输出坐标的抽头数（不足的补零权重）
+        std::vector<int> start;              // 首个抽头的源坐标，保证 start + count 不超过源长度
+        std::vector<std::int16_t> weights;   // count 个一组，每组之和为 kWeightOne（末尾多补 kTapPadding 个零）
+    };
+
+    AxisTaps BuildAreaTaps(int sourceLength, int targetLength) {
+        AxisTaps taps;
+        taps.count = std::min(sourceLength, (sourceLength + targetLength - 1) / targetLength + 1);
+        taps.start.resize(targetLength);
+        taps.weights.assign(static_cast<size_t>(targetLength) * taps.count + kTapPadding, 0);
+
+        // 以 1/targetLength 为单位：输出区间 [i * S, (i + 1) * S)，源像素 j 覆盖 [j * T, (j + 1) * T)
+        const long long s = sourceLength;
+        const long long t = targetLength;
+        for (int i = 0; i < targetLength; i++) {
+            long long begin = i * s;
+            long long end = begin + s;
+            int first = static_cast<int>(begin / t);
+            int last = static_cast<int>(std::min<long long>(sourceLength, (end + t - 1) / t));
+            int start = std::min(first, sourceLength - taps.count);
+            taps.start[i] = start;
+
+            // 按累计覆盖量取整，保证每组权重之和恰好为 kWeightOne
+            std::int16_t* weights = &taps.weights[static_cast<size_t>(i) * taps.count];
+            long long covered = 0;
+            int assigned = 0;
+            for (int j = first; j < last; j++) {
+                covered += std::min(end, (j + 1) * t) - std::max(begin, j * t);
+                int cumulative = static_cast<int>((covered * kWeightOne + s / 2) / s);
+                weights[j - start] = static_cast<std::int16_t>(cumulative - assigned);
+                assigned = cumulative;
+            }
+        }
+        return taps;
+    }
+
+    // ---------- 纵向：acc[i] = Σ weights[t] * row(t)[i] ----------
+
+    using VerticalKernel = void (*)(const std::uint8_t* first, std::ptrdiff_t stride, const std::int16_t* weights,
+                                    int taps, int count, std::uint16_t* acc);
+
+    // 逐列处理剩余元素
+    void VerticalTail(const std::uint8_t* first, std::ptrdiff_t stride, const std::int16_t* weights,
+                      int taps, int begin, int count, std::uint16_t* acc) {
+        for (int i = begin; i < count; i++) {
+            unsigned sum = 0;
+            for (int t = 0; t < taps; t++) {
+                sum += static_cast<unsigned>(weights[t]) * first[t * stride + i];
+            }
+            acc[i] = static_cast<std::uint16_t>(sum);
+        }
+    }
+
+    void VerticalScalar(const std::uint8_t* first, std::ptrdiff_t stride, const std::int16_t* weights,
+                        int taps, int count, std::uint16_t* acc) {
+        std::fill(acc, acc + count, static_cast<std::uint16_t>(0));
+        for (int t = 0; t < taps; t++) {
+            const std::uint8_t* row = first + t * stride;
+            unsigned weight = static_cast<unsigned>(weights[t]);
+            for (int i = 0; i < count; i++) {
+                acc[i] = static_cast<std::uint16_t>(acc[i] + weight * row[i]);
+            }
+        }
+    }
+
+    // ---------- 横向：盒式滤波，每 Factor 个相邻像素的同一通道求和 ----------
+
+    using BoxHorizontalKernel = void (*)(const std::uint16_t* acc, int outWidth, std::uint8_t* dst);
+
+    // Factor x Factor 个样本的四舍五入平均（Factor 为 2 或 4）
+    template <int Factor, int Channels>
+    void BoxHorizontalScalar(const std::uint16_t* acc, int begin, int outWidth, std::uint8_t* dst) {
+        const int shift = Factor == 2 ? 2 : 4;
+        for (int x = begin; x < outWidth; x++) {
+            const std::uint16_t* block = acc + x * Factor * Channels;
+            for (int c = 0; c < Channels; c++) {
+                unsigned sum = 0;
+                for (int i = 0; i < Factor; i++) {
+                    sum += block[i * Channels + c];
+                }
+                dst[x * Channels + c] = static_cast<std::uint8_t>((sum + (1u << (shift - 1))) >> shift);
+            }
+        }
+    }
+
+    template <int Factor, int Channels>
+    void BoxHorizontalScalarAll(const std::uint16_t* acc, int outWidth, std::uint8_t* dst) {
+        BoxHorizontalScalar<Factor, Channels>(acc, 0, outWidth, dst);
+    }
+
+    // ---------- 横向：面积平均 ----------
+
+    using AreaHorizontalKernel = void (*)(const std::uint16_t* acc, const AxisTaps& taps, std::uint8_t* dst);
+
+    template <int Channels>
+    void AreaHorizontalScalar(const std::uint16_t* acc, const AxisTaps& taps, std::uint8_t* dst) {
+        int outWidth = static_cast<int>(taps.start.size());
+        for (int x = 0; x < outWidth; x++) {
+            const std::uint16_t* base = acc + taps.start[x] * Channels;
+            const std::int16_t* weights = &taps.weights[static_cast<size_t>(x) * taps.count];
+            for (int c = 0; c < Channels; c++) {
+                std::uint32_t sum = 0;
+                for (int t = 0; t < taps.count; t++) {
+                    sum += static_cast<std::uint32_t>(weights[t]) * (base[t * Channels + c] >> 1);
+                }
+                dst[x * Channels + c] = static_cast<std::uint8_t>((sum + (1u << (kAreaShift - 1))) >> kAreaShift);
+            }
+        }
+    }
+
+#ifdef WINDOWSAPI_X86
+    // ---------- SSE2 ----------
+
+    WINDOWSAPI_TARGET("sse2")
+    void VerticalSSE2(const std::uint8_t* first, std::ptrdiff_t stride, const std::int16_t* weights,
+                      int taps, int count, std::uint16_t* acc) {
+        const __m128i zero = _mm_setzero_si128();
+        int i = 0;
+        for (; i + 16 <= count; i += 16) {
+            __m128i lo = zero;
+            __m128i hi = zero;
+            for (int t = 0; t < taps; t++) {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + t * stride + i));
+                __m128i w = _mm_set1_epi16(weights[t]);
+                lo = _mm_add_epi16(lo, _mm_mullo_epi16(_mm_unpacklo_epi8(v, zero), w));
+                hi = _mm_add_epi16(hi, _mm_mullo_epi16(_mm_unpackhi_epi8(v, zero), w));
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(acc + i), lo);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(acc + i + 8), hi);
+        }
+        VerticalTail(first, stride, weights, taps, i, count, acc);
+    }
+
+    WINDOWSAPI_TARGET("sse2")
+    void BoxHorizontal2x1SSE2(const std::uint16_t* acc, int outWidth, std::uint8_t* dst) {
+        const __m128i ones = _mm_set1_epi16(1);
+        const __m128i round = _mm_set1_epi16(2);
+        int x = 0;
+        for (; x + 8 <= outWidth; x += 8) {
+            const __m128i* in = reinterpret_cast<const __m128i*>(acc + x * 2);
+            // 相邻两列求和（值不超过 510，按有符号数相加不会溢出）
+            __m128i a = _mm_madd_epi16(_mm_loadu_si128(in), ones);
+            __m128i b = _mm_madd_epi16(_mm_loadu_si128(in + 1), ones);
+            __m128i sum = _mm_srli_epi16(_mm_add_epi16(_mm_packs_epi32(a, b), round), 2);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + x), _mm_packus_epi16(sum, sum));
+        }
+        BoxHorizontalScalar<2, 1>(acc, x, outWidth, dst);
+    }
+
+    WINDOWSAPI_TARGET("sse2")
+    void BoxHorizontal4x1SSE2(const std::uint16_t* acc, int outWidth, std::uint8_t* dst) {
+        const __m128i ones = _mm_set1_epi16(1);
+        const __m128i round = _mm_set1_epi16(8);
+        int x = 0;
+        for (; x + 8 <= outWidth; x += 8) {
+            const __m128i* in = reinterpret_cast<const __m128i*>(acc + x * 4);
+            __m128i a = _mm_madd_epi16(_mm_loadu_si128(in), ones);
+            __m128i b = _mm_madd_epi16(_mm_loadu_si128(in + 1), ones);
+            __m128i c = _mm_madd_epi16(_mm_loadu_si128(in + 2), ones);
+            __m128i d = _mm_madd_epi16(_mm_loadu_si128(in + 3), ones);
+            // 两两之和再相加，得到每4列之和
+            __m128i ab = _mm_madd_epi16(_mm_packs_epi32(a, b), ones);
+            __m128i cd = _mm_madd_epi16(_mm_packs_epi32(c, d), ones);
+            __m128i sum = _mm_srli_epi16(_mm_add_epi16(_mm_packs_epi32(ab, cd), round), 4);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + x), _mm_packus_epi16(sum, sum));
+        }
+        BoxHorizontalScalar<4, 1>(acc, x, outWidth, dst);
+    }
+
+    // 两个寄存器各含两个像素（4通道 x 16位），返回 [p0 + p1, p2 + p3]
+    WINDOWSAPI_TARGET("sse2")
+    inline __m128i AddPixelPairs(__m128i a, __m128i b) {
+        return _mm_add_epi16(_mm_unpacklo_epi64(a, b), _mm_unpackhi_epi64(a, b));
+    }
+
+    WINDOWSAPI_TARGET("sse2")
+    void BoxHorizontal2x4SSE2(const std::uint16_t* acc, int outWidth, std::uint8_t* dst) {
+        const __m128i round = _mm_set1_epi16(2);
+        int x = 0;
+        for (; x + 4 <= outWidth; x += 4) {
+            const __m128i* in = reinterpret_cast<const __m128i*>(acc + x * 8);
+            __m128i s0 = AddPixelPairs(_mm_loadu_si128(in), _mm_loadu_si128(in + 1));
+            __m128i s1 = AddPixelPairs(_mm_loadu_si128(in + 2), _mm_loadu_si128(in + 3));
+            s0 = _mm_srli_epi16(_mm_add_epi16(s0, round), 2);
+            s1 = _mm_srli_epi16(_mm_add_epi16(s1, round), 2);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 4), _mm_packus_epi16(s0, s1));
+        }
+        BoxHorizontalScalar<2, 4>(acc, x, outWidth, dst);
+    }
+
+    WINDOWSAPI_TARGET("sse2")
+    void BoxHorizontal4x4SSE2(const std::uint16_t* acc, int outWidth, std::uint8_t* dst) {
+        const __m128i round = _mm_set1_epi16(8);
+        int x = 0;
+        for (; x + 4 <= outWidth; x += 4) {
+            const __m128i* in = reinterpret_cast<const __m128i*>(acc + x * 16);
+            __m128i s0 = AddPixelPairs(AddPixelPairs(_mm_loadu_si128(in), _mm_loadu_si128(in + 1)),
+                                       AddPixelPairs(_mm_loadu_si128(in + 2), _mm_loadu_si128(in + 3)));
+            __m128i s1 = AddPixelPairs(AddPixelPairs(_mm_loadu_si128(in + 4), _mm_loadu_si128(in + 5)),
+                                       AddPixelPairs(_mm_loadu_si128(in + 6), _mm_loadu_si128(in + 7)));
+            s0 = _mm_srli_epi16(_mm_add_epi16(s0, round), 4);
+            s1 = _mm_srli_epi16(_mm_add_epi16(s1, round), 4);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 4), _mm_packus_epi16(s0, s1));
+        }
+        BoxHorizontalScalar<4, 4>(acc, x, outWidth, dst);
+    }
+
+    // 单通道面积平均：抽头不超过8个时一次读入全部抽头，多读的部分权重被屏蔽为0
+    WINDOWSAPI_TARGET("sse2")
+    void AreaHorizontal1SSE2(const std::uint16_t* acc, const AxisTaps& taps, std::uint8_t* dst) {
+        if (taps.count > 8) {
+            AreaHorizontalScalar<1>(acc, taps, dst);
+            return;
+        }
+        const __m128i laneMask = _mm_cmplt_epi16(_mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7), _mm_set1_epi16(
+            static_cast<short>(taps.count)));
+        const int round = 1 << (kAreaShift - 1);
+        int outWidth = static_cast<int>(taps.start.size());
+        for (int x = 0; x < outWidth; x++) {
+            __m128i v = _mm_srli_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(acc + taps.start[x])), 1);
+            __m128i w = _mm_and_si128(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(&taps.weights[static_cast<size_t>(x) * taps.count])),
+                laneMask);
+            __m128i sum = _mm_madd_epi16(v, w);
+            sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4E));
+            sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xB1));
+            dst[x] = static_cast<std::uint8_t>((_mm_cvtsi128_si32(sum) + round) >> kAreaShift);
+        }
+    }
+
+    // 4通道面积平均：两个抽头交错后用 madd 一次完成乘加
+    WINDOWSAPI_TARGET("sse2")
+    void AreaHorizontal4SSE2(const std::uint16_t* acc, const AxisTaps& taps, std::uint8_t* dst) {
+        const __m128i round = _mm_set1_epi32(1 << (kAreaShift - 1));
+        int outWidth = static_cast<int>(taps.start.size());
+        for (int x = 0; x < outWidth; x++) {
+            const std::uint16_t* base = acc + taps.start[x] * 4;
+            const std::int16_t* weights = &taps.weights[static_cast<size_t>(x) * taps.count];
+            __m128i sum = _mm_setzero_si128();
+            for (int t = 0; t < taps.count; t += 2) {
+                // 奇数个抽头时最后一对的第二个抽头复用同一像素，权重为0
+                bool pair = t + 1 < taps.count;
+                __m128i a = _mm_srli_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(base + t * 4)), 1);
+                __m128i b = _mm_srli_epi16(
+                    _mm_loadl_epi64(reinterpret_cast<const __m128i*>(base + (pair ? t + 1 : t) * 4)), 1);
+                int w0 = static_cast<std::uint16_t>(weights[t]);
+                int w1 = pair ? weights[t + 1] : 0;
+                sum = _mm_add_epi32(sum, _mm_madd_epi16(_mm_unpacklo_epi16(a, b), _mm_set1_epi32(w0 | (w1 << 16))));
+            }
+            sum = _mm_srli_epi32(_mm_add_epi32(sum, round), kAreaShift);
+            __m128i packed = _mm_packs_epi32(sum, sum);
+            int pixel = _mm_cvtsi128_si32(_mm_packus_epi16(packed, packed));
+            std::memcpy(dst + x * 4, &pixel, sizeof(pixel));
+        }
+    }
+
+    // ---------- AVX2 ----------
+
+    WINDOWSAPI_TARGET("avx2")
+    void VerticalAVX2(const std::uint8_t* first, std::ptrdiff_t stride, const std::int16_t* weights,
+                      int taps, int count, std::uint16_t* acc) {
+        int i = 0;
+        for (; i + 32 <= count; i += 32) {
+            __m256i lo = _mm256_setzero_si256();
+            __m256i hi = _mm256_setzero_si256();
+            for (int t = 0; t < taps; t++) {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + t * stride + i));
+                __m256i w = _mm256_set1_epi16(weights[t]);
+                lo = _mm256_add_epi16(lo, _mm256_mullo_epi16(_mm256_cvtepu8_epi16(_mm256_castsi256_si128(v)), w));
+                hi = _mm256_add_epi16(hi, _mm256_mullo_epi16(_mm256_cvtepu8_epi16(_mm256_extracti128_si256(v, 1)), w));
+            }
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + i), lo);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + i + 16), hi);
+        }
+        VerticalTail(first, stride, weights, taps, i, count, acc);
+    }
+#endif
+
+    // 纵向内核按 CPU 能力选择；横向内核在行缓冲上运行（位于一级缓存），SSE2 即可
+    VerticalKernel SelectVerticalKernel() {
+#ifdef WINDOWSAPI_X86
+        switch (CpuFeatures::GetSimdLevel()) {
+            case CpuFeatures::SimdLevel::AVX2: return VerticalAVX2;
+            case CpuFeatures::SimdLevel::SSSE3:
+            case CpuFeatures::SimdLevel::SSE2: return VerticalSSE2;
+            default: break;
+        }
+#endif
+        return VerticalScalar;
+    }
+
+    bool UseSSE2() {
+#ifdef WINDOWSAPI_X86
+        return CpuFeatures::GetSimdLevel() != CpuFeatures::SimdLevel::SCALAR;
+#else
+        return false;
+#endif
+    }
+
+    BoxHorizontalKernel SelectBoxKernel(int factor, int channels) {
+#ifdef WINDOWSAPI_X86
+        if (UseSSE2()) {
+            if (factor == 2) {
+                return channels == 4 ? BoxHorizontal2x4SSE2 : BoxHorizontal2x1SSE2;
+            }
+            return channels == 4 ? BoxHorizontal4x4SSE2 : BoxHorizontal4x1SSE2;
+        }
+#endif
+        if (factor == 2) {
+            return channels == 4 ? BoxHorizontalScalarAll<2, 4> : BoxHorizontalScalarAll<2, 1>;
+        }
+        return channels == 4 ? BoxHorizontalScalarAll<4, 4> : BoxHorizontalScalarAll<4, 1>;
+    }
+
+    AreaHorizontalKernel SelectAreaKernel(int channels) {
+#ifdef WINDOWSAPI_X86
+        if (UseSSE2()) {
+            return channels == 4 ? AreaHorizontal4SSE2 : AreaHorizontal1SSE2;
+        }
+#endif
+        return channels == 4 ? AreaHorizontalScalar<4> : AreaHorizontalScalar<1>;
+    }
+
+    // 按输出行带执行 rowFn(y, acc)，每个线程复用自己的16位行缓冲
+    template <typename RowFn>
+    void ForEachOutputRow(const ImageView& source, int outHeight, bool multithreaded, const RowFn& rowFn) {
+        size_t accLength = static_cast<size_t>(source.width) * source.BytesPerPixel() + kTapPadding;
+        auto band = [&](int begin, int end) {
+            thread_local std::vector<std::uint16_t> acc;
+            if (acc.size() < accLength) {
+                acc.resize(accLength);
+            }
+            for (int y = begin; y < end; y++) {
+                rowFn(y, acc.data());
+            }
+        };
+
+        ThreadPool& pool = ThreadPool::GetDefault();
+        long long pixelCount = static_cast<long long>(source.width) * source.height;
+        if (!multithreaded || pool.GetThreadCount() == 0 || pixelCount < kParallelPixelThreshold ||
+            outHeight < kMinBandRows * 2) {
+            band(0, outHeight);
+            return;
+        }
+        pool.ParallelFor(0, outHeight, band, kMinBandRows);
+    }
+
+    Result<bool> ValidateTarget(const ImageView& source, int width, int height) {
+        if (source.IsEmpty() || !IsSupported(source.format)) {
+            return Result<bool>::Error(ErrorCode::INVALID_PARAMETER, L"Source must be non-empty BGRA32, RGBA32 or GRAY8");
+        }
+        if (width <= 0 || height <= 0 || width > source.width || height > source.height) {
+            return Result<bool>::Error(ErrorCode::INVALID_PARAMETER, L"Target size must be between 1 and the source size");
+        }
+        return Result<bool>::Success(true);
+    }
+
+    Result<bool> ValidateBoxFactor(const ImageView& source, int factor) {
+        if (factor != 2 && factor != 4) {
+            return Result<bool>::Error(ErrorCode::INVALID_PARAMETER, L"Box factor must be 2 or 4");
+        }
+        return ValidateTarget(source, source.width / factor, source.height / factor);
+    }
+
+    Result<bool> ValidateDestination(const ImageView& source, int width,
+                                     const std::uint8_t* destination, int destinationStride) {
+        if (!destination || destinationStride < GetRowBytes(width, source.format)) {
+            return Result<bool>::Error(ErrorCode::INVALID_PARAMETER, L"Destination buffer is too small");
+        }
+        return Result<bool>::Success(true);
+    }
+
+    // 按输出尺寸整理 ImageData，已有内存足够时不重新分配
+    Result<bool> PrepareOutput(const ImageView& source, int width, int height, ImageData& output) {
+        if (!output.data.empty() && source.data >= output.data.data() &&
+            source.data < output.data.data() + output.data.size()) {
+            return Result<bool>::Error(ErrorCode::INVALID_PARAMETER, L"Output must not alias the source");
+        }
+        output.width = width;
+        output.height = height;
+        output.format = source.format;
+        output.bitsPerPixel = source.BitsPerPixel();
+        output.stride = GetAlignedStride(width, source.format);
+        output.data.resize(static_cast<size_t>(output.stride) * height);
+        return Result<bool>::Success(true);
+    }
+}
+
+bool IsSupported(PixelFormat format) {
+    return format == PixelFormat::BGRA32 || format == PixelFormat::RGBA32 || format == PixelFormat::GRAY8;
+}
+
+// ============ 盒式滤波 ============
+
+Result<bool> BoxRows(const ImageView& source, int factor, std::uint8_t* destination, int destinationStride,
+                     const DownscaleOptions& options) {
+    auto valid = ValidateBoxFactor(source, factor);
+    if (valid.IsError()) {
+        return valid;
+    }
+    valid = ValidateDestination(source, source.width / factor, destination, destinationStride);
+    if (valid.IsError()) {
+        return valid;
+    }
+
+    const int outWidth = source.width / factor;
+    const int outHeight = source.height / factor;
+    const int channels = source.BytesPerPixel();
+    const std::int16_t ones[4] = {1, 1, 1, 1};
+    VerticalKernel vertical = SelectVerticalKernel();
+    BoxHorizontalKernel horizontal = SelectBoxKernel(factor, channels);
+
+    // 纵向只累加实际用到的列
+    const int count = outWidth * factor * channels;
+    ForEachOutputRow(source, outHeight, options.multithreaded, [&](int y, std::uint16_t* acc) {
+        vertical(source.Row(y * factor), source.stride, ones, factor, count, acc);
+        horizontal(acc, outWidth, destination + static_cast<std::ptrdiff_t>(y) * destinationStride);
+    });
+    return Result<bool>::Success(true);
+}
+
+Result<bool> Box(const ImageView& source, int factor, ImageData& output, const DownscaleOptions& options) {
+    auto valid = ValidateBoxFactor(source, factor);
+    if (valid.IsError()) {
+        return valid;
+    }
+
+    auto prepared = PrepareOutput(source, source.width / factor, source.height / factor, output);
+    if (prepared.IsError()) {
+        return prepared;
+    }
+    return BoxRows(source, factor, output.data.data(), output.stride, options);
+}
+
+// ============ 面积平均 ============
+
+Result<bool> AreaRows(const ImageView& source, int width, int height,
+                      std::uint8_t* destination, int destinationStride, const DownscaleOptions& options) {
+    auto valid = ValidateTarget(source, width, height);
+    if (valid.IsError()) {
+        return valid;
+    }
+    valid = ValidateDestination(source, width, destination, destinationStride);
+    if (valid.IsError()) {
+        return valid;
+    }
+
+    const AxisTaps columns = BuildAreaTaps(source.width, width);
+    const AxisTaps rows = BuildAreaTaps(source.height, height);
+    const int channels = source.BytesPerPixel();
+    VerticalKernel vertical = SelectVerticalKernel();
+    AreaHorizontalKernel horizontal = SelectAreaKernel(channels);
+
+    const int count = source.width * channels;
+    ForEachOutputRow(source, height, options.multithreaded, [&](int y, std::uint16_t* acc) {
+        vertical(source.Row(rows.start[y]), source.stride, &rows.weights[static_cast<size_t>(y) * rows.count],
+                 rows.count, count, acc);
+        horizontal(acc, columns, destination + static_cast<std::ptrdiff_t>(y) * destinationStride);
+    });
+    return Result<bool>::Success(true);
+}
+
+Result<bool> Area(const ImageView& source, int width, int height, ImageData& output,
+                  const DownscaleOptions& options) {
+    auto valid = ValidateTarget(source, width, height);
+    if (valid.IsError()) {
+        return valid;
+    }
+
+    auto prepared = PrepareOutput(source, width, height, output);
+    if (prepared.IsError()) {
+        return prepared;
+    }
+    return AreaRows(source, width, height, output.data.data(), output.stride, options);
+}
+
+}  // namespace Downscale
@@ -0,0 +1,344 @@
+#include "../include/EdgeMap.h"
+#include "../include/PixelConvert.h"
+#include "CpuFeatures.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+#ifdef WINDOWSAPI_X86
+#include <immintrin.h>
+#endif
+
+namespace EdgeMap {
+
+// 内部辅助函数
+namespace {
+    // 像素数超过该值时才按行带并行
+    const long long kParallelPixelThreshold = 256 * 256;
+    // 每个行带的最少行数
+    const int kMinBandRows = 16;
+
+    // 算子权重：边行（列）权重、中心权重，以及把 |gx| + |gy| 归一化到 0-255 的右移位数
+    struct Weights {
+        int side;
+        int center;
+        int shift;
+    };
+
+    Weights GetWeights(Operator op) {
+        // 理想阶跃边缘 |gx| = (2 * side + center) * 255：Sobel 为 4 倍，Scharr 为 16 倍
+        return op == Operator::SCHARR ? Weights{3, 10, 4} : Weights{1, 2, 2};
+    }
+
+    // 处理一行：above/below 为上下相邻行（边界行传入自身），gx/gy 为可选的 16 位梯度输出
+    using RowKernel = void (*)(const std::uint8_t* above, const std::uint8_t* row, const std::uint8_t* below,
+                               int width, const Weights& weights, std::uint8_t* magnitude,
+                               std::int16_t* gx, std::int16_t* gy);
+
+    inline void GradientPixel(const std::uint8_t* above, const std::uint8_t* row, const std::uint8_t* below,
+                              int width, int x, const Weights& weights, std::uint8_t* magnitude,
+                              std::int16_t* gx, std::int16_t* gy) {
+        const int l = std::max(x - 1, 0);
+        const int r = std::min(x + 1, width - 1);
+        const int dx = weights.side * (above[r] - above[l]) + weights.center * (row[r] - row[l]) +
+                       weights.side * (below[r] - below[l]);
+        const int dy = weights.side * (below[l] - above[l]) + weights.center * (below[x] - above[x]) +
+                       weights.side * (below[r] - above[r]);
+        magnitude[x] = static_cast<std::uint8_t>(std::min(255, (std::abs(dx) + std::abs(dy)) >> weights.shift));
+        if (gx) {
+            gx[x] = static_cast<std::int16_t>(dx);
+            gy[x] = static_cast<std::int16_t>(dy);
+        }
+    }
+
+    void GradientRowScalar(const std::uint8_t* above, const std::uint8_t* row, const std::uint8_t* below,
+                           int width, const Weights& weights, std::uint8_t* magnitude,
+                           std::int16_t* gx, std::int16_t* gy) {
+        for (int x = 0; x < width; x++) {
+            GradientPixel(above, row, below, width, x, weights, magnitude, gx, gy);
+        }
+    }
+
+#ifdef WINDOWSAPI_X86
+    // 8 个像素的 16 位梯度：l/c/r 为上、中、下三行在 x-1、x、x+1 处展开后的值
+    struct Taps128 {
+        __m128i al, ac, ar, rl, rr, bl, bc, br;
+    };
+
+    WINDOWSAPI_TARGET("sse2")
+    inline void Gradient8SSE2(const Taps128& t, __m128i side, __m128i center, __m128i& dx, __m128i& dy) {
+        dx = _mm_add_epi16(_mm_mullo_epi16(side, _mm_add_epi16(_mm_sub_epi16(t.ar, t.al), _mm_sub_epi16(t.br, t.bl))),
+                           _mm_mullo_epi16(center, _mm_sub_epi16(t.rr, t.rl)));
+        dy = _mm_add_epi16(_mm_mullo_epi16(side, _mm_add_epi16(_mm_sub_epi16(t.bl, t.al), _mm_sub_epi16(t.br, t.ar))),
+                           _mm_mullo_epi16(center, _mm_sub_epi16(t.bc, t.ac)));
+    }
+
+    WINDOWSAPI_TARGET("sse2")
+    inline __m128i Abs16SSE2(__m128i v) {
+        return _mm_max_epi16(v, _mm_sub_epi16(_mm_setzero_si128(), v));
+    }
+
+    WINDOWSAPI_TARGET("sse2")
+    void GradientRowSSE2(const std::uint8_t* above, const std::uint8_t* row, const std::uint8_t* below,
+                         int width, const Weights& weights, std::uint8_t* magnitude,
+                         std::int16_t* gx, std::int16_t* gy) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i side = _mm_set1_epi16(static_cast<short>(weights.side));
+        const __m128i center = _mm_set1_epi16(static_cast<short>(weights.center));
+        const __m128i shift = _mm_cvtsi32_si128(weights.shift);
+        auto load = [](const std::uint8_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); };
+
+        GradientPixel(above, row, below, width, 0, weights, magnitude, gx, gy);
+        int x = 1;
+        // 每次 16 个像素，读取 [x-1, x+17)，最后一列留给标量处理
+        for (; x + 17 <= width; x += 16) {
+            const __m128i a[3] = {load(above + x - 1), load(above + x), load(above + x + 1)};
+            const __m128i r[3] = {load(row + x - 1), load(row + x), load(row + x + 1)};
+            const __m128i b[3] = {load(below + x - 1), load(below + x), load(below + x + 1)};
+            __m128i halves[2];
+            for (int h = 0; h < 2; h++) {
+                auto widen = [&](__m128i v) { return h == 0 ? _mm_unpacklo_epi8(v, zero) : _mm_unpackhi_epi8(v, zero); };
+                Taps128 t = {widen(a[0]), widen(a[1]), widen(a[2]), widen(r[0]), widen(r[2]),
+                             widen(b[0]), widen(b[1]), widen(b[2])};
+                __m128i dx, dy;
+                Gradient8SSE2(t, side, center, dx, dy);
+                halves[h] = _mm_srl_epi16(_mm_add_epi16(Abs16SSE2(dx), Abs16SSE2(dy)), shift);
+                if (gx) {
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(gx + x + h * 8), dx);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(gy + x + h * 8), dy);
+                }
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(magnitude + x), _mm_packus_epi16(halves[0], halves[1]));
+        }
+        for (; x < width; x++) {
+            GradientPixel(above, row, below, width, x, weights, magnitude, gx, gy);
+        }
+    }
+
+    // 16 个字节展开为 16 位
+    WINDOWSAPI_TARGET("avx2")
+    inline __m256i Load16AVX2(const std::uint8_t* p) {
+        return _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+    }
+
+    WINDOWSAPI_TARGET("avx2")
+    inline __m256i Abs16AVX2(__m256i v) {
+        return _mm256_max_epi16(v, _mm256_sub_epi16(_mm256_setzero_si256(), v));
+    }
+
+    WINDOWSAPI_TARGET("avx2")
+    void GradientRowAVX2(const std::uint8_t* above, const std::uint8_t* row, const std::uint8_t* below,
+                         int width, const Weights& weights, std::uint8_t* magnitude,
+                         std::int16_t* gx, std::int16_t* gy) {
+        const __m256i side = _mm256_set1_epi16(static_cast<short>(weights.side));
+        const __m256i center = _mm256_set1_epi16(static_cast<short>(weights.center));
+        const __m128i shift = _mm_cvtsi32_si128(weights.shift);
+
+        GradientPixel(above, row, below, width, 0, weights, magnitude, gx, gy);
+        int x = 1;
+        // 每次 16 个像素（16 位 16 路），最后一列留给标量处理
+        for (; x + 17 <= width; x += 16) {
+            const __m256i al = Load16AVX2(above + x - 1), ac = Load16AVX2(above + x), ar = Load16AVX2(above + x + 1);
+            const __m256i rl = Load16AVX2(row + x - 1), rr = Load16AVX2(row + x + 1);
+            const __m256i bl = Load16AVX2(below + x - 1), bc = Load16AVX2(below + x), br = Load16AVX2(below + x + 1);
+            const __m256i dx = _mm256_add_epi16(
+                _mm256_mullo_epi16(side, _mm256_add_epi16(_mm256_sub_epi16(ar, al), _mm256_sub_epi16(br, bl))),
+                _mm256_mullo_epi16(center, _mm256_sub_epi16(rr, rl)));
+            const __m256i dy = _mm256_add_epi16(
+                _mm256_mullo_epi16(side, _mm256_add_epi16(_mm256_sub_epi16(bl, al), _mm256_sub_epi16(br, ar))),
+                _mm256_mullo_epi16(center, _mm256_sub_epi16(bc, ac)));
+            const __m256i sum = _mm256_srl_epi16(_mm256_add_epi16(Abs16AVX2(dx), Abs16AVX2(dy)), shift);
+            // packus 按 128 位通道交错，permute 后低 128 位即为 16 个有序字节
+            const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(sum, sum), 0xD8);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(magnitude + x), _mm256_castsi256_si128(packed));
+            if (gx) {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(gx + x), dx);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(gy + x), dy);
+            }
+        }
+        for (; x < width; x++) {
+            GradientPixel(above, row, below, width, x, weights, magnitude, gx, gy);
+        }
+    }
+#endif
+
+    RowKernel SelectRowKernel() {
+#ifdef WINDOWSAPI_X86
+        switch (CpuFeatures::GetSimdLevel()) {
+            case CpuFeatures::SimdLevel::AVX2: return GradientRowAVX2;
+            case CpuFeatures::SimdLevel::SSSE3:
+            case CpuFeatures::SimdLevel::SSE2: return GradientRowSSE2;
+            default: break;
+        }
+#endif
+        return GradientRowScalar;
+    }
+
+    // atan(t / 64) 以 1/256 圈为单位，t = 0..64 对应 0..45 度
+    const std::array<std::uint8_t, 65>& AtanTable() {
+        static const std::array<std::uint8_t, 65> table = [] {
+            std::array<std::uint8_t, 65> values = {};
+            const double pi = std::acos(-1.0);
+            for (int t = 0; t <= 64; t++) {
+                values[t] = static_cast<std::uint8_t>(std::lround(std::atan(t / 64.0) * 128.0 / pi));
+            }
+            return values;
+        }();
+        return table;
+    }
+
+    // 先在第一象限内按较小分量与较大分量之比查表，再按符号折叠到整圈
+    inline std::uint8_t Orientation(int dx, int dy, const std::array<std::uint8_t, 65>& table) {
+        const int ax = std::abs(dx);
+        const int ay = std::abs(dy);
+        int angle;
+        if (ax >= ay) {
+            angle = table[(ay * 64 + ax / 2) / ax];
+        } else {
+            angle = 64 - table[(ax * 64 + ay / 2) / ay];
+        }
+        if (dx < 0) {
+            angle = 128 - angle;
+        }
+        if (dy < 0) {
+            angle = 256 - angle;
+        }
+        return static_cast<std::uint8_t>(angle & 0xFF);
+    }
+
+    Result<bool> ValidateImage(const ImageView& image) {
+        if (image.IsEmpty()) {
+            return Result<bool>::Error(ErrorCode::INVALID_PARAMETER, L"Empty image");
+        }
+        if (image.format != PixelFormat::GRAY8 && image.format != PixelFormat::BGRA32) {
+            return Result<bool>::Error(ErrorCode::INVALID_PARAMETER, L"Image must be GRAY8 or BGRA32");
+        }
+        return Result<bool>::Success(true);
+    }
+
+    // gray 必须为 GRAY8；orientation 为 nullptr 时只计算幅值
+    void Compute(const ImageView& gray, const EdgeOptions& options, ImageData& magnitude, ImageData* orientation) {
+        const RowKernel kernel = SelectRowKernel();
+        const Weights weights = GetWeights(options.op);
+        const auto& table = AtanTable();
+        const int width = gray.width;
+        const int height = gray.height;
+
+        auto rows = [&](int begin, int end) {
+            std::vector<std::int16_t> gx;
+            std::vector<std::int16_t> gy;
+            if (orientation) {
+                gx.resize(width);
+                gy.resize(width);
+            }
+            for (int y = begin; y < end; y++) {
+                std::uint8_t* out = magnitude.data.data() + static_cast<size_t>(y) * magnitude.stride;
+                kernel(gray.Row(std::max(y - 1, 0)), gray.Row(y), gray.Row(std::min(y + 1, height - 1)), width,
+                       weights, out, orientation ? gx.data() : nullptr, orientation ? gy.data() : nullptr);
+                if (orientation) {
+                    std::uint8_t* angles = orientation->data.data() + static_cast<size_t>(y) * orientation->stride;
+                    for (int x = 0; x < width; x++) {
+                        angles[x] = out[x] ? Orientation(gx[x], gy[x], table) : 0;
+                    }
+                }
+            }
+        };
+
+        ThreadPool& pool = ThreadPool::GetDefault();
+        const long long pixelCount = static_cast<long long>(width) * height;
+        if (options.multithreaded && pool.GetThreadCount() > 0 && pixelCount >= kParallelPixelThreshold) {
+            pool.ParallelFor(0, height, rows, kMinBandRows);
+        } else {
+            rows(0, height);
+        }
+    }
+
+    // BGRA32 输入先转灰度；gray 持有转换结果，返回值指向 image 或 gray
+    Result<ImageView> ToGray(const ImageView& image, ImageData& gray) {
+        if (image.format == PixelFormat::GRAY8) {
+            return Result<ImageView>::Success(image);
+        }
+        auto converted = PixelConvert::Convert(image, PixelFormat::GRAY8);
+        if (converted.IsError()) {
+            return Result<ImageView>::Error(converted.GetErrorCode(), converted.GetErrorMessage());
+        }
+        gray = std::move(converted).TakeData();
+        return Result<ImageView>::Success(ImageView(gray));
+    }
+}
+
+Result<ImageData> ComputeMagnitude(const ImageView& image, const EdgeOptions& options) {
+    auto valid = ValidateImage(image);
+    if (valid.IsError()) {
+        return Result<ImageData>::Error(valid.GetErrorCode(), valid.GetErrorMessage());
+    }
+    ImageData grayStorage;
+    auto gray = ToGray(image, grayStorage);
+    if (gray.IsError()) {
+        return Result<ImageData>::Error(gray.GetErrorCode(), gray.GetErrorMessage());
+    }
+
+    ImageData magnitude(image.width, image.height, PixelFormat::GRAY8);
+    Compute(gray.GetData(), options, magnitude, nullptr);
+    return Result<ImageData>::Success(std::move(magnitude));
+}
+
+Result<GradientMaps> ComputeGradients(const ImageView& image, const EdgeOptions& options) {
+    auto valid = ValidateImage(image);
+    if (valid.IsError()) {
+        return Result<GradientMaps>::Error(valid.GetErrorCode(), valid.GetErrorMessage());
+    }
+    ImageData grayStorage;
+    auto gray = ToGray(image, grayStorage);
+    if (gray.IsError()) {
+        return Result<GradientMaps>::Error(gray.GetErrorCode(), gray.GetErrorMessage());
+    }
+
+    GradientMaps maps;
+    maps.magnitude = ImageData(image.width, image.height, PixelFormat::GRAY8);
+    maps.orientation = ImageData(image.width, image.height, PixelFormat::GRAY8);
+    Compute(gray.GetData(), options, maps.magnitude, &maps.orientation);
+    return Result<GradientMaps>::Success(std::move(maps));
+}
+
+Result<ImageView> TemplateCache::Get(int templateId, const ImageView& templ) {
+    if (templateId < 0) {
+        return Result<ImageView>::Error(ErrorCode::INVALID_PARAMETER, L"Invalid template id");
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_maps.find(templateId);
+    if (it != m_maps.end() && (it->second.width != templ.width || it->second.height != templ.height)) {
+        return Result<ImageView>::Error(ErrorCode::INVALID_PARAMETER, L"Template id is cached with a different size");
+    }
+    if (it == m_maps.end()) {
+        EdgeOptions options;
+        options.op = m_operator;
+        options.multithreaded = false;
+        auto magnitude = ComputeMagnitude(templ, options);
+        if (magnitude.IsError()) {
+            return Result<ImageView>::Error(magnitude.GetErrorCode(), magnitude.GetErrorMessage());
+        }
+        it = m_maps.emplace(templateId, std::move(magnitude).TakeData()).first;
+    }
+    return Result<ImageView>::Success(ImageView(it->second));
+}
+
+size_t TemplateCache::GetSize() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_maps.size();
+}
+
+bool TemplateCache::Remove(int templateId) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_maps.erase(templateId) > 0;
+}
+
+void TemplateCache::Clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_maps.clear();
+}
+
+}  // namespace EdgeMap
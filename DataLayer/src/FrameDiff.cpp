@@ -0,0 +1,236 @@
+#include "../include/FrameDiff.h"
+#include "CpuFeatures.h"
+
+#include <algorithm>
+
+#ifdef WINDOWSAPI_X86
+#include <immintrin.h>
+#endif
+
+namespace FrameDiff {
+
+// 内部辅助函数
+namespace {
+    // 统计一段像素中超出容差的像素数
+    using CountKernel = int (*)(const std::uint8_t* a, const std::uint8_t* b, int pixelCount,
+                                std::uint32_t packedTolerance);
+    
+    // 4/8位掩码中置位的个数
+    inline int PopCount8(unsigned mask) {
+        mask = mask - ((mask >> 1) & 0x55u);
+        mask = (mask & 0x33u) + ((mask >> 2) & 0x33u);
+        return static_cast<int>((mask + (mask >> 4)) & 0x0Fu);
+    }
+    
+    int CountChangedScalar(const std::uint8_t* a, const std::uint8_t* b, int pixelCount,
+                           std::uint32_t packedTolerance) {
+        int changed = 0;
+        for (int i = 0; i < pixelCount; i++) {
+            const std::uint8_t* pa = a + i * 4;
+            const std::uint8_t* pb = b + i * 4;
+            for (int c = 0; c < 4; c++) {
+                int diff = pa[c] > pb[c] ? pa[c] - pb[c] : pb[c] - pa[c];
+                if (diff > static_cast<int>((packedTolerance >> (c * 8)) & 0xFF)) {
+                    changed++;
+                    break;
+                }
+            }
+        }
+        return changed;
+    }
+    
+#ifdef WINDOWSAPI_X86
+    WINDOWSAPI_TARGET("sse2")
+    int CountChangedSSE2(const std::uint8_t* a, const std::uint8_t* b, int pixelCount,
+                         std::uint32_t packedTolerance) {
+        const __m128i tolerance = _mm_set1_epi32(static_cast<int>(packedTolerance));
+        const __m128i zero = _mm_setzero_si128();
+        int unchanged = 0;
+        int i = 0;
+        for (; i + 4 <= pixelCount; i += 4) {
+            __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i * 4));
+            __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i * 4));
+            // |a-b| = (a-b饱和) | (b-a饱和)，再减去容差，非零字节即超出容差
+            __m128i diff = _mm_or_si128(_mm_subs_epu8(va, vb), _mm_subs_epu8(vb, va));
+            __m128i over = _mm_subs_epu8(diff, tolerance);
+            __m128i same = _mm_cmpeq_epi32(over, zero);
+            unchanged += PopCount8(static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(same))));
+        }
+        return (i - unchanged) + CountChangedScalar(a + i * 4, b + i * 4, pixelCount - i, packedTolerance);
+    }
+    
+    WINDOWSAPI_TARGET("avx2")
+    int CountChangedAVX2(const std::uint8_t* a, const std::uint8_t* b, int pixelCount,
+                         std::uint32_t packedTolerance) {
+        const __m256i tolerance = _mm256_set1_epi32(static_cast<int>(packedTolerance));
+        const __m256i zero = _mm256_setzero_si256();
+        int unchanged = 0;
+        int i = 0;
+        for (; i + 8 <= pixelCount; i += 8) {
+            __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i * 4));
+            __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i * 4));
+            __m256i diff = _mm256_or_si256(_mm256_subs_epu8(va, vb), _mm256_subs_epu8(vb, va));
+            __m256i over = _mm256_subs_epu8(diff, tolerance);
+            __m256i same = _mm256_cmpeq_epi32(over, zero);
+            unchanged += PopCount8(static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(same))));
+        }
+        return (i - unchanged) + CountChangedSSE2(a + i * 4, b + i * 4, pixelCount - i, packedTolerance);
+    }
+#endif
+    
+    CountKernel SelectKernel() {
+#ifdef WINDOWSAPI_X86
+        switch (CpuFeatures::GetSimdLevel()) {
+            case CpuFeatures::SimdLevel::AVX2: return CountChangedAVX2;
+            case CpuFeatures::SimdLevel::SSSE3:
+            case CpuFeatures::SimdLevel::SSE2: return CountChangedSSE2;
+            default: break;
+        }
+#endif
+        return CountChangedScalar;
+    }
+    
+    std::uint32_t PackTolerance(const DiffOptions& options) {
+        return static_cast<std::uint32_t>(options.channelTolerance[0]) |
+               (static_cast<std::uint32_t>(options.channelTolerance[1]) << 8) |
+               (static_cast<std::uint32_t>(options.channelTolerance[2]) << 16) |
+               (static_cast<std::uint32_t>(options.channelTolerance[3]) << 24);
+    }
+    
+    Result<bool> ValidateFrames(const ImageView& previous, const ImageView& current) {
+        if (previous.IsEmpty() || current.IsEmpty()) {
+            return Result<bool>::Error(ErrorCode::INVALID_PARAMETER, L"Empty frame");
+        }
+        if (previous.format != PixelFormat::BGRA32 || current.format != PixelFormat::BGRA32) {
+            return Result<bool>::Error(ErrorCode::INVALID_PARAMETER, L"Frames must be BGRA32");
+        }
+        if (previous.width != current.width || previous.height != current.height) {
+            return Result<bool>::Error(ErrorCode::INVALID_PARAMETER, L"Frame sizes do not match");
+        }
+        return Result<bool>::Success(true);
+    }
+    
+    // 将脏瓦片网格合并为矩形：先合并每行中连续的瓦片，再向下延伸横跨相同列的矩形
+    std::vector<WindowsAPI::Rectangle> MergeDirtyTiles(const std::vector<std::uint8_t>& dirty, int tilesX, int tilesY,
+                                                       int tileSize, int width, int height) {
+        std::vector<WindowsAPI::Rectangle> merged;  // 瓦片坐标
+        std::vector<WindowsAPI::Rectangle> active;
+        std::vector<WindowsAPI::Rectangle> nextActive;
+        
+        for (int ty = 0; ty < tilesY; ty++) {
+            nextActive.clear();
+            size_t cursor = 0;
+            int tx = 0;
+            while (tx < tilesX) {
+                if (!dirty[static_cast<size_t>(ty) * tilesX + tx]) {
+                    tx++;
+                    continue;
+                }
+                int runStart = tx;
+                while (tx < tilesX && dirty[static_cast<size_t>(ty) * tilesX + tx]) {
+                    tx++;
+                }
+                
+                // active 按列有序，跳过已经无法延伸的矩形
+                while (cursor < active.size() && active[cursor].left < runStart) {
+                    merged.push_back(active[cursor++]);
+                }
+                if (cursor < active.size() && active[cursor].left == runStart && active[cursor].right == tx) {
+                    WindowsAPI::Rectangle extended = active[cursor++];
+                    extended.bottom = ty + 1;
+                    nextActive.push_back(extended);
+                } else {
+                    nextActive.push_back(WindowsAPI::Rectangle(runStart, ty, tx, ty + 1));
+                }
+            }
+            while (cursor < active.size()) {
+                merged.push_back(active[cursor++]);
+            }
+            active.swap(nextActive);
+        }
+        merged.insert(merged.end(), active.begin(), active.end());
+        
+        // 换算为像素坐标并裁剪到图像范围
+        for (auto& rect : merged) {
+            rect.left *= tileSize;
+            rect.top *= tileSize;
+            rect.right = std::min(rect.right * tileSize, width);
+            rect.bottom = std::min(rect.bottom * tileSize, height);
+        }
+        return merged;
+    }
+}
+
+Result<DiffResult> Compare(const ImageView& previous, const ImageView& current, const DiffOptions& options) {
+    auto validResult = ValidateFrames(previous, current);
+    if (validResult.IsError()) {
+        return Result<DiffResult>::Error(validResult.GetErrorCode(), validResult.GetErrorMessage());
+    }
+    if (options.tileSize <= 0) {
+        return Result<DiffResult>::Error(ErrorCode::INVALID_PARAMETER, L"Invalid tile size");
+    }
+    
+    const int width = current.width;
+    const int height = current.height;
+    const int tileSize = options.tileSize;
+    const int tilesX = (width + tileSize - 1) / tileSize;
+    const int tilesY = (height + tileSize - 1) / tileSize;
+    const std::uint32_t tolerance = PackTolerance(options);
+    const CountKernel kernel = SelectKernel();
+    
+    DiffResult diff;
+    diff.totalPixels = static_cast<std::uint64_t>(width) * height;
+    
+    std::vector<std::uint8_t> dirty(static_cast<size_t>(tilesX) * tilesY, 0);
+    std::vector<std::uint32_t> tileCounts(tilesX);
+    
+    // 按行流式扫描，逐瓦片行累计变化像素
+    for (int ty = 0; ty < tilesY; ty++) {
+        std::fill(tileCounts.begin(), tileCounts.end(), 0);
+        int rowEnd = std::min((ty + 1) * tileSize, height);
+        for (int y = ty * tileSize; y < rowEnd; y++) {
+            const std::uint8_t* rowA = previous.Row(y);
+            const std::uint8_t* rowB = current.Row(y);
+            for (int tx = 0; tx < tilesX; tx++) {
+                int x0 = tx * tileSize;
+                int count = std::min(tileSize, width - x0);
+                tileCounts[tx] += static_cast<std::uint32_t>(kernel(rowA + x0 * 4, rowB + x0 * 4, count, tolerance));
+            }
+        }
+        
+        for (int tx = 0; tx < tilesX; tx++) {
+            if (tileCounts[tx] != 0) {
+                dirty[static_cast<size_t>(ty) * tilesX + tx] = 1;
+                diff.changedPixels += tileCounts[tx];
+                diff.dirtyTileCount++;
+            }
+        }
+    }
+    
+    diff.changedRatio = static_cast<double>(diff.changedPixels) / static_cast<double>(diff.totalPixels);
+    if (diff.dirtyTileCount > 0) {
+        diff.dirtyRects = MergeDirtyTiles(dirty, tilesX, tilesY, tileSize, width, height);
+    }
+    
+    return Result<DiffResult>::Success(std::move(diff));
+}
+
+Result<bool> HasChanged(const ImageView& previous, const ImageView& current, const DiffOptions& options) {
+    auto validResult = ValidateFrames(previous, current);
+    if (validResult.IsError()) {
+        return validResult;
+    }
+    
+    const std::uint32_t tolerance = PackTolerance(options);
+    const CountKernel kernel = SelectKernel();
+    
+    for (int y = 0; y < current.height; y++) {
+        if (kernel(previous.Row(y), current.Row(y), current.width, tolerance) != 0) {
+            return Result<bool>::Success(true);
+        }
+    }
+    
+    return Result<bool>::Success(false);
+}
+
+}  // namespace FrameDiff
@@ -0,0 +1,367 @@
+#include "../include/GlyphReader.h"
+#include "../include/PixelConvert.h"
+#include "MatchKernels.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace GlyphReader {
+
+// 内部辅助函数
+namespace {
+    // 模板块与字形块的行宽：字形居中放置，两侧至少留 8 列空白
+    const int kStride = 64;
+    // 比较时字形相对模板的最大偏移（像素）
+    const int kJitter = 1;
+    // 字形宽度与模板宽度相差超过该值时不比较
+    const int kWidthTolerance = 2;
+    // 墨迹少于该像素数的列段视为噪点
+    const int kMinInk = 2;
+
+    // 二值化后的文本区域：ink 为 0/0xFF，只在 [lineTop, lineBottom) 行内有墨迹时 hasText 为 true
+    struct Binary {
+        std::vector<std::uint8_t> ink;
+        std::vector<int> columnInk;     // 文本行内每列的墨迹像素数
+        int width = 0;
+        int height = 0;
+        int lineTop = 0;
+        int lineBottom = 0;
+        bool hasText = false;
+
+        int LineHeight() const { return lineBottom - lineTop; }
+    };
+
+    // 按列投影切出的字形段 [begin, end)
+    struct Segment {
+        int begin = 0;
+        int end = 0;
+    };
+
+    // 字形块：文本行的 [begin, end) 列居中放入 kStride 宽的缓冲区，上下各留 pad 行空白
+    struct Cell {
+        std::vector<std::uint8_t> pixels;
+        std::vector<int> rowPrefix;     // rowPrefix[r] 为前 r 行的墨迹像素数
+        int pad = 0;
+        int rows = 0;                   // 文本行高
+        int width = 0;
+        int ink = 0;
+    };
+
+    Result<Binary> Binarize(const ImageView& region, const BinarizeOptions& options) {
+        if (region.IsEmpty()) {
+            return Result<Binary>::Error(ErrorCode::INVALID_PARAMETER, L"Empty image");
+        }
+        if (region.format != PixelFormat::BGRA32 && region.format != PixelFormat::GRAY8) {
+            return Result<Binary>::Error(ErrorCode::INVALID_PARAMETER, L"Unsupported pixel format");
+        }
+        if (options.threshold > 255) {
+            return Result<Binary>::Error(ErrorCode::INVALID_PARAMETER, L"Threshold must be at most 255");
+        }
+
+        Binary binary;
+        binary.width = region.width;
+        binary.height = region.height;
+        binary.ink.resize(static_cast<size_t>(region.width) * region.height);
+        PixelConvert::ConvertRows(region, PixelFormat::GRAY8, binary.ink.data(), region.width);
+
+        auto range = std::minmax_element(binary.ink.begin(), binary.ink.end());
+        const int darkest = *range.first;
+        const int brightest = *range.second;
+        if (brightest - darkest < options.minContrast) {
+            return Result<Binary>::Success(std::move(binary));
+        }
+        const int threshold = options.threshold >= 0 ? options.threshold : (darkest + brightest + 1) / 2;
+
+        bool inkIsBright = options.polarity == Polarity::LIGHT_ON_DARK;
+        if (options.polarity == Polarity::AUTO) {
+            const size_t bright = std::count_if(binary.ink.begin(), binary.ink.end(),
+                                                [&](std::uint8_t v) { return v >= threshold; });
+            inkIsBright = bright * 2 < binary.ink.size();
+        }
+        for (auto& v : binary.ink) {
+            v = (v >= threshold) == inkIsBright ? 0xFF : 0x00;
+        }
+
+        // 文本行：有墨迹的第一行到最后一行
+        binary.lineTop = binary.height;
+        for (int y = 0; y < binary.height; y++) {
+            const std::uint8_t* row = &binary.ink[static_cast<size_t>(y) * binary.width];
+            if (std::find(row, row + binary.width, 0xFF) != row + binary.width) {
+                binary.lineTop = std::min(binary.lineTop, y);
+                binary.lineBottom = y + 1;
+            }
+        }
+        if (binary.lineBottom <= binary.lineTop) {
+            return Result<Binary>::Success(std::move(binary));
+        }
+
+        binary.columnInk.assign(binary.width, 0);
+        for (int y = binary.lineTop; y < binary.lineBottom; y++) {
+            const std::uint8_t* row = &binary.ink[static_cast<size_t>(y) * binary.width];
+            for (int x = 0; x < binary.width; x++) {
+                binary.columnInk[x] += row[x] & 1;
+            }
+        }
+        binary.hasText = true;
+        return Result<Binary>::Success(std::move(binary));
+    }
+
+    // 连续有墨迹的列构成一个字形段，墨迹过少的段丢弃
+    std::vector<Segment> SplitColumns(const Binary& binary) {
+        std::vector<Segment> segments;
+        int x = 0;
+        while (x < binary.width) {
+            if (binary.columnInk[x] == 0) {
+                x++;
+                continue;
+            }
+            Segment segment;
+            segment.begin = x;
+            int ink = 0;
+            while (x < binary.width && binary.columnInk[x] > 0) {
+                ink += binary.columnInk[x++];
+            }
+            segment.end = x;
+            if (ink >= kMinInk) {
+                segments.push_back(segment);
+            }
+        }
+        return segments;
+    }
+
+    void BuildCell(const Binary& binary, int begin, int end, int pad, Cell& cell) {
+        cell.pad = pad;
+        cell.rows = binary.LineHeight();
+        cell.width = end - begin;
+        const int totalRows = cell.rows + pad * 2;
+        cell.pixels.assign(static_cast<size_t>(totalRows) * kStride, 0);
+        cell.rowPrefix.assign(totalRows + 1, 0);
+        const int left = (kStride - cell.width) / 2;
+        for (int r = 0; r < totalRows; r++) {
+            int ink = 0;
+            const int y = binary.lineTop + r - pad;
+            if (r >= pad && r < pad + cell.rows) {
+                const std::uint8_t* source = &binary.ink[static_cast<size_t>(y) * binary.width + begin];
+                std::uint8_t* target = &cell.pixels[static_cast<size_t>(r) * kStride + left];
+                for (int x = 0; x < cell.width; x++) {
+                    target[x] = source[x];
+                    ink += source[x] & 1;
+                }
+            }
+            cell.rowPrefix[r + 1] = cell.rowPrefix[r] + ink;
+        }
+        cell.ink = cell.rowPrefix[totalRows];
+    }
+
+    // [begin, end) 列在文本行内墨迹的外接矩形
+    WindowsAPI::Rectangle InkBounds(const Binary& binary, int begin, int end) {
+        int top = binary.lineBottom;
+        int bottom = binary.lineTop;
+        for (int y = binary.lineTop; y < binary.lineBottom; y++) {
+            const std::uint8_t* row = &binary.ink[static_cast<size_t>(y) * binary.width];
+            if (std::find(row + begin, row + end, 0xFF) != row + end) {
+                top = std::min(top, y);
+                bottom = y + 1;
+            }
+        }
+        return WindowsAPI::Rectangle(begin, top, end, bottom);
+    }
+
+    /**
+     * 字形块与模板的最佳得分：1 - 不同像素数 / (两者墨迹数之和)。
+     * 模板窗口在字形块中按行连续，窗口外的字形墨迹也计为不同；
+     * 两侧空白列宽于 kJitter，窗口跨行处只会碰到空白列。
+     */
+    double ScoreTemplate(const Cell& cell, const std::uint8_t* templ, int templateRows, int templateInk) {
+        const auto& kernels = MatchKernels::GetKernels();
+        const int minOffset = std::min(0, cell.rows - templateRows) - kJitter;
+        const int maxOffset = std::max(0, cell.rows - templateRows) + kJitter;
+        const int length = templateRows * kStride;
+        std::uint32_t bestMismatch = static_cast<std::uint32_t>(cell.ink + templateInk);
+        for (int oy = minOffset; oy <= maxOffset; oy++) {
+            const int firstRow = cell.pad + oy;
+            const std::uint32_t outside = static_cast<std::uint32_t>(
+                cell.ink - (cell.rowPrefix[firstRow + templateRows] - cell.rowPrefix[firstRow]));
+            for (int ox = -kJitter; ox <= kJitter; ox++) {
+                const std::uint8_t* window = &cell.pixels[static_cast<size_t>(firstRow) * kStride + ox];
+                const std::uint32_t mismatch = kernels.sadRow(window, templ, length) / 255 + outside;
+                bestMismatch = std::min(bestMismatch, mismatch);
+            }
+        }
+        return 1.0 - static_cast<double>(bestMismatch) / std::max(1, cell.ink + templateInk);
+    }
+}
+
+Result<int> Font::Learn(const ImageView& sample, const std::wstring& text, const BinarizeOptions& options) {
+    std::wstring characters;
+    for (wchar_t c : text) {
+        if (c != L' ') {
+            characters.push_back(c);
+        }
+    }
+    if (characters.empty()) {
+        return Result<int>::Error(ErrorCode::INVALID_PARAMETER, L"Sample text is empty");
+    }
+    auto binarized = Binarize(sample, options);
+    if (binarized.IsError()) {
+        return Result<int>::Error(binarized.GetErrorCode(), binarized.GetErrorMessage());
+    }
+    const Binary& binary = binarized.GetData();
+    if (!binary.hasText) {
+        return Result<int>::Error(ErrorCode::OPERATION_FAILED, L"Sample contains no text");
+    }
+    const int lineHeight = binary.LineHeight();
+    if (lineHeight > kMaxLineHeight) {
+        return Result<int>::Error(ErrorCode::INVALID_PARAMETER, L"Sample line is taller than kMaxLineHeight");
+    }
+    if (m_lineHeight != 0 && lineHeight != m_lineHeight) {
+        return Result<int>::Error(ErrorCode::INVALID_PARAMETER, L"Sample line height differs from the font");
+    }
+
+    std::vector<Segment> segments = SplitColumns(binary);
+    if (segments.size() != characters.size()) {
+        return Result<int>::Error(ErrorCode::OPERATION_FAILED,
+            L"Found " + std::to_wstring(segments.size()) + L" glyphs, expected " + std::to_wstring(characters.size()));
+    }
+    for (const auto& segment : segments) {
+        if (segment.end - segment.begin > kMaxGlyphWidth) {
+            return Result<int>::Error(ErrorCode::INVALID_PARAMETER, L"Glyph is wider than kMaxGlyphWidth");
+        }
+    }
+
+    // 空格两侧与普通相邻字形的间隔
+    size_t glyph = 0;
+    bool spaceBefore = false;
+    for (wchar_t c : text) {
+        if (c == L' ') {
+            spaceBefore = glyph > 0;
+            continue;
+        }
+        if (glyph > 0) {
+            const int gap = segments[glyph].begin - segments[glyph - 1].end;
+            if (spaceBefore) {
+                m_minSpaceGap = m_minSpaceGap == 0 ? gap : std::min(m_minSpaceGap, gap);
+            } else {
+                m_maxGlyphGap = std::max(m_maxGlyphGap, gap);
+            }
+        }
+        spaceBefore = false;
+        glyph++;
+    }
+    m_spaceGap = m_minSpaceGap > 0 ? (m_maxGlyphGap + m_minSpaceGap + 1) / 2 : 0;
+
+    m_lineHeight = lineHeight;
+    Cell cell;
+    for (size_t i = 0; i < segments.size(); i++) {
+        BuildCell(binary, segments[i].begin, segments[i].end, 0, cell);
+        m_cells.insert(m_cells.end(), cell.pixels.begin(), cell.pixels.end());
+        m_characters.push_back(characters[i]);
+        m_widths.push_back(cell.width);
+        m_inks.push_back(cell.ink);
+        m_maxWidth = std::max(m_maxWidth, cell.width);
+    }
+    return Result<int>::Success(static_cast<int>(segments.size()));
+}
+
+Result<ReadResult> Font::Read(const ImageView& region, const ReadOptions& options) const {
+    if (m_characters.empty()) {
+        return Result<ReadResult>::Error(ErrorCode::OPERATION_FAILED, L"Font has no glyphs");
+    }
+    auto binarized = Binarize(region, options.binarize);
+    if (binarized.IsError()) {
+        return Result<ReadResult>::Error(binarized.GetErrorCode(), binarized.GetErrorMessage());
+    }
+    const Binary& binary = binarized.GetData();
+    ReadResult result;
+    if (!binary.hasText) {
+        return Result<ReadResult>::Success(std::move(result));
+    }
+
+    const size_t cellSize = static_cast<size_t>(m_lineHeight) * kStride;
+    const int pad = m_lineHeight + kJitter + 1;
+    const int spaceGap = options.spaceGap > 0 ? options.spaceGap : m_spaceGap;
+    Cell cell;
+
+    // 字形块与宽度相近（any 为 true 时不限宽度）的模板逐个比较，返回最佳模板下标
+    auto bestTemplate = [&](bool any, double& score) {
+        int best = -1;
+        score = 0.0;
+        for (int t = 0; t < GetGlyphCount(); t++) {
+            if (!any && std::abs(m_widths[t] - cell.width) > kWidthTolerance) {
+                continue;
+            }
+            const double s = ScoreTemplate(cell, &m_cells[t * cellSize], m_lineHeight, m_inks[t]);
+            if (best < 0 || s > score) {
+                best = t;
+                score = s;
+            }
+        }
+        return best;
+    };
+    auto emit = [&](int templ, double score, int begin, int end) {
+        Glyph glyph;
+        glyph.character = score >= options.minScore ? m_characters[templ] : kUnknownGlyph;
+        glyph.bounds = InkBounds(binary, begin, end);
+        glyph.confidence = score;
+        result.text.push_back(glyph.character);
+        result.glyphs.push_back(glyph);
+    };
+
+    int previousEnd = -1;
+    for (const auto& segment : SplitColumns(binary)) {
+        if (previousEnd >= 0 && spaceGap > 0 && segment.begin - previousEnd >= spaceGap) {
+            result.text.push_back(L' ');
+        }
+        previousEnd = segment.end;
+
+        if (segment.end - segment.begin <= std::min(kMaxGlyphWidth, m_maxWidth + kWidthTolerance)) {
+            BuildCell(binary, segment.begin, segment.end, pad, cell);
+            double score = 0.0;
+            int templ = bestTemplate(false, score);
+            if (templ < 0) {
+                templ = bestTemplate(true, score);
+            }
+            emit(templ, score, segment.begin, segment.end);
+            continue;
+        }
+
+        // 笔画相连的宽段：从左端起逐个模板截取同宽的列比较，取得分最高者后前进
+        int x = segment.begin;
+        while (x < segment.end) {
+            if (binary.columnInk[x] == 0) {
+                x++;
+                continue;
+            }
+            int bestIndex = -1;
+            double bestScore = 0.0;
+            for (int t = 0; t < GetGlyphCount(); t++) {
+                const int end = std::min(segment.end, x + m_widths[t]);
+                BuildCell(binary, x, end, pad, cell);
+                const double s = ScoreTemplate(cell, &m_cells[t * cellSize], m_lineHeight, m_inks[t]);
+                // 得分相同时取较宽的模板（窄模板可能恰好与宽字形的一部分相同）
+                if (bestIndex < 0 || s > bestScore || (s == bestScore && m_widths[t] > m_widths[bestIndex])) {
+                    bestIndex = t;
+                    bestScore = s;
+                }
+            }
+            const int end = std::min(segment.end, x + m_widths[bestIndex]);
+            emit(bestIndex, bestScore, x, end);
+            x = end;
+        }
+    }
+
+    result.confidence = 1.0;
+    for (const auto& glyph : result.glyphs) {
+        result.confidence = std::min(result.confidence, glyph.confidence);
+    }
+    if (result.glyphs.empty()) {
+        result.confidence = 0.0;
+    }
+    return Result<ReadResult>::Success(std::move(result));
+}
+
+void Font::Clear() {
+    *this = Font();
+}
+
+}  // namespace GlyphReader
@@ -0,0 +1,256 @@
+#include "../include/InputDispatcher.h"
+
+#include <algorithm>
+
+namespace InputDispatcher {
+
+// ============ 输入事件 ============
+
+InputEvent InputEvent::KeyDown(std::uint32_t virtualKey) {
+    InputEvent event;
+    event.type = EventType::KEY_DOWN;
+    event.code = virtualKey;
+    return event;
+}
+
+InputEvent InputEvent::KeyUp(std::uint32_t virtualKey) {
+    InputEvent event;
+    event.type = EventType::KEY_UP;
+    event.code = virtualKey;
+    return event;
+}
+
+InputEvent InputEvent::Char(wchar_t character) {
+    InputEvent event;
+    event.type = EventType::CHAR;
+    event.code = static_cast<std::uint32_t>(character);
+    return event;
+}
+
+InputEvent InputEvent::MouseMove(int x, int y, std::uint8_t held) {
+    InputEvent event;
+    event.type = EventType::MOUSE_MOVE;
+    event.x = x;
+    event.y = y;
+    event.held = held;
+    return event;
+}
+
+InputEvent InputEvent::MouseMove(int x, int y, MouseButton held) {
+    return MouseMove(x, y, HeldMask(held));
+}
+
+InputEvent InputEvent::ButtonDown(int x, int y, MouseButton button) {
+    InputEvent event;
+    event.type = EventType::BUTTON_DOWN;
+    event.x = x;
+    event.y = y;
+    event.button = button;
+    return event;
+}
+
+InputEvent InputEvent::ButtonUp(int x, int y, MouseButton button) {
+    InputEvent event;
+    event.type = EventType::BUTTON_UP;
+    event.x = x;
+    event.y = y;
+    event.button = button;
+    return event;
+}
+
+InputEvent InputEvent::Wheel(int x, int y, int delta) {
+    InputEvent event;
+    event.type = EventType::WHEEL;
+    event.x = x;
+    event.y = y;
+    event.delta = delta;
+    return event;
+}
+
+bool IsPostable(const InputEvent& event) {
+    if (event.delivery != Delivery::AUTO) {
+        return event.delivery == Delivery::POST;
+    }
+    return event.type == EventType::MOUSE_MOVE || event.type == EventType::WHEEL;
+}
+
+bool IsPostableBatch(const std::vector<InputEvent>& events) {
+    return std::all_of(events.begin(), events.end(), [](const InputEvent& event) { return IsPostable(event); });
+}
+
+Delivery ResolveDelivery(const InputEvent& event, bool postableBatch) {
+    if (event.delivery != Delivery::AUTO) {
+        return event.delivery;
+    }
+    return postableBatch ? Delivery::POST : Delivery::SEND;
+}
+
+Result<int> DeliverBatch(InputSink& sink, WindowHandle window, const std::vector<InputEvent>& events) {
+    auto begin = sink.BeginBatch(window);
+    if (begin.IsError()) {
+        return Result<int>::Error(begin.GetErrorCode(), begin.GetErrorMessage());
+    }
+
+    const bool postable = IsPostableBatch(events);
+    int delivered = 0;
+    for (const InputEvent& event : events) {
+        auto result = sink.Deliver(window, event, ResolveDelivery(event, postable));
+        if (result.IsError()) {
+            return Result<int>::Error(result.GetErrorCode(), result.GetErrorMessage());
+        }
+        delivered++;
+    }
+    return Result<int>::Success(delivered);
+}
+
+// ============ 派发器 ============
+
+Dispatcher::Dispatcher(std::unique_ptr<InputSink> sink)
+    : m_sink(std::move(sink)), m_head(&m_stub), m_tail(&m_stub) {
+    m_pump = std::thread([this]() { PumpLoop(); });
+}
+
+Dispatcher::~Dispatcher() {
+    m_stopping.store(true);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_wake.notify_one();
+    }
+    if (m_pump.joinable()) {
+        m_pump.join();
+    }
+}
+
+void Dispatcher::Push(Batch* batch) {
+    batch->next.store(nullptr, std::memory_order_relaxed);
+    Batch* previous = m_head.exchange(batch, std::memory_order_acq_rel);
+    // 交换与链接之间被打断时，消费者会看到断开的链表并稍后重试
+    previous->next.store(batch, std::memory_order_release);
+}
+
+Dispatcher::Batch* Dispatcher::Pop() {
+    Batch* tail = m_tail;
+    Batch* next = tail->next.load(std::memory_order_acquire);
+    if (tail == &m_stub) {
+        if (!next) {
+            return nullptr;
+        }
+        m_tail = next;
+        tail = next;
+        next = next->next.load(std::memory_order_acquire);
+    }
+    if (next) {
+        m_tail = next;
+        return tail;
+    }
+    if (tail != m_head.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+    // tail 是最后一个节点：放回哨兵后才能把它取走
+    Push(&m_stub);
+    next = tail->next.load(std::memory_order_acquire);
+    if (next) {
+        m_tail = next;
+        return tail;
+    }
+    return nullptr;
+}
+
+std::future<Result<int>> Dispatcher::Submit(WindowHandle window, std::vector<InputEvent> events) {
+    if (m_stopping.load()) {
+        std::promise<Result<int>> rejected;
+        rejected.set_value(Result<int>::Error(ErrorCode::OPERATION_FAILED, L"Dispatcher is shutting down"));
+        return rejected.get_future();
+    }
+
+    Batch* batch = new Batch();
+    batch->window = window;
+    batch->events = std::move(events);
+    std::future<Result<int>> future = batch->completion.get_future();
+
+    // 先计数再入队：派发线程看到计数大于已取出的批次数时不会休眠
+    m_submitted.fetch_add(1);
+    Push(batch);
+    if (m_sleeping.load()) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_wake.notify_one();
+    }
+    return future;
+}
+
+Result<int> Dispatcher::Dispatch(const Batch& batch) {
+    auto begin = m_sink->BeginBatch(batch.window);
+    if (begin.IsError()) {
+        m_failedBatchCount.fetch_add(1, std::memory_order_relaxed);
+        return Result<int>::Error(begin.GetErrorCode(), begin.GetErrorMessage());
+    }
+
+    const bool postable = IsPostableBatch(batch.events);
+    int delivered = 0;
+    for (const InputEvent& event : batch.events) {
+        const Delivery delivery = ResolveDelivery(event, postable);
+        auto result = m_sink->Deliver(batch.window, event, delivery);
+        if (result.IsError()) {
+            m_failedBatchCount.fetch_add(1, std::memory_order_relaxed);
+            return Result<int>::Error(result.GetErrorCode(), result.GetErrorMessage());
+        }
+        (delivery == Delivery::POST ? m_postedCount : m_sentCount).fetch_add(1, std::memory_order_relaxed);
+        delivered++;
+    }
+    return Result<int>::Success(delivered);
+}
+
+void Dispatcher::PumpLoop() {
+    std::uint64_t popped = 0;
+    while (true) {
+        Batch* batch = Pop();
+        if (batch) {
+            Result<int> result = Dispatch(*batch);
+            // 先计入统计再完成 future：调用方拿到结果后读到的统计已包含这一批
+            m_batchCount.fetch_add(1, std::memory_order_relaxed);
+            batch->completion.set_value(std::move(result));
+            delete batch;
+            popped++;
+            m_completed.store(popped);
+            if (m_idleWaiters.load() > 0) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_idle.notify_all();
+            }
+            continue;
+        }
+        if (m_submitted.load() != popped) {
+            // 生产者已计数但尚未链接完成
+            std::this_thread::yield();
+            continue;
+        }
+        if (m_stopping.load()) {
+            break;
+        }
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_sleeping.store(true);
+        m_wake.wait(lock, [&]() { return m_submitted.load() != popped || m_stopping.load(); });
+        m_sleeping.store(false);
+    }
+}
+
+void Dispatcher::WaitIdle() {
+    const std::uint64_t target = m_submitted.load();
+    m_idleWaiters.fetch_add(1);
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_idle.wait(lock, [&]() { return m_completed.load() >= target; });
+    }
+    m_idleWaiters.fetch_sub(1);
+}
+
+Dispatcher::Statistics Dispatcher::GetStatistics() const {
+    Statistics statistics;
+    statistics.batchCount = m_batchCount.load(std::memory_order_relaxed);
+    statistics.postedCount = m_postedCount.load(std::memory_order_relaxed);
+    statistics.sentCount = m_sentCount.load(std::memory_order_relaxed);
+    statistics.failedBatchCount = m_failedBatchCount.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+}  // namespace InputDispatcher
@@ -0,0 +1,470 @@
+#include "../include/InputMacro.h"
+#include "CpuFeatures.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <thread>
+
+#ifdef WINDOWSAPI_X86
+#include <immintrin.h>
+#endif
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace InputMacro {
+
+using InputDispatcher::Delivery;
+using InputDispatcher::EventType;
+
+// 内部辅助函数
+namespace {
+    // 标签字节：低 3 位事件类型，接着 2 位投递方式，高 3 位鼠标按键；
+    // 鼠标移动的高 3 位为 1 时坐标之后跟一个按住按键的 varint，悬停移动不占额外字节
+    const int kMaxEventType = static_cast<int>(EventType::WHEEL);
+    const int kMaxDelivery = static_cast<int>(Delivery::SEND);
+    const int kMaxButton = static_cast<int>(MouseButton::X2);
+    const int kMaxHeld = InputDispatcher::HeldMask(MouseButton::X2) * 2 - 1;
+
+    bool HasCode(EventType type) {
+        return type == EventType::KEY_DOWN || type == EventType::KEY_UP || type == EventType::CHAR;
+    }
+
+    void PutVarint(std::vector<std::uint8_t>& out, std::uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<std::uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<std::uint8_t>(value));
+    }
+
+    // zigzag：小的负数也编码为短 varint
+    void PutSigned(std::vector<std::uint8_t>& out, std::int64_t value) {
+        PutVarint(out, (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63));
+    }
+
+    bool GetVarint(const std::uint8_t*& position, const std::uint8_t* end, std::uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64 && position < end; shift += 7) {
+            const std::uint8_t byte = *position++;
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool GetSigned(const std::uint8_t*& position, const std::uint8_t* end, std::int64_t& value) {
+        std::uint64_t raw = 0;
+        if (!GetVarint(position, end, raw)) {
+            return false;
+        }
+        value = static_cast<std::int64_t>(raw >> 1) ^ -static_cast<std::int64_t>(raw & 1);
+        return true;
+    }
+
+    void PutLittleEndian(std::uint8_t* out, std::uint64_t value, int bytes) {
+        for (int i = 0; i < bytes; i++) {
+            out[i] = static_cast<std::uint8_t>(value >> (8 * i));
+        }
+    }
+
+    std::uint64_t GetLittleEndian(const std::uint8_t* in, int bytes) {
+        std::uint64_t value = 0;
+        for (int i = 0; i < bytes; i++) {
+            value |= static_cast<std::uint64_t>(in[i]) << (8 * i);
+        }
+        return value;
+    }
+
+    // 录制接收端
+    class RecordingSink : public InputSink {
+    public:
+        RecordingSink(std::unique_ptr<InputSink> inner, Recorder& recorder)
+            : m_inner(std::move(inner)), m_recorder(recorder) {}
+
+        Result<bool> BeginBatch(WindowHandle window) override {
+            return m_inner->BeginBatch(window);
+        }
+
+        Result<bool> Deliver(WindowHandle window, const InputEvent& event, Delivery delivery) override {
+            auto result = m_inner->Deliver(window, event, delivery);
+            if (result.IsSuccess()) {
+                m_recorder.Record(event);
+            }
+            return result;
+        }
+
+    private:
+        std::unique_ptr<InputSink> m_inner;
+        Recorder& m_recorder;
+    };
+
+    double Percentile(const std::vector<double>& sorted, double fraction) {
+        if (sorted.empty()) {
+            return 0.0;
+        }
+        const size_t index = static_cast<size_t>(fraction * (sorted.size() - 1) + 0.5);
+        return sorted[std::min(index, sorted.size() - 1)];
+    }
+}
+
+// ============ 录制 ============
+
+void Recorder::Start(Clock::time_point origin) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_origin = origin;
+    m_payload.clear();
+    m_count = 0;
+    m_lastTimeUs = 0;
+    m_lastX = 0;
+    m_lastY = 0;
+}
+
+void Recorder::Record(const InputEvent& event, Clock::time_point when) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(when - m_origin).count();
+    const std::uint64_t timeUs = std::max<std::uint64_t>(m_lastTimeUs, elapsed > 0 ? static_cast<std::uint64_t>(elapsed) : 0);
+
+    const int button = event.type == EventType::MOUSE_MOVE ? (event.held != 0 ? 1 : 0) : static_cast<int>(event.button);
+    m_payload.push_back(static_cast<std::uint8_t>(static_cast<int>(event.type)
+                                                  | (static_cast<int>(event.delivery) << 3)
+                                                  | (button << 5)));
+    PutVarint(m_payload, timeUs - m_lastTimeUs);
+    if (HasCode(event.type)) {
+        PutVarint(m_payload, event.code);
+    } else {
+        PutSigned(m_payload, static_cast<std::int64_t>(event.x) - m_lastX);
+        PutSigned(m_payload, static_cast<std::int64_t>(event.y) - m_lastY);
+        m_lastX = event.x;
+        m_lastY = event.y;
+        if (event.type == EventType::WHEEL) {
+            PutSigned(m_payload, event.delta);
+        } else if (event.type == EventType::MOUSE_MOVE && event.held != 0) {
+            PutVarint(m_payload, event.held);
+        }
+    }
+    m_lastTimeUs = timeUs;
+    m_count++;
+}
+
+size_t Recorder::GetEventCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_count;
+}
+
+std::vector<std::uint8_t> Recorder::Serialize() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<std::uint8_t> bytes(kHeaderSize + m_payload.size());
+    PutLittleEndian(&bytes[0], kMagic, 4);
+    PutLittleEndian(&bytes[4], kVersion, 2);
+    PutLittleEndian(&bytes[6], 0, 2);
+    PutLittleEndian(&bytes[8], m_count, 4);
+    PutLittleEndian(&bytes[12], m_payload.size(), 4);
+    if (!m_payload.empty()) {
+        std::memcpy(&bytes[kHeaderSize], m_payload.data(), m_payload.size());
+    }
+    return bytes;
+}
+
+Result<bool> Recorder::SaveToFile(const std::string& path) const {
+    const std::vector<std::uint8_t> bytes = Serialize();
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        return Result<bool>::Error(ErrorCode::OPERATION_FAILED, L"Cannot open macro file for writing");
+    }
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    if (!file) {
+        return Result<bool>::Error(ErrorCode::OPERATION_FAILED, L"Failed to write macro file");
+    }
+    return Result<bool>::Success(true);
+}
+
+std::unique_ptr<InputSink> CreateRecordingSink(std::unique_ptr<InputSink> inner, Recorder& recorder) {
+    return std::make_unique<RecordingSink>(std::move(inner), recorder);
+}
+
+// ============ 解码 ============
+
+MacroView::Cursor::Cursor(const MacroView& view)
+    : m_position(view.m_payload), m_end(view.m_payload + view.m_payloadSize), m_remaining(view.m_eventCount) {
+}
+
+bool MacroView::Cursor::Next(TimedEvent& out) {
+    if (m_remaining == 0 || m_corrupt) {
+        return false;
+    }
+    m_corrupt = true;
+    if (m_position >= m_end) {
+        return false;
+    }
+
+    const std::uint8_t tag = *m_position++;
+    const int type = tag & 0x07;
+    const int delivery = (tag >> 3) & 0x03;
+    const int button = tag >> 5;
+    if (type > kMaxEventType || delivery > kMaxDelivery || button > kMaxButton) {
+        return false;
+    }
+
+    std::uint64_t deltaUs = 0;
+    if (!GetVarint(m_position, m_end, deltaUs)) {
+        return false;
+    }
+    InputEvent event;
+    event.type = static_cast<EventType>(type);
+    event.delivery = static_cast<Delivery>(delivery);
+    if (event.type == EventType::MOUSE_MOVE) {
+        if (button > 1) {
+            return false;
+        }
+    } else {
+        event.button = static_cast<MouseButton>(button);
+    }
+    if (HasCode(event.type)) {
+        std::uint64_t code = 0;
+        if (!GetVarint(m_position, m_end, code) || code > 0xFFFFFFFFu) {
+            return false;
+        }
+        event.code = static_cast<std::uint32_t>(code);
+    } else {
+        std::int64_t dx = 0;
+        std::int64_t dy = 0;
+        if (!GetSigned(m_position, m_end, dx) || !GetSigned(m_position, m_end, dy)) {
+            return false;
+        }
+        m_x = static_cast<int>(m_x + dx);
+        m_y = static_cast<int>(m_y + dy);
+        event.x = m_x;
+        event.y = m_y;
+        if (event.type == EventType::WHEEL) {
+            std::int64_t delta = 0;
+            if (!GetSigned(m_position, m_end, delta)) {
+                return false;
+            }
+            event.delta = static_cast<int>(delta);
+        } else if (event.type == EventType::MOUSE_MOVE && button == 1) {
+            std::uint64_t held = 0;
+            if (!GetVarint(m_position, m_end, held) || held == 0 || held > static_cast<std::uint64_t>(kMaxHeld)) {
+                return false;
+            }
+            event.held = static_cast<std::uint8_t>(held);
+        }
+    }
+
+    m_timeUs += deltaUs;
+    out.timeUs = m_timeUs;
+    out.event = event;
+    m_remaining--;
+    m_corrupt = false;
+    return true;
+}
+
+Result<MacroView> MacroView::Open(const std::uint8_t* data, size_t size) {
+    if (!data || size < kHeaderSize) {
+        return Result<MacroView>::Error(ErrorCode::INVALID_PARAMETER, L"Macro data is too short");
+    }
+    if (GetLittleEndian(data, 4) != kMagic) {
+        return Result<MacroView>::Error(ErrorCode::INVALID_PARAMETER, L"Not a macro file");
+    }
+    if (GetLittleEndian(data + 4, 2) != kVersion) {
+        return Result<MacroView>::Error(ErrorCode::INVALID_PARAMETER, L"Unsupported macro version");
+    }
+    const std::uint64_t payloadSize = GetLittleEndian(data + 12, 4);
+    if (payloadSize > size - kHeaderSize) {
+        return Result<MacroView>::Error(ErrorCode::INVALID_PARAMETER, L"Macro data is truncated");
+    }
+
+    MacroView view;
+    view.m_payload = data + kHeaderSize;
+    view.m_payloadSize = static_cast<size_t>(payloadSize);
+    view.m_eventCount = static_cast<std::uint32_t>(GetLittleEndian(data + 8, 4));
+    return Result<MacroView>::Success(view);
+}
+
+Result<bool> MacroView::Validate() const {
+    Cursor cursor(*this);
+    TimedEvent timed;
+    size_t decoded = 0;
+    while (cursor.Next(timed)) {
+        decoded++;
+    }
+    if (cursor.IsCorrupt() || decoded != m_eventCount) {
+        return Result<bool>::Error(ErrorCode::INVALID_PARAMETER, L"Macro data is corrupt");
+    }
+    return Result<bool>::Success(true);
+}
+
+Result<std::vector<TimedEvent>> MacroView::Decode() const {
+    std::vector<TimedEvent> events;
+    events.reserve(m_eventCount);
+    Cursor cursor(*this);
+    TimedEvent timed;
+    while (cursor.Next(timed)) {
+        events.push_back(timed);
+    }
+    if (cursor.IsCorrupt() || events.size() != m_eventCount) {
+        return Result<std::vector<TimedEvent>>::Error(ErrorCode::INVALID_PARAMETER, L"Macro data is corrupt");
+    }
+    return Result<std::vector<TimedEvent>>::Success(std::move(events));
+}
+
+// ============ 文件映射 ============
+
+Result<std::shared_ptr<const MappedMacro>> MappedMacro::Open(const std::string& path) {
+    std::shared_ptr<MappedMacro> mapped(new MappedMacro());
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return Result<std::shared_ptr<const MappedMacro>>::Error(ErrorCode::OPERATION_FAILED, L"Cannot open macro file");
+    }
+    LARGE_INTEGER fileSize;
+    const bool sized = GetFileSizeEx(file, &fileSize) != FALSE && fileSize.QuadPart > 0;
+    HANDLE mapping = sized ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+    // 映射对象持有文件，文件句柄可以立即关闭
+    CloseHandle(file);
+    if (!mapping) {
+        return Result<std::shared_ptr<const MappedMacro>>::Error(ErrorCode::OPERATION_FAILED, L"Cannot map macro file");
+    }
+    mapped->m_mapping = mapping;
+    mapped->m_address = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    mapped->m_size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    const int file = open(path.c_str(), O_RDONLY);
+    if (file < 0) {
+        return Result<std::shared_ptr<const MappedMacro>>::Error(ErrorCode::OPERATION_FAILED, L"Cannot open macro file");
+    }
+    struct stat info;
+    const bool sized = fstat(file, &info) == 0 && info.st_size > 0;
+    void* address = sized ? mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, file, 0) : MAP_FAILED;
+    // 映射建立后文件描述符可以立即关闭
+    close(file);
+    if (address != MAP_FAILED) {
+        mapped->m_address = address;
+        mapped->m_size = static_cast<size_t>(info.st_size);
+    }
+#endif
+    if (!mapped->m_address) {
+        return Result<std::shared_ptr<const MappedMacro>>::Error(ErrorCode::OPERATION_FAILED, L"Cannot map macro file");
+    }
+
+    auto view = MacroView::Open(static_cast<const std::uint8_t*>(mapped->m_address), mapped->m_size);
+    if (view.IsError()) {
+        return Result<std::shared_ptr<const MappedMacro>>::Error(view.GetErrorCode(), view.GetErrorMessage());
+    }
+    mapped->m_view = view.GetData();
+    return Result<std::shared_ptr<const MappedMacro>>::Success(std::move(mapped));
+}
+
+MappedMacro::~MappedMacro() {
+#ifdef _WIN32
+    if (m_address) {
+        UnmapViewOfFile(m_address);
+    }
+    if (m_mapping) {
+        CloseHandle(m_mapping);
+    }
+#else
+    if (m_address) {
+        munmap(const_cast<void*>(m_address), m_size);
+    }
+#endif
+}
+
+// ============ 回放 ============
+
+void SleepUntil(Clock::time_point deadline, std::chrono::microseconds spin) {
+    const Clock::time_point coarse = deadline - spin;
+    if (Clock::now() < coarse) {
+        std::this_thread::sleep_until(coarse);
+    }
+    while (Clock::now() < deadline) {
+#ifdef WINDOWSAPI_X86
+        _mm_pause();
+#endif
+    }
+}
+
+Result<ReplayReport> Replay(const MacroView& macro, InputSink& sink, const std::vector<WindowHandle>& windows,
+                            const ReplayOptions& options) {
+    if (!(options.speed > 0.0) || options.spinUs < 0 || windows.empty()) {
+        return Result<ReplayReport>::Error(ErrorCode::INVALID_PARAMETER, L"Invalid replay options");
+    }
+    auto valid = macro.Validate();
+    if (valid.IsError()) {
+        return Result<ReplayReport>::Error(valid.GetErrorCode(), valid.GetErrorMessage());
+    }
+
+    ReplayReport report;
+    report.eventCount = macro.GetEventCount();
+    std::vector<WindowHandle> active;
+    active.reserve(windows.size());
+    for (WindowHandle window : windows) {
+        if (sink.BeginBatch(window).IsSuccess()) {
+            active.push_back(window);
+        } else {
+            report.failedWindowCount++;
+        }
+    }
+
+    // 整个宏按一批解析投递方式，保持事件顺序
+    bool postable = true;
+    {
+        MacroView::Cursor scan(macro);
+        TimedEvent timed;
+        while (postable && scan.Next(timed)) {
+            postable = InputDispatcher::IsPostable(timed.event);
+        }
+    }
+
+    std::vector<double> jitter;
+    jitter.reserve(report.eventCount * active.size());
+    const std::chrono::microseconds spin(options.spinUs);
+    const Clock::time_point start = Clock::now();
+    MacroView::Cursor cursor(macro);
+    TimedEvent timed;
+    while (cursor.Next(timed)) {
+        const auto offset = std::chrono::duration<double, std::micro>(static_cast<double>(timed.timeUs) / options.speed);
+        const Clock::time_point deadline = start + std::chrono::duration_cast<Clock::duration>(offset);
+        SleepUntil(deadline, spin);
+
+        // 窗口依次派发：每次派发开始时记录延迟，后面的窗口包含前面窗口的派发耗时
+        const Delivery delivery = InputDispatcher::ResolveDelivery(timed.event, postable);
+        for (size_t i = 0; i < active.size();) {
+            jitter.push_back(std::chrono::duration<double, std::micro>(Clock::now() - deadline).count());
+            if (sink.Deliver(active[i], timed.event, delivery).IsSuccess()) {
+                report.deliveredCount++;
+                i++;
+            } else {
+                // 派发失败的窗口不再回放
+                report.failedWindowCount++;
+                active.erase(active.begin() + static_cast<std::ptrdiff_t>(i));
+            }
+        }
+    }
+    report.durationUs = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+
+    std::sort(jitter.begin(), jitter.end());
+    report.jitterP50Us = Percentile(jitter, 0.50);
+    report.jitterP90Us = Percentile(jitter, 0.90);
+    report.jitterP99Us = Percentile(jitter, 0.99);
+    report.jitterMaxUs = jitter.empty() ? 0.0 : jitter.back();
+    return Result<ReplayReport>::Success(report);
+}
+
+}  // namespace InputMacro
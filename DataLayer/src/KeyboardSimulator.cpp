@@ -1,4 +1,5 @@
 #include "../include/KeyboardSimulator.h"
+#include "../include/Win32InputSink.h"
 #include <windows.h>
 
 
@@ -6,88 +7,154 @@ namespace KeyboardSimulator {
 
 // 内部辅助函数
 namespace {
-    // 构建键盘消息的LPARAM
-    LPARAM MakeKeyLParam(UINT scanCode, bool keyUp = false, bool extended = false) {
-        LPARAM lParam = 1; // 重复计数
-        lParam |= (scanCode & 0xFF) << 16; // 扫描码
-        if (extended) lParam |= 0x01000000; // 扩展键标志
-        if (keyUp) lParam |= 0x80000000; // 键释放标志
-        lParam |= 0x20000000; // 前一个键状态（假设之前未按下）
-        return lParam;
+    // 一块消息的处理进度（SendMessageCallback 的回调计数）
+    struct ChunkProgress {
+        size_t handled = 0;
+    };
+
+    VOID CALLBACK OnMessageHandled(HWND, UINT, ULONG_PTR data, LRESULT) {
+        reinterpret_cast<ChunkProgress*>(data)->handled++;
     }
-    
-    // 获取虚拟键码的扫描码
-    UINT GetScanCode(UINT virtualKey) {
-        return MapVirtualKey(virtualKey, MAPVK_VK_TO_VSC);
+
+    // 释放进度计数；超时或中途失败时还有回调未到，计数对象故意保留（之后取消息时回调仍会写入）
+    void ReleaseProgress(ChunkProgress* progress, size_t issued) {
+        if (progress->handled >= issued) {
+            delete progress;
+        }
     }
-    
-    // 检查是否为扩展键
-    bool IsExtendedKey(UINT virtualKey) {
-        switch (virtualKey) {
-            case VK_INSERT:
-            case VK_DELETE:
-            case VK_HOME:
-            case VK_END:
-            case VK_PRIOR: // Page Up
-            case VK_NEXT:  // Page Down
-            case VK_LEFT:
-            case VK_RIGHT:
-            case VK_UP:
-            case VK_DOWN:
-            case VK_RCONTROL:
-            case VK_RMENU: // Right Alt
-            case VK_LWIN:
-            case VK_RWIN:
-            case VK_APPS:
+
+    // 等待目标处理完已发出的消息：回调只在本线程取消息时调用
+    bool WaitHandled(const ChunkProgress& progress, size_t expected, int timeoutMs) {
+        const ULONGLONG deadline = GetTickCount64() + static_cast<ULONGLONG>(timeoutMs);
+        MSG message;
+        while (true) {
+            PeekMessage(&message, nullptr, 0, 0, PM_NOREMOVE);
+            if (progress.handled >= expected) {
                 return true;
-            default:
+            }
+            const ULONGLONG now = GetTickCount64();
+            if (now >= deadline) {
                 return false;
+            }
+            const DWORD wait = static_cast<DWORD>(deadline - now < 10 ? deadline - now : 10);
+            MsgWaitForMultipleObjects(0, nullptr, FALSE, wait, QS_ALLINPUT);
         }
     }
+
+    // 流水发送 [begin, end) 的按键与字符消息，块末等待全部处理完
+    Result<bool> SendEvents(HWND windowHandle, const std::vector<TextInput::InputEvent>& events,
+                            size_t begin, size_t end, int timeoutMs) {
+        auto* progress = new ChunkProgress();
+        size_t issued = 0;
+        for (size_t i = begin; i < end; i++) {
+            const InputDispatcher::WindowMessage built = InputDispatcher::ToWindowMessage(events[i], 0);
+            if (!SendMessageCallback(windowHandle, built.message, built.wParam, built.lParam, OnMessageHandled,
+                                     reinterpret_cast<ULONG_PTR>(progress))) {
+                ReleaseProgress(progress, issued);
+                return Result<bool>::Error(ErrorCode::INPUT_SIMULATION_FAILED, L"SendMessageCallback failed");
+            }
+            issued++;
+        }
+        const bool handled = WaitHandled(*progress, issued, timeoutMs);
+        ReleaseProgress(progress, issued);
+        if (!handled) {
+            return Result<bool>::Error(ErrorCode::WINDOW_NOT_RESPONDING, L"Target window did not process text in time");
+        }
+        return Result<bool>::Success(true);
+    }
+
+    // 单个事件经接收端同步发送（WM_KEYDOWN/WM_KEYUP/WM_CHAR，与 SendEvents 相同）
+    Result<bool> SendEvent(InputDispatcher::InputSink& sink, HWND windowHandle, InputDispatcher::InputEvent event) {
+        auto delivered = InputDispatcher::DeliverBatch(sink, windowHandle, {event.Via(InputDispatcher::Delivery::SEND)});
+        if (delivered.IsError()) {
+            return Result<bool>::Error(delivered.GetErrorCode(), delivered.GetErrorMessage());
+        }
+        return Result<bool>::Success(true);
+    }
+
+    // 发送带字符串参数的编辑控件消息（跨进程时由系统封送字符串）
+    Result<bool> SendStringMessage(HWND windowHandle, UINT message, WPARAM wParam, const std::wstring& text, int timeoutMs) {
+        DWORD_PTR result = 0;
+        if (!SendMessageTimeout(windowHandle, message, wParam, reinterpret_cast<LPARAM>(text.c_str()),
+                                SMTO_NORMAL | SMTO_ABORTIFHUNG, static_cast<UINT>(timeoutMs), &result)) {
+            return Result<bool>::Error(ErrorCode::WINDOW_NOT_RESPONDING, L"Target window did not process text in time");
+        }
+        if (message == WM_SETTEXT && !result) {
+            return Result<bool>::Error(ErrorCode::INPUT_SIMULATION_FAILED, L"WM_SETTEXT was rejected");
+        }
+        return Result<bool>::Success(true);
+    }
 }
 
 // ============ 基础按键操作 ============
 
 Result<bool> KeyDown(HWND windowHandle, UINT virtualKey) {
-    if (!IsWindow(windowHandle)) {
-        return Result<bool>::Error(ErrorCode::INVALID_HANDLE, L"Invalid window handle");
-    }
-    
-    UINT scanCode = GetScanCode(virtualKey);
-    bool extended = IsExtendedKey(virtualKey);
-    LPARAM lParam = MakeKeyLParam(scanCode, false, extended);
-    
-    SendMessage(windowHandle, WM_KEYDOWN, virtualKey, lParam);
-    
-    return Result<bool>::Success(true);
+    auto sink = InputDispatcher::CreateWin32Sink();
+    return KeyDown(*sink, windowHandle, virtualKey);
+}
+
+Result<bool> KeyDown(InputDispatcher::InputSink& sink, HWND windowHandle, UINT virtualKey) {
+    return SendEvent(sink, windowHandle, InputDispatcher::InputEvent::KeyDown(virtualKey));
 }
 
 Result<bool> KeyUp(HWND windowHandle, UINT virtualKey) {
-    if (!IsWindow(windowHandle)) {
-        return Result<bool>::Error(ErrorCode::INVALID_HANDLE, L"Invalid window handle");
-    }
-    
-    UINT scanCode = GetScanCode(virtualKey);
-    bool extended = IsExtendedKey(virtualKey);
-    LPARAM lParam = MakeKeyLParam(scanCode, true, extended);
-    
-    SendMessage(windowHandle, WM_KEYUP, virtualKey, lParam);
-    
-    return Result<bool>::Success(true);
+    auto sink = InputDispatcher::CreateWin32Sink();
+    return KeyUp(*sink, windowHandle, virtualKey);
+}
+
+Result<bool> KeyUp(InputDispatcher::InputSink& sink, HWND windowHandle, UINT virtualKey) {
+    return SendEvent(sink, windowHandle, InputDispatcher::InputEvent::KeyUp(virtualKey));
 }
 
 // ============ 文本输入 ============
 
 Result<bool> SendChar(HWND windowHandle, wchar_t character) {
+    auto sink = InputDispatcher::CreateWin32Sink();
+    return SendChar(*sink, windowHandle, character);
+}
+
+Result<bool> SendChar(InputDispatcher::InputSink& sink, HWND windowHandle, wchar_t character) {
+    return SendEvent(sink, windowHandle, InputDispatcher::InputEvent::Char(character));
+}
+
+Result<int> SendText(HWND windowHandle, const std::wstring& text, const TextInput::TextOptions& options) {
     if (!IsWindow(windowHandle)) {
-        return Result<bool>::Error(ErrorCode::INVALID_HANDLE, L"Invalid window handle");
+        return Result<int>::Error(ErrorCode::INVALID_HANDLE, L"Invalid window handle");
     }
-    
-    // 使用WM_CHAR消息发送字符
-    SendMessage(windowHandle, WM_CHAR, character, 1);
-    
-    return Result<bool>::Success(true);
+
+    auto built = TextInput::BuildPlan(text, options);
+    if (built.IsError()) {
+        return Result<int>::Error(built.GetErrorCode(), built.GetErrorMessage());
+    }
+    const TextInput::TextPlan plan = std::move(built).TakeData();
+
+    size_t begin = 0;
+    for (size_t chunk = 0; chunk < plan.chunkEnds.size(); chunk++) {
+        if (chunk > 0 && options.chunkDelayMs > 0) {
+            Sleep(static_cast<DWORD>(options.chunkDelayMs));
+        }
+        const size_t end = plan.chunkEnds[chunk];
+        Result<bool> sent = Result<bool>::Success(true);
+        switch (plan.mode) {
+            case TextInput::TextMode::SET_TEXT:
+                sent = SendStringMessage(windowHandle, WM_SETTEXT, 0, plan.text, options.timeoutMs);
+                break;
+            case TextInput::TextMode::REPLACE_SELECTION:
+                sent = SendStringMessage(windowHandle, EM_REPLACESEL, TRUE, plan.text.substr(begin, end - begin),
+                                         options.timeoutMs);
+                break;
+            default:
+                sent = SendEvents(windowHandle, plan.events, begin, end, options.timeoutMs);
+                break;
+        }
+        if (sent.IsError()) {
+            return Result<int>::Error(sent.GetErrorCode(), sent.GetErrorMessage());
+        }
+        begin = end;
+    }
+    return Result<int>::Success(static_cast<int>(plan.characterCount));
 }
+
 // ============ 键盘状态 ============
 
 Result<bool> IsKeyPressed(UINT virtualKey) {
@@ -0,0 +1,302 @@
+#include "MatchKernels.h"
+#include "CpuFeatures.h"
+
+#ifdef WINDOWSAPI_X86
+#include <immintrin.h>
+#endif
+
+namespace MatchKernels {
+
+// 内部辅助函数
+namespace {
+    std::uint32_t SadRowScalar(const std::uint8_t* a, const std::uint8_t* b, int n) {
+        std::uint32_t sum = 0;
+        for (int i = 0; i < n; i++) {
+            sum += static_cast<std::uint32_t>(a[i] > b[i] ? a[i] - b[i] : b[i] - a[i]);
+        }
+        return sum;
+    }
+    
+    std::uint32_t SsdRowScalar(const std::uint8_t* a, const std::uint8_t* b, int n) {
+        std::uint32_t sum = 0;
+        for (int i = 0; i < n; i++) {
+            int diff = static_cast<int>(a[i]) - static_cast<int>(b[i]);
+            sum += static_cast<std::uint32_t>(diff * diff);
+        }
+        return sum;
+    }
+    
+    std::uint32_t DotRowScalar(const std::uint8_t* a, const std::uint8_t* b, int n) {
+        std::uint32_t sum = 0;
+        for (int i = 0; i < n; i++) {
+            sum += static_cast<std::uint32_t>(a[i]) * b[i];
+        }
+        return sum;
+    }
+    
+    // 掩码版本：先把大图像素与掩码相与，模板中被掩盖的像素已经是0，差与乘积都为0
+    std::uint32_t MaskedSadRowScalar(const std::uint8_t* a, const std::uint8_t* b, const std::uint8_t* m, int n) {
+        std::uint32_t sum = 0;
+        for (int i = 0; i < n; i++) {
+            int diff = static_cast<int>(a[i] & m[i]) - static_cast<int>(b[i]);
+            sum += static_cast<std::uint32_t>(diff < 0 ? -diff : diff);
+        }
+        return sum;
+    }
+    
+    std::uint32_t MaskedSsdRowScalar(const std::uint8_t* a, const std::uint8_t* b, const std::uint8_t* m, int n) {
+        std::uint32_t sum = 0;
+        for (int i = 0; i < n; i++) {
+            int diff = static_cast<int>(a[i] & m[i]) - static_cast<int>(b[i]);
+            sum += static_cast<std::uint32_t>(diff * diff);
+        }
+        return sum;
+    }
+    
+    MaskedStats MaskedStatsRowScalar(const std::uint8_t* a, const std::uint8_t* b, const std::uint8_t* m, int n) {
+        MaskedStats stats = {0, 0, 0};
+        for (int i = 0; i < n; i++) {
+            std::uint32_t v = a[i] & m[i];
+            stats.dot += v * b[i];
+            stats.sum += v;
+            stats.sumSq += v * v;
+        }
+        return stats;
+    }
+    
+#ifdef WINDOWSAPI_X86
+    WINDOWSAPI_TARGET("sse2")
+    inline std::uint32_t HorizontalSum32(__m128i v) {
+        v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+        v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+        return static_cast<std::uint32_t>(_mm_cvtsi128_si32(v));
+    }
+    
+    WINDOWSAPI_TARGET("sse2")
+    std::uint32_t SadRowSSE2(const std::uint8_t* a, const std::uint8_t* b, int n) {
+        __m128i acc = _mm_setzero_si128();
+        int i = 0;
+        for (; i + 16 <= n; i += 16) {
+            __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            acc = _mm_add_epi64(acc, _mm_sad_epu8(va, vb));
+        }
+        std::uint32_t sum = static_cast<std::uint32_t>(_mm_cvtsi128_si32(acc)) +
+                            static_cast<std::uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(acc, 8)));
+        return sum + SadRowScalar(a + i, b + i, n - i);
+    }
+    
+    WINDOWSAPI_TARGET("sse2")
+    std::uint32_t SsdRowSSE2(const std::uint8_t* a, const std::uint8_t* b, int n) {
+        const __m128i zero = _mm_setzero_si128();
+        __m128i acc = _mm_setzero_si128();
+        int i = 0;
+        for (; i + 16 <= n; i += 16) {
+            __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            __m128i diff = _mm_or_si128(_mm_subs_epu8(va, vb), _mm_subs_epu8(vb, va));
+            __m128i lo = _mm_unpacklo_epi8(diff, zero);
+            __m128i hi = _mm_unpackhi_epi8(diff, zero);
+            acc = _mm_add_epi32(acc, _mm_madd_epi16(lo, lo));
+            acc = _mm_add_epi32(acc, _mm_madd_epi16(hi, hi));
+        }
+        return HorizontalSum32(acc) + SsdRowScalar(a + i, b + i, n - i);
+    }
+    
+    WINDOWSAPI_TARGET("sse2")
+    std::uint32_t DotRowSSE2(const std::uint8_t* a, const std::uint8_t* b, int n) {
+        const __m128i zero = _mm_setzero_si128();
+        __m128i acc = _mm_setzero_si128();
+        int i = 0;
+        for (; i + 16 <= n; i += 16) {
+            __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_unpacklo_epi8(va, zero), _mm_unpacklo_epi8(vb, zero)));
+            acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_unpackhi_epi8(va, zero), _mm_unpackhi_epi8(vb, zero)));
+        }
+        return HorizontalSum32(acc) + DotRowScalar(a + i, b + i, n - i);
+    }
+    
+    WINDOWSAPI_TARGET("sse2")
+    std::uint32_t MaskedSadRowSSE2(const std::uint8_t* a, const std::uint8_t* b, const std::uint8_t* m, int n) {
+        __m128i acc = _mm_setzero_si128();
+        int i = 0;
+        for (; i + 16 <= n; i += 16) {
+            __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            __m128i vm = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m + i));
+            acc = _mm_add_epi64(acc, _mm_sad_epu8(_mm_and_si128(va, vm), vb));
+        }
+        std::uint32_t sum = static_cast<std::uint32_t>(_mm_cvtsi128_si32(acc)) +
+                            static_cast<std::uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(acc, 8)));
+        return sum + MaskedSadRowScalar(a + i, b + i, m + i, n - i);
+    }
+    
+    WINDOWSAPI_TARGET("sse2")
+    std::uint32_t MaskedSsdRowSSE2(const std::uint8_t* a, const std::uint8_t* b, const std::uint8_t* m, int n) {
+        const __m128i zero = _mm_setzero_si128();
+        __m128i acc = _mm_setzero_si128();
+        int i = 0;
+        for (; i + 16 <= n; i += 16) {
+            __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            __m128i vm = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m + i));
+            va = _mm_and_si128(va, vm);
+            __m128i diff = _mm_or_si128(_mm_subs_epu8(va, vb), _mm_subs_epu8(vb, va));
+            __m128i lo = _mm_unpacklo_epi8(diff, zero);
+            __m128i hi = _mm_unpackhi_epi8(diff, zero);
+            acc = _mm_add_epi32(acc, _mm_madd_epi16(lo, lo));
+            acc = _mm_add_epi32(acc, _mm_madd_epi16(hi, hi));
+        }
+        return HorizontalSum32(acc) + MaskedSsdRowScalar(a + i, b + i, m + i, n - i);
+    }
+    
+    WINDOWSAPI_TARGET("sse2")
+    MaskedStats MaskedStatsRowSSE2(const std::uint8_t* a, const std::uint8_t* b, const std::uint8_t* m, int n) {
+        const __m128i zero = _mm_setzero_si128();
+        __m128i dot = _mm_setzero_si128();
+        __m128i sum = _mm_setzero_si128();
+        __m128i sumSq = _mm_setzero_si128();
+        int i = 0;
+        for (; i + 16 <= n; i += 16) {
+            __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            __m128i vm = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m + i));
+            va = _mm_and_si128(va, vm);
+            sum = _mm_add_epi64(sum, _mm_sad_epu8(va, zero));
+            __m128i aLo = _mm_unpacklo_epi8(va, zero);
+            __m128i aHi = _mm_unpackhi_epi8(va, zero);
+            dot = _mm_add_epi32(dot, _mm_madd_epi16(aLo, _mm_unpacklo_epi8(vb, zero)));
+            dot = _mm_add_epi32(dot, _mm_madd_epi16(aHi, _mm_unpackhi_epi8(vb, zero)));
+            sumSq = _mm_add_epi32(sumSq, _mm_madd_epi16(aLo, aLo));
+            sumSq = _mm_add_epi32(sumSq, _mm_madd_epi16(aHi, aHi));
+        }
+        MaskedStats stats = MaskedStatsRowScalar(a + i, b + i, m + i, n - i);
+        stats.dot += HorizontalSum32(dot);
+        stats.sum += static_cast<std::uint32_t>(_mm_cvtsi128_si32(sum)) +
+                     static_cast<std::uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(sum, 8)));
+        stats.sumSq += HorizontalSum32(sumSq);
+        return stats;
+    }
+    
+    WINDOWSAPI_TARGET("avx2")
+    inline std::uint32_t HorizontalSum32(__m256i v) {
+        __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+        return static_cast<std::uint32_t>(_mm_cvtsi128_si32(sum));
+    }
+    
+    WINDOWSAPI_TARGET("avx2")
+    std::uint32_t SadRowAVX2(const std::uint8_t* a, const std::uint8_t* b, int n) {
+        __m256i acc = _mm256_setzero_si256();
+        int i = 0;
+        for (; i + 32 <= n; i += 32) {
+            __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+            acc = _mm256_add_epi64(acc, _mm256_sad_epu8(va, vb));
+        }
+        // SAD结果位于每个64位通道的低32位
+        return HorizontalSum32(acc) + SadRowSSE2(a + i, b + i, n - i);
+    }
+    
+    WINDOWSAPI_TARGET("avx2")
+    std::uint32_t SsdRowAVX2(const std::uint8_t* a, const std::uint8_t* b, int n) {
+        __m256i acc = _mm256_setzero_si256();
+        int i = 0;
+        for (; i + 16 <= n; i += 16) {
+            __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            __m256i diff = _mm256_sub_epi16(_mm256_cvtepu8_epi16(va), _mm256_cvtepu8_epi16(vb));
+            acc = _mm256_add_epi32(acc, _mm256_madd_epi16(diff, diff));
+        }
+        return HorizontalSum32(acc) + SsdRowScalar(a + i, b + i, n - i);
+    }
+    
+    WINDOWSAPI_TARGET("avx2")
+    std::uint32_t DotRowAVX2(const std::uint8_t* a, const std::uint8_t* b, int n) {
+        __m256i acc = _mm256_setzero_si256();
+        int i = 0;
+        for (; i + 16 <= n; i += 16) {
+            __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            acc = _mm256_add_epi32(acc, _mm256_madd_epi16(_mm256_cvtepu8_epi16(va), _mm256_cvtepu8_epi16(vb)));
+        }
+        return HorizontalSum32(acc) + DotRowScalar(a + i, b + i, n - i);
+    }
+    
+    WINDOWSAPI_TARGET("avx2")
+    std::uint32_t MaskedSadRowAVX2(const std::uint8_t* a, const std::uint8_t* b, const std::uint8_t* m, int n) {
+        __m256i acc = _mm256_setzero_si256();
+        int i = 0;
+        for (; i + 32 <= n; i += 32) {
+            __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+            __m256i vm = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(m + i));
+            acc = _mm256_add_epi64(acc, _mm256_sad_epu8(_mm256_and_si256(va, vm), vb));
+        }
+        return HorizontalSum32(acc) + MaskedSadRowSSE2(a + i, b + i, m + i, n - i);
+    }
+    
+    WINDOWSAPI_TARGET("avx2")
+    std::uint32_t MaskedSsdRowAVX2(const std::uint8_t* a, const std::uint8_t* b, const std::uint8_t* m, int n) {
+        __m256i acc = _mm256_setzero_si256();
+        int i = 0;
+        for (; i + 16 <= n; i += 16) {
+            __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            __m128i vm = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m + i));
+            __m256i diff = _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm_and_si128(va, vm)), _mm256_cvtepu8_epi16(vb));
+            acc = _mm256_add_epi32(acc, _mm256_madd_epi16(diff, diff));
+        }
+        return HorizontalSum32(acc) + MaskedSsdRowScalar(a + i, b + i, m + i, n - i);
+    }
+    
+    WINDOWSAPI_TARGET("avx2")
+    MaskedStats MaskedStatsRowAVX2(const std::uint8_t* a, const std::uint8_t* b, const std::uint8_t* m, int n) {
+        __m256i dot = _mm256_setzero_si256();
+        __m256i sumSq = _mm256_setzero_si256();
+        __m128i sum = _mm_setzero_si128();
+        int i = 0;
+        for (; i + 16 <= n; i += 16) {
+            __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            __m128i vm = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m + i));
+            va = _mm_and_si128(va, vm);
+            sum = _mm_add_epi64(sum, _mm_sad_epu8(va, _mm_setzero_si128()));
+            __m256i wa = _mm256_cvtepu8_epi16(va);
+            dot = _mm256_add_epi32(dot, _mm256_madd_epi16(wa, _mm256_cvtepu8_epi16(vb)));
+            sumSq = _mm256_add_epi32(sumSq, _mm256_madd_epi16(wa, wa));
+        }
+        MaskedStats stats = MaskedStatsRowScalar(a + i, b + i, m + i, n - i);
+        stats.dot += HorizontalSum32(dot);
+        stats.sum += static_cast<std::uint32_t>(_mm_cvtsi128_si32(sum)) +
+                     static_cast<std::uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(sum, 8)));
+        stats.sumSq += HorizontalSum32(sumSq);
+        return stats;
+    }
+#endif
+    
+    const KernelSet kScalarKernels = {SadRowScalar, SsdRowScalar, DotRowScalar,
+                                      MaskedSadRowScalar, MaskedSsdRowScalar, MaskedStatsRowScalar};
+#ifdef WINDOWSAPI_X86
+    const KernelSet kSSE2Kernels = {SadRowSSE2, SsdRowSSE2, DotRowSSE2,
+                                    MaskedSadRowSSE2, MaskedSsdRowSSE2, MaskedStatsRowSSE2};
+    const KernelSet kAVX2Kernels = {SadRowAVX2, SsdRowAVX2, DotRowAVX2,
+                                    MaskedSadRowAVX2, MaskedSsdRowAVX2, MaskedStatsRowAVX2};
+#endif
+}
+
+const KernelSet& GetKernels() {
+#ifdef WINDOWSAPI_X86
+    switch (CpuFeatures::GetSimdLevel()) {
+        case CpuFeatures::SimdLevel::AVX2: return kAVX2Kernels;
+        case CpuFeatures::SimdLevel::SSSE3:
+        case CpuFeatures::SimdLevel::SSE2: return kSSE2Kernels;
+        default: break;
+    }
+#endif
+    return kScalarKernels;
+}
+
+}  // namespace MatchKernels
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+/**
+ * @namespace MatchKernels
+ * @brief 模板匹配使用的8位灰度行内核（数据层内部使用）
+ * 
+ * 每个内核处理一行 n 个像素，按运行时检测到的SIMD级别选择实现。
+ */
+namespace MatchKernels {
+
+// 绝对差之和
+using SadRowFn = std::uint32_t (*)(const std::uint8_t* a, const std::uint8_t* b, int n);
+// 差的平方和
+using SsdRowFn = std::uint32_t (*)(const std::uint8_t* a, const std::uint8_t* b, int n);
+// 乘积之和
+using DotRowFn = std::uint32_t (*)(const std::uint8_t* a, const std::uint8_t* b, int n);
+
+/**
+ * @brief 掩码行的 NCC 统计量
+ */
+struct MaskedStats {
+    std::uint32_t dot;      // 掩码内 a 与 b 的乘积之和
+    std::uint32_t sum;      // 掩码内 a 的和
+    std::uint32_t sumSq;    // 掩码内 a 的平方和
+};
+
+// 掩码内核：m 为 0x00/0xFF 字节掩码，b 为已按掩码清零的模板行，a 中 m 为 0 的像素不参与统计
+// 掩码内绝对差之和 / 差的平方和
+using MaskedDiffRowFn = std::uint32_t (*)(const std::uint8_t* a, const std::uint8_t* b, const std::uint8_t* m, int n);
+// 掩码内 NCC 统计量
+using MaskedStatsRowFn = MaskedStats (*)(const std::uint8_t* a, const std::uint8_t* b, const std::uint8_t* m, int n);
+
+/**
+ * @brief 一组行内核
+ */
+struct KernelSet {
+    SadRowFn sadRow;
+    SsdRowFn ssdRow;
+    DotRowFn dotRow;
+    MaskedDiffRowFn maskedSadRow;
+    MaskedDiffRowFn maskedSsdRow;
+    MaskedStatsRowFn maskedStatsRow;
+};
+
+/**
+ * @brief 获取当前SIMD级别对应的内核
+ */
+const KernelSet& GetKernels();
+
+/**
+ * @brief 由窗口与模板的统计量计算零均值归一化互相关
+ * 
+ * 纯色窗口或纯色模板时相关系数无定义：两者都是纯色时按均值差打分，否则为0。
+ * 
+ * @param dot 窗口与模板的乘积之和
+ * @param windowSum 窗口像素和
+ * @param windowSumSq 窗口像素平方和
+ * @param templSum 模板像素和
+ * @param templVariance 模板的 sumSq - sum^2 / n
+ * @param pixelCount 像素数 n
+ */
+inline double NccScore(double dot, double windowSum, double windowSumSq,
+                       double templSum, double templVariance, double pixelCount) {
+    double windowVariance = windowSumSq - windowSum * windowSum / pixelCount;
+    if (windowVariance < 1e-6 || templVariance < 1e-6) {
+        if (windowVariance < 1e-6 && templVariance < 1e-6) {
+            return 1.0 - std::fabs(windowSum - templSum) / (255.0 * pixelCount);
+        }
+        return 0.0;
+    }
+    double covariance = dot - windowSum * templSum / pixelCount;
+    return covariance / std::sqrt(windowVariance * templVariance);
+}
+
+}  // namespace MatchKernels
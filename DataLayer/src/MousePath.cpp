@@ -0,0 +1,197 @@
+#include "../include/MousePath.h"
+#include "../include/InputMacro.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace MousePath {
+
+// 内部辅助函数
+namespace {
+    const double kPi = 3.14159265358979323846;
+    const size_t kMaxPointCount = 65536;
+    const double kJitterSmoothing = 0.35;   // 抖动低通系数：越小越平滑
+
+    // 按轨迹时间逐个派发：第 i 个事件在第 min(i, 点数 - 1) 个点的时刻（拖拽的释放与最后一次移动同时）
+    Result<int> Play(InputSink& sink, WindowHandle window, const Path& path, const std::vector<InputEvent>& events,
+                     int spinUs) {
+        if (spinUs < 0) {
+            return Result<int>::Error(ErrorCode::INVALID_PARAMETER, L"Invalid spin time");
+        }
+        auto begin = sink.BeginBatch(window);
+        if (begin.IsError()) {
+            return Result<int>::Error(begin.GetErrorCode(), begin.GetErrorMessage());
+        }
+
+        const std::vector<PathPoint>& points = path.GetPoints();
+        const bool postable = InputDispatcher::IsPostableBatch(events);
+        const std::chrono::microseconds spin(spinUs);
+        const InputMacro::Clock::time_point start = InputMacro::Clock::now();
+        int delivered = 0;
+        for (size_t i = 0; i < events.size(); i++) {
+            const std::chrono::duration<double, std::milli> offset(points[std::min(i, points.size() - 1)].timeMs);
+            InputMacro::SleepUntil(start + std::chrono::duration_cast<InputMacro::Clock::duration>(offset), spin);
+            auto result = sink.Deliver(window, events[i], InputDispatcher::ResolveDelivery(events[i], postable));
+            if (result.IsError()) {
+                return Result<int>::Error(result.GetErrorCode(), result.GetErrorMessage());
+            }
+            delivered++;
+        }
+        return Result<int>::Success(delivered);
+    }
+
+    // 每个点一个移动事件，held 为按住按键的掩码（0 为悬停）
+    void AppendMoveHolding(const Path& path, std::uint8_t held, std::vector<InputEvent>& events) {
+        for (const PathPoint& point : path.GetPoints()) {
+            events.push_back(InputEvent::MouseMove(point.x, point.y, held));
+        }
+    }
+
+    // xorshift32：轨迹只需要可复现的廉价随机量
+    class Random {
+    public:
+        explicit Random(std::uint32_t seed) : m_state(seed ? seed : 0x9E3779B9u) {}
+
+        // [-1, 1) 内的均匀随机数
+        double Next() {
+            m_state ^= m_state << 13;
+            m_state ^= m_state >> 17;
+            m_state ^= m_state << 5;
+            return static_cast<double>(m_state >> 8) * (2.0 / 16777216.0) - 1.0;
+        }
+
+    private:
+        std::uint32_t m_state;
+    };
+
+    bool IsValid(const PathOptions& options) {
+        return options.speed > 0.0
+            && options.minDurationMs >= 0.0
+            && options.maxDurationMs >= options.minDurationMs
+            && options.sampleIntervalMs > 0.0
+            && (options.pointCount == 0 || options.pointCount >= 2)
+            && options.curvature >= 0.0
+            && options.jitter >= 0.0;
+    }
+}
+
+Path::Path(size_t capacity) {
+    m_points.reserve(capacity);
+}
+
+Result<size_t> Path::Generate(const Point& start, const Point& end, const PathOptions& options) {
+    if (!IsValid(options)) {
+        return Result<size_t>::Error(ErrorCode::INVALID_PARAMETER, L"Invalid mouse path options");
+    }
+
+    const double dx = static_cast<double>(end.x) - start.x;
+    const double dy = static_cast<double>(end.y) - start.y;
+    const double distance = std::hypot(dx, dy);
+    const double durationMs = std::min(std::max(distance / options.speed * 1000.0, options.minDurationMs),
+                                       options.maxDurationMs);
+    const double samples = options.pointCount > 0 ? options.pointCount
+                                                  : std::ceil(durationMs / options.sampleIntervalMs) + 1.0;
+    if (samples > static_cast<double>(kMaxPointCount)) {
+        return Result<size_t>::Error(ErrorCode::INVALID_PARAMETER, L"Mouse path has too many points");
+    }
+    const size_t count = std::max<size_t>(2, static_cast<size_t>(samples));
+
+    // 单位法向量；起终点重合时没有方向，不弯曲也不抖动
+    const double nx = distance > 0.0 ? -dy / distance : 0.0;
+    const double ny = distance > 0.0 ? dx / distance : 0.0;
+
+    // 两个控制点在三等分点处向同一侧偏移，形成一段弧
+    Random random(options.seed);
+    const double side = random.Next() < 0.0 ? -1.0 : 1.0;
+    const double bend1 = side * options.curvature * distance * (0.5 + 0.5 * std::abs(random.Next()));
+    const double bend2 = side * options.curvature * distance * (0.5 + 0.5 * std::abs(random.Next()));
+    const double c1x = start.x + dx / 3.0 + nx * bend1;
+    const double c1y = start.y + dy / 3.0 + ny * bend1;
+    const double c2x = start.x + dx * 2.0 / 3.0 + nx * bend2;
+    const double c2y = start.y + dy * 2.0 / 3.0 + ny * bend2;
+
+    m_points.clear();
+    double noise = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        const double t = static_cast<double>(i) / static_cast<double>(count - 1);
+        double px;
+        double py;
+        if (options.curve == Curve::BEZIER) {
+            const double s = t * t * (3.0 - 2.0 * t);
+            const double u = 1.0 - s;
+            const double b0 = u * u * u;
+            const double b1 = 3.0 * u * u * s;
+            const double b2 = 3.0 * u * s * s;
+            const double b3 = s * s * s;
+            px = b0 * start.x + b1 * c1x + b2 * c2x + b3 * end.x;
+            py = b0 * start.y + b1 * c1y + b2 * c2y + b3 * end.y;
+        } else {
+            const double s = t * t * t * (10.0 + t * (-15.0 + 6.0 * t));
+            px = start.x + s * dx;
+            py = start.y + s * dy;
+        }
+
+        if (options.jitter > 0.0) {
+            noise += kJitterSmoothing * (random.Next() - noise);
+            const double offset = options.jitter * std::sin(kPi * t) * noise;
+            px += nx * offset;
+            py += ny * offset;
+        }
+
+        PathPoint point;
+        point.x = i + 1 == count ? end.x : static_cast<int>(std::lround(px));
+        point.y = i + 1 == count ? end.y : static_cast<int>(std::lround(py));
+        point.timeMs = t * durationMs;
+        if (!m_points.empty() && m_points.back().x == point.x && m_points.back().y == point.y) {
+            if (i + 1 == count) {
+                m_points.back().timeMs = point.timeMs;
+            }
+            continue;
+        }
+        m_points.push_back(point);
+    }
+    return Result<size_t>::Success(m_points.size());
+}
+
+void AppendMove(const Path& path, std::vector<InputEvent>& events) {
+    AppendMoveHolding(path, 0, events);
+}
+
+void AppendMove(const Path& path, MouseButton held, std::vector<InputEvent>& events) {
+    AppendMoveHolding(path, InputDispatcher::HeldMask(held), events);
+}
+
+void AppendDrag(const Path& path, MouseButton button, std::vector<InputEvent>& events) {
+    const std::vector<PathPoint>& points = path.GetPoints();
+    if (points.empty()) {
+        return;
+    }
+    events.push_back(InputEvent::ButtonDown(points.front().x, points.front().y, button));
+    for (size_t i = 1; i < points.size(); i++) {
+        events.push_back(InputEvent::MouseMove(points[i].x, points[i].y, button).Via(InputDispatcher::Delivery::SEND));
+    }
+    events.push_back(InputEvent::ButtonUp(points.back().x, points.back().y, button));
+}
+
+Result<int> PlayMove(InputSink& sink, WindowHandle window, const Path& path, int spinUs) {
+    std::vector<InputEvent> events;
+    events.reserve(path.GetPointCount());
+    AppendMove(path, events);
+    return Play(sink, window, path, events, spinUs);
+}
+
+Result<int> PlayMove(InputSink& sink, WindowHandle window, const Path& path, MouseButton held, int spinUs) {
+    std::vector<InputEvent> events;
+    events.reserve(path.GetPointCount());
+    AppendMove(path, held, events);
+    return Play(sink, window, path, events, spinUs);
+}
+
+Result<int> PlayDrag(InputSink& sink, WindowHandle window, const Path& path, MouseButton button, int spinUs) {
+    std::vector<InputEvent> events;
+    events.reserve(path.GetPointCount() + 1);
+    AppendDrag(path, button, events);
+    return Play(sink, window, path, events, spinUs);
+}
+
+}  // namespace MousePath
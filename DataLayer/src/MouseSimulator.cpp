@@ -1,64 +1,18 @@
 #include "../include/MouseSimulator.h"
+#include "../include/Win32InputSink.h"
 #include <windows.h>
 
 namespace MouseSimulator {
 
 // 内部辅助函数
 namespace {
-    // 将MouseButton转换为Windows消息
-    UINT GetMouseDownMessage(MouseButton button) {
-        switch (button) {
-            case MouseButton::LEFT: return WM_LBUTTONDOWN;
-            case MouseButton::RIGHT: return WM_RBUTTONDOWN;
-            case MouseButton::MIDDLE: return WM_MBUTTONDOWN;
-            case MouseButton::X1: return WM_XBUTTONDOWN;
-            case MouseButton::X2: return WM_XBUTTONDOWN;
-            default: return WM_LBUTTONDOWN;
+    // 单个事件经接收端同步发送
+    Result<bool> SendEvent(InputDispatcher::InputSink& sink, HWND windowHandle, InputDispatcher::InputEvent event) {
+        auto delivered = InputDispatcher::DeliverBatch(sink, windowHandle, {event.Via(InputDispatcher::Delivery::SEND)});
+        if (delivered.IsError()) {
+            return Result<bool>::Error(delivered.GetErrorCode(), delivered.GetErrorMessage());
         }
-    }
-    
-    UINT GetMouseUpMessage(MouseButton button) {
-        switch (button) {
-            case MouseButton::LEFT: return WM_LBUTTONUP;
-            case MouseButton::RIGHT: return WM_RBUTTONUP;
-            case MouseButton::MIDDLE: return WM_MBUTTONUP;
-            case MouseButton::X1: return WM_XBUTTONUP;
-            case MouseButton::X2: return WM_XBUTTONUP;
-            default: return WM_LBUTTONUP;
-        }
-    }
-    
-    // 构建LPARAM参数（包含坐标信息）
-    LPARAM MakeLParam(int x, int y) {
-        return MAKELPARAM(x, y);
-    }
-    
-    // 构建鼠标消息的WPARAM参数（包含修饰键和鼠标按钮状态）
-    WPARAM BuildMouseWParam(MouseButton button) {
-        WPARAM wParam = 0;
-        if (GetAsyncKeyState(VK_CONTROL) & 0x8000) wParam |= MK_CONTROL;
-        if (GetAsyncKeyState(VK_SHIFT) & 0x8000) wParam |= MK_SHIFT;
-        
-        switch (button) {
-            case MouseButton::LEFT: wParam |= MK_LBUTTON; break;
-            case MouseButton::RIGHT: wParam |= MK_RBUTTON; break;
-            case MouseButton::MIDDLE: wParam |= MK_MBUTTON; break;
-            case MouseButton::X1: wParam |= MK_XBUTTON1; break;
-            case MouseButton::X2: wParam |= MK_XBUTTON2; break;
-        }
-        
-        return wParam;
-    }
-    
-    // 获取X按钮的附加信息
-    WPARAM GetXButtonWParam(MouseButton button) {
-        WPARAM wParam = BuildMouseWParam(button);
-        if (button == MouseButton::X1) {
-            wParam |= MAKEWPARAM(0, XBUTTON1);
-        } else if (button == MouseButton::X2) {
-            wParam |= MAKEWPARAM(0, XBUTTON2);
-        }
-        return wParam;
+        return Result<bool>::Success(true);
     }
 }
 
@@ -85,77 +39,72 @@ Result<Point> GetPositionInWindow(HWND windowHandle) {
 // ============ 窗口内点击操作 ============
 
 Result<bool> MouseButtonDownInWindow(HWND windowHandle, int x, int y, MouseButton button) {
-    if (!IsWindow(windowHandle)) {
-        return Result<bool>::Error(ErrorCode::INVALID_HANDLE, L"Invalid window handle");
-    }
-    
-    UINT message = GetMouseDownMessage(button);
-    WPARAM wParam;
-    
-    if (button == MouseButton::X1 || button == MouseButton::X2) {
-        wParam = GetXButtonWParam(button);
-    } else {
-        wParam = BuildMouseWParam(button);
-    }
-    
-    LPARAM lParam = MakeLParam(x, y);
-    
-    SendMessage(windowHandle, message, wParam, lParam);
-    
-    return Result<bool>::Success(true);
+    auto sink = InputDispatcher::CreateWin32Sink();
+    return MouseButtonDownInWindow(*sink, windowHandle, x, y, button);
+}
+
+Result<bool> MouseButtonDownInWindow(InputDispatcher::InputSink& sink, HWND windowHandle, int x, int y,
+                                     MouseButton button) {
+    return SendEvent(sink, windowHandle, InputDispatcher::InputEvent::ButtonDown(x, y, button));
 }
 
 Result<bool> MouseButtonUpInWindow(HWND windowHandle, int x, int y, MouseButton button) {
-    if (!IsWindow(windowHandle)) {
-        return Result<bool>::Error(ErrorCode::INVALID_HANDLE, L"Invalid window handle");
-    }
-    
-    UINT message = GetMouseUpMessage(button);
-    WPARAM wParam;
-    
-    if (button == MouseButton::X1 || button == MouseButton::X2) {
-        wParam = GetXButtonWParam(button);
-    } else {
-        wParam = BuildMouseWParam(button);
-    }
-    
-    LPARAM lParam = MakeLParam(x, y);
-    
-    SendMessage(windowHandle, message, wParam, lParam);
-    
-    return Result<bool>::Success(true);
+    auto sink = InputDispatcher::CreateWin32Sink();
+    return MouseButtonUpInWindow(*sink, windowHandle, x, y, button);
+}
+
+Result<bool> MouseButtonUpInWindow(InputDispatcher::InputSink& sink, HWND windowHandle, int x, int y,
+                                   MouseButton button) {
+    // 释放消息的 MK_* 为释放后的状态，不含该按键（见 InputDispatcher::ToWindowMessage）
+    return SendEvent(sink, windowHandle, InputDispatcher::InputEvent::ButtonUp(x, y, button));
 }
 
 // ============ 窗口内移动操作 ============
 
+Result<bool> MoveInWindow(HWND windowHandle, int endX, int endY) {
+    auto sink = InputDispatcher::CreateWin32Sink();
+    return MoveInWindow(*sink, windowHandle, endX, endY);
+}
+
+Result<bool> MoveInWindow(InputDispatcher::InputSink& sink, HWND windowHandle, int endX, int endY) {
+    return SendEvent(sink, windowHandle, InputDispatcher::InputEvent::MouseMove(endX, endY));
+}
+
 Result<bool> MoveInWindow(HWND windowHandle, int endX, int endY, MouseButton button) {
-    if (!IsWindow(windowHandle)) {
-        return Result<bool>::Error(ErrorCode::INVALID_HANDLE, L"Invalid window handle");
-    }
-    
-    // 发送鼠标移动消息
-    WPARAM wParam = BuildMouseWParam(button);
-    LPARAM lParam = MakeLParam(endX, endY);
-    
-    SendMessage(windowHandle, WM_MOUSEMOVE, wParam, lParam);
-    
-    return Result<bool>::Success(true);
+    auto sink = InputDispatcher::CreateWin32Sink();
+    return MoveInWindow(*sink, windowHandle, endX, endY, button);
+}
+
+Result<bool> MoveInWindow(InputDispatcher::InputSink& sink, HWND windowHandle, int endX, int endY,
+                          MouseButton button) {
+    return SendEvent(sink, windowHandle, InputDispatcher::InputEvent::MouseMove(endX, endY, button));
+}
+
+// ============ 窗口内轨迹移动与拖拽 ============
+
+Result<int> MoveAlongPathInWindow(InputDispatcher::InputSink& sink, HWND windowHandle, const MousePath::Path& path) {
+    return MousePath::PlayMove(sink, windowHandle, path);
+}
+
+Result<int> MoveAlongPathInWindow(InputDispatcher::InputSink& sink, HWND windowHandle, const MousePath::Path& path,
+                                  MouseButton button) {
+    return MousePath::PlayMove(sink, windowHandle, path, button);
+}
+
+Result<int> DragAlongPathInWindow(InputDispatcher::InputSink& sink, HWND windowHandle, const MousePath::Path& path,
+                                  MouseButton button) {
+    return MousePath::PlayDrag(sink, windowHandle, path, button);
 }
 
 // ============ 窗口内滚轮操作 ============
 
 Result<bool> ScrollInWindow(HWND windowHandle, int x, int y, int delta) {
-    if (!IsWindow(windowHandle)) {
-        return Result<bool>::Error(ErrorCode::INVALID_HANDLE, L"Invalid window handle");
-    }
-    
-    // 发送滚轮消息
-    WPARAM wParam = MAKEWPARAM(0, delta * WHEEL_DELTA);
-    LPARAM lParam = MakeLParam(x, y);
-    
-    SendMessage(windowHandle, WM_MOUSEWHEEL, wParam, lParam);
-    
-    return Result<bool>::Success(true);
+    auto sink = InputDispatcher::CreateWin32Sink();
+    return ScrollInWindow(*sink, windowHandle, x, y, delta);
+}
+
+Result<bool> ScrollInWindow(InputDispatcher::InputSink& sink, HWND windowHandle, int x, int y, int delta) {
+    return SendEvent(sink, windowHandle, InputDispatcher::InputEvent::Wheel(x, y, delta));
 }
 
 }  // namespace MouseSimulator
\ No newline at end of file
@@ -0,0 +1,727 @@
+#include "../include/PixelConvert.h"
+#include "CpuFeatures.h"
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef WINDOWSAPI_X86
+#include <immintrin.h>
+#endif
+
+namespace PixelConvert {
+
+// 内部辅助函数
+namespace {
+    // 转换一行像素
+    using RowKernel = void (*)(const std::uint8_t* src, std::uint8_t* dst, int width);
+
+    // 灰度权重（整数近似 BT.601，和为 256）
+    const int kWeightB = 29;
+    const int kWeightG = 150;
+    const int kWeightR = 77;
+
+    inline std::uint8_t GrayOf(const std::uint8_t* p) {
+        return static_cast<std::uint8_t>((kWeightB * p[0] + kWeightG * p[1] + kWeightR * p[2] + 128) >> 8);
+    }
+
+    // c * a / 255 四舍五入的无除法形式，SIMD 路径使用同一公式
+    inline std::uint8_t MultiplyAlpha(int c, int a) {
+        int t = c * a + 128;
+        return static_cast<std::uint8_t>((t + (t >> 8)) >> 8);
+    }
+
+    // ---------- 标量实现（也用于处理 SIMD 循环剩下的尾部） ----------
+
+    void SwapRedBlueScalar(const std::uint8_t* src, std::uint8_t* dst, int width) {
+        for (int x = 0; x < width; x++) {
+            std::uint8_t b = src[x * 4];
+            std::uint8_t g = src[x * 4 + 1];
+            std::uint8_t r = src[x * 4 + 2];
+            std::uint8_t a = src[x * 4 + 3];
+            dst[x * 4] = r;
+            dst[x * 4 + 1] = g;
+            dst[x * 4 + 2] = b;
+            dst[x * 4 + 3] = a;
+        }
+    }
+
+    void BgraToRgbScalar(const std::uint8_t* src, std::uint8_t* dst, int width) {
+        for (int x = 0; x < width; x++) {
+            std::uint8_t b = src[x * 4];
+            std::uint8_t g = src[x * 4 + 1];
+            std::uint8_t r = src[x * 4 + 2];
+            dst[x * 3] = r;
+            dst[x * 3 + 1] = g;
+            dst[x * 3 + 2] = b;
+        }
+    }
+
+    void BgraToGrayScalar(const std::uint8_t* src, std::uint8_t* dst, int width) {
+        for (int x = 0; x < width; x++) {
+            dst[x] = GrayOf(src + x * 4);
+        }
+    }
+
+    void GrayToBgraScalar(const std::uint8_t* src, std::uint8_t* dst, int width) {
+        for (int x = 0; x < width; x++) {
+            std::uint8_t v = src[x];
+            dst[x * 4] = v;
+            dst[x * 4 + 1] = v;
+            dst[x * 4 + 2] = v;
+            dst[x * 4 + 3] = 255;
+        }
+    }
+
+    void PremultiplyScalar(const std::uint8_t* src, std::uint8_t* dst, int width) {
+        for (int x = 0; x < width; x++) {
+            int a = src[x * 4 + 3];
+            dst[x * 4] = MultiplyAlpha(src[x * 4], a);
+            dst[x * 4 + 1] = MultiplyAlpha(src[x * 4 + 1], a);
+            dst[x * 4 + 2] = MultiplyAlpha(src[x * 4 + 2], a);
+            dst[x * 4 + 3] = static_cast<std::uint8_t>(a);
+        }
+    }
+
+    void BgraToRgb565Scalar(const std::uint8_t* src, std::uint8_t* dst, int width) {
+        for (int x = 0; x < width; x++) {
+            const std::uint8_t* p = src + x * 4;
+            unsigned v = ((p[2] >> 3) << 11) | ((p[1] >> 2) << 5) | (p[0] >> 3);
+            dst[x * 2] = static_cast<std::uint8_t>(v);
+            dst[x * 2 + 1] = static_cast<std::uint8_t>(v >> 8);
+        }
+    }
+
+    // 5/6 位分量扩展到 8 位时高位复制到低位，使 0 和最大值分别映射到 0 和 255
+    void Rgb565ToBgraScalar(const std::uint8_t* src, std::uint8_t* dst, int width) {
+        for (int x = 0; x < width; x++) {
+            unsigned v = src[x * 2] | (src[x * 2 + 1] << 8);
+            unsigned r = (v >> 11) & 0x1F;
+            unsigned g = (v >> 5) & 0x3F;
+            unsigned b = v & 0x1F;
+            dst[x * 4] = static_cast<std::uint8_t>((b << 3) | (b >> 2));
+            dst[x * 4 + 1] = static_cast<std::uint8_t>((g << 2) | (g >> 4));
+            dst[x * 4 + 2] = static_cast<std::uint8_t>((r << 3) | (r >> 2));
+            dst[x * 4 + 3] = 255;
+        }
+    }
+
+    // 把 count 个 8 位值按阈值打包为位（值 >= threshold 为 1），最后一个字节未用的位清零
+    using PackKernel = void (*)(const std::uint8_t* values, int count, std::uint8_t threshold, std::uint8_t* dst);
+
+    void PackBitsScalar(const std::uint8_t* values, int count, std::uint8_t threshold, std::uint8_t* dst) {
+        for (int x = 0; x < count; x += 8) {
+            int bits = std::min(8, count - x);
+            unsigned byte = 0;
+            for (int bit = 0; bit < bits; bit++) {
+                byte = (byte << 1) | (values[x + bit] >= threshold ? 1u : 0u);
+            }
+            dst[x / 8] = static_cast<std::uint8_t>(byte << (8 - bits));
+        }
+    }
+
+    void Mono1ToGrayScalar(const std::uint8_t* src, std::uint8_t* dst, int width) {
+        for (int x = 0; x < width; x++) {
+            dst[x] = ((src[x >> 3] >> (7 - (x & 7))) & 1) ? 255 : 0;
+        }
+    }
+
+    void Mono1ToBgraScalar(const std::uint8_t* src, std::uint8_t* dst, int width) {
+        for (int x = 0; x < width; x++) {
+            std::uint8_t v = ((src[x >> 3] >> (7 - (x & 7))) & 1) ? 255 : 0;
+            dst[x * 4] = v;
+            dst[x * 4 + 1] = v;
+            dst[x * 4 + 2] = v;
+            dst[x * 4 + 3] = 255;
+        }
+    }
+
+#ifdef WINDOWSAPI_X86
+    // ---------- SSSE3 ----------
+    // 每次迭代先读后写，且写入位置不超过已读取的位置，因此原地转换安全
+
+    WINDOWSAPI_TARGET("ssse3")
+    void SwapRedBlueSSSE3(const std::uint8_t* src, std::uint8_t* dst, int width) {
+        const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+        int x = 0;
+        for (; x + 4 <= width; x += 4) {
+            __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x * 4));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 4), _mm_shuffle_epi8(px, shuffle));
+        }
+        SwapRedBlueScalar(src + x * 4, dst + x * 4, width - x);
+    }
+
+    WINDOWSAPI_TARGET("ssse3")
+    void BgraToRgbSSSE3(const std::uint8_t* src, std::uint8_t* dst, int width) {
+        const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+        int x = 0;
+        // 每次写16字节、有效12字节，保证最后一次写入不越过行尾
+        for (; x + 6 <= width; x += 4) {
+            __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x * 4));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 3), _mm_shuffle_epi8(px, shuffle));
+        }
+        BgraToRgbScalar(src + x * 4, dst + x * 3, width - x);
+    }
+
+    WINDOWSAPI_TARGET("ssse3")
+    __m128i GraySums4SSSE3(__m128i px, __m128i weights, __m128i zero) {
+        // 每像素 (29B + 150G) 与 (77R + 0A) 两个32位部分和，再水平相加
+        __m128i lo = _mm_madd_epi16(_mm_unpacklo_epi8(px, zero), weights);
+        __m128i hi = _mm_madd_epi16(_mm_unpackhi_epi8(px, zero), weights);
+        return _mm_hadd_epi32(lo, hi);
+    }
+
+    WINDOWSAPI_TARGET("ssse3")
+    void BgraToGraySSSE3(const std::uint8_t* src, std::uint8_t* dst, int width) {
+        const __m128i weights = _mm_setr_epi16(kWeightB, kWeightG, kWeightR, 0, kWeightB, kWeightG, kWeightR, 0);
+        const __m128i round = _mm_set1_epi32(128);
+        const __m128i zero = _mm_setzero_si128();
+        int x = 0;
+        for (; x + 16 <= width; x += 16) {
+            const __m128i* in = reinterpret_cast<const __m128i*>(src + x * 4);
+            __m128i s0 = _mm_srli_epi32(_mm_add_epi32(GraySums4SSSE3(_mm_loadu_si128(in), weights, zero), round), 8);
+            __m128i s1 = _mm_srli_epi32(_mm_add_epi32(GraySums4SSSE3(_mm_loadu_si128(in + 1), weights, zero), round), 8);
+            __m128i s2 = _mm_srli_epi32(_mm_add_epi32(GraySums4SSSE3(_mm_loadu_si128(in + 2), weights, zero), round), 8);
+            __m128i s3 = _mm_srli_epi32(_mm_add_epi32(GraySums4SSSE3(_mm_loadu_si128(in + 3), weights, zero), round), 8);
+            __m128i packed = _mm_packus_epi16(_mm_packs_epi32(s0, s1), _mm_packs_epi32(s2, s3));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), packed);
+        }
+        BgraToGrayScalar(src + x * 4, dst + x, width - x);
+    }
+
+    WINDOWSAPI_TARGET("ssse3")
+    void GrayToBgraSSSE3(const std::uint8_t* src, std::uint8_t* dst, int width) {
+        const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+        const __m128i spread0 = _mm_setr_epi8(0, 0, 0, -1, 1, 1, 1, -1, 2, 2, 2, -1, 3, 3, 3, -1);
+        const __m128i spread1 = _mm_setr_epi8(4, 4, 4, -1, 5, 5, 5, -1, 6, 6, 6, -1, 7, 7, 7, -1);
+        const __m128i spread2 = _mm_setr_epi8(8, 8, 8, -1, 9, 9, 9, -1, 10, 10, 10, -1, 11, 11, 11, -1);
+        const __m128i spread3 = _mm_setr_epi8(12, 12, 12, -1, 13, 13, 13, -1, 14, 14, 14, -1, 15, 15, 15, -1);
+        int x = 0;
+        for (; x + 16 <= width; x += 16) {
+            __m128i gray = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x));
+            __m128i* out = reinterpret_cast<__m128i*>(dst + x * 4);
+            _mm_storeu_si128(out, _mm_or_si128(_mm_shuffle_epi8(gray, spread0), alpha));
+            _mm_storeu_si128(out + 1, _mm_or_si128(_mm_shuffle_epi8(gray, spread1), alpha));
+            _mm_storeu_si128(out + 2, _mm_or_si128(_mm_shuffle_epi8(gray, spread2), alpha));
+            _mm_storeu_si128(out + 3, _mm_or_si128(_mm_shuffle_epi8(gray, spread3), alpha));
+        }
+        GrayToBgraScalar(src + x, dst + x * 4, width - x);
+    }
+
+    WINDOWSAPI_TARGET("ssse3")
+    __m128i MultiplyAlpha8SSSE3(__m128i channels, __m128i alphaShuffle, __m128i round) {
+        // channels 为两个像素的16位通道；alpha 广播到同一像素的4个通道
+        __m128i alpha = _mm_shuffle_epi8(channels, alphaShuffle);
+        __m128i t = _mm_add_epi16(_mm_mullo_epi16(channels, alpha), round);
+        return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+    }
+
+    WINDOWSAPI_TARGET("ssse3")
+    void PremultiplySSSE3(const std::uint8_t* src, std::uint8_t* dst, int width) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i round = _mm_set1_epi16(128);
+        const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+        const __m128i alphaShuffle = _mm_setr_epi8(6, 7, 6, 7, 6, 7, 6, 7, 14, 15, 14, 15, 14, 15, 14, 15);
+        int x = 0;
+        for (; x + 4 <= width; x += 4) {
+            __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x * 4));
+            __m128i lo = MultiplyAlpha8SSSE3(_mm_unpacklo_epi8(px, zero), alphaShuffle, round);
+            __m128i hi = MultiplyAlpha8SSSE3(_mm_unpackhi_epi8(px, zero), alphaShuffle, round);
+            // 颜色通道取预乘结果，Alpha 通道保持原值
+            __m128i result = _mm_or_si128(_mm_andnot_si128(alphaMask, _mm_packus_epi16(lo, hi)),
+                                          _mm_and_si128(px, alphaMask));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 4), result);
+        }
+        PremultiplyScalar(src + x * 4, dst + x * 4, width - x);
+    }
+
+    WINDOWSAPI_TARGET("ssse3")
+    void BgraToRgb565SSSE3(const std::uint8_t* src, std::uint8_t* dst, int width) {
+        const __m128i maskR = _mm_set1_epi32(0xF800);
+        const __m128i maskG = _mm_set1_epi32(0x07E0);
+        const __m128i maskB = _mm_set1_epi32(0x001F);
+        int x = 0;
+        for (; x + 8 <= width; x += 8) {
+            __m128i v[2];
+            for (int k = 0; k < 2; k++) {
+                __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + (x + k * 4) * 4));
+                __m128i rgb = _mm_or_si128(_mm_or_si128(_mm_and_si128(_mm_srli_epi32(px, 8), maskR),
+                                                        _mm_and_si128(_mm_srli_epi32(px, 5), maskG)),
+                                           _mm_and_si128(_mm_srli_epi32(px, 3), maskB));
+                // 有符号饱和打包前先做符号扩展，使16位值原样保留
+                v[k] = _mm_srai_epi32(_mm_slli_epi32(rgb, 16), 16);
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 2), _mm_packs_epi32(v[0], v[1]));
+        }
+        BgraToRgb565Scalar(src + x * 4, dst + x * 2, width - x);
+    }
+
+    WINDOWSAPI_TARGET("ssse3")
+    __m128i ExpandRgb565SSSE3(__m128i v) {
+        // v 为 4 个 32 位通道，每个通道低 16 位是一个 RGB565 像素
+        __m128i r = _mm_and_si128(_mm_srli_epi32(v, 11), _mm_set1_epi32(0x1F));
+        __m128i g = _mm_and_si128(_mm_srli_epi32(v, 5), _mm_set1_epi32(0x3F));
+        __m128i b = _mm_and_si128(v, _mm_set1_epi32(0x1F));
+        r = _mm_or_si128(_mm_slli_epi32(r, 3), _mm_srli_epi32(r, 2));
+        g = _mm_or_si128(_mm_slli_epi32(g, 2), _mm_srli_epi32(g, 4));
+        b = _mm_or_si128(_mm_slli_epi32(b, 3), _mm_srli_epi32(b, 2));
+        return _mm_or_si128(_mm_or_si128(b, _mm_slli_epi32(g, 8)),
+                            _mm_or_si128(_mm_slli_epi32(r, 16), _mm_set1_epi32(static_cast<int>(0xFF000000u))));
+    }
+
+    WINDOWSAPI_TARGET("ssse3")
+    void Rgb565ToBgraSSSE3(const std::uint8_t* src, std::uint8_t* dst, int width) {
+        const __m128i zero = _mm_setzero_si128();
+        int x = 0;
+        for (; x + 8 <= width; x += 8) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x * 2));
+            __m128i* out = reinterpret_cast<__m128i*>(dst + x * 4);
+            _mm_storeu_si128(out, ExpandRgb565SSSE3(_mm_unpacklo_epi16(v, zero)));
+            _mm_storeu_si128(out + 1, ExpandRgb565SSSE3(_mm_unpackhi_epi16(v, zero)));
+        }
+        Rgb565ToBgraScalar(src + x * 2, dst + x * 4, width - x);
+    }
+
+    WINDOWSAPI_TARGET("ssse3")
+    void PackBitsSSSE3(const std::uint8_t* values, int count, std::uint8_t threshold, std::uint8_t* dst) {
+        const __m128i limit = _mm_set1_epi8(static_cast<char>(threshold));
+        // 每8字节内部倒序，movemask 得到的每个字节即为高位在前的像素位
+        const __m128i reverse = _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+        int x = 0;
+        for (; x + 16 <= count; x += 16) {
+            __m128i v = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(values + x)), reverse);
+            // v >= threshold 等价于 max(v, threshold) == v
+            std::uint16_t mask = static_cast<std::uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(v, limit), v)));
+            std::memcpy(dst + x / 8, &mask, sizeof(mask));
+        }
+        PackBitsScalar(values + x, count - x, threshold, dst + x / 8);
+    }
+
+    // ---------- AVX2 ----------
+
+    WINDOWSAPI_TARGET("avx2")
+    void SwapRedBlueAVX2(const std::uint8_t* src, std::uint8_t* dst, int width) {
+        const __m256i shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+                                                 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+        int x = 0;
+        for (; x + 8 <= width; x += 8) {
+            __m256i px = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + x * 4));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + x * 4), _mm256_shuffle_epi8(px, shuffle));
+        }
+        SwapRedBlueSSSE3(src + x * 4, dst + x * 4, width - x);
+    }
+
+    WINDOWSAPI_TARGET("avx2")
+    void BgraToRgbAVX2(const std::uint8_t* src, std::uint8_t* dst, int width) {
+        const __m256i shuffle = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                                 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+        // 两个128位通道各有12字节有效数据，合并为连续的24字节
+        const __m256i compact = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7);
+        int x = 0;
+        for (; x + 11 <= width; x += 8) {
+            __m256i px = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + x * 4));
+            __m256i rgb = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(px, shuffle), compact);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + x * 3), rgb);
+        }
+        BgraToRgbSSSE3(src + x * 4, dst + x * 3, width - x);
+    }
+
+    WINDOWSAPI_TARGET("avx2")
+    __m256i GraySums8AVX2(__m256i px, __m256i weights, __m256i zero) {
+        __m256i lo = _mm256_madd_epi16(_mm256_unpacklo_epi8(px, zero), weights);
+        __m256i hi = _mm256_madd_epi16(_mm256_unpackhi_epi8(px, zero), weights);
+        // 通道内 unpack/hadd 后像素顺序恢复为 0..7
+        return _mm256_hadd_epi32(lo, hi);
+    }
+
+    WINDOWSAPI_TARGET("avx2")
+    void BgraToGrayAVX2(const std::uint8_t* src, std::uint8_t* dst, int width) {
+        const __m256i weights = _mm256_setr_epi16(kWeightB, kWeightG, kWeightR, 0, kWeightB, kWeightG, kWeightR, 0,
+                                                  kWeightB, kWeightG, kWeightR, 0, kWeightB, kWeightG, kWeightR, 0);
+        const __m256i round = _mm256_set1_epi32(128);
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+        int x = 0;
+        for (; x + 32 <= width; x += 32) {
+            const __m256i* in = reinterpret_cast<const __m256i*>(src + x * 4);
+            __m256i s0 = _mm256_srli_epi32(_mm256_add_epi32(GraySums8AVX2(_mm256_loadu_si256(in), weights, zero), round), 8);
+            __m256i s1 = _mm256_srli_epi32(_mm256_add_epi32(GraySums8AVX2(_mm256_loadu_si256(in + 1), weights, zero), round), 8);
+            __m256i s2 = _mm256_srli_epi32(_mm256_add_epi32(GraySums8AVX2(_mm256_loadu_si256(in + 2), weights, zero), round), 8);
+            __m256i s3 = _mm256_srli_epi32(_mm256_add_epi32(GraySums8AVX2(_mm256_loadu_si256(in + 3), weights, zero), round), 8);
+            // 打包在各128位通道内进行，最后按 4 字节一组重排回像素顺序
+            __m256i packed = _mm256_packus_epi16(_mm256_packs_epi32(s0, s1), _mm256_packs_epi32(s2, s3));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + x), _mm256_permutevar8x32_epi32(packed, order));
+        }
+        BgraToGraySSSE3(src + x * 4, dst + x, width - x);
+    }
+
+    WINDOWSAPI_TARGET("avx2")
+    void GrayToBgraAVX2(const std::uint8_t* src, std::uint8_t* dst, int width) {
+        const __m256i alpha = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+        const __m256i spreadLow = _mm256_setr_epi8(0, 0, 0, -1, 1, 1, 1, -1, 2, 2, 2, -1, 3, 3, 3, -1,
+                                                   4, 4, 4, -1, 5, 5, 5, -1, 6, 6, 6, -1, 7, 7, 7, -1);
+        const __m256i spreadHigh = _mm256_setr_epi8(8, 8, 8, -1, 9, 9, 9, -1, 10, 10, 10, -1, 11, 11, 11, -1,
+                                                    12, 12, 12, -1, 13, 13, 13, -1, 14, 14, 14, -1, 15, 15, 15, -1);
+        int x = 0;
+        for (; x + 16 <= width; x += 16) {
+            // 16个灰度值复制到两个128位通道，再分别展开
+            __m256i gray = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x)));
+            __m256i* out = reinterpret_cast<__m256i*>(dst + x * 4);
+            _mm256_storeu_si256(out, _mm256_or_si256(_mm256_shuffle_epi8(gray, spreadLow), alpha));
+            _mm256_storeu_si256(out + 1, _mm256_or_si256(_mm256_shuffle_epi8(gray, spreadHigh), alpha));
+        }
+        GrayToBgraSSSE3(src + x, dst + x * 4, width - x);
+    }
+
+    WINDOWSAPI_TARGET("avx2")
+    __m256i MultiplyAlpha16AVX2(__m256i channels, __m256i alphaShuffle, __m256i round) {
+        __m256i alpha = _mm256_shuffle_epi8(channels, alphaShuffle);
+        __m256i t = _mm256_add_epi16(_mm256_mullo_epi16(channels, alpha), round);
+        return _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+    }
+
+    WINDOWSAPI_TARGET("avx2")
+    void PremultiplyAVX2(const std::uint8_t* src, std::uint8_t* dst, int width) {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i round = _mm256_set1_epi16(128);
+        const __m256i alphaMask = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+        const __m256i alphaShuffle = _mm256_setr_epi8(6, 7, 6, 7, 6, 7, 6, 7, 14, 15, 14, 15, 14, 15, 14, 15,
+                                                      6, 7, 6, 7, 6, 7, 6, 7, 14, 15, 14, 15, 14, 15, 14, 15);
+        int x = 0;
+        for (; x + 8 <= width; x += 8) {
+            __m256i px = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + x * 4));
+            __m256i lo = MultiplyAlpha16AVX2(_mm256_unpacklo_epi8(px, zero), alphaShuffle, round);
+            __m256i hi = MultiplyAlpha16AVX2(_mm256_unpackhi_epi8(px, zero), alphaShuffle, round);
+            __m256i result = _mm256_or_si256(_mm256_andnot_si256(alphaMask, _mm256_packus_epi16(lo, hi)),
+                                             _mm256_and_si256(px, alphaMask));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + x * 4), result);
+        }
+        PremultiplySSSE3(src + x * 4, dst + x * 4, width - x);
+    }
+
+    WINDOWSAPI_TARGET("avx2")
+    void BgraToRgb565AVX2(const std::uint8_t* src, std::uint8_t* dst, int width) {
+        const __m256i maskR = _mm256_set1_epi32(0xF800);
+        const __m256i maskG = _mm256_set1_epi32(0x07E0);
+        const __m256i maskB = _mm256_set1_epi32(0x001F);
+        int x = 0;
+        for (; x + 16 <= width; x += 16) {
+            __m256i v[2];
+            for (int k = 0; k < 2; k++) {
+                __m256i px = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + (x + k * 8) * 4));
+                v[k] = _mm256_or_si256(_mm256_or_si256(_mm256_and_si256(_mm256_srli_epi32(px, 8), maskR),
+                                                       _mm256_and_si256(_mm256_srli_epi32(px, 5), maskG)),
+                                       _mm256_and_si256(_mm256_srli_epi32(px, 3), maskB));
+            }
+            // 通道内打包后交换中间两个 64 位块恢复像素顺序
+            __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(v[0], v[1]), 0xD8);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + x * 2), packed);
+        }
+        BgraToRgb565SSSE3(src + x * 4, dst + x * 2, width - x);
+    }
+
+    WINDOWSAPI_TARGET("avx2")
+    __m256i ExpandRgb565AVX2(__m256i v) {
+        __m256i r = _mm256_and_si256(_mm256_srli_epi32(v, 11), _mm256_set1_epi32(0x1F));
+        __m256i g = _mm256_and_si256(_mm256_srli_epi32(v, 5), _mm256_set1_epi32(0x3F));
+        __m256i b = _mm256_and_si256(v, _mm256_set1_epi32(0x1F));
+        r = _mm256_or_si256(_mm256_slli_epi32(r, 3), _mm256_srli_epi32(r, 2));
+        g = _mm256_or_si256(_mm256_slli_epi32(g, 2), _mm256_srli_epi32(g, 4));
+        b = _mm256_or_si256(_mm256_slli_epi32(b, 3), _mm256_srli_epi32(b, 2));
+        return _mm256_or_si256(_mm256_or_si256(b, _mm256_slli_epi32(g, 8)),
+                               _mm256_or_si256(_mm256_slli_epi32(r, 16),
+                                               _mm256_set1_epi32(static_cast<int>(0xFF000000u))));
+    }
+
+    WINDOWSAPI_TARGET("avx2")
+    void Rgb565ToBgraAVX2(const std::uint8_t* src, std::uint8_t* dst, int width) {
+        int x = 0;
+        for (; x + 16 <= width; x += 16) {
+            const __m128i* in = reinterpret_cast<const __m128i*>(src + x * 2);
+            __m256i* out = reinterpret_cast<__m256i*>(dst + x * 4);
+            _mm256_storeu_si256(out, ExpandRgb565AVX2(_mm256_cvtepu16_epi32(_mm_loadu_si128(in))));
+            _mm256_storeu_si256(out + 1, ExpandRgb565AVX2(_mm256_cvtepu16_epi32(_mm_loadu_si128(in + 1))));
+        }
+        Rgb565ToBgraSSSE3(src + x * 2, dst + x * 4, width - x);
+    }
+
+    WINDOWSAPI_TARGET("avx2")
+    void PackBitsAVX2(const std::uint8_t* values, int count, std::uint8_t threshold, std::uint8_t* dst) {
+        const __m256i limit = _mm256_set1_epi8(static_cast<char>(threshold));
+        const __m256i reverse = _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+                                                 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+        int x = 0;
+        for (; x + 32 <= count; x += 32) {
+            __m256i v = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + x)), reverse);
+            std::uint32_t mask = static_cast<std::uint32_t>(
+                _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_max_epu8(v, limit), v)));
+            std::memcpy(dst + x / 8, &mask, sizeof(mask));
+        }
+        PackBitsSSSE3(values + x, count - x, threshold, dst + x / 8);
+    }
+#endif
+
+    enum class Operation {
+        SWAP_RED_BLUE,
+        BGRA_TO_RGB,
+        BGRA_TO_GRAY,
+        GRAY_TO_BGRA,
+        BGRA_TO_RGB565,
+        RGB565_TO_BGRA,
+        MONO1_TO_GRAY,
+        MONO1_TO_BGRA,
+        PREMULTIPLY
+    };
+
+    // 按 CPU 能力选择内核；只有 SSE2 时使用标量实现（洗牌指令需要 SSSE3）。
+    // MONO1 展开只用于调试显示，只有标量实现
+    RowKernel SelectKernel(Operation operation) {
+#ifdef WINDOWSAPI_X86
+        CpuFeatures::SimdLevel level = CpuFeatures::GetSimdLevel();
+        if (level == CpuFeatures::SimdLevel::AVX2) {
+            switch (operation) {
+                case Operation::SWAP_RED_BLUE: return SwapRedBlueAVX2;
+                case Operation::BGRA_TO_RGB: return BgraToRgbAVX2;
+                case Operation::BGRA_TO_GRAY: return BgraToGrayAVX2;
+                case Operation::GRAY_TO_BGRA: return GrayToBgraAVX2;
+                case Operation::BGRA_TO_RGB565: return BgraToRgb565AVX2;
+                case Operation::RGB565_TO_BGRA: return Rgb565ToBgraAVX2;
+                case Operation::PREMULTIPLY: return PremultiplyAVX2;
+                default: break;
+            }
+        }
+        if (level == CpuFeatures::SimdLevel::SSSE3) {
+            switch (operation) {
+                case Operation::SWAP_RED_BLUE: return SwapRedBlueSSSE3;
+                case Operation::BGRA_TO_RGB: return BgraToRgbSSSE3;
+                case Operation::BGRA_TO_GRAY: return BgraToGraySSSE3;
+                case Operation::GRAY_TO_BGRA: return GrayToBgraSSSE3;
+                case Operation::BGRA_TO_RGB565: return BgraToRgb565SSSE3;
+                case Operation::RGB565_TO_BGRA: return Rgb565ToBgraSSSE3;
+                case Operation::PREMULTIPLY: return PremultiplySSSE3;
+                default: break;
+            }
+        }
+#endif
+        switch (operation) {
+            case Operation::SWAP_RED_BLUE: return SwapRedBlueScalar;
+            case Operation::BGRA_TO_RGB: return BgraToRgbScalar;
+            case Operation::BGRA_TO_GRAY: return BgraToGrayScalar;
+            case Operation::GRAY_TO_BGRA: return GrayToBgraScalar;
+            case Operation::BGRA_TO_RGB565: return BgraToRgb565Scalar;
+            case Operation::RGB565_TO_BGRA: return Rgb565ToBgraScalar;
+            case Operation::MONO1_TO_GRAY: return Mono1ToGrayScalar;
+            case Operation::MONO1_TO_BGRA: return Mono1ToBgraScalar;
+            default: return PremultiplyScalar;
+        }
+    }
+
+    PackKernel SelectPackKernel() {
+#ifdef WINDOWSAPI_X86
+        switch (CpuFeatures::GetSimdLevel()) {
+            case CpuFeatures::SimdLevel::AVX2: return PackBitsAVX2;
+            case CpuFeatures::SimdLevel::SSSE3: return PackBitsSSSE3;
+            default: break;
+        }
+#endif
+        return PackBitsScalar;
+    }
+
+    // 查找格式对对应的转换操作（相同格式与生成 MONO1 不在此列）
+    bool FindOperation(PixelFormat source, PixelFormat target, Operation& operation) {
+        if (source == PixelFormat::BGRA32 && target == PixelFormat::RGB24) {
+            operation = Operation::BGRA_TO_RGB;
+        } else if ((source == PixelFormat::BGRA32 && target == PixelFormat::RGBA32) ||
+                   (source == PixelFormat::RGBA32 && target == PixelFormat::BGRA32)) {
+            operation = Operation::SWAP_RED_BLUE;
+        } else if (source == PixelFormat::BGRA32 && target == PixelFormat::GRAY8) {
+            operation = Operation::BGRA_TO_GRAY;
+        } else if (source == PixelFormat::GRAY8 && target == PixelFormat::BGRA32) {
+            operation = Operation::GRAY_TO_BGRA;
+        } else if (source == PixelFormat::BGRA32 && target == PixelFormat::RGB565) {
+            operation = Operation::BGRA_TO_RGB565;
+        } else if (source == PixelFormat::RGB565 && target == PixelFormat::BGRA32) {
+            operation = Operation::RGB565_TO_BGRA;
+        } else if (source == PixelFormat::MONO1 && target == PixelFormat::GRAY8) {
+            operation = Operation::MONO1_TO_GRAY;
+        } else if (source == PixelFormat::MONO1 && target == PixelFormat::BGRA32) {
+            operation = Operation::MONO1_TO_BGRA;
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    // 能否生成 MONO1 掩码
+    bool CanPack(PixelFormat source, MaskChannel channel) {
+        if (channel == MaskChannel::ALPHA) {
+            return source == PixelFormat::BGRA32 || source == PixelFormat::RGBA32;
+        }
+        return source == PixelFormat::BGRA32 || source == PixelFormat::GRAY8;
+    }
+
+    // 按通道阈值逐行打包为 MONO1；BGRA 先分块求出亮度或 Alpha，再统一打包
+    void PackRows(const ImageView& source, MaskChannel channel, std::uint8_t threshold,
+                  std::uint8_t* destination, int destinationStride) {
+        const int chunk = 256;  // 8 的倍数，保证每块从整字节开始
+        PackKernel pack = SelectPackKernel();
+        RowKernel toGray = SelectKernel(Operation::BGRA_TO_GRAY);
+        std::uint8_t values[chunk];
+
+        for (int y = 0; y < source.height; y++) {
+            const std::uint8_t* row = source.Row(y);
+            std::uint8_t* out = destination + static_cast<std::ptrdiff_t>(y) * destinationStride;
+            if (source.format == PixelFormat::GRAY8) {
+                pack(row, source.width, threshold, out);
+                continue;
+            }
+            for (int x = 0; x < source.width; x += chunk) {
+                int count = std::min(chunk, source.width - x);
+                if (channel == MaskChannel::ALPHA) {
+                    for (int i = 0; i < count; i++) {
+                        values[i] = row[(x + i) * 4 + 3];
+                    }
+                } else {
+                    toGray(row + x * 4, values, count);
+                }
+                pack(values, count, threshold, out + x / 8);
+            }
+        }
+    }
+
+    // 校验目标缓冲区；与源重叠时只允许原地收缩
+    Result<bool> ValidateDestination(const ImageView& source, PixelFormat target,
+                                     const std::uint8_t* destination, int destinationStride) {
+        if (source.IsEmpty()) {
+            return Result<bool>::Error(ErrorCode::INVALID_PARAMETER, L"Empty source image");
+        }
+        if (!destination || destinationStride < GetRowBytes(source.width, target)) {
+            return Result<bool>::Error(ErrorCode::INVALID_PARAMETER, L"Destination buffer is too small");
+        }
+        if (destination == source.data &&
+            (GetBitsPerPixel(target) > source.BitsPerPixel() || destinationStride > source.stride)) {
+            return Result<bool>::Error(ErrorCode::INVALID_PARAMETER, L"Conversion cannot run in place");
+        }
+        return Result<bool>::Success(true);
+    }
+
+    // 原地转换后收紧 ImageData：行跨度按4字节对齐，行尾填充清零，释放多余的容量
+    void ShrinkTo(ImageData& image, PixelFormat format) {
+        int stride = GetAlignedStride(image.width, format);
+        int rowBytes = GetRowBytes(image.width, format);
+        for (int y = 0; y < image.height; y++) {
+            std::memset(&image.data[static_cast<size_t>(y) * stride + rowBytes], 0, stride - rowBytes);
+        }
+        image.format = format;
+        image.bitsPerPixel = GetBitsPerPixel(format);
+        image.stride = stride;
+        image.data.resize(static_cast<size_t>(stride) * image.height);
+        image.data.shrink_to_fit();
+    }
+}
+
+// ============ 格式转换 ============
+
+bool IsSupported(PixelFormat source, PixelFormat target) {
+    Operation operation;
+    return (source == target && source != PixelFormat::UNKNOWN) || FindOperation(source, target, operation) ||
+           (target == PixelFormat::MONO1 && CanPack(source, MaskChannel::LUMA));
+}
+
+Result<bool> ConvertRows(const ImageView& source, PixelFormat target,
+                         std::uint8_t* destination, int destinationStride) {
+    if (!IsSupported(source.format, target)) {
+        return Result<bool>::Error(ErrorCode::INVALID_PARAMETER, L"Unsupported pixel format conversion");
+    }
+    auto valid = ValidateDestination(source, target, destination, destinationStride);
+    if (valid.IsError()) {
+        return valid;
+    }
+
+    if (source.format == target) {
+        size_t rowBytes = static_cast<size_t>(GetRowBytes(source.width, target));
+        for (int y = 0; y < source.height; y++) {
+            std::memmove(destination + static_cast<std::ptrdiff_t>(y) * destinationStride, source.Row(y), rowBytes);
+        }
+        return Result<bool>::Success(true);
+    }
+
+    if (target == PixelFormat::MONO1) {
+        PackRows(source, MaskChannel::LUMA, 128, destination, destinationStride);
+        return Result<bool>::Success(true);
+    }
+
+    Operation operation;
+    FindOperation(source.format, target, operation);
+    RowKernel kernel = SelectKernel(operation);
+    for (int y = 0; y < source.height; y++) {
+        kernel(source.Row(y), destination + static_cast<std::ptrdiff_t>(y) * destinationStride, source.width);
+    }
+    return Result<bool>::Success(true);
+}
+
+Result<ImageData> Convert(const ImageView& source, PixelFormat target) {
+    if (!IsSupported(source.format, target)) {
+        return Result<ImageData>::Error(ErrorCode::INVALID_PARAMETER, L"Unsupported pixel format conversion");
+    }
+    if (source.IsEmpty()) {
+        return Result<ImageData>::Error(ErrorCode::INVALID_PARAMETER, L"Empty source image");
+    }
+
+    ImageData image(source.width, source.height, target);
+    auto result = ConvertRows(source, target, image.data.data(), image.stride);
+    if (result.IsError()) {
+        return Result<ImageData>::Error(result.GetErrorCode(), result.GetErrorMessage());
+    }
+    return Result<ImageData>::Success(std::move(image));
+}
+
+Result<bool> ConvertInPlace(ImageData& image, PixelFormat target) {
+    ImageView view(image);
+    if (GetBitsPerPixel(target) > view.BitsPerPixel()) {
+        return Result<bool>::Error(ErrorCode::INVALID_PARAMETER, L"Conversion cannot run in place");
+    }
+
+    auto result = ConvertRows(view, target, image.data.data(), GetAlignedStride(image.width, target));
+    if (result.IsError()) {
+        return result;
+    }
+    ShrinkTo(image, target);
+    return result;
+}
+
+Result<ImageData> CreateMask(const ImageView& source, MaskChannel channel, std::uint8_t threshold) {
+    if (source.IsEmpty()) {
+        return Result<ImageData>::Error(ErrorCode::INVALID_PARAMETER, L"Empty source image");
+    }
+    if (!CanPack(source.format, channel)) {
+        return Result<ImageData>::Error(ErrorCode::INVALID_PARAMETER, L"Unsupported mask source");
+    }
+
+    ImageData mask(source.width, source.height, PixelFormat::MONO1);
+    PackRows(source, channel, threshold, mask.data.data(), mask.stride);
+    return Result<ImageData>::Success(std::move(mask));
+}
+
+// ============ Alpha 预乘 ============
+
+Result<bool> PremultiplyRows(const ImageView& source, std::uint8_t* destination, int destinationStride) {
+    if (source.BitsPerPixel() != 32) {
+        return Result<bool>::Error(ErrorCode::INVALID_PARAMETER, L"Premultiply requires a 32-bit format");
+    }
+    auto valid = ValidateDestination(source, source.format, destination, destinationStride);
+    if (valid.IsError()) {
+        return valid;
+    }
+
+    RowKernel kernel = SelectKernel(Operation::PREMULTIPLY);
+    for (int y = 0; y < source.height; y++) {
+        kernel(source.Row(y), destination + static_cast<std::ptrdiff_t>(y) * destinationStride, source.width);
+    }
+    return Result<bool>::Success(true);
+}
+
+Result<bool> PremultiplyInPlace(ImageData& image) {
+    return PremultiplyRows(ImageView(image), image.data.data(), image.stride);
+}
+
+}  // namespace PixelConvert
@@ -0,0 +1,201 @@
+#include "../include/PixelProbe.h"
+#include "CpuFeatures.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+
+#ifdef WINDOWSAPI_X86
+#include <immintrin.h>
+#endif
+
+namespace PixelProbe {
+
+// 内部辅助函数
+namespace {
+    constexpr int LANE_GROUP = 8;  // 补齐粒度（AVX2 一次处理的像素数）
+
+    // 探测点的结构数组视图，count 已补齐到 LANE_GROUP 的倍数
+    struct ProbeArrays {
+        const std::int32_t* offsetX;
+        const std::int32_t* offsetY;
+        const std::uint32_t* colors;
+        const std::uint32_t* tolerances;
+        int count;
+    };
+
+    using ProbeKernel = std::uint64_t (*)(const std::uint8_t* base, std::ptrdiff_t stride, const ProbeArrays& probes);
+
+    inline bool PixelMatches(std::uint32_t pixel, std::uint32_t expected, std::uint32_t tolerance) {
+        for (int c = 0; c < 4; c++) {
+            int a = static_cast<int>((pixel >> (c * 8)) & 0xFF);
+            int b = static_cast<int>((expected >> (c * 8)) & 0xFF);
+            if (std::abs(a - b) > static_cast<int>((tolerance >> (c * 8)) & 0xFF)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    inline std::uint32_t LoadPixel(const std::uint8_t* base, std::ptrdiff_t stride, std::int32_t x, std::int32_t y) {
+        const std::uint8_t* p = base + static_cast<std::ptrdiff_t>(y) * stride + x;
+        return static_cast<std::uint32_t>(p[0]) | (static_cast<std::uint32_t>(p[1]) << 8) |
+               (static_cast<std::uint32_t>(p[2]) << 16) | (static_cast<std::uint32_t>(p[3]) << 24);
+    }
+
+    std::uint64_t EvaluateScalar(const std::uint8_t* base, std::ptrdiff_t stride, const ProbeArrays& probes) {
+        std::uint64_t mask = 0;
+        for (int i = 0; i < probes.count; i++) {
+            std::uint32_t pixel = LoadPixel(base, stride, probes.offsetX[i], probes.offsetY[i]);
+            if (PixelMatches(pixel, probes.colors[i], probes.tolerances[i])) {
+                mask |= 1ull << i;
+            }
+        }
+        return mask;
+    }
+
+#ifdef WINDOWSAPI_X86
+    WINDOWSAPI_TARGET("sse2")
+    std::uint64_t EvaluateSSE2(const std::uint8_t* base, std::ptrdiff_t stride, const ProbeArrays& probes) {
+        const __m128i zero = _mm_setzero_si128();
+        std::uint64_t mask = 0;
+        for (int i = 0; i < probes.count; i += 4) {
+            // SSE2 没有收集指令，逐个装入后统一比较
+            __m128i pixels = _mm_setr_epi32(
+                static_cast<int>(LoadPixel(base, stride, probes.offsetX[i], probes.offsetY[i])),
+                static_cast<int>(LoadPixel(base, stride, probes.offsetX[i + 1], probes.offsetY[i + 1])),
+                static_cast<int>(LoadPixel(base, stride, probes.offsetX[i + 2], probes.offsetY[i + 2])),
+                static_cast<int>(LoadPixel(base, stride, probes.offsetX[i + 3], probes.offsetY[i + 3])));
+            __m128i expected = _mm_loadu_si128(reinterpret_cast<const __m128i*>(probes.colors + i));
+            __m128i tolerance = _mm_loadu_si128(reinterpret_cast<const __m128i*>(probes.tolerances + i));
+            __m128i diff = _mm_or_si128(_mm_subs_epu8(pixels, expected), _mm_subs_epu8(expected, pixels));
+            __m128i same = _mm_cmpeq_epi32(_mm_subs_epu8(diff, tolerance), zero);
+            mask |= static_cast<std::uint64_t>(_mm_movemask_ps(_mm_castsi128_ps(same))) << i;
+        }
+        return mask;
+    }
+
+    WINDOWSAPI_TARGET("avx2")
+    std::uint64_t EvaluateAVX2(const std::uint8_t* base, std::ptrdiff_t stride, const ProbeArrays& probes) {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i rowStride = _mm256_set1_epi32(static_cast<int>(stride));
+        std::uint64_t mask = 0;
+        for (int i = 0; i < probes.count; i += 8) {
+            // 字节偏移 = 行号 * 行跨度 + 列偏移，一次收集8个像素
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(probes.offsetX + i));
+            __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(probes.offsetY + i));
+            __m256i offsets = _mm256_add_epi32(_mm256_mullo_epi32(y, rowStride), x);
+            __m256i pixels = _mm256_i32gather_epi32(reinterpret_cast<const int*>(base), offsets, 1);
+            __m256i expected = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(probes.colors + i));
+            __m256i tolerance = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(probes.tolerances + i));
+            __m256i diff = _mm256_or_si256(_mm256_subs_epu8(pixels, expected), _mm256_subs_epu8(expected, pixels));
+            __m256i same = _mm256_cmpeq_epi32(_mm256_subs_epu8(diff, tolerance), zero);
+            mask |= static_cast<std::uint64_t>(_mm256_movemask_ps(_mm256_castsi256_ps(same))) << i;
+        }
+        return mask;
+    }
+#endif
+
+    // 收集指令使用32位偏移，超出范围时退回逐点读取
+    ProbeKernel SelectKernel(bool offsetsFitInt32) {
+#ifdef WINDOWSAPI_X86
+        switch (CpuFeatures::GetSimdLevel()) {
+            case CpuFeatures::SimdLevel::AVX2:
+                if (offsetsFitInt32) {
+                    return EvaluateAVX2;
+                }
+                return EvaluateSSE2;
+            case CpuFeatures::SimdLevel::SSSE3:
+            case CpuFeatures::SimdLevel::SSE2: return EvaluateSSE2;
+            default: break;
+        }
+#else
+        (void)offsetsFitInt32;
+#endif
+        return EvaluateScalar;
+    }
+
+    std::uint32_t PackChannels(const std::array<std::uint8_t, 4>& channels) {
+        return static_cast<std::uint32_t>(channels[0]) |
+               (static_cast<std::uint32_t>(channels[1]) << 8) |
+               (static_cast<std::uint32_t>(channels[2]) << 16) |
+               (static_cast<std::uint32_t>(channels[3]) << 24);
+    }
+}
+
+// ============ 编译 ============
+
+Result<PixelProbeSet> PixelProbeSet::Compile(const std::vector<Probe>& probes) {
+    if (probes.empty()) {
+        return Result<PixelProbeSet>::Error(ErrorCode::INVALID_PARAMETER, L"No probes given");
+    }
+    if (probes.size() > static_cast<size_t>(MAX_PROBES)) {
+        return Result<PixelProbeSet>::Error(ErrorCode::INVALID_PARAMETER, L"Too many probes (max 64)");
+    }
+
+    PixelProbeSet set;
+    set.m_count = static_cast<int>(probes.size());
+
+    int left = INT_MAX;
+    int top = INT_MAX;
+    int right = INT_MIN;
+    int bottom = INT_MIN;
+    for (const auto& probe : probes) {
+        if (probe.position.x < 0 || probe.position.y < 0) {
+            return Result<PixelProbeSet>::Error(ErrorCode::INVALID_PARAMETER, L"Probe position is negative");
+        }
+        left = std::min(left, probe.position.x);
+        top = std::min(top, probe.position.y);
+        right = std::max(right, probe.position.x + 1);
+        bottom = std::max(bottom, probe.position.y + 1);
+    }
+    set.m_bounds = WindowsAPI::Rectangle(left, top, right, bottom);
+
+    // 补齐的探测点指向外接矩形左上角，结果位在求值后被屏蔽
+    size_t padded = (probes.size() + LANE_GROUP - 1) / LANE_GROUP * LANE_GROUP;
+    set.m_offsetX.assign(padded, 0);
+    set.m_offsetY.assign(padded, 0);
+    set.m_colors.assign(padded, 0);
+    set.m_tolerances.assign(padded, 0);
+    for (size_t i = 0; i < probes.size(); i++) {
+        set.m_offsetX[i] = (probes[i].position.x - left) * 4;
+        set.m_offsetY[i] = probes[i].position.y - top;
+        set.m_colors[i] = PackChannels(probes[i].color);
+        set.m_tolerances[i] = PackChannels(probes[i].tolerance);
+    }
+
+    return Result<PixelProbeSet>::Success(std::move(set));
+}
+
+// ============ 求值 ============
+
+Result<std::uint64_t> PixelProbeSet::Evaluate(const ImageView& frame) const {
+    return Evaluate(frame, Point(0, 0));
+}
+
+Result<std::uint64_t> PixelProbeSet::Evaluate(const ImageView& view, Point viewOrigin) const {
+    if (m_count == 0) {
+        return Result<std::uint64_t>::Error(ErrorCode::INVALID_PARAMETER, L"Probe set is empty");
+    }
+    if (view.IsEmpty() || view.format != PixelFormat::BGRA32) {
+        return Result<std::uint64_t>::Error(ErrorCode::INVALID_PARAMETER, L"View must be non-empty BGRA32");
+    }
+
+    int left = m_bounds.left - viewOrigin.x;
+    int top = m_bounds.top - viewOrigin.y;
+    if (left < 0 || top < 0 || left + m_bounds.width() > view.width || top + m_bounds.height() > view.height) {
+        return Result<std::uint64_t>::Error(ErrorCode::INVALID_PARAMETER, L"View does not cover all probes");
+    }
+
+    // 最远的字节偏移可以用32位表示时才使用收集指令
+    std::int64_t farthest = static_cast<std::int64_t>(m_bounds.height()) * std::llabs(view.stride) +
+                            static_cast<std::int64_t>(m_bounds.width()) * 4;
+    ProbeKernel kernel = SelectKernel(farthest <= INT_MAX);
+
+    ProbeArrays arrays = {m_offsetX.data(), m_offsetY.data(), m_colors.data(), m_tolerances.data(),
+                          static_cast<int>(m_offsetX.size())};
+    std::uint64_t mask = kernel(view.PixelAt(left, top), view.stride, arrays);
+    return Result<std::uint64_t>::Success(mask & GetAllMask());
+}
+
+}  // namespace PixelProbe
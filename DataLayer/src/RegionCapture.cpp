@@ -0,0 +1,158 @@
+#include "../include/RegionCapture.h"
+
+#include <algorithm>
+
+namespace ScreenCapture {
+
+// 内部辅助函数
+namespace {
+    long long Area(const WindowsAPI::Rectangle& rect) {
+        return static_cast<long long>(rect.width()) * rect.height();
+    }
+
+    WindowsAPI::Rectangle Union(const WindowsAPI::Rectangle& a, const WindowsAPI::Rectangle& b) {
+        return WindowsAPI::Rectangle(std::min(a.left, b.left), std::min(a.top, b.top),
+                                     std::max(a.right, b.right), std::max(a.bottom, b.bottom));
+    }
+
+    // 区域换算为抓取结果内的子视图
+    ImageView LocalView(const ImageView& grabbed, const WindowsAPI::Rectangle& grabbedBounds,
+                        const WindowsAPI::Rectangle& region) {
+        WindowsAPI::Rectangle local(region.left - grabbedBounds.left, region.top - grabbedBounds.top,
+                                    region.right - grabbedBounds.left, region.bottom - grabbedBounds.top);
+        return grabbed.Subview(local);
+    }
+
+    bool MatchesBounds(const ImageView& grabbed, const WindowsAPI::Rectangle& bounds) {
+        return !grabbed.IsEmpty() && grabbed.format == PixelFormat::BGRA32 &&
+               grabbed.width == bounds.width() && grabbed.height == bounds.height();
+    }
+
+    std::vector<ImageData> CopyViews(const std::vector<ImageView>& views) {
+        std::vector<ImageData> images;
+        images.reserve(views.size());
+        for (const auto& view : views) {
+            images.push_back(CopyToImageData(view));
+        }
+        return images;
+    }
+}
+
+Result<RegionCapturePlan> PlanRegionCapture(const std::vector<WindowsAPI::Rectangle>& regions,
+                                            int sourceWidth, int sourceHeight, int mergeSlack) {
+    if (regions.empty()) {
+        return Result<RegionCapturePlan>::Error(ErrorCode::INVALID_PARAMETER, L"No regions specified");
+    }
+    if (mergeSlack < 0) {
+        return Result<RegionCapturePlan>::Error(ErrorCode::INVALID_PARAMETER, L"Invalid group merge slack");
+    }
+
+    RegionCapturePlan plan;
+    plan.regions = regions;
+    plan.bounds = regions.front();
+
+    for (size_t i = 0; i < regions.size(); i++) {
+        const auto& region = regions[i];
+        if (region.width() <= 0 || region.height() <= 0) {
+            return Result<RegionCapturePlan>::Error(ErrorCode::INVALID_PARAMETER, L"Invalid region dimensions");
+        }
+
+        // 检查区域是否超出源范围
+        if (region.left < 0 || region.top < 0 || region.right > sourceWidth || region.bottom > sourceHeight) {
+            return Result<RegionCapturePlan>::Error(ErrorCode::INVALID_PARAMETER, L"Region extends beyond window bounds");
+        }
+
+        plan.bounds = Union(plan.bounds, region);
+
+        RegionGroup group;
+        group.bounds = region;
+        group.regions.push_back(i);
+        plan.groups.push_back(std::move(group));
+    }
+
+    // 贪心合并：每次合并多抓取面积最小的两组（区域数通常只有几十个，O(n³) 足够）
+    std::vector<RegionGroup>& groups = plan.groups;
+    while (groups.size() > 1) {
+        size_t bestA = 0;
+        size_t bestB = 0;
+        long long bestWaste = -1;
+        for (size_t a = 0; a < groups.size(); a++) {
+            for (size_t b = a + 1; b < groups.size(); b++) {
+                const long long waste = Area(Union(groups[a].bounds, groups[b].bounds))
+                                      - Area(groups[a].bounds) - Area(groups[b].bounds);
+                if (bestWaste < 0 || waste < bestWaste) {
+                    bestWaste = waste;
+                    bestA = a;
+                    bestB = b;
+                }
+            }
+        }
+        if (bestWaste > mergeSlack) {
+            break;
+        }
+
+        RegionGroup& target = groups[bestA];
+        target.bounds = Union(target.bounds, groups[bestB].bounds);
+        target.regions.insert(target.regions.end(), groups[bestB].regions.begin(), groups[bestB].regions.end());
+        std::sort(target.regions.begin(), target.regions.end());
+        groups.erase(groups.begin() + static_cast<std::ptrdiff_t>(bestB));
+    }
+
+    return Result<RegionCapturePlan>::Success(std::move(plan));
+}
+
+Result<std::vector<ImageView>> GetRegionViews(const RegionCapturePlan& plan, const ImageView& grabbed) {
+    if (!MatchesBounds(grabbed, plan.bounds)) {
+        return Result<std::vector<ImageView>>::Error(ErrorCode::INVALID_PARAMETER, L"Grabbed image does not match plan bounds");
+    }
+
+    std::vector<ImageView> views;
+    views.reserve(plan.regions.size());
+
+    for (const auto& region : plan.regions) {
+        views.push_back(LocalView(grabbed, plan.bounds, region));
+    }
+
+    return Result<std::vector<ImageView>>::Success(std::move(views));
+}
+
+Result<std::vector<ImageData>> ExtractRegions(const RegionCapturePlan& plan, const ImageView& grabbed) {
+    auto viewsResult = GetRegionViews(plan, grabbed);
+    if (viewsResult.IsError()) {
+        return Result<std::vector<ImageData>>::Error(viewsResult.GetErrorCode(), viewsResult.GetErrorMessage());
+    }
+
+    return Result<std::vector<ImageData>>::Success(CopyViews(viewsResult.GetData()));
+}
+
+Result<std::vector<ImageView>> GetGroupedRegionViews(const RegionCapturePlan& plan,
+                                                     const std::vector<ImageView>& groupGrabs) {
+    if (groupGrabs.size() != plan.groups.size()) {
+        return Result<std::vector<ImageView>>::Error(ErrorCode::INVALID_PARAMETER, L"Grab count does not match plan groups");
+    }
+
+    std::vector<ImageView> views(plan.regions.size());
+    for (size_t g = 0; g < plan.groups.size(); g++) {
+        const RegionGroup& group = plan.groups[g];
+        if (!MatchesBounds(groupGrabs[g], group.bounds)) {
+            return Result<std::vector<ImageView>>::Error(ErrorCode::INVALID_PARAMETER, L"Grabbed image does not match group bounds");
+        }
+        for (size_t index : group.regions) {
+            views[index] = LocalView(groupGrabs[g], group.bounds, plan.regions[index]);
+        }
+    }
+
+    return Result<std::vector<ImageView>>::Success(std::move(views));
+}
+
+Result<std::vector<ImageData>> ExtractGroupedRegions(const RegionCapturePlan& plan,
+                                                     const std::vector<ImageView>& groupGrabs) {
+    auto viewsResult = GetGroupedRegionViews(plan, groupGrabs);
+    if (viewsResult.IsError()) {
+        return Result<std::vector<ImageData>>::Error(viewsResult.GetErrorCode(), viewsResult.GetErrorMessage());
+    }
+
+    return Result<std::vector<ImageData>>::Success(CopyViews(viewsResult.GetData()));
+}
+
+}  // namespace ScreenCapture
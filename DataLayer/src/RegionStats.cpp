@@ -0,0 +1,258 @@
+#include "../include/RegionStats.h"
+#include "../include/PixelConvert.h"
+#include "CpuFeatures.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+#ifdef WINDOWSAPI_X86
+#include <immintrin.h>
+#endif
+
+namespace RegionStats {
+
+// 内部辅助函数
+namespace {
+    // 32位取模的和能精确还原矩形和的最大面积
+    const long long kMaxPixels = 0xFFFFFFFFll / 255;
+    // 行内平方和的前缀用32位累加，宽度不能超过该值
+    const int kMaxWidth = static_cast<int>(0xFFFFFFFFll / (255 * 255));
+
+    // 计算一行：sum[x] = sumAbove[x] + 行内前缀和，sumSq 同理（指针都已跳过首列）
+    using RowKernel = void (*)(const std::uint8_t* row, int width, const std::uint32_t* sumAbove,
+                               const std::uint64_t* sumSqAbove, std::uint32_t* sum, std::uint64_t* sumSq);
+
+    void GrayRowTail(const std::uint8_t* row, int begin, int width, std::uint32_t rowSum, std::uint32_t rowSumSq,
+                     const std::uint32_t* sumAbove, const std::uint64_t* sumSqAbove,
+                     std::uint32_t* sum, std::uint64_t* sumSq) {
+        for (int x = begin; x < width; x++) {
+            std::uint32_t v = row[x];
+            rowSum += v;
+            rowSumSq += v * v;
+            sum[x] = sumAbove[x] + rowSum;
+            sumSq[x] = sumSqAbove[x] + rowSumSq;
+        }
+    }
+
+    void GrayRowScalar(const std::uint8_t* row, int width, const std::uint32_t* sumAbove,
+                       const std::uint64_t* sumSqAbove, std::uint32_t* sum, std::uint64_t* sumSq) {
+        GrayRowTail(row, 0, width, 0, 0, sumAbove, sumSqAbove, sum, sumSq);
+    }
+
+    void ChannelRowScalar(const std::uint8_t* row, int width, const std::uint32_t* sumAbove,
+                          const std::uint64_t* sumSqAbove, std::uint32_t* sum, std::uint64_t* sumSq) {
+        std::uint32_t rowSum[4] = {0, 0, 0, 0};
+        std::uint32_t rowSumSq[4] = {0, 0, 0, 0};
+        for (int i = 0; i < width * 4; i += 4) {
+            for (int c = 0; c < 4; c++) {
+                std::uint32_t v = row[i + c];
+                rowSum[c] += v;
+                rowSumSq[c] += v * v;
+                sum[i + c] = sumAbove[i + c] + rowSum[c];
+                sumSq[i + c] = sumSqAbove[i + c] + rowSumSq[c];
+            }
+        }
+    }
+
+#ifdef WINDOWSAPI_X86
+    // 4个32位值的行内前缀和，再加上前面的进位
+    WINDOWSAPI_TARGET("sse2")
+    inline __m128i PrefixSum4(__m128i v, __m128i carry) {
+        v = _mm_add_epi32(v, _mm_slli_si128(v, 4));
+        v = _mm_add_epi32(v, _mm_slli_si128(v, 8));
+        return _mm_add_epi32(v, carry);
+    }
+
+    // 4个32位平方和前缀加上一行的64位值后写出
+    WINDOWSAPI_TARGET("sse2")
+    inline void StoreSquares(__m128i prefix, const std::uint64_t* above, std::uint64_t* out) {
+        const __m128i zero = _mm_setzero_si128();
+        __m128i lo = _mm_add_epi64(_mm_unpacklo_epi32(prefix, zero),
+                                   _mm_loadu_si128(reinterpret_cast<const __m128i*>(above)));
+        __m128i hi = _mm_add_epi64(_mm_unpackhi_epi32(prefix, zero),
+                                   _mm_loadu_si128(reinterpret_cast<const __m128i*>(above + 2)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), lo);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2), hi);
+    }
+
+    WINDOWSAPI_TARGET("sse2")
+    void GrayRowSSE2(const std::uint8_t* row, int width, const std::uint32_t* sumAbove,
+                     const std::uint64_t* sumSqAbove, std::uint32_t* sum, std::uint64_t* sumSq) {
+        const __m128i zero = _mm_setzero_si128();
+        __m128i carry = zero;
+        __m128i carrySq = zero;
+        int x = 0;
+        for (; x + 8 <= width; x += 8) {
+            __m128i words = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(row + x)), zero);
+            for (int half = 0; half < 2; half++) {
+                __m128i v = half == 0 ? _mm_unpacklo_epi16(words, zero) : _mm_unpackhi_epi16(words, zero);
+                // 高16位为0，madd 得到每个值的平方
+                __m128i squares = _mm_madd_epi16(v, v);
+                __m128i prefix = PrefixSum4(v, carry);
+                __m128i prefixSq = PrefixSum4(squares, carrySq);
+                carry = _mm_shuffle_epi32(prefix, 0xFF);
+                carrySq = _mm_shuffle_epi32(prefixSq, 0xFF);
+
+                int i = x + half * 4;
+                __m128i above = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sumAbove + i));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(sum + i), _mm_add_epi32(prefix, above));
+                StoreSquares(prefixSq, sumSqAbove + i, sumSq + i);
+            }
+        }
+        GrayRowTail(row, x, width, static_cast<std::uint32_t>(_mm_cvtsi128_si32(carry)),
+                    static_cast<std::uint32_t>(_mm_cvtsi128_si32(carrySq)), sumAbove, sumSqAbove, sum, sumSq);
+    }
+
+    // 四通道：每个像素的4个通道正好占满一个寄存器，逐像素累加
+    WINDOWSAPI_TARGET("sse2")
+    void ChannelRowSSE2(const std::uint8_t* row, int width, const std::uint32_t* sumAbove,
+                        const std::uint64_t* sumSqAbove, std::uint32_t* sum, std::uint64_t* sumSq) {
+        const __m128i zero = _mm_setzero_si128();
+        __m128i running = zero;
+        __m128i runningSq = zero;
+        for (int x = 0; x < width; x++) {
+            int packed;
+            std::memcpy(&packed, row + x * 4, sizeof(packed));
+            __m128i v = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(packed), zero), zero);
+            running = _mm_add_epi32(running, v);
+            runningSq = _mm_add_epi32(runningSq, _mm_madd_epi16(v, v));
+
+            __m128i above = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sumAbove + x * 4));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(sum + x * 4), _mm_add_epi32(running, above));
+            StoreSquares(runningSq, sumSqAbove + x * 4, sumSq + x * 4);
+        }
+    }
+#endif
+
+    // 行内前缀依赖前一个元素，SSE2 已足够，AVX2 不再单独实现
+    RowKernel SelectKernel(int channels) {
+#ifdef WINDOWSAPI_X86
+        if (CpuFeatures::GetSimdLevel() != CpuFeatures::SimdLevel::SCALAR) {
+            return channels == 4 ? ChannelRowSSE2 : GrayRowSSE2;
+        }
+#endif
+        return channels == 4 ? ChannelRowScalar : GrayRowScalar;
+    }
+}
+
+// ============ 建立与更新 ============
+
+Result<IntegralImage> IntegralImage::Build(const ImageView& frame, ChannelMode mode) {
+    if (frame.IsEmpty()) {
+        return Result<IntegralImage>::Error(ErrorCode::INVALID_PARAMETER, L"Empty image");
+    }
+    bool supported = mode == ChannelMode::GRAY
+        ? (frame.format == PixelFormat::BGRA32 || frame.format == PixelFormat::GRAY8)
+        : (frame.format == PixelFormat::BGRA32 || frame.format == PixelFormat::RGBA32);
+    if (!supported) {
+        return Result<IntegralImage>::Error(ErrorCode::INVALID_PARAMETER, L"Unsupported pixel format for this channel mode");
+    }
+    if (static_cast<long long>(frame.width) * frame.height > kMaxPixels || frame.width > kMaxWidth) {
+        return Result<IntegralImage>::Error(ErrorCode::INVALID_PARAMETER, L"Image too large for 32-bit sums");
+    }
+
+    IntegralImage integral;
+    integral.m_width = frame.width;
+    integral.m_height = frame.height;
+    integral.m_channels = mode == ChannelMode::GRAY ? 1 : 4;
+    integral.m_mode = mode;
+    integral.m_format = frame.format;
+    size_t entries = static_cast<size_t>(frame.width + 1) * (frame.height + 1) * integral.m_channels;
+    integral.m_sum.assign(entries, 0);
+    integral.m_sumSq.assign(entries, 0);
+    integral.BuildRows(frame, 0);
+    return Result<IntegralImage>::Success(std::move(integral));
+}
+
+Result<bool> IntegralImage::Update(const ImageView& frame, int firstDirtyRow) {
+    auto valid = ValidateFrame(frame);
+    if (valid.IsError()) {
+        return valid;
+    }
+    if (firstDirtyRow < m_height) {
+        BuildRows(frame, std::max(firstDirtyRow, 0));
+    }
+    return Result<bool>::Success(true);
+}
+
+Result<bool> IntegralImage::Update(const ImageView& frame, const std::vector<WindowsAPI::Rectangle>& dirtyRects) {
+    int firstDirtyRow = INT_MAX;
+    for (const auto& rect : dirtyRects) {
+        if (rect.width() > 0 && rect.height() > 0) {
+            firstDirtyRow = std::min(firstDirtyRow, rect.top);
+        }
+    }
+    return Update(frame, firstDirtyRow);
+}
+
+Result<bool> IntegralImage::ValidateFrame(const ImageView& frame) const {
+    if (m_sum.empty()) {
+        return Result<bool>::Error(ErrorCode::INVALID_PARAMETER, L"Integral image is empty");
+    }
+    if (frame.width != m_width || frame.height != m_height || frame.format != m_format) {
+        return Result<bool>::Error(ErrorCode::INVALID_PARAMETER, L"Frame does not match the integral image");
+    }
+    return Result<bool>::Success(true);
+}
+
+void IntegralImage::BuildRows(const ImageView& frame, int firstRow) {
+    RowKernel kernel = SelectKernel(m_channels);
+    bool toGray = m_mode == ChannelMode::GRAY && frame.format == PixelFormat::BGRA32;
+    if (toGray) {
+        m_grayRow.resize(m_width);
+    }
+
+    for (int y = firstRow; y < m_height; y++) {
+        const std::uint8_t* row = frame.Row(y);
+        if (toGray) {
+            ImageView rowView(row, m_width, 1, frame.stride, frame.format);
+            PixelConvert::ConvertRows(rowView, PixelFormat::GRAY8, m_grayRow.data(), m_width);
+            row = m_grayRow.data();
+        }
+        size_t above = Index(1, y, 0);
+        size_t current = Index(1, y + 1, 0);
+        kernel(row, m_width, &m_sum[above], &m_sumSq[above], &m_sum[current], &m_sumSq[current]);
+    }
+}
+
+// ============ 查询 ============
+
+Result<RegionStatistics> IntegralImage::Query(const WindowsAPI::Rectangle& rect) const {
+    if (m_sum.empty()) {
+        return Result<RegionStatistics>::Error(ErrorCode::INVALID_PARAMETER, L"Integral image is empty");
+    }
+    if (rect.width() <= 0 || rect.height() <= 0 || rect.left < 0 || rect.top < 0 ||
+        rect.right > m_width || rect.bottom > m_height) {
+        return Result<RegionStatistics>::Error(ErrorCode::INVALID_PARAMETER, L"Region must be non-empty and inside the image");
+    }
+
+    RegionStatistics stats;
+    stats.pixelCount = static_cast<std::uint64_t>(rect.width()) * rect.height();
+    double count = static_cast<double>(stats.pixelCount);
+    for (int c = 0; c < m_channels; c++) {
+        std::uint64_t sum = Sum(rect.left, rect.top, rect.width(), rect.height(), c);
+        std::uint64_t sumSq = SumOfSquares(rect.left, rect.top, rect.width(), rect.height(), c);
+        double mean = static_cast<double>(sum) / count;
+        stats.sum[c] = sum;
+        stats.mean[c] = mean;
+        stats.variance[c] = std::max(0.0, static_cast<double>(sumSq) / count - mean * mean);
+    }
+    return Result<RegionStatistics>::Success(stats);
+}
+
+Result<bool> IntegralImage::IsUniform(const WindowsAPI::Rectangle& rect, double maxStdDev) const {
+    auto stats = Query(rect);
+    if (stats.IsError()) {
+        return Result<bool>::Error(stats.GetErrorCode(), stats.GetErrorMessage());
+    }
+    double limit = maxStdDev * maxStdDev;
+    for (int c = 0; c < m_channels; c++) {
+        if (stats.GetData().variance[c] > limit) {
+            return Result<bool>::Success(false);
+        }
+    }
+    return Result<bool>::Success(true);
+}
+
+}  // namespace RegionStats
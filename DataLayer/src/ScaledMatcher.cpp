@@ -0,0 +1,291 @@
+#include "../include/ScaledMatcher.h"
+#include "../include/PixelConvert.h"
+#include "../include/Downscale.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ScaledMatcher {
+
+// 内部辅助函数
+namespace {
+    // 比例扫描最多尝试的比例数（防止过小的 sweepRatio 使扫描失控）
+    const int kMaxSweepSteps = 64;
+
+    int ScaleKey(double scale) {
+        return static_cast<int>(std::lround(scale * ScaledTemplateSet::kScaleUnits));
+    }
+
+    double KeyScale(int key) {
+        return static_cast<double>(key) / ScaledTemplateSet::kScaleUnits;
+    }
+
+    // 双线性放大（像素中心对齐，8 位定点权重）
+    ImageData Bilinear(const ImageView& source, int width, int height) {
+        ImageData output(width, height, PixelFormat::GRAY8);
+        std::vector<int> x0(width);
+        std::vector<int> x1(width);
+        std::vector<int> fx(width);
+        for (int x = 0; x < width; x++) {
+            const double sx = std::max(0.0, (x + 0.5) * source.width / width - 0.5);
+            x0[x] = std::min(static_cast<int>(sx), source.width - 1);
+            x1[x] = std::min(x0[x] + 1, source.width - 1);
+            fx[x] = static_cast<int>(std::lround((sx - x0[x]) * 256.0));
+        }
+        for (int y = 0; y < height; y++) {
+            const double sy = std::max(0.0, (y + 0.5) * source.height / height - 0.5);
+            const int y0 = std::min(static_cast<int>(sy), source.height - 1);
+            const int y1 = std::min(y0 + 1, source.height - 1);
+            const int fy = static_cast<int>(std::lround((sy - y0) * 256.0));
+            const std::uint8_t* top = source.Row(y0);
+            const std::uint8_t* bottom = source.Row(y1);
+            std::uint8_t* out = output.data.data() + static_cast<size_t>(y) * output.stride;
+            for (int x = 0; x < width; x++) {
+                const int upper = top[x0[x]] * (256 - fx[x]) + top[x1[x]] * fx[x];
+                const int lower = bottom[x0[x]] * (256 - fx[x]) + bottom[x1[x]] * fx[x];
+                out[x] = static_cast<std::uint8_t>((upper * (256 - fy) + lower * fy + (1 << 15)) >> 16);
+            }
+        }
+        return output;
+    }
+
+    // 按比例重采样灰度模板：两个方向都不放大时用面积平均，否则用双线性
+    Result<ImageData> Resample(const ImageData& templ, int scaleKey) {
+        const int width = static_cast<int>(std::lround(templ.width * KeyScale(scaleKey)));
+        const int height = static_cast<int>(std::lround(templ.height * KeyScale(scaleKey)));
+        if (width < 1 || height < 1) {
+            return Result<ImageData>::Error(ErrorCode::INVALID_PARAMETER, L"Scaled template is empty");
+        }
+        ImageView source(templ);
+        if (width <= templ.width && height <= templ.height) {
+            ImageData output;
+            Downscale::DownscaleOptions options;
+            options.multithreaded = false;
+            auto area = Downscale::Area(source, width, height, output, options);
+            if (area.IsError()) {
+                return Result<ImageData>::Error(area.GetErrorCode(), area.GetErrorMessage());
+            }
+            return Result<ImageData>::Success(std::move(output));
+        }
+        return Result<ImageData>::Success(Bilinear(source, width, height));
+    }
+
+    ScaledMatch ToScaledMatch(const TemplateMatcher::Match& match, const ImageView& templ, int scaleKey, double minScore) {
+        ScaledMatch result;
+        result.match = match;
+        result.scale = KeyScale(scaleKey);
+        result.found = match.score >= minScore;
+        result.bounds = WindowsAPI::Rectangle(match.location.x, match.location.y,
+                                              match.location.x + templ.width, match.location.y + templ.height);
+        return result;
+    }
+
+    // 在单个比例下取最佳位置；模板比大图还大时返回 score 为 -1 的结果
+    Result<ScaledMatch> BestAt(const ImageView& haystack, const ImageView& templ, int scaleKey,
+                               const TemplateMatcher::MatchOptions& options) {
+        ScaledMatch none;
+        none.scale = KeyScale(scaleKey);
+        none.match.score = -1.0;
+        if (templ.width > haystack.width || templ.height > haystack.height) {
+            return Result<ScaledMatch>::Success(none);
+        }
+        TemplateMatcher::MatchOptions single = options;
+        single.maxResults = 1;
+        single.minScore = -1.0;
+        auto found = TemplateMatcher::FindTemplate(haystack, templ, single);
+        if (found.IsError()) {
+            return Result<ScaledMatch>::Error(found.GetErrorCode(), found.GetErrorMessage());
+        }
+        if (found.GetData().empty()) {
+            return Result<ScaledMatch>::Success(none);
+        }
+        return Result<ScaledMatch>::Success(ToScaledMatch(found.GetData()[0], templ, scaleKey, options.minScore));
+    }
+}
+
+double InferScale(const WindowsAPI::Rectangle& clientRect, int referenceWidth, int referenceHeight) {
+    if (clientRect.width() <= 0 || clientRect.height() <= 0 || referenceWidth <= 0 || referenceHeight <= 0) {
+        return 1.0;
+    }
+    return std::min(static_cast<double>(clientRect.width()) / referenceWidth,
+                    static_cast<double>(clientRect.height()) / referenceHeight);
+}
+
+Result<int> ScaledTemplateSet::Add(const ImageView& templ) {
+    if (templ.IsEmpty()) {
+        return Result<int>::Error(ErrorCode::INVALID_PARAMETER, L"Empty template");
+    }
+    if (templ.format != PixelFormat::BGRA32 && templ.format != PixelFormat::GRAY8) {
+        return Result<int>::Error(ErrorCode::INVALID_PARAMETER, L"Template must be BGRA32 or GRAY8");
+    }
+    auto gray = PixelConvert::Convert(templ, PixelFormat::GRAY8);
+    if (gray.IsError()) {
+        return Result<int>::Error(gray.GetErrorCode(), gray.GetErrorMessage());
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // 已缓存的比例同步补上新模板，保持每个比例下集合完整（缩放后为空的模板留空，查找时报错）
+    ImageData reference = std::move(gray).TakeData();
+    for (auto& entry : m_scaled) {
+        auto scaled = Resample(reference, entry.first);
+        entry.second.push_back(scaled.IsSuccess() ? std::move(scaled).TakeData() : ImageData());
+    }
+    m_templates.push_back(std::move(reference));
+    return Result<int>::Success(static_cast<int>(m_templates.size()) - 1);
+}
+
+int ScaledTemplateSet::GetTemplateCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return static_cast<int>(m_templates.size());
+}
+
+Result<const std::vector<ImageData>*> ScaledTemplateSet::EnsureScale(int scaleKey) {
+    if (scaleKey <= 0) {
+        return Result<const std::vector<ImageData>*>::Error(ErrorCode::INVALID_PARAMETER, L"Scale must be positive");
+    }
+    if (scaleKey == kScaleUnits) {
+        return Result<const std::vector<ImageData>*>::Success(&m_templates);
+    }
+    auto it = m_scaled.find(scaleKey);
+    if (it != m_scaled.end()) {
+        return Result<const std::vector<ImageData>*>::Success(&it->second);
+    }
+
+    std::vector<ImageData> scaled;
+    scaled.reserve(m_templates.size());
+    for (const auto& templ : m_templates) {
+        auto resampled = Resample(templ, scaleKey);
+        scaled.push_back(resampled.IsSuccess() ? std::move(resampled).TakeData() : ImageData());
+    }
+    it = m_scaled.emplace(scaleKey, std::move(scaled)).first;
+    return Result<const std::vector<ImageData>*>::Success(&it->second);
+}
+
+Result<bool> ScaledTemplateSet::Prepare(double scale) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto set = EnsureScale(ScaleKey(scale));
+    if (set.IsError()) {
+        return Result<bool>::Error(set.GetErrorCode(), set.GetErrorMessage());
+    }
+    for (const auto& templ : *set.GetData()) {
+        if (templ.data.empty()) {
+            return Result<bool>::Error(ErrorCode::INVALID_PARAMETER, L"Scaled template is empty");
+        }
+    }
+    return Result<bool>::Success(true);
+}
+
+Result<ImageView> ScaledTemplateSet::GetTemplate(int index, double scale) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (index < 0 || index >= static_cast<int>(m_templates.size())) {
+        return Result<ImageView>::Error(ErrorCode::INVALID_PARAMETER, L"Invalid template index");
+    }
+    auto set = EnsureScale(ScaleKey(scale));
+    if (set.IsError()) {
+        return Result<ImageView>::Error(set.GetErrorCode(), set.GetErrorMessage());
+    }
+    const ImageData& templ = (*set.GetData())[index];
+    if (templ.data.empty()) {
+        return Result<ImageView>::Error(ErrorCode::INVALID_PARAMETER, L"Scaled template is empty");
+    }
+    return Result<ImageView>::Success(ImageView(templ));
+}
+
+Result<std::vector<TemplateMatcher::Match>> ScaledTemplateSet::Find(const ImageView& haystack, int index, double scale,
+                                                                    const TemplateMatcher::MatchOptions& options) {
+    auto templ = GetTemplate(index, scale);
+    if (templ.IsError()) {
+        return Result<std::vector<TemplateMatcher::Match>>::Error(templ.GetErrorCode(), templ.GetErrorMessage());
+    }
+    return TemplateMatcher::FindTemplate(haystack, templ.GetData(), options);
+}
+
+Result<ScaledMatch> ScaledTemplateSet::MatchAt(const ImageView& haystack, int index, int scaleKey,
+                                               const TemplateMatcher::MatchOptions& options) {
+    auto templ = GetTemplate(index, KeyScale(scaleKey));
+    if (templ.IsError()) {
+        return Result<ScaledMatch>::Error(templ.GetErrorCode(), templ.GetErrorMessage());
+    }
+    return BestAt(haystack, templ.GetData(), scaleKey, options);
+}
+
+Result<ScaledMatch> ScaledTemplateSet::Locate(const ImageView& haystack, int index, double scale,
+                                              const ScaleOptions& options) {
+    if (haystack.IsEmpty()) {
+        return Result<ScaledMatch>::Error(ErrorCode::INVALID_PARAMETER, L"Empty image");
+    }
+    if (options.sweepOnMiss && (options.minScale <= 0.0 || options.maxScale < options.minScale ||
+                                options.sweepRatio <= 1.0)) {
+        return Result<ScaledMatch>::Error(ErrorCode::INVALID_PARAMETER, L"Invalid scale sweep range");
+    }
+
+    // 推断的比例：使用缓存的模板
+    const int inferredKey = ScaleKey(scale);
+    auto inferred = MatchAt(haystack, index, inferredKey, options.match);
+    if (inferred.IsError() || inferred.GetData().found || !options.sweepOnMiss) {
+        return inferred;
+    }
+
+    // 粗扫：临时重采样单个模板，不写入缓存
+    ImageData reference;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        reference = m_templates[index];
+    }
+    ScaledMatch best = inferred.GetData();
+    auto tryScale = [&](int key) -> Result<bool> {
+        if (key <= 0 || key == inferredKey) {
+            return Result<bool>::Success(true);
+        }
+        auto templ = Resample(reference, key);
+        if (templ.IsError()) {
+            return Result<bool>::Success(true);
+        }
+        auto match = BestAt(haystack, ImageView(templ.GetData()), key, options.match);
+        if (match.IsError()) {
+            return Result<bool>::Error(match.GetErrorCode(), match.GetErrorMessage());
+        }
+        if (match.GetData().match.score > best.match.score) {
+            best = match.GetData();
+        }
+        return Result<bool>::Success(true);
+    };
+    int steps = 0;
+    for (double s = options.minScale; s <= options.maxScale * 1.0001 && steps < kMaxSweepSteps;
+         s *= options.sweepRatio, steps++) {
+        auto tried = tryScale(ScaleKey(s));
+        if (tried.IsError()) {
+            return Result<ScaledMatch>::Error(tried.GetErrorCode(), tried.GetErrorMessage());
+        }
+    }
+
+    // 细化：在最佳比例两侧按四分之一与二分之一步长各试一次
+    const double center = best.scale;
+    for (double exponent : {-0.5, -0.25, 0.25, 0.5}) {
+        auto tried = tryScale(ScaleKey(center * std::pow(options.sweepRatio, exponent)));
+        if (tried.IsError()) {
+            return Result<ScaledMatch>::Error(tried.GetErrorCode(), tried.GetErrorMessage());
+        }
+    }
+
+    best.swept = true;
+    best.found = best.match.score >= options.match.minScore;
+    // 找到的比例写入缓存，之后按该比例查找不再重采样
+    if (best.found) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        EnsureScale(ScaleKey(best.scale));
+    }
+    return Result<ScaledMatch>::Success(best);
+}
+
+size_t ScaledTemplateSet::GetCachedScaleCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_scaled.size();
+}
+
+void ScaledTemplateSet::ClearCache() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_scaled.clear();
+}
+
+}  // namespace ScaledMatcher
@@ -1,5 +1,7 @@
 #include "../include/ScreenCapture.h"
+#include "../include/PixelConvert.h"
 #include <windows.h>
+#include <utility>
 
 namespace ScreenCapture {
 
@@ -7,15 +9,8 @@ namespace ScreenCapture {
 namespace {
     // 从HBITMAP提取图像数据
     Result<ImageData> ExtractImageDataFromBitmap(HBITMAP hBitmap, HDC hdc, int width, int height) {
-        ImageData imageData;
-        imageData.width = width;
-        imageData.height = height;
-        imageData.bitsPerPixel = 32; // 使用32位格式
-        imageData.stride = width * 4; // 每行字节数
-        
-        // 分配内存
-        int dataSize = imageData.stride * imageData.height;
-        imageData.data.resize(dataSize);
+        // 32位DIB每行天然按DWORD对齐
+        ImageData imageData(width, height, PixelFormat::BGRA32);
         
         // 创建位图信息头
         BITMAPINFOHEADER bi = {};
@@ -32,7 +27,140 @@ namespace {
             return Result<ImageData>::Error(ErrorCode::CAPTURE_FAILED, L"Failed to get bitmap bits");
         }
         
-        return Result<ImageData>::Success(imageData);
+        return Result<ImageData>::Success(std::move(imageData));
+    }
+    
+    // 把 BGRA32 捕获结果原地转换为调用方要求的格式
+    Result<ImageData> ApplyFormat(Result<ImageData> captured, PixelFormat format) {
+        if (captured.IsError() || format == PixelFormat::BGRA32) {
+            return captured;
+        }
+        
+        ImageData image = std::move(captured).TakeData();
+        auto converted = PixelConvert::ConvertInPlace(image, format);
+        if (converted.IsError()) {
+            return Result<ImageData>::Error(converted.GetErrorCode(), converted.GetErrorMessage());
+        }
+        return Result<ImageData>::Success(std::move(image));
+    }
+    
+    // 32位自上而下的 DIB 节：像素直接落在 bits 中，不需要再 GetDIBits
+    HBITMAP CreateSurface(HDC dc, int width, int height, void** bits) {
+        BITMAPINFO bi = {};
+        bi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+        bi.bmiHeader.biWidth = width;
+        bi.bmiHeader.biHeight = -height; // 负值表示自上而下的位图
+        bi.bmiHeader.biPlanes = 1;
+        bi.bmiHeader.biBitCount = 32;
+        bi.bmiHeader.biCompression = BI_RGB;
+        
+        *bits = nullptr;
+        HBITMAP bitmap = CreateDIBSection(dc, &bi, DIB_RGB_COLORS, bits, NULL, 0);
+        if (bitmap && !*bits) {
+            DeleteObject(bitmap);
+            return NULL;
+        }
+        return bitmap;
+    }
+    
+    // 每组只把外接矩形从窗口 DC BitBlt 到组大小的 DIB 节，再切出组内各区域
+    Result<std::vector<ImageData>> GrabRegionGroups(HWND windowHandle, const RegionCapturePlan& plan) {
+        HDC windowDC = GetWindowDC(windowHandle);
+        if (!windowDC) {
+            return Result<std::vector<ImageData>>::Error(ErrorCode::CAPTURE_FAILED, L"Failed to get window DC");
+        }
+        
+        HDC memDC = CreateCompatibleDC(windowDC);
+        if (!memDC) {
+            ReleaseDC(windowHandle, windowDC);
+            return Result<std::vector<ImageData>>::Error(ErrorCode::CAPTURE_FAILED, L"Failed to create memory DC");
+        }
+        
+        std::vector<HBITMAP> surfaces;
+        std::vector<ImageView> groupGrabs;
+        surfaces.reserve(plan.groups.size());
+        groupGrabs.reserve(plan.groups.size());
+        
+        auto release = [&]() {
+            for (HBITMAP surface : surfaces) {
+                DeleteObject(surface);
+            }
+            DeleteDC(memDC);
+            ReleaseDC(windowHandle, windowDC);
+        };
+        
+        for (const auto& group : plan.groups) {
+            const int width = group.bounds.width();
+            const int height = group.bounds.height();
+            
+            void* bits = nullptr;
+            HBITMAP surface = CreateSurface(memDC, width, height, &bits);
+            if (!surface) {
+                release();
+                return Result<std::vector<ImageData>>::Error(ErrorCode::MEMORY_ALLOCATION_FAILED, L"Failed to create DIB section");
+            }
+            surfaces.push_back(surface);
+            
+            HGDIOBJ oldBitmap = SelectObject(memDC, surface);
+            BOOL copied = BitBlt(memDC, 0, 0, width, height,
+                                 windowDC, group.bounds.left, group.bounds.top, SRCCOPY | CAPTUREBLT);
+            SelectObject(memDC, oldBitmap);
+            if (!copied) {
+                release();
+                return Result<std::vector<ImageData>>::Error(ErrorCode::CAPTURE_FAILED, L"Failed to copy window region");
+            }
+            
+            groupGrabs.emplace_back(static_cast<const std::uint8_t*>(bits), width, height, width * 4, PixelFormat::BGRA32);
+        }
+        
+        GdiFlush();
+        auto result = ExtractGroupedRegions(plan, groupGrabs);
+        release();
+        return result;
+    }
+    
+    // 回退路径。PrintWindow 没有源矩形参数，也不保证遵循目标 DC 的视口原点：
+    // 按整个窗口打印到 DIB 节，再切出各区域，分组在这里省不下打印的开销。
+    // BitBlt 路径复制的是屏幕上合成后的像素，窗口被遮挡或移出屏幕的部分会得到遮挡物；
+    // 需要被遮挡的内容时应使用 CaptureWindow
+    Result<std::vector<ImageData>> PrintRegionGroups(HWND windowHandle, const RegionCapturePlan& plan,
+                                                     int windowWidth, int windowHeight) {
+        HDC memDC = CreateCompatibleDC(NULL);
+        if (!memDC) {
+            return Result<std::vector<ImageData>>::Error(ErrorCode::CAPTURE_FAILED, L"Failed to create memory DC");
+        }
+        
+        void* bits = nullptr;
+        HBITMAP hBitmap = CreateSurface(memDC, windowWidth, windowHeight, &bits);
+        if (!hBitmap) {
+            DeleteDC(memDC);
+            return Result<std::vector<ImageData>>::Error(ErrorCode::MEMORY_ALLOCATION_FAILED, L"Failed to create DIB section");
+        }
+        
+        HGDIOBJ oldBitmap = SelectObject(memDC, hBitmap);
+        
+        if (!PrintWindow(windowHandle, memDC, 0)) {
+            SelectObject(memDC, oldBitmap);
+            DeleteObject(hBitmap);
+            DeleteDC(memDC);
+            return Result<std::vector<ImageData>>::Error(ErrorCode::CAPTURE_FAILED, L"Failed to print window");
+        }
+        
+        GdiFlush();
+        
+        ImageView window(static_cast<const std::uint8_t*>(bits), windowWidth, windowHeight, windowWidth * 4, PixelFormat::BGRA32);
+        std::vector<ImageView> groupGrabs;
+        groupGrabs.reserve(plan.groups.size());
+        for (const auto& group : plan.groups) {
+            groupGrabs.push_back(window.Subview(group.bounds));
+        }
+        auto result = ExtractGroupedRegions(plan, groupGrabs);
+        
+        SelectObject(memDC, oldBitmap);
+        DeleteObject(hBitmap);
+        DeleteDC(memDC);
+        
+        return result;
     }
     
     // 使用PrintWindow捕获窗口
@@ -75,6 +203,103 @@ namespace {
         return result;
     }
     
+    // 基于GDI的持久捕获后端：内存DC与DIB节跨帧复用
+    class GdiWindowCaptureBackend : public CaptureBackend {
+    public:
+        GdiWindowCaptureBackend(HWND windowHandle, bool clientOnly)
+            : m_windowHandle(windowHandle), m_clientOnly(clientOnly) {}
+        
+        ~GdiWindowCaptureBackend() override {
+            ReleaseSurface();
+            if (m_memDC) {
+                DeleteDC(m_memDC);
+            }
+        }
+        
+        GdiWindowCaptureBackend(const GdiWindowCaptureBackend&) = delete;
+        GdiWindowCaptureBackend& operator=(const GdiWindowCaptureBackend&) = delete;
+        
+        Result<WindowsAPI::Rectangle> QuerySourceBounds() override {
+            if (!IsWindow(m_windowHandle)) {
+                return Result<WindowsAPI::Rectangle>::Error(ErrorCode::INVALID_HANDLE, L"Invalid window handle");
+            }
+            
+            RECT rect;
+            BOOL ok = m_clientOnly ? ::GetClientRect(m_windowHandle, &rect) : ::GetWindowRect(m_windowHandle, &rect);
+            if (!ok) {
+                return Result<WindowsAPI::Rectangle>::Error(ErrorCode::OPERATION_FAILED, L"Failed to get window rect");
+            }
+            
+            WindowsAPI::Rectangle bounds(0, 0, rect.right - rect.left, rect.bottom - rect.top);
+            return Result<WindowsAPI::Rectangle>::Success(bounds);
+        }
+        
+        Result<CaptureSurface> AllocateSurface(int width, int height) override {
+            ReleaseSurface();
+            
+            if (!m_memDC) {
+                m_memDC = CreateCompatibleDC(NULL);
+                if (!m_memDC) {
+                    return Result<CaptureSurface>::Error(ErrorCode::CAPTURE_FAILED, L"Failed to create memory DC");
+                }
+            }
+            
+            BITMAPINFO bi = {};
+            bi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+            bi.bmiHeader.biWidth = width;
+            bi.bmiHeader.biHeight = -height; // 负值表示自上而下的位图
+            bi.bmiHeader.biPlanes = 1;
+            bi.bmiHeader.biBitCount = 32;
+            bi.bmiHeader.biCompression = BI_RGB;
+            
+            void* bits = nullptr;
+            m_bitmap = CreateDIBSection(m_memDC, &bi, DIB_RGB_COLORS, &bits, NULL, 0);
+            if (!m_bitmap || !bits) {
+                if (m_bitmap) {
+                    DeleteObject(m_bitmap);
+                }
+                m_bitmap = NULL;
+                return Result<CaptureSurface>::Error(ErrorCode::MEMORY_ALLOCATION_FAILED, L"Failed to create DIB section");
+            }
+            
+            m_oldBitmap = SelectObject(m_memDC, m_bitmap);
+            
+            CaptureSurface surface;
+            surface.pixels = static_cast<std::uint8_t*>(bits);
+            surface.width = width;
+            surface.height = height;
+            surface.stride = width * 4; // 32位DIB每行天然按DWORD对齐
+            return Result<CaptureSurface>::Success(surface);
+        }
+        
+        void ReleaseSurface() override {
+            if (m_bitmap) {
+                SelectObject(m_memDC, m_oldBitmap);
+                DeleteObject(m_bitmap);
+                m_bitmap = NULL;
+                m_oldBitmap = NULL;
+            }
+        }
+        
+        Result<bool> Grab(const CaptureSurface& surface) override {
+            (void)surface; // DIB节已选入内存DC，PrintWindow直接写入表面内存
+            if (!PrintWindow(m_windowHandle, m_memDC, m_clientOnly ? PW_CLIENTONLY : 0)) {
+                return Result<bool>::Error(ErrorCode::CAPTURE_FAILED, L"Failed to print window");
+            }
+            
+            // 确保GDI批处理的绘制操作已写入DIB内存
+            GdiFlush();
+            return Result<bool>::Success(true);
+        }
+        
+    private:
+        HWND m_windowHandle;
+        bool m_clientOnly;
+        HDC m_memDC = NULL;
+        HBITMAP m_bitmap = NULL;
+        HGDIOBJ m_oldBitmap = NULL;
+    };
+    
     // 使用BitBlt捕获屏幕区域（仅用于屏幕捕获）
     Result<ImageData> CaptureUsingBitBlt(HDC sourceDC, int x, int y, int width, int height) {
         HDC memDC = CreateCompatibleDC(sourceDC);
@@ -127,7 +352,7 @@ Result<ImageData> CaptureScreen() {
 
 // ============ 窗口截图功能 ============
 
-Result<ImageData> CaptureWindow(HWND windowHandle) {
+Result<ImageData> CaptureWindow(HWND windowHandle, PixelFormat format) {
     if (!IsWindow(windowHandle)) {
         return Result<ImageData>::Error(ErrorCode::INVALID_HANDLE, L"Invalid window handle");
     }
@@ -145,10 +370,10 @@ Result<ImageData> CaptureWindow(HWND windowHandle) {
     }
     
     // 使用PrintWindow捕获窗口
-    return CaptureUsingPrintWindow(windowHandle, width, height);
+    return ApplyFormat(CaptureUsingPrintWindow(windowHandle, width, height), format);
 }
 
-Result<ImageData> CaptureWindowClient(HWND windowHandle) {
+Result<ImageData> CaptureWindowClient(HWND windowHandle, PixelFormat format) {
     if (!IsWindow(windowHandle)) {
         return Result<ImageData>::Error(ErrorCode::INVALID_HANDLE, L"Invalid window handle");
     }
@@ -166,61 +391,82 @@ Result<ImageData> CaptureWindowClient(HWND windowHandle) {
     }
     
     // 使用PrintWindow捕获窗口客户区
-    return CaptureUsingPrintWindow(windowHandle, width, height, PW_CLIENTONLY);
+    return ApplyFormat(CaptureUsingPrintWindow(windowHandle, width, height, PW_CLIENTONLY), format);
 }
 
-Result<ImageData> CaptureRegion(HWND windowHandle, int x, int y, int width, int height) {
-    if (!IsWindow(windowHandle)) {
-        return Result<ImageData>::Error(ErrorCode::INVALID_HANDLE, L"Invalid window handle");
-    }
-    
+Result<ImageData> CaptureRegion(HWND windowHandle, int x, int y, int width, int height, PixelFormat format) {
     if (width <= 0 || height <= 0) {
         return Result<ImageData>::Error(ErrorCode::INVALID_PARAMETER, L"Invalid region dimensions");
     }
     
+    std::vector<WindowsAPI::Rectangle> regions = { WindowsAPI::Rectangle(x, y, x + width, y + height) };
+    auto regionsResult = CaptureRegions(windowHandle, regions);
+    if (regionsResult.IsError()) {
+        return Result<ImageData>::Error(regionsResult.GetErrorCode(), regionsResult.GetErrorMessage());
+    }
+    
+    auto images = std::move(regionsResult).TakeData();
+    return ApplyFormat(Result<ImageData>::Success(std::move(images.front())), format);
+}
+
+Result<std::vector<ImageData>> CaptureRegions(HWND windowHandle, const std::vector<WindowsAPI::Rectangle>& regions) {
+    if (!IsWindow(windowHandle)) {
+        return Result<std::vector<ImageData>>::Error(ErrorCode::INVALID_HANDLE, L"Invalid window handle");
+    }
+    
     // 获取窗口尺寸
     RECT windowRect;
     if (!GetWindowRect(windowHandle, &windowRect)) {
-        return Result<ImageData>::Error(ErrorCode::OPERATION_FAILED, L"Failed to get window rect");
+        return Result<std::vector<ImageData>>::Error(ErrorCode::OPERATION_FAILED, L"Failed to get window rect");
     }
     
     int windowWidth = windowRect.right - windowRect.left;
     int windowHeight = windowRect.bottom - windowRect.top;
     
-    // 检查区域是否超出窗口范围
-    if (x + width > windowWidth || y + height > windowHeight) {
-        return Result<ImageData>::Error(ErrorCode::INVALID_PARAMETER, L"Region extends beyond window bounds");
-    }
-    
-    // 先捕获整个窗口
-    auto fullWindowResult = CaptureUsingPrintWindow(windowHandle, windowWidth, windowHeight);
-    if (!fullWindowResult.IsSuccess()) {
-        return fullWindowResult;
+    auto planResult = PlanRegionCapture(regions, windowWidth, windowHeight);
+    if (planResult.IsError()) {
+        return Result<std::vector<ImageData>>::Error(planResult.GetErrorCode(), planResult.GetErrorMessage());
     }
     
-    auto fullImage = fullWindowResult.GetData();
+    const RegionCapturePlan& plan = planResult.GetData();
     
-    // 裁剪出指定区域
-    ImageData regionImage;
-    regionImage.width = width;
-    regionImage.height = height;
-    regionImage.bitsPerPixel = fullImage.bitsPerPixel;
-    regionImage.stride = width * 4; // 32位每像素
+    // 最小化的窗口在屏幕上没有像素可复制，只能整幅打印
+    if (!IsIconic(windowHandle)) {
+        auto grabbed = GrabRegionGroups(windowHandle, plan);
+        if (grabbed.IsSuccess()) {
+            return grabbed;
+        }
+    }
+    return PrintRegionGroups(windowHandle, plan, windowWidth, windowHeight);
+}
+
+// ============ 像素探测 ============
+
+Result<std::uint64_t> ProbeWindow(HWND windowHandle, const PixelProbe::PixelProbeSet& probes) {
+    const WindowsAPI::Rectangle& bounds = probes.GetBounds();
+    if (probes.GetProbeCount() == 0) {
+        return Result<std::uint64_t>::Error(ErrorCode::INVALID_PARAMETER, L"Probe set is empty");
+    }
     
-    int regionDataSize = regionImage.stride * height;
-    regionImage.data.resize(regionDataSize);
+    // 只抓取探测点的外接矩形
+    auto captureResult = CaptureRegion(windowHandle, bounds.left, bounds.top, bounds.width(), bounds.height());
+    if (captureResult.IsError()) {
+        return Result<std::uint64_t>::Error(captureResult.GetErrorCode(), captureResult.GetErrorMessage());
+    }
     
-    // 复制指定区域的数据
-    for (int row = 0; row < height; row++) {
-        int srcRowOffset = (y + row) * fullImage.stride + x * 4;
-        int dstRowOffset = row * regionImage.stride;
-        
-        if (srcRowOffset + width * 4 <= (int)fullImage.data.size()) {
-            memcpy(&regionImage.data[dstRowOffset], &fullImage.data[srcRowOffset], width * 4);
-        }
+    return probes.Evaluate(ImageView(captureResult.GetData()), Point(bounds.left, bounds.top));
+}
+
+// ============ 持久捕获会话 ============
+
+Result<std::shared_ptr<CaptureSession>> CreateCaptureSession(HWND windowHandle, bool clientOnly) {
+    if (!IsWindow(windowHandle)) {
+        return Result<std::shared_ptr<CaptureSession>>::Error(ErrorCode::INVALID_HANDLE, L"Invalid window handle");
     }
     
-    return Result<ImageData>::Success(regionImage);
+    auto backend = std::make_unique<GdiWindowCaptureBackend>(windowHandle, clientOnly);
+    auto session = std::make_shared<CaptureSession>(std::move(backend));
+    return Result<std::shared_ptr<CaptureSession>>::Success(std::move(session));
 }
 
 }  // namespace ScreenCapture
\ No newline at end of file
@@ -0,0 +1,392 @@
+#include "../include/ScreenState.h"
+#include "../include/PixelConvert.h"
+#include "../include/Downscale.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace ScreenState {
+
+// 内部辅助函数
+namespace {
+    // 每个采样格最多读取的源行数
+    const int kRowsPerCell = 4;
+    // 采样格亮度至少高出瓦片均值这么多才记为 1
+    const int kHashMargin = 2;
+    // 采样格亮度极差小于该值的瓦片视为纯色，哈希为 0，只比较平均亮度
+    const int kFlatRange = 16;
+    // 序列化格式标识与版本
+    const std::uint8_t kMagic[4] = {'S', 'S', 'T', 'I'};
+    const std::uint16_t kFormatVersion = 1;
+
+    inline int PopCount64(std::uint64_t value) {
+        value = value - ((value >> 1) & 0x5555555555555555ull);
+        value = (value & 0x3333333333333333ull) + ((value >> 2) & 0x3333333333333333ull);
+        value = (value + (value >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+        return static_cast<int>((value * 0x0101010101010101ull) >> 56);
+    }
+
+    bool IsValidTileCount(int tilesX, int tilesY) {
+        return tilesX >= 1 && tilesX <= kMaxTiles && tilesY >= 1 && tilesY <= kMaxTiles;
+    }
+
+    // 小端字节流写入
+    class ByteWriter {
+    public:
+        explicit ByteWriter(std::vector<std::uint8_t>& out) : m_out(out) {}
+
+        void Write(std::uint64_t value, int bytes) {
+            for (int i = 0; i < bytes; i++) {
+                m_out.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+            }
+        }
+
+        void WriteBytes(const std::uint8_t* data, std::size_t size) {
+            m_out.insert(m_out.end(), data, data + size);
+        }
+
+    private:
+        std::vector<std::uint8_t>& m_out;
+    };
+
+    // 小端字节流读取，越界后所有读取都失败
+    class ByteReader {
+    public:
+        ByteReader(const std::uint8_t* data, std::size_t size) : m_data(data), m_size(size) {}
+
+        bool Read(std::uint64_t& value, int bytes) {
+            if (!Has(bytes)) {
+                return false;
+            }
+            value = 0;
+            for (int i = 0; i < bytes; i++) {
+                value |= static_cast<std::uint64_t>(m_data[m_offset + i]) << (8 * i);
+            }
+            m_offset += bytes;
+            return true;
+        }
+
+        bool ReadBytes(std::uint8_t* out, std::size_t size) {
+            if (!Has(size)) {
+                return false;
+            }
+            std::copy_n(m_data + m_offset, size, out);
+            m_offset += size;
+            return true;
+        }
+
+        bool Has(std::size_t bytes) const { return m_size - m_offset >= bytes; }
+        bool AtEnd() const { return m_offset == m_size; }
+
+    private:
+        const std::uint8_t* m_data;
+        std::size_t m_size;
+        std::size_t m_offset = 0;
+    };
+
+    Result<StateIndex> CorruptedData() {
+        return Result<StateIndex>::Error(ErrorCode::INVALID_PARAMETER, L"Corrupted state index data");
+    }
+}
+
+Result<TileSignature> ComputeSignature(const ImageView& capture, int tilesX, int tilesY) {
+    if (capture.IsEmpty()) {
+        return Result<TileSignature>::Error(ErrorCode::INVALID_PARAMETER, L"Empty image");
+    }
+    if (capture.format != PixelFormat::BGRA32 && capture.format != PixelFormat::GRAY8) {
+        return Result<TileSignature>::Error(ErrorCode::INVALID_PARAMETER, L"Unsupported pixel format");
+    }
+    if (!IsValidTileCount(tilesX, tilesY)) {
+        return Result<TileSignature>::Error(ErrorCode::INVALID_PARAMETER, L"Invalid tile count");
+    }
+    const int cols = tilesX * kCellsPerTile;
+    const int rows = tilesY * kCellsPerTile;
+    if (capture.width < cols || capture.height < rows) {
+        return Result<TileSignature>::Error(ErrorCode::INVALID_PARAMETER, L"Image is smaller than the tile grid");
+    }
+
+    // 每隔 step 行取一行（从半个间隔处开始），再面积平均到采样格
+    const int step = std::max(1, capture.height / (rows * kRowsPerCell));
+    const int first = step / 2;
+    ImageView sampled(capture.Row(first), capture.width, (capture.height - 1 - first) / step + 1,
+                      capture.stride * step, capture.format);
+
+    Downscale::DownscaleOptions downscale;
+    downscale.multithreaded = false;
+    const int bytesPerPixel = capture.BytesPerPixel();
+    std::vector<std::uint8_t> cells(static_cast<size_t>(cols) * rows * bytesPerPixel);
+    auto scaled = Downscale::AreaRows(sampled, cols, rows, cells.data(), cols * bytesPerPixel, downscale);
+    if (scaled.IsError()) {
+        return Result<TileSignature>::Error(scaled.GetErrorCode(), scaled.GetErrorMessage());
+    }
+    std::vector<std::uint8_t> gray;
+    const std::uint8_t* luma = cells.data();
+    if (capture.format == PixelFormat::BGRA32) {
+        gray.resize(static_cast<size_t>(cols) * rows);
+        PixelConvert::ConvertRows(ImageView(cells.data(), cols, rows, cols * 4, PixelFormat::BGRA32),
+                                  PixelFormat::GRAY8, gray.data(), cols);
+        luma = gray.data();
+    }
+
+    TileSignature signature;
+    signature.tilesX = tilesX;
+    signature.tilesY = tilesY;
+    signature.hashes.resize(static_cast<size_t>(tilesX) * tilesY);
+    signature.means.resize(signature.hashes.size());
+    const int cellCount = kCellsPerTile * kCellsPerTile;
+    for (int ty = 0; ty < tilesY; ty++) {
+        for (int tx = 0; tx < tilesX; tx++) {
+            const std::uint8_t* tile = luma + static_cast<size_t>(ty) * kCellsPerTile * cols + tx * kCellsPerTile;
+            int sum = 0;
+            int low = 255;
+            int high = 0;
+            for (int y = 0; y < kCellsPerTile; y++) {
+                for (int x = 0; x < kCellsPerTile; x++) {
+                    const int v = tile[y * cols + x];
+                    sum += v;
+                    low = std::min(low, v);
+                    high = std::max(high, v);
+                }
+            }
+            // v > mean + margin，用整数比较避免舍入
+            const int threshold = sum + kHashMargin * cellCount;
+            std::uint64_t hash = 0;
+            if (high - low >= kFlatRange) {
+                for (int y = 0; y < kCellsPerTile; y++) {
+                    for (int x = 0; x < kCellsPerTile; x++) {
+                        hash = (hash << 1) | (tile[y * cols + x] * cellCount > threshold ? 1u : 0u);
+                    }
+                }
+            }
+            const size_t index = static_cast<size_t>(ty) * tilesX + tx;
+            signature.hashes[index] = hash;
+            signature.means[index] = static_cast<std::uint8_t>((sum + cellCount / 2) / cellCount);
+        }
+    }
+    return Result<TileSignature>::Success(std::move(signature));
+}
+
+StateIndex::StateIndex() : StateIndex(8, 8) {}
+
+StateIndex::StateIndex(int tilesX, int tilesY) : m_tilesX(tilesX), m_tilesY(tilesY) {}
+
+Result<StateIndex> StateIndex::Create(int tilesX, int tilesY) {
+    if (!IsValidTileCount(tilesX, tilesY)) {
+        return Result<StateIndex>::Error(ErrorCode::INVALID_PARAMETER, L"Invalid tile count");
+    }
+    return Result<StateIndex>::Success(StateIndex(tilesX, tilesY));
+}
+
+Result<int> StateIndex::AddSample(const std::wstring& name, const ImageView& capture,
+                                  const std::vector<WindowsAPI::Rectangle>& ignoreRegions) {
+    if (name.empty()) {
+        return Result<int>::Error(ErrorCode::INVALID_PARAMETER, L"Empty state name");
+    }
+    auto signature = ComputeSignature(capture, m_tilesX, m_tilesY);
+    if (signature.IsError()) {
+        return Result<int>::Error(signature.GetErrorCode(), signature.GetErrorMessage());
+    }
+
+    // 与忽略区域相交的瓦片
+    std::vector<std::uint64_t> ignored(MaskWords(), 0);
+    int active = TileCount();
+    for (int ty = 0; ty < m_tilesY; ty++) {
+        const int top = ty * capture.height / m_tilesY;
+        const int bottom = (ty + 1) * capture.height / m_tilesY;
+        for (int tx = 0; tx < m_tilesX; tx++) {
+            const int left = tx * capture.width / m_tilesX;
+            const int right = (tx + 1) * capture.width / m_tilesX;
+            for (const auto& region : ignoreRegions) {
+                if (region.left < right && region.right > left && region.top < bottom && region.bottom > top) {
+                    const int tile = ty * m_tilesX + tx;
+                    ignored[tile / 64] |= 1ull << (tile % 64);
+                    active--;
+                    break;
+                }
+            }
+        }
+    }
+    if (active == 0) {
+        return Result<int>::Error(ErrorCode::INVALID_PARAMETER, L"All tiles are ignored");
+    }
+
+    int state = FindState(name);
+    if (state < 0) {
+        state = static_cast<int>(m_names.size());
+        m_names.push_back(name);
+    }
+    const TileSignature& data = signature.GetData();
+    m_sampleStates.push_back(state);
+    m_activeTiles.push_back(active);
+    m_hashes.insert(m_hashes.end(), data.hashes.begin(), data.hashes.end());
+    m_means.insert(m_means.end(), data.means.begin(), data.means.end());
+    m_ignored.insert(m_ignored.end(), ignored.begin(), ignored.end());
+    return Result<int>::Success(state);
+}
+
+Result<Classification> StateIndex::Classify(const ImageView& capture, const ClassifyOptions& options) const {
+    auto signature = ComputeSignature(capture, m_tilesX, m_tilesY);
+    if (signature.IsError()) {
+        return Result<Classification>::Error(signature.GetErrorCode(), signature.GetErrorMessage());
+    }
+    return Classify(signature.GetData(), options);
+}
+
+Result<Classification> StateIndex::Classify(const TileSignature& signature, const ClassifyOptions& options) const {
+    const int tiles = TileCount();
+    if (signature.tilesX != m_tilesX || signature.tilesY != m_tilesY ||
+        static_cast<int>(signature.hashes.size()) != tiles || static_cast<int>(signature.means.size()) != tiles) {
+        return Result<Classification>::Error(ErrorCode::INVALID_PARAMETER, L"Signature does not match index tiles");
+    }
+
+    // 每个界面取其样本中的最高匹配比例
+    std::vector<double> ratios(m_names.size(), 0.0);
+    const int words = MaskWords();
+    for (size_t s = 0; s < m_sampleStates.size(); s++) {
+        const std::uint64_t* hashes = &m_hashes[s * tiles];
+        const std::uint8_t* means = &m_means[s * tiles];
+        const std::uint64_t* ignored = &m_ignored[s * words];
+        int matched = 0;
+        for (int t = 0; t < tiles; t++) {
+            if ((ignored[t / 64] >> (t % 64)) & 1) {
+                continue;
+            }
+            const bool hashMatch = PopCount64(hashes[t] ^ signature.hashes[t]) <= options.hashTolerance;
+            const bool meanMatch = std::abs(means[t] - signature.means[t]) <= options.meanTolerance;
+            matched += hashMatch && meanMatch ? 1 : 0;
+        }
+        double& ratio = ratios[m_sampleStates[s]];
+        ratio = std::max(ratio, static_cast<double>(matched) / m_activeTiles[s]);
+    }
+
+    Classification result;
+    double second = 0.0;
+    for (int state = 0; state < static_cast<int>(ratios.size()); state++) {
+        if (result.nearestState < 0 || ratios[state] > result.matchRatio) {
+            if (result.nearestState >= 0) {
+                second = result.matchRatio;
+            }
+            result.nearestState = state;
+            result.matchRatio = ratios[state];
+        } else {
+            second = std::max(second, ratios[state]);
+        }
+    }
+    result.confidence = result.matchRatio - second;
+    if (result.nearestState >= 0 && result.matchRatio >= options.minMatchRatio) {
+        result.state = result.nearestState;
+    }
+    return Result<Classification>::Success(result);
+}
+
+int StateIndex::FindState(const std::wstring& name) const {
+    auto it = std::find(m_names.begin(), m_names.end(), name);
+    return it == m_names.end() ? -1 : static_cast<int>(it - m_names.begin());
+}
+
+// 格式：标识(4) 版本(2) tilesX(1) tilesY(1) 界面数(4) 样本数(4)，
+// 每个界面：名称长度(4) 与按 32 位存放的字符；每个样本：所属界面(4) 参与比较的瓦片数(4)
+// 瓦片哈希(8 x 瓦片数) 瓦片亮度(1 x 瓦片数) 忽略位图(8 x 位图字数)
+std::vector<std::uint8_t> StateIndex::Serialize() const {
+    std::vector<std::uint8_t> out;
+    ByteWriter writer(out);
+    writer.WriteBytes(kMagic, sizeof(kMagic));
+    writer.Write(kFormatVersion, 2);
+    writer.Write(static_cast<std::uint64_t>(m_tilesX), 1);
+    writer.Write(static_cast<std::uint64_t>(m_tilesY), 1);
+    writer.Write(m_names.size(), 4);
+    writer.Write(m_sampleStates.size(), 4);
+    for (const auto& name : m_names) {
+        writer.Write(name.size(), 4);
+        for (wchar_t ch : name) {
+            writer.Write(static_cast<std::uint32_t>(ch), 4);
+        }
+    }
+    const int tiles = TileCount();
+    const int words = MaskWords();
+    for (size_t s = 0; s < m_sampleStates.size(); s++) {
+        writer.Write(static_cast<std::uint64_t>(m_sampleStates[s]), 4);
+        writer.Write(static_cast<std::uint64_t>(m_activeTiles[s]), 4);
+        for (int t = 0; t < tiles; t++) {
+            writer.Write(m_hashes[s * tiles + t], 8);
+        }
+        writer.WriteBytes(&m_means[s * tiles], tiles);
+        for (int w = 0; w < words; w++) {
+            writer.Write(m_ignored[s * words + w], 8);
+        }
+    }
+    return out;
+}
+
+Result<StateIndex> StateIndex::Deserialize(const std::uint8_t* data, std::size_t size) {
+    if (!data) {
+        return CorruptedData();
+    }
+    ByteReader reader(data, size);
+    std::uint8_t magic[4];
+    std::uint64_t version = 0, tilesX = 0, tilesY = 0, stateCount = 0, sampleCount = 0;
+    if (!reader.ReadBytes(magic, sizeof(magic)) || !std::equal(magic, magic + 4, kMagic) ||
+        !reader.Read(version, 2) || version != kFormatVersion ||
+        !reader.Read(tilesX, 1) || !reader.Read(tilesY, 1) ||
+        !IsValidTileCount(static_cast<int>(tilesX), static_cast<int>(tilesY)) ||
+        !reader.Read(stateCount, 4) || !reader.Read(sampleCount, 4)) {
+        return CorruptedData();
+    }
+
+    StateIndex index(static_cast<int>(tilesX), static_cast<int>(tilesY));
+    for (std::uint64_t i = 0; i < stateCount; i++) {
+        std::uint64_t length = 0;
+        if (!reader.Read(length, 4) || length == 0 || !reader.Has(length * 4)) {
+            return CorruptedData();
+        }
+        std::wstring name(static_cast<size_t>(length), L'\0');
+        for (auto& ch : name) {
+            std::uint64_t unit = 0;
+            if (!reader.Read(unit, 4)) {
+                return CorruptedData();
+            }
+            ch = static_cast<wchar_t>(unit);
+        }
+        index.m_names.push_back(std::move(name));
+    }
+
+    // 瓦片数已由 IsValidTileCount 检查，按无符号处理
+    const std::size_t tiles = static_cast<std::size_t>(index.TileCount());
+    const std::size_t words = static_cast<std::size_t>(index.MaskWords());
+    const std::size_t sampleBytes = 8 + tiles * 9 + words * 8;
+    if (!reader.Has(sampleCount * sampleBytes)) {
+        return CorruptedData();
+    }
+    index.m_hashes.resize(sampleCount * tiles);
+    index.m_means.resize(sampleCount * tiles);
+    index.m_ignored.resize(sampleCount * words);
+    for (std::uint64_t s = 0; s < sampleCount; s++) {
+        std::uint64_t state = 0;
+        std::uint64_t active = 0;
+        if (!reader.Read(state, 4) || !reader.Read(active, 4) ||
+            state >= stateCount || active == 0 || active > tiles) {
+            return CorruptedData();
+        }
+        index.m_sampleStates.push_back(static_cast<int>(state));
+        index.m_activeTiles.push_back(static_cast<int>(active));
+        for (std::size_t t = 0; t < tiles; t++) {
+            if (!reader.Read(index.m_hashes[s * tiles + t], 8)) {
+                return CorruptedData();
+            }
+        }
+        if (!reader.ReadBytes(&index.m_means[s * tiles], tiles)) {
+            return CorruptedData();
+        }
+        for (std::size_t w = 0; w < words; w++) {
+            if (!reader.Read(index.m_ignored[s * words + w], 8)) {
+                return CorruptedData();
+            }
+        }
+    }
+    if (!reader.AtEnd()) {
+        return CorruptedData();
+    }
+    return Result<StateIndex>::Success(std::move(index));
+}
+
+}  // namespace ScreenState
@@ -0,0 +1,440 @@
+#include "../include/ScrollMotion.h"
+#include "../include/PixelConvert.h"
+#include "../include/Downscale.h"
+#include "../include/TemplateMatcher.h"
+#include "MatchKernels.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <utility>
+
+namespace ScrollMotion {
+
+// 内部辅助函数
+namespace {
+    // 每行/每列签名的采样数
+    const int kSignatureSize = 64;
+    // 用全分辨率核对的签名代价局部最小值个数
+    const int kVerifyCandidates = 3;
+    // 粗搜索层：签名每 4 条合并为 1 条、采样数降为 1/4，位移搜索量约为原来的 1/64
+    const int kCoarseFactor = 4;
+    // 签名条数少于该值时直接在原层搜索
+    const int kMinCoarseLines = 128;
+
+    // 区域的灰度副本（stride = width）
+    struct GrayFrame {
+        const std::uint8_t* pixels = nullptr;
+        int width = 0;
+        int height = 0;
+
+        ImageView View() const { return ImageView(pixels, width, height, width, PixelFormat::GRAY8); }
+    };
+
+    // 一维位移搜索的结果：按签名代价从小到大排列的局部最小值
+    struct ShiftSearch {
+        std::vector<int> candidates;
+        std::vector<double> costs;  // 搜索层的代价曲线，下标为 shift + maxShift
+        int maxShift = 0;           // 搜索层的最大位移
+        int scale = 1;              // 搜索层一个位移单位对应的像素数
+
+        double Cost(int shift) const { return costs[shift + maxShift]; }
+    };
+
+    Result<ImageView> ResolveRegion(const ImageView& frame, const WindowsAPI::Rectangle& region) {
+        if (region.width() <= 0 || region.height() <= 0) {
+            return Result<ImageView>::Success(frame);
+        }
+        if (region.left < 0 || region.top < 0 || region.right > frame.width || region.bottom > frame.height) {
+            return Result<ImageView>::Error(ErrorCode::INVALID_PARAMETER, L"Region is outside the frame");
+        }
+        return Result<ImageView>::Success(frame.Subview(region));
+    }
+
+    void ToGray(const ImageView& view, std::vector<std::uint8_t>& out) {
+        out.resize(static_cast<size_t>(view.width) * view.height);
+        PixelConvert::ConvertRows(view, PixelFormat::GRAY8, out.data(), view.width);
+    }
+
+    // 行签名：每行等分为 kSignatureSize 段（不足时每像素一段）取平均，结果 height 行连续存放。
+    // 签名只需在两帧之间一致，用整数段边界直接求和，比通用面积缩放（分数权重）快得多
+    int RowSignatures(const GrayFrame& frame, std::vector<std::uint8_t>& out) {
+        const int size = std::min(kSignatureSize, frame.width);
+        out.resize(static_cast<size_t>(size) * frame.height);
+        for (int y = 0; y < frame.height; y++) {
+            const std::uint8_t* row = frame.pixels + static_cast<size_t>(y) * frame.width;
+            std::uint8_t* signature = &out[static_cast<size_t>(y) * size];
+            for (int k = 0; k < size; k++) {
+                const int begin = k * frame.width / size;
+                const int end = (k + 1) * frame.width / size;
+                std::uint32_t sum = 0;
+                for (int x = begin; x < end; x++) {
+                    sum += row[x];
+                }
+                const std::uint32_t count = static_cast<std::uint32_t>(end - begin);
+                signature[k] = static_cast<std::uint8_t>((sum + count / 2) / count);
+            }
+        }
+        return size;
+    }
+
+    // 列签名：每列等分为 kSignatureSize 段取平均，按列连续存放（width 条，每条 size 个采样）
+    int ColumnSignatures(const GrayFrame& frame, std::vector<std::uint8_t>& out) {
+        const int size = std::min(kSignatureSize, frame.height);
+        std::vector<std::uint32_t> sums(frame.width);
+        out.resize(static_cast<size_t>(frame.width) * size);
+        for (int k = 0; k < size; k++) {
+            const int begin = k * frame.height / size;
+            const int end = (k + 1) * frame.height / size;
+            std::fill(sums.begin(), sums.end(), 0u);
+            for (int y = begin; y < end; y++) {
+                const std::uint8_t* row = frame.pixels + static_cast<size_t>(y) * frame.width;
+                for (int x = 0; x < frame.width; x++) {
+                    sums[x] += row[x];
+                }
+            }
+            const std::uint32_t count = static_cast<std::uint32_t>(end - begin);
+            for (int x = 0; x < frame.width; x++) {
+                out[static_cast<size_t>(x) * size + k] = static_cast<std::uint8_t>((sums[x] + count / 2) / count);
+            }
+        }
+        return size;
+    }
+
+    // 当前帧第 i 条签名对应上一帧第 i - shift 条；重叠签名连续存放，一次 SAD 得到平均代价
+    double ShiftCost(const std::uint8_t* previous, const std::uint8_t* current, int lines, int lineLength, int shift) {
+        const int first = std::max(0, shift);
+        const int count = lines - std::abs(shift);
+        const std::uint32_t sad = MatchKernels::GetKernels().sadRow(
+            current + static_cast<size_t>(first) * lineLength, previous + static_cast<size_t>(first - shift) * lineLength,
+            count * lineLength);
+        return static_cast<double>(sad) / (static_cast<double>(count) * lineLength);
+    }
+
+    // 逐个位移计算代价曲线，取局部最小值
+    ShiftSearch SearchShift(const std::uint8_t* previous, const std::uint8_t* current, int lines, int lineLength,
+                            int maxShift) {
+        ShiftSearch search;
+        search.maxShift = maxShift;
+        search.costs.resize(static_cast<size_t>(maxShift) * 2 + 1);
+        for (int shift = -maxShift; shift <= maxShift; shift++) {
+            search.costs[shift + maxShift] = ShiftCost(previous, current, lines, lineLength, shift);
+        }
+
+        // 局部最小值按代价排序，取前几个
+        std::vector<int> minima;
+        for (int shift = -maxShift; shift <= maxShift; shift++) {
+            const double cost = search.Cost(shift);
+            if ((shift == -maxShift || cost <= search.Cost(shift - 1)) &&
+                (shift == maxShift || cost <= search.Cost(shift + 1))) {
+                minima.push_back(shift);
+            }
+        }
+        std::sort(minima.begin(), minima.end(), [&](int a, int b) {
+            return search.Cost(a) < search.Cost(b) || (search.Cost(a) == search.Cost(b) && std::abs(a) < std::abs(b));
+        });
+        if (static_cast<int>(minima.size()) > kVerifyCandidates) {
+            minima.resize(kVerifyCandidates);
+        }
+        search.candidates = std::move(minima);
+        return search;
+    }
+
+    // 先在粗层搜索整个位移范围，再在原层对每个粗候选附近 ±kCoarseFactor 细化
+    ShiftSearch SearchCoarseToFine(const std::vector<std::uint8_t>& previous, const std::vector<std::uint8_t>& current,
+                                   int lines, int lineLength, int maxShift) {
+        const int coarseLines = lines / kCoarseFactor;
+        if (lines < kMinCoarseLines || lineLength < kCoarseFactor) {
+            return SearchShift(previous.data(), current.data(), lines, lineLength, maxShift);
+        }
+
+        // 签名本身是 lineLength x lines 的灰度图，面积平均即得粗层（只取整除部分，粗条与原条严格对齐）
+        const int coarseLength = lineLength / kCoarseFactor;
+        std::vector<std::uint8_t> coarsePrevious(static_cast<size_t>(coarseLength) * coarseLines);
+        std::vector<std::uint8_t> coarseCurrent(coarsePrevious.size());
+        Downscale::DownscaleOptions options;
+        options.multithreaded = false;
+        Downscale::AreaRows(ImageView(previous.data(), lineLength, coarseLines * kCoarseFactor, lineLength, PixelFormat::GRAY8),
+                            coarseLength, coarseLines, coarsePrevious.data(), coarseLength, options);
+        Downscale::AreaRows(ImageView(current.data(), lineLength, coarseLines * kCoarseFactor, lineLength, PixelFormat::GRAY8),
+                            coarseLength, coarseLines, coarseCurrent.data(), coarseLength, options);
+        ShiftSearch search = SearchShift(coarsePrevious.data(), coarseCurrent.data(), coarseLines, coarseLength,
+                                         std::min(maxShift / kCoarseFactor, coarseLines - 1));
+        search.scale = kCoarseFactor;
+
+        for (int& candidate : search.candidates) {
+            const int center = candidate * kCoarseFactor;
+            int best = center;
+            double bestCost = std::numeric_limits<double>::max();
+            for (int shift = std::max(-maxShift, center - kCoarseFactor);
+                 shift <= std::min(maxShift, center + kCoarseFactor); shift++) {
+                const double cost = ShiftCost(previous.data(), current.data(), lines, lineLength, shift);
+                if (cost < bestCost) {
+                    best = shift;
+                    bestCost = cost;
+                }
+            }
+            candidate = best;
+        }
+        return search;
+    }
+
+    // 最佳位移相对其余位移（搜索层相距至少 2）的签名代价优势
+    double Confidence(const ShiftSearch& search, int best) {
+        const int scaled = std::max(-search.maxShift, std::min(search.maxShift,
+            (best + (best >= 0 ? search.scale / 2 : -search.scale / 2)) / search.scale));
+        double other = std::numeric_limits<double>::max();
+        for (int shift = -search.maxShift; shift <= search.maxShift; shift++) {
+            if (std::abs(shift - scaled) >= 2) {
+                other = std::min(other, search.Cost(shift));
+            }
+        }
+        if (other == std::numeric_limits<double>::max() || other <= 0.0) {
+            return 0.0;
+        }
+        return std::max(0.0, 1.0 - search.Cost(scaled) / other);
+    }
+
+    // 全分辨率平均绝对差
+    double FullError(const GrayFrame& previous, const GrayFrame& current, int dx, int dy) {
+        const auto& kernels = MatchKernels::GetKernels();
+        const int x0 = std::max(0, dx);
+        const int width = current.width - std::abs(dx);
+        const int y0 = std::max(0, dy);
+        const int height = current.height - std::abs(dy);
+        std::uint64_t sad = 0;
+        for (int y = y0; y < y0 + height; y++) {
+            sad += kernels.sadRow(current.pixels + static_cast<size_t>(y) * current.width + x0,
+                                  previous.pixels + static_cast<size_t>(y - dy) * previous.width + x0 - dx, width);
+        }
+        return static_cast<double>(sad) / (static_cast<double>(width) * height);
+    }
+
+    int MaxShift(int extent, const MotionOptions& options) {
+        int limit = extent - std::max(1, options.minOverlap);
+        if (options.maxShift > 0) {
+            limit = std::min(limit, options.maxShift);
+        }
+        return limit;
+    }
+
+    // 单方向：签名代价曲线的局部最小值与 0 位移用全分辨率核对；误差相同时保留先核对的候选（0 位移最先）
+    Motion EstimateAxis(const GrayFrame& previous, const GrayFrame& current, bool vertical, int maxShift) {
+        std::vector<std::uint8_t> previousSig;
+        std::vector<std::uint8_t> currentSig;
+        ShiftSearch search;
+        if (vertical) {
+            const int size = RowSignatures(previous, previousSig);
+            RowSignatures(current, currentSig);
+            search = SearchCoarseToFine(previousSig, currentSig, current.height, size, maxShift);
+        } else {
+            const int size = ColumnSignatures(previous, previousSig);
+            ColumnSignatures(current, currentSig);
+            search = SearchCoarseToFine(previousSig, currentSig, current.width, size, maxShift);
+        }
+
+        std::vector<int> candidates = {0};
+        candidates.insert(candidates.end(), search.candidates.begin(), search.candidates.end());
+        Motion best;
+        best.error = std::numeric_limits<double>::max();
+        for (int shift : candidates) {
+            const double error = vertical ? FullError(previous, current, 0, shift) : FullError(previous, current, shift, 0);
+            if (error < best.error) {
+                best.dx = vertical ? 0 : shift;
+                best.dy = vertical ? shift : 0;
+                best.error = error;
+            }
+        }
+        best.confidence = Confidence(search, vertical ? best.dy : best.dx);
+        return best;
+    }
+
+    // 双向：行/列签名对二维位移不可分，改为在上一帧中查找当前帧的五个半尺寸块（四角与中心），
+    // 各块位置给出的候选位移与两个单方向结果一起用全分辨率核对
+    Motion EstimateBoth(const GrayFrame& previous, const GrayFrame& current, int maxDx, int maxDy) {
+        std::vector<std::pair<int, int>> candidates = {{0, 0}};
+        Motion vertical = EstimateAxis(previous, current, true, maxDy);
+        Motion horizontal = EstimateAxis(previous, current, false, maxDx);
+        candidates.emplace_back(vertical.dx, vertical.dy);
+        candidates.emplace_back(horizontal.dx, horizontal.dy);
+
+        const int blockWidth = current.width / 2;
+        const int blockHeight = current.height / 2;
+        const int origins[][2] = {{0, 0}, {blockWidth, 0}, {0, blockHeight}, {blockWidth, blockHeight},
+                                  {blockWidth / 2, blockHeight / 2}};
+        TemplateMatcher::MatchOptions match;
+        match.method = TemplateMatcher::MatchMethod::SAD;
+        match.minScore = -1.0;
+        match.multithreaded = false;
+        for (const auto& origin : origins) {
+            ImageView block = current.View().Subview(WindowsAPI::Rectangle(origin[0], origin[1], origin[0] + blockWidth,
+                                                                           origin[1] + blockHeight));
+            auto found = TemplateMatcher::FindTemplate(previous.View(), block, match);
+            if (found.IsError() || found.GetData().empty()) {
+                continue;
+            }
+            const int dx = origin[0] - found.GetData()[0].location.x;
+            const int dy = origin[1] - found.GetData()[0].location.y;
+            if (std::abs(dx) <= maxDx && std::abs(dy) <= maxDy) {
+                candidates.emplace_back(dx, dy);
+            }
+        }
+
+        std::vector<double> errors;
+        Motion best;
+        best.error = std::numeric_limits<double>::max();
+        for (const auto& candidate : candidates) {
+            errors.push_back(FullError(previous, current, candidate.first, candidate.second));
+            if (errors.back() < best.error) {
+                best.dx = candidate.first;
+                best.dy = candidate.second;
+                best.error = errors.back();
+            }
+        }
+
+        // 置信度：最佳误差相对其余候选（任一方向相距至少 2）的优势
+        double other = std::numeric_limits<double>::max();
+        for (size_t i = 0; i < candidates.size(); i++) {
+            if (std::abs(candidates[i].first - best.dx) >= 2 || std::abs(candidates[i].second - best.dy) >= 2) {
+                other = std::min(other, errors[i]);
+            }
+        }
+        best.confidence = other == std::numeric_limits<double>::max() || other <= 0.0
+                              ? 0.0 : std::max(0.0, 1.0 - best.error / other);
+        return best;
+    }
+
+    // 在两帧灰度区域之间估计位移
+    Result<Motion> EstimateGray(const GrayFrame& previous, const GrayFrame& current, const MotionOptions& options) {
+        const bool vertical = options.axis != Axis::HORIZONTAL;
+        const bool horizontal = options.axis != Axis::VERTICAL;
+        const int maxDy = vertical ? MaxShift(current.height, options) : 0;
+        const int maxDx = horizontal ? MaxShift(current.width, options) : 0;
+        if (maxDy < 0 || maxDx < 0) {
+            return Result<Motion>::Error(ErrorCode::INVALID_PARAMETER, L"Frame is smaller than the minimum overlap");
+        }
+        if (vertical && horizontal) {
+            return Result<Motion>::Success(EstimateBoth(previous, current, maxDx, maxDy));
+        }
+        return Result<Motion>::Success(EstimateAxis(previous, current, vertical, vertical ? maxDy : maxDx));
+    }
+
+    Result<bool> ValidateFrame(const ImageView& frame) {
+        if (frame.IsEmpty()) {
+            return Result<bool>::Error(ErrorCode::INVALID_PARAMETER, L"Empty image");
+        }
+        if (frame.format != PixelFormat::BGRA32 && frame.format != PixelFormat::GRAY8) {
+            return Result<bool>::Error(ErrorCode::INVALID_PARAMETER, L"Unsupported pixel format");
+        }
+        return Result<bool>::Success(true);
+    }
+}
+
+Result<Motion> Estimate(const ImageView& previous, const ImageView& current, const MotionOptions& options) {
+    auto valid = ValidateFrame(previous);
+    if (valid.IsSuccess()) {
+        valid = ValidateFrame(current);
+    }
+    if (valid.IsError()) {
+        return Result<Motion>::Error(valid.GetErrorCode(), valid.GetErrorMessage());
+    }
+    if (previous.width != current.width || previous.height != current.height || previous.format != current.format) {
+        return Result<Motion>::Error(ErrorCode::INVALID_PARAMETER, L"Frame size or format mismatch");
+    }
+    auto previousRegion = ResolveRegion(previous, options.region);
+    auto currentRegion = ResolveRegion(current, options.region);
+    if (previousRegion.IsError()) {
+        return Result<Motion>::Error(previousRegion.GetErrorCode(), previousRegion.GetErrorMessage());
+    }
+
+    std::vector<std::uint8_t> previousGray;
+    std::vector<std::uint8_t> currentGray;
+    ToGray(previousRegion.GetData(), previousGray);
+    ToGray(currentRegion.GetData(), currentGray);
+    const int width = currentRegion.GetData().width;
+    const int height = currentRegion.GetData().height;
+    return EstimateGray({previousGray.data(), width, height}, {currentGray.data(), width, height}, options);
+}
+
+// ============ 长截图拼接 ============
+
+Stitcher::Stitcher(const StitchOptions& options) : m_options(options) {
+    m_options.motion.axis = Axis::VERTICAL;
+}
+
+Result<Motion> Stitcher::Append(const ImageView& frame) {
+    auto valid = ValidateFrame(frame);
+    if (valid.IsError()) {
+        return Result<Motion>::Error(valid.GetErrorCode(), valid.GetErrorMessage());
+    }
+    auto resolved = ResolveRegion(frame, m_options.motion.region);
+    if (resolved.IsError()) {
+        return Result<Motion>::Error(resolved.GetErrorCode(), resolved.GetErrorMessage());
+    }
+    const ImageView& region = resolved.GetData();
+    const int rowBytes = region.width * region.BytesPerPixel();
+
+    // 第一帧：整体复制
+    if (m_frameCount == 0) {
+        m_image = ImageData(region.width, region.height, region.format);
+        for (int y = 0; y < region.height; y++) {
+            std::copy_n(region.Row(y), rowBytes, &m_image.data[static_cast<size_t>(y) * m_image.stride]);
+        }
+        ToGray(region, m_previous);
+        m_frameCount = 1;
+        m_viewTop = 0;
+        return Result<Motion>::Success(Motion());
+    }
+
+    if (region.width != m_image.width || region.format != m_image.format ||
+        static_cast<size_t>(region.width) * region.height != m_previous.size()) {
+        return Result<Motion>::Error(ErrorCode::INVALID_PARAMETER, L"Frame size or format mismatch");
+    }
+
+    ToGray(region, m_current);
+    auto estimated = EstimateGray({m_previous.data(), region.width, region.height},
+                                  {m_current.data(), region.width, region.height}, m_options.motion);
+    if (estimated.IsError()) {
+        return estimated;
+    }
+    const Motion& motion = estimated.GetData();
+    if (motion.error > m_options.maxError) {
+        return Result<Motion>::Error(ErrorCode::OPERATION_FAILED, L"Frame does not overlap the previous frame");
+    }
+    const int viewTop = m_viewTop - motion.dy;
+    if (viewTop < 0) {
+        return Result<Motion>::Error(ErrorCode::OPERATION_FAILED, L"Frame is above the start of the document");
+    }
+
+    // 新露出的行追加到底部（vector 按几何增长，追加为均摊常数）
+    const int bottom = viewTop + region.height;
+    if (bottom > m_image.height) {
+        const int firstNewRow = m_image.height - viewTop;
+        m_image.data.resize(static_cast<size_t>(bottom) * m_image.stride);
+        for (int y = firstNewRow; y < region.height; y++) {
+            std::copy_n(region.Row(y), rowBytes, &m_image.data[static_cast<size_t>(viewTop + y) * m_image.stride]);
+        }
+        m_image.height = bottom;
+    }
+
+    m_previous.swap(m_current);
+    m_viewTop = viewTop;
+    m_frameCount++;
+    return estimated;
+}
+
+ImageData Stitcher::TakeImage() {
+    ImageData image = std::move(m_image);
+    Reset();
+    return image;
+}
+
+void Stitcher::Reset() {
+    m_image = ImageData();
+    m_previous.clear();
+    m_current.clear();
+    m_frameCount = 0;
+    m_viewTop = 0;
+}
+
+}  // namespace ScrollMotion
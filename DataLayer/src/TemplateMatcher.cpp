@@ -0,0 +1,561 @@
+#include "../include/TemplateMatcher.h"
+#include "../include/PixelConvert.h"
+#include "../include/Downscale.h"
+#include "../include/RegionStats.h"
+#include "MatchKernels.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace TemplateMatcher {
+
+// 内部辅助函数
+namespace {
+    // 最粗层保留的候选数下限
+    const int kMinCandidates = 16;
+    // 细化时在上一层候选点周围搜索的半径（像素）
+    const int kRefineRadius = 2;
+    // 使用掩码时，金字塔粗层掩码内至少保留的像素数
+    const int kMinMaskedPixels = 16;
+    
+    // 自有内存的灰度平面（stride = width）
+    struct GrayPlane {
+        std::vector<std::uint8_t> pixels;
+        int width = 0;
+        int height = 0;
+        
+        ImageView View() const {
+            return ImageView(pixels.data(), width, height, width, PixelFormat::GRAY8);
+        }
+    };
+    
+    // BGRA 转灰度（整数近似 BT.601 权重）
+    GrayPlane ToGray(const ImageView& view) {
+        GrayPlane plane;
+        plane.width = view.width;
+        plane.height = view.height;
+        plane.pixels.resize(static_cast<size_t>(view.width) * view.height);
+        PixelConvert::ConvertRows(view, PixelFormat::GRAY8, plane.pixels.data(), view.width);
+        return plane;
+    }
+    
+    // 2x2 盒式滤波降采样
+    GrayPlane Downsample2x(const ImageView& src, bool multithreaded) {
+        GrayPlane plane;
+        plane.width = src.width / 2;
+        plane.height = src.height / 2;
+        plane.pixels.resize(static_cast<size_t>(plane.width) * plane.height);
+        Downscale::DownscaleOptions options;
+        options.multithreaded = multithreaded;
+        Downscale::BoxRows(src, 2, plane.pixels.data(), plane.width, options);
+        return plane;
+    }
+    
+    // MONO1/GRAY8 掩码展开为 0x00/0xFF 字节掩码
+    GrayPlane ToByteMask(const ImageView& mask) {
+        GrayPlane plane;
+        plane.width = mask.width;
+        plane.height = mask.height;
+        plane.pixels.resize(static_cast<size_t>(mask.width) * mask.height);
+        PixelConvert::ConvertRows(mask, PixelFormat::GRAY8, plane.pixels.data(), mask.width);
+        for (auto& p : plane.pixels) {
+            p = p ? 0xFF : 0x00;
+        }
+        return plane;
+    }
+    
+    // 掩码降采样：2x2 块全部在掩码内时保留
+    GrayPlane DownsampleMask(const ImageView& mask, bool multithreaded) {
+        GrayPlane plane = Downsample2x(mask, multithreaded);
+        for (auto& p : plane.pixels) {
+            p = p == 0xFF ? 0xFF : 0x00;
+        }
+        return plane;
+    }
+    
+    int CountMaskedPixels(const GrayPlane& mask) {
+        return static_cast<int>(std::count(mask.pixels.begin(), mask.pixels.end(), 0xFF));
+    }
+    
+    // 计算某一金字塔层上任意位置的得分
+    // 有掩码时模板被掩盖的像素先清零，大图像素在内核中与掩码相与，统计量只包含掩码内像素
+    class Scorer {
+    public:
+        Scorer(const ImageView& haystack, const ImageView& templ, MatchMethod method,
+               const RegionStats::IntegralImage* integral, const ImageView* mask = nullptr)
+            : m_haystack(haystack), m_templ(templ), m_method(method), m_integral(integral), m_mask(mask),
+              m_kernels(MatchKernels::GetKernels()), m_zeros(templ.width, 0) {
+            m_pixelCount = static_cast<double>(templ.width) * templ.height;
+            if (mask) {
+                m_maskedTempl.resize(static_cast<size_t>(templ.width) * templ.height);
+                int count = 0;
+                for (int y = 0; y < templ.height; y++) {
+                    const std::uint8_t* src = templ.Row(y);
+                    const std::uint8_t* m = mask->Row(y);
+                    std::uint8_t* dst = &m_maskedTempl[static_cast<size_t>(y) * templ.width];
+                    for (int x = 0; x < templ.width; x++) {
+                        dst[x] = src[x] & m[x];
+                        count += m[x] ? 1 : 0;
+                    }
+                }
+                m_pixelCount = static_cast<double>(count);
+            }
+            if (method == MatchMethod::NCC) {
+                std::uint64_t sum = 0;
+                std::uint64_t sumSq = 0;
+                for (int y = 0; y < templ.height; y++) {
+                    const std::uint8_t* row = TemplRow(y);
+                    sum += m_kernels.sadRow(row, m_zeros.data(), templ.width);
+                    sumSq += m_kernels.dotRow(row, row, templ.width);
+                }
+                m_templSum = static_cast<double>(sum);
+                m_templVariance = static_cast<double>(sumSq) - m_templSum * m_templSum / m_pixelCount;
+            }
+        }
+        
+        double Score(int x, int y) const {
+            if (m_mask) {
+                return ScoreMasked(x, y);
+            }
+            const int w = m_templ.width;
+            const int h = m_templ.height;
+            switch (m_method) {
+                case MatchMethod::SAD: {
+                    std::uint64_t sad = 0;
+                    for (int r = 0; r < h; r++) {
+                        sad += m_kernels.sadRow(m_haystack.Row(y + r) + x, m_templ.Row(r), w);
+                    }
+                    return 1.0 - static_cast<double>(sad) / (255.0 * m_pixelCount);
+                }
+                case MatchMethod::SSD: {
+                    std::uint64_t ssd = 0;
+                    for (int r = 0; r < h; r++) {
+                        ssd += m_kernels.ssdRow(m_haystack.Row(y + r) + x, m_templ.Row(r), w);
+                    }
+                    return 1.0 - static_cast<double>(ssd) / (255.0 * 255.0 * m_pixelCount);
+                }
+                default:
+                    return ScoreNcc(x, y);
+            }
+        }
+        
+    private:
+        const std::uint8_t* TemplRow(int y) const {
+            return m_mask ? &m_maskedTempl[static_cast<size_t>(y) * m_templ.width] : m_templ.Row(y);
+        }
+        
+        double ScoreMasked(int x, int y) const {
+            const int w = m_templ.width;
+            const int h = m_templ.height;
+            switch (m_method) {
+                case MatchMethod::SAD: {
+                    std::uint64_t sad = 0;
+                    for (int r = 0; r < h; r++) {
+                        sad += m_kernels.maskedSadRow(m_haystack.Row(y + r) + x, TemplRow(r), m_mask->Row(r), w);
+                    }
+                    return 1.0 - static_cast<double>(sad) / (255.0 * m_pixelCount);
+                }
+                case MatchMethod::SSD: {
+                    std::uint64_t ssd = 0;
+                    for (int r = 0; r < h; r++) {
+                        ssd += m_kernels.maskedSsdRow(m_haystack.Row(y + r) + x, TemplRow(r), m_mask->Row(r), w);
+                    }
+                    return 1.0 - static_cast<double>(ssd) / (255.0 * 255.0 * m_pixelCount);
+                }
+                default: {
+                    std::uint64_t dot = 0;
+                    std::uint64_t sum = 0;
+                    std::uint64_t sumSq = 0;
+                    for (int r = 0; r < h; r++) {
+                        MatchKernels::MaskedStats stats =
+                            m_kernels.maskedStatsRow(m_haystack.Row(y + r) + x, TemplRow(r), m_mask->Row(r), w);
+                        dot += stats.dot;
+                        sum += stats.sum;
+                        sumSq += stats.sumSq;
+                    }
+                    return MatchKernels::NccScore(static_cast<double>(dot), static_cast<double>(sum),
+                                                  static_cast<double>(sumSq), m_templSum, m_templVariance, m_pixelCount);
+                }
+            }
+        }
+        
+        double ScoreNcc(int x, int y) const {
+            const int w = m_templ.width;
+            const int h = m_templ.height;
+            std::uint64_t dot = 0;
+            std::uint64_t sum = 0;
+            std::uint64_t sumSq = 0;
+            if (m_integral) {
+                sum = m_integral->Sum(x, y, w, h);
+                sumSq = m_integral->SumOfSquares(x, y, w, h);
+                for (int r = 0; r < h; r++) {
+                    dot += m_kernels.dotRow(m_haystack.Row(y + r) + x, m_templ.Row(r), w);
+                }
+            } else {
+                for (int r = 0; r < h; r++) {
+                    const std::uint8_t* row = m_haystack.Row(y + r) + x;
+                    dot += m_kernels.dotRow(row, m_templ.Row(r), w);
+                    sum += m_kernels.sadRow(row, m_zeros.data(), w);
+                    sumSq += m_kernels.dotRow(row, row, w);
+                }
+            }
+            
+            return MatchKernels::NccScore(static_cast<double>(dot), static_cast<double>(sum), static_cast<double>(sumSq),
+                                          m_templSum, m_templVariance, m_pixelCount);
+        }
+        
+    private:
+        const ImageView& m_haystack;
+        const ImageView& m_templ;
+        MatchMethod m_method;
+        const RegionStats::IntegralImage* m_integral;
+        const ImageView* m_mask;
+        const MatchKernels::KernelSet& m_kernels;
+        std::vector<std::uint8_t> m_zeros;
+        std::vector<std::uint8_t> m_maskedTempl;    // 按掩码清零的模板（stride = width）
+        double m_pixelCount = 0.0;
+        double m_templSum = 0.0;
+        double m_templVariance = 0.0;
+    };
+    
+    // 全图搜索：计算得分图并提取局部极大值中得分最高的若干个
+    std::vector<Match> SearchExhaustive(const ImageView& haystack, const ImageView& templ, const ImageView* mask,
+                                        const MatchOptions& options, int candidateCount) {
+        const int rangeX = haystack.width - templ.width + 1;
+        const int rangeY = haystack.height - templ.height + 1;
+        
+        RegionStats::IntegralImage integral;
+        if (options.method == MatchMethod::NCC && !mask) {
+            auto built = RegionStats::IntegralImage::Build(haystack);
+            if (built.IsSuccess()) {
+                integral = std::move(built).TakeData();
+            }
+        }
+        Scorer scorer(haystack, templ, options.method, integral.GetWidth() > 0 ? &integral : nullptr, mask);
+        
+        std::vector<float> scores(static_cast<size_t>(rangeX) * rangeY);
+        auto scoreRows = [&](int rowBegin, int rowEnd) {
+            for (int y = rowBegin; y < rowEnd; y++) {
+                float* out = &scores[static_cast<size_t>(y) * rangeX];
+                for (int x = 0; x < rangeX; x++) {
+                    out[x] = static_cast<float>(scorer.Score(x, y));
+                }
+            }
+        };
+        
+        if (options.multithreaded) {
+            ThreadPool::GetDefault().ParallelFor(0, rangeY, scoreRows);
+        } else {
+            scoreRows(0, rangeY);
+        }
+        
+        // 3x3 邻域内的局部极大值
+        std::vector<Match> peaks;
+        for (int y = 0; y < rangeY; y++) {
+            for (int x = 0; x < rangeX; x++) {
+                float value = scores[static_cast<size_t>(y) * rangeX + x];
+                bool isPeak = true;
+                for (int dy = -1; dy <= 1 && isPeak; dy++) {
+                    int ny = y + dy;
+                    if (ny < 0 || ny >= rangeY) {
+                        continue;
+                    }
+                    for (int dx = -1; dx <= 1; dx++) {
+                        int nx = x + dx;
+                        if ((dx == 0 && dy == 0) || nx < 0 || nx >= rangeX) {
+                            continue;
+                        }
+                        if (scores[static_cast<size_t>(ny) * rangeX + nx] > value) {
+                            isPeak = false;
+                            break;
+                        }
+                    }
+                }
+                if (isPeak) {
+                    Match match;
+                    match.location = WindowsAPI::Point(x, y);
+                    match.score = value;
+                    peaks.push_back(match);
+                }
+            }
+        }
+        
+        auto byScore = [](const Match& a, const Match& b) { return a.score > b.score; };
+        if (static_cast<int>(peaks.size()) > candidateCount) {
+            std::partial_sort(peaks.begin(), peaks.begin() + candidateCount, peaks.end(), byScore);
+            peaks.resize(candidateCount);
+        } else {
+            std::sort(peaks.begin(), peaks.end(), byScore);
+        }
+        return peaks;
+    }
+    
+    // 在上一层候选点（坐标已放大2倍）附近细化
+    void RefineCandidates(const ImageView& haystack, const ImageView& templ, const ImageView* mask,
+                          const MatchOptions& options, std::vector<Match>& candidates) {
+        const int maxX = haystack.width - templ.width;
+        const int maxY = haystack.height - templ.height;
+        Scorer scorer(haystack, templ, options.method, nullptr, mask);
+        
+        auto refine = [&](int begin, int end) {
+            for (int i = begin; i < end; i++) {
+                Match& candidate = candidates[i];
+                int centerX = candidate.location.x * 2;
+                int centerY = candidate.location.y * 2;
+                Match best;
+                best.score = -2.0;
+                for (int y = std::max(0, centerY - kRefineRadius); y <= std::min(maxY, centerY + kRefineRadius); y++) {
+                    for (int x = std::max(0, centerX - kRefineRadius); x <= std::min(maxX, centerX + kRefineRadius); x++) {
+                        double score = scorer.Score(x, y);
+                        if (score > best.score) {
+                            best.score = score;
+                            best.location = WindowsAPI::Point(x, y);
+                        }
+                    }
+                }
+                candidate = best;
+            }
+        };
+        
+        if (options.multithreaded) {
+            ThreadPool::GetDefault().ParallelFor(0, static_cast<int>(candidates.size()), refine);
+        } else {
+            refine(0, static_cast<int>(candidates.size()));
+        }
+    }
+    
+    // 按得分过滤并做非极大值抑制
+    std::vector<Match> SelectMatches(std::vector<Match> candidates, int templWidth, int templHeight,
+                                     const MatchOptions& options) {
+        std::sort(candidates.begin(), candidates.end(),
+                  [](const Match& a, const Match& b) { return a.score > b.score; });
+        
+        const int minDistanceX = std::max(1, templWidth / 2);
+        const int minDistanceY = std::max(1, templHeight / 2);
+        std::vector<Match> selected;
+        for (const auto& candidate : candidates) {
+            if (candidate.score < options.minScore || static_cast<int>(selected.size()) >= options.maxResults) {
+                break;
+            }
+            bool overlaps = false;
+            for (const auto& accepted : selected) {
+                if (std::abs(accepted.location.x - candidate.location.x) < minDistanceX &&
+                    std::abs(accepted.location.y - candidate.location.y) < minDistanceY) {
+                    overlaps = true;
+                    break;
+                }
+            }
+            if (!overlaps) {
+                selected.push_back(candidate);
+            }
+        }
+        return selected;
+    }
+    
+    int ChoosePyramidLevels(const ImageView& haystack, const ImageView& templ, const MatchOptions& options) {
+        const int maxLevels = 6;
+        int limit = options.pyramidLevels > 0 ? options.pyramidLevels : maxLevels;
+        int minSize = std::max(1, options.minPyramidTemplateSize);
+        int levels = 1;
+        while (levels < limit && (templ.width >> levels) >= minSize && (templ.height >> levels) >= minSize &&
+               (haystack.width >> levels) >= (templ.width >> levels) &&
+               (haystack.height >> levels) >= (templ.height >> levels)) {
+            levels++;
+        }
+        return levels;
+    }
+    
+    // 去掉一像素边框：幅值图边界按复制边缘计算，与模板在大图内部时的值不一致。
+    // 模板内部左上角在大图内部视图中的坐标就是模板在原图中的坐标，匹配位置不变
+    ImageView Interior(const ImageView& view) {
+        return view.Subview(WindowsAPI::Rectangle(1, 1, view.width - 1, view.height - 1));
+    }
+    
+    // 计算 EDGES 使用的幅值图，把 haystackLevel0/templLevel0 替换为幅值图内部；
+    // 模板优先从缓存获取（以调用方传入的模板为键），mask 非空时 edgeMask 为掩码内部
+    Result<bool> PrepareEdges(const ImageView& templ, const GrayPlane* mask,
+                              ImageView& haystackLevel0, ImageView& templLevel0, const MatchOptions& options,
+                              ImageData& haystackEdges, ImageData& templEdges, GrayPlane& edgeMask) {
+        EdgeMap::EdgeOptions edgeOptions;
+        edgeOptions.op = options.edgeOperator;
+        edgeOptions.multithreaded = options.multithreaded;
+        
+        ImageView templMap;
+        if (options.edgeCache) {
+            auto cached = options.edgeCache->Get(options.edgeTemplateId, templ);
+            if (cached.IsError()) {
+                return Result<bool>::Error(cached.GetErrorCode(), cached.GetErrorMessage());
+            }
+            templMap = cached.GetData();
+        } else {
+            auto computed = EdgeMap::ComputeMagnitude(templLevel0, edgeOptions);
+            if (computed.IsError()) {
+                return Result<bool>::Error(computed.GetErrorCode(), computed.GetErrorMessage());
+            }
+            templEdges = std::move(computed).TakeData();
+            templMap = ImageView(templEdges);
+        }
+        auto computed = EdgeMap::ComputeMagnitude(haystackLevel0, edgeOptions);
+        if (computed.IsError()) {
+            return Result<bool>::Error(computed.GetErrorCode(), computed.GetErrorMessage());
+        }
+        haystackEdges = std::move(computed).TakeData();
+        haystackLevel0 = Interior(ImageView(haystackEdges));
+        templLevel0 = Interior(templMap);
+        
+        if (mask) {
+            ImageView inner = Interior(mask->View());
+            edgeMask.width = inner.width;
+            edgeMask.height = inner.height;
+            edgeMask.pixels.resize(static_cast<size_t>(inner.width) * inner.height);
+            for (int y = 0; y < inner.height; y++) {
+                std::copy(inner.Row(y), inner.Row(y) + inner.width,
+                          edgeMask.pixels.begin() + static_cast<size_t>(y) * inner.width);
+            }
+            if (CountMaskedPixels(edgeMask) == 0) {
+                return Result<bool>::Error(ErrorCode::INVALID_PARAMETER, L"Mask is empty inside the template border");
+            }
+        }
+        return Result<bool>::Success(true);
+    }
+    
+    // 校验输入并执行金字塔搜索；mask 为与模板同尺寸的字节掩码或 nullptr
+    Result<std::vector<Match>> Find(const ImageView& haystack, const ImageView& templ, const GrayPlane* mask,
+                                    const MatchOptions& options) {
+        // 第0层：灰度输入直接引用，BGRA 输入先转灰度
+        GrayPlane haystackGray;
+        GrayPlane templGray;
+        ImageView haystackLevel0 = haystack;
+        ImageView templLevel0 = templ;
+        if (haystack.format == PixelFormat::BGRA32) {
+            haystackGray = ToGray(haystack);
+            haystackLevel0 = haystackGray.View();
+        }
+        if (templ.format == PixelFormat::BGRA32) {
+            templGray = ToGray(templ);
+            templLevel0 = templGray.View();
+        }
+        
+        // EDGES：改为在幅值图上匹配
+        ImageData haystackEdges;
+        ImageData templEdges;
+        GrayPlane edgeMask;
+        if (options.features == MatchFeatures::EDGES) {
+            auto edges = PrepareEdges(templ, mask, haystackLevel0, templLevel0, options,
+                                      haystackEdges, templEdges, edgeMask);
+            if (edges.IsError()) {
+                return Result<std::vector<Match>>::Error(edges.GetErrorCode(), edges.GetErrorMessage());
+            }
+            if (mask) {
+                mask = &edgeMask;
+            }
+        }
+        
+        // 构建金字塔；掩码内像素过少的粗层不使用
+        int levels = ChoosePyramidLevels(haystackLevel0, templLevel0, options);
+        std::vector<GrayPlane> maskPlanes;
+        std::vector<ImageView> maskPyramid;
+        if (mask) {
+            maskPlanes.resize(levels);
+            maskPyramid.push_back(mask->View());
+            for (int level = 1; level < levels; level++) {
+                maskPlanes[level] = DownsampleMask(maskPyramid.back(), options.multithreaded);
+                if (CountMaskedPixels(maskPlanes[level]) < kMinMaskedPixels) {
+                    levels = level;
+                    break;
+                }
+                maskPyramid.push_back(maskPlanes[level].View());
+            }
+        }
+        std::vector<GrayPlane> haystackPlanes(levels);
+        std::vector<GrayPlane> templPlanes(levels);
+        std::vector<ImageView> haystackPyramid = {haystackLevel0};
+        std::vector<ImageView> templPyramid = {templLevel0};
+        for (int level = 1; level < levels; level++) {
+            haystackPlanes[level] = Downsample2x(haystackPyramid.back(), options.multithreaded);
+            templPlanes[level] = Downsample2x(templPyramid.back(), options.multithreaded);
+            haystackPyramid.push_back(haystackPlanes[level].View());
+            templPyramid.push_back(templPlanes[level].View());
+        }
+        auto maskAt = [&](int level) { return mask ? &maskPyramid[level] : nullptr; };
+        
+        // 最粗层全图搜索，然后逐层细化
+        int candidateCount = std::max(kMinCandidates, options.maxResults * 4);
+        std::vector<Match> candidates = SearchExhaustive(haystackPyramid[levels - 1], templPyramid[levels - 1],
+                                                         maskAt(levels - 1), options, candidateCount);
+        for (int level = levels - 2; level >= 0; level--) {
+            RefineCandidates(haystackPyramid[level], templPyramid[level], maskAt(level), options, candidates);
+        }
+        
+        return Result<std::vector<Match>>::Success(
+            SelectMatches(std::move(candidates), templ.width, templ.height, options));
+    }
+    
+    Result<bool> ValidateInput(const ImageView& haystack, const ImageView& templ, const MatchOptions& options) {
+        if (haystack.IsEmpty() || templ.IsEmpty()) {
+            return Result<bool>::Error(ErrorCode::INVALID_PARAMETER, L"Empty image");
+        }
+        if ((haystack.format != PixelFormat::BGRA32 && haystack.format != PixelFormat::GRAY8) ||
+            (templ.format != PixelFormat::BGRA32 && templ.format != PixelFormat::GRAY8)) {
+            return Result<bool>::Error(ErrorCode::INVALID_PARAMETER, L"Unsupported pixel format");
+        }
+        if (templ.width > haystack.width || templ.height > haystack.height) {
+            return Result<bool>::Error(ErrorCode::INVALID_PARAMETER, L"Template is larger than haystack");
+        }
+        if (options.maxResults <= 0) {
+            return Result<bool>::Error(ErrorCode::INVALID_PARAMETER, L"Invalid max results");
+        }
+        if (options.features == MatchFeatures::EDGES) {
+            if (templ.width < 3 || templ.height < 3) {
+                return Result<bool>::Error(ErrorCode::INVALID_PARAMETER, L"Edge matching needs a template of at least 3x3");
+            }
+            if (options.edgeCache && options.edgeCache->GetOperator() != options.edgeOperator) {
+                return Result<bool>::Error(ErrorCode::INVALID_PARAMETER, L"Edge cache operator does not match options");
+            }
+            if (options.edgeCache && options.edgeTemplateId < 0) {
+                return Result<bool>::Error(ErrorCode::INVALID_PARAMETER, L"Edge cache needs a template id");
+            }
+        }
+        return Result<bool>::Success(true);
+    }
+}
+
+Result<std::vector<Match>> FindTemplate(const ImageView& haystack, const ImageView& templ,
+                                        const MatchOptions& options) {
+    if (options.useAlphaMask && templ.format == PixelFormat::BGRA32) {
+        auto mask = PixelConvert::CreateMask(templ, PixelConvert::MaskChannel::ALPHA, options.alphaThreshold);
+        if (mask.IsError()) {
+            return Result<std::vector<Match>>::Error(mask.GetErrorCode(), mask.GetErrorMessage());
+        }
+        return FindTemplate(haystack, templ, ImageView(mask.GetData()), options);
+    }
+    
+    auto valid = ValidateInput(haystack, templ, options);
+    if (valid.IsError()) {
+        return Result<std::vector<Match>>::Error(valid.GetErrorCode(), valid.GetErrorMessage());
+    }
+    return Find(haystack, templ, nullptr, options);
+}
+
+Result<std::vector<Match>> FindTemplate(const ImageView& haystack, const ImageView& templ, const ImageView& mask,
+                                        const MatchOptions& options) {
+    auto valid = ValidateInput(haystack, templ, options);
+    if (valid.IsError()) {
+        return Result<std::vector<Match>>::Error(valid.GetErrorCode(), valid.GetErrorMessage());
+    }
+    if (mask.format != PixelFormat::MONO1 && mask.format != PixelFormat::GRAY8) {
+        return Result<std::vector<Match>>::Error(ErrorCode::INVALID_PARAMETER, L"Unsupported mask format");
+    }
+    if (mask.width != templ.width || mask.height != templ.height) {
+        return Result<std::vector<Match>>::Error(ErrorCode::INVALID_PARAMETER, L"Mask size does not match template");
+    }
+    
+    GrayPlane byteMask = ToByteMask(mask);
+    if (CountMaskedPixels(byteMask) == 0) {
+        return Result<std::vector<Match>>::Error(ErrorCode::INVALID_PARAMETER, L"Mask is empty");
+    }
+    return Find(haystack, templ, &byteMask, options);
+}
+
+}  // namespace TemplateMatcher
@@ -0,0 +1,191 @@
+#include "../include/TextInput.h"
+
+namespace TextInput {
+
+// 内部辅助函数
+namespace {
+    const std::uint32_t kZeroWidthJoiner = 0x200D;
+
+    bool IsHighSurrogate(std::uint32_t unit) { return unit >= 0xD800 && unit <= 0xDBFF; }
+    bool IsLowSurrogate(std::uint32_t unit) { return unit >= 0xDC00 && unit <= 0xDFFF; }
+    bool IsRegionalIndicator(std::uint32_t codePoint) { return codePoint >= 0x1F1E6 && codePoint <= 0x1F1FF; }
+
+    // 附着在前一个字符上、不能与它拆开的码位（IME 与字体按整个序列组字）
+    bool IsExtending(std::uint32_t codePoint) {
+        return (codePoint >= 0x0300 && codePoint <= 0x036F)      // 组合附加符号
+            || (codePoint >= 0x1160 && codePoint <= 0x11FF)      // 谚文中声与终声字母
+            || (codePoint >= 0x1AB0 && codePoint <= 0x1AFF)
+            || (codePoint >= 0x1DC0 && codePoint <= 0x1DFF)
+            || (codePoint >= 0x20D0 && codePoint <= 0x20FF)
+            || (codePoint >= 0x3099 && codePoint <= 0x309A)      // 组合用浊点、半浊点
+            || (codePoint >= 0xFE00 && codePoint <= 0xFE0F)      // 变体选择符
+            || (codePoint >= 0xFE20 && codePoint <= 0xFE2F)
+            || (codePoint >= 0x1F3FB && codePoint <= 0x1F3FF)    // 肤色修饰符
+            || (codePoint >= 0xE0020 && codePoint <= 0xE007F)    // 旗帜标签字符
+            || (codePoint >= 0xE0100 && codePoint <= 0xE01EF)    // 补充变体选择符
+            || codePoint == kZeroWidthJoiner;
+    }
+
+    // 追加码位的 UTF-16 码元
+    void AppendUtf16(std::uint32_t codePoint, std::wstring& out) {
+        if (codePoint >= 0x10000) {
+            codePoint -= 0x10000;
+            out.push_back(static_cast<wchar_t>(0xD800 + (codePoint >> 10)));
+            out.push_back(static_cast<wchar_t>(0xDC00 + (codePoint & 0x3FF)));
+        } else {
+            out.push_back(static_cast<wchar_t>(codePoint));
+        }
+    }
+
+    // 码位在消息序列中占的 UTF-16 码元数（编辑控件模式下换行为 \r\n）
+    size_t Utf16Length(std::uint32_t codePoint, TextMode mode) {
+        if (codePoint == L'\r') {
+            return (mode == TextMode::REPLACE_SELECTION || mode == TextMode::SET_TEXT) ? 2 : 1;
+        }
+        return codePoint >= 0x10000 ? 2 : 1;
+    }
+
+    /**
+     * @brief 解码为码位并统一换行：\r\n、\r、\n 都变为一个 \r
+     *
+     * 同时接受 UTF-16（Windows）与 UTF-32（wchar_t 为 32 位的平台）输入。
+     */
+    Result<std::vector<std::uint32_t>> Decode(const std::wstring& text) {
+        std::vector<std::uint32_t> codePoints;
+        codePoints.reserve(text.size());
+        for (size_t i = 0; i < text.size(); i++) {
+            const std::uint32_t unit = static_cast<std::uint32_t>(text[i]);
+            if (IsHighSurrogate(unit)) {
+                const std::uint32_t next = i + 1 < text.size() ? static_cast<std::uint32_t>(text[i + 1]) : 0;
+                if (!IsLowSurrogate(next)) {
+                    return Result<std::vector<std::uint32_t>>::Error(ErrorCode::INVALID_PARAMETER,
+                                                                     L"Unpaired high surrogate at " + std::to_wstring(i));
+                }
+                codePoints.push_back(0x10000 + ((unit - 0xD800) << 10) + (next - 0xDC00));
+                i++;
+            } else if (IsLowSurrogate(unit)) {
+                return Result<std::vector<std::uint32_t>>::Error(ErrorCode::INVALID_PARAMETER,
+                                                                 L"Unpaired low surrogate at " + std::to_wstring(i));
+            } else if (unit > 0x10FFFF) {
+                return Result<std::vector<std::uint32_t>>::Error(ErrorCode::INVALID_PARAMETER,
+                                                                 L"Invalid code point at " + std::to_wstring(i));
+            } else if (unit == L'\r' || unit == L'\n') {
+                codePoints.push_back(L'\r');
+                if (unit == L'\r' && i + 1 < text.size() && text[i + 1] == L'\n') {
+                    i++;
+                }
+            } else {
+                codePoints.push_back(unit);
+            }
+        }
+        return Result<std::vector<std::uint32_t>>::Success(std::move(codePoints));
+    }
+
+    // 追加一个字符的消息或文本
+    void AppendCharacter(std::uint32_t codePoint, TextPlan& plan) {
+        switch (plan.mode) {
+            case TextMode::CHAR_STREAM:
+            case TextMode::KEY_STROKES: {
+                std::wstring units;
+                AppendUtf16(codePoint, units);
+                const std::uint32_t virtualKey = VirtualKeyFor(codePoint);
+                if (plan.mode == TextMode::KEY_STROKES) {
+                    plan.events.push_back(InputEvent::KeyDown(virtualKey));
+                }
+                for (wchar_t unit : units) {
+                    plan.events.push_back(InputEvent::Char(unit));
+                }
+                if (plan.mode == TextMode::KEY_STROKES) {
+                    plan.events.push_back(InputEvent::KeyUp(virtualKey));
+                }
+                break;
+            }
+            case TextMode::REPLACE_SELECTION:
+            case TextMode::SET_TEXT:
+                // 多行编辑控件只认 \r\n
+                if (codePoint == L'\r') {
+                    plan.text += L"\r\n";
+                } else {
+                    AppendUtf16(codePoint, plan.text);
+                }
+                break;
+        }
+    }
+
+    size_t PlanLength(const TextPlan& plan) {
+        return (plan.mode == TextMode::CHAR_STREAM || plan.mode == TextMode::KEY_STROKES) ? plan.events.size()
+                                                                                          : plan.text.size();
+    }
+}
+
+std::uint32_t VirtualKeyFor(std::uint32_t codePoint) {
+    if (codePoint >= L'a' && codePoint <= L'z') {
+        return codePoint - (L'a' - L'A');
+    }
+    if ((codePoint >= L'A' && codePoint <= L'Z') || (codePoint >= L'0' && codePoint <= L'9') || codePoint == L' ') {
+        return codePoint;
+    }
+    switch (codePoint) {
+        case L'\r':
+        case L'\n': return 0x0D;    // VK_RETURN
+        case L'\t': return 0x09;    // VK_TAB
+        case L'\b': return 0x08;    // VK_BACK
+        default: return kVirtualKeyPacket;
+    }
+}
+
+Result<TextPlan> BuildPlan(const std::wstring& text, const TextOptions& options) {
+    if (options.chunkSize < 1 || options.chunkDelayMs < 0 || options.timeoutMs < 1) {
+        return Result<TextPlan>::Error(ErrorCode::INVALID_PARAMETER, L"Invalid text input options");
+    }
+    auto decoded = Decode(text);
+    if (decoded.IsError()) {
+        return Result<TextPlan>::Error(decoded.GetErrorCode(), decoded.GetErrorMessage());
+    }
+    const std::vector<std::uint32_t> codePoints = std::move(decoded).TakeData();
+
+    TextPlan plan;
+    plan.mode = options.mode;
+    plan.characterCount = codePoints.size();
+    const size_t eventsPerUnit = options.mode == TextMode::KEY_STROKES ? 3 : 1;
+    plan.events.reserve(options.mode == TextMode::CHAR_STREAM || options.mode == TextMode::KEY_STROKES
+                        ? codePoints.size() * eventsPerUnit : 0);
+
+    // 按字符序列（基字符加其后附着的码位）切块，块长按 UTF-16 码元计
+    const size_t chunkSize = static_cast<size_t>(options.chunkSize);
+    size_t chunkUnits = 0;
+    size_t i = 0;
+    while (i < codePoints.size()) {
+        size_t end = i + 1;
+        size_t clusterUnits = Utf16Length(codePoints[i], options.mode);
+        bool joined = codePoints[i] == kZeroWidthJoiner;
+        while (end < codePoints.size()) {
+            const std::uint32_t next = codePoints[end];
+            // 两个区域指示符组成一面国旗
+            const bool flagPair = end == i + 1 && IsRegionalIndicator(codePoints[i]) && IsRegionalIndicator(next);
+            if (!joined && !IsExtending(next) && !flagPair) {
+                break;
+            }
+            joined = next == kZeroWidthJoiner;
+            clusterUnits += Utf16Length(next, options.mode);
+            end++;
+        }
+
+        if (options.mode != TextMode::SET_TEXT && chunkUnits > 0 && chunkUnits + clusterUnits > chunkSize) {
+            plan.chunkEnds.push_back(PlanLength(plan));
+            chunkUnits = 0;
+        }
+        for (size_t k = i; k < end; k++) {
+            AppendCharacter(codePoints[k], plan);
+        }
+        chunkUnits += clusterUnits;
+        i = end;
+    }
+    // WM_SETTEXT 对空文本也发送一次（清空控件）
+    if (chunkUnits > 0 || options.mode == TextMode::SET_TEXT) {
+        plan.chunkEnds.push_back(PlanLength(plan));
+    }
+    return Result<TextPlan>::Success(std::move(plan));
+}
+
+}  // namespace TextInput
@@ -0,0 +1,132 @@
+#include "../include/Win32InputSink.h"
+#include <windows.h>
+
+namespace InputDispatcher {
+
+// 内部辅助函数
+namespace {
+    // 构建键盘消息的LPARAM：扫描码、扩展键标志，假设之前未按下
+    LPARAM MakeKeyLParam(UINT virtualKey, bool keyUp) {
+        LPARAM lParam = 1; // 重复计数
+        lParam |= (MapVirtualKey(virtualKey, MAPVK_VK_TO_VSC) & 0xFF) << 16; // 扫描码
+        switch (virtualKey) {
+            case VK_INSERT: case VK_DELETE: case VK_HOME: case VK_END:
+            case VK_PRIOR: case VK_NEXT: case VK_LEFT: case VK_RIGHT: case VK_UP: case VK_DOWN:
+            case VK_RCONTROL: case VK_RMENU: case VK_LWIN: case VK_RWIN: case VK_APPS:
+                lParam |= 0x01000000; // 扩展键标志
+                break;
+            default:
+                break;
+        }
+        if (keyUp) lParam |= 0x80000000; // 键释放标志
+        lParam |= 0x20000000;
+        return lParam;
+    }
+
+    UINT ButtonMessage(MouseButton button, bool down) {
+        switch (button) {
+            case MouseButton::RIGHT: return down ? WM_RBUTTONDOWN : WM_RBUTTONUP;
+            case MouseButton::MIDDLE: return down ? WM_MBUTTONDOWN : WM_MBUTTONUP;
+            case MouseButton::X1:
+            case MouseButton::X2: return down ? WM_XBUTTONDOWN : WM_XBUTTONUP;
+            default: return down ? WM_LBUTTONDOWN : WM_LBUTTONUP;
+        }
+    }
+
+    WPARAM ButtonFlags(MouseButton button) {
+        switch (button) {
+            case MouseButton::RIGHT: return MK_RBUTTON;
+            case MouseButton::MIDDLE: return MK_MBUTTON;
+            case MouseButton::X1: return MK_XBUTTON1 | MAKEWPARAM(0, XBUTTON1);
+            case MouseButton::X2: return MK_XBUTTON2 | MAKEWPARAM(0, XBUTTON2);
+            default: return MK_LBUTTON;
+        }
+    }
+
+    // 移动消息只带实际按住的按键
+    WPARAM HeldFlags(std::uint8_t held) {
+        WPARAM flags = 0;
+        for (MouseButton button : {MouseButton::LEFT, MouseButton::RIGHT, MouseButton::MIDDLE,
+                                   MouseButton::X1, MouseButton::X2}) {
+            if (held & HeldMask(button)) {
+                flags |= LOWORD(ButtonFlags(button));
+            }
+        }
+        return flags;
+    }
+
+    class Win32Sink : public InputSink {
+    public:
+        Result<bool> BeginBatch(WindowHandle window) override {
+            if (!IsWindow(static_cast<HWND>(window))) {
+                return Result<bool>::Error(ErrorCode::INVALID_HANDLE, L"Invalid window handle");
+            }
+            m_modifiers = 0;
+            if (GetAsyncKeyState(VK_CONTROL) & 0x8000) m_modifiers |= MK_CONTROL;
+            if (GetAsyncKeyState(VK_SHIFT) & 0x8000) m_modifiers |= MK_SHIFT;
+            return Result<bool>::Success(true);
+        }
+
+        Result<bool> Deliver(WindowHandle window, const InputEvent& event, Delivery delivery) override {
+            const WindowMessage built = ToWindowMessage(event, m_modifiers);
+            HWND handle = static_cast<HWND>(window);
+            if (delivery == Delivery::POST) {
+                if (!PostMessage(handle, built.message, built.wParam, built.lParam)) {
+                    return Result<bool>::Error(ErrorCode::INPUT_SIMULATION_FAILED, L"PostMessage failed");
+                }
+            } else {
+                SendMessage(handle, built.message, built.wParam, built.lParam);
+            }
+            return Result<bool>::Success(true);
+        }
+
+    private:
+        WPARAM m_modifiers = 0;
+    };
+}
+
+WindowMessage ToWindowMessage(const InputEvent& event, WPARAM modifiers) {
+    WindowMessage built;
+    built.lParam = MAKELPARAM(event.x, event.y);
+    switch (event.type) {
+        case EventType::KEY_DOWN:
+        case EventType::KEY_UP:
+            built.message = event.type == EventType::KEY_DOWN ? WM_KEYDOWN : WM_KEYUP;
+            built.wParam = event.code;
+            built.lParam = MakeKeyLParam(event.code, event.type == EventType::KEY_UP);
+            break;
+        case EventType::CHAR:
+            built.message = WM_CHAR;
+            built.wParam = event.code;
+            built.lParam = 1;
+            break;
+        case EventType::MOUSE_MOVE:
+            built.message = WM_MOUSEMOVE;
+            built.wParam = modifiers | HeldFlags(event.held);
+            break;
+        case EventType::BUTTON_DOWN:
+            built.message = ButtonMessage(event.button, true);
+            built.wParam = modifiers | ButtonFlags(event.button);
+            break;
+        case EventType::BUTTON_UP:
+            // 释放消息的 MK_* 为释放后的状态，不含该按键（X 键编号保留在高位字）
+            built.message = ButtonMessage(event.button, false);
+            built.wParam = modifiers | MAKEWPARAM(0, HIWORD(ButtonFlags(event.button)));
+            break;
+        case EventType::WHEEL:
+            built.message = WM_MOUSEWHEEL;
+            built.wParam = MAKEWPARAM(modifiers, event.delta * WHEEL_DELTA);
+            break;
+    }
+    return built;
+}
+
+std::unique_ptr<InputSink> CreateWin32Sink() {
+    return std::make_unique<Win32Sink>();
+}
+
+std::unique_ptr<Dispatcher> CreateWin32Dispatcher() {
+    return std::make_unique<Dispatcher>(CreateWin32Sink());
+}
+
+}  // namespace InputDispatcher
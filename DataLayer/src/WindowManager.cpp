@@ -30,7 +30,7 @@ Result<std::vector<HWND>> EnumerateWindows() {
         return Result<std::vector<HWND>>::Error(ErrorCode::OPERATION_FAILED, L"Failed to enumerate windows");
     }
     
-    return Result<std::vector<HWND>>::Success(windows);
+    return Result<std::vector<HWND>>::Success(std::move(windows));
 }
 
 // ============ 窗口查找 ============
@@ -75,7 +75,7 @@ Result<std::wstring> GetWindowTitle(HWND windowHandle) {
     int actualLength = GetWindowTextW(windowHandle, &title[0], length + 1);
     title.resize(actualLength);
     
-    return Result<std::wstring>::Success(title);
+    return Result<std::wstring>::Success(std::move(title));
 }
 
 Result<std::wstring> GetWindowClassName(HWND windowHandle) {
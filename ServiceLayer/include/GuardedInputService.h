@@ -0,0 +1,85 @@
+#pragma once
+
+#include "CommonTypes.h"
+#include "InputDispatcher.h"
+#include "WindowHealth.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace WindowsAPI;
+
+/**
+ * @brief 带超时与窗口健康记录的输入/查询服务
+ *
+ * DataLayer 的输入函数使用阻塞的 SendMessage，目标窗口挂起时调用线程随之卡死。
+ * 这里的每次同步调用都经过 BoundedSend（SendMessageTimeout + SMTO_ABORTIFHUNG），
+ * 结果计入 WindowHealthTracker：
+ * - 标记为 HUNG 的窗口直接拒绝（WINDOW_NOT_RESPONDING），不再占用调用线程
+ * - 距下次探测不超过 maxDeferMs 时先等待再探测，而不是立即拒绝
+ * - GetHealthTracker 提供每个窗口的延迟 EWMA 与超时统计，供调度方分配工作
+ */
+class GuardedInputService {
+public:
+    /**
+     * @brief 服务选项
+     */
+    struct Options {
+        UINT timeoutMs = 1000;                  // 每次同步调用的时限
+        int maxDeferMs = 0;                     // 拒绝前最多等待探测的时间，0 表示立即拒绝
+        WindowHealth::HealthOptions health;
+    };
+
+public:
+    explicit GuardedInputService(const Options& options = Options());
+
+    GuardedInputService(const GuardedInputService&) = delete;
+    GuardedInputService& operator=(const GuardedInputService&) = delete;
+
+    /**
+     * @brief 限时发送任意消息
+     * @return 目标窗口过程的返回值；拒绝或超时为 WINDOW_NOT_RESPONDING
+     */
+    Result<LRESULT> Send(HWND windowHandle, UINT message, WPARAM wParam, LPARAM lParam);
+
+    /**
+     * @brief 按顺序派发一批输入事件
+     *
+     * AUTO 按整批解析（见 InputDispatcher::Delivery）。投递（POST）的事件仍使用 PostMessage，不会阻塞；
+     * 同步事件逐个限时发送，
+     * 某个事件失败后剩余的事件不再派发。
+     *
+     * @return 已派发的事件数
+     */
+    Result<int> SendEvents(HWND windowHandle, const std::vector<InputDispatcher::InputEvent>& events);
+
+    /**
+     * @brief 限时读取窗口文本（WM_GETTEXTLENGTH + WM_GETTEXT）
+     */
+    Result<std::wstring> QueryText(HWND windowHandle);
+
+    /**
+     * @brief 创建经过本服务的输入接收端，供 InputDispatcher::Dispatcher 使用
+     *
+     * 派发线程因此不会被挂起的窗口卡住。服务必须比接收端活得久。
+     */
+    std::unique_ptr<InputDispatcher::InputSink> CreateSink();
+
+    WindowHealth::WindowHealthTracker& GetHealthTracker() { return m_tracker; }
+    const WindowHealth::WindowHealthTracker& GetHealthTracker() const { return m_tracker; }
+
+private:
+    // 准入判定（必要时等待探测）；拒绝时为 WINDOW_NOT_RESPONDING
+    Result<bool> Admit(HWND windowHandle);
+    // 准入后的一次限时发送，并记录结果
+    Result<LRESULT> SendAdmitted(HWND windowHandle, UINT message, WPARAM wParam, LPARAM lParam);
+    // 派发单个事件（已准入）
+    Result<bool> Deliver(HWND windowHandle, const InputDispatcher::InputEvent& event,
+                         InputDispatcher::Delivery delivery, WPARAM modifiers);
+
+    class Sink;
+
+    Options m_options;
+    WindowHealth::WindowHealthTracker m_tracker;
+};
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "BasicTypes.h"
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace WindowsAPI;
+
+/**
+ * @namespace WindowHealth
+ * @brief 按窗口记录的响应健康状态
+ *
+ * 每次限时发送（见 BoundedSend）后记录耗时或超时：
+ * - 延迟用指数加权移动平均（EWMA）平滑，超过阈值的窗口为 SLOW
+ * - 连续超时达到次数或系统报告挂起时标记为 HUNG，之后的调用直接拒绝（不再等待超时）
+ * - HUNG 的窗口到期后放行一次探测调用，成功则恢复，失败则加倍等待时间
+ * 调度方可以读取每个窗口的统计，把工作分给响应快的目标。与平台无关，可在 Linux 上测试。
+ */
+namespace WindowHealth {
+
+// 窗口键（Windows 下即 HWND）
+using WindowKey = const void*;
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief 健康状态
+ */
+enum class HealthState {
+    HEALTHY,
+    SLOW,           // 延迟 EWMA 超过 slowLatencyMs
+    HUNG            // 暂停调用，等待探测
+};
+
+/**
+ * @brief 调用准入结果
+ */
+enum class Admission {
+    ALLOW,          // 正常调用
+    PROBE,          // HUNG 的窗口到期，放行这一次调用作为探测
+    SHED            // 拒绝调用
+};
+
+/**
+ * @brief 健康判定参数
+ */
+struct HealthOptions {
+    double latencyAlpha = 0.2;      // EWMA 中新样本的权重（0, 1]
+    double slowLatencyMs = 100.0;   // EWMA 超过该值为 SLOW
+    int hungAfterTimeouts = 2;      // 连续超时达到该次数标记为 HUNG
+    int retryDelayMs = 1000;        // 标记为 HUNG 后到首次探测的时间
+    int maxRetryDelayMs = 30000;    // 探测失败时等待时间加倍的上限
+};
+
+/**
+ * @brief 单个窗口的健康记录
+ */
+struct HealthRecord {
+    HealthState state = HealthState::HEALTHY;
+    double latencyEwmaMs = 0.0;     // 延迟 EWMA（超时按已等待的时间计入）
+    double lastLatencyMs = 0.0;
+    std::uint64_t callCount = 0;    // 已完成或超时的调用
+    std::uint64_t timeoutCount = 0;
+    std::uint64_t shedCount = 0;    // 被拒绝的调用
+    int consecutiveTimeouts = 0;
+    std::int64_t retryInMs = 0;     // HUNG 时距下次放行探测的毫秒数（可以探测时为 0）
+};
+
+/**
+ * @brief 窗口健康记录表（线程安全）
+ */
+class WindowHealthTracker {
+public:
+    explicit WindowHealthTracker(const HealthOptions& options = HealthOptions());
+
+    WindowHealthTracker(const WindowHealthTracker&) = delete;
+    WindowHealthTracker& operator=(const WindowHealthTracker&) = delete;
+
+    /**
+     * @brief 调用前的准入判定
+     *
+     * 返回 PROBE 后，探测结果记录之前同一窗口的其他调用都被拒绝；
+     * 探测一直没有记录结果时，再过一个等待周期放行下一次探测。
+     *
+     * @param window 目标窗口
+     * @param now 当前时间
+     * @return 准入结果（SHED 计入 shedCount）
+     */
+    Admission Admit(WindowKey window, Clock::time_point now = Clock::now());
+
+    /**
+     * @brief 记录一次在时限内完成的调用
+     * @param window 目标窗口
+     * @param latencyMs 耗时（毫秒）
+     */
+    void RecordSuccess(WindowKey window, double latencyMs);
+
+    /**
+     * @brief 记录一次超时的调用
+     * @param window 目标窗口
+     * @param elapsedMs 已等待的时间（毫秒）
+     * @param reportedHung 系统是否报告目标挂起（是则立即标记为 HUNG）
+     * @param now 当前时间
+     */
+    void RecordTimeout(WindowKey window, double elapsedMs, bool reportedHung, Clock::time_point now = Clock::now());
+
+    /**
+     * @brief 获取窗口的健康记录
+     * @return 从未准入或记录过的窗口为 WINDOW_NOT_FOUND
+     */
+    Result<HealthRecord> GetHealth(WindowKey window, Clock::time_point now = Clock::now()) const;
+
+    /**
+     * @brief 获取所有窗口的健康记录，按响应从快到慢排序（HUNG 在最后）
+     */
+    std::vector<std::pair<WindowKey, HealthRecord>> Snapshot(Clock::time_point now = Clock::now()) const;
+
+    // 删除窗口的记录（窗口关闭后调用）
+    void Forget(WindowKey window);
+
+    size_t GetWindowCount() const;
+
+private:
+    struct Entry {
+        HealthRecord record;
+        Clock::time_point retryAt;
+        int retryDelayMs = 0;       // 当前的探测等待时间，恢复后清零
+    };
+
+    HealthRecord Describe(const Entry& entry, Clock::time_point now) const;
+
+    HealthOptions m_options;
+    mutable std::mutex m_mutex;
+    std::unordered_map<WindowKey, Entry> m_entries;
+};
+
+}  // namespace WindowHealth
@@ -0,0 +1,169 @@
+#include "GuardedInputService.h"
+#include "BoundedSend.h"
+#include "Win32InputSink.h"
+
+#include <algorithm>
+#include <memory>
+
+using namespace WindowsAPI;
+
+// 内部辅助函数
+namespace {
+    // 鼠标消息 wParam 中的修饰键状态（每批读取一次）
+    WPARAM ReadModifiers() {
+        WPARAM modifiers = 0;
+        if (GetAsyncKeyState(VK_CONTROL) & 0x8000) modifiers |= MK_CONTROL;
+        if (GetAsyncKeyState(VK_SHIFT) & 0x8000) modifiers |= MK_SHIFT;
+        return modifiers;
+    }
+
+    // 目标窗口是否属于本进程：此时消息参数中的缓冲区不经封送，超时后目标仍可能访问
+    bool IsSameProcess(HWND windowHandle) {
+        DWORD processId = 0;
+        GetWindowThreadProcessId(windowHandle, &processId);
+        return processId == GetCurrentProcessId();
+    }
+}
+
+// ============ 输入接收端 ============
+
+class GuardedInputService::Sink : public InputDispatcher::InputSink {
+public:
+    explicit Sink(GuardedInputService& service) : m_service(service) {}
+
+    Result<bool> BeginBatch(InputDispatcher::WindowHandle window) override {
+        auto admitted = m_service.Admit(static_cast<HWND>(window));
+        if (admitted.IsError()) {
+            return admitted;
+        }
+        m_modifiers = ReadModifiers();
+        return Result<bool>::Success(true);
+    }
+
+    Result<bool> Deliver(InputDispatcher::WindowHandle window, const InputDispatcher::InputEvent& event,
+                         InputDispatcher::Delivery delivery) override {
+        return m_service.Deliver(static_cast<HWND>(window), event, delivery, m_modifiers);
+    }
+
+private:
+    GuardedInputService& m_service;
+    WPARAM m_modifiers = 0;
+};
+
+// ============ GuardedInputService 实现 ============
+
+GuardedInputService::GuardedInputService(const Options& options)
+    : m_options(options), m_tracker(options.health) {
+}
+
+Result<bool> GuardedInputService::Admit(HWND windowHandle) {
+    if (!IsWindow(windowHandle)) {
+        return Result<bool>::Error(ErrorCode::INVALID_HANDLE, L"Invalid window handle");
+    }
+
+    WindowHealth::Admission admission = m_tracker.Admit(windowHandle);
+    if (admission == WindowHealth::Admission::SHED && m_options.maxDeferMs > 0) {
+        // 探测时间临近时推迟调用，而不是立即拒绝
+        auto health = m_tracker.GetHealth(windowHandle);
+        const std::int64_t retryInMs = health.IsSuccess() ? health.GetData().retryInMs : 0;
+        if (retryInMs > 0 && retryInMs <= m_options.maxDeferMs) {
+            Sleep(static_cast<DWORD>(retryInMs));
+            admission = m_tracker.Admit(windowHandle);
+        }
+    }
+    if (admission == WindowHealth::Admission::SHED) {
+        return Result<bool>::Error(ErrorCode::WINDOW_NOT_RESPONDING, L"Window is marked as hung; call shed");
+    }
+    return Result<bool>::Success(true);
+}
+
+Result<LRESULT> GuardedInputService::SendAdmitted(HWND windowHandle, UINT message, WPARAM wParam, LPARAM lParam) {
+    auto sent = BoundedSend::Send(windowHandle, message, wParam, lParam, m_options.timeoutMs);
+    if (sent.IsError()) {
+        // 窗口已销毁：记录不再有用
+        m_tracker.Forget(windowHandle);
+        return Result<LRESULT>::Error(sent.GetErrorCode(), sent.GetErrorMessage());
+    }
+
+    const BoundedSend::SendOutcome& outcome = sent.GetData();
+    if (outcome.completed) {
+        m_tracker.RecordSuccess(windowHandle, outcome.latencyMs);
+        return Result<LRESULT>::Success(outcome.result);
+    }
+    m_tracker.RecordTimeout(windowHandle, outcome.latencyMs, outcome.hung);
+    return Result<LRESULT>::Error(ErrorCode::WINDOW_NOT_RESPONDING,
+                                  outcome.hung ? L"Window is hung" : L"Window did not respond in time");
+}
+
+Result<LRESULT> GuardedInputService::Send(HWND windowHandle, UINT message, WPARAM wParam, LPARAM lParam) {
+    auto admitted = Admit(windowHandle);
+    if (admitted.IsError()) {
+        return Result<LRESULT>::Error(admitted.GetErrorCode(), admitted.GetErrorMessage());
+    }
+    return SendAdmitted(windowHandle, message, wParam, lParam);
+}
+
+Result<bool> GuardedInputService::Deliver(HWND windowHandle, const InputDispatcher::InputEvent& event,
+                                          InputDispatcher::Delivery delivery, WPARAM modifiers) {
+    const InputDispatcher::WindowMessage built = InputDispatcher::ToWindowMessage(event, modifiers);
+    if (delivery == InputDispatcher::Delivery::POST) {
+        if (!PostMessage(windowHandle, built.message, built.wParam, built.lParam)) {
+            return Result<bool>::Error(ErrorCode::INPUT_SIMULATION_FAILED, L"PostMessage failed");
+        }
+        return Result<bool>::Success(true);
+    }
+
+    auto sent = SendAdmitted(windowHandle, built.message, built.wParam, built.lParam);
+    if (sent.IsError()) {
+        return Result<bool>::Error(sent.GetErrorCode(), sent.GetErrorMessage());
+    }
+    return Result<bool>::Success(true);
+}
+
+Result<int> GuardedInputService::SendEvents(HWND windowHandle, const std::vector<InputDispatcher::InputEvent>& events) {
+    auto admitted = Admit(windowHandle);
+    if (admitted.IsError()) {
+        return Result<int>::Error(admitted.GetErrorCode(), admitted.GetErrorMessage());
+    }
+
+    const WPARAM modifiers = ReadModifiers();
+    const bool postable = InputDispatcher::IsPostableBatch(events);
+    int delivered = 0;
+    for (const InputDispatcher::InputEvent& event : events) {
+        auto result = Deliver(windowHandle, event, InputDispatcher::ResolveDelivery(event, postable), modifiers);
+        if (result.IsError()) {
+            return Result<int>::Error(result.GetErrorCode(), result.GetErrorMessage());
+        }
+        delivered++;
+    }
+    return Result<int>::Success(delivered);
+}
+
+Result<std::wstring> GuardedInputService::QueryText(HWND windowHandle) {
+    auto admitted = Admit(windowHandle);
+    if (admitted.IsError()) {
+        return Result<std::wstring>::Error(admitted.GetErrorCode(), admitted.GetErrorMessage());
+    }
+
+    auto length = SendAdmitted(windowHandle, WM_GETTEXTLENGTH, 0, 0);
+    if (length.IsError()) {
+        return Result<std::wstring>::Error(length.GetErrorCode(), length.GetErrorMessage());
+    }
+
+    const size_t capacity = static_cast<size_t>(length.GetData()) + 1;
+    std::unique_ptr<wchar_t[]> buffer(new wchar_t[capacity]());
+    auto copied = SendAdmitted(windowHandle, WM_GETTEXT, capacity, reinterpret_cast<LPARAM>(buffer.get()));
+    if (copied.IsError()) {
+        if (copied.GetErrorCode() == ErrorCode::WINDOW_NOT_RESPONDING && IsSameProcess(windowHandle)) {
+            // 同进程的目标稍后仍可能写入缓冲区，故意不释放
+            buffer.release();
+        }
+        return Result<std::wstring>::Error(copied.GetErrorCode(), copied.GetErrorMessage());
+    }
+    const size_t copiedLength = std::min(static_cast<size_t>(copied.GetData()), capacity - 1);
+    return Result<std::wstring>::Success(std::wstring(buffer.get(), copiedLength));
+}
+
+std::unique_ptr<InputDispatcher::InputSink> GuardedInputService::CreateSink() {
+    return std::make_unique<Sink>(*this);
+}
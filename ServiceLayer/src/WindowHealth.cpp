@@ -0,0 +1,115 @@
+#include "WindowHealth.h"
+
+#include <algorithm>
+
+namespace WindowHealth {
+
+// 内部辅助函数
+namespace {
+    // 计入一个延迟样本：第一个样本直接作为初值
+    void AddLatencySample(HealthRecord& record, double latencyMs, double alpha) {
+        record.latencyEwmaMs = record.callCount == 0 ? latencyMs
+                                                     : record.latencyEwmaMs + alpha * (latencyMs - record.latencyEwmaMs);
+        record.lastLatencyMs = latencyMs;
+        record.callCount++;
+    }
+}
+
+WindowHealthTracker::WindowHealthTracker(const HealthOptions& options) : m_options(options) {
+    m_options.latencyAlpha = std::min(1.0, std::max(0.01, m_options.latencyAlpha));
+    m_options.hungAfterTimeouts = std::max(1, m_options.hungAfterTimeouts);
+    m_options.retryDelayMs = std::max(1, m_options.retryDelayMs);
+    m_options.maxRetryDelayMs = std::max(m_options.retryDelayMs, m_options.maxRetryDelayMs);
+}
+
+Admission WindowHealthTracker::Admit(WindowKey window, Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Entry& entry = m_entries[window];
+    if (entry.record.state != HealthState::HUNG) {
+        return Admission::ALLOW;
+    }
+    if (now >= entry.retryAt) {
+        // 探测期间其余调用继续拒绝；探测没有记录结果时（调用方未发送同步消息）到期后再放行一次
+        entry.retryAt = now + std::chrono::milliseconds(entry.retryDelayMs);
+        return Admission::PROBE;
+    }
+    entry.record.shedCount++;
+    return Admission::SHED;
+}
+
+void WindowHealthTracker::RecordSuccess(WindowKey window, double latencyMs) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Entry& entry = m_entries[window];
+    AddLatencySample(entry.record, latencyMs, m_options.latencyAlpha);
+    entry.record.consecutiveTimeouts = 0;
+    entry.retryDelayMs = 0;
+    entry.record.state = entry.record.latencyEwmaMs > m_options.slowLatencyMs ? HealthState::SLOW : HealthState::HEALTHY;
+}
+
+void WindowHealthTracker::RecordTimeout(WindowKey window, double elapsedMs, bool reportedHung, Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Entry& entry = m_entries[window];
+    AddLatencySample(entry.record, elapsedMs, m_options.latencyAlpha);
+    entry.record.timeoutCount++;
+    entry.record.consecutiveTimeouts++;
+
+    if (reportedHung || entry.record.state == HealthState::HUNG
+        || entry.record.consecutiveTimeouts >= m_options.hungAfterTimeouts) {
+        // 已经 HUNG 时再次超时即探测失败：等待时间加倍
+        entry.retryDelayMs = entry.retryDelayMs == 0 ? m_options.retryDelayMs
+                                                     : std::min(entry.retryDelayMs * 2, m_options.maxRetryDelayMs);
+        entry.retryAt = now + std::chrono::milliseconds(entry.retryDelayMs);
+        entry.record.state = HealthState::HUNG;
+    } else if (entry.record.latencyEwmaMs > m_options.slowLatencyMs) {
+        entry.record.state = HealthState::SLOW;
+    }
+}
+
+HealthRecord WindowHealthTracker::Describe(const Entry& entry, Clock::time_point now) const {
+    HealthRecord record = entry.record;
+    if (record.state == HealthState::HUNG && now < entry.retryAt) {
+        record.retryInMs = std::chrono::duration_cast<std::chrono::milliseconds>(entry.retryAt - now).count();
+    }
+    return record;
+}
+
+Result<HealthRecord> WindowHealthTracker::GetHealth(WindowKey window, Clock::time_point now) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_entries.find(window);
+    if (it == m_entries.end()) {
+        return Result<HealthRecord>::Error(ErrorCode::WINDOW_NOT_FOUND, L"No health record for window");
+    }
+    return Result<HealthRecord>::Success(Describe(it->second, now));
+}
+
+std::vector<std::pair<WindowKey, HealthRecord>> WindowHealthTracker::Snapshot(Clock::time_point now) const {
+    std::vector<std::pair<WindowKey, HealthRecord>> records;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        records.reserve(m_entries.size());
+        for (const auto& entry : m_entries) {
+            records.emplace_back(entry.first, Describe(entry.second, now));
+        }
+    }
+    std::sort(records.begin(), records.end(), [](const auto& a, const auto& b) {
+        const bool hungA = a.second.state == HealthState::HUNG;
+        const bool hungB = b.second.state == HealthState::HUNG;
+        if (hungA != hungB) {
+            return hungB;
+        }
+        return a.second.latencyEwmaMs < b.second.latencyEwmaMs;
+    });
+    return records;
+}
+
+void WindowHealthTracker::Forget(WindowKey window) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.erase(window);
+}
+
+size_t WindowHealthTracker::GetWindowCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+}  // namespace WindowHealth
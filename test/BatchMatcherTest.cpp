@@ -0,0 +1,196 @@
+#include <gtest/gtest.h>
+#include "../DataLayer/include/BatchMatcher.h"
+#include "TestUtils.h"
+
+#include <random>
+#include <vector>
+
+using namespace BatchMatcher;
+using TestUtils::GrayImage;
+
+namespace {
+
+// 随机纹理的图标
+GrayImage MakeIcon(int width, int height, unsigned seed) {
+    std::mt19937 rng(seed);
+    GrayImage icon(width, height);
+    for (auto& p : icon.pixels) {
+        p = static_cast<std::uint8_t>(rng());
+    }
+    return icon;
+}
+
+// 平滑噪声背景
+GrayImage MakeBackground(int width, int height, unsigned seed) {
+    std::mt19937 rng(seed);
+    GrayImage image(width, height);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            image.pixels[static_cast<size_t>(y) * width + x] = static_cast<std::uint8_t>(((x / 6) * 37 + (y / 5) * 11 + rng() % 8) & 0xFF);
+        }
+    }
+    return image;
+}
+
+void Paste(GrayImage& target, const GrayImage& patch, int x, int y) {
+    for (int row = 0; row < patch.height; row++) {
+        std::copy_n(&patch.pixels[static_cast<size_t>(row) * patch.width], patch.width,
+                    &target.pixels[static_cast<size_t>(y + row) * target.width + x]);
+    }
+}
+
+// BGRA 拷贝（B=G=R=灰度，转回灰度后不变）
+std::vector<std::uint8_t> ToBgra(const GrayImage& gray) {
+    std::vector<std::uint8_t> bgra(gray.pixels.size() * 4);
+    for (size_t i = 0; i < gray.pixels.size(); i++) {
+        bgra[i * 4] = bgra[i * 4 + 1] = bgra[i * 4 + 2] = gray.pixels[i];
+        bgra[i * 4 + 3] = 255;
+    }
+    return bgra;
+}
+
+}  // namespace
+
+TEST(BatchMatcherTest, FindsEveryPlantedTemplate) {
+    GrayImage haystack = MakeBackground(400, 300, 1);
+    std::vector<GrayImage> icons;
+    std::vector<WindowsAPI::Point> positions;
+    const int sizes[][2] = {{16, 16}, {24, 24}, {16, 16}, {32, 20}, {24, 24}, {9, 13}};
+    for (int i = 0; i < 6; i++) {
+        icons.push_back(MakeIcon(sizes[i][0], sizes[i][1], 100 + i));
+        positions.emplace_back(20 + i * 60, 30 + (i * 47) % 200);
+        Paste(haystack, icons.back(), positions.back().x, positions.back().y);
+    }
+    // 第7个模板不在大图中
+    icons.push_back(MakeIcon(16, 16, 999));
+
+    std::vector<ImageView> views;
+    for (const auto& icon : icons) {
+        views.push_back(icon.View());
+    }
+    auto set = TemplateSet::Compile(views);
+    ASSERT_TRUE(set.IsSuccess());
+    EXPECT_EQ(set.GetData().GetTemplateCount(), 7);
+    EXPECT_EQ(set.GetData().GetGroupCount(), 4);
+
+    auto hits = FindAll(haystack.View(), set.GetData());
+    ASSERT_TRUE(hits.IsSuccess());
+    ASSERT_EQ(hits.GetData().size(), 7u);
+    for (int i = 0; i < 6; i++) {
+        EXPECT_TRUE(hits.GetData()[i].found) << i;
+        EXPECT_EQ(hits.GetData()[i].best.location.x, positions[i].x) << i;
+        EXPECT_EQ(hits.GetData()[i].best.location.y, positions[i].y) << i;
+        EXPECT_NEAR(hits.GetData()[i].best.score, 1.0, 1e-9);
+    }
+    EXPECT_FALSE(hits.GetData()[6].found);
+
+    // BGRA 大图得到同样的结果
+    std::vector<std::uint8_t> bgra = ToBgra(haystack);
+    auto bgraHits = FindAll(ImageView(bgra.data(), 400, 300, 400 * 4, PixelFormat::BGRA32), set.GetData());
+    ASSERT_TRUE(bgraHits.IsSuccess());
+    for (int i = 0; i < 7; i++) {
+        EXPECT_EQ(bgraHits.GetData()[i].found, hits.GetData()[i].found);
+        EXPECT_EQ(bgraHits.GetData()[i].best.location.x, hits.GetData()[i].best.location.x);
+    }
+}
+
+TEST(BatchMatcherTest, FindsTemplatesAtEveryPhase) {
+    // 32x32 在 4x 缩小图上筛选、12x12 在 2x 上、6x6 不缩小；位置覆盖缩小块内的每种相位，最后一个贴着右下边缘
+    GrayImage haystack = MakeBackground(421, 201, 6);
+    std::vector<GrayImage> icons;
+    std::vector<WindowsAPI::Point> positions;
+    for (int i = 0; i < 16; i++) {
+        icons.push_back(MakeIcon(32, 32, 300 + i));
+        positions.emplace_back(8 + (i % 8) * 50 + i % 4, 8 + (i / 8) * 50 + (i / 4) % 4);
+    }
+    icons.push_back(MakeIcon(32, 32, 316));
+    positions.emplace_back(389, 169);
+    for (int i = 0; i < 4; i++) {
+        icons.push_back(MakeIcon(12, 12, 320 + i));
+        positions.emplace_back(8 + i * 40 + i % 2, 120 + i / 2);
+    }
+    icons.push_back(MakeIcon(6, 6, 330));
+    positions.emplace_back(201, 151);
+
+    std::vector<ImageView> views;
+    for (size_t i = 0; i < icons.size(); i++) {
+        Paste(haystack, icons[i], positions[i].x, positions[i].y);
+        views.push_back(icons[i].View());
+    }
+    auto set = TemplateSet::Compile(views).TakeData();
+    EXPECT_EQ(set.GetGroupCount(), 3);
+
+    auto hits = FindAll(haystack.View(), set).TakeData();
+    for (size_t i = 0; i < icons.size(); i++) {
+        EXPECT_TRUE(hits[i].found) << i;
+        EXPECT_EQ(hits[i].best.location.x, positions[i].x) << i;
+        EXPECT_EQ(hits[i].best.location.y, positions[i].y) << i;
+        EXPECT_NEAR(hits[i].best.score, 1.0, 1e-9) << i;
+    }
+}
+
+TEST(BatchMatcherTest, ToleratesSmallBrightnessShift) {
+    GrayImage haystack = MakeBackground(200, 120, 2);
+    GrayImage icon = MakeIcon(20, 20, 3);
+    GrayImage shifted = icon;
+    for (auto& p : shifted.pixels) {
+        p = static_cast<std::uint8_t>(std::min(255, p + 6));
+    }
+    Paste(haystack, shifted, 70, 40);
+
+    auto set = TemplateSet::Compile({icon.View()}).TakeData();
+    auto hit = FindAll(haystack.View(), set).TakeData()[0];
+    EXPECT_TRUE(hit.found);
+    EXPECT_EQ(hit.best.location.x, 70);
+    EXPECT_EQ(hit.best.location.y, 40);
+
+    // 容差小于亮度偏移时被预筛选跳过
+    auto strict = TemplateSet::Compile({icon.View()}, 2).TakeData();
+    EXPECT_FALSE(FindAll(haystack.View(), strict).TakeData()[0].found);
+}
+
+TEST(BatchMatcherTest, ThreadedResultMatchesSerial) {
+    GrayImage haystack = MakeBackground(320, 240, 4);
+    std::vector<GrayImage> icons;
+    for (int i = 0; i < 20; i++) {
+        icons.push_back(MakeIcon(12 + (i % 3) * 4, 12 + (i % 2) * 6, 200 + i));
+        if (i % 2 == 0) {
+            Paste(haystack, icons.back(), (i * 29) % 280, (i * 53) % 200);
+        }
+    }
+    std::vector<ImageView> views;
+    for (const auto& icon : icons) {
+        views.push_back(icon.View());
+    }
+    auto set = TemplateSet::Compile(views).TakeData();
+
+    BatchOptions serial;
+    serial.multithreaded = false;
+    auto a = FindAll(haystack.View(), set, serial).TakeData();
+    auto b = FindAll(haystack.View(), set).TakeData();
+    for (size_t i = 0; i < a.size(); i++) {
+        EXPECT_EQ(a[i].found, b[i].found);
+        EXPECT_EQ(a[i].best.location.x, b[i].best.location.x);
+        EXPECT_EQ(a[i].best.location.y, b[i].best.location.y);
+        EXPECT_DOUBLE_EQ(a[i].best.score, b[i].best.score);
+    }
+}
+
+TEST(BatchMatcherTest, RejectsInvalidInput) {
+    GrayImage tiny(1, 5);
+    GrayImage icon = MakeIcon(8, 8, 5);
+    EXPECT_TRUE(TemplateSet::Compile({}).IsError());
+    EXPECT_TRUE(TemplateSet::Compile({tiny.View()}).IsError());
+    EXPECT_TRUE(TemplateSet::Compile({icon.View()}, -1).IsError());
+    std::vector<std::uint8_t> rgb(8 * 8 * 3);
+    EXPECT_TRUE(TemplateSet::Compile({ImageView(rgb.data(), 8, 8, 24, PixelFormat::RGB24)}).IsError());
+
+    // 比大图还大的模板不报错，只是找不到
+    GrayImage small(6, 6);
+    auto set = TemplateSet::Compile({icon.View()}).TakeData();
+    auto hits = FindAll(small.View(), set);
+    ASSERT_TRUE(hits.IsSuccess());
+    EXPECT_FALSE(hits.GetData()[0].found);
+    EXPECT_EQ(hits.GetData()[0].best.score, -1.0);
+    EXPECT_TRUE(FindAll(ImageView(), set).IsError());
+}
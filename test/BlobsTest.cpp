@@ -0,0 +1,232 @@
+#include <gtest/gtest.h>
+#include "../DataLayer/include/Blobs.h"
+#include "../DataLayer/include/ColorSearch.h"
+
+#include <deque>
+#include <random>
+#include <vector>
+
+using namespace Blobs;
+
+namespace {
+
+struct GrayMask {
+    int width;
+    int height;
+    std::vector<std::uint8_t> pixels;
+
+    GrayMask(int w, int h) : width(w), height(h), pixels(static_cast<size_t>(w) * h, 0) {}
+
+    ImageView View() const { return ImageView(pixels.data(), width, height, width, PixelFormat::GRAY8); }
+
+    void Fill(int left, int top, int right, int bottom) {
+        for (int y = top; y < bottom; y++) {
+            for (int x = left; x < right; x++) {
+                pixels[static_cast<size_t>(y) * width + x] = 255;
+            }
+        }
+    }
+
+    bool At(int x, int y) const { return pixels[static_cast<size_t>(y) * width + x] != 0; }
+};
+
+// 同一掩码的 MONO1 版本，行尾填充位全部置 1 以检查越界位被忽略
+ImageData ToMono1(const GrayMask& mask) {
+    ImageData mono(mask.width, mask.height, PixelFormat::MONO1);
+    std::fill(mono.data.begin(), mono.data.end(), 0);
+    for (int y = 0; y < mask.height; y++) {
+        std::uint8_t* row = &mono.data[static_cast<size_t>(y) * mono.stride];
+        for (int x = mask.width; x < mono.stride * 8; x++) {
+            row[x >> 3] |= static_cast<std::uint8_t>(0x80 >> (x & 7));
+        }
+        for (int x = 0; x < mask.width; x++) {
+            if (mask.At(x, y)) {
+                row[x >> 3] |= static_cast<std::uint8_t>(0x80 >> (x & 7));
+            }
+        }
+    }
+    return mono;
+}
+
+// 参考实现：光栅顺序逐像素广度优先填充
+std::vector<Blob> ReferenceBlobs(const GrayMask& mask, Connectivity connectivity) {
+    std::vector<int> visited(mask.pixels.size(), 0);
+    std::vector<Blob> blobs;
+    for (int y0 = 0; y0 < mask.height; y0++) {
+        for (int x0 = 0; x0 < mask.width; x0++) {
+            if (!mask.At(x0, y0) || visited[static_cast<size_t>(y0) * mask.width + x0]) {
+                continue;
+            }
+            Blob blob;
+            blob.bounds = WindowsAPI::Rectangle(x0, y0, x0 + 1, y0 + 1);
+            double sumX = 0.0;
+            double sumY = 0.0;
+            std::deque<std::pair<int, int>> queue = {{x0, y0}};
+            visited[static_cast<size_t>(y0) * mask.width + x0] = 1;
+            while (!queue.empty()) {
+                auto [x, y] = queue.front();
+                queue.pop_front();
+                blob.area++;
+                sumX += x;
+                sumY += y;
+                blob.bounds.left = std::min(blob.bounds.left, x);
+                blob.bounds.top = std::min(blob.bounds.top, y);
+                blob.bounds.right = std::max(blob.bounds.right, x + 1);
+                blob.bounds.bottom = std::max(blob.bounds.bottom, y + 1);
+                for (int dy = -1; dy <= 1; dy++) {
+                    for (int dx = -1; dx <= 1; dx++) {
+                        if ((dx == 0 && dy == 0) || (connectivity == Connectivity::FOUR && dx != 0 && dy != 0)) {
+                            continue;
+                        }
+                        int nx = x + dx;
+                        int ny = y + dy;
+                        if (nx < 0 || ny < 0 || nx >= mask.width || ny >= mask.height || !mask.At(nx, ny)) {
+                            continue;
+                        }
+                        int& seen = visited[static_cast<size_t>(ny) * mask.width + nx];
+                        if (!seen) {
+                            seen = 1;
+                            queue.emplace_back(nx, ny);
+                        }
+                    }
+                }
+            }
+            blob.centroidX = sumX / blob.area;
+            blob.centroidY = sumY / blob.area;
+            blobs.push_back(blob);
+        }
+    }
+    return blobs;
+}
+
+void ExpectSameBlobs(const std::vector<Blob>& actual, const std::vector<Blob>& expected) {
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < actual.size(); i++) {
+        EXPECT_EQ(actual[i].area, expected[i].area) << i;
+        EXPECT_EQ(actual[i].bounds.left, expected[i].bounds.left) << i;
+        EXPECT_EQ(actual[i].bounds.top, expected[i].bounds.top) << i;
+        EXPECT_EQ(actual[i].bounds.right, expected[i].bounds.right) << i;
+        EXPECT_EQ(actual[i].bounds.bottom, expected[i].bounds.bottom) << i;
+        EXPECT_NEAR(actual[i].centroidX, expected[i].centroidX, 1e-9) << i;
+        EXPECT_NEAR(actual[i].centroidY, expected[i].centroidY, 1e-9) << i;
+    }
+}
+
+}  // namespace
+
+TEST(BlobsTest, FindsShapesWithAreaBoundsAndCentroid) {
+    GrayMask mask(64, 40);
+    mask.Fill(2, 3, 12, 8);         // 10x5 矩形
+    mask.Fill(30, 0, 33, 20);       // U 形：两根竖条在底部相连，先出现的两个游程在后面合并
+    mask.Fill(40, 0, 43, 20);
+    mask.Fill(30, 20, 43, 23);
+    mask.Fill(50, 30, 51, 31);      // 与下一个像素只在对角相邻
+    mask.Fill(51, 31, 52, 32);
+
+    auto eight = FindBlobs(mask.View());
+    ASSERT_TRUE(eight.IsSuccess());
+    const auto& blobs = eight.GetData();
+    // 按第一个像素的光栅顺序：U 形从第 0 行开始，排在矩形之前
+    ASSERT_EQ(blobs.size(), 3u);
+    EXPECT_EQ(blobs[0].area, 3 * 20 * 2 + 13 * 3);
+    EXPECT_EQ(blobs[0].bounds.right, 43);
+    EXPECT_DOUBLE_EQ(blobs[0].centroidX, 36.0);
+    EXPECT_EQ(blobs[1].area, 50);
+    EXPECT_EQ(blobs[1].bounds.left, 2);
+    EXPECT_EQ(blobs[1].bounds.bottom, 8);
+    EXPECT_DOUBLE_EQ(blobs[1].centroidX, 6.5);
+    EXPECT_DOUBLE_EQ(blobs[1].centroidY, 5.0);
+    EXPECT_EQ(blobs[2].area, 2);
+
+    LabelOptions options;
+    options.connectivity = Connectivity::FOUR;
+    EXPECT_EQ(FindBlobs(mask.View(), options).GetData().size(), 4u);
+
+    options.minArea = 20;
+    auto large = FindBlobs(mask.View(), options).TakeData();
+    ASSERT_EQ(large.size(), 2u);
+    EXPECT_EQ(large[1].bounds.top, 3);
+}
+
+TEST(BlobsTest, MatchesReferenceOnRandomMasks) {
+    std::mt19937 rng(3);
+    for (int density : {30, 45, 60}) {
+        GrayMask mask(517, 301);
+        for (auto& p : mask.pixels) {
+            p = static_cast<int>(rng() % 100) < density ? static_cast<std::uint8_t>(1 + rng() % 255) : 0;
+        }
+        ImageData mono = ToMono1(mask);
+        for (auto connectivity : {Connectivity::FOUR, Connectivity::EIGHT}) {
+            auto expected = ReferenceBlobs(mask, connectivity);
+            for (bool threaded : {false, true}) {
+                LabelOptions options;
+                options.connectivity = connectivity;
+                options.multithreaded = threaded;
+                auto gray = FindBlobs(mask.View(), options);
+                auto bits = FindBlobs(ImageView(mono), options);
+                ASSERT_TRUE(gray.IsSuccess());
+                ASSERT_TRUE(bits.IsSuccess());
+                ExpectSameBlobs(gray.GetData(), expected);
+                ExpectSameBlobs(bits.GetData(), expected);
+            }
+        }
+    }
+}
+
+TEST(BlobsTest, MonoMaskIgnoresPaddingBits) {
+    GrayMask mask(13, 4);
+    mask.Fill(10, 0, 13, 2);
+    mask.Fill(0, 3, 13, 4);
+    ImageData mono = ToMono1(mask);
+    auto blobs = FindBlobs(ImageView(mono)).TakeData();
+    ASSERT_EQ(blobs.size(), 2u);
+    EXPECT_EQ(blobs[0].area, 6);
+    EXPECT_EQ(blobs[0].bounds.right, 13);
+    EXPECT_EQ(blobs[1].area, 13);
+}
+
+TEST(BlobsTest, FindsColorMarkersFromColorMask) {
+    // 灰色背景上的红色标记（面积 4、30、120）与一块绿色区域
+    const int width = 200;
+    const int height = 120;
+    std::vector<std::uint8_t> pixels(static_cast<size_t>(width) * height * 4, 90);
+    auto paint = [&](int left, int top, int right, int bottom, std::uint8_t r, std::uint8_t g, std::uint8_t b) {
+        for (int y = top; y < bottom; y++) {
+            for (int x = left; x < right; x++) {
+                std::uint8_t* p = &pixels[(static_cast<size_t>(y) * width + x) * 4];
+                p[0] = b;
+                p[1] = g;
+                p[2] = r;
+            }
+        }
+    };
+    paint(10, 10, 12, 12, 230, 20, 30);
+    paint(50, 40, 56, 45, 220, 30, 20);
+    paint(120, 70, 132, 80, 240, 10, 10);
+    paint(150, 10, 190, 30, 20, 220, 30);
+
+    ImageView image(pixels.data(), width, height, width * 4, PixelFormat::BGRA32);
+    auto mask = ColorSearch::CreateMask(image, ColorSearch::ColorRange::FromRgb(230, 20, 20, 20));
+    ASSERT_TRUE(mask.IsSuccess());
+    LabelOptions options;
+    options.minArea = 20;
+    auto blobs = FindBlobs(ImageView(mask.GetData()), options).TakeData();
+    ASSERT_EQ(blobs.size(), 2u);
+    EXPECT_EQ(blobs[0].area, 30);
+    EXPECT_DOUBLE_EQ(blobs[0].centroidX, 52.5);
+    EXPECT_DOUBLE_EQ(blobs[0].centroidY, 42.0);
+    EXPECT_EQ(blobs[1].area, 120);
+    EXPECT_EQ(blobs[1].bounds.left, 120);
+}
+
+TEST(BlobsTest, RejectsInvalidInput) {
+    EXPECT_TRUE(FindBlobs(ImageView()).IsError());
+    std::vector<std::uint8_t> bgra(16 * 4);
+    EXPECT_TRUE(FindBlobs(ImageView(bgra.data(), 4, 4, 16, PixelFormat::BGRA32)).IsError());
+
+    GrayMask mask(4, 4);
+    LabelOptions options;
+    options.minArea = -1;
+    EXPECT_TRUE(FindBlobs(mask.View(), options).IsError());
+    EXPECT_TRUE(FindBlobs(mask.View()).GetData().empty());
+}
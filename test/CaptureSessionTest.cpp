@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include "../DataLayer/include/CaptureSession.h"
+
+#include <cstring>
+#include <vector>
+
+using namespace ScreenCapture;
+
+namespace {
+
+// 假捕获后端：记录调用次数，Grab时用帧序号填充像素
+class FakeCaptureBackend : public CaptureBackend {
+public:
+    struct Counters {
+        int allocations = 0;
+        int releases = 0;
+        int grabs = 0;
+    };
+
+    FakeCaptureBackend(int width, int height, Counters* counters)
+        : m_width(width), m_height(height), m_counters(counters) {}
+
+    void Resize(int width, int height) {
+        m_width = width;
+        m_height = height;
+    }
+
+    void FailNextGrab() { m_failNextGrab = true; }
+
+    Result<WindowsAPI::Rectangle> QuerySourceBounds() override {
+        return Result<WindowsAPI::Rectangle>::Success(WindowsAPI::Rectangle(0, 0, m_width, m_height));
+    }
+
+    Result<CaptureSurface> AllocateSurface(int width, int height) override {
+        m_counters->allocations++;
+        m_buffer.assign(static_cast<size_t>(width) * height * 4, 0);
+        CaptureSurface surface;
+        surface.pixels = m_buffer.data();
+        surface.width = width;
+        surface.height = height;
+        surface.stride = width * 4;
+        return Result<CaptureSurface>::Success(surface);
+    }
+
+    void ReleaseSurface() override {
+        m_counters->releases++;
+        m_buffer.clear();
+    }
+
+    Result<bool> Grab(const CaptureSurface& surface) override {
+        if (m_failNextGrab) {
+            m_failNextGrab = false;
+            return Result<bool>::Error(ErrorCode::CAPTURE_FAILED, L"Fake grab failure");
+        }
+        m_counters->grabs++;
+        std::memset(surface.pixels, m_counters->grabs & 0xFF,
+                    static_cast<size_t>(surface.stride) * surface.height);
+        return Result<bool>::Success(true);
+    }
+
+private:
+    int m_width;
+    int m_height;
+    bool m_failNextGrab = false;
+    Counters* m_counters;
+    std::vector<std::uint8_t> m_buffer;
+};
+
+}  // namespace
+
+TEST(CaptureSessionTest, ReusesSurfaceAcrossFrames) {
+    FakeCaptureBackend::Counters counters;
+    CaptureSession session(std::make_unique<FakeCaptureBackend>(64, 32, &counters));
+
+    const std::uint8_t* firstPixels = nullptr;
+    for (int i = 0; i < 10; i++) {
+        auto result = session.Capture();
+        ASSERT_TRUE(result.IsSuccess());
+        const ImageView& view = result.GetData();
+        EXPECT_EQ(view.width, 64);
+        EXPECT_EQ(view.height, 32);
+        EXPECT_EQ(view.stride, 64 * 4);
+        EXPECT_EQ(view.data[0], static_cast<std::uint8_t>(i + 1));
+        if (i == 0) {
+            firstPixels = view.data;
+        }
+        EXPECT_EQ(view.data, firstPixels);
+    }
+
+    EXPECT_EQ(counters.allocations, 1);
+    EXPECT_EQ(counters.grabs, 10);
+    EXPECT_EQ(session.GetStatistics().frameCount, 10u);
+    EXPECT_EQ(session.GetStatistics().allocationCount, 1u);
+}
+
+TEST(CaptureSessionTest, ReallocatesOnlyWhenSizeChanges) {
+    FakeCaptureBackend::Counters counters;
+    auto backend = std::make_unique<FakeCaptureBackend>(100, 50, &counters);
+    FakeCaptureBackend* fake = backend.get();
+    CaptureSession session(std::move(backend));
+
+    ASSERT_TRUE(session.Capture().IsSuccess());
+    ASSERT_TRUE(session.Capture().IsSuccess());
+    EXPECT_EQ(counters.allocations, 1);
+
+    fake->Resize(120, 60);
+    auto resized = session.Capture();
+    ASSERT_TRUE(resized.IsSuccess());
+    EXPECT_EQ(resized.GetData().width, 120);
+    EXPECT_EQ(resized.GetData().height, 60);
+    EXPECT_EQ(counters.allocations, 2);
+    EXPECT_EQ(counters.releases, 1);
+
+    ASSERT_TRUE(session.Capture().IsSuccess());
+    EXPECT_EQ(counters.allocations, 2);
+}
+
+TEST(CaptureSessionTest, ReleasesSurfaceOnResetAndDestruction) {
+    FakeCaptureBackend::Counters counters;
+    {
+        CaptureSession session(std::make_unique<FakeCaptureBackend>(16, 16, &counters));
+        ASSERT_TRUE(session.Capture().IsSuccess());
+        session.Reset();
+        EXPECT_EQ(counters.releases, 1);
+        ASSERT_TRUE(session.Capture().IsSuccess());
+        EXPECT_EQ(counters.allocations, 2);
+    }
+    EXPECT_EQ(counters.releases, 2);
+}
+
+TEST(CaptureSessionTest, PropagatesGrabFailure) {
+    FakeCaptureBackend::Counters counters;
+    auto backend = std::make_unique<FakeCaptureBackend>(8, 8, &counters);
+    FakeCaptureBackend* fake = backend.get();
+    CaptureSession session(std::move(backend));
+
+    fake->FailNextGrab();
+    auto result = session.Capture();
+    EXPECT_TRUE(result.IsError());
+    EXPECT_EQ(result.GetErrorCode(), ErrorCode::CAPTURE_FAILED);
+    EXPECT_EQ(session.GetStatistics().frameCount, 0u);
+
+    // 失败后表面仍被保留，下一帧无需重新分配
+    EXPECT_TRUE(session.Capture().IsSuccess());
+    EXPECT_EQ(counters.allocations, 1);
+}
+
+TEST(CaptureSessionTest, RejectsEmptySource) {
+    FakeCaptureBackend::Counters counters;
+    CaptureSession session(std::make_unique<FakeCaptureBackend>(0, 10, &counters));
+
+    auto result = session.Capture();
+    EXPECT_TRUE(result.IsError());
+    EXPECT_EQ(result.GetErrorCode(), ErrorCode::INVALID_PARAMETER);
+    EXPECT_EQ(counters.allocations, 0);
+}
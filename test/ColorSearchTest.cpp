@@ -0,0 +1,285 @@
+#include <gtest/gtest.h>
+#include "../DataLayer/include/ColorSearch.h"
+#include "TestUtils.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace ColorSearch;
+using TestUtils::ForEachSimdLevel;
+
+namespace {
+
+struct TestImage {
+    int width;
+    int height;
+    std::vector<std::uint8_t> pixels;
+
+    TestImage(int w, int h) : width(w), height(h), pixels(static_cast<size_t>(w) * h * 4, 0) {}
+
+    ImageView View() const { return ImageView(pixels.data(), width, height, width * 4, PixelFormat::BGRA32); }
+
+    void Set(int x, int y, std::uint8_t r, std::uint8_t g, std::uint8_t b) {
+        std::uint8_t* p = &pixels[(static_cast<size_t>(y) * width + x) * 4];
+        p[0] = b;
+        p[1] = g;
+        p[2] = r;
+        p[3] = 255;
+    }
+};
+
+TestImage MakeNoise(int width, int height, unsigned seed) {
+    TestImage image(width, height);
+    std::mt19937 rng(seed);
+    for (auto& p : image.pixels) {
+        p = static_cast<std::uint8_t>(rng());
+    }
+    return image;
+}
+
+// 参考实现：逐像素判定 HSV（与文档中的整数规则一致）
+bool ReferenceHsv(const std::uint8_t* p, const HsvRange& range) {
+    int b = p[0], g = p[1], r = p[2];
+    int v = std::max(b, std::max(g, r));
+    int delta = v - std::min(b, std::min(g, r));
+    int s = v == 0 ? 0 : delta * 255 / v;
+    int h = 0;
+    if (delta != 0) {
+        if (v == r) {
+            h = 60 * (g - b) / delta;
+        } else if (v == g) {
+            h = 120 + 60 * (b - r) / delta;
+        } else {
+            h = 240 + 60 * (r - g) / delta;
+        }
+        if (h < 0) {
+            h += 360;
+        }
+    }
+    bool hueOk = range.hueMin <= range.hueMax ? (h >= range.hueMin && h <= range.hueMax)
+                                              : (h >= range.hueMin || h <= range.hueMax);
+    return hueOk && s >= range.saturationMin && s <= range.saturationMax && v >= range.valueMin && v <= range.valueMax;
+}
+
+bool ReferenceRange(const std::uint8_t* p, const ColorRange& range) {
+    for (int c = 0; c < 4; c++) {
+        if (p[c] < range.low[c] || p[c] > range.high[c]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Predicate>
+std::vector<Point> ReferenceRaster(const TestImage& image, Predicate predicate) {
+    std::vector<Point> hits;
+    for (int y = 0; y < image.height; y++) {
+        for (int x = 0; x < image.width; x++) {
+            if (predicate(&image.pixels[(static_cast<size_t>(y) * image.width + x) * 4])) {
+                hits.emplace_back(x, y);
+            }
+        }
+    }
+    return hits;
+}
+
+void ExpectSamePoints(const std::vector<Point>& actual, const std::vector<Point>& expected) {
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < actual.size(); i++) {
+        EXPECT_EQ(actual[i].x, expected[i].x) << "index " << i;
+        EXPECT_EQ(actual[i].y, expected[i].y) << "index " << i;
+    }
+}
+
+}  // namespace
+
+TEST(ColorSearchTest, FromRgbClampsRange) {
+    ColorRange range = ColorRange::FromRgb(250, 3, 100, 10);
+    EXPECT_EQ(range.low[2], 240);
+    EXPECT_EQ(range.high[2], 255);
+    EXPECT_EQ(range.low[1], 0);
+    EXPECT_EQ(range.high[1], 13);
+    EXPECT_EQ(range.low[0], 90);
+    EXPECT_EQ(range.high[0], 110);
+    EXPECT_EQ(range.low[3], 0);
+    EXPECT_EQ(range.high[3], 255);
+}
+
+TEST(ColorSearchTest, FindAllColorsMatchesReferenceAtEverySimdLevel) {
+    TestImage image = MakeNoise(301, 67, 1);
+    ColorRange range;
+    range.low = {0, 100, 150, 0};
+    range.high = {90, 200, 255, 255};
+    auto expected = ReferenceRaster(image, [&](const std::uint8_t* p) { return ReferenceRange(p, range); });
+    ASSERT_FALSE(expected.empty());
+
+    ForEachSimdLevel([&]() {
+        for (bool threaded : {false, true}) {
+            SearchOptions options;
+            options.multithreaded = threaded;
+            auto result = FindAllColors(image.View(), range, options);
+            ASSERT_TRUE(result.IsSuccess());
+            ExpectSamePoints(result.GetData(), expected);
+        }
+    });
+}
+
+TEST(ColorSearchTest, HsvSearchMatchesReferenceAtEverySimdLevel) {
+    TestImage image = MakeNoise(157, 93, 2);
+    std::vector<HsvRange> ranges(3);
+    ranges[0].hueMin = 90;
+    ranges[0].hueMax = 150;
+    ranges[0].saturationMin = 80;
+    ranges[1].hueMin = 340;  // 跨越 0 度
+    ranges[1].hueMax = 20;
+    ranges[1].valueMin = 100;
+    ranges[1].valueMax = 220;
+    ranges[2].saturationMax = 40;  // 全色相，只限制饱和度
+
+    for (const auto& range : ranges) {
+        auto expected = ReferenceRaster(image, [&](const std::uint8_t* p) { return ReferenceHsv(p, range); });
+        ASSERT_FALSE(expected.empty());
+        ForEachSimdLevel([&]() {
+            auto result = FindAllColors(image.View(), range);
+            ASSERT_TRUE(result.IsSuccess());
+            ExpectSamePoints(result.GetData(), expected);
+        });
+    }
+}
+
+TEST(ColorSearchTest, HsvHandlesBlackAndGray) {
+    TestImage image(4, 1);
+    image.Set(0, 0, 0, 0, 0);
+    image.Set(1, 0, 128, 128, 128);
+    image.Set(2, 0, 255, 0, 0);
+    image.Set(3, 0, 0, 0, 255);
+
+    HsvRange gray;
+    gray.saturationMax = 0;
+    HsvRange red;
+    red.hueMin = 350;
+    red.hueMax = 10;
+    red.saturationMin = 200;
+
+    ForEachSimdLevel([&]() {
+        ExpectSamePoints(FindAllColors(image.View(), gray).GetData(), {Point(0, 0), Point(1, 0)});
+        ExpectSamePoints(FindAllColors(image.View(), red).GetData(), {Point(2, 0)});
+    });
+}
+
+TEST(ColorSearchTest, RasterStartsAtStartPointAndWraps) {
+    TestImage image(40, 30);
+    image.Set(5, 2, 255, 0, 0);
+    image.Set(20, 10, 255, 0, 0);
+    image.Set(35, 10, 255, 0, 0);
+    image.Set(1, 25, 255, 0, 0);
+
+    SearchOptions options;
+    options.start = Point(21, 10);
+    ColorRange red = ColorRange::FromRgb(255, 0, 0);
+
+    auto first = FindColor(image.View(), red, options);
+    ASSERT_TRUE(first.IsSuccess());
+    ExpectSamePoints(first.GetData(), {Point(35, 10)});
+
+    auto all = FindAllColors(image.View(), red, options);
+    ExpectSamePoints(all.GetData(), {Point(35, 10), Point(1, 25), Point(5, 2), Point(20, 10)});
+
+    options.maxResults = 2;
+    ExpectSamePoints(FindAllColors(image.View(), red, options).GetData(), {Point(35, 10), Point(1, 25)});
+}
+
+TEST(ColorSearchTest, SpiralReturnsNearestFirst) {
+    TestImage image(500, 400);
+    std::vector<Point> placed = {Point(10, 10), Point(260, 190), Point(230, 205), Point(499, 399), Point(250, 150),
+                                 Point(100, 380)};
+    for (const auto& p : placed) {
+        image.Set(p.x, p.y, 0, 255, 0);
+    }
+
+    SearchOptions options;
+    options.order = SearchOrder::SPIRAL;
+    options.start = Point(250, 200);
+    ColorRange green = ColorRange::FromRgb(0, 255, 0);
+
+    ForEachSimdLevel([&]() {
+        auto all = FindAllColors(image.View(), green, options);
+        ASSERT_TRUE(all.IsSuccess());
+        // 切比雪夫距离：10, 20, 50, 150, 240, 249
+        ExpectSamePoints(all.GetData(), {Point(260, 190), Point(230, 205), Point(250, 150), Point(100, 380),
+                                         Point(10, 10), Point(499, 399)});
+
+        auto nearest = FindColor(image.View(), green, options);
+        ExpectSamePoints(nearest.GetData(), {Point(260, 190)});
+    });
+}
+
+TEST(ColorSearchTest, MaxResultsLimitsLargeThreadedScan) {
+    TestImage image(1024, 512);
+    for (int y = 0; y < image.height; y += 3) {
+        image.Set((y * 7) % image.width, y, 10, 20, 30);
+    }
+    ColorRange target = ColorRange::FromRgb(10, 20, 30);
+    auto expected = ReferenceRaster(image, [&](const std::uint8_t* p) { return ReferenceRange(p, target); });
+
+    SearchOptions options;
+    options.maxResults = 5;
+    auto limited = FindAllColors(image.View(), target, options);
+    ASSERT_TRUE(limited.IsSuccess());
+    ExpectSamePoints(limited.GetData(), std::vector<Point>(expected.begin(), expected.begin() + 5));
+
+    options.maxResults = 0;
+    ExpectSamePoints(FindAllColors(image.View(), target, options).GetData(), expected);
+}
+
+TEST(ColorSearchTest, CreateMaskMatchesReferenceAtEverySimdLevel) {
+    TestImage image = MakeNoise(601, 300, 9);
+    ColorRange range;
+    range.low = {0, 100, 150, 0};
+    range.high = {90, 200, 255, 255};
+    HsvRange hsv;
+    hsv.hueMin = 330;
+    hsv.hueMax = 20;
+    hsv.saturationMin = 80;
+
+    ForEachSimdLevel([&]() {
+        for (bool threaded : {false, true}) {
+            auto rangeMask = CreateMask(image.View(), range, threaded);
+            auto hsvMask = CreateMask(image.View(), hsv, threaded);
+            ASSERT_TRUE(rangeMask.IsSuccess());
+            ASSERT_TRUE(hsvMask.IsSuccess());
+            ImageView rangeView(rangeMask.GetData());
+            ImageView hsvView(hsvMask.GetData());
+            ASSERT_EQ(rangeView.format, PixelFormat::MONO1);
+            for (int y = 0; y < image.height; y++) {
+                for (int x = 0; x < image.width; x++) {
+                    const std::uint8_t* p = &image.pixels[(static_cast<size_t>(y) * image.width + x) * 4];
+                    ASSERT_EQ(rangeView.MaskBit(x, y), ReferenceRange(p, range)) << x << "," << y;
+                    ASSERT_EQ(hsvView.MaskBit(x, y), ReferenceHsv(p, hsv)) << x << "," << y;
+                }
+            }
+        }
+    });
+
+    hsv.hueMin = -1;
+    EXPECT_TRUE(CreateMask(image.View(), hsv).IsError());
+    EXPECT_TRUE(CreateMask(ImageView(), range).IsError());
+}
+
+TEST(ColorSearchTest, RejectsInvalidArguments) {
+    TestImage image(8, 8);
+    ColorRange range;
+    SearchOptions options;
+    options.start = Point(8, 0);
+    EXPECT_TRUE(FindColor(image.View(), range, options).IsError());
+    EXPECT_TRUE(FindColor(ImageView(), range).IsError());
+
+    HsvRange hsv;
+    hsv.hueMax = 360;
+    EXPECT_TRUE(FindAllColors(image.View(), hsv).IsError());
+
+    options.start = Point(0, 0);
+    options.maxResults = -1;
+    EXPECT_TRUE(FindAllColors(image.View(), range, options).IsError());
+}
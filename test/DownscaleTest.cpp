@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+#include "../DataLayer/include/Downscale.h"
+#include "TestUtils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace Downscale;
+using TestUtils::ForEachSimdLevel;
+
+namespace {
+
+// 随机图像，行尾带填充以覆盖 stride != width * 每像素字节数 的情况
+struct PaddedImage {
+    int width;
+    int height;
+    int stride;
+    PixelFormat format;
+    std::vector<std::uint8_t> pixels;
+
+    PaddedImage(int w, int h, PixelFormat f, unsigned seed)
+        : width(w), height(h), stride(GetRowBytes(w, f) + 20), format(f), pixels(static_cast<size_t>(stride) * h) {
+        std::mt19937 rng(seed);
+        for (auto& p : pixels) {
+            p = static_cast<std::uint8_t>(rng());
+        }
+    }
+
+    ImageView View() const { return ImageView(pixels.data(), width, height, stride, format); }
+};
+
+// 逐像素盒式滤波参考实现
+int ReferenceBox(const ImageView& view, int factor, int x, int y, int c) {
+    int channels = view.BytesPerPixel();
+    int sum = 0;
+    for (int dy = 0; dy < factor; dy++) {
+        for (int dx = 0; dx < factor; dx++) {
+            sum += view.Row(y * factor + dy)[(x * factor + dx) * channels + c];
+        }
+    }
+    return (sum + factor * factor / 2) / (factor * factor);
+}
+
+// 浮点面积平均参考实现
+double ReferenceArea(const ImageView& view, int width, int height, int x, int y, int c) {
+    double rx = static_cast<double>(view.width) / width;
+    double ry = static_cast<double>(view.height) / height;
+    int channels = view.BytesPerPixel();
+    double sum = 0.0;
+    for (int sy = static_cast<int>(y * ry); sy < std::min(view.height, static_cast<int>(std::ceil((y + 1) * ry))); sy++) {
+        double wy = std::min(sy + 1.0, (y + 1) * ry) - std::max(static_cast<double>(sy), y * ry);
+        for (int sx = static_cast<int>(x * rx); sx < std::min(view.width, static_cast<int>(std::ceil((x + 1) * rx))); sx++) {
+            double wx = std::min(sx + 1.0, (x + 1) * rx) - std::max(static_cast<double>(sx), x * rx);
+            sum += wx * wy * view.Row(sy)[sx * channels + c];
+        }
+    }
+    return sum / (rx * ry);
+}
+
+}  // namespace
+
+TEST(DownscaleTest, BoxMatchesReference) {
+    for (PixelFormat format : {PixelFormat::BGRA32, PixelFormat::GRAY8}) {
+        PaddedImage source(147, 37, format, 1);
+        ImageView view = source.View();
+        int channels = view.BytesPerPixel();
+        for (int factor : {2, 4}) {
+            ForEachSimdLevel([&]() {
+                ImageData output;
+                ASSERT_TRUE(Box(view, factor, output).IsSuccess());
+                EXPECT_EQ(output.width, 147 / factor);
+                EXPECT_EQ(output.height, 37 / factor);
+                EXPECT_EQ(output.GetFormat(), format);
+                EXPECT_EQ(output.stride, GetAlignedStride(output.width, format));
+                for (int y = 0; y < output.height; y++) {
+                    for (int x = 0; x < output.width; x++) {
+                        for (int c = 0; c < channels; c++) {
+                            ASSERT_EQ(output.data[static_cast<size_t>(y) * output.stride + x * channels + c],
+                                      ReferenceBox(view, factor, x, y, c))
+                                << "factor " << factor << " at " << x << "," << y << " channel " << c;
+                        }
+                    }
+                }
+            });
+        }
+    }
+}
+
+TEST(DownscaleTest, AreaAveragesWithinTolerance) {
+    for (PixelFormat format : {PixelFormat::BGRA32, PixelFormat::GRAY8}) {
+        PaddedImage source(203, 89, format, 2);
+        ImageView view = source.View();
+        int channels = view.BytesPerPixel();
+        const int sizes[][2] = {{45, 20}, {100, 89}, {7, 3}, {1, 1}};
+        for (const auto& size : sizes) {
+            ForEachSimdLevel([&]() {
+                ImageData output;
+                ASSERT_TRUE(Area(view, size[0], size[1], output).IsSuccess());
+                for (int y = 0; y < size[1]; y++) {
+                    for (int x = 0; x < size[0]; x++) {
+                        for (int c = 0; c < channels; c++) {
+                            double expected = ReferenceArea(view, size[0], size[1], x, y, c);
+                            int actual = output.data[static_cast<size_t>(y) * output.stride + x * channels + c];
+                            ASSERT_NEAR(actual, expected, 2.0) << size[0] << "x" << size[1] << " at " << x << "," << y;
+                        }
+                    }
+                }
+            });
+        }
+    }
+}
+
+TEST(DownscaleTest, AreaWithSameSizeCopiesPixels) {
+    PaddedImage source(33, 9, PixelFormat::BGRA32, 3);
+    ImageData output;
+    ASSERT_TRUE(Area(source.View(), 33, 9, output).IsSuccess());
+    for (int y = 0; y < 9; y++) {
+        for (int x = 0; x < 33 * 4; x++) {
+            ASSERT_EQ(output.data[static_cast<size_t>(y) * output.stride + x], source.View().Row(y)[x]);
+        }
+    }
+}
+
+TEST(DownscaleTest, ReusesOutputBuffer) {
+    PaddedImage first(640, 360, PixelFormat::BGRA32, 4);
+    PaddedImage second(640, 360, PixelFormat::BGRA32, 5);
+    ImageData output;
+    ASSERT_TRUE(Area(first.View(), 213, 120, output).IsSuccess());
+    const std::uint8_t* buffer = output.data.data();
+
+    ASSERT_TRUE(Area(second.View(), 213, 120, output).IsSuccess());
+    EXPECT_EQ(output.data.data(), buffer);
+    ASSERT_TRUE(Box(second.View(), 4, output).IsSuccess());
+    EXPECT_EQ(output.data.data(), buffer);
+    EXPECT_EQ(output.width, 160);
+}
+
+TEST(DownscaleTest, ParallelMatchesSerial) {
+    PaddedImage source(1024, 600, PixelFormat::BGRA32, 6);
+    DownscaleOptions serial;
+    serial.multithreaded = false;
+
+    ImageData parallelBox;
+    ImageData serialBox;
+    ASSERT_TRUE(Box(source.View(), 2, parallelBox).IsSuccess());
+    ASSERT_TRUE(Box(source.View(), 2, serialBox, serial).IsSuccess());
+    EXPECT_EQ(parallelBox.data, serialBox.data);
+
+    ImageData parallelArea;
+    ImageData serialArea;
+    ASSERT_TRUE(Area(source.View(), 300, 170, parallelArea).IsSuccess());
+    ASSERT_TRUE(Area(source.View(), 300, 170, serialArea, serial).IsSuccess());
+    EXPECT_EQ(parallelArea.data, serialArea.data);
+}
+
+TEST(DownscaleTest, RejectsInvalidRequests) {
+    PaddedImage source(16, 16, PixelFormat::BGRA32, 7);
+    ImageView view = source.View();
+    ImageData output;
+    std::vector<std::uint8_t> small(8 * 8);
+
+    EXPECT_TRUE(Box(view, 3, output).IsError());
+    EXPECT_TRUE(Box(ImageView(), 2, output).IsError());
+    EXPECT_TRUE(Box(view.Subview(WindowsAPI::Rectangle(0, 0, 3, 3)), 4, output).IsError());
+    EXPECT_TRUE(BoxRows(view, 2, small.data(), 8).IsError());
+    EXPECT_TRUE(Area(view, 32, 8, output).IsError());
+    EXPECT_TRUE(Area(view, 0, 8, output).IsError());
+    EXPECT_TRUE(Area(ImageView(small.data(), 8, 8, 4, PixelFormat::RGB565), 4, 4, output).IsError());
+
+    // 输出不能覆盖正在读取的源
+    ImageData image = CopyToImageData(view);
+    EXPECT_TRUE(Box(ImageView(image), 2, image).IsError());
+}
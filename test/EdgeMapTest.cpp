@@ -0,0 +1,294 @@
+#include <gtest/gtest.h>
+#include "../DataLayer/include/EdgeMap.h"
+#include "../DataLayer/include/TemplateMatcher.h"
+#include "TestUtils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace EdgeMap;
+using TestUtils::GrayImage;
+using TestUtils::ForEachSimdLevel;
+
+namespace {
+
+// 逐像素参考实现：复制边缘后做 3x3 卷积
+void ReferenceGradient(const GrayImage& image, Operator op, int x, int y, int& gx, int& gy) {
+    const int side = op == Operator::SCHARR ? 3 : 1;
+    const int center = op == Operator::SCHARR ? 10 : 2;
+    auto at = [&](int dx, int dy) {
+        return static_cast<int>(image.At(std::clamp(x + dx, 0, image.width - 1), std::clamp(y + dy, 0, image.height - 1)));
+    };
+    gx = side * (at(1, -1) - at(-1, -1)) + center * (at(1, 0) - at(-1, 0)) + side * (at(1, 1) - at(-1, 1));
+    gy = side * (at(-1, 1) - at(-1, -1)) + center * (at(0, 1) - at(0, -1)) + side * (at(1, 1) - at(1, -1));
+}
+
+int ReferenceMagnitude(int gx, int gy, Operator op) {
+    return std::min(255, (std::abs(gx) + std::abs(gy)) / (op == Operator::SCHARR ? 16 : 4));
+}
+
+int AngleDistance(int a, int b) {
+    const int d = std::abs(a - b) % 256;
+    return std::min(d, 256 - d);
+}
+
+// 随机矩形组成的界面截图
+GrayImage RenderScene(int width, int height, unsigned seed) {
+    GrayImage scene(width, height, 200);
+    std::mt19937 rng(seed);
+    for (int i = 0; i < 60; i++) {
+        const int w = 6 + static_cast<int>(rng() % 40);
+        const int h = 6 + static_cast<int>(rng() % 30);
+        const int left = static_cast<int>(rng() % (width - w));
+        const int top = static_cast<int>(rng() % (height - h));
+        const std::uint8_t value = static_cast<std::uint8_t>(40 + rng() % 180);
+        for (int y = top; y < top + h; y++) {
+            for (int x = left; x < left + w; x++) {
+                scene.At(x, y) = value;
+            }
+        }
+    }
+    return scene;
+}
+
+GrayImage Crop(const GrayImage& image, int left, int top, int width, int height) {
+    GrayImage crop(width, height);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            crop.At(x, y) = image.At(left + x, top + y);
+        }
+    }
+    return crop;
+}
+
+}  // namespace
+
+TEST(EdgeMapTest, MatchesReferenceAtEverySimdLevel) {
+    std::mt19937 rng(7);
+    for (Operator op : {Operator::SOBEL, Operator::SCHARR}) {
+        for (int width : {1, 2, 3, 16, 17, 18, 33, 50, 67}) {
+            GrayImage image(width, 9);
+            for (auto& p : image.pixels) {
+                p = static_cast<std::uint8_t>(rng());
+            }
+            ForEachSimdLevel([&] {
+                EdgeOptions options;
+                options.op = op;
+                auto maps = ComputeGradients(image.View(), options);
+                ASSERT_TRUE(maps.IsSuccess());
+                ImageView magnitude(maps.GetData().magnitude);
+                ImageView orientation(maps.GetData().orientation);
+                auto magnitudeOnly = ComputeMagnitude(image.View(), options);
+                ASSERT_TRUE(magnitudeOnly.IsSuccess());
+                ImageView plain(magnitudeOnly.GetData());
+                for (int y = 0; y < image.height; y++) {
+                    for (int x = 0; x < width; x++) {
+                        int gx, gy;
+                        ReferenceGradient(image, op, x, y, gx, gy);
+                        const int expected = ReferenceMagnitude(gx, gy, op);
+                        ASSERT_EQ(magnitude.Row(y)[x], expected) << "x " << x << " y " << y << " width " << width;
+                        ASSERT_EQ(plain.Row(y)[x], expected) << "x " << x << " y " << y << " width " << width;
+                        if (expected == 0) {
+                            EXPECT_EQ(orientation.Row(y)[x], 0);
+                        } else {
+                            const double turns = std::atan2(static_cast<double>(gy), static_cast<double>(gx)) * 128.0 / std::acos(-1.0);
+                            const int angle = static_cast<int>(std::lround(turns + 256.0)) & 0xFF;
+                            EXPECT_LE(AngleDistance(orientation.Row(y)[x], angle), 1) << "x " << x << " y " << y;
+                        }
+                    }
+                }
+            });
+        }
+    }
+}
+
+TEST(EdgeMapTest, StepEdgesAndOrientation) {
+    // 0 到 255 的理想竖直阶跃：阶跃两侧的列幅值为 255，其余为 0
+    GrayImage step(40, 5);
+    for (int y = 0; y < step.height; y++) {
+        for (int x = 20; x < step.width; x++) {
+            step.At(x, y) = 255;
+        }
+    }
+    for (Operator op : {Operator::SOBEL, Operator::SCHARR}) {
+        EdgeOptions options;
+        options.op = op;
+        auto maps = ComputeGradients(step.View(), options).TakeData();
+        ImageView magnitude(maps.magnitude);
+        ImageView orientation(maps.orientation);
+        for (int x = 0; x < step.width; x++) {
+            EXPECT_EQ(magnitude.Row(2)[x], (x == 19 || x == 20) ? 255 : 0) << "x " << x;
+        }
+        EXPECT_EQ(orientation.Row(2)[19], 0);
+    }
+
+    // 各方向的线性亮度斜坡：方向指向亮度增加的一侧
+    struct Ramp {
+        int dx;
+        int dy;
+        int expected;
+    };
+    for (const Ramp& ramp : {Ramp{1, 0, 0}, Ramp{1, 1, 32}, Ramp{0, 1, 64}, Ramp{-1, 1, 96},
+                             Ramp{-1, 0, 128}, Ramp{-1, -1, 160}, Ramp{0, -1, 192}, Ramp{1, -1, 224}}) {
+        GrayImage image(32, 32);
+        for (int y = 0; y < 32; y++) {
+            for (int x = 0; x < 32; x++) {
+                image.At(x, y) = static_cast<std::uint8_t>(128 + 3 * (ramp.dx * (x - 16) + ramp.dy * (y - 16)));
+            }
+        }
+        auto maps = ComputeGradients(image.View()).TakeData();
+        EXPECT_EQ(ImageView(maps.orientation).Row(16)[16], ramp.expected) << ramp.dx << "," << ramp.dy;
+        EXPECT_GT(ImageView(maps.magnitude).Row(16)[16], 0);
+    }
+
+    // 平坦区域幅值与方向都为 0
+    GrayImage flat(20, 20, 90);
+    auto maps = ComputeGradients(flat.View()).TakeData();
+    EXPECT_TRUE(std::all_of(maps.magnitude.data.begin(), maps.magnitude.data.end(), [](std::uint8_t v) { return v == 0; }));
+    EXPECT_TRUE(std::all_of(maps.orientation.data.begin(), maps.orientation.data.end(), [](std::uint8_t v) { return v == 0; }));
+}
+
+TEST(EdgeMapTest, BgraInputAndParallelBandsMatchSerial) {
+    GrayImage scene = RenderScene(320, 300, 3);
+    std::vector<std::uint8_t> bgra(scene.pixels.size() * 4);
+    for (size_t i = 0; i < scene.pixels.size(); i++) {
+        bgra[i * 4] = bgra[i * 4 + 1] = bgra[i * 4 + 2] = scene.pixels[i];
+        bgra[i * 4 + 3] = 255;
+    }
+    ImageView bgraView(bgra.data(), scene.width, scene.height, scene.width * 4, PixelFormat::BGRA32);
+
+    EdgeOptions serial;
+    serial.multithreaded = false;
+    auto expected = ComputeMagnitude(scene.View(), serial).TakeData();
+    auto parallel = ComputeMagnitude(scene.View()).TakeData();
+    auto fromBgra = ComputeMagnitude(bgraView, serial).TakeData();
+    EXPECT_EQ(parallel.data, expected.data);
+    EXPECT_EQ(fromBgra.data, expected.data);
+}
+
+TEST(EdgeMapTest, EdgeMatchingSurvivesThemeChanges) {
+    GrayImage scene = RenderScene(400, 300, 11);
+    GrayImage templ = Crop(scene, 180, 120, 60, 40);
+
+    // 深色主题：明暗反转并降低对比度
+    GrayImage dark(scene.width, scene.height);
+    for (size_t i = 0; i < scene.pixels.size(); i++) {
+        dark.pixels[i] = static_cast<std::uint8_t>(20 + (255 - scene.pixels[i]) * 3 / 5);
+    }
+
+    TemplateMatcher::MatchOptions intensity;
+    auto plain = TemplateMatcher::FindTemplate(dark.View(), templ.View(), intensity);
+    ASSERT_TRUE(plain.IsSuccess());
+    EXPECT_TRUE(plain.GetData().empty() ||
+                plain.GetData()[0].location.x != 180 || plain.GetData()[0].location.y != 120);
+
+    for (Operator op : {Operator::SOBEL, Operator::SCHARR}) {
+        TemplateMatcher::MatchOptions edges;
+        edges.features = TemplateMatcher::MatchFeatures::EDGES;
+        edges.edgeOperator = op;
+        for (const GrayImage* haystack : {&scene, &dark}) {
+            auto found = TemplateMatcher::FindTemplate(haystack->View(), templ.View(), edges);
+            ASSERT_TRUE(found.IsSuccess());
+            ASSERT_EQ(found.GetData().size(), 1u);
+            EXPECT_EQ(found.GetData()[0].location.x, 180);
+            EXPECT_EQ(found.GetData()[0].location.y, 120);
+            EXPECT_GT(found.GetData()[0].score, 0.9);
+        }
+    }
+}
+
+TEST(EdgeMapTest, TemplateCacheReusesMaps) {
+    GrayImage scene = RenderScene(400, 300, 5);
+    GrayImage templ = Crop(scene, 60, 200, 48, 32);
+    GrayImage other = Crop(scene, 300, 40, 32, 32);
+
+    TemplateCache cache(Operator::SCHARR);
+    EXPECT_EQ(cache.GetOperator(), Operator::SCHARR);
+    auto first = cache.Get(0, templ.View());
+    ASSERT_TRUE(first.IsSuccess());
+    auto second = cache.Get(0, templ.View());
+    EXPECT_EQ(first.GetData().data, second.GetData().data);
+    EXPECT_EQ(cache.GetSize(), 1u);
+
+    EdgeOptions options;
+    options.op = Operator::SCHARR;
+    auto direct = ComputeMagnitude(templ.View(), options).TakeData();
+    for (int y = 0; y < templ.height; y++) {
+        EXPECT_TRUE(std::equal(direct.data.begin() + static_cast<size_t>(y) * direct.stride,
+                               direct.data.begin() + static_cast<size_t>(y) * direct.stride + templ.width,
+                               first.GetData().Row(y)));
+    }
+
+    TemplateMatcher::MatchOptions matchOptions;
+    matchOptions.features = TemplateMatcher::MatchFeatures::EDGES;
+    matchOptions.edgeOperator = Operator::SCHARR;
+    auto uncached = TemplateMatcher::FindTemplate(scene.View(), templ.View(), matchOptions).TakeData();
+    matchOptions.edgeCache = &cache;
+    EXPECT_EQ(TemplateMatcher::FindTemplate(scene.View(), templ.View(), matchOptions).GetErrorCode(),
+              ErrorCode::INVALID_PARAMETER);
+    matchOptions.edgeTemplateId = 0;
+    auto cached = TemplateMatcher::FindTemplate(scene.View(), templ.View(), matchOptions).TakeData();
+    ASSERT_EQ(cached.size(), 1u);
+    ASSERT_EQ(uncached.size(), 1u);
+    EXPECT_EQ(cached[0].location.x, 60);
+    EXPECT_EQ(cached[0].location.y, 200);
+    EXPECT_EQ(cached[0].score, uncached[0].score);
+    EXPECT_EQ(cache.GetSize(), 1u);
+
+    ASSERT_TRUE(cache.Get(1, other.View()).IsSuccess());
+    EXPECT_EQ(cache.GetSize(), 2u);
+
+    // 按编号缓存：同一块内存换成另一个模板时，新编号得到新模板的幅值图
+    GrayImage reused = Crop(scene, 60, 200, 48, 32);
+    const ImageView before = cache.Get(2, reused.View()).GetData();
+    GrayImage replacement = Crop(scene, 200, 100, 48, 32);
+    std::copy(replacement.pixels.begin(), replacement.pixels.end(), reused.pixels.begin());
+    // 旧编号仍是旧内容的幅值图（内容改变后应 Remove 或换编号）
+    EXPECT_EQ(cache.Get(2, reused.View()).GetData().data, before.data);
+    auto fresh = cache.Get(3, reused.View());
+    ASSERT_TRUE(fresh.IsSuccess());
+    auto expected = ComputeMagnitude(replacement.View(), options).TakeData();
+    for (int y = 0; y < replacement.height; y++) {
+        EXPECT_TRUE(std::equal(expected.data.begin() + static_cast<size_t>(y) * expected.stride,
+                               expected.data.begin() + static_cast<size_t>(y) * expected.stride + replacement.width,
+                               fresh.GetData().Row(y)));
+    }
+
+    // 编号被另一尺寸的模板复用时报错；移除后可重新登记
+    EXPECT_EQ(cache.Get(1, templ.View()).GetErrorCode(), ErrorCode::INVALID_PARAMETER);
+    EXPECT_TRUE(cache.Remove(1));
+    EXPECT_FALSE(cache.Remove(1));
+    ASSERT_TRUE(cache.Get(1, templ.View()).IsSuccess());
+    EXPECT_EQ(cache.GetSize(), 4u);
+
+    // 缓存算子与匹配选项不一致
+    matchOptions.edgeOperator = Operator::SOBEL;
+    EXPECT_EQ(TemplateMatcher::FindTemplate(scene.View(), templ.View(), matchOptions).GetErrorCode(),
+              ErrorCode::INVALID_PARAMETER);
+
+    cache.Clear();
+    EXPECT_EQ(cache.GetSize(), 0u);
+}
+
+TEST(EdgeMapTest, RejectsInvalidInput) {
+    EXPECT_TRUE(ComputeMagnitude(ImageView()).IsError());
+    std::vector<std::uint8_t> rgb(30 * 10 * 3);
+    EXPECT_EQ(ComputeGradients(ImageView(rgb.data(), 30, 10, 90, PixelFormat::RGB24)).GetErrorCode(),
+              ErrorCode::INVALID_PARAMETER);
+    TemplateCache cache;
+    EXPECT_TRUE(cache.Get(0, ImageView()).IsError());
+    GrayImage small(8, 8);
+    EXPECT_EQ(cache.Get(-1, small.View()).GetErrorCode(), ErrorCode::INVALID_PARAMETER);
+    EXPECT_EQ(cache.GetSize(), 0u);
+
+    // 边缘匹配去掉一像素边框后模板至少要剩 1x1
+    GrayImage haystack(20, 20);
+    GrayImage tiny(2, 5);
+    TemplateMatcher::MatchOptions options;
+    options.features = TemplateMatcher::MatchFeatures::EDGES;
+    EXPECT_EQ(TemplateMatcher::FindTemplate(haystack.View(), tiny.View(), options).GetErrorCode(),
+              ErrorCode::INVALID_PARAMETER);
+}
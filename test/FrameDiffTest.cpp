@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include "../DataLayer/include/FrameDiff.h"
+#include "../Common/include/CpuFeatures.h"
+#include "TestUtils.h"
+
+#include <random>
+#include <vector>
+
+using namespace FrameDiff;
+using TestUtils::ForEachSimdLevel;
+
+namespace {
+
+struct Frame {
+    int width;
+    int height;
+    std::vector<std::uint8_t> pixels;
+
+    Frame(int w, int h, std::uint8_t fill = 0x40) : width(w), height(h), pixels(static_cast<size_t>(w) * h * 4, fill) {}
+
+    std::uint8_t* At(int x, int y) { return &pixels[(static_cast<size_t>(y) * width + x) * 4]; }
+    ImageView View() const { return ImageView(pixels.data(), width, height, width * 4, PixelFormat::BGRA32); }
+};
+
+}  // namespace
+
+TEST(FrameDiffTest, IdenticalFramesHaveNoDirtyRects) {
+    Frame a(100, 60);
+    Frame b(100, 60);
+
+    ForEachSimdLevel([&]() {
+        auto result = Compare(a.View(), b.View());
+        ASSERT_TRUE(result.IsSuccess());
+        EXPECT_FALSE(result.GetData().HasChanges());
+        EXPECT_TRUE(result.GetData().dirtyRects.empty());
+        EXPECT_EQ(result.GetData().changedRatio, 0.0);
+        EXPECT_FALSE(HasChanged(a.View(), b.View()).GetData());
+    });
+}
+
+TEST(FrameDiffTest, SinglePixelChangeMarksOneTile) {
+    Frame a(100, 60);
+    Frame b(100, 60);
+    b.At(70, 40)[2] = 0xFF;
+
+    ForEachSimdLevel([&]() {
+        auto result = Compare(a.View(), b.View());
+        ASSERT_TRUE(result.IsSuccess());
+        const DiffResult& diff = result.GetData();
+        EXPECT_EQ(diff.changedPixels, 1u);
+        EXPECT_EQ(diff.dirtyTileCount, 1);
+        ASSERT_EQ(diff.dirtyRects.size(), 1u);
+        // 最后一列/行瓦片被裁剪到图像边界
+        EXPECT_EQ(diff.dirtyRects[0].left, 64);
+        EXPECT_EQ(diff.dirtyRects[0].top, 32);
+        EXPECT_EQ(diff.dirtyRects[0].right, 96);
+        EXPECT_EQ(diff.dirtyRects[0].bottom, 60);
+        EXPECT_TRUE(HasChanged(a.View(), b.View()).GetData());
+    });
+}
+
+TEST(FrameDiffTest, ToleranceIgnoresNoiseAndAlpha) {
+    Frame a(64, 64);
+    Frame b(64, 64);
+    for (int y = 0; y < 64; y++) {
+        for (int x = 0; x < 64; x++) {
+            b.At(x, y)[0] += 3;
+            b.At(x, y)[3] = 0;
+        }
+    }
+
+    DiffOptions options;
+    options.SetColorTolerance(3);
+    ForEachSimdLevel([&]() {
+        EXPECT_FALSE(Compare(a.View(), b.View(), options).GetData().HasChanges());
+
+        DiffOptions strict;
+        strict.channelTolerance = {2, 2, 2, 255};
+        EXPECT_EQ(Compare(a.View(), b.View(), strict).GetData().changedPixels, 64u * 64u);
+
+        DiffOptions withAlpha;
+        withAlpha.channelTolerance = {3, 3, 3, 0};
+        EXPECT_EQ(Compare(a.View(), b.View(), withAlpha).GetData().changedRatio, 1.0);
+    });
+}
+
+TEST(FrameDiffTest, AdjacentDirtyTilesAreMerged) {
+    Frame a(128, 128);
+    Frame b(128, 128);
+    // 覆盖瓦片 (1..2, 1..2) 的变化块，以及一个独立的瓦片 (0,3)
+    for (int y = 40; y < 90; y++) {
+        for (int x = 40; x < 90; x++) {
+            b.At(x, y)[1] = 0;
+        }
+    }
+    b.At(5, 100)[0] = 0;
+
+    ForEachSimdLevel([&]() {
+        auto result = Compare(a.View(), b.View());
+        ASSERT_TRUE(result.IsSuccess());
+        const auto& rects = result.GetData().dirtyRects;
+        ASSERT_EQ(rects.size(), 2u);
+        EXPECT_EQ(rects[0].left, 32);
+        EXPECT_EQ(rects[0].top, 32);
+        EXPECT_EQ(rects[0].right, 96);
+        EXPECT_EQ(rects[0].bottom, 96);
+        EXPECT_EQ(rects[1].left, 0);
+        EXPECT_EQ(rects[1].top, 96);
+        EXPECT_EQ(rects[1].right, 32);
+        EXPECT_EQ(rects[1].bottom, 128);
+        EXPECT_EQ(result.GetData().changedPixels, 50u * 50u + 1u);
+    });
+}
+
+TEST(FrameDiffTest, SimdKernelsMatchScalar) {
+    Frame a(257, 131);
+    Frame b(257, 131);
+    std::mt19937 rng(1234);
+    for (size_t i = 0; i < a.pixels.size(); i++) {
+        a.pixels[i] = static_cast<std::uint8_t>(rng());
+        b.pixels[i] = static_cast<std::uint8_t>(a.pixels[i] + static_cast<int>(rng() % 9) - 4);
+    }
+    DiffOptions options;
+    options.tileSize = 16;
+    options.channelTolerance = {3, 2, 4, 1};
+
+    CpuFeatures::SetMaxSimdLevel(CpuFeatures::SimdLevel::SCALAR);
+    auto expected = Compare(a.View(), b.View(), options).GetData();
+    ForEachSimdLevel([&]() {
+        auto actual = Compare(a.View(), b.View(), options).GetData();
+        EXPECT_EQ(actual.changedPixels, expected.changedPixels);
+        EXPECT_EQ(actual.dirtyTileCount, expected.dirtyTileCount);
+        EXPECT_EQ(actual.dirtyRects.size(), expected.dirtyRects.size());
+    });
+}
+
+TEST(FrameDiffTest, RespectsStrideOfSubviews) {
+    Frame a(64, 64);
+    Frame b(64, 64);
+    b.At(10, 10)[0] = 0;
+
+    WindowsAPI::Rectangle inner(8, 8, 24, 24);
+    auto result = Compare(a.View().Subview(inner), b.View().Subview(inner), DiffOptions());
+    ASSERT_TRUE(result.IsSuccess());
+    ASSERT_EQ(result.GetData().dirtyRects.size(), 1u);
+    EXPECT_EQ(result.GetData().dirtyRects[0].right, 16);
+}
+
+TEST(FrameDiffTest, RejectsMismatchedFrames) {
+    Frame a(10, 10);
+    Frame b(10, 11);
+    EXPECT_EQ(Compare(a.View(), b.View()).GetErrorCode(), ErrorCode::INVALID_PARAMETER);
+    EXPECT_TRUE(HasChanged(a.View(), ImageView()).IsError());
+
+    std::vector<std::uint8_t> gray(100);
+    ImageView grayView(gray.data(), 10, 10, 10, PixelFormat::GRAY8);
+    EXPECT_TRUE(Compare(grayView, grayView).IsError());
+}
@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+#include "../DataLayer/include/GlyphReader.h"
+#include "TestUtils.h"
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace GlyphReader;
+using TestUtils::GrayImage;
+
+namespace {
+
+// 5x7 点阵字体（'.' 与 ':' 为单列）
+const std::map<wchar_t, std::vector<const char*>>& Patterns() {
+    static const std::map<wchar_t, std::vector<const char*>> patterns = {
+        {L'0', {"01110", "10001", "10011", "10101", "11001", "10001", "01110"}},
+        {L'1', {"00100", "01100", "00100", "00100", "00100", "00100", "01110"}},
+        {L'2', {"01110", "10001", "00001", "00010", "00100", "01000", "11111"}},
+        {L'3', {"11111", "00010", "00100", "00010", "00001", "10001", "01110"}},
+        {L'4', {"00010", "00110", "01010", "10010", "11111", "00010", "00010"}},
+        {L'5', {"11111", "10000", "11110", "00001", "00001", "10001", "01110"}},
+        {L'6', {"00110", "01000", "10000", "11110", "10001", "10001", "01110"}},
+        {L'7', {"11111", "00001", "00010", "00100", "01000", "01000", "01000"}},
+        {L'8', {"01110", "10001", "10001", "01110", "10001", "10001", "01110"}},
+        {L'9', {"01110", "10001", "10001", "01111", "00001", "00010", "01100"}},
+        {L'X', {"10001", "10001", "01010", "00100", "01010", "10001", "10001"}},
+        {L':', {"0", "1", "1", "0", "1", "1", "0"}},
+        {L'.', {"0", "0", "0", "0", "0", "1", "1"}},
+    };
+    return patterns;
+}
+
+// 按 scale 倍放大渲染文本：字符间隔 spacing 列（放大前），空格占 4 列
+GrayImage Render(const std::wstring& text, int scale, int spacing, std::uint8_t ink, std::uint8_t background) {
+    const int margin = 3;
+    int columns = 0;
+    for (wchar_t c : text) {
+        columns += (c == L' ' ? 4 : static_cast<int>(std::string(Patterns().at(c)[0]).size())) + spacing;
+    }
+    GrayImage image;
+    image.width = columns * scale + margin * 2;
+    image.height = 7 * scale + margin * 2;
+    image.pixels.assign(static_cast<size_t>(image.width) * image.height, background);
+    int x = margin;
+    for (wchar_t c : text) {
+        if (c == L' ') {
+            x += (4 + spacing) * scale;
+            continue;
+        }
+        const auto& rows = Patterns().at(c);
+        const int glyphWidth = static_cast<int>(std::string(rows[0]).size());
+        for (int r = 0; r < 7; r++) {
+            for (int col = 0; col < glyphWidth; col++) {
+                if (rows[r][col] != '1') {
+                    continue;
+                }
+                for (int dy = 0; dy < scale; dy++) {
+                    for (int dx = 0; dx < scale; dx++) {
+                        image.pixels[static_cast<size_t>(margin + r * scale + dy) * image.width + x + col * scale + dx] = ink;
+                    }
+                }
+            }
+        }
+        x += (glyphWidth + spacing) * scale;
+    }
+    return image;
+}
+
+std::vector<std::uint8_t> ToBgra(const GrayImage& gray, std::uint8_t tint) {
+    std::vector<std::uint8_t> bgra(gray.pixels.size() * 4);
+    for (size_t i = 0; i < gray.pixels.size(); i++) {
+        bgra[i * 4] = gray.pixels[i];
+        bgra[i * 4 + 1] = static_cast<std::uint8_t>(gray.pixels[i] / 2 + tint / 2);
+        bgra[i * 4 + 2] = gray.pixels[i];
+        bgra[i * 4 + 3] = 255;
+    }
+    return bgra;
+}
+
+Font LearnDigits() {
+    Font font;
+    EXPECT_EQ(font.Learn(Render(L"0123456789", 2, 1, 20, 230).View(), L"0123456789").GetData(), 10);
+    EXPECT_EQ(font.Learn(Render(L"12 34:5.6", 2, 1, 20, 230).View(), L"12 34:5.6").GetData(), 8);
+    return font;
+}
+
+}  // namespace
+
+TEST(GlyphReaderTest, LearnsAndReadsText) {
+    Font font = LearnDigits();
+    EXPECT_EQ(font.GetGlyphCount(), 18);
+    EXPECT_EQ(font.GetLineHeight(), 14);
+    EXPECT_GT(font.GetSpaceGap(), 0);
+
+    for (const std::wstring text : {L"4096 1337", L"12:58:07", L"3.14159", L"9876543210"}) {
+        GrayImage capture = Render(text, 2, 1, 35, 240);
+        auto read = font.Read(capture.View());
+        ASSERT_TRUE(read.IsSuccess());
+        EXPECT_EQ(read.GetData().text, text);
+        EXPECT_EQ(read.GetData().confidence, 1.0);
+    }
+
+    auto read = font.Read(Render(L"70", 2, 1, 20, 230).View()).TakeData();
+    ASSERT_EQ(read.glyphs.size(), 2u);
+    EXPECT_EQ(read.glyphs[0].character, L'7');
+    EXPECT_EQ(read.glyphs[0].bounds.left, 3);
+    EXPECT_EQ(read.glyphs[0].bounds.top, 3);
+    EXPECT_EQ(read.glyphs[0].bounds.right, 13);
+    EXPECT_EQ(read.glyphs[0].bounds.bottom, 17);
+    EXPECT_EQ(read.glyphs[1].bounds.left, 15);
+}
+
+TEST(GlyphReaderTest, ReadsColoredAndInvertedCaptures) {
+    Font font = LearnDigits();
+
+    // 深色背景上的浅色文字，BGRA 输入，极性自动判断
+    GrayImage inverted = Render(L"2024", 2, 1, 250, 10);
+    std::vector<std::uint8_t> bgra = ToBgra(inverted, 90);
+    ImageView view(bgra.data(), inverted.width, inverted.height, inverted.width * 4, PixelFormat::BGRA32);
+    EXPECT_EQ(font.Read(view).GetData().text, L"2024");
+
+    // 指定错误的极性时背景成为墨迹，读不出原文
+    ReadOptions options;
+    options.binarize.polarity = Polarity::DARK_ON_LIGHT;
+    EXPECT_NE(font.Read(view, options).GetData().text, L"2024");
+
+    // 噪声与亮度起伏
+    GrayImage noisy = Render(L"86420", 2, 1, 40, 220);
+    std::mt19937 rng(1);
+    for (auto& p : noisy.pixels) {
+        p = static_cast<std::uint8_t>(std::clamp(static_cast<int>(p) + static_cast<int>(rng() % 41) - 20, 0, 255));
+    }
+    auto read = font.Read(noisy.View());
+    ASSERT_TRUE(read.IsSuccess());
+    EXPECT_EQ(read.GetData().text, L"86420");
+}
+
+TEST(GlyphReaderTest, HandlesUnknownAndTouchingGlyphs) {
+    Font font = LearnDigits();
+
+    auto unknown = font.Read(Render(L"1X2", 2, 1, 20, 230).View()).TakeData();
+    EXPECT_EQ(unknown.text, L"1?2");
+    ASSERT_EQ(unknown.glyphs.size(), 3u);
+    EXPECT_LT(unknown.glyphs[1].confidence, 0.75);
+    EXPECT_EQ(unknown.confidence, unknown.glyphs[1].confidence);
+
+    // 字符间隔为 0 时 8 与 0 的笔画相连，整段按模板宽度拆分
+    EXPECT_EQ(font.Read(Render(L"808", 2, 0, 20, 230).View()).GetData().text, L"808");
+
+    // 间隔按墨迹计算：1 右侧的空白列使 1 与 2 的间隔（4）大于 2 与 3（2）
+    ReadOptions options;
+    options.spaceGap = 3;
+    EXPECT_EQ(font.Read(Render(L"123", 2, 1, 20, 230).View(), options).GetData().text, L"1 23");
+}
+
+TEST(GlyphReaderTest, EmptyRegionReadsNothing) {
+    Font font = LearnDigits();
+    GrayImage blank;
+    blank.width = 40;
+    blank.height = 20;
+    blank.pixels.assign(800, 128);
+    auto read = font.Read(blank.View());
+    ASSERT_TRUE(read.IsSuccess());
+    EXPECT_TRUE(read.GetData().text.empty());
+    EXPECT_EQ(read.GetData().confidence, 0.0);
+}
+
+TEST(GlyphReaderTest, RejectsInvalidInput) {
+    Font font;
+    GrayImage sample = Render(L"123", 2, 1, 20, 230);
+    EXPECT_EQ(font.Read(sample.View()).GetErrorCode(), ErrorCode::OPERATION_FAILED);
+    EXPECT_EQ(font.Learn(sample.View(), L"12").GetErrorCode(), ErrorCode::OPERATION_FAILED);
+    EXPECT_EQ(font.Learn(sample.View(), L"  ").GetErrorCode(), ErrorCode::INVALID_PARAMETER);
+    EXPECT_EQ(font.GetGlyphCount(), 0);
+
+    ASSERT_TRUE(font.Learn(sample.View(), L"123").IsSuccess());
+    EXPECT_EQ(font.Learn(Render(L"45", 3, 1, 20, 230).View(), L"45").GetErrorCode(), ErrorCode::INVALID_PARAMETER);
+    EXPECT_EQ(font.GetGlyphCount(), 3);
+
+    std::vector<std::uint8_t> rgb(30 * 10 * 3);
+    EXPECT_TRUE(font.Read(ImageView(rgb.data(), 30, 10, 90, PixelFormat::RGB24)).IsError());
+    EXPECT_TRUE(font.Read(ImageView()).IsError());
+
+    font.Clear();
+    EXPECT_EQ(font.GetGlyphCount(), 0);
+    EXPECT_EQ(font.GetLineHeight(), 0);
+}
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include "../Common/include/ImageView.h"
+
+using namespace WindowsAPI;
+
+namespace {
+
+ImageData MakeImage(int width, int height) {
+    ImageData image;
+    image.width = width;
+    image.height = height;
+    image.bitsPerPixel = 32;
+    image.stride = width * 4;
+    image.data.resize(static_cast<size_t>(image.stride) * height);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            std::uint8_t* p = &image.data[static_cast<size_t>(y) * image.stride + x * 4];
+            p[0] = static_cast<std::uint8_t>(x);
+            p[1] = static_cast<std::uint8_t>(y);
+            p[2] = 0;
+            p[3] = 255;
+        }
+    }
+    return image;
+}
+
+}  // namespace
+
+TEST(ImageViewTest, ViewReferencesImageDataWithoutCopy) {
+    ImageData image = MakeImage(16, 8);
+    ImageView view(image);
+
+    EXPECT_EQ(view.data, image.data.data());
+    EXPECT_EQ(view.width, 16);
+    EXPECT_EQ(view.height, 8);
+    EXPECT_EQ(view.stride, 64);
+    EXPECT_EQ(view.format, PixelFormat::BGRA32);
+    EXPECT_EQ(view.BytesPerPixel(), 4);
+    EXPECT_TRUE(ImageView(ImageData()).IsEmpty());
+}
+
+TEST(ImageViewTest, SubviewSharesPixelsAndKeepsStride) {
+    ImageData image = MakeImage(32, 32);
+    ImageView view(image);
+
+    ImageView sub = view.Subview(WindowsAPI::Rectangle(4, 6, 14, 10));
+    EXPECT_EQ(sub.width, 10);
+    EXPECT_EQ(sub.height, 4);
+    EXPECT_EQ(sub.stride, view.stride);
+    EXPECT_EQ(sub.data, view.PixelAt(4, 6));
+    EXPECT_EQ(sub.PixelAt(2, 3)[0], 6);
+    EXPECT_EQ(sub.PixelAt(2, 3)[1], 9);
+
+    // 子视图的子视图仍以父视图内存为基准
+    ImageView nested = sub.Subview(WindowsAPI::Rectangle(1, 1, 3, 3));
+    EXPECT_EQ(nested.data, view.PixelAt(5, 7));
+}
+
+TEST(ImageViewTest, SubviewClipsToBounds) {
+    ImageData image = MakeImage(20, 10);
+    ImageView view(image);
+
+    ImageView clipped = view.Subview(WindowsAPI::Rectangle(-5, 8, 4, 30));
+    EXPECT_EQ(clipped.width, 4);
+    EXPECT_EQ(clipped.height, 2);
+    EXPECT_EQ(clipped.data, view.PixelAt(0, 8));
+
+    EXPECT_TRUE(view.Subview(WindowsAPI::Rectangle(25, 0, 30, 5)).IsEmpty());
+    EXPECT_TRUE(view.Subview(WindowsAPI::Rectangle(5, 5, 5, 8)).IsEmpty());
+}
+
+TEST(ImageViewTest, CopyToImageDataPacksRows) {
+    ImageData image = MakeImage(24, 12);
+    ImageView sub = ImageView(image).Subview(WindowsAPI::Rectangle(3, 2, 8, 7));
+
+    ImageData copy = CopyToImageData(sub);
+    EXPECT_EQ(copy.width, 5);
+    EXPECT_EQ(copy.height, 5);
+    EXPECT_EQ(copy.stride, 20);
+    EXPECT_EQ(copy.bitsPerPixel, 32);
+    ASSERT_EQ(copy.data.size(), 100u);
+    for (int y = 0; y < copy.height; y++) {
+        for (int x = 0; x < copy.width; x++) {
+            EXPECT_EQ(copy.data[static_cast<size_t>(y) * copy.stride + x * 4], 3 + x);
+            EXPECT_EQ(copy.data[static_cast<size_t>(y) * copy.stride + x * 4 + 1], 2 + y);
+        }
+    }
+}
+
+TEST(ImageViewTest, Gray8Format) {
+    std::vector<std::uint8_t> pixels(10 * 10);
+    for (size_t i = 0; i < pixels.size(); i++) {
+        pixels[i] = static_cast<std::uint8_t>(i);
+    }
+    ImageView view(pixels.data(), 10, 10, 10, PixelFormat::GRAY8);
+
+    ImageView sub = view.Subview(WindowsAPI::Rectangle(2, 3, 5, 6));
+    EXPECT_EQ(*sub.data, 32);
+    EXPECT_EQ(sub.BytesPerPixel(), 1);
+    EXPECT_EQ(CopyToImageData(sub).bitsPerPixel, 8);
+}
+
+TEST(ImageViewTest, FormatConstructorAlignsRows) {
+    ImageData rgb(5, 3, PixelFormat::RGB24);
+    EXPECT_EQ(rgb.GetFormat(), PixelFormat::RGB24);
+    EXPECT_EQ(rgb.bitsPerPixel, 24);
+    EXPECT_EQ(rgb.stride, 16);
+    EXPECT_EQ(rgb.data.size(), 48u);
+
+    ImageData rgb565(3, 2, PixelFormat::RGB565);
+    EXPECT_EQ(rgb565.stride, 8);
+    EXPECT_EQ(ImageView(rgb565).format, PixelFormat::RGB565);
+
+    ImageData mask(33, 2, PixelFormat::MONO1);
+    EXPECT_EQ(mask.stride, 8);
+    EXPECT_EQ(GetRowBytes(33, PixelFormat::MONO1), 5);
+
+    // 未设置 format 时按位数推断
+    EXPECT_EQ(MakeImage(2, 2).GetFormat(), PixelFormat::BGRA32);
+}
+
+TEST(ImageViewTest, Mono1BitsAndSubview) {
+    ImageData mask(20, 2, PixelFormat::MONO1);
+    mask.data[0] = 0x80;   // x = 0
+    mask.data[1] = 0x01;   // x = 15
+    mask.data[mask.stride + 2] = 0x40;  // x = 17, y = 1
+    ImageView view(mask);
+
+    EXPECT_TRUE(view.MaskBit(0, 0));
+    EXPECT_FALSE(view.MaskBit(1, 0));
+    EXPECT_TRUE(view.MaskBit(15, 0));
+    EXPECT_TRUE(view.MaskBit(17, 1));
+    EXPECT_EQ(view.BitsPerPixel(), 1);
+
+    // 子视图左边界必须落在整字节上
+    ImageView sub = view.Subview(WindowsAPI::Rectangle(8, 0, 20, 2));
+    EXPECT_TRUE(sub.MaskBit(7, 0));
+    EXPECT_TRUE(sub.MaskBit(9, 1));
+    EXPECT_TRUE(view.Subview(WindowsAPI::Rectangle(3, 0, 20, 2)).IsEmpty());
+
+    ImageData copy = CopyToImageData(sub);
+    EXPECT_EQ(copy.GetFormat(), PixelFormat::MONO1);
+    EXPECT_EQ(copy.stride, 4);
+    EXPECT_TRUE(ImageView(copy).MaskBit(9, 1));
+}
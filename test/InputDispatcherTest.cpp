@@ -0,0 +1,245 @@
+#include <gtest/gtest.h>
+#include "../DataLayer/include/InputDispatcher.h"
+
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace InputDispatcher;
+
+namespace {
+
+struct Record {
+    WindowHandle window;
+    InputEvent event;
+    Delivery delivery;
+};
+
+// 记录所有事件的假接收端：句柄为 nullptr 视为无效，code 为 failCode 的事件派发失败，
+// gate 非空时第一次派发前等待放行
+struct RecordingState {
+    std::mutex mutex;
+    std::vector<Record> records;
+    int batchCount = 0;
+    std::uint32_t failCode = 0xFFFFFFFF;
+    std::shared_future<void> gate;
+};
+
+class RecordingSink : public InputSink {
+public:
+    explicit RecordingSink(std::shared_ptr<RecordingState> state) : m_state(std::move(state)) {}
+
+    Result<bool> BeginBatch(WindowHandle window) override {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        m_state->batchCount++;
+        if (!window) {
+            return Result<bool>::Error(ErrorCode::INVALID_HANDLE, L"Invalid window handle");
+        }
+        return Result<bool>::Success(true);
+    }
+
+    Result<bool> Deliver(WindowHandle window, const InputEvent& event, Delivery delivery) override {
+        if (m_state->gate.valid()) {
+            m_state->gate.wait();
+        }
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        if (event.code == m_state->failCode) {
+            return Result<bool>::Error(ErrorCode::INPUT_SIMULATION_FAILED, L"Delivery failed");
+        }
+        m_state->records.push_back({window, event, delivery});
+        return Result<bool>::Success(true);
+    }
+
+private:
+    std::shared_ptr<RecordingState> m_state;
+};
+
+WindowHandle Window(std::uintptr_t id) {
+    return reinterpret_cast<WindowHandle>(id);
+}
+
+}  // namespace
+
+TEST(InputDispatcherTest, ResolvesDeliveryPerBatch) {
+    EXPECT_TRUE(IsPostable(InputEvent::MouseMove(1, 2)));
+    EXPECT_TRUE(IsPostable(InputEvent::Wheel(1, 2, -1)));
+    EXPECT_FALSE(IsPostable(InputEvent::ButtonDown(1, 2)));
+    EXPECT_FALSE(IsPostable(InputEvent::KeyDown(0x41)));
+    EXPECT_TRUE(IsPostable(InputEvent::Char(L'a').Via(Delivery::POST)));
+    EXPECT_FALSE(IsPostable(InputEvent::MouseMove(0, 0).Via(Delivery::SEND)));
+
+    // 整批可投递时 AUTO 投递；批内有同步事件时 AUTO 一律同步发送，移动不会晚于释放
+    EXPECT_TRUE(IsPostableBatch({InputEvent::MouseMove(1, 2), InputEvent::Wheel(1, 2, 1)}));
+    EXPECT_FALSE(IsPostableBatch({InputEvent::MouseMove(1, 2), InputEvent::ButtonUp(1, 2)}));
+    EXPECT_TRUE(IsPostableBatch({}));
+    EXPECT_EQ(ResolveDelivery(InputEvent::MouseMove(1, 2), true), Delivery::POST);
+    EXPECT_EQ(ResolveDelivery(InputEvent::MouseMove(1, 2), false), Delivery::SEND);
+    EXPECT_EQ(ResolveDelivery(InputEvent::Wheel(1, 2, -1), false), Delivery::SEND);
+    EXPECT_EQ(ResolveDelivery(InputEvent::ButtonDown(1, 2), false), Delivery::SEND);
+    EXPECT_EQ(ResolveDelivery(InputEvent::Char(L'a').Via(Delivery::POST), false), Delivery::POST);
+    EXPECT_EQ(ResolveDelivery(InputEvent::MouseMove(0, 0).Via(Delivery::SEND), true), Delivery::SEND);
+}
+
+TEST(InputDispatcherTest, MovesHoldOnlyRequestedButtons) {
+    // 默认的移动为悬停，不带任何按键，目标窗口不会看到拖拽
+    EXPECT_EQ(InputEvent::MouseMove(1, 2).held, 0);
+    EXPECT_EQ(InputEvent().held, 0);
+
+    EXPECT_EQ(InputEvent::MouseMove(1, 2, MouseButton::RIGHT).held, HeldMask(MouseButton::RIGHT));
+    const std::uint8_t both = HeldMask(MouseButton::LEFT) | HeldMask(MouseButton::X2);
+    EXPECT_EQ(InputEvent::MouseMove(1, 2, both).held, both);
+    EXPECT_NE(HeldMask(MouseButton::LEFT), HeldMask(MouseButton::X1));
+
+    // 按下与释放只用 button，不影响 held
+    EXPECT_EQ(InputEvent::ButtonDown(1, 2, MouseButton::MIDDLE).held, 0);
+}
+
+TEST(InputDispatcherTest, DeliversBatchesInOrder) {
+    auto state = std::make_shared<RecordingState>();
+    Dispatcher dispatcher(std::make_unique<RecordingSink>(state));
+
+    auto first = dispatcher.Submit(Window(1), {InputEvent::MouseMove(10, 20), InputEvent::ButtonDown(10, 20),
+                                               InputEvent::ButtonUp(10, 20)});
+    auto second = dispatcher.Submit(Window(2), {InputEvent::KeyDown(0x41), InputEvent::Char(L'a'),
+                                                InputEvent::KeyUp(0x41), InputEvent::Wheel(3, 4, 2)});
+    auto empty = dispatcher.Submit(Window(1), {});
+    auto moves = dispatcher.Submit(Window(1), {InputEvent::MouseMove(5, 6), InputEvent::Wheel(5, 6, -1)});
+    ASSERT_EQ(first.get().GetData(), 3);
+    ASSERT_EQ(second.get().GetData(), 4);
+    EXPECT_EQ(empty.get().GetData(), 0);
+    EXPECT_EQ(moves.get().GetData(), 2);
+
+    std::lock_guard<std::mutex> lock(state->mutex);
+    ASSERT_EQ(state->records.size(), 9u);
+    const EventType expected[] = {EventType::MOUSE_MOVE, EventType::BUTTON_DOWN, EventType::BUTTON_UP,
+                                  EventType::KEY_DOWN, EventType::CHAR, EventType::KEY_UP, EventType::WHEEL,
+                                  EventType::MOUSE_MOVE, EventType::WHEEL};
+    for (size_t i = 0; i < 9; i++) {
+        EXPECT_EQ(state->records[i].event.type, expected[i]) << "index " << i;
+        EXPECT_EQ(state->records[i].window, Window(i < 3 || i >= 7 ? 1 : 2));
+        // 与点击、按键同批的移动和滚轮同步发送；只含移动与滚轮的批次投递
+        EXPECT_EQ(state->records[i].delivery, i < 7 ? Delivery::SEND : Delivery::POST) << "index " << i;
+    }
+    EXPECT_EQ(state->batchCount, 4);
+
+    auto statistics = dispatcher.GetStatistics();
+    EXPECT_EQ(statistics.batchCount, 4u);
+    EXPECT_EQ(statistics.postedCount, 2u);
+    EXPECT_EQ(statistics.sentCount, 7u);
+    EXPECT_EQ(statistics.failedBatchCount, 0u);
+}
+
+TEST(InputDispatcherTest, ValidatesHandleOncePerBatchAndStopsOnFailure) {
+    auto state = std::make_shared<RecordingState>();
+    state->failCode = 0x99;
+    Dispatcher dispatcher(std::make_unique<RecordingSink>(state));
+
+    std::vector<InputEvent> keys;
+    for (int i = 0; i < 50; i++) {
+        keys.push_back(InputEvent::KeyDown(0x41 + i % 20));
+    }
+    auto invalid = dispatcher.Submit(nullptr, keys).get();
+    EXPECT_EQ(invalid.GetErrorCode(), ErrorCode::INVALID_HANDLE);
+
+    auto valid = dispatcher.Submit(Window(7), keys).get();
+    EXPECT_EQ(valid.GetData(), 50);
+
+    auto failing = dispatcher.Submit(Window(7), {InputEvent::KeyDown(0x41), InputEvent::KeyDown(0x99),
+                                                 InputEvent::KeyDown(0x42)}).get();
+    EXPECT_EQ(failing.GetErrorCode(), ErrorCode::INPUT_SIMULATION_FAILED);
+
+    std::lock_guard<std::mutex> lock(state->mutex);
+    EXPECT_EQ(state->batchCount, 3);
+    // 无效句柄的批次不派发，失败事件之后的事件不派发
+    ASSERT_EQ(state->records.size(), 51u);
+    EXPECT_EQ(state->records.back().event.code, 0x41u);
+    EXPECT_EQ(dispatcher.GetStatistics().failedBatchCount, 2u);
+}
+
+TEST(InputDispatcherTest, DeliverBatchRunsOnCallerThread) {
+    // 与派发线程相同的规则：每批一次 BeginBatch、按整批解析、失败即停
+    auto state = std::make_shared<RecordingState>();
+    state->failCode = 0x99;
+    RecordingSink sink(state);
+
+    auto delivered = DeliverBatch(sink, Window(4), {InputEvent::MouseMove(1, 1), InputEvent::ButtonDown(1, 1)});
+    ASSERT_TRUE(delivered.IsSuccess());
+    EXPECT_EQ(delivered.GetData(), 2);
+    auto single = DeliverBatch(sink, Window(4), {InputEvent::MouseMove(2, 2).Via(Delivery::SEND)});
+    EXPECT_EQ(single.GetData(), 1);
+    EXPECT_EQ(DeliverBatch(sink, nullptr, {InputEvent::KeyDown(0x41)}).GetErrorCode(), ErrorCode::INVALID_HANDLE);
+    auto failed = DeliverBatch(sink, Window(4), {InputEvent::KeyDown(0x41), InputEvent::KeyDown(0x99),
+                                                 InputEvent::KeyUp(0x41)});
+    EXPECT_EQ(failed.GetErrorCode(), ErrorCode::INPUT_SIMULATION_FAILED);
+
+    std::lock_guard<std::mutex> lock(state->mutex);
+    EXPECT_EQ(state->batchCount, 4);
+    ASSERT_EQ(state->records.size(), 4u);
+    EXPECT_EQ(state->records[0].delivery, Delivery::SEND);
+    EXPECT_EQ(state->records[1].event.type, EventType::BUTTON_DOWN);
+    EXPECT_EQ(state->records[2].delivery, Delivery::SEND);
+    EXPECT_EQ(state->records[3].event.code, 0x41u);
+}
+
+TEST(InputDispatcherTest, SubmitDoesNotWaitForTheTarget) {
+    auto state = std::make_shared<RecordingState>();
+    std::promise<void> release;
+    state->gate = release.get_future().share();
+    Dispatcher dispatcher(std::make_unique<RecordingSink>(state));
+
+    // 接收端被阻塞时提交仍立即返回
+    std::vector<std::future<Result<int>>> futures;
+    for (int i = 0; i < 100; i++) {
+        futures.push_back(dispatcher.Submit(Window(1), {InputEvent::Char(static_cast<wchar_t>(L'a' + i % 26))}));
+    }
+    EXPECT_EQ(futures.front().wait_for(std::chrono::milliseconds(20)), std::future_status::timeout);
+
+    release.set_value();
+    dispatcher.WaitIdle();
+    for (auto& future : futures) {
+        EXPECT_EQ(future.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+        EXPECT_EQ(future.get().GetData(), 1);
+    }
+    EXPECT_EQ(dispatcher.GetStatistics().batchCount, 100u);
+}
+
+TEST(InputDispatcherTest, ConcurrentProducersKeepPerThreadOrder) {
+    auto state = std::make_shared<RecordingState>();
+    const int producers = 4;
+    const int batchesPerProducer = 500;
+    {
+        Dispatcher dispatcher(std::make_unique<RecordingSink>(state));
+        std::vector<std::thread> threads;
+        for (int p = 0; p < producers; p++) {
+            threads.emplace_back([&dispatcher, p]() {
+                for (int b = 0; b < batchesPerProducer; b++) {
+                    // 事件的 x 为批次序号，y 为批内序号
+                    dispatcher.Submit(Window(p + 1), {InputEvent::MouseMove(b, 0), InputEvent::MouseMove(b, 1)});
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        // 析构时派发完所有已提交的批次
+    }
+
+    ASSERT_EQ(state->records.size(), static_cast<size_t>(producers * batchesPerProducer * 2));
+    std::vector<int> next(producers, 0);
+    for (size_t i = 0; i < state->records.size(); i += 2) {
+        const Record& a = state->records[i];
+        const Record& b = state->records[i + 1];
+        // 同一批的事件连续出现
+        ASSERT_EQ(a.window, b.window);
+        ASSERT_EQ(a.event.x, b.event.x);
+        ASSERT_EQ(a.event.y, 0);
+        ASSERT_EQ(b.event.y, 1);
+        const int producer = static_cast<int>(reinterpret_cast<std::uintptr_t>(a.window)) - 1;
+        EXPECT_EQ(a.event.x, next[producer]++);
+    }
+    for (int count : next) {
+        EXPECT_EQ(count, batchesPerProducer);
+    }
+}
@@ -0,0 +1,290 @@
+#include <gtest/gtest.h>
+#include "../DataLayer/include/InputMacro.h"
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace InputMacro;
+using InputDispatcher::Delivery;
+using InputDispatcher::EventType;
+
+namespace {
+
+// 记录派发时间的假接收端：句柄为 nullptr 视为无效，code 为 0x99 的事件派发失败
+class TimingSink : public InputSink {
+public:
+    struct Record {
+        WindowHandle window;
+        InputEvent event;
+        Clock::time_point when;
+    };
+
+    Result<bool> BeginBatch(WindowHandle window) override {
+        if (!window) {
+            return Result<bool>::Error(ErrorCode::INVALID_HANDLE, L"Invalid window handle");
+        }
+        return Result<bool>::Success(true);
+    }
+
+    Result<bool> Deliver(WindowHandle window, const InputEvent& event, Delivery) override {
+        if (event.code == 0x99 && window == failingWindow) {
+            return Result<bool>::Error(ErrorCode::INPUT_SIMULATION_FAILED, L"Delivery failed");
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        records.push_back({window, event, Clock::now()});
+        if (deliverDelay.count() > 0) {
+            std::this_thread::sleep_for(deliverDelay);
+        }
+        return Result<bool>::Success(true);
+    }
+
+    std::mutex mutex;
+    std::vector<Record> records;
+    WindowHandle failingWindow = nullptr;
+    std::chrono::microseconds deliverDelay{0};  // 模拟目标窗口处理每个事件的耗时
+};
+
+WindowHandle Window(std::uintptr_t id) {
+    return reinterpret_cast<WindowHandle>(id);
+}
+
+// 录制一段示例宏：按键、字符、移动、点击与滚轮，时间以微秒给出
+std::vector<TimedEvent> SampleEvents() {
+    std::vector<TimedEvent> events;
+    auto add = [&](std::uint64_t timeUs, InputEvent event) {
+        TimedEvent timed;
+        timed.timeUs = timeUs;
+        timed.event = event;
+        events.push_back(timed);
+    };
+    add(0, InputEvent::KeyDown(0x41));
+    add(150, InputEvent::Char(L'中'));
+    add(150, InputEvent::KeyUp(0x41));
+    add(20000, InputEvent::MouseMove(500, 300));
+    add(28000, InputEvent::MouseMove(503, 298, MouseButton::RIGHT));
+    add(28000, InputEvent::MouseMove(504, 298, InputDispatcher::HeldMask(MouseButton::LEFT) | InputDispatcher::HeldMask(MouseButton::X2)));
+    add(28000, InputEvent::ButtonDown(503, 298, MouseButton::X2).Via(Delivery::POST));
+    add(5000000, InputEvent::ButtonUp(-20, 70000, MouseButton::MIDDLE));
+    add(5000001, InputEvent::Wheel(10, 10, -3));
+    return events;
+}
+
+std::vector<std::uint8_t> Serialize(const std::vector<TimedEvent>& events) {
+    Recorder recorder;
+    const Clock::time_point origin = Clock::now();
+    recorder.Start(origin);
+    for (const TimedEvent& timed : events) {
+        recorder.Record(timed.event, origin + std::chrono::microseconds(timed.timeUs));
+    }
+    return recorder.Serialize();
+}
+
+void ExpectSameEvent(const InputEvent& a, const InputEvent& b) {
+    EXPECT_EQ(a.type, b.type);
+    EXPECT_EQ(a.delivery, b.delivery);
+    EXPECT_EQ(a.code, b.code);
+    EXPECT_EQ(a.x, b.x);
+    EXPECT_EQ(a.y, b.y);
+    EXPECT_EQ(a.delta, b.delta);
+    EXPECT_EQ(a.button, b.button);
+    EXPECT_EQ(a.held, b.held);
+}
+
+}  // namespace
+
+TEST(InputMacroTest, RoundTripsEventsCompactly) {
+    const std::vector<TimedEvent> events = SampleEvents();
+    const std::vector<std::uint8_t> bytes = Serialize(events);
+
+    auto view = MacroView::Open(bytes.data(), bytes.size());
+    ASSERT_TRUE(view.IsSuccess());
+    EXPECT_EQ(view.GetData().GetEventCount(), events.size());
+    EXPECT_EQ(view.GetData().GetPayloadSize(), bytes.size() - kHeaderSize);
+    EXPECT_TRUE(view.GetData().Validate().IsSuccess());
+
+    auto decoded = view.GetData().Decode();
+    ASSERT_TRUE(decoded.IsSuccess());
+    ASSERT_EQ(decoded.GetData().size(), events.size());
+    for (size_t i = 0; i < events.size(); i++) {
+        EXPECT_EQ(decoded.GetData()[i].timeUs, events[i].timeUs) << "index " << i;
+        ExpectSameEvent(decoded.GetData()[i].event, events[i].event);
+    }
+
+    // 小幅鼠标移动：标签 + 间隔 + 两个差值，各 1 字节
+    Recorder recorder;
+    const Clock::time_point origin = Clock::now();
+    recorder.Start(origin);
+    for (int i = 0; i < 1000; i++) {
+        recorder.Record(InputEvent::MouseMove(100 + i % 50, 200 - i % 30), origin + std::chrono::microseconds(i * 100));
+    }
+    EXPECT_EQ(recorder.GetEventCount(), 1000u);
+    EXPECT_LE(recorder.Serialize().size(), kHeaderSize + 1000 * 5);
+
+    // 早于上一事件的时间按上一事件计
+    recorder.Start(origin);
+    recorder.Record(InputEvent::KeyDown(1), origin + std::chrono::milliseconds(5));
+    recorder.Record(InputEvent::KeyDown(2), origin + std::chrono::milliseconds(3));
+    const std::vector<std::uint8_t> clamped = recorder.Serialize();
+    auto times = MacroView::Open(clamped.data(), clamped.size()).GetData().Decode().TakeData();
+    EXPECT_EQ(times[1].timeUs, 5000u);
+}
+
+TEST(InputMacroTest, RejectsCorruptData) {
+    std::vector<std::uint8_t> bytes = Serialize(SampleEvents());
+
+    EXPECT_TRUE(MacroView::Open(nullptr, 0).IsError());
+    EXPECT_TRUE(MacroView::Open(bytes.data(), kHeaderSize - 1).IsError());
+    EXPECT_TRUE(MacroView::Open(bytes.data(), bytes.size() - 1).IsError());
+
+    std::vector<std::uint8_t> badMagic = bytes;
+    badMagic[0] ^= 0xFF;
+    EXPECT_EQ(MacroView::Open(badMagic.data(), badMagic.size()).GetErrorCode(), ErrorCode::INVALID_PARAMETER);
+    std::vector<std::uint8_t> badVersion = bytes;
+    badVersion[4] = 9;
+    EXPECT_TRUE(MacroView::Open(badVersion.data(), badVersion.size()).IsError());
+
+    // 事件数比负载多：打开成功（只检查文件头），校验与回放失败
+    std::vector<std::uint8_t> extraCount = bytes;
+    extraCount[8]++;
+    auto view = MacroView::Open(extraCount.data(), extraCount.size());
+    ASSERT_TRUE(view.IsSuccess());
+    EXPECT_TRUE(view.GetData().Validate().IsError());
+    EXPECT_TRUE(view.GetData().Decode().IsError());
+    TimingSink sink;
+    EXPECT_EQ(Replay(view.GetData(), sink, {Window(1)}).GetErrorCode(), ErrorCode::INVALID_PARAMETER);
+    EXPECT_TRUE(sink.records.empty());
+
+    // 无效的事件类型
+    std::vector<std::uint8_t> badTag = bytes;
+    badTag[kHeaderSize] = 0x07;
+    EXPECT_TRUE(MacroView::Open(badTag.data(), badTag.size()).GetData().Validate().IsError());
+}
+
+TEST(InputMacroTest, MapsSavedFiles) {
+    const std::vector<TimedEvent> events = SampleEvents();
+    Recorder recorder;
+    const Clock::time_point origin = Clock::now();
+    recorder.Start(origin);
+    for (const TimedEvent& timed : events) {
+        recorder.Record(timed.event, origin + std::chrono::microseconds(timed.timeUs));
+    }
+
+    const std::string path = ::testing::TempDir() + "InputMacroTest.macro";
+    ASSERT_TRUE(recorder.SaveToFile(path).IsSuccess());
+    {
+        auto mapped = MappedMacro::Open(path);
+        ASSERT_TRUE(mapped.IsSuccess());
+        const MacroView& view = mapped.GetData()->GetView();
+        EXPECT_EQ(view.GetEventCount(), events.size());
+        auto decoded = view.Decode();
+        ASSERT_TRUE(decoded.IsSuccess());
+        for (size_t i = 0; i < events.size(); i++) {
+            EXPECT_EQ(decoded.GetData()[i].timeUs, events[i].timeUs);
+            ExpectSameEvent(decoded.GetData()[i].event, events[i].event);
+        }
+    }
+    std::remove(path.c_str());
+
+    EXPECT_EQ(MappedMacro::Open(path).GetErrorCode(), ErrorCode::OPERATION_FAILED);
+    EXPECT_TRUE(recorder.SaveToFile(::testing::TempDir() + "missing-dir/x/y.macro").IsError());
+}
+
+TEST(InputMacroTest, RecordingSinkCapturesDeliveredEvents) {
+    Recorder recorder;
+    auto inner = std::make_unique<TimingSink>();
+    inner->failingWindow = Window(1);
+    InputDispatcher::Dispatcher dispatcher(CreateRecordingSink(std::move(inner), recorder));
+
+    dispatcher.Submit(Window(1), {InputEvent::KeyDown(0x41), InputEvent::MouseMove(7, 8), InputEvent::KeyDown(0x99),
+                                  InputEvent::KeyDown(0x42)});
+    dispatcher.Submit(nullptr, {InputEvent::KeyDown(0x43)});
+    dispatcher.Submit(Window(2), {InputEvent::Wheel(1, 2, 3)});
+    dispatcher.WaitIdle();
+
+    // 失败的事件与之后的事件、无效句柄的批次都不记录
+    const std::vector<std::uint8_t> bytes = recorder.Serialize();
+    auto decoded = MacroView::Open(bytes.data(), bytes.size()).GetData().Decode();
+    ASSERT_TRUE(decoded.IsSuccess());
+    ASSERT_EQ(decoded.GetData().size(), 3u);
+    EXPECT_EQ(decoded.GetData()[0].event.code, 0x41u);
+    EXPECT_EQ(decoded.GetData()[1].event.type, EventType::MOUSE_MOVE);
+    EXPECT_EQ(decoded.GetData()[1].event.x, 7);
+    EXPECT_EQ(decoded.GetData()[2].event.type, EventType::WHEEL);
+    EXPECT_EQ(decoded.GetData()[2].event.delta, 3);
+    EXPECT_LE(decoded.GetData()[0].timeUs, decoded.GetData()[2].timeUs);
+}
+
+TEST(InputMacroTest, ReplaysOnScheduleToAllWindows) {
+    // 20 个事件，间隔 2 毫秒；第 10 个事件在窗口 3 上派发失败
+    std::vector<TimedEvent> events;
+    for (int i = 0; i < 20; i++) {
+        TimedEvent timed;
+        timed.timeUs = static_cast<std::uint64_t>(i) * 2000;
+        timed.event = i == 10 ? InputEvent::KeyDown(0x99) : InputEvent::MouseMove(i, i * 2);
+        events.push_back(timed);
+    }
+    const std::vector<std::uint8_t> bytes = Serialize(events);
+    const MacroView view = MacroView::Open(bytes.data(), bytes.size()).TakeData();
+
+    TimingSink sink;
+    sink.failingWindow = Window(3);
+    const Clock::time_point start = Clock::now();
+    auto replayed = Replay(view, sink, {Window(1), nullptr, Window(3)});
+    ASSERT_TRUE(replayed.IsSuccess());
+    const ReplayReport& report = replayed.GetData();
+    EXPECT_EQ(report.eventCount, 20u);
+    EXPECT_EQ(report.deliveredCount, 20u + 10u);
+    EXPECT_EQ(report.failedWindowCount, 2u);
+    EXPECT_GE(report.durationUs, 38000.0);
+    EXPECT_GE(report.jitterP50Us, 0.0);
+    EXPECT_LE(report.jitterP50Us, report.jitterP90Us);
+    EXPECT_LE(report.jitterP99Us, report.jitterMaxUs);
+
+    // 窗口 1 按顺序收到全部事件，且没有早于计划时间
+    size_t next = 0;
+    for (const TimingSink::Record& record : sink.records) {
+        if (record.window != Window(1)) {
+            continue;
+        }
+        ASSERT_LT(next, events.size());
+        ExpectSameEvent(record.event, events[next].event);
+        EXPECT_GE(record.when - start, std::chrono::microseconds(events[next].timeUs));
+        next++;
+    }
+    EXPECT_EQ(next, events.size());
+
+    // 两倍速
+    ReplayOptions fast;
+    fast.speed = 2.0;
+    TimingSink fastSink;
+    auto fastReplay = Replay(view, fastSink, {Window(1)}, fast);
+    ASSERT_TRUE(fastReplay.IsSuccess());
+    EXPECT_GE(fastReplay.GetData().durationUs, 19000.0);
+    EXPECT_EQ(fastReplay.GetData().deliveredCount, 20u);
+
+    // 接收端每次派发耗时 3 毫秒：第二个窗口的延迟计入报告
+    TimingSink slowSink;
+    slowSink.deliverDelay = std::chrono::microseconds(3000);
+    std::vector<TimedEvent> sparse(5);
+    for (size_t i = 0; i < sparse.size(); i++) {
+        sparse[i].timeUs = i * 10000;
+        sparse[i].event = InputEvent::MouseMove(static_cast<int>(i), 0);
+    }
+    const std::vector<std::uint8_t> sparseBytes = Serialize(sparse);
+    const MacroView sparseView = MacroView::Open(sparseBytes.data(), sparseBytes.size()).TakeData();
+    auto slowReplay = Replay(sparseView, slowSink, {Window(1), Window(2)});
+    ASSERT_TRUE(slowReplay.IsSuccess());
+    EXPECT_EQ(slowReplay.GetData().deliveredCount, 10u);
+    EXPECT_GE(slowReplay.GetData().jitterMaxUs, 3000.0);
+    EXPECT_GE(slowReplay.GetData().jitterP90Us, 3000.0);
+
+    ReplayOptions invalid;
+    invalid.speed = 0.0;
+    EXPECT_EQ(Replay(view, sink, {Window(1)}, invalid).GetErrorCode(), ErrorCode::INVALID_PARAMETER);
+    EXPECT_EQ(Replay(view, sink, {}).GetErrorCode(), ErrorCode::INVALID_PARAMETER);
+}
@@ -0,0 +1,290 @@
+#include <gtest/gtest.h>
+#include "../DataLayer/include/MousePath.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+using namespace MousePath;
+using InputDispatcher::Delivery;
+using InputDispatcher::EventType;
+
+namespace {
+
+// 点到直线 start-end 的有向距离
+double Deviation(const PathPoint& point, const Point& start, const Point& end) {
+    const double dx = end.x - start.x;
+    const double dy = end.y - start.y;
+    return ((point.x - start.x) * dy - (point.y - start.y) * dx) / std::hypot(dx, dy);
+}
+
+using Clock = std::chrono::steady_clock;
+
+// 记录每个事件派发时刻的假接收端；句柄为 nullptr 视为无效
+class TimingSink : public InputDispatcher::InputSink {
+public:
+    struct Record {
+        InputEvent event;
+        Delivery delivery;
+        Clock::time_point when;
+    };
+
+    Result<bool> BeginBatch(InputDispatcher::WindowHandle window) override {
+        batchCount++;
+        if (!window) {
+            return Result<bool>::Error(ErrorCode::INVALID_HANDLE, L"Invalid window handle");
+        }
+        return Result<bool>::Success(true);
+    }
+
+    Result<bool> Deliver(InputDispatcher::WindowHandle, const InputEvent& event, Delivery delivery) override {
+        records.push_back({event, delivery, Clock::now()});
+        return Result<bool>::Success(true);
+    }
+
+    int batchCount = 0;
+    std::vector<Record> records;
+};
+
+double ElapsedMs(Clock::time_point from, Clock::time_point to) {
+    return std::chrono::duration<double, std::milli>(to - from).count();
+}
+
+}  // namespace
+
+TEST(MousePathTest, MinimumJerkAcceleratesThenDecelerates) {
+    Path path;
+    PathOptions options;
+    options.speed = 1200.0;
+    options.sampleIntervalMs = 8.0;
+    auto generated = path.Generate(Point(100, 50), Point(700, 50), options);
+    ASSERT_TRUE(generated.IsSuccess());
+
+    // 600 像素 / 1200 像素每秒 = 500 毫秒，最多 64 个采样点（起止处取整后重复的点被跳过）
+    const std::vector<PathPoint>& points = path.GetPoints();
+    EXPECT_EQ(generated.GetData(), points.size());
+    EXPECT_LE(points.size(), 64u);
+    EXPECT_GE(points.size(), 50u);
+    EXPECT_DOUBLE_EQ(path.GetDurationMs(), 500.0);
+    EXPECT_EQ(points.front().x, 100);
+    EXPECT_DOUBLE_EQ(points.front().timeMs, 0.0);
+    EXPECT_EQ(points.back().x, 700);
+
+    int maxStep = 0;
+    size_t maxStepIndex = 0;
+    for (size_t i = 1; i < points.size(); i++) {
+        EXPECT_EQ(points[i].y, 50);
+        EXPECT_GT(points[i].x, points[i - 1].x) << "index " << i;
+        EXPECT_GT(points[i].timeMs, points[i - 1].timeMs);
+        if (points[i].x - points[i - 1].x > maxStep) {
+            maxStep = points[i].x - points[i - 1].x;
+            maxStepIndex = i;
+        }
+    }
+    // 起止处步长小，中段步长最大（峰值速度为平均速度的 1.875 倍）
+    EXPECT_LE(points[1].x - points[0].x, 3);
+    EXPECT_LE(points.back().x - points[points.size() - 2].x, 3);
+    EXPECT_GE(maxStep, 17);
+    EXPECT_GT(maxStepIndex, points.size() / 3);
+    EXPECT_LT(maxStepIndex, points.size() * 2 / 3);
+}
+
+TEST(MousePathTest, BezierArcsToOneSideDeterministically) {
+    const Point start(0, 0);
+    const Point end(400, 300);
+    PathOptions options;
+    options.curve = Curve::BEZIER;
+    options.curvature = 0.2;
+    options.seed = 42;
+
+    Path first;
+    Path second;
+    ASSERT_TRUE(first.Generate(start, end, options).IsSuccess());
+    ASSERT_TRUE(second.Generate(start, end, options).IsSuccess());
+    ASSERT_EQ(first.GetPointCount(), second.GetPointCount());
+    for (size_t i = 0; i < first.GetPointCount(); i++) {
+        EXPECT_EQ(first.GetPoints()[i].x, second.GetPoints()[i].x);
+        EXPECT_EQ(first.GetPoints()[i].y, second.GetPoints()[i].y);
+    }
+
+    EXPECT_EQ(first.GetPoints().front().x, 0);
+    EXPECT_EQ(first.GetPoints().back().x, 400);
+    EXPECT_EQ(first.GetPoints().back().y, 300);
+
+    // 所有点在直线同一侧，最大偏离不超过 curvature × 距离
+    double maxDeviation = 0.0;
+    double minDeviation = 0.0;
+    for (const PathPoint& point : first.GetPoints()) {
+        const double deviation = Deviation(point, start, end);
+        maxDeviation = std::max(maxDeviation, deviation);
+        minDeviation = std::min(minDeviation, deviation);
+    }
+    EXPECT_TRUE(maxDeviation < 1.0 || minDeviation > -1.0);
+    EXPECT_GT(std::max(maxDeviation, -minDeviation), 10.0);
+    EXPECT_LE(std::max(maxDeviation, -minDeviation), 0.2 * 500.0 + 1.0);
+
+    // 不弯曲时为直线
+    options.curvature = 0.0;
+    ASSERT_TRUE(first.Generate(start, end, options).IsSuccess());
+    for (const PathPoint& point : first.GetPoints()) {
+        EXPECT_LE(std::abs(Deviation(point, start, end)), 1.0);
+    }
+}
+
+TEST(MousePathTest, JitterStaysWithinAmplitude) {
+    PathOptions options;
+    options.jitter = 3.0;
+    options.seed = 7;
+    Path path;
+    ASSERT_TRUE(path.Generate(Point(0, 100), Point(900, 100), options).IsSuccess());
+
+    int offAxis = 0;
+    for (const PathPoint& point : path.GetPoints()) {
+        EXPECT_LE(std::abs(point.y - 100), 3);
+        offAxis += point.y != 100;
+    }
+    EXPECT_GT(offAxis, 0);
+    EXPECT_EQ(path.GetPoints().front().y, 100);
+    EXPECT_EQ(path.GetPoints().back().y, 100);
+    EXPECT_EQ(path.GetPoints().back().x, 900);
+}
+
+TEST(MousePathTest, ReusesBufferAndValidatesOptions) {
+    Path path(256);
+    PathOptions options;
+    options.pointCount = 200;
+    ASSERT_TRUE(path.Generate(Point(0, 0), Point(1000, 800), options).IsSuccess());
+    EXPECT_GT(path.GetPointCount(), 150u);
+    EXPECT_LE(path.GetPointCount(), 200u);
+    const PathPoint* buffer = path.GetPoints().data();
+
+    // 再次生成复用同一块内存
+    options.curve = Curve::BEZIER;
+    options.jitter = 2.0;
+    ASSERT_TRUE(path.Generate(Point(900, 20), Point(-300, 600), options).IsSuccess());
+    EXPECT_GT(path.GetPointCount(), 150u);
+    EXPECT_EQ(path.GetPoints().data(), buffer);
+    const size_t generated = path.GetPointCount();
+
+    // 选项无效时缓冲区不变
+    PathOptions invalid;
+    invalid.speed = 0.0;
+    EXPECT_EQ(path.Generate(Point(0, 0), Point(1, 1), invalid).GetErrorCode(), ErrorCode::INVALID_PARAMETER);
+    invalid = PathOptions();
+    invalid.pointCount = 1;
+    EXPECT_TRUE(path.Generate(Point(0, 0), Point(1, 1), invalid).IsError());
+    invalid = PathOptions();
+    invalid.sampleIntervalMs = 0.0001;
+    EXPECT_TRUE(path.Generate(Point(0, 0), Point(1, 1), invalid).IsError());
+    EXPECT_EQ(path.GetPointCount(), generated);
+
+    // 短距离按时长下限；重复的整数坐标被跳过
+    ASSERT_TRUE(path.Generate(Point(10, 10), Point(13, 10), PathOptions()).IsSuccess());
+    EXPECT_DOUBLE_EQ(path.GetDurationMs(), 60.0);
+    EXPECT_LE(path.GetPointCount(), 4u);
+    EXPECT_EQ(path.GetPoints().back().x, 13);
+
+    ASSERT_TRUE(path.Generate(Point(5, 5), Point(5, 5), PathOptions()).IsSuccess());
+    EXPECT_EQ(path.GetPointCount(), 1u);
+}
+
+TEST(MousePathTest, DragKeepsButtonHeldThroughout) {
+    Path path;
+    ASSERT_TRUE(path.Generate(Point(10, 20), Point(310, 220)).IsSuccess());
+    const size_t count = path.GetPointCount();
+
+    std::vector<InputEvent> events;
+    AppendDrag(path, MouseButton::RIGHT, events);
+    ASSERT_EQ(events.size(), count + 1);
+    EXPECT_EQ(events.front().type, EventType::BUTTON_DOWN);
+    EXPECT_EQ(events.front().x, 10);
+    EXPECT_EQ(events.front().y, 20);
+    EXPECT_EQ(events.back().type, EventType::BUTTON_UP);
+    EXPECT_EQ(events.back().x, 310);
+    EXPECT_EQ(events.back().y, 220);
+    for (size_t i = 1; i + 1 < events.size(); i++) {
+        EXPECT_EQ(events[i].type, EventType::MOUSE_MOVE);
+        EXPECT_EQ(events[i].held, InputDispatcher::HeldMask(MouseButton::RIGHT));
+        // 移动显式同步发送，即使与按下、释放分批提交也不会晚于释放被处理
+        EXPECT_EQ(InputDispatcher::ResolveDelivery(events[i], true), Delivery::SEND);
+    }
+    EXPECT_EQ(events.front().button, MouseButton::RIGHT);
+    EXPECT_EQ(events.back().button, MouseButton::RIGHT);
+
+    // 不指定按键的移动为悬停
+    std::vector<InputEvent> moves;
+    AppendMove(path, moves);
+    ASSERT_EQ(moves.size(), count);
+    for (const InputEvent& move : moves) {
+        EXPECT_EQ(move.held, 0);
+    }
+    EXPECT_TRUE(InputDispatcher::IsPostableBatch(moves));
+
+    std::vector<InputEvent> held;
+    AppendMove(path, MouseButton::LEFT, held);
+    ASSERT_EQ(held.size(), count);
+    EXPECT_EQ(held.front().held, InputDispatcher::HeldMask(MouseButton::LEFT));
+    EXPECT_FALSE(InputDispatcher::IsPostableBatch(events));
+    EXPECT_EQ(moves.back().x, 310);
+
+    // 空轨迹不追加事件
+    std::vector<InputEvent> none;
+    AppendDrag(Path(), MouseButton::LEFT, none);
+    EXPECT_TRUE(none.empty());
+}
+
+TEST(MousePathTest, PlaysEventsOnPathSchedule) {
+    // 300 像素 / 1200 像素每秒 = 250 毫秒，每 8 毫秒一个点
+    Path path;
+    PathOptions options;
+    options.curve = Curve::BEZIER;
+    ASSERT_TRUE(path.Generate(Point(0, 0), Point(300, 0), options).IsSuccess());
+    const std::vector<PathPoint>& points = path.GetPoints();
+    auto* window = reinterpret_cast<InputDispatcher::WindowHandle>(1);
+
+    TimingSink sink;
+    const Clock::time_point start = Clock::now();
+    auto played = PlayMove(sink, window, path);
+    const double elapsedMs = ElapsedMs(start, Clock::now());
+    ASSERT_TRUE(played.IsSuccess());
+    ASSERT_EQ(static_cast<size_t>(played.GetData()), points.size());
+    ASSERT_EQ(sink.records.size(), points.size());
+    EXPECT_EQ(sink.batchCount, 1);
+    EXPECT_GE(elapsedMs, path.GetDurationMs() - 1.0);
+
+    // 每个点不早于计划时刻；相邻事件的间隔跟随轨迹时间，而不是一次性发完
+    int paced = 0;
+    for (size_t i = 0; i < points.size(); i++) {
+        EXPECT_GE(ElapsedMs(start, sink.records[i].when), points[i].timeMs) << "index " << i;
+        EXPECT_EQ(sink.records[i].event.x, points[i].x);
+        EXPECT_EQ(sink.records[i].delivery, Delivery::POST);
+        EXPECT_EQ(sink.records[i].event.held, 0);
+        if (i > 0) {
+            const double gap = ElapsedMs(sink.records[i - 1].when, sink.records[i].when);
+            const double planned = points[i].timeMs - points[i - 1].timeMs;
+            paced += gap >= planned * 0.5 ? 1 : 0;
+        }
+    }
+    EXPECT_GE(paced, static_cast<int>(points.size()) * 3 / 4);
+
+    // 拖拽：按下在起点时刻，释放与最后一次移动同时，全部同步发送
+    TimingSink dragSink;
+    const Clock::time_point dragStart = Clock::now();
+    auto dragged = PlayDrag(dragSink, window, path, MouseButton::RIGHT);
+    ASSERT_TRUE(dragged.IsSuccess());
+    ASSERT_EQ(dragSink.records.size(), points.size() + 1);
+    EXPECT_EQ(dragSink.records.front().event.type, EventType::BUTTON_DOWN);
+    EXPECT_EQ(dragSink.records.back().event.type, EventType::BUTTON_UP);
+    EXPECT_GE(ElapsedMs(dragStart, dragSink.records.back().when), path.GetDurationMs());
+    for (const TimingSink::Record& record : dragSink.records) {
+        EXPECT_EQ(record.delivery, Delivery::SEND);
+    }
+
+    // 句柄无效时不派发
+    TimingSink rejected;
+    EXPECT_EQ(PlayMove(rejected, nullptr, path).GetErrorCode(), ErrorCode::INVALID_HANDLE);
+    EXPECT_TRUE(rejected.records.empty());
+    EXPECT_EQ(PlayMove(rejected, window, path, -1).GetErrorCode(), ErrorCode::INVALID_PARAMETER);
+}
@@ -0,0 +1,238 @@
+#include <gtest/gtest.h>
+#include "../DataLayer/include/PixelConvert.h"
+#include "TestUtils.h"
+
+#include <random>
+#include <vector>
+
+using namespace PixelConvert;
+using TestUtils::ForEachSimdLevel;
+
+namespace {
+
+// 随机 BGRA 图像，行尾带填充以覆盖 stride != width * 4 的情况
+struct PaddedImage {
+    int width;
+    int height;
+    int stride;
+    std::vector<std::uint8_t> pixels;
+
+    PaddedImage(int w, int h, int bytesPerPixel, unsigned seed)
+        : width(w), height(h), stride(w * bytesPerPixel + 12), pixels(static_cast<size_t>(stride) * h) {
+        std::mt19937 rng(seed);
+        for (auto& p : pixels) {
+            p = static_cast<std::uint8_t>(rng());
+        }
+    }
+
+    ImageView View(PixelFormat format) const { return ImageView(pixels.data(), width, height, stride, format); }
+};
+
+int ExpectedGray(const std::uint8_t* p) {
+    return (29 * p[0] + 150 * p[1] + 77 * p[2] + 128) >> 8;
+}
+
+int ExpectedPremultiplied(int c, int a) {
+    return (c * a + 127) / 255;
+}
+
+}  // namespace
+
+TEST(PixelConvertTest, ReportsSupportedConversions) {
+    EXPECT_TRUE(IsSupported(PixelFormat::BGRA32, PixelFormat::RGB24));
+    EXPECT_TRUE(IsSupported(PixelFormat::BGRA32, PixelFormat::RGBA32));
+    EXPECT_TRUE(IsSupported(PixelFormat::RGBA32, PixelFormat::BGRA32));
+    EXPECT_TRUE(IsSupported(PixelFormat::BGRA32, PixelFormat::GRAY8));
+    EXPECT_TRUE(IsSupported(PixelFormat::GRAY8, PixelFormat::BGRA32));
+    EXPECT_TRUE(IsSupported(PixelFormat::GRAY8, PixelFormat::GRAY8));
+    EXPECT_TRUE(IsSupported(PixelFormat::BGRA32, PixelFormat::RGB565));
+    EXPECT_TRUE(IsSupported(PixelFormat::RGB565, PixelFormat::BGRA32));
+    EXPECT_TRUE(IsSupported(PixelFormat::BGRA32, PixelFormat::MONO1));
+    EXPECT_TRUE(IsSupported(PixelFormat::GRAY8, PixelFormat::MONO1));
+    EXPECT_TRUE(IsSupported(PixelFormat::MONO1, PixelFormat::GRAY8));
+    EXPECT_FALSE(IsSupported(PixelFormat::RGB565, PixelFormat::MONO1));
+    EXPECT_FALSE(IsSupported(PixelFormat::RGB24, PixelFormat::GRAY8));
+    EXPECT_FALSE(IsSupported(PixelFormat::UNKNOWN, PixelFormat::UNKNOWN));
+}
+
+TEST(PixelConvertTest, BgraToRgbAndRgba) {
+    PaddedImage source(61, 7, 4, 1);
+    ForEachSimdLevel([&]() {
+        auto rgb = Convert(source.View(PixelFormat::BGRA32), PixelFormat::RGB24);
+        auto rgba = Convert(source.View(PixelFormat::BGRA32), PixelFormat::RGBA32);
+        ASSERT_TRUE(rgb.IsSuccess());
+        ASSERT_TRUE(rgba.IsSuccess());
+        EXPECT_EQ(rgb.GetData().stride, GetAlignedStride(61, PixelFormat::RGB24));
+        EXPECT_EQ(rgb.GetData().bitsPerPixel, 24);
+        for (int y = 0; y < source.height; y++) {
+            for (int x = 0; x < source.width; x++) {
+                const std::uint8_t* s = &source.pixels[static_cast<size_t>(y) * source.stride + x * 4];
+                const std::uint8_t* d3 = &rgb.GetData().data[static_cast<size_t>(y) * rgb.GetData().stride + x * 3];
+                const std::uint8_t* d4 = &rgba.GetData().data[static_cast<size_t>(y) * 61 * 4 + x * 4];
+                ASSERT_EQ(d3[0], s[2]);
+                ASSERT_EQ(d3[1], s[1]);
+                ASSERT_EQ(d3[2], s[0]);
+                ASSERT_EQ(d4[0], s[2]);
+                ASSERT_EQ(d4[1], s[1]);
+                ASSERT_EQ(d4[2], s[0]);
+                ASSERT_EQ(d4[3], s[3]);
+            }
+        }
+    });
+}
+
+TEST(PixelConvertTest, BgraToGrayMatchesWeights) {
+    PaddedImage source(77, 5, 4, 2);
+    ForEachSimdLevel([&]() {
+        auto gray = Convert(source.View(PixelFormat::BGRA32), PixelFormat::GRAY8);
+        ASSERT_TRUE(gray.IsSuccess());
+        for (int y = 0; y < source.height; y++) {
+            for (int x = 0; x < source.width; x++) {
+                const std::uint8_t* s = &source.pixels[static_cast<size_t>(y) * source.stride + x * 4];
+                ASSERT_EQ(gray.GetData().data[static_cast<size_t>(y) * gray.GetData().stride + x], ExpectedGray(s))
+                    << x << "," << y;
+            }
+        }
+    });
+}
+
+TEST(PixelConvertTest, GrayToBgraExpandsChannels) {
+    PaddedImage source(45, 3, 1, 3);
+    ForEachSimdLevel([&]() {
+        auto bgra = Convert(source.View(PixelFormat::GRAY8), PixelFormat::BGRA32);
+        ASSERT_TRUE(bgra.IsSuccess());
+        for (int y = 0; y < source.height; y++) {
+            for (int x = 0; x < source.width; x++) {
+                std::uint8_t v = source.pixels[static_cast<size_t>(y) * source.stride + x];
+                const std::uint8_t* d = &bgra.GetData().data[(static_cast<size_t>(y) * 45 + x) * 4];
+                ASSERT_EQ(d[0], v);
+                ASSERT_EQ(d[1], v);
+                ASSERT_EQ(d[2], v);
+                ASSERT_EQ(d[3], 255);
+            }
+        }
+    });
+}
+
+TEST(PixelConvertTest, PremultiplyRoundsToNearest) {
+    PaddedImage source(37, 4, 4, 4);
+    ForEachSimdLevel([&]() {
+        std::vector<std::uint8_t> out(static_cast<size_t>(37) * 4 * 4);
+        ASSERT_TRUE(PremultiplyRows(source.View(PixelFormat::BGRA32), out.data(), 37 * 4).IsSuccess());
+        for (int y = 0; y < source.height; y++) {
+            for (int x = 0; x < source.width; x++) {
+                const std::uint8_t* s = &source.pixels[static_cast<size_t>(y) * source.stride + x * 4];
+                const std::uint8_t* d = &out[(static_cast<size_t>(y) * 37 + x) * 4];
+                for (int c = 0; c < 3; c++) {
+                    ASSERT_EQ(d[c], ExpectedPremultiplied(s[c], s[3]));
+                }
+                ASSERT_EQ(d[3], s[3]);
+            }
+        }
+    });
+}
+
+TEST(PixelConvertTest, InPlaceMatchesOutOfPlace) {
+    PaddedImage source(93, 6, 4, 5);
+    ForEachSimdLevel([&]() {
+        for (PixelFormat target : {PixelFormat::RGB24, PixelFormat::RGBA32, PixelFormat::GRAY8,
+                                   PixelFormat::RGB565, PixelFormat::MONO1}) {
+            auto expected = Convert(source.View(PixelFormat::BGRA32), target).TakeData();
+
+            ImageData image;
+            image.width = source.width;
+            image.height = source.height;
+            image.bitsPerPixel = 32;
+            image.stride = source.stride;
+            image.data = source.pixels;
+            ASSERT_TRUE(ConvertInPlace(image, target).IsSuccess());
+            EXPECT_EQ(image.bitsPerPixel, GetBitsPerPixel(target));
+            EXPECT_EQ(image.GetFormat(), target);
+            EXPECT_EQ(image.stride, expected.stride);
+            EXPECT_EQ(image.data, expected.data);
+            // 转换为较小的格式后不再占着 BGRA32 大小的内存
+            EXPECT_EQ(image.data.capacity(), image.data.size());
+        }
+
+        ImageData image = CopyToImageData(source.View(PixelFormat::BGRA32));
+        std::vector<std::uint8_t> expected(image.data.size());
+        PremultiplyRows(ImageView(image), expected.data(), image.stride);
+        ASSERT_TRUE(PremultiplyInPlace(image).IsSuccess());
+        EXPECT_EQ(image.data, expected);
+    });
+}
+
+TEST(PixelConvertTest, Rgb565RoundTripKeepsHighBits) {
+    PaddedImage source(53, 5, 4, 7);
+    ForEachSimdLevel([&]() {
+        auto packed = Convert(source.View(PixelFormat::BGRA32), PixelFormat::RGB565);
+        ASSERT_TRUE(packed.IsSuccess());
+        EXPECT_EQ(packed.GetData().stride, 108);
+        EXPECT_EQ(packed.GetData().bitsPerPixel, 16);
+
+        auto unpacked = Convert(ImageView(packed.GetData()), PixelFormat::BGRA32);
+        ASSERT_TRUE(unpacked.IsSuccess());
+        for (int y = 0; y < source.height; y++) {
+            for (int x = 0; x < source.width; x++) {
+                const std::uint8_t* s = &source.pixels[static_cast<size_t>(y) * source.stride + x * 4];
+                const std::uint8_t* p = &packed.GetData().data[static_cast<size_t>(y) * 108 + x * 2];
+                int expected = ((s[2] >> 3) << 11) | ((s[1] >> 2) << 5) | (s[0] >> 3);
+                ASSERT_EQ(p[0] | (p[1] << 8), expected) << x << "," << y;
+
+                // 展开时高位复制到低位，0 与 255 保持不变
+                const std::uint8_t* d = &unpacked.GetData().data[(static_cast<size_t>(y) * 53 + x) * 4];
+                ASSERT_EQ(d[0], (s[0] & 0xF8) | (s[0] >> 5));
+                ASSERT_EQ(d[1], (s[1] & 0xFC) | (s[1] >> 6));
+                ASSERT_EQ(d[2], (s[2] & 0xF8) | (s[2] >> 5));
+                ASSERT_EQ(d[3], 255);
+            }
+        }
+    });
+}
+
+TEST(PixelConvertTest, MonoMaskPacksMostSignificantBitFirst) {
+    PaddedImage source(70, 4, 4, 8);
+    ForEachSimdLevel([&]() {
+        auto alpha = CreateMask(source.View(PixelFormat::BGRA32), MaskChannel::ALPHA, 100);
+        auto luma = Convert(source.View(PixelFormat::BGRA32), PixelFormat::MONO1);
+        ASSERT_TRUE(alpha.IsSuccess());
+        ASSERT_TRUE(luma.IsSuccess());
+        EXPECT_EQ(alpha.GetData().stride, 12);
+        EXPECT_EQ(alpha.GetData().GetFormat(), PixelFormat::MONO1);
+
+        ImageView alphaView(alpha.GetData());
+        ImageView lumaView(luma.GetData());
+        for (int y = 0; y < source.height; y++) {
+            for (int x = 0; x < source.width; x++) {
+                const std::uint8_t* s = &source.pixels[static_cast<size_t>(y) * source.stride + x * 4];
+                ASSERT_EQ(alphaView.MaskBit(x, y), s[3] >= 100) << x << "," << y;
+                ASSERT_EQ(lumaView.MaskBit(x, y), ExpectedGray(s) >= 128) << x << "," << y;
+            }
+            // 行尾多余的位保持为0
+            EXPECT_EQ(alphaView.Row(y)[8] & 0x03, 0);
+            EXPECT_EQ(alphaView.Row(y)[9], 0);
+        }
+
+        auto gray = Convert(lumaView, PixelFormat::GRAY8);
+        ASSERT_TRUE(gray.IsSuccess());
+        for (int x = 0; x < source.width; x++) {
+            ASSERT_EQ(gray.GetData().data[x], lumaView.MaskBit(x, 0) ? 255 : 0);
+        }
+    });
+}
+
+TEST(PixelConvertTest, RejectsInvalidRequests) {
+    PaddedImage source(8, 8, 4, 6);
+    ImageView view = source.View(PixelFormat::BGRA32);
+    std::vector<std::uint8_t> small(8 * 8 * 2);
+
+    EXPECT_TRUE(Convert(view, PixelFormat::UNKNOWN).IsError());
+    EXPECT_TRUE(Convert(ImageView(), PixelFormat::RGB24).IsError());
+    EXPECT_TRUE(ConvertRows(view, PixelFormat::RGB24, small.data(), 8 * 2).IsError());
+    EXPECT_TRUE(PremultiplyRows(source.View(PixelFormat::GRAY8), small.data(), 8).IsError());
+    EXPECT_TRUE(CreateMask(source.View(PixelFormat::GRAY8), MaskChannel::ALPHA, 128).IsError());
+
+    // 扩张的转换不能原地进行
+    ImageData gray = CopyToImageData(source.View(PixelFormat::GRAY8));
+    EXPECT_TRUE(ConvertInPlace(gray, PixelFormat::BGRA32).IsError());
+}
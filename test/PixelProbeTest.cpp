@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include "../DataLayer/include/PixelProbe.h"
+#include "TestUtils.h"
+
+#include <vector>
+
+using namespace PixelProbe;
+using TestUtils::ForEachSimdLevel;
+
+namespace {
+
+// 生成每个像素编码了自身坐标的BGRA图像
+std::vector<std::uint8_t> MakeCoordinateImage(int width, int height) {
+    std::vector<std::uint8_t> pixels(static_cast<size_t>(width) * height * 4);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            std::uint8_t* p = &pixels[(static_cast<size_t>(y) * width + x) * 4];
+            p[0] = static_cast<std::uint8_t>(x);
+            p[1] = static_cast<std::uint8_t>(y);
+            p[2] = static_cast<std::uint8_t>(x + y);
+            p[3] = 255;
+        }
+    }
+    return pixels;
+}
+
+// 期望颜色与坐标图像一致的探测点
+Probe CoordinateProbe(int x, int y) {
+    return Probe::Rgb(x, y, static_cast<std::uint8_t>(x + y), static_cast<std::uint8_t>(y),
+                      static_cast<std::uint8_t>(x));
+}
+
+}  // namespace
+
+TEST(PixelProbeTest, CompileComputesBoundingBox) {
+    auto result = PixelProbeSet::Compile({CoordinateProbe(10, 40), CoordinateProbe(30, 5), CoordinateProbe(12, 12)});
+    ASSERT_TRUE(result.IsSuccess());
+    const auto& set = result.GetData();
+    EXPECT_EQ(set.GetProbeCount(), 3);
+    EXPECT_EQ(set.GetBounds().left, 10);
+    EXPECT_EQ(set.GetBounds().top, 5);
+    EXPECT_EQ(set.GetBounds().right, 31);
+    EXPECT_EQ(set.GetBounds().bottom, 41);
+    EXPECT_EQ(set.GetAllMask(), 0x7u);
+}
+
+TEST(PixelProbeTest, CompileRejectsInvalidProbes) {
+    EXPECT_TRUE(PixelProbeSet::Compile({}).IsError());
+    EXPECT_TRUE(PixelProbeSet::Compile({Probe::Rgb(-1, 0, 0, 0, 0)}).IsError());
+    std::vector<Probe> tooMany(PixelProbeSet::MAX_PROBES + 1, Probe::Rgb(0, 0, 0, 0, 0));
+    EXPECT_TRUE(PixelProbeSet::Compile(tooMany).IsError());
+    tooMany.pop_back();
+    EXPECT_TRUE(PixelProbeSet::Compile(tooMany).IsSuccess());
+}
+
+TEST(PixelProbeTest, ReportsPerProbeMatches) {
+    auto pixels = MakeCoordinateImage(100, 80);
+    ImageView frame(pixels.data(), 100, 80, 100 * 4, PixelFormat::BGRA32);
+
+    // 偶数下标的探测点颜色正确，奇数下标的偏差超出容差
+    std::vector<Probe> probes;
+    std::uint64_t expected = 0;
+    for (int i = 0; i < 21; i++) {
+        Probe probe = CoordinateProbe(3 * i + 1, 2 * i + 7);
+        if (i % 2 == 1) {
+            probe.color[1] = static_cast<std::uint8_t>(probe.color[1] + 9);
+        } else {
+            expected |= 1ull << i;
+        }
+        probe.tolerance = {4, 4, 4, 255};
+        probes.push_back(probe);
+    }
+    auto set = PixelProbeSet::Compile(probes).TakeData();
+
+    ForEachSimdLevel([&]() {
+        auto result = set.Evaluate(frame);
+        ASSERT_TRUE(result.IsSuccess());
+        EXPECT_EQ(result.GetData(), expected);
+        EXPECT_FALSE(set.AllMatched(result.GetData()));
+    });
+}
+
+TEST(PixelProbeTest, ToleranceIsInclusivePerChannel) {
+    std::vector<std::uint8_t> pixels = {100, 150, 200, 255};
+    ImageView frame(pixels.data(), 1, 1, 4, PixelFormat::BGRA32);
+
+    Probe probe = Probe::Rgb(0, 0, 205, 145, 95);
+    probe.tolerance = {5, 5, 5, 255};
+    auto within = PixelProbeSet::Compile({probe}).TakeData();
+
+    probe.tolerance = {5, 4, 5, 255};
+    auto outside = PixelProbeSet::Compile({probe}).TakeData();
+
+    ForEachSimdLevel([&]() {
+        EXPECT_EQ(within.Evaluate(frame).GetData(), 1u);
+        EXPECT_EQ(outside.Evaluate(frame).GetData(), 0u);
+    });
+}
+
+TEST(PixelProbeTest, EvaluatesRegionCaptureOfBoundingBox) {
+    auto pixels = MakeCoordinateImage(200, 150);
+    ImageView frame(pixels.data(), 200, 150, 200 * 4, PixelFormat::BGRA32);
+
+    std::vector<Probe> probes;
+    for (int i = 0; i < 64; i++) {
+        probes.push_back(CoordinateProbe(50 + (i % 8) * 9, 60 + (i / 8) * 7));
+    }
+    auto set = PixelProbeSet::Compile(probes).TakeData();
+
+    // 模拟只抓取外接矩形：复制出一块独立的小图
+    ImageData region = CopyToImageData(frame.Subview(set.GetBounds()));
+    const auto& bounds = set.GetBounds();
+
+    ForEachSimdLevel([&]() {
+        auto full = set.Evaluate(frame);
+        auto partial = set.Evaluate(ImageView(region), Point(bounds.left, bounds.top));
+        ASSERT_TRUE(full.IsSuccess());
+        ASSERT_TRUE(partial.IsSuccess());
+        EXPECT_EQ(full.GetData(), ~0ull);
+        EXPECT_EQ(partial.GetData(), ~0ull);
+        EXPECT_TRUE(set.AllMatched(partial.GetData()));
+    });
+}
+
+TEST(PixelProbeTest, RejectsViewsThatMissProbes) {
+    auto pixels = MakeCoordinateImage(64, 64);
+    ImageView frame(pixels.data(), 64, 64, 64 * 4, PixelFormat::BGRA32);
+    auto set = PixelProbeSet::Compile({CoordinateProbe(10, 10), CoordinateProbe(20, 30)}).TakeData();
+
+    EXPECT_TRUE(set.Evaluate(frame.Subview(WindowsAPI::Rectangle(0, 0, 20, 64))).IsError());
+    EXPECT_TRUE(set.Evaluate(frame.Subview(WindowsAPI::Rectangle(12, 0, 64, 64)), Point(12, 0)).IsError());
+    EXPECT_TRUE(set.Evaluate(ImageView()).IsError());
+    EXPECT_TRUE(PixelProbeSet().Evaluate(frame).IsError());
+}
@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+#include "../DataLayer/include/RegionCapture.h"
+
+#include <vector>
+
+using namespace ScreenCapture;
+
+namespace {
+
+// 生成每个像素编码了自身坐标的BGRA图像
+std::vector<std::uint8_t> MakeCoordinateImage(int width, int height) {
+    std::vector<std::uint8_t> pixels(static_cast<size_t>(width) * height * 4);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            std::uint8_t* p = &pixels[(static_cast<size_t>(y) * width + x) * 4];
+            p[0] = static_cast<std::uint8_t>(x);
+            p[1] = static_cast<std::uint8_t>(y);
+            p[2] = 0;
+            p[3] = 255;
+        }
+    }
+    return pixels;
+}
+
+}  // namespace
+
+TEST(RegionCaptureTest, PlanUsesBoundingBoxOfAllRegions) {
+    std::vector<WindowsAPI::Rectangle> regions = {
+        WindowsAPI::Rectangle(10, 20, 50, 60),
+        WindowsAPI::Rectangle(40, 5, 70, 30),
+    };
+
+    auto result = PlanRegionCapture(regions, 200, 100);
+    ASSERT_TRUE(result.IsSuccess());
+    const auto& bounds = result.GetData().bounds;
+    EXPECT_EQ(bounds.left, 10);
+    EXPECT_EQ(bounds.top, 5);
+    EXPECT_EQ(bounds.right, 70);
+    EXPECT_EQ(bounds.bottom, 60);
+}
+
+TEST(RegionCaptureTest, PlanRejectsInvalidRegions) {
+    EXPECT_TRUE(PlanRegionCapture({}, 100, 100).IsError());
+    EXPECT_TRUE(PlanRegionCapture({WindowsAPI::Rectangle(10, 10, 10, 20)}, 100, 100).IsError());
+    EXPECT_TRUE(PlanRegionCapture({WindowsAPI::Rectangle(-1, 0, 10, 10)}, 100, 100).IsError());
+    EXPECT_TRUE(PlanRegionCapture({WindowsAPI::Rectangle(90, 90, 101, 100)}, 100, 100).IsError());
+    EXPECT_TRUE(PlanRegionCapture({WindowsAPI::Rectangle(0, 0, 100, 100)}, 100, 100).IsSuccess());
+}
+
+TEST(RegionCaptureTest, ExtractsRightSizedRegions) {
+    std::vector<WindowsAPI::Rectangle> regions = {
+        WindowsAPI::Rectangle(10, 20, 14, 23),
+        WindowsAPI::Rectangle(30, 25, 32, 40),
+    };
+    auto planResult = PlanRegionCapture(regions, 64, 64);
+    ASSERT_TRUE(planResult.IsSuccess());
+    const auto& plan = planResult.GetData();
+
+    // 模拟只抓取外接矩形：像素按源坐标编码
+    int width = plan.bounds.width();
+    int height = plan.bounds.height();
+    auto source = MakeCoordinateImage(64, 64);
+    std::vector<std::uint8_t> grabbed(static_cast<size_t>(width) * height * 4);
+    for (int y = 0; y < height; y++) {
+        const std::uint8_t* src = &source[((static_cast<size_t>(plan.bounds.top) + y) * 64 + plan.bounds.left) * 4];
+        std::copy(src, src + width * 4, &grabbed[static_cast<size_t>(y) * width * 4]);
+    }
+
+    auto extractResult = ExtractRegions(plan, ImageView(grabbed.data(), width, height, width * 4, PixelFormat::BGRA32));
+    ASSERT_TRUE(extractResult.IsSuccess());
+    const auto& images = extractResult.GetData();
+    ASSERT_EQ(images.size(), 2u);
+
+    for (size_t i = 0; i < images.size(); i++) {
+        const ImageData& image = images[i];
+        EXPECT_EQ(image.width, regions[i].width());
+        EXPECT_EQ(image.height, regions[i].height());
+        EXPECT_EQ(image.stride, image.width * 4);
+        EXPECT_EQ(image.data.size(), static_cast<size_t>(image.stride) * image.height);
+        for (int y = 0; y < image.height; y++) {
+            for (int x = 0; x < image.width; x++) {
+                const std::uint8_t* p = &image.data[static_cast<size_t>(y) * image.stride + x * 4];
+                EXPECT_EQ(p[0], regions[i].left + x);
+                EXPECT_EQ(p[1], regions[i].top + y);
+            }
+        }
+    }
+}
+
+TEST(RegionCaptureTest, RegionViewsAreZeroCopy) {
+    std::vector<WindowsAPI::Rectangle> regions = {
+        WindowsAPI::Rectangle(2, 2, 6, 6),
+        WindowsAPI::Rectangle(8, 4, 10, 12),
+    };
+    auto planResult = PlanRegionCapture(regions, 16, 16);
+    ASSERT_TRUE(planResult.IsSuccess());
+    const auto& plan = planResult.GetData();
+
+    int width = plan.bounds.width();
+    int height = plan.bounds.height();
+    std::vector<std::uint8_t> grabbed(static_cast<size_t>(width) * height * 4);
+    ImageView grabbedView(grabbed.data(), width, height, width * 4, PixelFormat::BGRA32);
+
+    auto viewsResult = GetRegionViews(plan, grabbedView);
+    ASSERT_TRUE(viewsResult.IsSuccess());
+    const auto& views = viewsResult.GetData();
+    ASSERT_EQ(views.size(), 2u);
+    EXPECT_EQ(views[0].data, grabbedView.PixelAt(0, 0));
+    EXPECT_EQ(views[1].data, grabbedView.PixelAt(6, 2));
+    EXPECT_EQ(views[1].width, 2);
+    EXPECT_EQ(views[1].height, 8);
+    EXPECT_EQ(views[1].stride, width * 4);
+}
+
+TEST(RegionCaptureTest, ExtractRejectsMismatchedGrab) {
+    auto planResult = PlanRegionCapture({WindowsAPI::Rectangle(0, 0, 8, 8)}, 16, 16);
+    ASSERT_TRUE(planResult.IsSuccess());
+
+    std::vector<std::uint8_t> pixels(16 * 16 * 4);
+    auto result = ExtractRegions(planResult.GetData(), ImageView(pixels.data(), 16, 16, 64, PixelFormat::BGRA32));
+    EXPECT_TRUE(result.IsError());
+    EXPECT_EQ(result.GetErrorCode(), ErrorCode::INVALID_PARAMETER);
+}
+
+TEST(RegionCaptureTest, PlanGroupsDistantRegionsSeparately) {
+    // 左上角两个相邻图标合为一组，右下角的图标单独一组
+    std::vector<WindowsAPI::Rectangle> regions = {
+        WindowsAPI::Rectangle(10, 10, 50, 50),
+        WindowsAPI::Rectangle(1800, 1000, 1840, 1040),
+        WindowsAPI::Rectangle(55, 10, 95, 50),
+    };
+    auto result = PlanRegionCapture(regions, 1920, 1080);
+    ASSERT_TRUE(result.IsSuccess());
+    const auto& plan = result.GetData();
+    EXPECT_EQ(plan.bounds.left, 10);
+    EXPECT_EQ(plan.bounds.right, 1840);
+    ASSERT_EQ(plan.groups.size(), 2u);
+    EXPECT_EQ(plan.groups[0].regions, (std::vector<size_t>{0, 2}));
+    EXPECT_EQ(plan.groups[0].bounds.left, 10);
+    EXPECT_EQ(plan.groups[0].bounds.right, 95);
+    EXPECT_EQ(plan.groups[1].regions, (std::vector<size_t>{1}));
+
+    // 不允许多抓像素时相邻但不接触的区域也分开；负的余量无效
+    EXPECT_EQ(PlanRegionCapture(regions, 1920, 1080, 0).GetData().groups.size(), 3u);
+    EXPECT_TRUE(PlanRegionCapture(regions, 1920, 1080, -1).IsError());
+    // 余量足够大时退化为单个外接矩形
+    EXPECT_EQ(PlanRegionCapture(regions, 1920, 1080, 1920 * 1080).GetData().groups.size(), 1u);
+}
+
+TEST(RegionCaptureTest, ExtractsRegionsFromGroupGrabs) {
+    std::vector<WindowsAPI::Rectangle> regions = {
+        WindowsAPI::Rectangle(2, 2, 6, 6),
+        WindowsAPI::Rectangle(200, 150, 204, 153),
+        WindowsAPI::Rectangle(7, 3, 9, 8),
+    };
+    auto planResult = PlanRegionCapture(regions, 256, 256);
+    ASSERT_TRUE(planResult.IsSuccess());
+    const auto& plan = planResult.GetData();
+    ASSERT_EQ(plan.groups.size(), 2u);
+
+    // 模拟整幅打印后按组取子视图
+    auto source = MakeCoordinateImage(256, 256);
+    ImageView window(source.data(), 256, 256, 256 * 4, PixelFormat::BGRA32);
+    std::vector<ImageView> grabs;
+    for (const auto& group : plan.groups) {
+        grabs.push_back(window.Subview(group.bounds));
+    }
+
+    auto extractResult = ExtractGroupedRegions(plan, grabs);
+    ASSERT_TRUE(extractResult.IsSuccess());
+    const auto& images = extractResult.GetData();
+    ASSERT_EQ(images.size(), 3u);
+    for (size_t i = 0; i < images.size(); i++) {
+        EXPECT_EQ(images[i].width, regions[i].width());
+        EXPECT_EQ(images[i].height, regions[i].height());
+        for (int y = 0; y < images[i].height; y++) {
+            for (int x = 0; x < images[i].width; x++) {
+                const std::uint8_t* p = &images[i].data[static_cast<size_t>(y) * images[i].stride + x * 4];
+                EXPECT_EQ(p[0], static_cast<std::uint8_t>(regions[i].left + x));
+                EXPECT_EQ(p[1], static_cast<std::uint8_t>(regions[i].top + y));
+            }
+        }
+    }
+
+    // 抓取数量或尺寸与分组不符
+    EXPECT_TRUE(ExtractGroupedRegions(plan, {grabs[0]}).IsError());
+    std::swap(grabs[0], grabs[1]);
+    EXPECT_EQ(ExtractGroupedRegions(plan, grabs).GetErrorCode(), ErrorCode::INVALID_PARAMETER);
+}
@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+#include "../DataLayer/include/PixelConvert.h"
+#include "../DataLayer/include/RegionStats.h"
+#include "TestUtils.h"
+
+#include <random>
+#include <vector>
+
+using namespace RegionStats;
+using TestUtils::ForEachSimdLevel;
+
+namespace {
+
+// 随机 BGRA 图像，行尾带填充
+struct PaddedImage {
+    int width;
+    int height;
+    int stride;
+    std::vector<std::uint8_t> pixels;
+
+    PaddedImage(int w, int h, unsigned seed) : width(w), height(h), stride(w * 4 + 8), pixels(static_cast<size_t>(stride) * h) {
+        std::mt19937 rng(seed);
+        for (auto& p : pixels) {
+            p = static_cast<std::uint8_t>(rng());
+        }
+    }
+
+    ImageView View() const { return ImageView(pixels.data(), width, height, stride, PixelFormat::BGRA32); }
+};
+
+// 逐像素统计参考实现
+void ReferenceStats(const ImageView& view, const WindowsAPI::Rectangle& rect, int channel, int channels,
+                    std::uint64_t& sum, std::uint64_t& sumSq) {
+    sum = 0;
+    sumSq = 0;
+    for (int y = rect.top; y < rect.bottom; y++) {
+        for (int x = rect.left; x < rect.right; x++) {
+            std::uint64_t v = view.Row(y)[x * channels + channel];
+            sum += v;
+            sumSq += v * v;
+        }
+    }
+}
+
+}  // namespace
+
+TEST(RegionStatsTest, GrayQueriesMatchReference) {
+    PaddedImage source(83, 41, 1);
+    ImageData gray = PixelConvert::Convert(source.View(), PixelFormat::GRAY8).TakeData();
+    ImageView grayView(gray);
+    std::mt19937 rng(2);
+
+    ForEachSimdLevel([&]() {
+        // BGRA 按灰度权重转换后的结果与直接使用 GRAY8 相同
+        auto fromBgra = IntegralImage::Build(source.View());
+        auto fromGray = IntegralImage::Build(grayView);
+        ASSERT_TRUE(fromBgra.IsSuccess());
+        ASSERT_TRUE(fromGray.IsSuccess());
+        EXPECT_EQ(fromBgra.GetData().GetChannelCount(), 1);
+
+        for (int i = 0; i < 200; i++) {
+            int left = static_cast<int>(rng() % 83);
+            int top = static_cast<int>(rng() % 41);
+            int right = left + 1 + static_cast<int>(rng() % (83 - left));
+            int bottom = top + 1 + static_cast<int>(rng() % (41 - top));
+            WindowsAPI::Rectangle rect(left, top, right, bottom);
+
+            std::uint64_t sum = 0;
+            std::uint64_t sumSq = 0;
+            ReferenceStats(grayView, rect, 0, 1, sum, sumSq);
+            auto stats = fromBgra.GetData().Query(rect);
+            ASSERT_TRUE(stats.IsSuccess());
+            double count = static_cast<double>(rect.width()) * rect.height();
+            ASSERT_EQ(stats.GetData().sum[0], sum);
+            ASSERT_EQ(stats.GetData().pixelCount, static_cast<std::uint64_t>(count));
+            ASSERT_NEAR(stats.GetData().mean[0], sum / count, 1e-9);
+            ASSERT_NEAR(stats.GetData().variance[0], sumSq / count - (sum / count) * (sum / count), 1e-6);
+            ASSERT_EQ(fromGray.GetData().SumOfSquares(left, top, rect.width(), rect.height()), sumSq);
+        }
+    });
+}
+
+TEST(RegionStatsTest, PerChannelQueriesMatchReference) {
+    PaddedImage source(29, 17, 3);
+    ForEachSimdLevel([&]() {
+        auto integral = IntegralImage::Build(source.View(), ChannelMode::PER_CHANNEL);
+        ASSERT_TRUE(integral.IsSuccess());
+        EXPECT_EQ(integral.GetData().GetChannelCount(), 4);
+
+        WindowsAPI::Rectangle rect(3, 2, 27, 15);
+        auto stats = integral.GetData().Query(rect).TakeData();
+        for (int c = 0; c < 4; c++) {
+            std::uint64_t sum = 0;
+            std::uint64_t sumSq = 0;
+            ReferenceStats(source.View(), rect, c, 4, sum, sumSq);
+            EXPECT_EQ(stats.sum[c], sum);
+            EXPECT_EQ(integral.GetData().SumOfSquares(3, 2, 24, 13, c), sumSq);
+        }
+    });
+}
+
+TEST(RegionStatsTest, ModularSumsStayExactForLargeImages) {
+    // 4000x4000 全白：整幅和超过 2^31，但仍小于 2^32
+    std::vector<std::uint8_t> white(static_cast<size_t>(4000) * 4000, 255);
+    ImageView view(white.data(), 4000, 4000, 4000, PixelFormat::GRAY8);
+    auto integral = IntegralImage::Build(view);
+    ASSERT_TRUE(integral.IsSuccess());
+    EXPECT_EQ(integral.GetData().Sum(0, 0, 4000, 4000), 4000ull * 4000 * 255);
+    EXPECT_EQ(integral.GetData().Sum(1000, 3000, 2000, 1000), 2000ull * 1000 * 255);
+    EXPECT_EQ(integral.GetData().SumOfSquares(0, 0, 4000, 4000), 4000ull * 4000 * 255 * 255);
+
+    std::vector<std::uint8_t> huge(static_cast<size_t>(5000) * 4000);
+    EXPECT_TRUE(IntegralImage::Build(ImageView(huge.data(), 5000, 4000, 5000, PixelFormat::GRAY8)).IsError());
+}
+
+TEST(RegionStatsTest, IncrementalUpdateMatchesRebuild) {
+    PaddedImage first(64, 48, 4);
+    PaddedImage second = first;
+    // 只修改第 30-35 行
+    std::mt19937 rng(5);
+    for (int y = 30; y < 36; y++) {
+        for (int x = 0; x < 64 * 4; x++) {
+            second.pixels[static_cast<size_t>(y) * second.stride + x] = static_cast<std::uint8_t>(rng());
+        }
+    }
+
+    for (ChannelMode mode : {ChannelMode::GRAY, ChannelMode::PER_CHANNEL}) {
+        auto integral = IntegralImage::Build(first.View(), mode).TakeData();
+        std::vector<WindowsAPI::Rectangle> dirty = {WindowsAPI::Rectangle(10, 32, 20, 36),
+                                                    WindowsAPI::Rectangle(0, 30, 64, 34)};
+        ASSERT_TRUE(integral.Update(second.View(), dirty).IsSuccess());
+
+        auto rebuilt = IntegralImage::Build(second.View(), mode).TakeData();
+        for (int c = 0; c < integral.GetChannelCount(); c++) {
+            for (int y = 0; y <= 48; y += 6) {
+                for (int x = 0; x <= 64; x += 8) {
+                    ASSERT_EQ(integral.Sum(0, 0, x, y, c), rebuilt.Sum(0, 0, x, y, c));
+                    ASSERT_EQ(integral.SumOfSquares(0, 0, x, y, c), rebuilt.SumOfSquares(0, 0, x, y, c));
+                }
+            }
+        }
+
+        // 没有脏区域时保持不变；尺寸不同的帧被拒绝
+        EXPECT_TRUE(integral.Update(second.View(), std::vector<WindowsAPI::Rectangle>()).IsSuccess());
+        EXPECT_TRUE(integral.Update(second.View().Subview(WindowsAPI::Rectangle(0, 0, 32, 32)), 0).IsError());
+    }
+}
+
+TEST(RegionStatsTest, DetectsUniformRegions) {
+    PaddedImage source(40, 40, 6);
+    // 左上 20x20 填充为近似纯色的面板
+    for (int y = 0; y < 20; y++) {
+        for (int x = 0; x < 20; x++) {
+            std::uint8_t* p = &source.pixels[static_cast<size_t>(y) * source.stride + x * 4];
+            p[0] = static_cast<std::uint8_t>(200 + (x + y) % 2);
+            p[1] = 200;
+            p[2] = 200;
+            p[3] = 255;
+        }
+    }
+
+    auto integral = IntegralImage::Build(source.View(), ChannelMode::PER_CHANNEL).TakeData();
+    EXPECT_TRUE(integral.IsUniform(WindowsAPI::Rectangle(0, 0, 20, 20), 1.0).GetData());
+    EXPECT_FALSE(integral.IsUniform(WindowsAPI::Rectangle(0, 0, 21, 20), 1.0).GetData());
+    EXPECT_FALSE(integral.IsUniform(WindowsAPI::Rectangle(20, 20, 40, 40), 10.0).GetData());
+    EXPECT_TRUE(integral.IsUniform(WindowsAPI::Rectangle(0, 0, 41, 20), 1.0).IsError());
+    EXPECT_TRUE(integral.Query(WindowsAPI::Rectangle(5, 5, 5, 10)).IsError());
+    EXPECT_TRUE(IntegralImage().Query(WindowsAPI::Rectangle(0, 0, 1, 1)).IsError());
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include "../Common/include/BasicTypes.h"
+
+#include <vector>
+
+using namespace WindowsAPI;
+
+namespace {
+
+// 统计复制与移动次数的载荷
+struct CopyCounter {
+    static int copies;
+    static int moves;
+
+    std::vector<int> payload;
+
+    CopyCounter() = default;
+    explicit CopyCounter(size_t size) : payload(size, 7) {}
+    CopyCounter(const CopyCounter& other) : payload(other.payload) { copies++; }
+    CopyCounter(CopyCounter&& other) noexcept : payload(std::move(other.payload)) { moves++; }
+    CopyCounter& operator=(const CopyCounter& other) {
+        payload = other.payload;
+        copies++;
+        return *this;
+    }
+    CopyCounter& operator=(CopyCounter&& other) noexcept {
+        payload = std::move(other.payload);
+        moves++;
+        return *this;
+    }
+
+    static void ResetCounters() {
+        copies = 0;
+        moves = 0;
+    }
+};
+
+int CopyCounter::copies = 0;
+int CopyCounter::moves = 0;
+
+Result<CopyCounter> Produce() {
+    CopyCounter value(1024);
+    return Result<CopyCounter>::Success(std::move(value));
+}
+
+}  // namespace
+
+TEST(ResultTest, SuccessMovesPayloadWithoutCopy) {
+    CopyCounter::ResetCounters();
+
+    auto result = Produce();
+    ASSERT_TRUE(result.IsSuccess());
+    CopyCounter taken = std::move(result).TakeData();
+
+    EXPECT_EQ(CopyCounter::copies, 0);
+    EXPECT_EQ(taken.payload.size(), 1024u);
+}
+
+TEST(ResultTest, GetDataOnTemporaryMovesOut) {
+    CopyCounter::ResetCounters();
+
+    CopyCounter value = Produce().GetData();
+
+    EXPECT_EQ(CopyCounter::copies, 0);
+    EXPECT_EQ(value.payload.size(), 1024u);
+}
+
+TEST(ResultTest, LvalueAccessStillReturnsReference) {
+    auto result = Produce();
+    CopyCounter::ResetCounters();
+
+    const auto& ref = result.GetData();
+    result.GetData().payload.push_back(1);
+
+    EXPECT_EQ(CopyCounter::copies, 0);
+    EXPECT_EQ(ref.payload.size(), 1025u);
+}
+
+TEST(ResultTest, ErrorWithoutMessageUsesStaticText) {
+    auto result = Result<CopyCounter>::Error(ErrorCode::CAPTURE_FAILED);
+
+    EXPECT_TRUE(result.IsError());
+    EXPECT_EQ(result.GetErrorCode(), ErrorCode::CAPTURE_FAILED);
+    EXPECT_EQ(result.GetErrorMessage(), L"Capture failed");
+    EXPECT_EQ(&result.GetErrorMessage(), &GetErrorCodeText(ErrorCode::CAPTURE_FAILED));
+}
+
+TEST(ResultTest, ErrorKeepsCustomMessageAcrossCopies) {
+    auto result = Result<int>::Error(ErrorCode::INVALID_HANDLE, L"Invalid window handle");
+    Result<int> copy = result;
+
+    EXPECT_EQ(copy.GetErrorMessage(), L"Invalid window handle");
+    EXPECT_EQ(&copy.GetErrorMessage(), &result.GetErrorMessage());
+}
+
+TEST(ResultTest, SuccessMessageIsStaticText) {
+    auto result = Result<int>::Success(42);
+
+    EXPECT_EQ(result.GetData(), 42);
+    EXPECT_EQ(result.GetErrorMessage(), L"Success");
+}
@@ -0,0 +1,206 @@
+#include <gtest/gtest.h>
+#include "../DataLayer/include/ScaledMatcher.h"
+#include "TestUtils.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace ScaledMatcher;
+using TestUtils::GrayImage;
+
+namespace {
+
+struct Box {
+    double left;
+    double top;
+    double right;
+    double bottom;
+    std::uint8_t value;
+};
+
+// 参考尺寸下的界面：随机矩形，按 scale 渲染（像素中心落在矩形内即为矩形颜色）
+std::vector<Box> MakeLayout(int width, int height, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::vector<Box> boxes;
+    for (int i = 0; i < 80; i++) {
+        const double w = 6 + rng() % 40;
+        const double h = 6 + rng() % 30;
+        const double left = rng() % static_cast<unsigned>(width - w);
+        const double top = rng() % static_cast<unsigned>(height - h);
+        boxes.push_back({left, top, left + w, top + h, static_cast<std::uint8_t>(30 + rng() % 200)});
+    }
+    return boxes;
+}
+
+GrayImage Render(const std::vector<Box>& boxes, int width, int height, double scale) {
+    GrayImage image(static_cast<int>(std::lround(width * scale)), static_cast<int>(std::lround(height * scale)));
+    for (int y = 0; y < image.height; y++) {
+        const double v = (y + 0.5) / scale;
+        for (int x = 0; x < image.width; x++) {
+            const double u = (x + 0.5) / scale;
+            std::uint8_t value = 210;
+            for (const Box& box : boxes) {
+                if (u >= box.left && u < box.right && v >= box.top && v < box.bottom) {
+                    value = box.value;
+                }
+            }
+            image.pixels[static_cast<size_t>(y) * image.width + x] = value;
+        }
+    }
+    return image;
+}
+
+GrayImage Crop(const GrayImage& image, int left, int top, int width, int height) {
+    GrayImage crop(width, height);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            crop.pixels[static_cast<size_t>(y) * width + x] = image.pixels[static_cast<size_t>(top + y) * image.width + left + x];
+        }
+    }
+    return crop;
+}
+
+const int kReferenceWidth = 320;
+const int kReferenceHeight = 240;
+
+}  // namespace
+
+TEST(ScaledMatcherTest, InfersScaleFromClientRect) {
+    EXPECT_DOUBLE_EQ(InferScale(WindowsAPI::Rectangle(0, 0, 320, 240), 320, 240), 1.0);
+    EXPECT_DOUBLE_EQ(InferScale(WindowsAPI::Rectangle(0, 0, 480, 360), 320, 240), 1.5);
+    EXPECT_DOUBLE_EQ(InferScale(WindowsAPI::Rectangle(10, 20, 410, 320), 320, 240), 1.25);
+    // 单向拉伸：取较小的比例
+    EXPECT_DOUBLE_EQ(InferScale(WindowsAPI::Rectangle(0, 0, 640, 300), 320, 240), 1.25);
+    EXPECT_DOUBLE_EQ(InferScale(WindowsAPI::Rectangle(), 320, 240), 1.0);
+    EXPECT_DOUBLE_EQ(InferScale(WindowsAPI::Rectangle(0, 0, 100, 100), 0, 240), 1.0);
+
+    ScaledTemplateSet set(800, 600);
+    EXPECT_DOUBLE_EQ(set.InferScale(WindowsAPI::Rectangle(0, 0, 1000, 750)), 1.25);
+}
+
+TEST(ScaledMatcherTest, FindsTemplatesAtKnownScales) {
+    const auto layout = MakeLayout(kReferenceWidth, kReferenceHeight, 4);
+    GrayImage reference = Render(layout, kReferenceWidth, kReferenceHeight, 1.0);
+    const int anchors[2][2] = {{40, 60}, {200, 150}};
+
+    ScaledTemplateSet set(kReferenceWidth, kReferenceHeight);
+    for (const auto& anchor : anchors) {
+        ASSERT_TRUE(set.Add(Crop(reference, anchor[0], anchor[1], 56, 40).View()).IsSuccess());
+    }
+    EXPECT_EQ(set.GetTemplateCount(), 2);
+
+    for (double scale : {1.0, 1.25, 1.5, 0.8, 2.0}) {
+        GrayImage frame = Render(layout, kReferenceWidth, kReferenceHeight, scale);
+        const double inferred = set.InferScale(WindowsAPI::Rectangle(0, 0, frame.width, frame.height));
+        EXPECT_NEAR(inferred, scale, 0.005);
+        for (int i = 0; i < 2; i++) {
+            auto found = set.Find(frame.View(), i, inferred);
+            ASSERT_TRUE(found.IsSuccess());
+            ASSERT_EQ(found.GetData().size(), 1u) << "scale " << scale << " template " << i;
+            EXPECT_NEAR(found.GetData()[0].location.x, anchors[i][0] * scale, 1.0) << "scale " << scale;
+            EXPECT_NEAR(found.GetData()[0].location.y, anchors[i][1] * scale, 1.0) << "scale " << scale;
+
+            auto view = set.GetTemplate(i, inferred).TakeData();
+            EXPECT_EQ(view.width, static_cast<int>(std::lround(56 * inferred)));
+            EXPECT_EQ(view.height, static_cast<int>(std::lround(40 * inferred)));
+        }
+    }
+    // 每个非参考比例缓存一次
+    EXPECT_EQ(set.GetCachedScaleCount(), 4u);
+
+    // 同一比例再次查询直接返回缓存的模板
+    auto first = set.GetTemplate(1, 1.5).TakeData();
+    auto second = set.GetTemplate(1, 1.5004).TakeData();
+    EXPECT_EQ(first.data, second.data);
+    EXPECT_EQ(set.GetCachedScaleCount(), 4u);
+
+    set.ClearCache();
+    EXPECT_EQ(set.GetCachedScaleCount(), 0u);
+    EXPECT_EQ(set.GetTemplateCount(), 2);
+}
+
+TEST(ScaledMatcherTest, PrepareResamplesWholeSet) {
+    const auto layout = MakeLayout(kReferenceWidth, kReferenceHeight, 9);
+    GrayImage reference = Render(layout, kReferenceWidth, kReferenceHeight, 1.0);
+
+    ScaledTemplateSet set(kReferenceWidth, kReferenceHeight);
+    ASSERT_TRUE(set.Add(Crop(reference, 10, 10, 40, 30).View()).IsSuccess());
+    ASSERT_TRUE(set.Prepare(1.75).IsSuccess());
+    EXPECT_EQ(set.GetCachedScaleCount(), 1u);
+
+    // 之后添加的模板同步补进已缓存的比例
+    std::vector<std::uint8_t> bgra(24 * 16 * 4, 255);
+    ASSERT_EQ(set.Add(ImageView(bgra.data(), 24, 16, 24 * 4, PixelFormat::BGRA32)).GetData(), 1);
+    auto added = set.GetTemplate(1, 1.75);
+    ASSERT_TRUE(added.IsSuccess());
+    EXPECT_EQ(added.GetData().width, 42);
+    EXPECT_EQ(added.GetData().height, 28);
+    EXPECT_EQ(added.GetData().format, PixelFormat::GRAY8);
+    EXPECT_EQ(set.GetCachedScaleCount(), 1u);
+
+    // 缩放后为空的模板
+    std::vector<std::uint8_t> tiny(2 * 2, 0);
+    ASSERT_TRUE(set.Add(ImageView(tiny.data(), 2, 2, 2, PixelFormat::GRAY8)).IsSuccess());
+    EXPECT_TRUE(set.Prepare(0.1).IsError());
+    EXPECT_TRUE(set.GetTemplate(2, 0.1).IsError());
+    EXPECT_TRUE(set.GetTemplate(0, 0.1).IsSuccess());
+}
+
+TEST(ScaledMatcherTest, SweepsScalesWhenInferenceMisses) {
+    const auto layout = MakeLayout(kReferenceWidth, kReferenceHeight, 21);
+    GrayImage reference = Render(layout, kReferenceWidth, kReferenceHeight, 1.0);
+    ScaledTemplateSet set(kReferenceWidth, kReferenceHeight);
+    ASSERT_TRUE(set.Add(Crop(reference, 120, 90, 64, 48).View()).IsSuccess());
+
+    // 窗口被拉伸但界面按 150% 渲染：客户区推断的比例（1.0）不对
+    GrayImage frame = Render(layout, kReferenceWidth, kReferenceHeight, 1.5);
+
+    ScaleOptions noSweep;
+    noSweep.sweepOnMiss = false;
+    auto miss = set.Locate(frame.View(), 0, 1.0, noSweep);
+    ASSERT_TRUE(miss.IsSuccess());
+    EXPECT_FALSE(miss.GetData().found);
+    EXPECT_FALSE(miss.GetData().swept);
+
+    auto swept = set.Locate(frame.View(), 0, 1.0);
+    ASSERT_TRUE(swept.IsSuccess());
+    const ScaledMatch& match = swept.GetData();
+    EXPECT_TRUE(match.found);
+    EXPECT_TRUE(match.swept);
+    EXPECT_NEAR(match.scale, 1.5, 0.05);
+    EXPECT_NEAR(match.match.location.x, 180, 3);
+    EXPECT_NEAR(match.match.location.y, 135, 3);
+    EXPECT_EQ(match.bounds.width(), static_cast<int>(std::lround(64 * match.scale)));
+    // 扫描只缓存找到的比例
+    EXPECT_EQ(set.GetCachedScaleCount(), 1u);
+
+    // 推断正确时不扫描
+    auto direct = set.Locate(frame.View(), 0, 1.5);
+    ASSERT_TRUE(direct.IsSuccess());
+    EXPECT_TRUE(direct.GetData().found);
+    EXPECT_FALSE(direct.GetData().swept);
+    EXPECT_EQ(direct.GetData().match.location.x, 180);
+    EXPECT_EQ(direct.GetData().match.location.y, 135);
+}
+
+TEST(ScaledMatcherTest, RejectsInvalidInput) {
+    ScaledTemplateSet set(320, 240);
+    EXPECT_TRUE(set.Add(ImageView()).IsError());
+    std::vector<std::uint8_t> rgb(10 * 10 * 3);
+    EXPECT_EQ(set.Add(ImageView(rgb.data(), 10, 10, 30, PixelFormat::RGB24)).GetErrorCode(), ErrorCode::INVALID_PARAMETER);
+
+    GrayImage frame(100, 100);
+    EXPECT_EQ(set.Find(frame.View(), 0, 1.0).GetErrorCode(), ErrorCode::INVALID_PARAMETER);
+    GrayImage templ(10, 10);
+    ASSERT_TRUE(set.Add(templ.View()).IsSuccess());
+    EXPECT_TRUE(set.GetTemplate(0, 0.0).IsError());
+    EXPECT_TRUE(set.GetTemplate(0, -1.0).IsError());
+    EXPECT_TRUE(set.GetTemplate(1, 1.0).IsError());
+    EXPECT_TRUE(set.Locate(ImageView(), 0, 1.0).IsError());
+
+    ScaleOptions badRange;
+    badRange.sweepRatio = 1.0;
+    EXPECT_EQ(set.Locate(frame.View(), 0, 1.0, badRange).GetErrorCode(), ErrorCode::INVALID_PARAMETER);
+}
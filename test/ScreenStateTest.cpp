@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+#include "../DataLayer/include/ScreenState.h"
+#include "TestUtils.h"
+
+#include <random>
+#include <vector>
+
+using namespace ScreenState;
+using TestUtils::GrayImage;
+
+namespace {
+
+// 相对坐标描述的界面面板，textured 为类似文字的条纹
+struct Panel {
+    double left, top, right, bottom;
+    int value;
+    bool textured;
+};
+
+// 按相对坐标绘制界面，不同分辨率得到相同的布局；noise 为逐像素随机扰动幅度
+GrayImage Render(const std::vector<Panel>& panels, int width, int height, int noise = 0, unsigned seed = 1) {
+    std::mt19937 rng(seed);
+    GrayImage image(width, height);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            double u = (x + 0.5) / width;
+            double v = (y + 0.5) / height;
+            int value = 90 + static_cast<int>(60 * u);
+            for (const auto& panel : panels) {
+                if (u >= panel.left && u < panel.right && v >= panel.top && v < panel.bottom) {
+                    bool stripe = panel.textured && static_cast<int>(v * 90) % 3 == 0 && static_cast<int>(u * 160) % 4 != 3;
+                    value = stripe ? 255 - panel.value : panel.value;
+                }
+            }
+            if (noise > 0) {
+                value += static_cast<int>(rng() % (2 * noise + 1)) - noise;
+            }
+            image.pixels[static_cast<size_t>(y) * width + x] = static_cast<std::uint8_t>(std::min(255, std::max(0, value)));
+        }
+    }
+    return image;
+}
+
+const std::vector<Panel> kLogin = {{0.3, 0.25, 0.7, 0.75, 230, false}, {0.35, 0.4, 0.65, 0.48, 250, true},
+                                   {0.35, 0.55, 0.65, 0.63, 250, true}};
+const std::vector<Panel> kLobby = {{0.0, 0.0, 1.0, 0.1, 40, true},  {0.05, 0.2, 0.3, 0.5, 200, true},
+                                   {0.35, 0.2, 0.6, 0.5, 170, true}, {0.65, 0.2, 0.95, 0.5, 210, true},
+                                   {0.05, 0.6, 0.95, 0.9, 60, true}};
+const std::vector<Panel> kSettings = {{0.0, 0.0, 0.2, 1.0, 30, true}, {0.25, 0.05, 0.95, 0.95, 240, true}};
+
+}  // namespace
+
+TEST(ScreenStateTest, ClassifiesKnownScreensUnderNoise) {
+    StateIndex index;
+    ASSERT_EQ(index.AddSample(L"login", Render(kLogin, 1280, 720).View()).GetData(), 0);
+    ASSERT_EQ(index.AddSample(L"lobby", Render(kLobby, 1280, 720).View()).GetData(), 1);
+    ASSERT_EQ(index.AddSample(L"settings", Render(kSettings, 1280, 720).View()).GetData(), 2);
+    EXPECT_EQ(index.GetStateCount(), 3);
+
+    const std::vector<Panel>* layouts[] = {&kLogin, &kLobby, &kSettings};
+    for (int state = 0; state < 3; state++) {
+        auto result = index.Classify(Render(*layouts[state], 1280, 720, 6, 10 + state).View());
+        ASSERT_TRUE(result.IsSuccess());
+        EXPECT_EQ(result.GetData().state, state);
+        EXPECT_GT(result.GetData().matchRatio, 0.95);
+        EXPECT_GT(result.GetData().confidence, 0.3);
+    }
+
+    // 随机噪声画面不属于任何已知界面
+    GrayImage unknown(1280, 720);
+    std::mt19937 rng(5);
+    for (auto& p : unknown.pixels) {
+        p = static_cast<std::uint8_t>(rng());
+    }
+    auto result = index.Classify(unknown.View());
+    ASSERT_TRUE(result.IsSuccess());
+    EXPECT_EQ(result.GetData().state, -1);
+    EXPECT_GE(result.GetData().nearestState, 0);
+    EXPECT_LT(result.GetData().matchRatio, 0.5);
+}
+
+TEST(ScreenStateTest, ToleratesResolutionAndFormatChange) {
+    StateIndex index;
+    index.AddSample(L"login", Render(kLogin, 1280, 720).View());
+    index.AddSample(L"lobby", Render(kLobby, 1280, 720).View());
+
+    // 不同分辨率的灰度截图
+    EXPECT_EQ(index.Classify(Render(kLobby, 1920, 1080).View()).GetData().state, 1);
+    EXPECT_EQ(index.Classify(Render(kLogin, 800, 450).View()).GetData().state, 0);
+
+    // BGRA 截图（B=G=R=灰度）
+    GrayImage gray = Render(kLobby, 1024, 576);
+    std::vector<std::uint8_t> bgra(gray.pixels.size() * 4);
+    for (size_t i = 0; i < gray.pixels.size(); i++) {
+        bgra[i * 4] = bgra[i * 4 + 1] = bgra[i * 4 + 2] = gray.pixels[i];
+        bgra[i * 4 + 3] = 255;
+    }
+    auto result = index.Classify(ImageView(bgra.data(), 1024, 576, 1024 * 4, PixelFormat::BGRA32));
+    ASSERT_TRUE(result.IsSuccess());
+    EXPECT_EQ(result.GetData().state, 1);
+    EXPECT_GT(result.GetData().matchRatio, 0.95);
+}
+
+TEST(ScreenStateTest, IgnoredRegionsAndSimilarStates) {
+    // 大厅右上角有会变化的计时器
+    std::vector<Panel> lobbyWithTimer = kLobby;
+    lobbyWithTimer.push_back({0.8, 0.0, 1.0, 0.1, 250, false});
+    std::vector<Panel> timerChanged = kLobby;
+    timerChanged.push_back({0.8, 0.0, 1.0, 0.1, 0, true});
+
+    StateIndex plain;
+    plain.AddSample(L"lobby", Render(lobbyWithTimer, 1280, 720).View());
+    StateIndex ignoring;
+    ignoring.AddSample(L"lobby", Render(lobbyWithTimer, 1280, 720).View(), {WindowsAPI::Rectangle(1024, 0, 1280, 72)});
+
+    GrayImage query = Render(timerChanged, 1280, 720);
+    EXPECT_LT(plain.Classify(query.View()).GetData().matchRatio, 1.0);
+    EXPECT_DOUBLE_EQ(ignoring.Classify(query.View()).GetData().matchRatio, 1.0);
+
+    // 大厅上弹出对话框：两个界面只差中间几个瓦片，置信度低于差别明显的界面
+    std::vector<Panel> dialog = kLobby;
+    dialog.push_back({0.35, 0.3, 0.65, 0.7, 235, true});
+    StateIndex index;
+    index.AddSample(L"lobby", Render(kLobby, 1280, 720).View());
+    index.AddSample(L"dialog", Render(dialog, 1280, 720).View());
+    index.AddSample(L"login", Render(kLogin, 1280, 720).View());
+    auto result = index.Classify(Render(dialog, 1280, 720, 4, 3).View()).GetData();
+    EXPECT_EQ(result.state, 1);
+    EXPECT_GT(result.confidence, 0.0);
+    EXPECT_LT(result.confidence, 0.3);
+
+    // 同名样本归入同一界面
+    EXPECT_EQ(index.AddSample(L"dialog", Render(dialog, 1600, 900).View()).GetData(), 1);
+    EXPECT_EQ(index.GetStateCount(), 3);
+    EXPECT_EQ(index.GetSampleCount(), 4);
+    EXPECT_EQ(index.FindState(L"login"), 2);
+    EXPECT_EQ(index.FindState(L"missing"), -1);
+}
+
+TEST(ScreenStateTest, SerializationRoundTrip) {
+    auto created = StateIndex::Create(12, 6);
+    ASSERT_TRUE(created.IsSuccess());
+    StateIndex index = std::move(created).TakeData();
+    index.AddSample(L"login", Render(kLogin, 1280, 720).View());
+    index.AddSample(L"lobby", Render(kLobby, 1280, 720).View(), {WindowsAPI::Rectangle(0, 0, 200, 100)});
+    index.AddSample(L"设置", Render(kSettings, 1280, 720).View());
+
+    std::vector<std::uint8_t> bytes = index.Serialize();
+    auto restored = StateIndex::Deserialize(bytes.data(), bytes.size());
+    ASSERT_TRUE(restored.IsSuccess());
+    const StateIndex& copy = restored.GetData();
+    EXPECT_EQ(copy.GetTilesX(), 12);
+    EXPECT_EQ(copy.GetTilesY(), 6);
+    EXPECT_EQ(copy.GetStateCount(), 3);
+    EXPECT_EQ(copy.GetStateName(2), L"设置");
+    EXPECT_EQ(copy.Serialize(), bytes);
+
+    const std::vector<Panel>* layouts[] = {&kLogin, &kLobby, &kSettings};
+    for (int state = 0; state < 3; state++) {
+        GrayImage query = Render(*layouts[state], 1280, 720, 5, 20 + state);
+        auto a = index.Classify(query.View()).GetData();
+        auto b = copy.Classify(query.View()).GetData();
+        EXPECT_EQ(a.state, state);
+        EXPECT_EQ(b.state, a.state);
+        EXPECT_DOUBLE_EQ(b.matchRatio, a.matchRatio);
+        EXPECT_DOUBLE_EQ(b.confidence, a.confidence);
+    }
+
+    // 截断、多余字节与错误标识都报错
+    for (size_t length = 0; length < bytes.size(); length++) {
+        EXPECT_TRUE(StateIndex::Deserialize(bytes.data(), length).IsError()) << "length " << length;
+    }
+    std::vector<std::uint8_t> longer = bytes;
+    longer.push_back(0);
+    EXPECT_TRUE(StateIndex::Deserialize(longer.data(), longer.size()).IsError());
+    std::vector<std::uint8_t> badMagic = bytes;
+    badMagic[0] = 'X';
+    EXPECT_TRUE(StateIndex::Deserialize(badMagic.data(), badMagic.size()).IsError());
+    EXPECT_TRUE(StateIndex::Deserialize(nullptr, 0).IsError());
+}
+
+TEST(ScreenStateTest, RejectsInvalidInput) {
+    EXPECT_TRUE(StateIndex::Create(0, 8).IsError());
+    EXPECT_TRUE(StateIndex::Create(8, kMaxTiles + 1).IsError());
+
+    StateIndex index;
+    GrayImage small(32, 32);
+    GrayImage screen = Render(kLogin, 640, 360);
+    EXPECT_EQ(index.AddSample(L"small", small.View()).GetErrorCode(), ErrorCode::INVALID_PARAMETER);
+    EXPECT_TRUE(index.AddSample(L"", screen.View()).IsError());
+    EXPECT_TRUE(index.AddSample(L"all", screen.View(), {WindowsAPI::Rectangle(0, 0, 640, 360)}).IsError());
+    EXPECT_EQ(index.GetStateCount(), 0);
+
+    // 空索引：没有最近界面
+    auto empty = index.Classify(screen.View());
+    ASSERT_TRUE(empty.IsSuccess());
+    EXPECT_EQ(empty.GetData().state, -1);
+    EXPECT_EQ(empty.GetData().nearestState, -1);
+
+    // 瓦片数不一致的签名
+    auto signature = ComputeSignature(screen.View(), 4, 4);
+    ASSERT_TRUE(signature.IsSuccess());
+    EXPECT_TRUE(index.Classify(signature.GetData()).IsError());
+}
@@ -0,0 +1,229 @@
+#include <gtest/gtest.h>
+#include "../DataLayer/include/ScrollMotion.h"
+#include "TestUtils.h"
+
+#include <random>
+#include <vector>
+
+using namespace ScrollMotion;
+using TestUtils::GrayImage;
+
+namespace {
+
+// 从第 y 行起、高 h 的视口
+ImageView Viewport(const GrayImage& image, int y, int h) {
+    return image.View().Subview(WindowsAPI::Rectangle(0, y, image.width, y + h));
+}
+
+// 类似网页/列表的长文档：白底上每 20 行一行"文字"（随机宽度的深色块）
+GrayImage MakeDocument(int width, int height, unsigned seed) {
+    std::mt19937 rng(seed);
+    GrayImage doc(width, height, 255);
+    for (int line = 0; line + 20 <= height; line += 20) {
+        int x = 8 + static_cast<int>(rng() % 24);
+        while (x < width - 16) {
+            int glyph = 4 + static_cast<int>(rng() % 9);
+            int top = line + 4 + static_cast<int>(rng() % 4);
+            int bottom = line + 12 + static_cast<int>(rng() % 5);
+            std::uint8_t ink = static_cast<std::uint8_t>(rng() % 90);
+            for (int y = top; y < bottom; y++) {
+                for (int gx = x; gx < std::min(width, x + glyph); gx++) {
+                    doc.pixels[static_cast<size_t>(y) * width + gx] = ink;
+                }
+            }
+            x += glyph + 2 + static_cast<int>(rng() % 6) * (rng() % 5 == 0 ? 3 : 1);
+        }
+    }
+    return doc;
+}
+
+// 二维随机纹理：6x6 的随机灰度块叠加噪声，类似地图或画布（横向与双向位移）
+GrayImage MakeTexture(int width, int height, unsigned seed) {
+    std::mt19937 rng(seed);
+    const int cellsX = width / 6 + 1;
+    std::vector<std::uint8_t> cells(static_cast<size_t>(cellsX) * (height / 6 + 1));
+    for (auto& cell : cells) {
+        cell = static_cast<std::uint8_t>(rng() % 200);
+    }
+    GrayImage image(width, height, 255);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            image.pixels[static_cast<size_t>(y) * width + x] =
+                static_cast<std::uint8_t>(cells[static_cast<size_t>(y / 6) * cellsX + x / 6] + rng() % 24);
+        }
+    }
+    return image;
+}
+
+// 视图复制为自有图像，可选地在顶部叠加固定标题栏
+GrayImage Copy(const ImageView& view, int headerHeight = 0) {
+    GrayImage image(view.width, view.height, 255);
+    for (int y = 0; y < view.height; y++) {
+        for (int x = 0; x < view.width; x++) {
+            image.pixels[static_cast<size_t>(y) * view.width + x] = y < headerHeight ? 60 : view.Row(y)[x];
+        }
+    }
+    return image;
+}
+
+std::vector<std::uint8_t> ToBgra(const ImageView& gray) {
+    std::vector<std::uint8_t> bgra(static_cast<size_t>(gray.width) * gray.height * 4);
+    for (int y = 0; y < gray.height; y++) {
+        for (int x = 0; x < gray.width; x++) {
+            std::uint8_t* p = &bgra[(static_cast<size_t>(y) * gray.width + x) * 4];
+            p[0] = p[1] = p[2] = gray.Row(y)[x];
+            p[3] = 255;
+        }
+    }
+    return bgra;
+}
+
+}  // namespace
+
+TEST(ScrollMotionTest, EstimatesVerticalShift) {
+    GrayImage doc = MakeDocument(480, 1200, 1);
+    for (int shift : {1, 20, 137, 300}) {
+        auto down = Estimate(Viewport(doc, 100, 400), Viewport(doc, 100 + shift, 400));
+        ASSERT_TRUE(down.IsSuccess());
+        EXPECT_EQ(down.GetData().dy, -shift);
+        EXPECT_EQ(down.GetData().dx, 0);
+        EXPECT_EQ(down.GetData().error, 0.0);
+        EXPECT_GT(down.GetData().confidence, 0.3) << shift;
+
+        auto up = Estimate(Viewport(doc, 100 + shift, 400), Viewport(doc, 100, 400));
+        ASSERT_TRUE(up.IsSuccess());
+        EXPECT_EQ(up.GetData().dy, shift);
+    }
+
+    // 没有移动
+    EXPECT_EQ(Estimate(Viewport(doc, 0, 300), Viewport(doc, 0, 300)).GetData().dy, 0);
+
+    // BGRA 输入
+    std::vector<std::uint8_t> a = ToBgra(Viewport(doc, 0, 400));
+    std::vector<std::uint8_t> b = ToBgra(Viewport(doc, 77, 400));
+    auto bgra = Estimate(ImageView(a.data(), 480, 400, 480 * 4, PixelFormat::BGRA32),
+                         ImageView(b.data(), 480, 400, 480 * 4, PixelFormat::BGRA32));
+    ASSERT_TRUE(bgra.IsSuccess());
+    EXPECT_EQ(bgra.GetData().dy, -77);
+}
+
+TEST(ScrollMotionTest, EstimatesHorizontalAndDiagonalShift) {
+    GrayImage texture = MakeTexture(700, 500, 2);
+    ImageView base = texture.View().Subview(WindowsAPI::Rectangle(100, 100, 500, 400));
+    ImageView right = texture.View().Subview(WindowsAPI::Rectangle(123, 100, 523, 400));
+    ImageView diagonal = texture.View().Subview(WindowsAPI::Rectangle(77, 141, 477, 441));
+
+    MotionOptions options;
+    options.axis = Axis::HORIZONTAL;
+    auto horizontal = Estimate(base, right, options);
+    ASSERT_TRUE(horizontal.IsSuccess());
+    EXPECT_EQ(horizontal.GetData().dx, -23);
+    EXPECT_EQ(horizontal.GetData().dy, 0);
+
+    options.axis = Axis::BOTH;
+    auto both = Estimate(base, diagonal, options);
+    ASSERT_TRUE(both.IsSuccess());
+    EXPECT_EQ(both.GetData().dx, 23);
+    EXPECT_EQ(both.GetData().dy, -41);
+    EXPECT_EQ(both.GetData().error, 0.0);
+
+    // 限制最大位移后找不到真实位移，误差明显大于 0
+    options.maxShift = 10;
+    EXPECT_GT(Estimate(base, diagonal, options).GetData().error, 10.0);
+}
+
+TEST(ScrollMotionTest, RegionExcludesFixedHeader) {
+    GrayImage doc = MakeDocument(400, 1000, 3);
+    GrayImage first = Copy(Viewport(doc, 0, 360), 48);
+    GrayImage second = Copy(Viewport(doc, 95, 360), 48);
+
+    MotionOptions options;
+    options.region = WindowsAPI::Rectangle(0, 48, 400, 360);
+    auto motion = Estimate(first.View(), second.View(), options);
+    ASSERT_TRUE(motion.IsSuccess());
+    EXPECT_EQ(motion.GetData().dy, -95);
+    EXPECT_EQ(motion.GetData().error, 0.0);
+}
+
+TEST(ScrollMotionTest, UniformContentHasNoConfidence) {
+    GrayImage blank(320, 240, 255);
+    auto motion = Estimate(blank.View(), blank.View());
+    ASSERT_TRUE(motion.IsSuccess());
+    EXPECT_EQ(motion.GetData().dy, 0);
+    EXPECT_EQ(motion.GetData().confidence, 0.0);
+}
+
+TEST(ScrollMotionTest, StitcherRebuildsDocument) {
+    GrayImage doc = MakeDocument(360, 2400, 4);
+    std::vector<std::uint8_t> bgra = ToBgra(doc.View());
+    ImageView docView(bgra.data(), 360, 2400, 360 * 4, PixelFormat::BGRA32);
+    const int viewport = 300;
+
+    // 带固定标题栏的窗口，只拼接标题栏下方的滚动区域；中途回滚一次
+    StitchOptions options;
+    options.motion.region = WindowsAPI::Rectangle(0, 40, 360, 40 + viewport);
+    Stitcher stitcher(options);
+    std::vector<std::uint8_t> frame(static_cast<size_t>(360) * (viewport + 40) * 4, 0);
+    const int offsets[] = {0, 180, 400, 330, 560, 800, 1050, 1290, 1500, 1750, 2000, 2100};
+    for (int offset : offsets) {
+        for (int y = 0; y < viewport; y++) {
+            std::copy_n(docView.Row(offset + y), 360 * 4, &frame[static_cast<size_t>(y + 40) * 360 * 4]);
+        }
+        auto motion = stitcher.Append(ImageView(frame.data(), 360, viewport + 40, 360 * 4, PixelFormat::BGRA32));
+        ASSERT_TRUE(motion.IsSuccess()) << offset;
+        EXPECT_EQ(stitcher.GetViewTop(), offset);
+    }
+    EXPECT_EQ(stitcher.GetFrameCount(), 12);
+
+    const ImageData& image = stitcher.GetImage();
+    ASSERT_EQ(image.width, 360);
+    ASSERT_EQ(image.height, 2100 + viewport);
+    EXPECT_EQ(image.format, PixelFormat::BGRA32);
+    for (int y = 0; y < image.height; y++) {
+        ASSERT_TRUE(std::equal(docView.Row(y), docView.Row(y) + 360 * 4, &image.data[static_cast<size_t>(y) * image.stride]))
+            << "row " << y;
+    }
+
+    ImageData taken = stitcher.TakeImage();
+    EXPECT_EQ(taken.height, 2100 + viewport);
+    EXPECT_EQ(stitcher.GetFrameCount(), 0);
+}
+
+TEST(ScrollMotionTest, StitcherRejectsUnrelatedFrames) {
+    GrayImage doc = MakeDocument(300, 1200, 5);
+    GrayImage other = MakeTexture(300, 250, 6);
+    Stitcher stitcher;
+    ASSERT_TRUE(stitcher.Append(Viewport(doc, 200, 250)).IsSuccess());
+    ASSERT_TRUE(stitcher.Append(Viewport(doc, 320, 250)).IsSuccess());
+
+    // 无关画面与回滚到起点之上的帧都被拒绝，状态不变
+    EXPECT_EQ(stitcher.Append(other.View()).GetErrorCode(), ErrorCode::OPERATION_FAILED);
+    EXPECT_EQ(stitcher.Append(Viewport(doc, 100, 250)).GetErrorCode(), ErrorCode::OPERATION_FAILED);
+    EXPECT_EQ(stitcher.GetFrameCount(), 2);
+    EXPECT_EQ(stitcher.GetImage().height, 370);
+
+    ASSERT_TRUE(stitcher.Append(Viewport(doc, 500, 250)).IsSuccess());
+    EXPECT_EQ(stitcher.GetImage().height, 550);
+
+    // 尺寸不一致
+    EXPECT_TRUE(stitcher.Append(Viewport(doc, 0, 200)).IsError());
+}
+
+TEST(ScrollMotionTest, RejectsInvalidInput) {
+    GrayImage a(100, 100, 255);
+    GrayImage b(100, 90, 255);
+    EXPECT_EQ(Estimate(a.View(), b.View()).GetErrorCode(), ErrorCode::INVALID_PARAMETER);
+    EXPECT_TRUE(Estimate(ImageView(), a.View()).IsError());
+
+    MotionOptions options;
+    options.region = WindowsAPI::Rectangle(0, 0, 120, 50);
+    EXPECT_TRUE(Estimate(a.View(), a.View(), options).IsError());
+
+    options = MotionOptions();
+    options.minOverlap = 200;
+    EXPECT_TRUE(Estimate(a.View(), a.View(), options).IsError());
+
+    std::vector<std::uint8_t> rgb(100 * 100 * 3);
+    ImageView rgbView(rgb.data(), 100, 100, 300, PixelFormat::RGB24);
+    EXPECT_TRUE(Estimate(rgbView, rgbView).IsError());
+}
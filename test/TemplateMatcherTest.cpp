@@ -0,0 +1,313 @@
+#include <gtest/gtest.h>
+#include "../Common/include/CpuFeatures.h"
+#include "../DataLayer/include/TemplateMatcher.h"
+#include "TestUtils.h"
+
+#include <random>
+#include <vector>
+
+using namespace TemplateMatcher;
+using TestUtils::GrayImage;
+using TestUtils::ForEachSimdLevel;
+
+namespace {
+
+// 生成带纹理的灰度图：随机块再做平滑，保证任意位置的图块都足够独特
+GrayImage MakeTexture(int width, int height, unsigned seed) {
+    std::mt19937 rng(seed);
+    GrayImage noise(width, height);
+    for (auto& p : noise.pixels) {
+        p = static_cast<std::uint8_t>(rng());
+    }
+    GrayImage image(width, height);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            int sum = 0;
+            int count = 0;
+            for (int dy = -1; dy <= 1; dy++) {
+                for (int dx = -1; dx <= 1; dx++) {
+                    int nx = std::min(std::max(x + dx, 0), width - 1);
+                    int ny = std::min(std::max(y + dy, 0), height - 1);
+                    sum += noise.pixels[static_cast<size_t>(ny) * width + nx];
+                    count++;
+                }
+            }
+            image.pixels[static_cast<size_t>(y) * width + x] = static_cast<std::uint8_t>(sum / count);
+        }
+    }
+    return image;
+}
+
+GrayImage Crop(const GrayImage& source, int x, int y, int width, int height) {
+    GrayImage crop(width, height);
+    for (int row = 0; row < height; row++) {
+        std::copy_n(&source.pixels[static_cast<size_t>(y + row) * source.width + x], width,
+                    &crop.pixels[static_cast<size_t>(row) * width]);
+    }
+    return crop;
+}
+
+// 把图块贴到目标图的指定位置
+void Paste(GrayImage& target, const GrayImage& patch, int x, int y) {
+    for (int row = 0; row < patch.height; row++) {
+        std::copy_n(&patch.pixels[static_cast<size_t>(row) * patch.width], patch.width,
+                    &target.pixels[static_cast<size_t>(y + row) * target.width + x]);
+    }
+}
+
+// 圆形掩码：圆内为 255，圆外为 0
+GrayImage MakeDisc(int size) {
+    GrayImage mask(size, size);
+    const int r = size / 2;
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            int dx = x - r;
+            int dy = y - r;
+            mask.pixels[static_cast<size_t>(y) * size + x] = dx * dx + dy * dy < r * r ? 255 : 0;
+        }
+    }
+    return mask;
+}
+
+// 只贴掩码内的像素
+void PasteMasked(GrayImage& target, const GrayImage& patch, const GrayImage& mask, int x, int y) {
+    for (int row = 0; row < patch.height; row++) {
+        for (int col = 0; col < patch.width; col++) {
+            size_t i = static_cast<size_t>(row) * patch.width + col;
+            if (mask.pixels[i]) {
+                target.pixels[static_cast<size_t>(y + row) * target.width + x + col] = patch.pixels[i];
+            }
+        }
+    }
+}
+
+}  // namespace
+
+TEST(TemplateMatcherTest, FindsExactLocationWithEveryMethod) {
+    GrayImage haystack = MakeTexture(320, 200, 1);
+    GrayImage templ = Crop(haystack, 157, 83, 40, 32);
+
+    for (MatchMethod method : {MatchMethod::SAD, MatchMethod::SSD, MatchMethod::NCC}) {
+        for (int levels : {1, 0}) {
+            MatchOptions options;
+            options.method = method;
+            options.pyramidLevels = levels;
+            auto result = FindTemplate(haystack.View(), templ.View(), options);
+            ASSERT_TRUE(result.IsSuccess());
+            ASSERT_EQ(result.GetData().size(), 1u);
+            EXPECT_EQ(result.GetData()[0].location.x, 157);
+            EXPECT_EQ(result.GetData()[0].location.y, 83);
+            EXPECT_NEAR(result.GetData()[0].score, 1.0, 1e-6);
+        }
+    }
+}
+
+TEST(TemplateMatcherTest, ReturnsBestNDistinctMatches) {
+    GrayImage haystack = MakeTexture(400, 300, 2);
+    GrayImage templ = MakeTexture(48, 48, 99);
+    Paste(haystack, templ, 20, 30);
+    Paste(haystack, templ, 300, 200);
+    Paste(haystack, templ, 180, 120);
+
+    MatchOptions options;
+    options.maxResults = 5;
+    options.minScore = 0.95;
+    auto result = FindTemplate(haystack.View(), templ.View(), options);
+    ASSERT_TRUE(result.IsSuccess());
+    const auto& matches = result.GetData();
+    ASSERT_EQ(matches.size(), 3u);
+
+    std::vector<std::pair<int, int>> found;
+    for (const auto& match : matches) {
+        found.emplace_back(match.location.x, match.location.y);
+    }
+    std::sort(found.begin(), found.end());
+    EXPECT_EQ(found[0], std::make_pair(20, 30));
+    EXPECT_EQ(found[1], std::make_pair(180, 120));
+    EXPECT_EQ(found[2], std::make_pair(300, 200));
+}
+
+TEST(TemplateMatcherTest, NccToleratesBrightnessShift) {
+    GrayImage haystack = MakeTexture(200, 160, 3);
+    GrayImage templ = Crop(haystack, 60, 70, 32, 32);
+    for (auto& p : templ.pixels) {
+        p = static_cast<std::uint8_t>(p / 2 + 40);
+    }
+
+    MatchOptions options;
+    options.method = MatchMethod::NCC;
+    auto result = FindTemplate(haystack.View(), templ.View(), options);
+    ASSERT_TRUE(result.IsSuccess());
+    ASSERT_EQ(result.GetData().size(), 1u);
+    EXPECT_EQ(result.GetData()[0].location.x, 60);
+    EXPECT_EQ(result.GetData()[0].location.y, 70);
+    EXPECT_GT(result.GetData()[0].score, 0.99);
+}
+
+TEST(TemplateMatcherTest, AcceptsBgraInput) {
+    GrayImage gray = MakeTexture(120, 90, 4);
+    std::vector<std::uint8_t> bgra(gray.pixels.size() * 4);
+    for (size_t i = 0; i < gray.pixels.size(); i++) {
+        bgra[i * 4] = gray.pixels[i];
+        bgra[i * 4 + 1] = gray.pixels[i];
+        bgra[i * 4 + 2] = gray.pixels[i];
+        bgra[i * 4 + 3] = 255;
+    }
+    ImageView haystack(bgra.data(), 120, 90, 120 * 4, PixelFormat::BGRA32);
+    ImageView templ = haystack.Subview(WindowsAPI::Rectangle(50, 40, 74, 64));
+
+    auto result = FindTemplate(haystack, templ);
+    ASSERT_TRUE(result.IsSuccess());
+    ASSERT_EQ(result.GetData().size(), 1u);
+    EXPECT_EQ(result.GetData()[0].location.x, 50);
+    EXPECT_EQ(result.GetData()[0].location.y, 40);
+}
+
+TEST(TemplateMatcherTest, SimdLevelsAgree) {
+    GrayImage haystack = MakeTexture(257, 131, 5);
+    GrayImage templ = Crop(haystack, 101, 47, 37, 29);
+
+    for (MatchMethod method : {MatchMethod::SAD, MatchMethod::SSD, MatchMethod::NCC}) {
+        MatchOptions options;
+        options.method = method;
+        options.pyramidLevels = 1;
+        options.minScore = -1.0;
+        options.maxResults = 8;
+
+        CpuFeatures::SetMaxSimdLevel(CpuFeatures::SimdLevel::SCALAR);
+        auto expected = FindTemplate(haystack.View(), templ.View(), options).GetData();
+        ForEachSimdLevel([&]() {
+            auto actual = FindTemplate(haystack.View(), templ.View(), options).GetData();
+            ASSERT_EQ(actual.size(), expected.size());
+            for (size_t i = 0; i < actual.size(); i++) {
+                EXPECT_EQ(actual[i].location.x, expected[i].location.x);
+                EXPECT_EQ(actual[i].location.y, expected[i].location.y);
+                EXPECT_NEAR(actual[i].score, expected[i].score, 1e-6);
+            }
+        });
+    }
+}
+
+TEST(TemplateMatcherTest, MinScoreFiltersWeakMatches) {
+    GrayImage haystack = MakeTexture(160, 120, 6);
+    GrayImage templ = MakeTexture(24, 24, 7);
+
+    MatchOptions options;
+    options.minScore = 0.9;
+    auto result = FindTemplate(haystack.View(), templ.View(), options);
+    ASSERT_TRUE(result.IsSuccess());
+    EXPECT_TRUE(result.GetData().empty());
+}
+
+TEST(TemplateMatcherTest, RejectsInvalidInput) {
+    GrayImage haystack = MakeTexture(32, 32, 8);
+    GrayImage big = MakeTexture(40, 10, 9);
+    EXPECT_EQ(FindTemplate(haystack.View(), big.View()).GetErrorCode(), ErrorCode::INVALID_PARAMETER);
+    EXPECT_TRUE(FindTemplate(ImageView(), haystack.View()).IsError());
+
+    MatchOptions options;
+    options.maxResults = 0;
+    EXPECT_TRUE(FindTemplate(haystack.View(), haystack.View(), options).IsError());
+}
+
+TEST(TemplateMatcherTest, MaskIgnoresPixelsOutsideShape) {
+    GrayImage haystack = MakeTexture(300, 200, 11);
+    GrayImage icon = MakeTexture(40, 40, 12);
+    GrayImage mask = MakeDisc(40);
+    PasteMasked(haystack, icon, mask, 130, 70);
+
+    for (MatchMethod method : {MatchMethod::SAD, MatchMethod::SSD, MatchMethod::NCC}) {
+        for (int levels : {1, 0}) {
+            MatchOptions options;
+            options.method = method;
+            options.pyramidLevels = levels;
+            auto result = FindTemplate(haystack.View(), icon.View(), mask.View(), options);
+            ASSERT_TRUE(result.IsSuccess());
+            ASSERT_EQ(result.GetData().size(), 1u);
+            EXPECT_EQ(result.GetData()[0].location.x, 130);
+            EXPECT_EQ(result.GetData()[0].location.y, 70);
+            EXPECT_NEAR(result.GetData()[0].score, 1.0, 1e-6);
+        }
+    }
+
+    // 不使用掩码时圆外的背景拉低得分
+    MatchOptions options;
+    options.minScore = -1.0;
+    auto unmasked = FindTemplate(haystack.View(), icon.View(), options);
+    ASSERT_TRUE(unmasked.IsSuccess());
+    EXPECT_LT(unmasked.GetData()[0].score, 0.95);
+}
+
+TEST(TemplateMatcherTest, DerivesMaskFromAlphaChannel) {
+    GrayImage haystack = MakeTexture(200, 150, 13);
+    GrayImage icon = MakeTexture(32, 32, 14);
+    GrayImage mask = MakeDisc(32);
+    PasteMasked(haystack, icon, mask, 61, 47);
+
+    // 透明像素的颜色是任意值
+    std::vector<std::uint8_t> bgra(icon.pixels.size() * 4);
+    for (size_t i = 0; i < icon.pixels.size(); i++) {
+        std::uint8_t v = mask.pixels[i] ? icon.pixels[i] : static_cast<std::uint8_t>(i * 37);
+        bgra[i * 4] = bgra[i * 4 + 1] = bgra[i * 4 + 2] = v;
+        bgra[i * 4 + 3] = mask.pixels[i] ? 255 : 0;
+    }
+    ImageView templ(bgra.data(), 32, 32, 32 * 4, PixelFormat::BGRA32);
+
+    MatchOptions options;
+    options.useAlphaMask = true;
+    auto result = FindTemplate(haystack.View(), templ, options);
+    ASSERT_TRUE(result.IsSuccess());
+    ASSERT_EQ(result.GetData().size(), 1u);
+    EXPECT_EQ(result.GetData()[0].location.x, 61);
+    EXPECT_EQ(result.GetData()[0].location.y, 47);
+    EXPECT_NEAR(result.GetData()[0].score, 1.0, 1e-6);
+
+    options.useAlphaMask = false;
+    options.minScore = -1.0;
+    EXPECT_LT(FindTemplate(haystack.View(), templ, options).GetData()[0].score, 0.9);
+}
+
+TEST(TemplateMatcherTest, MaskedSimdLevelsAgree) {
+    GrayImage haystack = MakeTexture(203, 117, 15);
+    GrayImage templ = Crop(haystack, 71, 33, 37, 29);
+    GrayImage mask(37, 29);
+    for (size_t i = 0; i < mask.pixels.size(); i++) {
+        mask.pixels[i] = (i * 7) % 5 ? 1 : 0;     // 任意非零值都表示参与匹配
+    }
+
+    for (MatchMethod method : {MatchMethod::SAD, MatchMethod::SSD, MatchMethod::NCC}) {
+        MatchOptions options;
+        options.method = method;
+        options.pyramidLevels = 1;
+        options.minScore = -1.0;
+        options.maxResults = 8;
+
+        CpuFeatures::SetMaxSimdLevel(CpuFeatures::SimdLevel::SCALAR);
+        auto expected = FindTemplate(haystack.View(), templ.View(), mask.View(), options).GetData();
+        ASSERT_FALSE(expected.empty());
+        EXPECT_EQ(expected[0].location.x, 71);
+        EXPECT_EQ(expected[0].location.y, 33);
+        ForEachSimdLevel([&]() {
+            auto actual = FindTemplate(haystack.View(), templ.View(), mask.View(), options).GetData();
+            ASSERT_EQ(actual.size(), expected.size());
+            for (size_t i = 0; i < actual.size(); i++) {
+                EXPECT_EQ(actual[i].location.x, expected[i].location.x);
+                EXPECT_EQ(actual[i].location.y, expected[i].location.y);
+                EXPECT_NEAR(actual[i].score, expected[i].score, 1e-6);
+            }
+        });
+    }
+}
+
+TEST(TemplateMatcherTest, RejectsInvalidMask) {
+    GrayImage haystack = MakeTexture(64, 64, 16);
+    GrayImage templ = MakeTexture(16, 16, 17);
+    GrayImage wrongSize(16, 12);
+    GrayImage empty(16, 16);
+    std::vector<std::uint8_t> rgb(16 * 16 * 3);
+
+    EXPECT_EQ(FindTemplate(haystack.View(), templ.View(), wrongSize.View()).GetErrorCode(),
+              ErrorCode::INVALID_PARAMETER);
+    EXPECT_TRUE(FindTemplate(haystack.View(), templ.View(), empty.View()).IsError());
+    EXPECT_TRUE(FindTemplate(haystack.View(), templ.View(), ImageView(rgb.data(), 16, 16, 48, PixelFormat::RGB24)).IsError());
+}
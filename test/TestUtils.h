@@ -0,0 +1,61 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include "../Common/include/CpuFeatures.h"
+#include "../Common/include/ImageView.h"
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @namespace TestUtils
+ * @brief 各测试共用的灰度图与 SIMD 级别遍历
+ */
+namespace TestUtils {
+
+/**
+ * @brief 紧凑存储的 GRAY8 图像（行跨度等于宽度）
+ */
+struct GrayImage {
+    int width = 0;
+    int height = 0;
+    std::vector<std::uint8_t> pixels;
+
+    GrayImage() = default;
+    GrayImage(int w, int h, std::uint8_t value = 0) : width(w), height(h), pixels(static_cast<size_t>(w) * h, value) {}
+
+    WindowsAPI::ImageView View() const {
+        return WindowsAPI::ImageView(pixels.data(), width, height, width, WindowsAPI::PixelFormat::GRAY8);
+    }
+
+    std::uint8_t& At(int x, int y) { return pixels[static_cast<size_t>(y) * width + x]; }
+    std::uint8_t At(int x, int y) const { return pixels[static_cast<size_t>(y) * width + x]; }
+};
+
+/**
+ * @brief 在每个可用的 SIMD 级别下执行同一段检查，结束后取消限制
+ *
+ * CPU 不支持的级别会被 SetMaxSimdLevel 降到已支持的最高级别，重复的级别只执行一次；
+ * 失败信息带上当前级别名称。
+ */
+template <typename Fn>
+void ForEachSimdLevel(Fn&& fn) {
+    const CpuFeatures::SimdLevel levels[] = {CpuFeatures::SimdLevel::SCALAR, CpuFeatures::SimdLevel::SSE2,
+                                             CpuFeatures::SimdLevel::SSSE3, CpuFeatures::SimdLevel::AVX2};
+    bool first = true;
+    CpuFeatures::SimdLevel previous = CpuFeatures::SimdLevel::SCALAR;
+    for (auto level : levels) {
+        CpuFeatures::SetMaxSimdLevel(level);
+        const CpuFeatures::SimdLevel effective = CpuFeatures::GetSimdLevel();
+        if (!first && effective == previous) {
+            continue;
+        }
+        first = false;
+        previous = effective;
+        SCOPED_TRACE(CpuFeatures::GetSimdLevelName(effective));
+        fn();
+    }
+    CpuFeatures::SetMaxSimdLevel(CpuFeatures::SimdLevel::AVX2);
+}
+
+}  // namespace TestUtils
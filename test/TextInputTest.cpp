@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+#include "../DataLayer/include/TextInput.h"
+
+#include <string>
+#include <vector>
+
+using namespace TextInput;
+using InputDispatcher::EventType;
+
+namespace {
+
+// 由 UTF-16 码元构造文本（wchar_t 为 32 位时同样得到代理项）
+std::wstring Units(std::initializer_list<std::uint32_t> units) {
+    std::wstring text;
+    for (std::uint32_t unit : units) {
+        text.push_back(static_cast<wchar_t>(unit));
+    }
+    return text;
+}
+
+std::vector<std::uint32_t> CharCodes(const TextPlan& plan) {
+    std::vector<std::uint32_t> codes;
+    for (const InputEvent& event : plan.events) {
+        if (event.type == EventType::CHAR) {
+            codes.push_back(event.code);
+        }
+    }
+    return codes;
+}
+
+TextOptions Mode(TextMode mode, int chunkSize = 256) {
+    TextOptions options;
+    options.mode = mode;
+    options.chunkSize = chunkSize;
+    return options;
+}
+
+}  // namespace
+
+TEST(TextInputTest, EncodesSurrogatePairsAndRejectsUnpaired) {
+    // U+1F600 的代理对
+    const std::wstring emoji = L"a" + Units({0xD83D, 0xDE00}) + L"b";
+    auto plan = BuildPlan(emoji);
+    ASSERT_TRUE(plan.IsSuccess());
+    EXPECT_EQ(plan.GetData().characterCount, 3u);
+    EXPECT_EQ(CharCodes(plan.GetData()), (std::vector<std::uint32_t>{L'a', 0xD83D, 0xDE00, L'b'}));
+
+    EXPECT_EQ(BuildPlan(Units({L'a', 0xD83D})).GetErrorCode(), ErrorCode::INVALID_PARAMETER);
+    EXPECT_EQ(BuildPlan(Units({0xD83D, L'a'})).GetErrorCode(), ErrorCode::INVALID_PARAMETER);
+    EXPECT_EQ(BuildPlan(Units({0xDE00, L'a'})).GetErrorCode(), ErrorCode::INVALID_PARAMETER);
+
+    // 32 位 wchar_t 的码位直接编码为代理对
+    if (sizeof(wchar_t) == 4) {
+        auto wide = BuildPlan(Units({0x1F600}));
+        ASSERT_TRUE(wide.IsSuccess());
+        EXPECT_EQ(CharCodes(wide.GetData()), (std::vector<std::uint32_t>{0xD83D, 0xDE00}));
+        EXPECT_EQ(BuildPlan(Units({0x110000})).GetErrorCode(), ErrorCode::INVALID_PARAMETER);
+    }
+
+    auto empty = BuildPlan(L"");
+    ASSERT_TRUE(empty.IsSuccess());
+    EXPECT_TRUE(empty.GetData().events.empty());
+    EXPECT_TRUE(empty.GetData().chunkEnds.empty());
+}
+
+TEST(TextInputTest, MapsNewlinesPerMode) {
+    const std::wstring text = L"a\r\nb\nc\rd\te";
+
+    auto stream = BuildPlan(text, Mode(TextMode::CHAR_STREAM));
+    ASSERT_TRUE(stream.IsSuccess());
+    EXPECT_EQ(CharCodes(stream.GetData()),
+              (std::vector<std::uint32_t>{L'a', L'\r', L'b', L'\r', L'c', L'\r', L'd', L'\t', L'e'}));
+    EXPECT_EQ(stream.GetData().characterCount, 9u);
+
+    auto replace = BuildPlan(text, Mode(TextMode::REPLACE_SELECTION));
+    ASSERT_TRUE(replace.IsSuccess());
+    EXPECT_EQ(replace.GetData().text, L"a\r\nb\r\nc\r\nd\te");
+    EXPECT_TRUE(replace.GetData().events.empty());
+    EXPECT_EQ(replace.GetData().chunkEnds, (std::vector<size_t>{replace.GetData().text.size()}));
+    EXPECT_EQ(replace.GetData().characterCount, 9u);
+}
+
+TEST(TextInputTest, KeyStrokesWrapEachCharacter) {
+    auto plan = BuildPlan(L"aZ1 \n\t" + Units({0xD83D, 0xDE00}) + L"中", Mode(TextMode::KEY_STROKES));
+    ASSERT_TRUE(plan.IsSuccess());
+    const std::vector<InputEvent>& events = plan.GetData().events;
+    // 代理对共用一次按键
+    ASSERT_EQ(events.size(), 8u * 3 + 1);
+
+    const std::uint32_t keys[] = {L'A', L'Z', L'1', L' ', 0x0D, 0x09, kVirtualKeyPacket, kVirtualKeyPacket};
+    size_t index = 0;
+    for (std::uint32_t key : keys) {
+        EXPECT_EQ(events[index].type, EventType::KEY_DOWN);
+        EXPECT_EQ(events[index].code, key);
+        index++;
+        while (events[index].type == EventType::CHAR) {
+            index++;
+        }
+        EXPECT_EQ(events[index].type, EventType::KEY_UP);
+        EXPECT_EQ(events[index].code, key);
+        index++;
+    }
+    EXPECT_EQ(index, events.size());
+    EXPECT_EQ(events[1].code, static_cast<std::uint32_t>(L'a'));
+    EXPECT_EQ(events[13].code, static_cast<std::uint32_t>(L'\r'));
+
+    EXPECT_EQ(VirtualKeyFor(L'q'), static_cast<std::uint32_t>(L'Q'));
+    EXPECT_EQ(VirtualKeyFor(L'\b'), 0x08u);
+    EXPECT_EQ(VirtualKeyFor(L'!'), kVirtualKeyPacket);
+}
+
+TEST(TextInputTest, ChunksNeverSplitCharacterSequences) {
+    // 每块最多 2 个码元：代理对、e + 组合尖音符、ZWJ 连接的表情、国旗（两个区域指示符）各自成块
+    const std::wstring text = L"ab" + Units({0xD83D, 0xDE00}) + L"e" + Units({0x0301}) + L"x"
+                            + Units({0xD83D, 0xDC69, 0x200D, 0xD83D, 0xDCBB})
+                            + Units({0xD83C, 0xDDE8, 0xD83C, 0xDDF3}) + L"yz";
+    auto plan = BuildPlan(text, Mode(TextMode::CHAR_STREAM, 2));
+    ASSERT_TRUE(plan.IsSuccess());
+    const TextPlan& data = plan.GetData();
+    EXPECT_EQ(data.events.size(), text.size());
+    EXPECT_EQ(data.chunkEnds, (std::vector<size_t>{2, 4, 6, 7, 12, 16, 18}));
+
+    // 块边界不落在低代理项、组合符号或 ZWJ 之后
+    for (size_t end : data.chunkEnds) {
+        if (end < data.events.size()) {
+            const std::uint32_t next = data.events[end].code;
+            EXPECT_FALSE(next >= 0xDC00 && next <= 0xDFFF) << "chunk end " << end;
+            EXPECT_NE(next, 0x0301u);
+            EXPECT_NE(data.events[end - 1].code, 0x200Du);
+        }
+    }
+
+    // 谚文字母与组合用浊点附着在前一个字符上
+    auto jamo = BuildPlan(Units({0x1100, 0x1161, 0x11A8, 0x304B, 0x3099}), Mode(TextMode::CHAR_STREAM, 1));
+    ASSERT_TRUE(jamo.IsSuccess());
+    EXPECT_EQ(jamo.GetData().chunkEnds, (std::vector<size_t>{3, 5}));
+
+    // 编辑控件模式按文本分块，\r\n 不拆开
+    auto replace = BuildPlan(L"abc\ndef", Mode(TextMode::REPLACE_SELECTION, 4));
+    ASSERT_TRUE(replace.IsSuccess());
+    EXPECT_EQ(replace.GetData().chunkEnds, (std::vector<size_t>{3, 7, 8}));
+}
+
+TEST(TextInputTest, SetTextIsSingleChunk) {
+    std::wstring text(5000, L'x');
+    auto plan = BuildPlan(text, Mode(TextMode::SET_TEXT, 16));
+    ASSERT_TRUE(plan.IsSuccess());
+    EXPECT_EQ(plan.GetData().chunkEnds, (std::vector<size_t>{5000}));
+
+    // 空文本也发送一次（清空控件）
+    auto empty = BuildPlan(L"", Mode(TextMode::SET_TEXT));
+    ASSERT_TRUE(empty.IsSuccess());
+    EXPECT_EQ(empty.GetData().chunkEnds, (std::vector<size_t>{0}));
+
+    // 字符流按块数 = ceil(5000 / 16)
+    auto stream = BuildPlan(text, Mode(TextMode::CHAR_STREAM, 16));
+    ASSERT_TRUE(stream.IsSuccess());
+    EXPECT_EQ(stream.GetData().chunkEnds.size(), 313u);
+    EXPECT_EQ(stream.GetData().chunkEnds.back(), 5000u);
+}
+
+TEST(TextInputTest, RejectsInvalidOptions) {
+    TextOptions options;
+    options.chunkSize = 0;
+    EXPECT_EQ(BuildPlan(L"a", options).GetErrorCode(), ErrorCode::INVALID_PARAMETER);
+    options = TextOptions();
+    options.chunkDelayMs = -1;
+    EXPECT_EQ(BuildPlan(L"a", options).GetErrorCode(), ErrorCode::INVALID_PARAMETER);
+    options = TextOptions();
+    options.timeoutMs = 0;
+    EXPECT_EQ(BuildPlan(L"a", options).GetErrorCode(), ErrorCode::INVALID_PARAMETER);
+}
@@ -0,0 +1,41 @@
+#include <gtest/gtest.h>
+#include "../Common/include/ThreadPool.h"
+
+#include <atomic>
+#include <vector>
+
+using namespace WindowsAPI;
+
+TEST(ThreadPoolTest, ParallelForCoversRangeExactlyOnce) {
+    ThreadPool pool(3);
+    std::vector<std::atomic<int>> hits(1000);
+    pool.ParallelFor(0, 1000, [&](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+            hits[i]++;
+        }
+    }, 7);
+    for (const auto& hit : hits) {
+        EXPECT_EQ(hit.load(), 1);
+    }
+}
+
+TEST(ThreadPoolTest, ParallelForWithoutWorkersRunsOnCaller) {
+    ThreadPool pool(0);
+    int total = 0;
+    pool.ParallelFor(5, 15, [&](int begin, int end) { total += end - begin; });
+    EXPECT_EQ(total, 10);
+
+    pool.ParallelFor(3, 3, [&](int, int) { total = -1; });
+    EXPECT_EQ(total, 10);
+}
+
+TEST(ThreadPoolTest, SubmittedTasksRunBeforeDestruction) {
+    std::atomic<int> counter{0};
+    {
+        ThreadPool pool(2);
+        for (int i = 0; i < 50; i++) {
+            pool.Submit([&]() { counter++; });
+        }
+    }
+    EXPECT_EQ(counter.load(), 50);
+}
@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+#include "../ServiceLayer/include/WindowHealth.h"
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace WindowHealth;
+
+namespace {
+
+WindowKey Window(std::uintptr_t id) {
+    return reinterpret_cast<WindowKey>(id);
+}
+
+HealthOptions TestOptions() {
+    HealthOptions options;
+    options.latencyAlpha = 0.5;
+    options.slowLatencyMs = 50.0;
+    options.hungAfterTimeouts = 2;
+    options.retryDelayMs = 100;
+    options.maxRetryDelayMs = 350;
+    return options;
+}
+
+}  // namespace
+
+TEST(WindowHealthTest, TracksLatencyEwmaAndSlowState) {
+    WindowHealthTracker tracker(TestOptions());
+    EXPECT_EQ(tracker.GetHealth(Window(1)).GetErrorCode(), ErrorCode::WINDOW_NOT_FOUND);
+
+    tracker.RecordSuccess(Window(1), 10.0);
+    auto health = tracker.GetHealth(Window(1)).TakeData();
+    EXPECT_DOUBLE_EQ(health.latencyEwmaMs, 10.0);
+    EXPECT_EQ(health.state, HealthState::HEALTHY);
+
+    tracker.RecordSuccess(Window(1), 90.0);
+    health = tracker.GetHealth(Window(1)).TakeData();
+    EXPECT_DOUBLE_EQ(health.latencyEwmaMs, 50.0);
+    EXPECT_DOUBLE_EQ(health.lastLatencyMs, 90.0);
+    EXPECT_EQ(health.state, HealthState::HEALTHY);
+
+    tracker.RecordSuccess(Window(1), 70.0);
+    health = tracker.GetHealth(Window(1)).TakeData();
+    EXPECT_DOUBLE_EQ(health.latencyEwmaMs, 60.0);
+    EXPECT_EQ(health.state, HealthState::SLOW);
+    EXPECT_EQ(health.callCount, 3u);
+
+    // 快速响应后恢复
+    tracker.RecordSuccess(Window(1), 0.0);
+    EXPECT_EQ(tracker.GetHealth(Window(1)).GetData().state, HealthState::HEALTHY);
+    EXPECT_EQ(tracker.Admit(Window(1)), Admission::ALLOW);
+}
+
+TEST(WindowHealthTest, ConsecutiveTimeoutsMarkHungAndShed) {
+    WindowHealthTracker tracker(TestOptions());
+    const Clock::time_point start = Clock::now();
+
+    tracker.RecordTimeout(Window(1), 20.0, false, start);
+    auto health = tracker.GetHealth(Window(1), start).TakeData();
+    EXPECT_EQ(health.state, HealthState::HEALTHY);
+    EXPECT_EQ(health.consecutiveTimeouts, 1);
+
+    // 中间一次成功清零连续超时
+    tracker.RecordSuccess(Window(1), 5.0);
+    tracker.RecordTimeout(Window(1), 20.0, false, start);
+    EXPECT_NE(tracker.GetHealth(Window(1), start).GetData().state, HealthState::HUNG);
+    tracker.RecordTimeout(Window(1), 20.0, false, start);
+    health = tracker.GetHealth(Window(1), start).TakeData();
+    EXPECT_EQ(health.state, HealthState::HUNG);
+    EXPECT_EQ(health.timeoutCount, 3u);
+    EXPECT_EQ(health.retryInMs, 100);
+
+    EXPECT_EQ(tracker.Admit(Window(1), start + std::chrono::milliseconds(40)), Admission::SHED);
+    EXPECT_EQ(tracker.Admit(Window(1), start + std::chrono::milliseconds(99)), Admission::SHED);
+    EXPECT_EQ(tracker.GetHealth(Window(1), start).GetData().shedCount, 2u);
+    EXPECT_EQ(tracker.GetHealth(Window(1), start + std::chrono::milliseconds(40)).GetData().retryInMs, 60);
+
+    // 系统报告挂起时一次超时即标记
+    tracker.RecordTimeout(Window(2), 1.0, true, start);
+    EXPECT_EQ(tracker.GetHealth(Window(2), start).GetData().state, HealthState::HUNG);
+    EXPECT_EQ(tracker.Admit(Window(2), start), Admission::SHED);
+}
+
+TEST(WindowHealthTest, ProbesAfterDelayAndBacksOff) {
+    WindowHealthTracker tracker(TestOptions());
+    const Clock::time_point start = Clock::now();
+    auto at = [&](int ms) { return start + std::chrono::milliseconds(ms); };
+
+    tracker.RecordTimeout(Window(1), 1000.0, true, at(0));
+    EXPECT_EQ(tracker.Admit(Window(1), at(100)), Admission::PROBE);
+    // 探测进行中，其余调用继续拒绝
+    EXPECT_EQ(tracker.Admit(Window(1), at(101)), Admission::SHED);
+
+    // 探测失败：等待加倍到 200，再到 350 封顶
+    tracker.RecordTimeout(Window(1), 1000.0, false, at(150));
+    EXPECT_EQ(tracker.GetHealth(Window(1), at(150)).GetData().retryInMs, 200);
+    EXPECT_EQ(tracker.Admit(Window(1), at(349)), Admission::SHED);
+    EXPECT_EQ(tracker.Admit(Window(1), at(350)), Admission::PROBE);
+    tracker.RecordTimeout(Window(1), 1000.0, false, at(360));
+    EXPECT_EQ(tracker.GetHealth(Window(1), at(360)).GetData().retryInMs, 350);
+    tracker.RecordTimeout(Window(1), 1000.0, false, at(360));
+    EXPECT_EQ(tracker.GetHealth(Window(1), at(360)).GetData().retryInMs, 350);
+
+    // 探测没有记录结果时，下一个周期再放行
+    EXPECT_EQ(tracker.Admit(Window(1), at(710)), Admission::PROBE);
+    EXPECT_EQ(tracker.Admit(Window(1), at(800)), Admission::SHED);
+    EXPECT_EQ(tracker.Admit(Window(1), at(1060)), Admission::PROBE);
+
+    // 探测成功后恢复，等待时间复位
+    tracker.RecordSuccess(Window(1), 2.0);
+    auto health = tracker.GetHealth(Window(1), at(1070)).TakeData();
+    EXPECT_NE(health.state, HealthState::HUNG);
+    EXPECT_EQ(health.consecutiveTimeouts, 0);
+    EXPECT_EQ(health.retryInMs, 0);
+    EXPECT_EQ(tracker.Admit(Window(1), at(1070)), Admission::ALLOW);
+
+    tracker.RecordTimeout(Window(1), 10.0, true, at(2000));
+    EXPECT_EQ(tracker.GetHealth(Window(1), at(2000)).GetData().retryInMs, 100);
+}
+
+TEST(WindowHealthTest, SnapshotOrdersFastestFirst) {
+    WindowHealthTracker tracker(TestOptions());
+    tracker.RecordSuccess(Window(1), 30.0);
+    tracker.RecordSuccess(Window(2), 5.0);
+    tracker.RecordTimeout(Window(3), 1.0, true);
+    tracker.RecordSuccess(Window(4), 80.0);
+    EXPECT_EQ(tracker.GetWindowCount(), 4u);
+
+    auto snapshot = tracker.Snapshot();
+    ASSERT_EQ(snapshot.size(), 4u);
+    EXPECT_EQ(snapshot[0].first, Window(2));
+    EXPECT_EQ(snapshot[1].first, Window(1));
+    EXPECT_EQ(snapshot[2].first, Window(4));
+    EXPECT_EQ(snapshot[2].second.state, HealthState::SLOW);
+    // HUNG 的窗口即使延迟最低也排在最后
+    EXPECT_EQ(snapshot[3].first, Window(3));
+    EXPECT_EQ(snapshot[3].second.state, HealthState::HUNG);
+
+    tracker.Forget(Window(3));
+    EXPECT_EQ(tracker.GetWindowCount(), 3u);
+    EXPECT_TRUE(tracker.GetHealth(Window(3)).IsError());
+}
+
+TEST(WindowHealthTest, ConcurrentRecordsAreCounted) {
+    WindowHealthTracker tracker(TestOptions());
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&tracker, t]() {
+            for (int i = 0; i < 1000; i++) {
+                const WindowKey window = Window(1 + i % 8);
+                if (tracker.Admit(window) != Admission::SHED) {
+                    tracker.RecordSuccess(window, static_cast<double>(t));
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::uint64_t calls = 0;
+    for (const auto& entry : tracker.Snapshot()) {
+        calls += entry.second.callCount;
+        EXPECT_EQ(entry.second.state, HealthState::HEALTHY);
+    }
+    EXPECT_EQ(calls, 4000u);
+}
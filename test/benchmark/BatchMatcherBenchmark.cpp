@@ -0,0 +1,140 @@
+#include "BenchmarkUtils.h"
+#include "../../Common/include/CpuFeatures.h"
+#include "../../Common/include/ThreadPool.h"
+#include "../../DataLayer/include/BatchMatcher.h"
+
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using namespace BatchMatcher;
+
+namespace {
+
+// 合成的 1080p 界面帧：纯色面板、渐变与类似文字的细纹理
+std::vector<std::uint8_t> MakeFrame(int width, int height) {
+    std::mt19937 rng(7);
+    std::vector<std::uint8_t> frame(static_cast<size_t>(width) * height * 4);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            std::uint8_t v;
+            if (y < 60) {
+                v = 45;                                                    // 标题栏
+            } else if (x < 320) {
+                v = static_cast<std::uint8_t>(200 + (y % 40 < 2 ? -60 : 0));  // 侧边列表
+            } else if ((y / 18) % 3 == 0 && (x / 7) % 5 != 4) {
+                v = static_cast<std::uint8_t>(rng() % 2 ? 30 : 235);       // 文字行
+            } else {
+                v = static_cast<std::uint8_t>(180 + x * 60 / width);       // 渐变背景
+            }
+            std::uint8_t* p = &frame[(static_cast<size_t>(y) * width + x) * 4];
+            p[0] = p[1] = p[2] = v;
+            p[3] = 255;
+        }
+    }
+    return frame;
+}
+
+// 合成图标：纯色底，叠加几个与底色有明显反差的矩形与圆
+void DrawIcon(std::vector<std::uint8_t>& pixels, int w, int h, std::mt19937& rng) {
+    const int background = static_cast<int>(rng() % 256);
+    std::vector<std::uint8_t> gray(static_cast<size_t>(w) * h, static_cast<std::uint8_t>(background));
+    int shapes = 2 + static_cast<int>(rng() % 3);
+    for (int s = 0; s < shapes; s++) {
+        std::uint8_t v = static_cast<std::uint8_t>((background + 64 + rng() % 128) % 256);
+        int cx = static_cast<int>(rng() % w);
+        int cy = static_cast<int>(rng() % h);
+        int r = 2 + static_cast<int>(rng() % (std::min(w, h) / 2));
+        bool circle = rng() % 2 == 0;
+        for (int y = 0; y < h; y++) {
+            for (int x = 0; x < w; x++) {
+                int dx = x - cx;
+                int dy = y - cy;
+                bool inside = circle ? dx * dx + dy * dy <= r * r : std::abs(dx) <= r && std::abs(dy) <= r / 2;
+                if (inside) {
+                    gray[static_cast<size_t>(y) * w + x] = v;
+                }
+            }
+        }
+    }
+    for (size_t p = 0; p < gray.size(); p++) {
+        pixels[p * 4] = pixels[p * 4 + 1] = pixels[p * 4 + 2] = gray[p];
+        pixels[p * 4 + 3] = 255;
+    }
+}
+
+}  // namespace
+
+int main() {
+    const int width = 1920;
+    const int height = 1080;
+    const int iconCount = 300;
+    std::vector<std::uint8_t> frame = MakeFrame(width, height);
+
+    // 300 个合成图标，6 种尺寸；前 10 个贴到帧中
+    const int sizes[][2] = {{16, 16}, {24, 24}, {32, 32}, {48, 48}, {20, 28}, {64, 24}};
+    std::mt19937 rng(11);
+    std::vector<std::vector<std::uint8_t>> iconPixels;
+    std::vector<ImageView> icons;
+    iconPixels.reserve(iconCount);
+    for (int i = 0; i < iconCount; i++) {
+        int w = sizes[i % 6][0];
+        int h = sizes[i % 6][1];
+        iconPixels.emplace_back(static_cast<size_t>(w) * h * 4);
+        auto& pixels = iconPixels.back();
+        DrawIcon(pixels, w, h, rng);
+        icons.emplace_back(pixels.data(), w, h, w * 4, PixelFormat::BGRA32);
+        if (i < 10) {
+            int x = 400 + i * 140;
+            int y = 200 + (i % 4) * 200;
+            for (int row = 0; row < h; row++) {
+                std::copy_n(&pixels[static_cast<size_t>(row) * w * 4], w * 4,
+                            &frame[(static_cast<size_t>(y + row) * width + x) * 4]);
+            }
+        }
+    }
+    ImageView haystack(frame.data(), width, height, width * 4, PixelFormat::BGRA32);
+
+    std::printf("BatchMatcher benchmark: %d templates in %dx%d BGRA frame, detected SIMD %s, %zu worker threads\n",
+                iconCount, width, height, CpuFeatures::GetSimdLevelName(CpuFeatures::GetDetectedSimdLevel()),
+                WindowsAPI::ThreadPool::GetDefault().GetThreadCount());
+
+    auto compile = Benchmark::Measure(10, [&]() {
+        Benchmark::DoNotOptimize(TemplateSet::Compile(icons));
+    });
+    Benchmark::Report("compile template set", compile);
+
+    auto set = TemplateSet::Compile(icons).TakeData();
+    auto hits = FindAll(haystack, set).TakeData();
+    int found = 0;
+    for (const auto& hit : hits) {
+        found += hit.found ? 1 : 0;
+    }
+    std::printf("%d templates scored >= 0.8 (10 planted)\n\n", found);
+
+    // 目标：300 个模板、1080p 一帧在 10 ms 内
+    const double targetMs = 10.0;
+    for (bool threaded : {false, true}) {
+        BatchOptions options;
+        options.multithreaded = threaded;
+        auto stats = Benchmark::Measure(10, [&]() {
+            Benchmark::DoNotOptimize(FindAll(haystack, set, options));
+        });
+        Benchmark::Report(threaded ? "FindAll 300 templates (thread pool)" : "FindAll 300 templates (serial)", stats);
+        const double medianMs = stats.medianNs / 1e6;
+        std::printf("  vs %.0f ms target: median %.2f ms, %s (%.1fx the target)\n", targetMs, medianMs,
+                    medianMs <= targetMs ? "met" : "MISSED", medianMs / targetMs);
+    }
+
+    // 对照：逐个模板调用单模板搜索（测前 5 个，按 300 个折算）
+    auto single = Benchmark::Measure(3, [&]() {
+        for (int i = 0; i < 5; i++) {
+            Benchmark::DoNotOptimize(TemplateMatcher::FindTemplate(haystack, icons[i]));
+        }
+    });
+    single.medianNs *= iconCount / 5.0;
+    single.minNs *= iconCount / 5.0;
+    single.meanNs *= iconCount / 5.0;
+    Benchmark::Report("FindTemplate x 300 (extrapolated)", single);
+    return 0;
+}
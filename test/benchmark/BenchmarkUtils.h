@@ -0,0 +1,78 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+/**
+ * @namespace Benchmark
+ * @brief 简单的基准测量工具（不依赖第三方基准库）
+ */
+namespace Benchmark {
+
+/**
+ * @brief 单项基准结果（单位：纳秒/次）
+ */
+struct Stats {
+    double medianNs = 0.0;
+    double minNs = 0.0;
+    double meanNs = 0.0;
+};
+
+/**
+ * @brief 防止编译器把基准体优化掉
+ */
+template<typename T>
+inline void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * @brief 重复执行并统计每次耗时
+ * @param iterations 计时次数（另有少量预热）
+ * @param fn 被测函数
+ * @return 统计结果
+ */
+template<typename Fn>
+Stats Measure(int iterations, Fn&& fn) {
+    using Clock = std::chrono::steady_clock;
+
+    for (int i = 0; i < std::max(1, iterations / 10); i++) {
+        fn();
+    }
+
+    std::vector<double> samples;
+    samples.reserve(iterations);
+    double total = 0.0;
+    for (int i = 0; i < iterations; i++) {
+        auto start = Clock::now();
+        fn();
+        auto end = Clock::now();
+        double ns = std::chrono::duration<double, std::nano>(end - start).count();
+        samples.push_back(ns);
+        total += ns;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    Stats stats;
+    stats.medianNs = samples[samples.size() / 2];
+    stats.minNs = samples.front();
+    stats.meanNs = total / iterations;
+    return stats;
+}
+
+/**
+ * @brief 打印一行基准结果
+ */
+inline void Report(const char* name, const Stats& stats) {
+    std::printf("%-48s median %10.2f us   min %10.2f us   mean %10.2f us\n", name,
+                stats.medianNs / 1000.0, stats.minNs / 1000.0, stats.meanNs / 1000.0);
+}
+
+}  // namespace Benchmark
@@ -0,0 +1,87 @@
+#include "BenchmarkUtils.h"
+#include "../../Common/include/CpuFeatures.h"
+#include "../../DataLayer/include/Blobs.h"
+#include "../../DataLayer/include/ColorSearch.h"
+#include "../../Common/include/ThreadPool.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Blobs;
+
+namespace {
+
+// 4K BGRA 画面：灰色背景上随机分布的红色矩形标记
+std::vector<std::uint8_t> MakeMarkers(int width, int height, int count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::vector<std::uint8_t> pixels(static_cast<size_t>(width) * height * 4, 80);
+    for (int i = 0; i < count; i++) {
+        int w = 2 + static_cast<int>(rng() % 40);
+        int h = 2 + static_cast<int>(rng() % 20);
+        int left = static_cast<int>(rng() % (width - w));
+        int top = static_cast<int>(rng() % (height - h));
+        for (int y = top; y < top + h; y++) {
+            for (int x = left; x < left + w; x++) {
+                std::uint8_t* p = &pixels[(static_cast<size_t>(y) * width + x) * 4];
+                p[0] = 20;
+                p[1] = 25;
+                p[2] = 230;
+            }
+        }
+    }
+    return pixels;
+}
+
+}  // namespace
+
+int main() {
+    const int width = 3840;
+    const int height = 2160;
+    std::printf("Blobs benchmark: %dx%d masks, detected SIMD %s\n\n",
+                width, height, CpuFeatures::GetSimdLevelName(CpuFeatures::GetDetectedSimdLevel()));
+
+    std::vector<std::uint8_t> frame = MakeMarkers(width, height, 2000, 1);
+    ImageView image(frame.data(), width, height, width * 4, PixelFormat::BGRA32);
+    ColorSearch::ColorRange red = ColorSearch::ColorRange::FromRgb(230, 25, 20, 20);
+
+    for (bool threaded : {false, true}) {
+        const char* suffix = threaded ? ", threaded" : ", 1 thread";
+        auto mask = Benchmark::Measure(10, [&]() {
+            Benchmark::DoNotOptimize(ColorSearch::CreateMask(image, red, threaded));
+        });
+        Benchmark::Report((std::string("color mask 4K BGRA") + suffix).c_str(), mask);
+    }
+
+    ImageData markerMask = ColorSearch::CreateMask(image, red).TakeData();
+    std::mt19937 rng(2);
+    std::vector<std::uint8_t> noise(static_cast<size_t>(width) * height);
+    for (auto& p : noise) {
+        p = rng() % 100 < 30 ? 255 : 0;
+    }
+    ImageView noiseView(noise.data(), width, height, width, PixelFormat::GRAY8);
+
+    for (bool threaded : {false, true}) {
+        LabelOptions options;
+        options.multithreaded = threaded;
+        options.minArea = 20;
+        const char* suffix = threaded ? ", threaded" : ", 1 thread";
+        auto markers = Benchmark::Measure(20, [&]() {
+            Benchmark::DoNotOptimize(FindBlobs(ImageView(markerMask), options));
+        });
+        Benchmark::Report((std::string("blobs 4K MONO1 markers") + suffix).c_str(), markers);
+
+        auto dense = Benchmark::Measure(5, [&]() {
+            Benchmark::DoNotOptimize(FindBlobs(noiseView, options));
+        });
+        Benchmark::Report((std::string("blobs 4K GRAY8 30% noise (worst case)") + suffix).c_str(), dense);
+    }
+
+    auto blobs = FindBlobs(ImageView(markerMask)).GetData();
+    LabelOptions options;
+    options.connectivity = Connectivity::FOUR;
+    auto noiseBlobs = FindBlobs(noiseView, options).GetData();
+    std::printf("\nmarkers: %zu blobs; 30%% noise: %zu 4-connected blobs; pool threads %zu\n",
+                blobs.size(), noiseBlobs.size(), ThreadPool::GetDefault().GetThreadCount());
+    return 0;
+}
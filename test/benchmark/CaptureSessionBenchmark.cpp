@@ -0,0 +1,93 @@
+#include "BenchmarkUtils.h"
+#include "../../DataLayer/include/CaptureSession.h"
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+using namespace ScreenCapture;
+
+namespace {
+
+// 假后端：每次分配真实的堆内存，Grab时写满整个表面，模拟抓取的内存带宽
+class FakeCaptureBackend : public CaptureBackend {
+public:
+    FakeCaptureBackend(int width, int height) : m_width(width), m_height(height) {}
+
+    Result<WindowsAPI::Rectangle> QuerySourceBounds() override {
+        return Result<WindowsAPI::Rectangle>::Success(WindowsAPI::Rectangle(0, 0, m_width, m_height));
+    }
+
+    Result<CaptureSurface> AllocateSurface(int width, int height) override {
+        m_buffer.reset(new std::uint8_t[static_cast<size_t>(width) * height * 4]);
+        CaptureSurface surface;
+        surface.pixels = m_buffer.get();
+        surface.width = width;
+        surface.height = height;
+        surface.stride = width * 4;
+        return Result<CaptureSurface>::Success(surface);
+    }
+
+    void ReleaseSurface() override { m_buffer.reset(); }
+
+    Result<bool> Grab(const CaptureSurface& surface) override {
+        std::memset(surface.pixels, ++m_frame, static_cast<size_t>(surface.stride) * surface.height);
+        return Result<bool>::Success(true);
+    }
+
+private:
+    int m_width;
+    int m_height;
+    std::uint8_t m_frame = 0;
+    std::unique_ptr<std::uint8_t[]> m_buffer;
+};
+
+// 旧路径：每帧分配表面、抓取，再复制到零初始化的 ImageData 中并释放表面
+ImageData CaptureWithChurn(FakeCaptureBackend& backend, int width, int height) {
+    auto surface = backend.AllocateSurface(width, height).GetData();
+    backend.Grab(surface);
+
+    ImageData image;
+    image.width = width;
+    image.height = height;
+    image.bitsPerPixel = 32;
+    image.stride = width * 4;
+    image.data.resize(static_cast<size_t>(image.stride) * height);
+    std::memcpy(image.data.data(), surface.pixels, image.data.size());
+
+    backend.ReleaseSurface();
+    return image;
+}
+
+void RunForSize(int width, int height, int iterations) {
+    std::printf("\n[%dx%d]\n", width, height);
+
+    FakeCaptureBackend churnBackend(width, height);
+    auto churn = Benchmark::Measure(iterations, [&]() {
+        ImageData image = CaptureWithChurn(churnBackend, width, height);
+        Benchmark::DoNotOptimize(image);
+    });
+    Benchmark::Report("allocate + grab + copy per frame", churn);
+
+    CaptureSession session(std::make_unique<FakeCaptureBackend>(width, height));
+    auto reuse = Benchmark::Measure(iterations, [&]() {
+        auto result = session.Capture();
+        Benchmark::DoNotOptimize(result);
+    });
+    Benchmark::Report("CaptureSession (reused surface)", reuse);
+
+    std::printf("speedup: %.2fx, surface allocations: %llu for %llu frames\n",
+                churn.medianNs / reuse.medianNs,
+                static_cast<unsigned long long>(session.GetStatistics().allocationCount),
+                static_cast<unsigned long long>(session.GetStatistics().frameCount));
+}
+
+}  // namespace
+
+int main() {
+    std::printf("CaptureSession benchmark (fake backend)\n");
+    RunForSize(800, 600, 200);
+    RunForSize(1920, 1080, 100);
+    RunForSize(2560, 1440, 60);
+    return 0;
+}
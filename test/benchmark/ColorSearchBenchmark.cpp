@@ -0,0 +1,92 @@
+#include "BenchmarkUtils.h"
+#include "../../Common/include/CpuFeatures.h"
+#include "../../Common/include/ThreadPool.h"
+#include "../../DataLayer/include/ColorSearch.h"
+
+#include <random>
+#include <vector>
+
+using namespace ColorSearch;
+
+namespace {
+
+// 手写的标量扫描：逐像素比较 ImageData::data
+std::vector<Point> LegacyFindAll(const ImageData& image, std::uint8_t r, std::uint8_t g, std::uint8_t b, int tolerance) {
+    std::vector<Point> hits;
+    for (int y = 0; y < image.height; y++) {
+        for (int x = 0; x < image.width; x++) {
+            const std::uint8_t* p = &image.data[static_cast<size_t>(y) * image.stride + static_cast<size_t>(x) * 4];
+            if (std::abs(p[0] - b) <= tolerance && std::abs(p[1] - g) <= tolerance && std::abs(p[2] - r) <= tolerance) {
+                hits.emplace_back(x, y);
+            }
+        }
+    }
+    return hits;
+}
+
+}  // namespace
+
+int main() {
+    ImageData frame;
+    frame.width = 1920;
+    frame.height = 1080;
+    frame.bitsPerPixel = 32;
+    frame.stride = frame.width * 4;
+    frame.data.resize(static_cast<size_t>(frame.stride) * frame.height);
+    std::mt19937 rng(7);
+    for (auto& v : frame.data) {
+        v = static_cast<std::uint8_t>(rng() & 0x7F);  // 目标颜色（高亮红）在帧中不存在，测量整帧扫描
+    }
+    ImageView view(frame);
+
+    std::printf("ColorSearch benchmark: %dx%d BGRA frame, detected SIMD %s, %zu worker threads\n",
+                frame.width, frame.height, CpuFeatures::GetSimdLevelName(CpuFeatures::GetDetectedSimdLevel()),
+                WindowsAPI::ThreadPool::GetDefault().GetThreadCount());
+
+    auto legacy = Benchmark::Measure(10, [&]() {
+        Benchmark::DoNotOptimize(LegacyFindAll(frame, 250, 20, 20, 5));
+    });
+    Benchmark::Report("scalar loop over ImageData", legacy);
+
+    ColorRange red = ColorRange::FromRgb(250, 20, 20, 5);
+    HsvRange hsvRed;
+    hsvRed.hueMin = 350;
+    hsvRed.hueMax = 10;
+    hsvRed.saturationMin = 200;
+    hsvRed.valueMin = 200;
+
+    for (auto level : {CpuFeatures::SimdLevel::SCALAR, CpuFeatures::SimdLevel::SSE2, CpuFeatures::SimdLevel::AVX2}) {
+        CpuFeatures::SetMaxSimdLevel(level);
+        const char* levelName = CpuFeatures::GetSimdLevelName(CpuFeatures::GetSimdLevel());
+        for (bool threaded : {false, true}) {
+            SearchOptions options;
+            options.multithreaded = threaded;
+            char name[96];
+
+            auto rgb = Benchmark::Measure(20, [&]() {
+                Benchmark::DoNotOptimize(FindAllColors(view, red, options));
+            });
+            std::snprintf(name, sizeof(name), "FindAllColors RGB (%s, %s)", levelName, threaded ? "pool" : "1 thread");
+            Benchmark::Report(name, rgb);
+
+            auto hsv = Benchmark::Measure(20, [&]() {
+                Benchmark::DoNotOptimize(FindAllColors(view, hsvRed, options));
+            });
+            std::snprintf(name, sizeof(name), "FindAllColors HSV (%s, %s)", levelName, threaded ? "pool" : "1 thread");
+            Benchmark::Report(name, hsv);
+        }
+    }
+
+    // 目标在起点附近时螺旋搜索几乎立即返回
+    frame.data[(static_cast<size_t>(500) * frame.width + 900) * 4 + 2] = 250;
+    frame.data[(static_cast<size_t>(500) * frame.width + 900) * 4 + 1] = 20;
+    frame.data[(static_cast<size_t>(500) * frame.width + 900) * 4 + 0] = 20;
+    SearchOptions spiral;
+    spiral.order = SearchOrder::SPIRAL;
+    spiral.start = Point(910, 510);
+    auto nearby = Benchmark::Measure(1000, [&]() {
+        Benchmark::DoNotOptimize(FindColor(view, red, spiral));
+    });
+    Benchmark::Report("FindColor spiral, hit 10px away", nearby);
+    return 0;
+}
@@ -0,0 +1,96 @@
+#include "BenchmarkUtils.h"
+#include "../../Common/include/CpuFeatures.h"
+#include "../../Common/include/ThreadPool.h"
+#include "../../DataLayer/include/Downscale.h"
+
+#include <random>
+#include <vector>
+
+using namespace Downscale;
+
+namespace {
+
+// 逐像素标量面积平均（浮点权重），作为对照
+void LegacyArea(const ImageView& source, int width, int height, std::vector<std::uint8_t>& out) {
+    double rx = static_cast<double>(source.width) / width;
+    double ry = static_cast<double>(source.height) / height;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            double sum[4] = {0, 0, 0, 0};
+            for (int sy = static_cast<int>(y * ry); sy < static_cast<int>((y + 1) * ry); sy++) {
+                for (int sx = static_cast<int>(x * rx); sx < static_cast<int>((x + 1) * rx); sx++) {
+                    const std::uint8_t* p = source.PixelAt(sx, sy);
+                    for (int c = 0; c < 4; c++) {
+                        sum[c] += p[c];
+                    }
+                }
+            }
+            int count = (static_cast<int>((y + 1) * ry) - static_cast<int>(y * ry)) *
+                        (static_cast<int>((x + 1) * rx) - static_cast<int>(x * rx));
+            for (int c = 0; c < 4; c++) {
+                out[(static_cast<size_t>(y) * width + x) * 4 + c] = static_cast<std::uint8_t>(sum[c] / count + 0.5);
+            }
+        }
+    }
+}
+
+}  // namespace
+
+int main() {
+    const int width = 3840;
+    const int height = 2160;
+    std::vector<std::uint8_t> frame(static_cast<size_t>(width) * height * 4);
+    std::vector<std::uint8_t> grayFrame(static_cast<size_t>(width) * height);
+    std::mt19937 rng(11);
+    for (auto& v : frame) {
+        v = static_cast<std::uint8_t>(rng());
+    }
+    for (auto& v : grayFrame) {
+        v = static_cast<std::uint8_t>(rng());
+    }
+    ImageView bgra(frame.data(), width, height, width * 4, PixelFormat::BGRA32);
+    ImageView gray(grayFrame.data(), width, height, width, PixelFormat::GRAY8);
+
+    std::printf("Downscale benchmark: %dx%d source, detected SIMD %s, %zu worker threads\n",
+                width, height, CpuFeatures::GetSimdLevelName(CpuFeatures::GetDetectedSimdLevel()),
+                WindowsAPI::ThreadPool::GetDefault().GetThreadCount());
+
+    std::vector<std::uint8_t> legacyOut(static_cast<size_t>(854) * 480 * 4);
+    auto legacy = Benchmark::Measure(5, [&]() {
+        LegacyArea(bgra, 854, 480, legacyOut);
+        Benchmark::DoNotOptimize(legacyOut.data());
+    });
+    Benchmark::Report("legacy per-pixel area BGRA 4K->854x480", legacy);
+
+    ImageData output;
+    for (auto level : {CpuFeatures::SimdLevel::SCALAR, CpuFeatures::SimdLevel::SSE2, CpuFeatures::SimdLevel::AVX2}) {
+        CpuFeatures::SetMaxSimdLevel(level);
+        std::printf("\n[%s]\n", CpuFeatures::GetSimdLevelName(CpuFeatures::GetSimdLevel()));
+        for (bool threaded : {false, true}) {
+            DownscaleOptions options;
+            options.multithreaded = threaded;
+            const char* suffix = threaded ? " (threaded)" : "";
+
+            auto area = Benchmark::Measure(20, [&]() {
+                Benchmark::DoNotOptimize(Area(bgra, 854, 480, output, options));
+            });
+            Benchmark::Report((std::string("area BGRA 4K->854x480") + suffix).c_str(), area);
+
+            auto areaGray = Benchmark::Measure(20, [&]() {
+                Benchmark::DoNotOptimize(Area(gray, 854, 480, output, options));
+            });
+            Benchmark::Report((std::string("area Gray8 4K->854x480") + suffix).c_str(), areaGray);
+
+            auto box4 = Benchmark::Measure(20, [&]() {
+                Benchmark::DoNotOptimize(Box(bgra, 4, output, options));
+            });
+            Benchmark::Report((std::string("box 4x BGRA 4K->960x540") + suffix).c_str(), box4);
+
+            auto box2 = Benchmark::Measure(20, [&]() {
+                Benchmark::DoNotOptimize(Box(gray, 2, output, options));
+            });
+            Benchmark::Report((std::string("box 2x Gray8 4K->1920x1080") + suffix).c_str(), box2);
+        }
+    }
+    return 0;
+}
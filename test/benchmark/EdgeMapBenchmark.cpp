@@ -0,0 +1,98 @@
+#include "BenchmarkUtils.h"
+#include "../../Common/include/CpuFeatures.h"
+#include "../../DataLayer/include/EdgeMap.h"
+#include "../../DataLayer/include/TemplateMatcher.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace EdgeMap;
+
+namespace {
+
+// 1080p 灰度界面：随机矩形
+std::vector<std::uint8_t> MakeScene(int width, int height, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::vector<std::uint8_t> pixels(static_cast<size_t>(width) * height, 200);
+    for (int i = 0; i < 1500; i++) {
+        int w = 6 + static_cast<int>(rng() % 80);
+        int h = 6 + static_cast<int>(rng() % 40);
+        int left = static_cast<int>(rng() % (width - w));
+        int top = static_cast<int>(rng() % (height - h));
+        std::uint8_t value = static_cast<std::uint8_t>(40 + rng() % 180);
+        for (int y = top; y < top + h; y++) {
+            std::fill(pixels.begin() + static_cast<size_t>(y) * width + left,
+                      pixels.begin() + static_cast<size_t>(y) * width + left + w, value);
+        }
+    }
+    return pixels;
+}
+
+}  // namespace
+
+int main() {
+    const int width = 1920;
+    const int height = 1080;
+    std::printf("EdgeMap benchmark: %dx%d GRAY8, detected SIMD %s\n\n",
+                width, height, CpuFeatures::GetSimdLevelName(CpuFeatures::GetDetectedSimdLevel()));
+
+    std::vector<std::uint8_t> scene = MakeScene(width, height, 1);
+    ImageView frame(scene.data(), width, height, width, PixelFormat::GRAY8);
+
+    for (auto level : {CpuFeatures::SimdLevel::SCALAR, CpuFeatures::SimdLevel::SSE2, CpuFeatures::SimdLevel::AVX2}) {
+        CpuFeatures::SetMaxSimdLevel(level);
+        const std::string suffix = std::string(" (") + CpuFeatures::GetSimdLevelName(CpuFeatures::GetSimdLevel()) + ")";
+        for (Operator op : {Operator::SOBEL, Operator::SCHARR}) {
+            EdgeOptions options;
+            options.op = op;
+            options.multithreaded = false;
+            auto magnitude = Benchmark::Measure(20, [&]() {
+                Benchmark::DoNotOptimize(ComputeMagnitude(frame, options));
+            });
+            Benchmark::Report((std::string(op == Operator::SOBEL ? "sobel" : "scharr") + " magnitude 1080p" + suffix).c_str(),
+                              magnitude);
+        }
+    }
+    CpuFeatures::SetMaxSimdLevel(CpuFeatures::SimdLevel::AVX2);
+
+    auto gradients = Benchmark::Measure(10, [&]() {
+        Benchmark::DoNotOptimize(ComputeGradients(frame));
+    });
+    Benchmark::Report("sobel magnitude + orientation 1080p", gradients);
+
+    // 64x48 模板：灰度匹配、边缘匹配、带模板缓存的边缘匹配
+    std::vector<std::uint8_t> templPixels(64 * 48);
+    for (int y = 0; y < 48; y++) {
+        std::copy(scene.begin() + static_cast<size_t>(700 + y) * width + 1200,
+                  scene.begin() + static_cast<size_t>(700 + y) * width + 1264, templPixels.begin() + y * 64);
+    }
+    ImageView templ(templPixels.data(), 64, 48, 64, PixelFormat::GRAY8);
+
+    TemplateMatcher::MatchOptions intensity;
+    auto plain = Benchmark::Measure(5, [&]() {
+        Benchmark::DoNotOptimize(TemplateMatcher::FindTemplate(frame, templ, intensity));
+    });
+    Benchmark::Report("match 64x48 intensity", plain);
+
+    TemplateMatcher::MatchOptions edges;
+    edges.features = TemplateMatcher::MatchFeatures::EDGES;
+    auto edgeMatch = Benchmark::Measure(5, [&]() {
+        Benchmark::DoNotOptimize(TemplateMatcher::FindTemplate(frame, templ, edges));
+    });
+    Benchmark::Report("match 64x48 edges", edgeMatch);
+
+    TemplateCache cache;
+    edges.edgeCache = &cache;
+    edges.edgeTemplateId = 0;
+    auto cachedMatch = Benchmark::Measure(5, [&]() {
+        Benchmark::DoNotOptimize(TemplateMatcher::FindTemplate(frame, templ, edges));
+    });
+    Benchmark::Report("match 64x48 edges, cached template", cachedMatch);
+
+    auto found = TemplateMatcher::FindTemplate(frame, templ, edges).TakeData();
+    if (!found.empty()) {
+        std::printf("\nedge match at (%d, %d), score %.3f\n", found[0].location.x, found[0].location.y, found[0].score);
+    }
+    return 0;
+}
@@ -0,0 +1,84 @@
+#include "BenchmarkUtils.h"
+#include "../../Common/include/CpuFeatures.h"
+#include "../../DataLayer/include/FrameDiff.h"
+
+#include <cstring>
+#include <vector>
+
+using namespace FrameDiff;
+
+namespace {
+
+// 逐字节比较的基线（旧做法）
+bool NaiveChanged(const std::vector<std::uint8_t>& a, const std::vector<std::uint8_t>& b) {
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a[i] != b[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace
+
+int main() {
+    const int width = 2560;
+    const int height = 1440;
+    std::printf("FrameDiff benchmark: %dx%d BGRA, detected SIMD %s\n", width, height,
+                CpuFeatures::GetSimdLevelName(CpuFeatures::GetDetectedSimdLevel()));
+
+    std::vector<std::uint8_t> previous(static_cast<size_t>(width) * height * 4);
+    for (size_t i = 0; i < previous.size(); i++) {
+        previous[i] = static_cast<std::uint8_t>((i * 7) >> 3);
+    }
+    std::vector<std::uint8_t> unchanged = previous;
+    std::vector<std::uint8_t> changed = previous;
+    // 模拟一个 200x40 的状态栏变化
+    for (int y = 1380; y < 1420; y++) {
+        std::memset(&changed[(static_cast<size_t>(y) * width + 2200) * 4], 0xFF, 200 * 4);
+    }
+
+    ImageView prevView(previous.data(), width, height, width * 4, PixelFormat::BGRA32);
+    ImageView sameView(unchanged.data(), width, height, width * 4, PixelFormat::BGRA32);
+    ImageView changedView(changed.data(), width, height, width * 4, PixelFormat::BGRA32);
+
+    auto naive = Benchmark::Measure(20, [&]() { Benchmark::DoNotOptimize(NaiveChanged(previous, unchanged)); });
+    Benchmark::Report("naive byte loop (unchanged frame)", naive);
+
+    const CpuFeatures::SimdLevel levels[] = {CpuFeatures::SimdLevel::SCALAR, CpuFeatures::SimdLevel::SSE2,
+                                             CpuFeatures::SimdLevel::AVX2};
+    for (auto level : levels) {
+        if (level > CpuFeatures::GetDetectedSimdLevel()) {
+            continue;
+        }
+        CpuFeatures::SetMaxSimdLevel(level);
+        std::printf("\n[%s]\n", CpuFeatures::GetSimdLevelName(level));
+
+        auto compareSame = Benchmark::Measure(20, [&]() {
+            Benchmark::DoNotOptimize(Compare(prevView, sameView));
+        });
+        Benchmark::Report("Compare (unchanged frame)", compareSame);
+
+        auto compareChanged = Benchmark::Measure(20, [&]() {
+            Benchmark::DoNotOptimize(Compare(prevView, changedView));
+        });
+        Benchmark::Report("Compare (200x40 change)", compareChanged);
+
+        auto hasChangedSame = Benchmark::Measure(20, [&]() {
+            Benchmark::DoNotOptimize(HasChanged(prevView, sameView));
+        });
+        Benchmark::Report("HasChanged (unchanged, full scan)", hasChangedSame);
+
+        // 脏区在帧底部：只检查已知会变化的状态栏区域
+        WindowsAPI::Rectangle statusBar(2200, 1380, 2400, 1420);
+        auto hasChangedRoi = Benchmark::Measure(200, [&]() {
+            Benchmark::DoNotOptimize(HasChanged(prevView.Subview(statusBar), changedView.Subview(statusBar)));
+        });
+        Benchmark::Report("HasChanged (status bar subview)", hasChangedRoi);
+    }
+
+    CpuFeatures::SetMaxSimdLevel(CpuFeatures::SimdLevel::AVX2);
+    auto diff = Compare(prevView, changedView).GetData();
+    std::printf("\ndirty rects: %zu, changed ratio %.5f\n", diff.dirtyRects.size(), diff.changedRatio);
+    return 0;
+}
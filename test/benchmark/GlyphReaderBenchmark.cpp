@@ -0,0 +1,83 @@
+#include "BenchmarkUtils.h"
+#include "../../Common/include/CpuFeatures.h"
+#include "../../DataLayer/include/GlyphReader.h"
+
+#include <string>
+#include <vector>
+
+using namespace GlyphReader;
+
+namespace {
+
+// 5x7 点阵数字，放大 2 倍
+const char* const kDigits[10][7] = {
+    {"01110", "10001", "10011", "10101", "11001", "10001", "01110"},
+    {"00100", "01100", "00100", "00100", "00100", "00100", "01110"},
+    {"01110", "10001", "00001", "00010", "00100", "01000", "11111"},
+    {"11111", "00010", "00100", "00010", "00001", "10001", "01110"},
+    {"00010", "00110", "01010", "10010", "11111", "00010", "00010"},
+    {"11111", "10000", "11110", "00001", "00001", "10001", "01110"},
+    {"00110", "01000", "10000", "11110", "10001", "10001", "01110"},
+    {"11111", "00001", "00010", "00100", "01000", "01000", "01000"},
+    {"01110", "10001", "10001", "01110", "10001", "10001", "01110"},
+    {"01110", "10001", "10001", "01111", "00001", "00010", "01100"},
+};
+
+// 在 BGRA 帧的 (left, top) 处绘制数字串（浅色背景上的深色文字）
+void DrawDigits(std::vector<std::uint8_t>& frame, int frameWidth, int left, int top, const std::wstring& text) {
+    const int scale = 2;
+    int x = left;
+    for (wchar_t c : text) {
+        const auto& rows = kDigits[c - L'0'];
+        for (int r = 0; r < 7; r++) {
+            for (int col = 0; col < 5; col++) {
+                if (rows[r][col] != '1') {
+                    continue;
+                }
+                for (int dy = 0; dy < scale; dy++) {
+                    for (int dx = 0; dx < scale; dx++) {
+                        std::uint8_t* p = &frame[(static_cast<size_t>(top + r * scale + dy) * frameWidth +
+                                                  x + col * scale + dx) * 4];
+                        p[0] = 30;
+                        p[1] = 40;
+                        p[2] = 50;
+                    }
+                }
+            }
+        }
+        x += 6 * scale;
+    }
+}
+
+}  // namespace
+
+int main() {
+    const int width = 1920;
+    const int height = 1080;
+    std::printf("GlyphReader benchmark: 10-digit counter in a %dx%d BGRA frame, detected SIMD %s\n\n",
+                width, height, CpuFeatures::GetSimdLevelName(CpuFeatures::GetDetectedSimdLevel()));
+
+    std::vector<std::uint8_t> frame(static_cast<size_t>(width) * height * 4, 235);
+    DrawDigits(frame, width, 100, 100, L"0123456789");
+    DrawDigits(frame, width, 800, 500, L"4096172835");
+    ImageView view(frame.data(), width, height, width * 4, PixelFormat::BGRA32);
+
+    Font font;
+    font.Learn(view.Subview(WindowsAPI::Rectangle(96, 96, 230, 118)), L"0123456789");
+    ImageView counter = view.Subview(WindowsAPI::Rectangle(790, 494, 940, 520));
+
+    auto learn = Benchmark::Measure(200, [&]() {
+        Font fresh;
+        Benchmark::DoNotOptimize(fresh.Learn(view.Subview(WindowsAPI::Rectangle(96, 96, 230, 118)), L"0123456789"));
+    });
+    Benchmark::Report("learn 10 glyphs", learn);
+
+    auto read = Benchmark::Measure(2000, [&]() {
+        Benchmark::DoNotOptimize(font.Read(counter));
+    });
+    Benchmark::Report("read 10-digit counter (150x26 ROI)", read);
+
+    auto result = font.Read(counter).GetData();
+    std::printf("\nread \"%ls\" (expected \"4096172835\"), confidence %.3f\n", result.text.c_str(), result.confidence);
+    return 0;
+}
@@ -0,0 +1,120 @@
+#include "BenchmarkUtils.h"
+#include "../../Common/include/CpuFeatures.h"
+#include "../../DataLayer/include/InputMacro.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace InputMacro;
+
+namespace {
+
+// 模拟一段真实操作：平滑的鼠标轨迹夹杂点击与按键，约 125 Hz
+std::vector<std::uint8_t> BuildMacro(int eventCount) {
+    Recorder recorder;
+    const Clock::time_point origin = Clock::now();
+    recorder.Start(origin);
+    int x = 400;
+    int y = 300;
+    for (int i = 0; i < eventCount; i++) {
+        const Clock::time_point when = origin + std::chrono::microseconds(i * 8000 + (i * 37) % 900);
+        if (i % 50 == 49) {
+            recorder.Record(InputEvent::KeyDown(0x41 + i % 26), when);
+        } else if (i % 50 == 25) {
+            recorder.Record(InputEvent::ButtonDown(x, y), when);
+        } else {
+            x += (i * 7) % 11 - 5;
+            y += (i * 13) % 9 - 4;
+            recorder.Record(InputEvent::MouseMove(x, y), when);
+        }
+    }
+    return recorder.Serialize();
+}
+
+double Percentile(std::vector<double> values, double p) {
+    std::sort(values.begin(), values.end());
+    return values[static_cast<size_t>(p * (values.size() - 1))];
+}
+
+}  // namespace
+
+int main() {
+    std::printf("InputMacro benchmark: detected SIMD %s, %u hardware threads\n\n",
+                CpuFeatures::GetSimdLevelName(CpuFeatures::GetDetectedSimdLevel()),
+                std::thread::hardware_concurrency());
+
+    const int events = 100000;
+
+    // 录制编码
+    {
+        auto stats = Benchmark::Measure(10, [&]() {
+            auto bytes = BuildMacro(events);
+            Benchmark::DoNotOptimize(bytes);
+        });
+        Benchmark::Report("record + serialize", stats);
+        std::printf("    %.1f ns/event\n", stats.medianNs / events);
+    }
+
+    // 解码与体积（对比每个事件约 60 字节的 JSON 文本）
+    const std::vector<std::uint8_t> bytes = BuildMacro(events);
+    const MacroView view = MacroView::Open(bytes.data(), bytes.size()).TakeData();
+    {
+        std::uint64_t checksum = 0;
+        auto stats = Benchmark::Measure(10, [&]() {
+            MacroView::Cursor cursor(view);
+            TimedEvent timed;
+            while (cursor.Next(timed)) {
+                checksum += timed.timeUs + timed.event.x;
+            }
+        });
+        Benchmark::Report("decode (cursor)", stats);
+        std::printf("    %.1f ns/event, %.2f bytes/event (JSON ~60), checksum %llu\n", stats.medianNs / events,
+                    static_cast<double>(bytes.size() - kHeaderSize) / events, static_cast<unsigned long long>(checksum));
+    }
+
+    // 加载大量宏：打开只检查文件头
+    {
+        const std::string path = "InputMacroBenchmark.macro";
+        Recorder recorder;
+        for (int i = 0; i < 2000; i++) {
+            recorder.Record(InputEvent::MouseMove(i, i));
+        }
+        if (recorder.SaveToFile(path).IsSuccess()) {
+            const int files = 1000;
+            auto stats = Benchmark::Measure(5, [&]() {
+                std::vector<std::shared_ptr<const MappedMacro>> macros;
+                macros.reserve(files);
+                for (int i = 0; i < files; i++) {
+                    auto mapped = MappedMacro::Open(path);
+                    if (mapped.IsSuccess()) {
+                        macros.push_back(std::move(mapped).TakeData());
+                    }
+                }
+                Benchmark::DoNotOptimize(macros);
+            });
+            Benchmark::Report("map 1000 macros (2000 events each)", stats);
+            std::printf("    %.1f us/macro\n", stats.medianNs / files / 1000.0);
+            std::remove(path.c_str());
+        }
+    }
+
+    // 定时精度：纯休眠与休眠 + 自旋
+    for (int spinUs : {0, 2000}) {
+        std::vector<double> lateUs;
+        Clock::time_point deadline = Clock::now();
+        for (int i = 0; i < 300; i++) {
+            deadline += std::chrono::microseconds(1000);
+            SleepUntil(deadline, std::chrono::microseconds(spinUs));
+            lateUs.push_back(std::chrono::duration<double, std::micro>(Clock::now() - deadline).count());
+        }
+        std::printf("%-40s p50 %7.1f us  p90 %7.1f us  p99 %7.1f us\n",
+                    spinUs ? "sleep + 2 ms spin, 1 ms period" : "sleep only, 1 ms period", Percentile(lateUs, 0.5),
+                    Percentile(lateUs, 0.9), Percentile(lateUs, 0.99));
+    }
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include "BenchmarkUtils.h"
+#include "../../Common/include/CpuFeatures.h"
+#include "../../DataLayer/include/MousePath.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include <vector>
+
+using namespace MousePath;
+
+// ============ 分配计数 ============
+
+namespace {
+std::atomic<long long> g_allocations{0};
+}  // namespace
+
+void* operator new(size_t size) {
+    g_allocations++;
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+int main() {
+    std::printf("MousePath benchmark: detected SIMD %s, %u hardware threads\n\n",
+                CpuFeatures::GetSimdLevelName(CpuFeatures::GetDetectedSimdLevel()),
+                std::thread::hardware_concurrency());
+
+    const int paths = 10000;
+
+    // 生成 200 点的轨迹（复用缓冲区）
+    for (Curve curve : {Curve::MINIMUM_JERK, Curve::BEZIER}) {
+        for (double jitter : {0.0, 2.0}) {
+            PathOptions options;
+            options.curve = curve;
+            options.pointCount = 200;
+            options.jitter = jitter;
+            Path path(256);
+            long long allocations = 0;
+            auto stats = Benchmark::Measure(10, [&]() {
+                const long long before = g_allocations;
+                for (int i = 0; i < paths; i++) {
+                    options.seed = static_cast<std::uint32_t>(i + 1);
+                    auto generated = path.Generate(Point(i % 640, 40), Point(1200 - i % 480, 700), options);
+                    Benchmark::DoNotOptimize(generated);
+                }
+                allocations += g_allocations - before;
+            });
+            char name[64];
+            std::snprintf(name, sizeof(name), "generate 200 points, %s%s",
+                          curve == Curve::BEZIER ? "bezier" : "minimum jerk", jitter > 0.0 ? " + jitter" : "");
+            Benchmark::Report(name, stats);
+            std::printf("    %.1f ns/path, %.2f ns/point, %lld allocations\n", stats.medianNs / paths,
+                        stats.medianNs / paths / 200.0, allocations);
+        }
+    }
+
+    // 生成轨迹 + 拖拽事件流（事件缓冲区复用）
+    {
+        PathOptions options;
+        options.pointCount = 200;
+        Path path(256);
+        std::vector<InputEvent> events;
+        events.reserve(256);
+        long long allocations = 0;
+        auto stats = Benchmark::Measure(10, [&]() {
+            const long long before = g_allocations;
+            for (int i = 0; i < paths; i++) {
+                path.Generate(Point(20, 20), Point(820 + i % 100, 620), options);
+                events.clear();
+                AppendDrag(path, MouseButton::LEFT, events);
+                Benchmark::DoNotOptimize(events);
+            }
+            allocations += g_allocations - before;
+        });
+        Benchmark::Report("generate + drag events, 200 points", stats);
+        std::printf("    %.1f ns/drag, %lld allocations\n", stats.medianNs / paths, allocations);
+    }
+    return 0;
+}
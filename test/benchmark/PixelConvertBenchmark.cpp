@@ -0,0 +1,110 @@
+#include "BenchmarkUtils.h"
+#include "../../Common/include/CpuFeatures.h"
+#include "../../DataLayer/include/PixelConvert.h"
+
+#include <random>
+#include <vector>
+
+using namespace PixelConvert;
+
+namespace {
+
+struct Case {
+    const char* name;
+    PixelFormat source;
+    PixelFormat target;  // UNKNOWN 表示 Alpha 预乘
+};
+
+// 逐像素标量写法，作为对照
+void LegacyBgraToRgb(const ImageData& image, std::vector<std::uint8_t>& out) {
+    for (int y = 0; y < image.height; y++) {
+        for (int x = 0; x < image.width; x++) {
+            const std::uint8_t* p = &image.data[static_cast<size_t>(y) * image.stride + static_cast<size_t>(x) * 4];
+            std::uint8_t* d = &out[(static_cast<size_t>(y) * image.width + x) * 3];
+            d[0] = p[2];
+            d[1] = p[1];
+            d[2] = p[0];
+        }
+    }
+}
+
+}  // namespace
+
+int main() {
+    const int width = 1920;
+    const int height = 1080;
+    ImageData bgra;
+    bgra.width = width;
+    bgra.height = height;
+    bgra.bitsPerPixel = 32;
+    bgra.stride = width * 4;
+    bgra.data.resize(static_cast<size_t>(bgra.stride) * height);
+    std::mt19937 rng(3);
+    for (auto& v : bgra.data) {
+        v = static_cast<std::uint8_t>(rng());
+    }
+    std::vector<std::uint8_t> grayPixels(static_cast<size_t>(width) * height);
+    for (auto& v : grayPixels) {
+        v = static_cast<std::uint8_t>(rng());
+    }
+    ImageData rgb565 = Convert(ImageView(bgra), PixelFormat::RGB565).TakeData();
+    std::vector<std::uint8_t> output(static_cast<size_t>(width) * height * 4);
+
+    std::printf("PixelConvert benchmark: %dx%d, detected SIMD %s (throughput counts bytes read + written)\n",
+                width, height, CpuFeatures::GetSimdLevelName(CpuFeatures::GetDetectedSimdLevel()));
+
+    auto reportThroughput = [](const char* name, const Benchmark::Stats& stats, double bytes) {
+        Benchmark::Report(name, stats);
+        std::printf("%-48s %.2f GB/s\n", "", bytes / stats.medianNs);
+    };
+
+    double pixels = static_cast<double>(width) * height;
+    auto legacy = Benchmark::Measure(20, [&]() {
+        LegacyBgraToRgb(bgra, output);
+        Benchmark::DoNotOptimize(output.data());
+    });
+    reportThroughput("legacy per-pixel BGRA->RGB", legacy, pixels * 7);
+
+    const Case cases[] = {
+        {"BGRA->RGB", PixelFormat::BGRA32, PixelFormat::RGB24},
+        {"BGRA->RGBA", PixelFormat::BGRA32, PixelFormat::RGBA32},
+        {"BGRA->Gray8", PixelFormat::BGRA32, PixelFormat::GRAY8},
+        {"Gray8->BGRA", PixelFormat::GRAY8, PixelFormat::BGRA32},
+        {"BGRA->RGB565", PixelFormat::BGRA32, PixelFormat::RGB565},
+        {"RGB565->BGRA", PixelFormat::RGB565, PixelFormat::BGRA32},
+        {"BGRA->Mono1", PixelFormat::BGRA32, PixelFormat::MONO1},
+        {"Gray8->Mono1", PixelFormat::GRAY8, PixelFormat::MONO1},
+        {"premultiply", PixelFormat::BGRA32, PixelFormat::UNKNOWN},
+    };
+
+    for (auto level : {CpuFeatures::SimdLevel::SCALAR, CpuFeatures::SimdLevel::SSSE3, CpuFeatures::SimdLevel::AVX2}) {
+        CpuFeatures::SetMaxSimdLevel(level);
+        std::printf("\n[%s]\n", CpuFeatures::GetSimdLevelName(CpuFeatures::GetSimdLevel()));
+        for (const auto& c : cases) {
+            ImageView source = c.source == PixelFormat::GRAY8
+                ? ImageView(grayPixels.data(), width, height, width, PixelFormat::GRAY8)
+                : c.source == PixelFormat::RGB565 ? ImageView(rgb565) : ImageView(bgra);
+            PixelFormat target = c.target == PixelFormat::UNKNOWN ? PixelFormat::BGRA32 : c.target;
+            int targetStride = GetAlignedStride(width, target);
+            auto stats = Benchmark::Measure(50, [&]() {
+                if (c.target == PixelFormat::UNKNOWN) {
+                    Benchmark::DoNotOptimize(PremultiplyRows(source, output.data(), targetStride));
+                } else {
+                    Benchmark::DoNotOptimize(ConvertRows(source, c.target, output.data(), targetStride));
+                }
+            });
+            reportThroughput(c.name, stats, pixels * (source.BitsPerPixel() + GetBitsPerPixel(target)) / 8);
+        }
+    }
+
+    // 模板缓存的内存占用：5000 个 32x32 图标
+    const int iconCount = 5000;
+    std::printf("\nIcon cache footprint (%d icons, 32x32):\n", iconCount);
+    for (PixelFormat format : {PixelFormat::BGRA32, PixelFormat::RGB565, PixelFormat::GRAY8, PixelFormat::MONO1}) {
+        ImageData icon(32, 32, format);
+        std::printf("  %-8s %8.1f KB\n", format == PixelFormat::BGRA32 ? "BGRA32" : format == PixelFormat::RGB565 ? "RGB565"
+                    : format == PixelFormat::GRAY8 ? "Gray8" : "Mono1",
+                    static_cast<double>(icon.data.size()) * iconCount / 1024.0);
+    }
+    return 0;
+}
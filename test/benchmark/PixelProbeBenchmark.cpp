@@ -0,0 +1,83 @@
+#include "BenchmarkUtils.h"
+#include "../../Common/include/CpuFeatures.h"
+#include "../../DataLayer/include/PixelProbe.h"
+
+#include <vector>
+
+using namespace PixelProbe;
+
+namespace {
+
+// 每次检查单独读取一个像素的旧写法
+bool LegacyCheck(const ImageData& image, int x, int y, std::uint8_t r, std::uint8_t g, std::uint8_t b, int tolerance) {
+    const std::uint8_t* p = &image.data[static_cast<size_t>(y) * image.stride + static_cast<size_t>(x) * 4];
+    return std::abs(p[0] - b) <= tolerance && std::abs(p[1] - g) <= tolerance && std::abs(p[2] - r) <= tolerance;
+}
+
+}  // namespace
+
+int main() {
+    const int width = 1920;
+    const int height = 1080;
+    ImageData frame;
+    frame.width = width;
+    frame.height = height;
+    frame.bitsPerPixel = 32;
+    frame.stride = width * 4;
+    frame.data.assign(static_cast<size_t>(frame.stride) * height, 0);
+    for (size_t i = 0; i < frame.data.size(); i++) {
+        frame.data[i] = static_cast<std::uint8_t>(i * 7);
+    }
+
+    // 20 个探测点散布在窗口右下角的一块 UI 区域
+    std::vector<Probe> probes;
+    for (int i = 0; i < 20; i++) {
+        int x = 1500 + (i % 5) * 37;
+        int y = 800 + (i / 5) * 23;
+        const std::uint8_t* p = &frame.data[static_cast<size_t>(y) * frame.stride + static_cast<size_t>(x) * 4];
+        probes.push_back(Probe::Rgb(x, y, p[2], p[1], p[0], 8));
+    }
+    auto set = PixelProbeSet::Compile(probes).TakeData();
+    const auto& bounds = set.GetBounds();
+
+    std::printf("PixelProbe benchmark: %d probes, bounding box %dx%d in %dx%d frame, detected SIMD %s\n",
+                set.GetProbeCount(), bounds.width(), bounds.height(), width, height,
+                CpuFeatures::GetSimdLevelName(CpuFeatures::GetDetectedSimdLevel()));
+
+    const int iterations = 200000;
+    auto legacy = Benchmark::Measure(iterations, [&]() {
+        std::uint64_t mask = 0;
+        for (int i = 0; i < 20; i++) {
+            const auto& probe = probes[i];
+            if (LegacyCheck(frame, probe.position.x, probe.position.y, probe.color[2], probe.color[1], probe.color[0], 8)) {
+                mask |= 1ull << i;
+            }
+        }
+        Benchmark::DoNotOptimize(mask);
+    });
+    Benchmark::Report("scalar loop over ImageData", legacy);
+
+    ImageView view(frame);
+    for (auto level : {CpuFeatures::SimdLevel::SCALAR, CpuFeatures::SimdLevel::SSE2, CpuFeatures::SimdLevel::AVX2}) {
+        CpuFeatures::SetMaxSimdLevel(level);
+        auto stats = Benchmark::Measure(iterations, [&]() {
+            Benchmark::DoNotOptimize(set.Evaluate(view));
+        });
+        char name[64];
+        std::snprintf(name, sizeof(name), "PixelProbeSet (%s)", CpuFeatures::GetSimdLevelName(CpuFeatures::GetSimdLevel()));
+        Benchmark::Report(name, stats);
+    }
+
+    // 捕获成本按需要复制的像素量估算：整窗口 vs 外接矩形
+    auto fullCopy = Benchmark::Measure(50, [&]() {
+        Benchmark::DoNotOptimize(CopyToImageData(view));
+    });
+    auto boundsCopy = Benchmark::Measure(50000, [&]() {
+        Benchmark::DoNotOptimize(CopyToImageData(view.Subview(bounds)));
+    });
+    Benchmark::Report("copy full window", fullCopy);
+    Benchmark::Report("copy probe bounding box", boundsCopy);
+    std::printf("bounding box is %.2f%% of the window\n",
+                100.0 * bounds.width() * bounds.height() / (static_cast<double>(width) * height));
+    return 0;
+}
@@ -0,0 +1,153 @@
+#include "BenchmarkUtils.h"
+#include "../../DataLayer/include/RegionCapture.h"
+
+#include <cstring>
+#include <vector>
+
+using namespace ScreenCapture;
+
+namespace {
+
+// 模拟的窗口内容：抓取即逐行复制（BitBlt / PrintWindow 的像素搬运都按 memcpy 计，不含 GDI 调用开销）
+struct FakeWindow {
+    int width;
+    int height;
+    std::vector<std::uint8_t> pixels;
+
+    FakeWindow(int w, int h) : width(w), height(h), pixels(static_cast<size_t>(w) * h * 4) {
+        for (size_t i = 0; i < pixels.size(); i++) {
+            pixels[i] = static_cast<std::uint8_t>(i * 31);
+        }
+    }
+
+    // 把源矩形写入目标缓冲，返回移动的字节数
+    size_t Grab(const WindowsAPI::Rectangle& rect, std::uint8_t* dst, int dstStride) const {
+        int rowBytes = rect.width() * 4;
+        for (int y = 0; y < rect.height(); y++) {
+            const std::uint8_t* src = &pixels[(static_cast<size_t>(rect.top + y) * width + rect.left) * 4];
+            std::memcpy(dst + static_cast<size_t>(y) * dstStride, src, rowBytes);
+        }
+        return static_cast<size_t>(rowBytes) * rect.height();
+    }
+};
+
+// 旧路径：每个区域都抓取整个窗口到新分配的 ImageData，再裁剪
+size_t CropAfterFullCapture(const FakeWindow& window, const std::vector<WindowsAPI::Rectangle>& regions,
+                            std::vector<ImageData>& out) {
+    size_t bytesMoved = 0;
+    out.clear();
+    for (const auto& region : regions) {
+        ImageData full;
+        full.width = window.width;
+        full.height = window.height;
+        full.bitsPerPixel = 32;
+        full.stride = window.width * 4;
+        full.data.resize(static_cast<size_t>(full.stride) * full.height);
+        bytesMoved += window.Grab(WindowsAPI::Rectangle(0, 0, window.width, window.height), full.data.data(), full.stride);
+
+        ImageData image;
+        image.width = region.width();
+        image.height = region.height();
+        image.bitsPerPixel = 32;
+        image.stride = image.width * 4;
+        image.data.resize(static_cast<size_t>(image.stride) * image.height);
+        for (int row = 0; row < image.height; row++) {
+            std::memcpy(&image.data[static_cast<size_t>(row) * image.stride],
+                        &full.data[static_cast<size_t>(region.top + row) * full.stride + region.left * 4], image.stride);
+        }
+        bytesMoved += image.data.size();
+        out.push_back(std::move(image));
+    }
+    return bytesMoved;
+}
+
+// CaptureRegions 的 BitBlt 路径：每组只抓取组内区域的外接矩形到组大小的缓冲，再切出各区域
+size_t GroupBlitCapture(const FakeWindow& window, const std::vector<WindowsAPI::Rectangle>& regions,
+                           std::vector<ImageData>& out) {
+    auto plan = PlanRegionCapture(regions, window.width, window.height).GetData();
+    std::vector<std::vector<std::uint8_t>> surfaces;
+    std::vector<ImageView> grabs;
+    size_t bytesMoved = 0;
+    for (const auto& group : plan.groups) {
+        int width = group.bounds.width();
+        int height = group.bounds.height();
+        surfaces.emplace_back(static_cast<size_t>(width) * height * 4);
+        bytesMoved += window.Grab(group.bounds, surfaces.back().data(), width * 4);
+        grabs.emplace_back(surfaces.back().data(), width, height, width * 4, PixelFormat::BGRA32);
+    }
+
+    out = ExtractGroupedRegions(plan, grabs).GetData();
+    for (const auto& image : out) {
+        bytesMoved += image.data.size();
+    }
+    return bytesMoved;
+}
+
+// CaptureRegions 的 PrintWindow 回退路径：整个窗口打印一次到窗口大小的缓冲，再按组切出各区域
+size_t FullPrintCapture(const FakeWindow& window, const std::vector<WindowsAPI::Rectangle>& regions,
+                        std::vector<ImageData>& out) {
+    auto plan = PlanRegionCapture(regions, window.width, window.height).GetData();
+    std::vector<std::uint8_t> surface(static_cast<size_t>(window.width) * window.height * 4);
+    size_t bytesMoved = window.Grab(WindowsAPI::Rectangle(0, 0, window.width, window.height), surface.data(), window.width * 4);
+    ImageView full(surface.data(), window.width, window.height, window.width * 4, PixelFormat::BGRA32);
+    std::vector<ImageView> grabs;
+    for (const auto& group : plan.groups) {
+        grabs.push_back(full.Subview(group.bounds));
+    }
+
+    out = ExtractGroupedRegions(plan, grabs).GetData();
+    for (const auto& image : out) {
+        bytesMoved += image.data.size();
+    }
+    return bytesMoved;
+}
+
+void Compare(const char* title, const FakeWindow& window, const std::vector<WindowsAPI::Rectangle>& regions,
+             int iterations) {
+    std::printf("\n[%s]\n", title);
+    std::vector<ImageData> out;
+
+    size_t oldBytes = CropAfterFullCapture(window, regions, out);
+    auto oldStats = Benchmark::Measure(iterations, [&]() {
+        CropAfterFullCapture(window, regions, out);
+        Benchmark::DoNotOptimize(out);
+    });
+    Benchmark::Report("full capture + crop", oldStats);
+
+    size_t printBytes = FullPrintCapture(window, regions, out);
+    auto printStats = Benchmark::Measure(iterations, [&]() {
+        FullPrintCapture(window, regions, out);
+        Benchmark::DoNotOptimize(out);
+    });
+    Benchmark::Report("PrintWindow fallback (print once + crop)", printStats);
+
+    size_t blitBytes = GroupBlitCapture(window, regions, out);
+    auto blitStats = Benchmark::Measure(iterations, [&]() {
+        GroupBlitCapture(window, regions, out);
+        Benchmark::DoNotOptimize(out);
+    });
+    Benchmark::Report("per-group BitBlt", blitStats);
+
+    std::printf("bytes moved: %zu (old) / %zu (print fallback) / %zu (per-group BitBlt), "
+                "BitBlt vs old %.1fx less, latency speedup %.1fx\n",
+                oldBytes, printBytes, blitBytes, static_cast<double>(oldBytes) / blitBytes,
+                oldStats.medianNs / blitStats.medianNs);
+}
+
+}  // namespace
+
+int main() {
+    std::printf("Region capture benchmark (2560x1440 fake window)\n");
+    FakeWindow window(2560, 1440);
+
+    Compare("single 40x40 icon", window, {WindowsAPI::Rectangle(2400, 60, 2440, 100)}, 50);
+    Compare("4 clustered 40x40 icons", window,
+            {WindowsAPI::Rectangle(2300, 60, 2340, 100), WindowsAPI::Rectangle(2350, 60, 2390, 100),
+             WindowsAPI::Rectangle(2400, 60, 2440, 100), WindowsAPI::Rectangle(2450, 60, 2490, 100)},
+            30);
+    Compare("200x120 panel", window, {WindowsAPI::Rectangle(100, 1200, 300, 1320)}, 50);
+    // 相距较远的区域分组抓取，外接矩形不会退化为整个窗口
+    Compare("2 icons in opposite corners", window,
+            {WindowsAPI::Rectangle(20, 20, 60, 60), WindowsAPI::Rectangle(2500, 1380, 2540, 1420)}, 30);
+    return 0;
+}
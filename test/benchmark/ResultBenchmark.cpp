@@ -0,0 +1,144 @@
+#include "BenchmarkUtils.h"
+#include "../../Common/include/BasicTypes.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+using namespace WindowsAPI;
+
+// ============ 分配计数 ============
+
+namespace {
+std::atomic<long long> g_allocations{0};
+std::atomic<long long> g_allocatedBytes{0};
+}  // namespace
+
+void* operator new(size_t size) {
+    g_allocations++;
+    g_allocatedBytes += static_cast<long long>(size);
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+// 旧版 Result：按值复制载荷，成功路径也构造 std::wstring
+template<typename T>
+class LegacyResult {
+private:
+    ErrorCode errorCode;
+    T data;
+    std::wstring errorMessage;
+
+public:
+    LegacyResult() : errorCode(ErrorCode::SUCCESS) {}
+    LegacyResult(ErrorCode code, const std::wstring& message = L"") : errorCode(code), errorMessage(message) {}
+    LegacyResult(const T& value) : errorCode(ErrorCode::SUCCESS), data(value) {}
+
+    bool IsSuccess() const { return errorCode == ErrorCode::SUCCESS; }
+    const T& GetData() const { return data; }
+    T& GetData() { return data; }
+
+    static LegacyResult<T> Success(const T& value) { return LegacyResult<T>(value); }
+};
+
+// 统计像素缓冲复制次数的图像
+struct CountedImage {
+    static int copies;
+    ImageData image;
+
+    CountedImage() = default;
+    CountedImage(const CountedImage& other) : image(other.image) { copies++; }
+    CountedImage(CountedImage&& other) noexcept = default;
+    CountedImage& operator=(const CountedImage& other) {
+        image = other.image;
+        copies++;
+        return *this;
+    }
+    CountedImage& operator=(CountedImage&& other) noexcept = default;
+};
+
+int CountedImage::copies = 0;
+
+CountedImage Grab(int width, int height) {
+    CountedImage frame;
+    frame.image.width = width;
+    frame.image.height = height;
+    frame.image.bitsPerPixel = 32;
+    frame.image.stride = width * 4;
+    frame.image.data.resize(static_cast<size_t>(frame.image.stride) * height);
+    std::memset(frame.image.data.data(), 0x33, frame.image.data.size());
+    return frame;
+}
+
+// 旧路径：ExtractImageDataFromBitmap 返回 Success(imageData)，调用方再 auto full = r.GetData()
+LegacyResult<CountedImage> LegacyExtract(int width, int height) {
+    CountedImage frame = Grab(width, height);
+    return LegacyResult<CountedImage>::Success(frame);
+}
+
+size_t LegacyCapture(int width, int height) {
+    auto result = LegacyExtract(width, height);
+    auto full = result.GetData();
+    return full.image.data.size();
+}
+
+// 新路径：Success(std::move(imageData))，调用方 TakeData()
+Result<CountedImage> MoveAwareExtract(int width, int height) {
+    CountedImage frame = Grab(width, height);
+    return Result<CountedImage>::Success(std::move(frame));
+}
+
+size_t MoveAwareCapture(int width, int height) {
+    auto result = MoveAwareExtract(width, height);
+    auto full = std::move(result).TakeData();
+    return full.image.data.size();
+}
+
+template<typename Fn>
+void CountOnce(const char* name, Fn&& fn) {
+    CountedImage::copies = 0;
+    long long allocationsBefore = g_allocations;
+    long long bytesBefore = g_allocatedBytes;
+    Benchmark::DoNotOptimize(fn());
+    std::printf("%-30s payload copies %d, allocations %lld, bytes allocated %lld\n", name, CountedImage::copies,
+                g_allocations - allocationsBefore, g_allocatedBytes - bytesBefore);
+}
+
+}  // namespace
+
+int main() {
+    const int width = 1920;
+    const int height = 1080;
+    std::printf("Result<T> benchmark: one %dx%d BGRA capture\n\n", width, height);
+
+    CountOnce("legacy Result (copying)", [&]() { return LegacyCapture(width, height); });
+    CountOnce("move-aware Result", [&]() { return MoveAwareCapture(width, height); });
+
+    std::printf("\n");
+    auto legacy = Benchmark::Measure(100, [&]() { Benchmark::DoNotOptimize(LegacyCapture(width, height)); });
+    Benchmark::Report("legacy Result (copying)", legacy);
+    auto moveAware = Benchmark::Measure(100, [&]() { Benchmark::DoNotOptimize(MoveAwareCapture(width, height)); });
+    Benchmark::Report("move-aware Result", moveAware);
+
+    // 静态描述表在首次使用时构造，之后的错误路径不再分配
+    Benchmark::DoNotOptimize(GetErrorCodeText(ErrorCode::SUCCESS));
+    std::printf("\nerror path without message allocates: ");
+    long long before = g_allocations;
+    auto error = Result<ImageData>::Error(ErrorCode::CAPTURE_FAILED);
+    Benchmark::DoNotOptimize(error.GetErrorMessage());
+    std::printf("%lld allocations\n", g_allocations - before);
+    return 0;
+}
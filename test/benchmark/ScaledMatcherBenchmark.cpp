@@ -0,0 +1,93 @@
+#include "BenchmarkUtils.h"
+#include "../../Common/include/CpuFeatures.h"
+#include "../../DataLayer/include/ScaledMatcher.h"
+#include "../../DataLayer/include/Downscale.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace ScaledMatcher;
+
+namespace {
+
+// 灰度界面：随机矩形
+std::vector<std::uint8_t> MakeScene(int width, int height, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::vector<std::uint8_t> pixels(static_cast<size_t>(width) * height, 200);
+    for (int i = 0; i < 1500; i++) {
+        int w = 6 + static_cast<int>(rng() % 80);
+        int h = 6 + static_cast<int>(rng() % 40);
+        int left = static_cast<int>(rng() % (width - w));
+        int top = static_cast<int>(rng() % (height - h));
+        std::uint8_t value = static_cast<std::uint8_t>(40 + rng() % 180);
+        for (int y = top; y < top + h; y++) {
+            std::fill(pixels.begin() + static_cast<size_t>(y) * width + left,
+                      pixels.begin() + static_cast<size_t>(y) * width + left + w, value);
+        }
+    }
+    return pixels;
+}
+
+}  // namespace
+
+int main() {
+    const int width = 1920;
+    const int height = 1080;
+    std::printf("ScaledMatcher benchmark: %dx%d GRAY8, detected SIMD %s\n\n",
+                width, height, CpuFeatures::GetSimdLevelName(CpuFeatures::GetDetectedSimdLevel()));
+
+    std::vector<std::uint8_t> scene = MakeScene(width, height, 1);
+    ImageView frame(scene.data(), width, height, width, PixelFormat::GRAY8);
+
+    // 帧按 150% 渲染：96x72 为帧中截取的原尺寸模板，参考模板为其缩小到 64x48 的版本
+    auto crop = [&](int left, int top, int w, int h) {
+        std::vector<std::uint8_t> pixels(static_cast<size_t>(w) * h);
+        for (int y = 0; y < h; y++) {
+            std::copy(scene.begin() + static_cast<size_t>(top + y) * width + left,
+                      scene.begin() + static_cast<size_t>(top + y) * width + left + w, pixels.begin() + y * w);
+        }
+        return pixels;
+    };
+    std::vector<std::uint8_t> native = crop(1200, 700, 96, 72);
+    ImageView nativeView(native.data(), 96, 72, 96, PixelFormat::GRAY8);
+    ImageData small;
+    Downscale::Area(nativeView, 64, 48, small);
+
+    ScaledTemplateSet set(1280, 720);
+    std::vector<std::vector<std::uint8_t>> extra;
+    std::mt19937 rng(3);
+    set.Add(ImageView(small));
+    for (int i = 0; i < 63; i++) {
+        extra.push_back(crop(static_cast<int>(rng() % 1800), static_cast<int>(rng() % 1000), 64, 48));
+        set.Add(ImageView(extra.back().data(), 64, 48, 64, PixelFormat::GRAY8));
+    }
+
+    auto prepare = Benchmark::Measure(10, [&]() {
+        set.ClearCache();
+        Benchmark::DoNotOptimize(set.Prepare(1.5));
+    });
+    Benchmark::Report("prepare 64 templates at 150%", prepare);
+
+    TemplateMatcher::MatchOptions options;
+    auto nativeMatch = Benchmark::Measure(5, [&]() {
+        Benchmark::DoNotOptimize(TemplateMatcher::FindTemplate(frame, nativeView, options));
+    });
+    Benchmark::Report("native 96x72 template", nativeMatch);
+
+    auto known = Benchmark::Measure(5, [&]() {
+        Benchmark::DoNotOptimize(set.Find(frame, 0, set.InferScale(WindowsAPI::Rectangle(0, 0, width, height)), options));
+    });
+    Benchmark::Report("cached 64x48 at 150% (known scale)", known);
+
+    ScaleOptions sweep;
+    auto swept = Benchmark::Measure(2, [&]() {
+        Benchmark::DoNotOptimize(set.Locate(frame, 0, 1.0, sweep));
+    });
+    Benchmark::Report("inferred 100% misses, sweep 0.5-2.0", swept);
+
+    auto found = set.Locate(frame, 0, 1.0, sweep).TakeData();
+    std::printf("\nswept scale %.3f at (%d, %d), score %.3f\n", found.scale, found.match.location.x,
+                found.match.location.y, found.match.score);
+    return 0;
+}
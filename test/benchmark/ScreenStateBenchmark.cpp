@@ -0,0 +1,92 @@
+#include "BenchmarkUtils.h"
+#include "../../Common/include/CpuFeatures.h"
+#include "../../DataLayer/include/ScreenState.h"
+
+#include <random>
+#include <vector>
+
+using namespace ScreenState;
+
+namespace {
+
+// 合成界面：随机放置若干纯色或条纹面板的 BGRA 帧
+std::vector<std::uint8_t> MakeScreen(int width, int height, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::vector<std::uint8_t> gray(static_cast<size_t>(width) * height);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            gray[static_cast<size_t>(y) * width + x] = static_cast<std::uint8_t>(80 + x * 80 / width);
+        }
+    }
+    int panels = 4 + static_cast<int>(rng() % 5);
+    for (int p = 0; p < panels; p++) {
+        int w = width / 8 + static_cast<int>(rng() % (width / 2));
+        int h = height / 8 + static_cast<int>(rng() % (height / 2));
+        int left = static_cast<int>(rng() % (width - w));
+        int top = static_cast<int>(rng() % (height - h));
+        std::uint8_t value = static_cast<std::uint8_t>(rng());
+        bool textured = rng() % 2 == 0;
+        for (int y = top; y < top + h; y++) {
+            for (int x = left; x < left + w; x++) {
+                bool stripe = textured && (y / 6) % 3 == 0 && (x / 5) % 4 != 3;
+                gray[static_cast<size_t>(y) * width + x] = stripe ? static_cast<std::uint8_t>(255 - value) : value;
+            }
+        }
+    }
+    std::vector<std::uint8_t> frame(gray.size() * 4);
+    for (size_t i = 0; i < gray.size(); i++) {
+        frame[i * 4] = frame[i * 4 + 1] = frame[i * 4 + 2] = gray[i];
+        frame[i * 4 + 3] = 255;
+    }
+    return frame;
+}
+
+}  // namespace
+
+int main() {
+    const int width = 1920;
+    const int height = 1080;
+    const int stateCount = 200;
+
+    std::printf("ScreenState benchmark: %d states, %dx%d BGRA frame, detected SIMD %s\n",
+                stateCount, width, height, CpuFeatures::GetSimdLevelName(CpuFeatures::GetDetectedSimdLevel()));
+
+    StateIndex index;
+    std::vector<std::uint8_t> query;
+    for (int s = 0; s < stateCount; s++) {
+        std::vector<std::uint8_t> screen = MakeScreen(width, height, 100 + s);
+        index.AddSample(L"state" + std::to_wstring(s), ImageView(screen.data(), width, height, width * 4, PixelFormat::BGRA32));
+        if (s == stateCount / 2) {
+            query = std::move(screen);
+        }
+    }
+    ImageView frame(query.data(), width, height, width * 4, PixelFormat::BGRA32);
+    std::vector<std::uint8_t> bytes = index.Serialize();
+    std::printf("serialized index: %zu bytes\n\n", bytes.size());
+
+    auto signature = Benchmark::Measure(200, [&]() {
+        Benchmark::DoNotOptimize(ComputeSignature(frame));
+    });
+    Benchmark::Report("signature (1080p BGRA)", signature);
+
+    auto tiles = ComputeSignature(frame).TakeData();
+    auto lookup = Benchmark::Measure(200, [&]() {
+        Benchmark::DoNotOptimize(index.Classify(tiles));
+    });
+    Benchmark::Report("lookup 200 states", lookup);
+
+    auto classify = Benchmark::Measure(200, [&]() {
+        Benchmark::DoNotOptimize(index.Classify(frame));
+    });
+    Benchmark::Report("classify frame (signature + lookup)", classify);
+
+    auto load = Benchmark::Measure(50, [&]() {
+        Benchmark::DoNotOptimize(StateIndex::Deserialize(bytes.data(), bytes.size()));
+    });
+    Benchmark::Report("deserialize index", load);
+
+    auto result = index.Classify(frame).GetData();
+    std::printf("\nclassified as %d (expected %d), match ratio %.3f, confidence %.3f\n",
+                result.state, stateCount / 2, result.matchRatio, result.confidence);
+    return 0;
+}
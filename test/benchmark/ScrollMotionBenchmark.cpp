@@ -0,0 +1,96 @@
+#include "BenchmarkUtils.h"
+#include "../../Common/include/CpuFeatures.h"
+#include "../../DataLayer/include/ScrollMotion.h"
+#include "../../DataLayer/include/TemplateMatcher.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace ScrollMotion;
+
+namespace {
+
+// 类似列表/网页的长文档（BGRA）：白底上每 24 行一行随机宽度的深色"文字"
+std::vector<std::uint8_t> MakeDocument(int width, int height, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::vector<std::uint8_t> doc(static_cast<size_t>(width) * height * 4, 255);
+    for (int line = 0; line + 24 <= height; line += 24) {
+        int x = 16 + static_cast<int>(rng() % 40);
+        while (x < width - 24) {
+            int glyph = 5 + static_cast<int>(rng() % 10);
+            int top = line + 5 + static_cast<int>(rng() % 4);
+            int bottom = line + 15 + static_cast<int>(rng() % 5);
+            std::uint8_t ink = static_cast<std::uint8_t>(rng() % 90);
+            for (int y = top; y < bottom; y++) {
+                for (int gx = x; gx < std::min(width, x + glyph); gx++) {
+                    std::uint8_t* p = &doc[(static_cast<size_t>(y) * width + gx) * 4];
+                    p[0] = p[1] = p[2] = ink;
+                }
+            }
+            x += glyph + 2 + static_cast<int>(rng() % 6) * (rng() % 5 == 0 ? 4 : 1);
+        }
+    }
+    return doc;
+}
+
+}  // namespace
+
+int main() {
+    const int width = 1920;
+    const int viewport = 1000;
+    const int docHeight = 12000;
+    const int step = 700;
+
+    std::printf("ScrollMotion benchmark: %dx%d viewport over a %d-row document, detected SIMD %s\n\n",
+                width, viewport, docHeight, CpuFeatures::GetSimdLevelName(CpuFeatures::GetDetectedSimdLevel()));
+
+    std::vector<std::uint8_t> doc = MakeDocument(width, docHeight, 7);
+    ImageView docView(doc.data(), width, docHeight, width * 4, PixelFormat::BGRA32);
+    auto frameAt = [&](int y) { return docView.Subview(WindowsAPI::Rectangle(0, y, width, y + viewport)); };
+
+    for (int shift : {40, 360, step}) {
+        auto estimate = Benchmark::Measure(20, [&]() {
+            Benchmark::DoNotOptimize(Estimate(frameAt(1000), frameAt(1000 + shift)));
+        });
+        Benchmark::Report(("estimate vertical, shift " + std::to_string(shift)).c_str(), estimate);
+    }
+
+    // 对照：滚动后重新匹配——在新截图中查找上一帧底部的 200 行条带
+    TemplateMatcher::MatchOptions match;
+    match.multithreaded = false;
+    auto rematch = Benchmark::Measure(5, [&]() {
+        ImageView strip = frameAt(1000).Subview(WindowsAPI::Rectangle(0, viewport - 200, width, viewport));
+        Benchmark::DoNotOptimize(TemplateMatcher::FindTemplate(frameAt(1000 + step), strip, match));
+    });
+    Benchmark::Report("re-match 200-row strip (TemplateMatcher, 1 thread)", rematch);
+
+    MotionOptions both;
+    both.axis = Axis::BOTH;
+    both.maxShift = 200;
+    auto diagonal = Benchmark::Measure(5, [&]() {
+        Benchmark::DoNotOptimize(Estimate(frameAt(1000), docView.Subview(WindowsAPI::Rectangle(0, 1120, width, 1120 + viewport)),
+                                          both));
+    });
+    Benchmark::Report("estimate both axes (block search)", diagonal);
+
+    // 整个文档按固定步长滚动，增量拼接
+    const int frames = (docHeight - viewport) / step + 1;
+    auto stitch = Benchmark::Measure(3, [&]() {
+        Stitcher stitcher;
+        for (int i = 0; i < frames; i++) {
+            stitcher.Append(frameAt(i * step));
+        }
+        Benchmark::DoNotOptimize(stitcher.GetImage().height);
+    });
+    Benchmark::Report(("stitch " + std::to_string(frames) + " frames").c_str(), stitch);
+
+    Stitcher stitcher;
+    for (int i = 0; i < frames; i++) {
+        stitcher.Append(frameAt(i * step));
+    }
+    std::printf("\nstitched height %d (expected %d), %d frames accepted; per frame %.2f ms\n",
+                stitcher.GetImage().height, (frames - 1) * step + viewport, stitcher.GetFrameCount(),
+                stitch.medianNs / 1e6 / frames);
+    return 0;
+}
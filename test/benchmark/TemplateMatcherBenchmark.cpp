@@ -0,0 +1,129 @@
+#include "BenchmarkUtils.h"
+#include "../../Common/include/CpuFeatures.h"
+#include "../../Common/include/ThreadPool.h"
+#include "../../DataLayer/include/TemplateMatcher.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace TemplateMatcher;
+
+namespace {
+
+// 合成的 1080p BGRA 帧：平滑噪声背景
+std::vector<std::uint8_t> MakeFrame(int width, int height) {
+    std::mt19937 rng(42);
+    std::vector<std::uint8_t> coarse(static_cast<size_t>(width / 4 + 1) * (height / 4 + 1));
+    for (auto& v : coarse) {
+        v = static_cast<std::uint8_t>(rng());
+    }
+    std::vector<std::uint8_t> frame(static_cast<size_t>(width) * height * 4);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            std::uint8_t v = coarse[static_cast<size_t>(y / 4) * (width / 4 + 1) + x / 4];
+            std::uint8_t* p = &frame[(static_cast<size_t>(y) * width + x) * 4];
+            p[0] = v;
+            p[1] = static_cast<std::uint8_t>(v ^ (x & 7));
+            p[2] = static_cast<std::uint8_t>(255 - v);
+            p[3] = 255;
+        }
+    }
+    return frame;
+}
+
+const char* MethodName(MatchMethod method) {
+    switch (method) {
+        case MatchMethod::SAD: return "SAD";
+        case MatchMethod::SSD: return "SSD";
+        default: return "NCC";
+    }
+}
+
+}  // namespace
+
+int main() {
+    const int width = 1920;
+    const int height = 1080;
+    std::vector<std::uint8_t> frame = MakeFrame(width, height);
+    ImageView haystack(frame.data(), width, height, width * 4, PixelFormat::BGRA32);
+    ImageView templ = haystack.Subview(WindowsAPI::Rectangle(1500, 700, 1548, 748));
+
+    std::printf("TemplateMatcher benchmark: 48x48 template in %dx%d BGRA frame, detected SIMD %s, %zu worker threads\n",
+                width, height, CpuFeatures::GetSimdLevelName(CpuFeatures::GetDetectedSimdLevel()),
+                WindowsAPI::ThreadPool::GetDefault().GetThreadCount());
+
+    for (MatchMethod method : {MatchMethod::SAD, MatchMethod::SSD, MatchMethod::NCC}) {
+        std::printf("\n[%s]\n", MethodName(method));
+        for (bool pyramid : {true, false}) {
+            for (bool threaded : {false, true}) {
+                if (!pyramid && method != MatchMethod::SAD) {
+                    continue;  // 不使用金字塔的全图搜索太慢，只测一种度量
+                }
+                MatchOptions options;
+                options.method = method;
+                options.pyramidLevels = pyramid ? 0 : 1;
+                options.multithreaded = threaded;
+                options.minScore = 0.5;
+
+                int iterations = pyramid ? 10 : 2;
+                auto stats = Benchmark::Measure(iterations, [&]() {
+                    Benchmark::DoNotOptimize(FindTemplate(haystack, templ, options));
+                });
+                char name[96];
+                std::snprintf(name, sizeof(name), "%s, %s", pyramid ? "pyramid" : "single level",
+                              threaded ? "thread pool" : "1 thread");
+                Benchmark::Report(name, stats);
+                std::printf("%-48s %.1f matches/s\n", "", 1e9 / stats.medianNs);
+            }
+        }
+    }
+
+    // 掩码匹配：同一模板配圆形 Alpha 掩码，与不带掩码的耗时对比
+    std::vector<std::uint8_t> icon(48 * 48 * 4);
+    for (int y = 0; y < 48; y++) {
+        for (int x = 0; x < 48; x++) {
+            std::uint8_t* p = &icon[(static_cast<size_t>(y) * 48 + x) * 4];
+            std::copy_n(templ.PixelAt(x, y), 4, p);
+            int dx = x - 24;
+            int dy = y - 24;
+            p[3] = dx * dx + dy * dy < 24 * 24 ? 255 : 0;
+        }
+    }
+    ImageView maskedTempl(icon.data(), 48, 48, 48 * 4, PixelFormat::BGRA32);
+    ImageView region = haystack.Subview(WindowsAPI::Rectangle(1200, 540, 1680, 810));
+
+    std::printf("\n[alpha mask, 1 thread]\n");
+    for (MatchMethod method : {MatchMethod::SAD, MatchMethod::SSD, MatchMethod::NCC}) {
+        for (bool pyramid : {true, false}) {
+            MatchOptions options;
+            options.method = method;
+            options.pyramidLevels = pyramid ? 0 : 1;
+            options.multithreaded = false;
+            options.minScore = 0.5;
+            // 单层搜索在 480x270 区域内进行，直接反映行内核的开销
+            const ImageView& target = pyramid ? haystack : region;
+
+            int iterations = pyramid ? 10 : 3;
+            auto plain = Benchmark::Measure(iterations, [&]() {
+                Benchmark::DoNotOptimize(FindTemplate(target, templ, options));
+            });
+            options.useAlphaMask = true;
+            auto masked = Benchmark::Measure(iterations, [&]() {
+                Benchmark::DoNotOptimize(FindTemplate(target, maskedTempl, options));
+            });
+            char name[96];
+            std::snprintf(name, sizeof(name), "%s %s, unmasked", MethodName(method), pyramid ? "pyramid" : "single level");
+            Benchmark::Report(name, plain);
+            std::snprintf(name, sizeof(name), "%s %s, masked", MethodName(method), pyramid ? "pyramid" : "single level");
+            Benchmark::Report(name, masked);
+            std::printf("%-48s %.2fx unmasked\n", "", masked.medianNs / plain.medianNs);
+        }
+    }
+
+    auto check = FindTemplate(haystack, templ).GetData();
+    if (!check.empty()) {
+        std::printf("\nbest match at (%d, %d), score %.4f\n", check[0].location.x, check[0].location.y, check[0].score);
+    }
+    return 0;
+}
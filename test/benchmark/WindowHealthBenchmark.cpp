@@ -0,0 +1,92 @@
+#include "BenchmarkUtils.h"
+#include "../../Common/include/CpuFeatures.h"
+#include "../../ServiceLayer/include/WindowHealth.h"
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace WindowHealth;
+
+namespace {
+
+WindowKey Window(std::uintptr_t id) {
+    return reinterpret_cast<WindowKey>(id);
+}
+
+}  // namespace
+
+int main() {
+    std::printf("WindowHealth benchmark: detected SIMD %s, %u hardware threads\n\n",
+                CpuFeatures::GetSimdLevelName(CpuFeatures::GetDetectedSimdLevel()),
+                std::thread::hardware_concurrency());
+
+    const int calls = 100000;
+
+    // 每次同步调用附加的记录开销：准入 + 记录结果
+    for (int windows : {1, 64, 4096}) {
+        WindowHealthTracker tracker;
+        auto stats = Benchmark::Measure(10, [&]() {
+            for (int i = 0; i < calls; i++) {
+                const WindowKey window = Window(1 + i % windows);
+                if (tracker.Admit(window) != Admission::SHED) {
+                    tracker.RecordSuccess(window, 0.5 + (i & 7));
+                }
+            }
+        });
+        Benchmark::Report(("admit + record, " + std::to_string(windows) + " windows").c_str(), stats);
+        std::printf("    %.1f ns/call\n", stats.medianNs / calls);
+    }
+
+    // 挂起窗口的调用直接拒绝
+    {
+        WindowHealthTracker tracker;
+        tracker.RecordTimeout(Window(1), 1000.0, true);
+        std::uint64_t shed = 0;
+        auto stats = Benchmark::Measure(10, [&]() {
+            for (int i = 0; i < calls; i++) {
+                shed += tracker.Admit(Window(1)) == Admission::SHED;
+            }
+        });
+        Benchmark::Report("admit on hung window (shed)", stats);
+        std::printf("    %.1f ns/call, %llu shed\n", stats.medianNs / calls, static_cast<unsigned long long>(shed));
+    }
+
+    // 调度方读取全部窗口的排序快照
+    for (int windows : {64, 4096}) {
+        WindowHealthTracker tracker;
+        for (int i = 0; i < windows; i++) {
+            tracker.RecordSuccess(Window(1 + i), static_cast<double>((i * 37) % 200));
+        }
+        auto stats = Benchmark::Measure(50, [&]() {
+            auto snapshot = tracker.Snapshot();
+            Benchmark::DoNotOptimize(snapshot);
+        });
+        Benchmark::Report(("snapshot, " + std::to_string(windows) + " windows").c_str(), stats);
+    }
+
+    // 4 个线程同时记录
+    {
+        WindowHealthTracker tracker;
+        auto stats = Benchmark::Measure(5, [&]() {
+            std::vector<std::thread> threads;
+            for (int t = 0; t < 4; t++) {
+                threads.emplace_back([&tracker, t]() {
+                    for (int i = 0; i < calls / 4; i++) {
+                        const WindowKey window = Window(1 + (i + t) % 64);
+                        if (tracker.Admit(window) != Admission::SHED) {
+                            tracker.RecordSuccess(window, 1.0);
+                        }
+                    }
+                });
+            }
+            for (auto& thread : threads) {
+                thread.join();
+            }
+        });
+        Benchmark::Report("admit + record, 4 threads, 64 windows", stats);
+        std::printf("    %.1f ns/call\n", stats.medianNs / calls);
+    }
+    return 0;
+}